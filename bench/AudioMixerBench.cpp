@@ -0,0 +1,241 @@
+// Copyright (C) XFX Team
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without 
+// modification, are permitted provided that the following conditions are met:
+// 
+//* Redistributions of source code must retain the above copyright 
+//notice, this list of conditions and the following disclaimer.
+//* Redistributions in binary form must reproduce the above copyright 
+//notice, this list of conditions and the following disclaimer in the 
+//documentation and/or other materials provided with the distribution.
+//* Neither the name of the copyright holder nor the names of any 
+//contributors may be used to endorse or promote products derived from 
+//this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE 
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF 
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS 
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE 
+// POSSIBILITY OF SUCH DAMAGE.
+
+// Renders a scene through AudioMixer to AudioMixerBench.wav, then measures how many voices it mixes per millisecond of CPU time:
+// a voice mixed for one millisecond of audio counts as one, so the figure is also the number of voices one core could mix in real time.
+// The makefile builds this twice: AudioMixerBench measures the SSE mixer, AudioMixerBenchScalar its scalar fallback.
+
+#include <Audio/AudioEmitter.h>
+#include <Audio/AudioListener.h>
+#include <Audio/AudioMixer.h>
+#include <Audio/SoundEffect.h>
+#include <Audio/SoundEffectInstance.h>
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "HostTest.h"
+
+using namespace XFX;
+using namespace XFX::Audio;
+
+static const double TwoPi = 6.283185307179586;
+// The mixer is called with 10 ms blocks, like an audio device.
+static const int BlockFrames = AudioMixer::SampleRate / 100;
+
+static double CpuMilliseconds()
+{
+	timespec time;
+	clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &time);
+	return time.tv_sec * 1e3 + time.tv_nsec * 1e-6;
+}
+
+// Creates a sine, or two in a stereo sound, that repeats as a whole when looped.
+static SoundEffect* CreateTone(const int sampleRate, const int channels, const int frames, const double frequency, const double amplitude)
+{
+	short* samples = new short[frames * channels];
+
+	for (int i = 0; i < frames; i++)
+	{
+		for (int c = 0; c < channels; c++)
+		{
+			samples[i * channels + c] = (short)lrint(amplitude * sin(TwoPi * frequency * (c + 2) / 2 * i / sampleRate));
+		}
+	}
+
+	SoundEffect* sound = new SoundEffect((byte*)samples, 0, frames * channels * 2, sampleRate, (AudioChannels_t)channels, 0, 0);
+	delete[] samples;
+	return sound;
+}
+
+static void WriteWave(const char* path, const short samples[], const int frames)
+{
+	FILE* file = fopen(path, "wb");
+	const int dataSize = frames * 4;
+	const int header[] = { 36 + dataSize, 16, 1 | (2 << 16), AudioMixer::SampleRate, AudioMixer::SampleRate * 4, 4 | (16 << 16), dataSize };
+
+	fwrite("RIFF", 1, 4, file);
+	fwrite(&header[0], 4, 1, file);
+	fwrite("WAVEfmt ", 1, 8, file);
+	fwrite(&header[1], 4, 5, file);
+	fwrite("data", 1, 4, file);
+	fwrite(&header[6], 4, 1, file);
+	fwrite(samples, 4, frames, file);
+	fclose(file);
+}
+
+// Six seconds of pitched fire-and-forget beeps, a looped chord that pans and fades, and a doppler flyby, at 80% master volume.
+static void RenderScene(const char* path)
+{
+	const int blocks = 600;
+	short* output = new short[blocks * BlockFrames * 2];
+	SoundEffect* beep = CreateTone(22050, 1, 22050 / 2, 440.0, 8000.0);
+	SoundEffect* chord = CreateTone(44100, 2, 44100, 262.0, 6000.0);
+	SoundEffect* engine = CreateTone(48000, 1, 48000, 110.0, 8000.0);
+	SoundEffectInstance* chordInstance = chord->CreateInstance();
+	SoundEffectInstance* engineInstance = engine->CreateInstance();
+	AudioListener listener;
+	AudioEmitter emitter;
+	int loudest = 0;
+
+	SoundEffect::setMasterVolume(0.8f);
+	chordInstance->IsLooped(true);
+	engineInstance->IsLooped(true);
+
+	for (int block = 0; block < blocks; block++)
+	{
+		const double time = block / 100.0;
+
+		if (block % 50 == 0 && block < 300)
+		{
+			beep->Play(0.8f, block / 150.0f - 1.0f, block / 150.0f - 1.0f);
+		}
+
+		if (block == 100)
+		{
+			chordInstance->Play();
+		}
+
+		if (block >= 100 && block < 400)
+		{
+			chordInstance->setPan((float)sin(TwoPi * (time - 1.0) / 3.0));
+			chordInstance->setVolume((float)(1.0 - (time - 1.0) / 3.5));
+		}
+
+		if (block == 300)
+		{
+			engineInstance->Play();
+		}
+
+		if (block >= 300)
+		{
+			// Passes 5 m in front of the listener at 40 m/s, from left to right.
+			emitter.Position = Vector3((float)(40.0 * (time - 4.5)), 0.0f, -5.0f);
+			emitter.Velocity = Vector3(40.0f, 0.0f, 0.0f);
+			engineInstance->Apply3D(listener, emitter);
+		}
+
+		if (block == 400)
+		{
+			chordInstance->Stop();
+		}
+
+		AudioMixer::Render(&output[block * BlockFrames * 2], BlockFrames);
+	}
+
+	engineInstance->Stop();
+
+	for (int i = 0; i < blocks * BlockFrames * 2; i++)
+	{
+		loudest = (abs(output[i]) > loudest) ? abs(output[i]) : loudest;
+	}
+
+	// Every beep has ended, and every instance stopped.
+	CHECK(AudioMixer::getActiveVoiceCount() == 0);
+	CHECK(loudest > 1000);
+
+	WriteWave(path, output, blocks * BlockFrames);
+	printf("  rendered %d s to %s, peak %d\n", blocks / 100, path, loudest);
+
+	SoundEffect::setMasterVolume(1.0f);
+	delete chordInstance;
+	delete engineInstance;
+	beep->Dispose();
+	chord->Dispose();
+	engine->Dispose();
+	delete beep;
+	delete chord;
+	delete engine;
+	delete[] output;
+}
+
+static void Bench(const char* name, const int sampleRate, const int channels, const bool pitched, const bool cubic)
+{
+	const int voices = AudioMixer::MaxVoices;
+	const int seconds = 5;
+	SoundEffect* sounds[voices];
+	SoundEffectInstance* instances[voices];
+	short output[BlockFrames * 2];
+
+	AudioMixer::setCubicInterpolation(cubic);
+
+	for (int v = 0; v < voices; v++)
+	{
+		sounds[v] = CreateTone(sampleRate, channels, sampleRate, 200.0 + v * 17, 300.0);
+		instances[v] = sounds[v]->CreateInstance();
+		instances[v]->IsLooped(true);
+		instances[v]->setPitch(pitched ? ((v * 37) % 100) / 50.0f - 1.0f : 0.0f);
+		instances[v]->setPan(((v * 53) % 100) / 50.0f - 1.0f);
+		instances[v]->setVolume(0.05f);
+		instances[v]->Play();
+	}
+
+	CHECK(AudioMixer::getActiveVoiceCount() == voices);
+
+	const double start = CpuMilliseconds();
+
+	for (int block = 0; block < seconds * 100; block++)
+	{
+		AudioMixer::Render(output, BlockFrames);
+	}
+
+	const double milliseconds = CpuMilliseconds() - start;
+
+	printf("  %-32s %2d voices: %7.1f voices mixed per ms of CPU, %5.2f%% of one core\n",
+		name, voices, voices * seconds * 1000.0 / milliseconds, 100.0 * milliseconds / (seconds * 1000.0));
+
+	for (int v = 0; v < voices; v++)
+	{
+		instances[v]->Stop();
+		delete instances[v];
+		sounds[v]->Dispose();
+		delete sounds[v];
+	}
+
+	AudioMixer::setCubicInterpolation(false);
+}
+
+int main()
+{
+#if __SSE__
+	printf("AudioMixerBench (SSE):\n");
+#else
+	printf("AudioMixerBench (scalar):\n");
+#endif
+
+	RenderScene("AudioMixerBench.wav");
+
+	Bench("48 kHz mono, unpitched", AudioMixer::SampleRate, 1, false, false);
+	Bench("22 kHz mono, pitched, linear", 22050, 1, true, false);
+	Bench("22 kHz mono, pitched, cubic", 22050, 1, true, true);
+	Bench("44 kHz stereo, pitched, linear", 44100, 2, true, false);
+	Bench("44 kHz stereo, pitched, cubic", 44100, 2, true, true);
+
+	return (hostCheckFailures == 0 && hostAssertFailures == 0) ? 0 : 1;
+}
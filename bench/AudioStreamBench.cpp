@@ -0,0 +1,225 @@
+// Copyright (C) XFX Team
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without 
+// modification, are permitted provided that the following conditions are met:
+// 
+//* Redistributions of source code must retain the above copyright 
+//notice, this list of conditions and the following disclaimer.
+//* Redistributions in binary form must reproduce the above copyright 
+//notice, this list of conditions and the following disclaimer in the 
+//documentation and/or other materials provided with the distribution.
+//* Neither the name of the copyright holder nor the names of any 
+//contributors may be used to endorse or promote products derived from 
+//this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE 
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF 
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS 
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE 
+// POSSIBILITY OF SUCH DAMAGE.
+
+// Streams a DynamicSoundEffectInstance into a fake 48 kHz audio sink, and reports underruns and latency.
+//
+// A producer thread plays the game: it calls FrameworkDispatcher::Update once per frame, and its BufferNeeded handler submits 10 ms buffers.
+// The sink reads 5 ms blocks through ReadSamples on the main thread, paced by the clock like an audio device. Every frame carries its own
+// number, so the sink also checks that no frame is lost, repeated or torn. Latency is the time from SubmitBuffer to the block that starts
+// playing the buffer.
+
+#include <Audio/DynamicSoundEffectInstance.h>
+#include <FrameworkDispatcher.h>
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "HostTest.h"
+
+using namespace XFX;
+using namespace XFX::Audio;
+
+static const int SampleRate = 48000;
+static const int BufferFrames = SampleRate / 100;
+static const int SinkFrames = SampleRate / 200;
+// More buffers than the queue holds, so none is rewritten while it is queued.
+static const int PoolSize = 96;
+static const int MaxBuffers = 1 << 14;
+
+struct Configuration
+{
+	const char* Name;
+	int Threshold;
+	// The time between two calls to FrameworkDispatcher::Update.
+	int FrameMicroseconds;
+	// The longest random delay before each buffer is produced, as when a decoder stalls.
+	int JitterMicroseconds;
+};
+
+static Configuration configuration;
+static DynamicSoundEffectInstance* instance;
+static volatile bool producing;
+
+static short pool[PoolSize][BufferFrames * 2];
+static double submitTimes[MaxBuffers];
+static volatile int submitted;
+static unsigned int producedFrames;
+static unsigned int seed;
+
+static void Sleep(const int microseconds)
+{
+	timespec delay = { microseconds / 1000000, (microseconds % 1000000) * 1000L };
+	nanosleep(&delay, null);
+}
+
+static void OnBufferNeeded(Object* const sender, EventArgs* const e)
+{
+	while (instance->getPendingBufferCount() <= configuration.Threshold && submitted < MaxBuffers)
+	{
+		short* buffer = pool[submitted % PoolSize];
+
+		if (configuration.JitterMicroseconds > 0)
+		{
+			seed = seed * 1103515245 + 12345;
+			Sleep((seed >> 8) % configuration.JitterMicroseconds);
+		}
+
+		for (int i = 0; i < BufferFrames; i++, producedFrames++)
+		{
+			buffer[2 * i] = (short)((producedFrames & 0x7FFF) + 1);
+			buffer[2 * i + 1] = (short)~buffer[2 * i];
+		}
+
+		submitTimes[submitted] = HostSeconds();
+		instance->SubmitBuffer((byte*)buffer, 0, BufferFrames * 4);
+		// Published after the buffer is queued, so the sink never counts a buffer as submitted before it can read it.
+		submitted++;
+	}
+}
+
+static void* Producer(void*)
+{
+	while (producing)
+	{
+		FrameworkDispatcher::Update();
+		Sleep(configuration.FrameMicroseconds);
+	}
+
+	return null;
+}
+
+static int CompareLatencies(const void* a, const void* b)
+{
+	const double difference = *(const double*)a - *(const double*)b;
+	return (difference > 0) - (difference < 0);
+}
+
+static void Run(const Configuration& run, const double seconds)
+{
+	static double latencies[MaxBuffers];
+	short block[SinkFrames * 2];
+	unsigned int expectedFrame = 0;
+	int started = 0;
+	int errors = 0;
+
+	configuration = run;
+	seed = 12345;
+	submitted = 0;
+	producedFrames = 0;
+
+	instance = new DynamicSoundEffectInstance(SampleRate, AudioChannels::Stereo);
+	instance->setBufferNeededThreshold(run.Threshold);
+	instance->BufferNeeded += new EventHandler::S(OnBufferNeeded);
+	// Raises BufferNeeded here, which queues the first buffers; from now on only the producer submits.
+	instance->Play();
+
+	producing = true;
+	pthread_t producer;
+	pthread_create(&producer, null, Producer, null);
+
+	timespec next;
+	clock_gettime(CLOCK_MONOTONIC, &next);
+	const double start = HostSeconds();
+
+	while (HostSeconds() - start < seconds)
+	{
+		next.tv_nsec += SinkFrames * (1000000000L / SampleRate);
+		if (next.tv_nsec >= 1000000000L)
+		{
+			next.tv_sec++;
+			next.tv_nsec -= 1000000000L;
+		}
+		clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, null);
+
+		const double now = HostSeconds();
+		const int available = submitted;
+		const int read = instance->ReadSamples((byte*)block, 0, sizeof(block)) / 4;
+
+		for (int i = 0; i < read; i++, expectedFrame++)
+		{
+			// The first frame of each buffer starts it playing.
+			if (expectedFrame % BufferFrames == 0 && started < available)
+			{
+				latencies[started] = (now - submitTimes[started]) * 1000.0;
+				started++;
+			}
+
+			if (block[2 * i] != (short)((expectedFrame & 0x7FFF) + 1) || block[2 * i + 1] != (short)~block[2 * i])
+			{
+				errors++;
+			}
+		}
+
+		for (int i = read; i < SinkFrames; i++)
+		{
+			if (block[2 * i] != 0 || block[2 * i + 1] != 0)
+			{
+				errors++;
+			}
+		}
+	}
+
+	producing = false;
+	pthread_join(producer, null);
+
+	CHECK(errors == 0);
+	CHECK(started > 0);
+
+	if (started > 0)
+	{
+		qsort(latencies, started, sizeof(double), CompareLatencies);
+		printf("  %-36s %5d buffers %4d underruns   latency ms p50 %5.1f  p99 %5.1f  max %5.1f\n", run.Name, started, instance->getUnderrunCount(),
+			latencies[started / 2], latencies[started * 99 / 100], latencies[started - 1]);
+	}
+
+	instance->Stop();
+	((SoundEffectInstance*)instance)->Dispose();
+	delete instance;
+}
+
+int main()
+{
+	static const Configuration runs[] =
+	{
+		{ "threshold 2, 1 ms frames", 2, 1000, 0 },
+		{ "threshold 2, 16 ms frames", 2, 16667, 0 },
+		{ "threshold 4, 16 ms frames", 4, 16667, 0 },
+		{ "threshold 2, 16 ms frames, jitter", 2, 16667, 8000 },
+		{ "threshold 4, 16 ms frames, jitter", 4, 16667, 8000 },
+	};
+
+	printf("AudioStreamBench, %d Hz stereo, %d ms buffers, %d ms sink blocks:\n", SampleRate, BufferFrames * 1000 / SampleRate, SinkFrames * 1000 / SampleRate);
+
+	for (unsigned int i = 0; i < sizeof(runs) / sizeof(runs[0]); i++)
+	{
+		Run(runs[i], 2.0);
+	}
+
+	return (hostCheckFailures == 0 && hostAssertFailures == 0) ? 0 : 1;
+}
@@ -0,0 +1,236 @@
+// Copyright (C) XFX Team
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without 
+// modification, are permitted provided that the following conditions are met:
+// 
+//* Redistributions of source code must retain the above copyright 
+//notice, this list of conditions and the following disclaimer.
+//* Redistributions in binary form must reproduce the above copyright 
+//notice, this list of conditions and the following disclaimer in the 
+//documentation and/or other materials provided with the distribution.
+//* Neither the name of the copyright holder nor the names of any 
+//contributors may be used to endorse or promote products derived from 
+//this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE 
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF 
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS 
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE 
+// POSSIBILITY OF SUCH DAMAGE.
+
+// Parses a large synthetic XNB-style stream of records, the way type readers do, and reports MB/s.
+// The stream is read once from a MappedFileStream, which BinaryReader reads in place, and once from a stream that only implements Read,
+// which BinaryReader reads through its read-ahead buffer.
+
+#include <Content/ContentReader.h>
+#include <Matrix.h>
+#include <Vector2.h>
+#include <Vector3.h>
+#include <System/IO/MappedFileStream.h>
+
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "HostTest.h"
+
+using namespace XFX;
+using namespace XFX::Content;
+
+// An id, a Matrix, a Vector3, a Vector2, a short and a byte, as in a model's bone and vertex data.
+static const int RecordSize = 4 + 64 + 12 + 8 + 2 + 1;
+static const int RecordCount = (32 << 20) / RecordSize;
+static const int Length = RecordCount * RecordSize;
+
+/**
+ * A stream over a buffer that only implements Read, like a file or network stream.
+ */
+class BufferStream : public Stream
+{
+private:
+	const byte* data;
+	int length;
+
+public:
+	BufferStream(const byte* data, const int length)
+		: data(data), length(length)
+	{
+		Position = 0;
+	}
+
+	bool CanRead()
+	{
+		return true;
+	}
+
+	bool CanSeek()
+	{
+		return true;
+	}
+
+	long long Length()
+	{
+		return length;
+	}
+
+	int Read(byte buffer[], int offset, int count)
+	{
+		count = (count < length - Position) ? count : (int)(length - Position);
+		memcpy(&buffer[offset], &data[Position], count);
+		Position += count;
+		return count;
+	}
+
+	long long Seek(long long offset, SeekOrigin_t origin)
+	{
+		Position = offset + ((origin == SeekOrigin::Current) ? Position : (origin == SeekOrigin::End) ? length : 0);
+		return Position;
+	}
+};
+
+static void Generate(byte* data, double& checksum)
+{
+	checksum = 0.0;
+
+	for (int i = 0; i < RecordCount; i++)
+	{
+		byte* record = &data[i * RecordSize];
+		float values[16 + 3 + 2];
+
+		memcpy(record, &i, 4);
+
+		for (int j = 0; j < 21; j++)
+		{
+			values[j] = (float)((i + j) % 1000) * 0.5f;
+			checksum += values[j];
+		}
+
+		memcpy(&record[4], values, sizeof(values));
+
+		const short s = (short)i;
+		memcpy(&record[4 + sizeof(values)], &s, 2);
+		record[RecordSize - 1] = (byte)i;
+		checksum += i + s + (byte)i;
+	}
+}
+
+// Reads every record with BinaryReader primitives: one ReadSingle per component.
+static double ParsePrimitives(BinaryReader& reader)
+{
+	double checksum = 0.0;
+
+	for (int i = 0; i < RecordCount; i++)
+	{
+		checksum += reader.ReadInt32();
+
+		for (int j = 0; j < 21; j++)
+		{
+			checksum += reader.ReadSingle();
+		}
+
+		checksum += reader.ReadInt16();
+		checksum += reader.ReadByte();
+	}
+
+	return checksum;
+}
+
+// Reads every record with the ContentReader math readers.
+static double ParseContent(ContentReader& reader)
+{
+	double checksum = 0.0;
+
+	for (int i = 0; i < RecordCount; i++)
+	{
+		checksum += reader.ReadInt32();
+
+		const Matrix matrix = reader.ReadMatrix();
+		const Vector3 position = reader.ReadVector3();
+		const Vector2 texture = reader.ReadVector2();
+
+		checksum += matrix.M11; checksum += matrix.M12; checksum += matrix.M13; checksum += matrix.M14;
+		checksum += matrix.M21; checksum += matrix.M22; checksum += matrix.M23; checksum += matrix.M24;
+		checksum += matrix.M31; checksum += matrix.M32; checksum += matrix.M33; checksum += matrix.M34;
+		checksum += matrix.M41; checksum += matrix.M42; checksum += matrix.M43; checksum += matrix.M44;
+		checksum += position.X; checksum += position.Y; checksum += position.Z;
+		checksum += texture.X; checksum += texture.Y;
+		checksum += reader.ReadInt16();
+		checksum += reader.ReadByte();
+	}
+
+	return checksum;
+}
+
+static void Report(const char* name, const double seconds)
+{
+	printf("  %-44s %7.1f MB/s\n", name, Length / seconds / 1e6);
+}
+
+int main()
+{
+	byte* data = (byte*)malloc(Length);
+	double expected;
+
+	Generate(data, expected);
+
+	char path[] = "/tmp/xfx-records-XXXXXX";
+	FILE* file = fdopen(mkstemp(path), "wb");
+
+	fwrite(data, 1, Length, file);
+	fclose(file);
+
+	printf("BinaryReaderBench, %d records (%d MB):\n", RecordCount, Length >> 20);
+
+	{
+		MappedFileStream stream(path);
+		BinaryReader reader(&stream);
+		const double start = HostSeconds();
+
+		CHECK(ParsePrimitives(reader) == expected);
+		Report("MappedFileStream, primitives", HostSeconds() - start);
+	}
+
+	{
+		MappedFileStream stream(path);
+		ContentReader reader(null, &stream, (GraphicsDevice*)null);
+		const double start = HostSeconds();
+
+		CHECK(ParseContent(reader) == expected);
+		Report("MappedFileStream, ContentReader", HostSeconds() - start);
+	}
+
+	const int sizes[] = { BinaryReader::MinReadAheadSize, BinaryReader::DefaultReadAheadSize, BinaryReader::MaxReadAheadSize };
+
+	for (int i = 0; i < 3; i++)
+	{
+		char name[64];
+		BufferStream stream(data, Length);
+		BinaryReader reader(&stream, sizes[i]);
+		const double start = HostSeconds();
+
+		CHECK(ParsePrimitives(reader) == expected);
+		sprintf(name, "Read-only stream, %2dKB read-ahead, primitives", sizes[i] >> 10);
+		Report(name, HostSeconds() - start);
+	}
+
+	{
+		BufferStream stream(data, Length);
+		ContentReader reader(null, &stream, (GraphicsDevice*)null);
+		const double start = HostSeconds();
+
+		CHECK(ParseContent(reader) == expected);
+		Report("Read-only stream, ContentReader", HostSeconds() - start);
+	}
+
+	unlink(path);
+	free(data);
+
+	return (hostCheckFailures == 0 && hostAssertFailures == 0) ? 0 : 1;
+}
@@ -0,0 +1,165 @@
+/*****************************************************************************
+ *	ChainedDictionary.h 													 *
+ *																			 *
+ *	The hash table Dictionary used before its entries+buckets rewrite		 *
+ *	Copyright (c) XFX Team. All Rights Reserved								 *
+ *****************************************************************************/
+#ifndef _XFX_BENCH_CHAINEDDICTIONARY_
+#define _XFX_BENCH_CHAINEDDICTIONARY_
+
+#include <stddef.h>
+
+/**
+ * The lookup, insert and remove paths of the previous Dictionary, kept for DictionaryBench to compare against.
+ *
+ * The bucket count is fixed when the table is created (4 by default), and every entry is allocated on its own and chained from its bucket.
+ */
+template <class TKey, class TValue>
+class ChainedDictionary
+{
+private:
+	struct Entry
+	{
+		TKey Key;
+		TValue Value;
+		Entry* next;
+
+		Entry(const TKey& key, const TValue& value)
+			: Key(key), Value(value), next(NULL)
+		{
+		}
+	};
+
+	static const int defaultCapacity = 4;
+
+	int _count;
+	Entry** _internalStorage;
+	int _size;
+
+	ChainedDictionary(const ChainedDictionary<TKey, TValue> &obj);
+
+	Entry* FindEntry(const TKey& key) const
+	{
+		Entry* entry = _internalStorage[key.GetHashCode() % _size];
+
+		while (entry != NULL && !(entry->Key == key))
+		{
+			entry = entry->next;
+		}
+
+		return entry;
+	}
+
+public:
+	int Count() const
+	{
+		return _count;
+	}
+
+	ChainedDictionary(const int capacity = defaultCapacity)
+		: _count(0), _size(capacity)
+	{
+		_internalStorage = new Entry*[_size];
+
+		for (int i = 0; i < _size; i++)
+		{
+			_internalStorage[i] = NULL;
+		}
+	}
+
+	~ChainedDictionary()
+	{
+		for (int i = 0; i < _size; i++)
+		{
+			Entry* entry = _internalStorage[i];
+
+			while (entry != NULL)
+			{
+				Entry* next = entry->next;
+				delete entry;
+				entry = next;
+			}
+		}
+
+		delete[] _internalStorage;
+	}
+
+	void Add(const TKey& key, const TValue& value)
+	{
+		int hash = key.GetHashCode() % _size;
+
+		if (_internalStorage[hash] == NULL)
+		{
+			_internalStorage[hash] = new Entry(key, value);
+		}
+		else
+		{
+			Entry* entry = _internalStorage[hash];
+
+			while (entry->next != NULL)
+			{
+				entry = entry->next;
+			}
+
+			if (entry->Key == key)
+			{
+				return;
+			}
+
+			entry->next = new Entry(key, value);
+		}
+
+		_count++;
+	}
+
+	bool ContainsKey(const TKey& key) const
+	{
+		return FindEntry(key) != NULL;
+	}
+
+	bool Remove(const TKey& key)
+	{
+		int hash = key.GetHashCode() % _size;
+		Entry* prevEntry = NULL;
+		Entry* entry = _internalStorage[hash];
+
+		while (entry != NULL && !(entry->Key == key))
+		{
+			prevEntry = entry;
+			entry = entry->next;
+		}
+
+		if (entry == NULL)
+		{
+			return false;
+		}
+
+		if (prevEntry == NULL)
+		{
+			_internalStorage[hash] = entry->next;
+		}
+		else
+		{
+			prevEntry->next = entry->next;
+		}
+
+		delete entry;
+		_count--;
+		return true;
+	}
+
+	bool TryGetValue(const TKey& key, TValue& value) const
+	{
+		Entry* entry = FindEntry(key);
+
+		if (entry == NULL)
+		{
+			return false;
+		}
+
+		value = entry->Value;
+		return true;
+	}
+};
+
+#endif //_XFX_BENCH_CHAINEDDICTIONARY_
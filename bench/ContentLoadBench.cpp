@@ -0,0 +1,335 @@
+// Copyright (C) XFX Team
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without 
+// modification, are permitted provided that the following conditions are met:
+// 
+//* Redistributions of source code must retain the above copyright 
+//notice, this list of conditions and the following disclaimer.
+//* Redistributions in binary form must reproduce the above copyright 
+//notice, this list of conditions and the following disclaimer in the 
+//documentation and/or other materials provided with the distribution.
+//* Neither the name of the copyright holder nor the names of any 
+//contributors may be used to endorse or promote products derived from 
+//this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE 
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF 
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS 
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE 
+// POSSIBILITY OF SUCH DAMAGE.
+
+// Loads a directory of .xnb files on several threads at once, and reports the throughput.
+//
+// ContentLoadBench [directory]
+//
+// Without a directory, synthetic files holding Matrix arrays are written to a temporary directory and loaded from there.
+// ContentManager is built on the Xbox kernel, so each thread does the part of Load that runs on any platform:
+// it maps the file, lets ContentReader check the header (and decompress the body), and reads the asset.
+
+#include <Matrix.h>
+#include <Content/ContentReader.h>
+#include <System/IO/MappedFileStream.h>
+#include <System/Threading/Interlocked.h>
+
+#include <dirent.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "HostTest.h"
+
+using namespace System::Threading;
+using namespace XFX;
+using namespace XFX::Content;
+
+static const int MaxFiles = 1024;
+static const int SyntheticFiles = 64;
+static const int SyntheticMatrices = 4096;
+static const int Passes = 8;
+
+static const char MatrixArrayReader[] = "Microsoft.Xna.Framework.Content.ArrayReader`1[[Microsoft.Xna.Framework.Matrix, Microsoft.Xna.Framework, Version=4.0.0.0, Culture=neutral, PublicKeyToken=842cf8be1de50553]]";
+
+static char* paths[MaxFiles];
+static int fileCount;
+static volatile int nextFile;
+static volatile int failedFiles;
+// Bytes read from disk and bytes of asset data decoded, per thread.
+static long long fileBytes[16];
+static long long assetBytes[16];
+static float checksums[16];
+
+static void Write7BitEncodedInt(FILE* const file, unsigned int value)
+{
+	while (value >= 0x80)
+	{
+		fputc((int)(value | 0x80) & 0xFF, file);
+		value >>= 7;
+	}
+
+	fputc((int)value, file);
+}
+
+static void WriteInt32(FILE* const file, const int value)
+{
+	fwrite(&value, sizeof(value), 1, file);
+}
+
+// An uncompressed .xnb file holding one Matrix[] asset.
+static void WriteMatrixArray(const char* const path, const int index)
+{
+	FILE* file = fopen(path, "wb");
+	const int nameLength = sizeof(MatrixArrayReader) - 1;
+
+	fwrite("XNBx\x05\x00", 1, 6, file);
+	WriteInt32(file, 0);
+	Write7BitEncodedInt(file, 1);
+	Write7BitEncodedInt(file, nameLength);
+	fwrite(MatrixArrayReader, 1, nameLength, file);
+	WriteInt32(file, 0);
+	Write7BitEncodedInt(file, 0);
+	Write7BitEncodedInt(file, 1);
+	WriteInt32(file, SyntheticMatrices);
+
+	for (int i = 0; i < SyntheticMatrices; i++)
+	{
+		float elements[16];
+
+		for (int j = 0; j < 16; j++)
+		{
+			elements[j] = (float)((index + i + j) % 7);
+		}
+
+		fwrite(elements, sizeof(elements), 1, file);
+	}
+
+	const int size = (int)ftell(file);
+	fseek(file, 6, SEEK_SET);
+	WriteInt32(file, size);
+	fclose(file);
+}
+
+static int Read7BitEncodedInt(ContentReader& reader)
+{
+	int value = 0;
+
+	for (int shift = 0; shift < 35; shift += 7)
+	{
+		const byte b = reader.ReadByte();
+
+		value |= (b & 0x7F) << shift;
+
+		if ((b & 0x80) == 0)
+		{
+			break;
+		}
+	}
+
+	return value;
+}
+
+// Reads the type reader list and the asset. Matrix arrays are read as matrices, anything else as raw bytes.
+static bool Load(const char* const path, const int thread)
+{
+	MappedFileStream file(path);
+
+	if (!file.CanRead())
+	{
+		return false;
+	}
+
+	Stream* body;
+	{
+		ContentReader reader(null, &file, path);
+
+		const int typeReaderCount = Read7BitEncodedInt(reader);
+		bool matrixArray = false;
+
+		// The names are 7-bit length prefixed, as in .NET, where BinaryReader::ReadString expects a 16-bit length.
+		for (int i = 0; i < typeReaderCount; i++)
+		{
+			const int nameLength = Read7BitEncodedInt(reader);
+			const byte* name = reader.ReadSpan(nameLength);
+
+			matrixArray |= (i == 0 && name != null && nameLength == sizeof(MatrixArrayReader) - 1 && memcmp(name, MatrixArrayReader, nameLength) == 0);
+			reader.ReadInt32();
+		}
+
+		Read7BitEncodedInt(reader);
+		Read7BitEncodedInt(reader);
+
+		if (matrixArray)
+		{
+			const int count = reader.ReadInt32();
+
+			for (int i = 0; i < count; i++)
+			{
+				const Matrix matrix = reader.ReadMatrix();
+
+				checksums[thread] += matrix.M11 + matrix.M44;
+			}
+
+			assetBytes[thread] += count * 16 * sizeof(float);
+		}
+		else
+		{
+			byte buffer[4096];
+			int read;
+
+			while ((read = reader.Read(buffer, 0, sizeof(buffer))) > 0)
+			{
+				assetBytes[thread] += read;
+			}
+		}
+
+		fileBytes[thread] += file.Length();
+		body = reader.BaseStream();
+	}
+
+	// ContentReader closes, but does not free, the decompressing stream it created.
+	if (body != &file)
+	{
+		delete body;
+	}
+
+	return true;
+}
+
+static void* LoadThread(void* const argument)
+{
+	const int thread = (int)(long)argument;
+	int index;
+
+	while ((index = Interlocked::Increment(&nextFile) - 1) < fileCount * Passes)
+	{
+		if (!Load(paths[index % fileCount], thread))
+		{
+			Interlocked::Increment(&failedFiles);
+		}
+	}
+
+	return null;
+}
+
+int main(int argc, char* argv[])
+{
+	char directory[64] = "/tmp/xfx-xnb-XXXXXX";
+	const bool synthetic = (argc < 2);
+
+	if (synthetic)
+	{
+		if (mkdtemp(directory) == null)
+		{
+			return 1;
+		}
+
+		for (int i = 0; i < SyntheticFiles; i++)
+		{
+			paths[i] = (char*)malloc(strlen(directory) + 16);
+			sprintf(paths[i], "%s/%02d.xnb", directory, i);
+			WriteMatrixArray(paths[i], i);
+		}
+
+		fileCount = SyntheticFiles;
+	}
+	else
+	{
+		DIR* dir = opendir(argv[1]);
+
+		if (dir == null)
+		{
+			fprintf(stderr, "Could not open %s\n", argv[1]);
+			return 1;
+		}
+
+		dirent* entry;
+
+		while ((entry = readdir(dir)) != null && fileCount < MaxFiles)
+		{
+			const size_t length = strlen(entry->d_name);
+
+			if (length > 4 && strcasecmp(entry->d_name + length - 4, ".xnb") == 0)
+			{
+				paths[fileCount] = (char*)malloc(strlen(argv[1]) + length + 2);
+				sprintf(paths[fileCount++], "%s/%s", argv[1], entry->d_name);
+			}
+		}
+
+		closedir(dir);
+	}
+
+	printf("ContentLoadBench, %d files loaded %d times:\n", fileCount, Passes);
+
+	float expected = 0.0f;
+
+	for (int threads = 1; threads <= 4; threads *= 2)
+	{
+		pthread_t handles[4];
+
+		memset(fileBytes, 0, sizeof(fileBytes));
+		memset(assetBytes, 0, sizeof(assetBytes));
+		memset(checksums, 0, sizeof(checksums));
+		nextFile = 0;
+
+		const double start = HostSeconds();
+
+		for (int i = 0; i < threads; i++)
+		{
+			pthread_create(&handles[i], null, LoadThread, (void*)(long)i);
+		}
+
+		for (int i = 0; i < threads; i++)
+		{
+			pthread_join(handles[i], null);
+		}
+
+		const double seconds = HostSeconds() - start;
+		long long totalFileBytes = 0;
+		long long totalAssetBytes = 0;
+		float checksum = 0.0f;
+
+		for (int i = 0; i < threads; i++)
+		{
+			totalFileBytes += fileBytes[i];
+			totalAssetBytes += assetBytes[i];
+			checksum += checksums[i];
+		}
+
+		printf("  %d threads: %8.1f files/s, %7.1f MB/s read, %7.1f MB/s of assets\n", threads, fileCount * Passes / seconds,
+			totalFileBytes / seconds / 1e6, totalAssetBytes / seconds / 1e6);
+
+		// Every thread count loads the same files, so the matrices add up to the same sum.
+		if (threads == 1)
+		{
+			expected = checksum;
+		}
+
+		CHECK(checksum == expected);
+	}
+
+	CHECK(failedFiles == 0);
+
+	for (int i = 0; i < fileCount; i++)
+	{
+		if (synthetic)
+		{
+			unlink(paths[i]);
+		}
+
+		free(paths[i]);
+	}
+
+	if (synthetic)
+	{
+		rmdir(directory);
+	}
+
+	return (hostCheckFailures == 0 && hostAssertFailures == 0) ? 0 : 1;
+}
@@ -0,0 +1,158 @@
+// Copyright (C) XFX Team
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without 
+// modification, are permitted provided that the following conditions are met:
+// 
+//* Redistributions of source code must retain the above copyright 
+//notice, this list of conditions and the following disclaimer.
+//* Redistributions in binary form must reproduce the above copyright 
+//notice, this list of conditions and the following disclaimer in the 
+//documentation and/or other materials provided with the distribution.
+//* Neither the name of the copyright holder nor the names of any 
+//contributors may be used to endorse or promote products derived from 
+//this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE 
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF 
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS 
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE 
+// POSSIBILITY OF SUCH DAMAGE.
+
+// Compares insert, lookup and remove on Dictionary against the chained table it replaced (ChainedDictionary.h).
+
+#include <System/Collections/Generic/Dictionary.h>
+
+#include "ChainedDictionary.h"
+#include "HostTest.h"
+
+using namespace System::Collections::Generic;
+
+// An int key, hashed as Int32 is.
+struct Key
+{
+	int value;
+
+	Key()
+		: value(0)
+	{
+	}
+
+	Key(const int value)
+		: value(value)
+	{
+	}
+
+	int GetHashCode() const
+	{
+		return value;
+	}
+
+	bool operator==(const Key& other) const
+	{
+		return value == other.value;
+	}
+
+	bool operator!=(const Key& other) const
+	{
+		return value != other.value;
+	}
+};
+
+static const int Operations = 2000000;
+
+static const int MaxKeys = 10000;
+
+static Key keys[MaxKeys];
+static Key missing[MaxKeys];
+
+// Inserts count keys, looks each up along with a missing key, then removes them. Returns the number of lookups that hit.
+template <class TDictionary>
+static int Run(TDictionary& dictionary, const int count, double seconds[3])
+{
+	int hits = 0;
+	int value;
+
+	double start = HostSeconds();
+	for (int i = 0; i < count; i++)
+	{
+		dictionary.Add(keys[i], i);
+	}
+	seconds[0] += HostSeconds() - start;
+
+	start = HostSeconds();
+	for (int i = 0; i < count; i++)
+	{
+		hits += dictionary.TryGetValue(keys[i], value) && value == i;
+		hits += dictionary.ContainsKey(missing[i]);
+	}
+	seconds[1] += HostSeconds() - start;
+
+	start = HostSeconds();
+	for (int i = 0; i < count; i++)
+	{
+		hits -= !dictionary.Remove(keys[i]);
+	}
+	seconds[2] += HostSeconds() - start;
+
+	return hits;
+}
+
+static void Report(const char* name, const int count, const int passes, const double seconds[3])
+{
+	const double operations = (double)count * passes / 1e6;
+
+	printf("  %-18s %6d keys: insert %7.2f, lookup %7.2f, remove %7.2f Mop/s\n", name, count, operations / seconds[0], 2 * operations / seconds[1], operations / seconds[2]);
+}
+
+int main()
+{
+	// Multiplying by an odd constant is a bijection, so the keys are distinct, and spread like hashed ids.
+	for (int i = 0; i < MaxKeys; i++)
+	{
+		keys[i] = Key((int)((i * 2654435761u) & 0x7FFFFFFF));
+		missing[i] = Key((int)(((i + MaxKeys) * 2654435761u) & 0x7FFFFFFF));
+	}
+
+	printf("DictionaryBench:\n");
+
+	const int counts[] = { 100, 1000, MaxKeys };
+
+	for (int c = 0; c < 3; c++)
+	{
+		const int count = counts[c];
+		const int passes = Operations / count;
+		double seconds[3] = { 0, 0, 0 };
+		double chainedSeconds[3] = { 0, 0, 0 };
+		// The chained table does not grow, so its passes take quadratic time and fewer are run.
+		const int chainedPasses = (count > 100) ? passes * 100 / count : passes;
+		int hits = 0;
+		int chainedHits = 0;
+
+		for (int pass = 0; pass < passes; pass++)
+		{
+			Dictionary<Key, int> dictionary;
+			hits = Run(dictionary, count, seconds);
+			CHECK(dictionary.Count() == 0);
+		}
+
+		for (int pass = 0; pass < chainedPasses; pass++)
+		{
+			ChainedDictionary<Key, int> dictionary;
+			chainedHits = Run(dictionary, count, chainedSeconds);
+			CHECK(dictionary.Count() == 0);
+		}
+
+		Report("Dictionary", count, passes, seconds);
+		Report("previous (chained)", count, chainedPasses, chainedSeconds);
+		CHECK(hits == count && chainedHits == count);
+	}
+
+	return (hostCheckFailures == 0 && hostAssertFailures == 0) ? 0 : 1;
+}
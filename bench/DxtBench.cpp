@@ -0,0 +1,158 @@
+// Copyright (C) XFX Team
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without 
+// modification, are permitted provided that the following conditions are met:
+// 
+//* Redistributions of source code must retain the above copyright 
+//notice, this list of conditions and the following disclaimer.
+//* Redistributions in binary form must reproduce the above copyright 
+//notice, this list of conditions and the following disclaimer in the 
+//documentation and/or other materials provided with the distribution.
+//* Neither the name of the copyright holder nor the names of any 
+//contributors may be used to endorse or promote products derived from 
+//this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE 
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF 
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS 
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE 
+// POSSIBILITY OF SUCH DAMAGE.
+
+// Measures DxtUtil on a 1024x1024 image: decoding DXT1, DXT3 and DXT5 whole and split between threads by block rows,
+// and encoding DXT1 and DXT5. Reports megapixels per second.
+
+#include "DxtUtil.h"
+
+#include <pthread.h>
+#include <string.h>
+
+#include "HostTest.h"
+
+using namespace XFX::Graphics;
+
+static const int Width = 1024;
+static const int Height = 1024;
+static const int Passes = 50;
+static const int Threads = 4;
+
+typedef void (*DecompressRows)(const byte imageData[], const int width, const int height, byte output[], const int firstBlockRow, const int blockRowCount);
+
+struct RowRange
+{
+	DecompressRows decompress;
+	const byte* imageData;
+	byte* output;
+	int firstBlockRow;
+	int blockRowCount;
+};
+
+static void* DecompressRange(void* argument)
+{
+	const RowRange* range = (const RowRange*)argument;
+
+	range->decompress(range->imageData, Width, Height, range->output, range->firstBlockRow, range->blockRowCount);
+	return null;
+}
+
+static void Report(const char* name, const int passes, const double seconds)
+{
+	printf("  %-32s %8.1f Mpx/s\n", name, (double)passes * Width * Height / seconds / 1e6);
+}
+
+static void BenchDecompress(const char* name, byte* (*decompress)(const byte[], const int, const int), const DecompressRows decompressRows, const byte imageData[])
+{
+	byte* expected = decompress(imageData, Width, Height);
+	double start = HostSeconds();
+
+	for (int i = 0; i < Passes; i++)
+	{
+		delete[] decompress(imageData, Width, Height);
+	}
+
+	Report(name, Passes, HostSeconds() - start);
+
+	// The same image split into one range of block rows per thread.
+	byte* output = new byte[Width * Height * 4];
+	const int blockRows = DxtUtil::GetBlockCount(Height);
+	pthread_t threads[Threads];
+	RowRange ranges[Threads];
+	char threadedName[64];
+
+	memset(output, 0, Width * Height * 4);
+	start = HostSeconds();
+
+	for (int i = 0; i < Passes; i++)
+	{
+		for (int t = 0; t < Threads; t++)
+		{
+			ranges[t].decompress = decompressRows;
+			ranges[t].imageData = imageData;
+			ranges[t].output = output;
+			ranges[t].firstBlockRow = t * blockRows / Threads;
+			ranges[t].blockRowCount = (t + 1) * blockRows / Threads - ranges[t].firstBlockRow;
+			pthread_create(&threads[t], null, DecompressRange, &ranges[t]);
+		}
+
+		for (int t = 0; t < Threads; t++)
+		{
+			pthread_join(threads[t], null);
+		}
+	}
+
+	sprintf(threadedName, "%s, %d threads", name, Threads);
+	Report(threadedName, Passes, HostSeconds() - start);
+	CHECK(memcmp(output, expected, Width * Height * 4) == 0);
+
+	delete[] expected;
+	delete[] output;
+}
+
+static void BenchCompress(const char* name, byte* (*compress)(const byte[], const int, const int), const byte image[])
+{
+	const double start = HostSeconds();
+
+	for (int i = 0; i < Passes / 5; i++)
+	{
+		delete[] compress(image, Width, Height);
+	}
+
+	Report(name, Passes / 5, HostSeconds() - start);
+}
+
+int main()
+{
+	// Gradients with some noise, so every block has distinct endpoints and indices.
+	byte* image = new byte[Width * Height * 4];
+	unsigned int seed = 12345;
+
+	for (int i = 0; i < Width * Height * 4; i++)
+	{
+		seed = seed * 1103515245 + 12345;
+		image[i] = (byte)((i / 4) % Width + (i / 4) / Width * 3 + (i & 3) * 40 + ((seed >> 8) & 15));
+	}
+
+	byte* dxt1 = DxtUtil::CompressDxt1(image, Width, Height);
+	byte* dxt5 = DxtUtil::CompressDxt5(image, Width, Height);
+
+	printf("DxtBench, %dx%d:\n", Width, Height);
+
+	BenchDecompress("DecompressDxt1", DxtUtil::DecompressDxt1, DxtUtil::DecompressDxt1, dxt1);
+	// DXT5 data read as DXT3: the alpha is meaningless, but the work is the same.
+	BenchDecompress("DecompressDxt3", DxtUtil::DecompressDxt3, DxtUtil::DecompressDxt3, dxt5);
+	BenchDecompress("DecompressDxt5", DxtUtil::DecompressDxt5, DxtUtil::DecompressDxt5, dxt5);
+	BenchCompress("CompressDxt1", DxtUtil::CompressDxt1, image);
+	BenchCompress("CompressDxt5", DxtUtil::CompressDxt5, image);
+
+	delete[] image;
+	delete[] dxt1;
+	delete[] dxt5;
+
+	return (hostCheckFailures == 0 && hostAssertFailures == 0) ? 0 : 1;
+}
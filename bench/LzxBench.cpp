@@ -0,0 +1,158 @@
+// Copyright (C) XFX Team
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without 
+// modification, are permitted provided that the following conditions are met:
+// 
+//* Redistributions of source code must retain the above copyright 
+//notice, this list of conditions and the following disclaimer.
+//* Redistributions in binary form must reproduce the above copyright 
+//notice, this list of conditions and the following disclaimer in the 
+//documentation and/or other materials provided with the distribution.
+//* Neither the name of the copyright holder nor the names of any 
+//contributors may be used to endorse or promote products derived from 
+//this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE 
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF 
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS 
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE 
+// POSSIBILITY OF SUCH DAMAGE.
+
+// Measures LZX decompression in MB/s of output: LzxDecoder on whole frames, and ContentReader reading a compressed .xnb body.
+
+#include <Content/ContentReader.h>
+#include <System/IO/MappedFileStream.h>
+#include "LzxDecoder.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "HostTest.h"
+#include "LzxEncoder.h"
+
+using namespace XFX::Content;
+
+static const int FrameSize = 0x8000;
+static const int Length = 16 << 20;
+static const int Passes = 4;
+
+// Decodes every frame of a compressed body into output.
+static bool Decode(const byte* compressed, const int compressedLength, byte* output)
+{
+	LzxDecoder decoder(16);
+	int read = 0;
+	int written = 0;
+
+	while (read < compressedLength)
+	{
+		int frameSize = FrameSize;
+
+		if (compressed[read] == 0xFF)
+		{
+			frameSize = (compressed[read + 1] << 8) | compressed[read + 2];
+			read += 3;
+		}
+
+		const int blockSize = (compressed[read] << 8) | compressed[read + 1];
+
+		if (!decoder.Decompress(&compressed[read + 2], blockSize, &output[written], frameSize))
+		{
+			return false;
+		}
+
+		read += 2 + blockSize;
+		written += frameSize;
+	}
+
+	return true;
+}
+
+static void WriteInt32(FILE* const file, const int value)
+{
+	fwrite(&value, sizeof(value), 1, file);
+}
+
+static void Run(const char* name, const byte* data, const LzxEncoder::BlockTypes blockTypes)
+{
+	byte* output = (byte*)malloc(Length);
+	int compressedLength;
+	byte* compressed = LzxEncoder::Compress(data, Length, blockTypes, compressedLength);
+
+	double start = HostSeconds();
+	for (int pass = 0; pass < Passes; pass++)
+	{
+		CHECK(Decode(compressed, compressedLength, output));
+	}
+	const double seconds = HostSeconds() - start;
+
+	CHECK(memcmp(data, output, Length) == 0);
+
+	char path[] = "/tmp/xfx-lzx-XXXXXX";
+	FILE* file = fdopen(mkstemp(path), "wb");
+
+	fwrite("XNBx\x05\x80", 1, 6, file);
+	WriteInt32(file, 14 + compressedLength);
+	WriteInt32(file, Length);
+	fwrite(compressed, 1, compressedLength, file);
+	fclose(file);
+
+	// ContentReader is read 4KB at a time, as a type reader copying a large asset would.
+	double streamSeconds = 0.0;
+
+	for (int pass = 0; pass < Passes; pass++)
+	{
+		MappedFileStream stream(path);
+		Stream* body;
+
+		start = HostSeconds();
+		{
+			ContentReader reader(null, &stream, path);
+			int read = 0;
+			int count;
+
+			while ((count = reader.Read(output, read, (Length - read < 4096) ? Length - read : 4096)) > 0)
+			{
+				read += count;
+			}
+
+			CHECK(read == Length);
+			body = reader.BaseStream();
+		}
+		streamSeconds += HostSeconds() - start;
+
+		// ContentReader closes, but does not free, the decompressing stream it created.
+		delete body;
+	}
+
+	CHECK(memcmp(data, output, Length) == 0);
+	unlink(path);
+
+	printf("  %-8s %5.1f%% of the size: LzxDecoder %7.1f MB/s, ContentReader %7.1f MB/s\n", name, compressedLength * 100.0 / Length,
+		(double)Length * Passes / seconds / 1e6, (double)Length * Passes / streamSeconds / 1e6);
+
+	free(compressed);
+	free(output);
+}
+
+int main()
+{
+	byte* data = (byte*)malloc(Length);
+
+	LzxEncoder::SampleData(data, Length, 12345);
+
+	printf("LzxBench, %d MB:\n", Length >> 20);
+	Run("verbatim", data, LzxEncoder::Verbatim);
+	Run("mixed", data, LzxEncoder::Mixed);
+
+	free(data);
+
+	return (hostCheckFailures == 0 && hostAssertFailures == 0) ? 0 : 1;
+}
@@ -0,0 +1,205 @@
+// Copyright (C) XFX Team
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without 
+// modification, are permitted provided that the following conditions are met:
+// 
+//* Redistributions of source code must retain the above copyright 
+//notice, this list of conditions and the following disclaimer.
+//* Redistributions in binary form must reproduce the above copyright 
+//notice, this list of conditions and the following disclaimer in the 
+//documentation and/or other materials provided with the distribution.
+//* Neither the name of the copyright holder nor the names of any 
+//contributors may be used to endorse or promote products derived from 
+//this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE 
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF 
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS 
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE 
+// POSSIBILITY OF SUCH DAMAGE.
+
+// Compares the const reference Matrix API with the by-value signatures it replaced, on the matrix work of a camera and a skinned model.
+// The by-value signatures are reproduced here as wrappers that take their arguments by value, as the old out overloads did.
+
+#include <MathHelper.h>
+#include <Matrix.h>
+#include <Quaternion.h>
+#include <Vector3.h>
+
+#include "HostTest.h"
+
+using namespace XFX;
+
+static const int Bones = 64;
+static const int Frames = 20000;
+
+#define NOINLINE __attribute__((noinline))
+
+static NOINLINE void MultiplyByValue(Matrix matrix1, Matrix matrix2, Matrix& result)
+{
+	Matrix::Multiply(matrix1, matrix2, result);
+}
+
+static NOINLINE void InvertByValue(Matrix matrix, Matrix& result)
+{
+	Matrix::Invert(matrix, result);
+}
+
+static NOINLINE void CreateLookAtByValue(Vector3 cameraPosition, Vector3 cameraTarget, Vector3 cameraUpVector, Matrix& result)
+{
+	Matrix::CreateLookAt(cameraPosition, cameraTarget, cameraUpVector, result);
+}
+
+static NOINLINE void CreateFromQuaternionByValue(Quaternion rotation, Matrix& result)
+{
+	Matrix::CreateFromQuaternion(rotation, result);
+}
+
+static Matrix bindPose[Bones];
+static Matrix inverseBindPose[Bones];
+static Quaternion rotations[Bones];
+static int parents[Bones];
+static Matrix absolute[Bones];
+static Matrix skin[Bones];
+static Matrix skinByValue[Bones];
+
+// One frame of camera work: the view from a moving eye, the view-projection and its inverse for picking.
+static void Camera(const int frame, const Matrix& projection, Matrix& viewProjection, Matrix& inverse)
+{
+	const Vector3 eye((float)(frame % 100), 5.0f, 20.0f);
+	Matrix view;
+
+	Matrix::CreateLookAt(eye, Vector3::Zero, Vector3::Up, view);
+	Matrix::Multiply(view, projection, viewProjection);
+	Matrix::Invert(viewProjection, inverse);
+}
+
+static void CameraByValue(const int frame, const Matrix& projection, Matrix& viewProjection, Matrix& inverse)
+{
+	const Vector3 eye((float)(frame % 100), 5.0f, 20.0f);
+	Matrix view;
+
+	CreateLookAtByValue(eye, Vector3::Zero, Vector3::Up, view);
+	MultiplyByValue(view, projection, viewProjection);
+	InvertByValue(viewProjection, inverse);
+}
+
+// One frame of skinning: each bone's local rotation over its bind pose, concatenated down the hierarchy, then relative to the bind pose.
+static void Skin()
+{
+	for (int i = 0; i < Bones; i++)
+	{
+		Matrix local;
+
+		Matrix::CreateFromQuaternion(rotations[i], local);
+		Matrix::Multiply(local, bindPose[i], local);
+
+		if (parents[i] >= 0)
+		{
+			Matrix::Multiply(local, absolute[parents[i]], absolute[i]);
+		}
+		else
+		{
+			absolute[i] = local;
+		}
+
+		Matrix::Multiply(inverseBindPose[i], absolute[i], skin[i]);
+	}
+}
+
+static void SkinByValue()
+{
+	for (int i = 0; i < Bones; i++)
+	{
+		Matrix local;
+
+		CreateFromQuaternionByValue(rotations[i], local);
+		MultiplyByValue(local, bindPose[i], local);
+
+		if (parents[i] >= 0)
+		{
+			MultiplyByValue(local, absolute[parents[i]], absolute[i]);
+		}
+		else
+		{
+			absolute[i] = local;
+		}
+
+		MultiplyByValue(inverseBindPose[i], absolute[i], skinByValue[i]);
+	}
+}
+
+static void Report(const char* name, const int calls, const int bytesByValue, const int bytesByReference, const double secondsByValue, const double seconds)
+{
+	printf("  %-8s %5d calls/frame, %6d -> %4d argument bytes/frame, %7.2f -> %7.2f us/frame\n", name, calls, bytesByValue, bytesByReference,
+		secondsByValue / Frames * 1e6, seconds / Frames * 1e6);
+}
+
+int main()
+{
+	const Matrix projection = Matrix::CreatePerspectiveFieldOfView(MathHelper::PiOver4, 4.0f / 3.0f, 0.1f, 1000.0f);
+
+	for (int i = 0; i < Bones; i++)
+	{
+		parents[i] = i - 1 - (i % 3 == 2);
+		rotations[i] = Quaternion::CreateFromYawPitchRoll(0.01f * i, 0.02f * i, -0.03f * i);
+		bindPose[i] = Matrix::CreateTranslation(0.0f, 1.0f, 0.1f * i);
+		Matrix::Invert(bindPose[i], inverseBindPose[i]);
+	}
+
+	Matrix viewProjection, inverse, viewProjectionByValue, inverseByValue;
+
+	printf("MatrixArgumentBench, before (by value) -> after (const reference):\n");
+
+	double start = HostSeconds();
+	for (int frame = 0; frame < Frames; frame++)
+	{
+		CameraByValue(frame, projection, viewProjectionByValue, inverseByValue);
+	}
+	const double cameraByValue = HostSeconds() - start;
+
+	start = HostSeconds();
+	for (int frame = 0; frame < Frames; frame++)
+	{
+		Camera(frame, projection, viewProjection, inverse);
+	}
+	const double camera = HostSeconds() - start;
+
+	// CreateLookAt took three Vector3s, Multiply two matrices and Invert one; now each argument is a pointer.
+	Report("camera", 3, 3 * sizeof(Vector3) + 3 * sizeof(Matrix), 6 * sizeof(void*), cameraByValue, camera);
+
+	start = HostSeconds();
+	for (int frame = 0; frame < Frames; frame++)
+	{
+		SkinByValue();
+	}
+	const double skinningByValue = HostSeconds() - start;
+
+	start = HostSeconds();
+	for (int frame = 0; frame < Frames; frame++)
+	{
+		Skin();
+	}
+	const double skinning = HostSeconds() - start;
+
+	// Per bone: CreateFromQuaternion and three Multiply calls (the root has one fewer).
+	const int multiplies = 3 * Bones - 1;
+	Report("skinning", Bones + multiplies, Bones * sizeof(Quaternion) + multiplies * 2 * sizeof(Matrix), (Bones + multiplies * 2) * sizeof(void*), skinningByValue, skinning);
+
+	// Both signatures run the same code, so the results are identical.
+	CHECK(viewProjection == viewProjectionByValue && inverse == inverseByValue);
+
+	for (int i = 0; i < Bones; i++)
+	{
+		CHECK(skin[i] == skinByValue[i]);
+	}
+
+	return (hostCheckFailures == 0 && hostAssertFailures == 0) ? 0 : 1;
+}
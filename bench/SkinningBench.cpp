@@ -0,0 +1,207 @@
+// Copyright (C) XFX Team
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without 
+// modification, are permitted provided that the following conditions are met:
+// 
+//* Redistributions of source code must retain the above copyright 
+//notice, this list of conditions and the following disclaimer.
+//* Redistributions in binary form must reproduce the above copyright 
+//notice, this list of conditions and the following disclaimer in the 
+//documentation and/or other materials provided with the distribution.
+//* Neither the name of the copyright holder nor the names of any 
+//contributors may be used to endorse or promote products derived from 
+//this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE 
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF 
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS 
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE 
+// POSSIBILITY OF SUCH DAMAGE.
+
+// Times SkinnedEffect::SkinVertices, and counts the push buffer dwords SkinnedEffect sends per apply for a full pose, a partly changed pose
+// and an unchanged one.
+// The makefile builds this twice: SkinningBench measures the SSE path of the CPU skinning, SkinningBenchScalar its scalar fallback.
+
+#include <Graphics/GraphicsDevice.h>
+#include <Graphics/PresentationParameters.h>
+#include <Graphics/SkinnedEffect.h>
+#include <Graphics/VertexElement.h>
+#include <Matrix.h>
+#include <Vector3.h>
+
+extern "C"
+{
+#include "pbKit.h"
+}
+
+#include <string.h>
+
+#include "HostTest.h"
+
+using namespace XFX;
+using namespace XFX::Graphics;
+
+// About as many vertices as a couple of skinned characters.
+static const int Count = 8192;
+static const int Passes = 200;
+static const int Frames = 1000;
+
+struct SkinnedVertex
+{
+	float Position[3];
+	float Normal[3];
+	byte Indices[4];
+	float Weights[4];
+	float TextureCoordinate[2];
+};
+
+static SkinnedVertex vertices[Count];
+static SkinnedVertex skinned[Count];
+
+static DWORD Mark()
+{
+	DWORD count;
+	pb_recorded_stream(&count);
+	return count;
+}
+
+// Applies the effect once per frame, and reports the dwords it sent per frame.
+static double Apply(const char* name, SkinnedEffect& effect, Matrix bones[], const int changedBones)
+{
+	DWORD dwords = 0;
+
+	for (int frame = 0; frame < Frames; frame++)
+	{
+		for (int i = 0; i < changedBones; i++)
+		{
+			bones[i] = Matrix::CreateRotationZ(0.001f * frame + i) * Matrix::CreateTranslation((float)i, 0.0f, 0.0f);
+		}
+		effect.SetBoneTransforms(bones, SkinnedEffect::MaxBones);
+
+		const DWORD start = Mark();
+		effect.OnApply();
+		dwords += Mark() - start;
+
+		pb_reset();
+	}
+
+	printf("  %-34s %8.1f dwords/apply\n", name, (double)dwords / Frames);
+	return (double)dwords / Frames;
+}
+
+int main()
+{
+	PresentationParameters presentationParameters;
+	presentationParameters.BackBufferWidth = 640;
+	presentationParameters.BackBufferHeight = 480;
+
+	GraphicsDevice device(null, &presentationParameters);
+	SkinnedEffect effect(&device);
+	Matrix bones[SkinnedEffect::MaxBones];
+
+	for (int i = 0; i < SkinnedEffect::MaxBones; i++)
+	{
+		bones[i] = Matrix::CreateRotationY(0.1f * i) * Matrix::CreateTranslation(0.0f, (float)i, 0.0f);
+	}
+
+	for (int i = 0; i < Count; i++)
+	{
+		vertices[i].Position[0] = (float)(i % 97);
+		vertices[i].Position[1] = (float)(i % 89) * 0.5f;
+		vertices[i].Position[2] = (float)(i % 83) * -0.25f;
+		vertices[i].Normal[0] = 0.6f;
+		vertices[i].Normal[1] = (float)(i % 7) * 0.1f;
+		vertices[i].Normal[2] = -0.8f;
+
+		for (int j = 0; j < 4; j++)
+		{
+			vertices[i].Indices[j] = (byte)((i + j * 7) % SkinnedEffect::MaxBones);
+		}
+
+		vertices[i].TextureCoordinate[0] = vertices[i].TextureCoordinate[1] = 0.0f;
+	}
+
+	printf("SkinningBench, %d bones:\n", SkinnedEffect::MaxBones);
+
+	// The first apply loads the program and the whole palette, after that only the bones that move are sent.
+	effect.SetBoneTransforms(bones, SkinnedEffect::MaxBones);
+	effect.OnApply();
+	pb_reset();
+
+	const double full = Apply("every bone moving", effect, bones, SkinnedEffect::MaxBones);
+	const double upperBody = Apply("12 bones moving", effect, bones, 12);
+	const double still = Apply("unchanged pose", effect, bones, 0);
+
+	// An unchanged pose only sends the 35 dwords of constants.
+	CHECK(still == 35.0);
+	CHECK(upperBody < full);
+
+	const VertexElement elements[] =
+	{
+		VertexElement(0, VertexElementFormat::Vector3, VertexElementUsage::Position, 0),
+		VertexElement(12, VertexElementFormat::Vector3, VertexElementUsage::Normal, 0),
+		VertexElement(24, VertexElementFormat::Byte4, VertexElementUsage::BlendIndices, 0),
+		VertexElement(28, VertexElementFormat::Vector4, VertexElementUsage::BlendWeight, 0),
+		VertexElement(44, VertexElementFormat::Vector2, VertexElementUsage::TextureCoordinate, 0)
+	};
+	const int weightCounts[] = { 1, 2, 4 };
+
+#if __SSE__
+	printf("SkinningBench (SSE), %d vertices:\n", Count);
+#else
+	printf("SkinningBench (scalar), %d vertices:\n", Count);
+#endif
+
+	for (int w = 0; w < 3; w++)
+	{
+		const int weightsPerVertex = weightCounts[w];
+		char name[64];
+
+		effect.setWeightsPerVertex(weightsPerVertex);
+
+		// The weights a vertex uses add up to one, as they do in skinned models.
+		for (int i = 0; i < Count; i++)
+		{
+			for (int j = 0; j < 4; j++)
+			{
+				vertices[i].Weights[j] = (j < weightsPerVertex) ? 1.0f / weightsPerVertex : 0.0f;
+			}
+		}
+
+		const double start = HostSeconds();
+		for (int pass = 0; pass < Passes; pass++)
+		{
+			effect.SkinVertices(vertices, skinned, Count, sizeof(SkinnedVertex), elements, 5);
+		}
+		const double seconds = HostSeconds() - start;
+
+		sprintf(name, "SkinVertices, %d weight%s", weightsPerVertex, (weightsPerVertex > 1) ? "s" : "");
+		printf("  %-34s %8.1f Mvert/s\n", name, (double)Count * Passes / seconds / 1e6);
+
+		// Checked against blending the bone matrices and transforming one vertex at a time.
+		for (int i = 0; i < Count; i++)
+		{
+			Matrix blended = bones[vertices[i].Indices[0]] * vertices[i].Weights[0];
+
+			for (int j = 1; j < weightsPerVertex; j++)
+			{
+				blended = blended + bones[vertices[i].Indices[j]] * vertices[i].Weights[j];
+			}
+
+			const Vector3 position = Vector3::Transform(Vector3(vertices[i].Position[0], vertices[i].Position[1], vertices[i].Position[2]), blended);
+			const Vector3 normal = Vector3::TransformNormal(Vector3(vertices[i].Normal[0], vertices[i].Normal[1], vertices[i].Normal[2]), blended);
+
+			CHECK(Vector3::Distance(Vector3(skinned[i].Position[0], skinned[i].Position[1], skinned[i].Position[2]), position) <= 1e-4f * (1.0f + position.Length()));
+			CHECK(Vector3::Distance(Vector3(skinned[i].Normal[0], skinned[i].Normal[1], skinned[i].Normal[2]), normal) <= 1e-4f * (1.0f + normal.Length()));
+		}
+	}
+
+	return (hostCheckFailures == 0 && hostAssertFailures == 0) ? 0 : 1;
+}
@@ -0,0 +1,137 @@
+// Copyright (C) XFX Team
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without 
+// modification, are permitted provided that the following conditions are met:
+// 
+//* Redistributions of source code must retain the above copyright 
+//notice, this list of conditions and the following disclaimer.
+//* Redistributions in binary form must reproduce the above copyright 
+//notice, this list of conditions and the following disclaimer in the 
+//documentation and/or other materials provided with the distribution.
+//* Neither the name of the copyright holder nor the names of any 
+//contributors may be used to endorse or promote products derived from 
+//this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE 
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF 
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS 
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE 
+// POSSIBILITY OF SUCH DAMAGE.
+
+// Times the vector Transform array overloads against transforming one vector per call.
+// The makefile builds this twice: TransformBench measures the SSE kernels, TransformBenchScalar their scalar fallback.
+
+#include <Matrix.h>
+#include <Quaternion.h>
+#include <Vector3.h>
+#include <Vector4.h>
+
+#include <string.h>
+
+#include "HostTest.h"
+
+using namespace XFX;
+
+// About as many positions as a busy frame of particles and skinned vertices.
+static const int Count = 16384;
+static const int Passes = 200;
+
+static Vector3 positions[Count];
+static Vector3 transformed[Count];
+static Vector3 expected[Count];
+static Vector4 positions4[Count];
+static Vector4 transformed4[Count];
+static float sourceX[Count], sourceY[Count], sourceZ[Count];
+static float destinationX[Count], destinationY[Count], destinationZ[Count];
+
+static void Report(const char* name, const double seconds)
+{
+	printf("  %-34s %8.1f Mvec/s\n", name, (double)Count * Passes / seconds / 1e6);
+}
+
+int main()
+{
+	const Matrix matrix = Matrix::CreateFromYawPitchRoll(0.3f, 1.1f, -0.7f) * Matrix::CreateTranslation(4.0f, -2.0f, 9.0f);
+	const Quaternion rotation = Quaternion::CreateFromYawPitchRoll(0.3f, 1.1f, -0.7f);
+
+	for (int i = 0; i < Count; i++)
+	{
+		positions[i] = Vector3((float)(i % 97), (float)(i % 89) * 0.5f, (float)(i % 83) * -0.25f);
+		positions4[i] = Vector4(positions[i], 1.0f);
+		sourceX[i] = positions[i].X;
+		sourceY[i] = positions[i].Y;
+		sourceZ[i] = positions[i].Z;
+	}
+
+#if __SSE__
+	printf("TransformBench (SSE), %d vectors:\n", Count);
+#else
+	printf("TransformBench (scalar), %d vectors:\n", Count);
+#endif
+
+	double start = HostSeconds();
+	for (int pass = 0; pass < Passes; pass++)
+	{
+		for (int i = 0; i < Count; i++)
+		{
+			Vector3::Transform(positions[i], matrix, expected[i]);
+		}
+	}
+	Report("Vector3 one per call", HostSeconds() - start);
+
+	start = HostSeconds();
+	for (int pass = 0; pass < Passes; pass++)
+	{
+		Vector3::Transform(positions, 0, matrix, transformed, 0, Count);
+	}
+	Report("Vector3 array, matrix", HostSeconds() - start);
+
+	// The batch kernels are checked against the single vector transform they replace.
+	for (int i = 0; i < Count; i++)
+	{
+		CHECK(Vector3::Distance(transformed[i], expected[i]) <= 1e-4f * (1.0f + expected[i].Length()));
+	}
+
+	start = HostSeconds();
+	for (int pass = 0; pass < Passes; pass++)
+	{
+		Vector3::Transform(sourceX, sourceY, sourceZ, matrix, destinationX, destinationY, destinationZ, Count);
+	}
+	Report("Vector3 structure of arrays", HostSeconds() - start);
+
+	// The array overload gathers into the same kernel, so the results are identical.
+	for (int i = 0; i < Count; i++)
+	{
+		CHECK(destinationX[i] == transformed[i].X && destinationY[i] == transformed[i].Y && destinationZ[i] == transformed[i].Z);
+	}
+
+	start = HostSeconds();
+	for (int pass = 0; pass < Passes; pass++)
+	{
+		Vector3::TransformNormal(positions, 0, matrix, transformed, 0, Count);
+	}
+	Report("Vector3 array, TransformNormal", HostSeconds() - start);
+
+	start = HostSeconds();
+	for (int pass = 0; pass < Passes; pass++)
+	{
+		Vector3::Transform(positions, 0, rotation, transformed, 0, Count);
+	}
+	Report("Vector3 array, quaternion", HostSeconds() - start);
+
+	start = HostSeconds();
+	for (int pass = 0; pass < Passes; pass++)
+	{
+		Vector4::Transform(positions4, 0, matrix, transformed4, 0, Count);
+	}
+	Report("Vector4 array, matrix", HostSeconds() - start);
+
+	return (hostCheckFailures == 0 && hostAssertFailures == 0) ? 0 : 1;
+}
@@ -29,15 +29,16 @@ namespace XFX
 			Vector3 Up;
 			Vector3 Velocity;
 
-			AudioEmitter() { }
+			AudioEmitter()
+				: DopplerScale(1.0f), Forward(0.0f, 0.0f, -1.0f), Position(0.0f, 0.0f, 0.0f), Up(0.0f, 1.0f, 0.0f), Velocity(0.0f, 0.0f, 0.0f)
+			{
+			}
 
 			const Type& GetType()
 			{
 				return AudioEmitterTypeInfo;
 			}
 		};
-
-		const Type AudioEmitter::AudioEmitterTypeInfo = Type("AudioEmitter", "XFX::Audio::AudioEmitter", TypeCode::Object);
 	}
 }
 
@@ -24,7 +24,10 @@ namespace XFX
 			Vector3 Up;
 			Vector3 Velocity;
 
-			AudioListener() { }
+			AudioListener()
+				: Forward(0.0f, 0.0f, -1.0f), Position(0.0f, 0.0f, 0.0f), Up(0.0f, 1.0f, 0.0f), Velocity(0.0f, 0.0f, 0.0f)
+			{
+			}
 
 			inline int GetType() const { }
 		};
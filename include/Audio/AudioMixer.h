@@ -0,0 +1,91 @@
+/*****************************************************************************
+ *	AudioMixer.h															 *
+ *																			 *
+ *	XFX::Audio::AudioMixer class definition file							 *
+ *	Copyright (c) XFX Team. All Rights Reserved 							 *
+ *****************************************************************************/
+#ifndef _XFX_AUDIO_AUDIOMIXER_
+#define _XFX_AUDIO_AUDIOMIXER_
+
+#include <System/Types.h>
+
+using namespace System;
+
+namespace XFX
+{
+	namespace Audio
+	{
+		class SoundEffect;
+		class SoundEffectInstance;
+
+		/**
+		 * Mixes the playing sound effect instances into 16-bit stereo.
+		 *
+		 * Each voice is resampled to the output rate with linear or cubic (Catmull-Rom) interpolation, following its sample rate, pitch and the doppler shift set by Apply3D.
+		 * Its volume, pan and distance attenuation are then applied, scaled by SoundEffect::MasterVolume.
+		 * Gains are ramped across each block of 64 frames, so volume and pan changes don't click.
+		 *
+		 * Render is called by the audio output, usually on a thread of its own, while the game plays and stops sounds.
+		 * Sound effects and their instances must only be used from one thread at a time.
+		 * This is an XFX extension.
+		 */
+		class AudioMixer
+		{
+		private:
+			friend class SoundEffect;
+			friend class SoundEffectInstance;
+
+			struct Voice;
+
+			static Voice voices[];
+
+			AudioMixer(); // Private constructor to prevent instantiation.
+
+			static bool Add(SoundEffectInstance * const instance);
+			static void Fill(Voice& voice, SoundEffectInstance * const instance, const int count);
+			static void GetGains(SoundEffectInstance * const instance, float& left, float& right);
+			static bool MixVoice(Voice& voice, SoundEffectInstance * const instance, const int count);
+			static void Remove(SoundEffect * const parent);
+			static void Remove(SoundEffectInstance * const instance);
+
+		public:
+			/**
+			 * The maximum number of sound effect instances that can play at once.
+			 */
+			static const int MaxVoices = 64;
+			/**
+			 * The sample rate, in Hertz (Hz), of the mix.
+			 */
+			static const int SampleRate = 48000;
+
+			/**
+			 * Gets the number of sound effect instances that are playing or paused.
+			 */
+			static int getActiveVoiceCount();
+			/**
+			 * Gets whether voices are resampled with cubic rather than linear interpolation.
+			 */
+			static bool getCubicInterpolation();
+			/**
+			 * Sets whether voices are resampled with cubic rather than linear interpolation.
+			 *
+			 * Cubic interpolation attenuates less of the treble of sounds played slower than the output rate, for about twice the CPU time.
+			 */
+			static void setCubicInterpolation(bool value);
+
+			/**
+			 * Mixes the next frameCount frames of the playing voices into output, as interleaved left and right samples.
+			 * Voices that reach the end of their sound stop, and instances created by SoundEffect::Play are deleted.
+			 *
+			 * @param output
+			 * Buffer that receives frameCount * 2 samples.
+			 *
+			 * @param frameCount
+			 * The number of frames to mix.
+			 */
+			static void Render(short output[], const int frameCount);
+		};
+	}
+}
+
+#endif //_XFX_AUDIO_AUDIOMIXER_
@@ -9,35 +9,76 @@
 
 #include <Audio/SoundEffectInstance.h>
 #include <System/Event.h>
-#include <System/Collections/Generic/Queue.h>
 #include <System/TimeSpan.h>
 
 using namespace System;
-using namespace System::Collections::Generic;
 
 namespace XFX
 {
+	class FrameworkDispatcher;
+
 	namespace Audio
 	{
+		class AudioBufferQueue;
+
 		/**
 		 * Provides properties, methods, and events for play back of the audio buffer.
+		 *
+		 * Submitted buffers are queued without locking, so one thread (such as a decoder) can submit buffers while the audio output reads them on another.
+		 * Only one thread may submit buffers at a time, and only one may read them.
 		 */
 		class DynamicSoundEffectInstance : public SoundEffectInstance
 		{
 		private:
-			Queue<byte[]> bufferQueue;
-			AudioChannels_t channels;
-			int sampleRate;
+			friend class XFX::FrameworkDispatcher;
+
+			// Every live instance, in a list only used on the game thread, so that FrameworkDispatcher::Update can raise their events.
+			static DynamicSoundEffectInstance* first;
+			static DynamicSoundEffectInstance* dispatchNext;
+			DynamicSoundEffectInstance* next;
+			DynamicSoundEffectInstance* previous;
+
+			AudioBufferQueue* bufferQueue;
+			// Set by the thread reading the samples, and cleared when BufferNeeded is raised on the game thread.
+			volatile int bufferNeededPending;
+			int bufferNeededThreshold;
+			volatile int underrunCount;
+
+			static void DispatchBufferNeeded();
+			int ReadFrames(short destination[], const int count);
+			void Unregister();
 
 		protected:
 			void Dispose(bool disposing);
 
 		public:
 			/**
-			 * The event that occurs when the number of audio capture buffers awaiting playback is less than or equal to two.
+			 * The event that occurs when the number of audio capture buffers awaiting playback is less than or equal to the buffer needed threshold, which is two by default.
+			 *
+			 * The event is raised by Play, and after that by FrameworkDispatcher::Update (called by Game every frame) whenever the thread that reads the samples
+			 * has finished a buffer or run out of them since the last update. Handlers run on the game thread, so they may submit buffers, stop or dispose of the instance.
 			 */
 			EventHandler BufferNeeded;
 
+			/**
+			 * Gets the number of pending buffers at or below which BufferNeeded is raised. This is an XFX extension.
+			 */
+			int getBufferNeededThreshold() const;
+			/**
+			 * Sets the number of pending buffers at or below which BufferNeeded is raised. This is an XFX extension.
+			 *
+			 * Raising the threshold gives the producer more time to decode the next buffer, at the cost of more buffers in flight.
+			 */
+			void setBufferNeededThreshold(int value);
+			/**
+			 * Gets the number of audio buffers queued for playback.
+			 */
+			int getPendingBufferCount() const;
+			/**
+			 * Gets the number of times the audio output ran out of submitted buffers while playing. This is an XFX extension.
+			 */
+			int getUnderrunCount() const;
+
 			/**
 			 * Initializes a new instance of this class, which creates a dynamic sound effect based on the specified sample rate and audio channel.
 			 * 
@@ -51,6 +92,7 @@ namespace XFX
 			 * 
 			 */
 			DynamicSoundEffectInstance(int sampleRate, AudioChannels_t channels);
+			~DynamicSoundEffectInstance();
 
 			/**
 			 * Returns the sample duration based on the specified size of the audio buffer.
@@ -82,6 +124,24 @@ namespace XFX
 			 * @throws System::ObjectDisposedException
 			 */
 			void Play();
+			/**
+			 * Copies the next count bytes of submitted audio into buffer, filling any part that has not been submitted yet with silence.
+			 * AudioMixer reads playing instances through this; an audio output that plays the instance by itself may call it instead, from a single thread.
+			 * This is an XFX extension.
+			 *
+			 * @param buffer
+			 * Buffer that receives the audio data, in the format of the submitted buffers.
+			 *
+			 * @param offset
+			 * Offset, in bytes, to the starting position in buffer.
+			 *
+			 * @param count
+			 * Amount, in bytes, of data to read. This must be a multiple of the size of a sample frame.
+			 *
+			 * @return
+			 * The number of bytes copied from submitted buffers; the remainder of count is silence.
+			 */
+			int ReadSamples(byte buffer[], int offset, int count);
 			/**
 			 * Submits an audio buffer for playback. Playback begins at the specified offset, and the byte count determines the size of the sample played.
 			 * 
@@ -98,6 +158,10 @@ namespace XFX
 			 * 
 			 * @throws System::ArgumentException
 			 * 
+			 * @throws System::InvalidOperationException
+			 * 64 buffers are already pending.
+			 * 
+			 * The buffer is queued without being copied; its contents must not be changed while it is pending.
 			 */
 			void SubmitBuffer(byte buffer[], int offset, int count);
 		};
@@ -21,6 +21,7 @@ namespace XFX
 	namespace Audio
 	{
 		class SoundEffectInstance;
+		class WaveDecoder;
 
 		/**
 		 * 
@@ -30,12 +31,19 @@ namespace XFX
 			friend class SoundEffectInstance;
 
 		private:
+			AudioChannels_t channels;
+			WaveDecoder* decoder;
 			static float distanceScale;
 			static float dopplerScale;
 			TimeSpan duration;
+			int frameCount;
 			bool isDisposed;
+			int loopLength;
+			int loopStart;
 			static float masterVolume;
 			int referenceCount;
+			int sampleRate;
+			short* samples;
 			static float speedOfSound;
 			float volume;
 
@@ -54,18 +62,94 @@ namespace XFX
 			static float getSpeedOfSound();
 			static void setSpeedOfSound(float value);
 
+			/**
+			 * Creates a sound effect from 16-bit PCM data, which is copied.
+			 *
+			 * @param buffer
+			 * Buffer that contains the audio data, as interleaved little-endian samples.
+			 *
+			 * @param offset
+			 * Offset, in bytes, to the starting position of the data.
+			 *
+			 * @param count
+			 * Amount, in bytes, of data. This must be a multiple of the size of a sample frame.
+			 *
+			 * @param sampleRate
+			 * Sample rate, in Hertz (Hz), of the audio data, between 8000 and 48000.
+			 *
+			 * @param channels
+			 * Number of channels in the audio data.
+			 *
+			 * @param loopStart
+			 * The first frame that a looped instance repeats.
+			 *
+			 * @param loopLength
+			 * The number of frames that a looped instance repeats, or 0 to repeat the whole sound.
+			 */
 			SoundEffect(byte buffer[], const int offset, const int count, const int sampleRate, AudioChannels_t channels, const int loopStart, const int loopLength);
+			/**
+			 * Creates an empty sound effect. Since a C++ array doesn't carry its length, the overload that takes an offset and count is needed to create one with data.
+			 */
 			SoundEffect(byte buffer[], const int sampleRate, const AudioChannels_t numChannels);
 			SoundEffect(const SoundEffect &obj);
 			~SoundEffect();
 
 			SoundEffectInstance* CreateInstance();
 			void Dispose();
+			/**
+			 * Creates a sound effect from a RIFF WAVE file holding 8 or 16-bit PCM, IMA ADPCM or Xbox ADPCM data, which is decoded into memory.
+			 * A "smpl" chunk sets the loop region of the sound.
+			 *
+			 * @param stream
+			 * The stream to read the file from, starting at its current position.
+			 *
+			 * @return
+			 * The sound effect, or null if the stream does not hold a WAVE file in a supported format.
+			 */
 			static SoundEffect* FromStream(Stream * const stream);
+			/**
+			 * Creates a sound effect from a RIFF WAVE file, optionally playing it from the stream instead of decoding it into memory.
+			 * This is an XFX extension.
+			 *
+			 * Streaming suits long music and ambience tracks: each instance decodes the file a block at a time as it plays,
+			 * holding no more than 4 KB of it, plus one decoded block.
+			 *
+			 * @param stream
+			 * The stream to read the file from, starting at its current position.
+			 * A streamed sound needs a seekable stream, which must stay open until the sound effect is disposed, and which only AudioMixer::Render may then read.
+			 *
+			 * @param streamed
+			 * true to play the sound from the stream.
+			 *
+			 * @return
+			 * The sound effect, or null if the stream does not hold a WAVE file in a supported format.
+			 */
+			static SoundEffect* FromStream(Stream * const stream, const bool streamed);
 			static TimeSpan GetSampleDuration(int sizeInBytes, int sampleRate, AudioChannels_t channels);
 			static int GetSampleSizeInBytes(TimeSpan duration, int sampleRate, AudioChannels_t channels);
 			static const Type& GetType();
+			/**
+			 * Plays the sound effect once, at full volume.
+			 *
+			 * @return
+			 * false if AudioMixer::MaxVoices voices are already playing.
+			 */
 			bool Play();
+			/**
+			 * Plays the sound effect once.
+			 *
+			 * @param volume
+			 * Volume, from 0.0 (silence) to 1.0 (full volume), scaled by MasterVolume.
+			 *
+			 * @param pitch
+			 * Pitch adjustment, from -1.0 (down one octave) to 1.0 (up one octave).
+			 *
+			 * @param pan
+			 * Panning, from -1.0 (left speaker) to 1.0 (right speaker).
+			 *
+			 * @return
+			 * false if AudioMixer::MaxVoices voices are already playing.
+			 */
 			bool Play(const float volume, const float pitch, const float pan);
 		};
 	}
@@ -4,6 +4,9 @@
  *	XFX::Audio::SoundEffectInstance class definition file					 *
  *	Copyright (c) XFX Team. All Rights Reserved 							 *
  *****************************************************************************/
+#ifndef _XFX_AUDIO_SOUNDEFFECTINSTANCE_
+#define _XFX_AUDIO_SOUNDEFFECTINSTANCE_
+
 #include <System/Interfaces.h>
 #include "Enums.h"
 
@@ -17,6 +20,7 @@ namespace XFX
 		class AudioEmitter;
 		class DynamicSoundEffectInstance;
 		class SoundEffect;
+		class WaveDecoder;
 
 		/**
 		 * Provides a single playing, paused, or stopped instance of a SoundEffect sound.
@@ -24,17 +28,36 @@ namespace XFX
 		class SoundEffectInstance : public IDisposable, public Object
 		{
 		private:
+			friend class AudioMixer;
 			friend class SoundEffect;
 			friend class DynamicSoundEffectInstance;
 
+			AudioChannels_t _channels;
+			WaveDecoder* _decoder;
+			float _distanceGain;
+			float _dopplerFactor;
+			bool _fireAndForget;
+			bool _isLooped;
 			float _pan;
 			SoundEffect* _parent;
+			float _pitch;
+			float _positionalPan;
+			int _readPosition;
+			int _sampleRate;
+			volatile SoundState_t _state;
 			float _volume;
 
 			SoundEffectInstance();
 			SoundEffectInstance(SoundEffect * const parent, bool fireAndForget);
 
 			virtual void Dispose(bool disposing);
+			/**
+			 * Copies the next count frames of audio into destination, for AudioMixer. A looped sound wraps around its loop.
+			 *
+			 * @return
+			 * The number of frames copied, which is less than count once a sound that isn't looped has ended.
+			 */
+			virtual int ReadFrames(short destination[], const int count);
 
 		public:
 			bool IsDisposed() const;
@@ -50,7 +73,14 @@ namespace XFX
 
 			~SoundEffectInstance();
 
+			/**
+			 * Positions the sound relative to a listener, setting its distance attenuation, its pan and its doppler shift, all of which add to the Volume, Pan and Pitch properties.
+			 * Sounds fade as listener.Position gets further than SoundEffect::DistanceScale from emitter.Position.
+			 */
 			void Apply3D(AudioListener listener, AudioEmitter emitter);
+			/**
+			 * Positions the sound relative to the first listener; output is always stereo, so the others would not be heard differently.
+			 */
 			void Apply3D(AudioListener listeners[], AudioEmitter emitter);
 			void Dispose();
 			static const Type& GetType();
@@ -62,3 +92,5 @@ namespace XFX
 		};
 	}
 }
+
+#endif //_XFX_AUDIO_SOUNDEFFECTINSTANCE_
@@ -39,9 +39,10 @@ namespace XFX
 		static const int RightPlaneIndex;
 		static const int TopPlaneIndex;
 
-		static Vector3 ComputeIntersection(Plane plane, Ray ray);
-		static Ray ComputeIntersectionLine(Plane p1, Plane p2);
-		void SupportMapping(Vector3 v, out Vector3& result);
+		static Vector3 ComputeIntersection(const Plane& plane, const Ray& ray);
+		static Ray ComputeIntersectionLine(const Plane& p1, const Plane& p2);
+		static bool SeparatedAlong(const Vector3& axis, const Vector3 corners1[], const Vector3 corners2[]);
+		void SupportMapping(const Vector3& v, out Vector3& result);
 
 	public:
 		Plane Bottom();
@@ -49,37 +50,57 @@ namespace XFX
 		Plane Far();
 		Plane Left();
 		Matrix getMatrix();
-		void setMatrix(Matrix value);
+		void setMatrix(const Matrix& value);
 		Plane Near();
 		Plane Right();
 		Plane Top();
 
 		BoundingFrustum();
-		BoundingFrustum(Matrix value);
+		BoundingFrustum(const Matrix& value);
 		BoundingFrustum(const BoundingFrustum &obj); // copy constructor
 
-		ContainmentType_t Contains(BoundingBox box);
-		ContainmentType_t Contains(BoundingFrustum frustrum);
-		ContainmentType_t Contains(BoundingSphere sphere);
-		ContainmentType_t Contains(Vector3 point);
-		void Contains(BoundingBox box, out ContainmentType_t& result);
-		void Contains(BoundingSphere sphere, out ContainmentType_t& result);
-		void Contains(Vector3 point, out ContainmentType_t& result);
+		ContainmentType_t Contains(const BoundingBox& box);
+		ContainmentType_t Contains(const BoundingFrustum& frustrum);
+		ContainmentType_t Contains(const BoundingSphere& sphere);
+		ContainmentType_t Contains(const Vector3& point);
+		void Contains(const BoundingBox& box, out ContainmentType_t& result);
+		void Contains(const BoundingSphere& sphere, out ContainmentType_t& result);
+		void Contains(const Vector3& point, out ContainmentType_t& result);
+		/**
+		 * Culls a structure-of-arrays list of axis-aligned boxes against the frustum.
+		 *
+		 * @param visibility
+		 *		Receives one bit per box (bit i % 32 of element i / 32), set when the box is inside or intersects the frustum. Must hold (count + 31) / 32 elements.
+		 *
+		 * @param lastPlane
+		 *		Optional per-box cache of the plane index (0-5) that last rejected the box. It is tested first and updated on every rejection. May be null.
+		 */
+		void Cull(const float minX[], const float minY[], const float minZ[], const float maxX[], const float maxY[], const float maxZ[], const int count, uint visibility[], byte lastPlane[]) const NONNULL(2, 3, 4, 5, 6, 7, 9);
+		/**
+		 * Culls a structure-of-arrays list of bounding spheres against the frustum.
+		 *
+		 * @param visibility
+		 *		Receives one bit per sphere (bit i % 32 of element i / 32), set when the sphere is inside or intersects the frustum. Must hold (count + 31) / 32 elements.
+		 *
+		 * @param lastPlane
+		 *		Optional per-sphere cache of the plane index (0-5) that last rejected the sphere. It is tested first and updated on every rejection. May be null.
+		 */
+		void Cull(const float centerX[], const float centerY[], const float centerZ[], const float radius[], const int count, uint visibility[], byte lastPlane[]) const NONNULL(2, 3, 4, 5, 7);
 		bool Equals(Object const * const obj) const;
 		bool Equals(const BoundingFrustum other) const;
 		Vector3* GetCorners();
 		void GetCorners(Vector3 corners[]);
 		int GetHashCode() const;
 		static const Type& GetType();
-		bool Intersects(BoundingBox box);
-		bool Intersects(BoundingFrustum frustrum);
-		bool Intersects(BoundingSphere sphere);
-		PlaneIntersectionType_t Intersects(Plane plane);
-		float Intersects(Ray ray);
-		void Intersects(BoundingBox box, out bool& result);
-		void Intersects(BoundingSphere sphere, out bool& result);
-		void Intersects(Plane plane, out PlaneIntersectionType_t& result);
-		void Intersects(Ray ray, out float& result);
+		bool Intersects(const BoundingBox& box);
+		bool Intersects(const BoundingFrustum& frustrum);
+		bool Intersects(const BoundingSphere& sphere);
+		PlaneIntersectionType_t Intersects(const Plane& plane);
+		float Intersects(const Ray& ray);
+		void Intersects(const BoundingBox& box, out bool& result);
+		void Intersects(const BoundingSphere& sphere, out bool& result);
+		void Intersects(const Plane& plane, out PlaneIntersectionType_t& result);
+		void Intersects(const Ray& ray, out float& result);
 		const String ToString() const;
 
 		bool operator==(const BoundingFrustum& other) const;
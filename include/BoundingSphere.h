@@ -22,7 +22,7 @@ namespace XFX
 		Vector3 Center;
 		float Radius;
 		
-		BoundingSphere(const Vector3 center, const float radius);
+		BoundingSphere(const Vector3& center, const float radius);
 		BoundingSphere(const BoundingSphere &obj);
 		BoundingSphere();
 
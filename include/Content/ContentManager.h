@@ -7,8 +7,10 @@
 #ifndef _XFX_CONTENT_CONTENTMANAGER_
 #define _XFX_CONTENT_CONTENTMANAGER_
 
+#include <Content/ContentTypeReader.h>
 #include <System/Collections/Generic/List.h>
 #include <System/Collections/Generic/Dictionary.h>
+#include <System/Delegates.h>
 #include <System/IO/Stream.h>
 #include <System/Interfaces.h>
 #include <System/String.h>
@@ -20,37 +22,141 @@ using namespace System::IO;
 namespace XFX
 {
 	namespace Content
-	{		
+	{
+		class ContentLoadAsyncResult;
+		class ContentReader;
+
 		/**
 		 * The ContentManager is the run-time component which loads managed objects from the binary files produced by the design time content pipeline. It also manages the lifespan of the loaded objects, disposing the content manager will also dispose any assets which are themselves System.IDisposable.
 		 */
 		class ContentManager : public IDisposable, public Object
 		{
+			friend class ContentLoadAsyncResult;
+
 		private:
-			List<IDisposable*> disposableAssets;
-			Dictionary<String, Object*> loadedAssets;
+			// A loaded asset together with what is needed to free it without knowing its type.
+			struct AssetEntry
+			{
+				void* Asset;
+				const Type* AssetType;
+				void (*Release)(void* asset);
+				int ReferenceCount;
+
+				inline bool operator==(const AssetEntry& other) const { return Asset == other.Asset; }
+			};
+
+			Dictionary<String, AssetEntry> loadedAssets;
+			List<ContentLoadAsyncResult*> pendingLoads;
 			bool disposed;
 			IServiceProvider* _provider;
 
+			void AddAsset(const String& assetName, const Type& assetType, void * const asset, void (*release)(void*));
+			// The untyped halves of Load, LoadAsync and EndLoad, which are only templates for the functions that read and free the asset.
+			IAsyncResult* BeginLoad(const String& assetName, const Type& assetType, void* (*read)(ContentReader * const), void (*release)(void*), AsyncCallback callback, Object* state);
+			void CompleteLoad(ContentLoadAsyncResult * const result);
+			void* EndLoad(IAsyncResult * const asyncResult, const Type& assetType);
+			static String GetCleanPath(const String& path);
+			void* LoadAsset(const String& assetName, const Type& assetType, void* (*read)(ContentReader * const), void (*release)(void*));
+			static void QueueLoad(ContentLoadAsyncResult * const result);
+			static void DisposeAsset(IDisposable * const asset);
+			static void DisposeAsset(...);
+			template <class T>
+			static void* ReadAssetThunk(ContentReader * const input);
+			template <class T>
+			static void ReleaseAsset(void * const asset);
+
 		protected:
 			virtual void Dispose(bool disposing);
 			virtual Stream* OpenStream(const String& assetName);
+			void* ReadAsset(const String& assetName, void* (*read)(ContentReader * const));
 			template <class T>
 			T* ReadAsset(const String& assetName); //! usage: T ReadAsset<T>(assetName); where T is the preferred type, i.e. Texture2D*
-			
+
+
 		public:
 			String RootDirectory;
+			IServiceProvider* getServiceProvider() const;
 
 			ContentManager(IServiceProvider* provider);
 			ContentManager(IServiceProvider* provider, const String& rootDirectory);
 			virtual ~ContentManager();
 		
+			/**
+			 * Hands the assets that finished loading in the background over to the cache and invokes their callbacks. Game calls this once per frame, before Update.
+			 * This is an XFX extension.
+			 */
+			void DispatchCompletedLoads();
 			void Dispose();
+			/**
+			 * Completes an asynchronous load started with LoadAsync and returns the asset, waiting for it if it is not finished yet.
+			 * This is an XFX extension.
+			 */
+			template <class T>
+			T* EndLoad(IAsyncResult * const asyncResult);
 			static const Type& GetType();
+			/**
+			 * Loads an asset that has been processed by the Content Pipeline.
+			 * Assets are cached by their cleaned path and reference counted; loading the same asset again returns the cached instance.
+			 * T is read by ContentTypeReaderFor<T>.
+			 */
 			template <class T>
 			T* Load(const String& assetName); //! usage: T Load<T>(assetName); where T is the preferred type, i.e. Texture2D*
+			/**
+			 * Starts loading an asset on the background content thread. The callback runs on the game thread, from DispatchCompletedLoads, once the asset is ready.
+			 * Call EndLoad to get the asset.
+			 * This is an XFX extension.
+			 */
+			template <class T>
+			IAsyncResult* LoadAsync(const String& assetName, AsyncCallback callback, Object* state);
 			virtual void Unload();
+			/**
+			 * Releases one reference to a loaded asset, disposing of it once no references remain.
+			 * This is an XFX extension.
+			 */
+			void UnloadAsset(const String& assetName);
 		};
+
+		///////////////////////////////////////////////////////////////////
+
+		template <class T>
+		T* ContentManager::EndLoad(IAsyncResult * const asyncResult)
+		{
+			return (T*)EndLoad(asyncResult, T::GetType());
+		}
+
+		template <class T>
+		T* ContentManager::Load(const String& assetName)
+		{
+			return (T*)LoadAsset(assetName, T::GetType(), &ReadAssetThunk<T>, &ReleaseAsset<T>);
+		}
+
+		template <class T>
+		IAsyncResult* ContentManager::LoadAsync(const String& assetName, AsyncCallback callback, Object* state)
+		{
+			return BeginLoad(assetName, T::GetType(), &ReadAssetThunk<T>, &ReleaseAsset<T>, callback, state);
+		}
+
+		template <class T>
+		T* ContentManager::ReadAsset(const String& assetName)
+		{
+			return (T*)ReadAsset(assetName, &ReadAssetThunk<T>);
+		}
+
+		template <class T>
+		void* ContentManager::ReadAssetThunk(ContentReader * const input)
+		{
+			return ContentTypeReaderFor<T>::Read(input, null);
+		}
+
+		template <class T>
+		void ContentManager::ReleaseAsset(void * const asset)
+		{
+			T* local = (T*)asset;
+
+			// overload resolution picks the IDisposable version only for assets that implement it
+			DisposeAsset(local);
+			delete local;
+		}
 	}
 }
 
@@ -33,6 +33,8 @@ namespace XFX
 		 */
 		class ContentReader : public BinaryReader
 		{
+			friend class ContentManager;
+
 		private:
 			ContentManager* contentManager;
 			GraphicsDevice* _graphicsDevice;
@@ -40,6 +42,7 @@ namespace XFX
 			static const short XnbVersion;
 
 			static Stream* PrepareStream(Stream * const stream, const String& assetName);
+			void* ReadAsset(void* (*read)(ContentReader * const input));
 
 		public:
 			const String getAssetName() const;
@@ -16,14 +16,24 @@ namespace XFX
 		{
 		protected:
 			// Creates a new instance of ContentTypeReader.
-			ContentTypeReader();
+			ContentTypeReader() { }
 
 			// Reads an object from the current stream.
 			Object* Read(ContentReader * const input, Object * const existingInstance);
 
 			// Reads a strongly typed object from the current stream.
-			T* Read(ContentReader * const input, T* existingInstance) =0;
+			virtual T* Read(ContentReader * const input, T* existingInstance) =0;
+
+		public:
+			virtual ~ContentTypeReader() { }
 		};
+
+		/**
+		 * Reads the assets that ContentManager loads as T. Every type that can be loaded specializes it with
+		 * static T* Read(ContentReader * const input, T* existingInstance), which reads the asset that follows the .xnb header.
+		 */
+		template <typename T>
+		struct ContentTypeReaderFor;
 	}
 }
 
@@ -0,0 +1,29 @@
+/*****************************************************************************
+ *	FrameworkDispatcher.h													 *
+ *																			 *
+ *	XFX::FrameworkDispatcher class definition file							 *
+ *	Copyright (c) XFX Team. All Rights Reserved 							 *
+ *****************************************************************************/
+#ifndef _XFX_FRAMEWORKDISPATCHER_
+#define _XFX_FRAMEWORKDISPATCHER_
+
+namespace XFX
+{
+	/**
+	 * Raises the framework events that are signalled on other threads, such as DynamicSoundEffectInstance::BufferNeeded, on the thread calling Update.
+	 */
+	class FrameworkDispatcher
+	{
+	private:
+		FrameworkDispatcher(); // Private constructor to prevent instantiation.
+
+	public:
+		/**
+		 * Updates the status of various framework components and raises their pending events.
+		 * Game calls this once per frame; programs that don't use Game must call it regularly themselves.
+		 */
+		static void Update();
+	};
+}
+
+#endif //_XFX_FRAMEWORKDISPATCHER_
@@ -25,6 +25,7 @@
 #include "Graphics/PresentationParameters.h"
 #include "Graphics/RenderTarget.h"
 #include "Graphics/RenderTarget2D.h"
+#include "Graphics/SkinnedEffect.h"
 #include "Graphics/SpriteBatch.h"
 #include "Graphics/SpriteFont.h"
 #include "Graphics/Texture.h"
@@ -31,6 +31,8 @@ namespace XFX
 			AlphaTestEffect(AlphaTestEffect const * const cloneSource);
 
 			void OnApply();
+			void OnApplyWorld(const Matrix& world);
+			void SetMatrices(const Matrix& world, const Matrix& view, const Matrix& projection);
 
 		public:
 			float Alpha;
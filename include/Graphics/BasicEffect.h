@@ -30,6 +30,8 @@ namespace XFX
 		protected:
 			BasicEffect(BasicEffect const * const cloneSource);
 			void OnApply();
+			void OnApplyWorld(const Matrix& world);
+			void SetMatrices(const Matrix& world, const Matrix& view, const Matrix& projection);
 
 		public:
 			float Alpha;
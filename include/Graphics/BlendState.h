@@ -36,6 +36,8 @@ namespace XFX
 			bool isBound;
 			int multiSampleMask;
 
+			BlendState(const Blend_t sourceBlend, const Blend_t destinationBlend);
+
 		protected:
 			void Dispose(bool disposing);
 
@@ -47,6 +49,20 @@ namespace XFX
 
 			BlendFunction_t getAlphaBlendFunction() const;
 			void setAlphaBlendFunction(BlendFunction_t value);
+			Blend_t getAlphaDestinationBlend() const;
+			void setAlphaDestinationBlend(Blend_t value);
+			Blend_t getAlphaSourceBlend() const;
+			void setAlphaSourceBlend(Blend_t value);
+			Color getBlendFactor() const;
+			void setBlendFactor(Color value);
+			BlendFunction_t getColorBlendFunction() const;
+			void setColorBlendFunction(BlendFunction_t value);
+			Blend_t getColorDestinationBlend() const;
+			void setColorDestinationBlend(Blend_t value);
+			Blend_t getColorSourceBlend() const;
+			void setColorSourceBlend(Blend_t value);
+			ColorWriteChannels_t getColorWriteChannels() const;
+			void setColorWriteChannels(ColorWriteChannels_t value);
 			int getMultiSampleMask() const;
 			void setMultiSampleMask(int value);
 
@@ -22,7 +22,20 @@ namespace XFX
 			StencilOperation_t counterClockwiseStencilDepthBufferFail;
 			StencilOperation_t counterClockwiseStencilFail;
 			CompareFunction_t counterClockwiseStencilFunction;
+			bool depthBufferEnable;
+			CompareFunction_t depthBufferFunction;
+			bool depthBufferWriteEnable;
 			bool isBound;
+			int referenceStencil;
+			StencilOperation_t stencilDepthBufferFail;
+			bool stencilEnable;
+			StencilOperation_t stencilFail;
+			CompareFunction_t stencilFunction;
+			int stencilMask;
+			StencilOperation_t stencilPass;
+			int stencilWriteMask;
+
+			DepthStencilState(const bool depthBufferEnable, const bool depthBufferWriteEnable);
 
 		protected:
 			void Dispose(bool disposing);
@@ -38,6 +51,28 @@ namespace XFX
 			void setCounterClockwiseStencilFail(StencilOperation_t value);
 			CompareFunction_t getCounterClockwiseStencilFunction() const;
 			void setCounterClockwiseStencilFunction(CompareFunction_t value);
+			bool getDepthBufferEnable() const;
+			void setDepthBufferEnable(bool value);
+			CompareFunction_t getDepthBufferFunction() const;
+			void setDepthBufferFunction(CompareFunction_t value);
+			bool getDepthBufferWriteEnable() const;
+			void setDepthBufferWriteEnable(bool value);
+			int getReferenceStencil() const;
+			void setReferenceStencil(int value);
+			StencilOperation_t getStencilDepthBufferFail() const;
+			void setStencilDepthBufferFail(StencilOperation_t value);
+			bool getStencilEnable() const;
+			void setStencilEnable(bool value);
+			StencilOperation_t getStencilFail() const;
+			void setStencilFail(StencilOperation_t value);
+			CompareFunction_t getStencilFunction() const;
+			void setStencilFunction(CompareFunction_t value);
+			int getStencilMask() const;
+			void setStencilMask(int value);
+			StencilOperation_t getStencilPass() const;
+			void setStencilPass(StencilOperation_t value);
+			int getStencilWriteMask() const;
+			void setStencilWriteMask(int value);
 
 			DepthStencilState();
 			~DepthStencilState();
@@ -13,6 +13,8 @@
 
 namespace XFX
 {
+	struct Matrix;
+
 	namespace Graphics
 	{
 		/**
@@ -20,6 +22,9 @@ namespace XFX
 		 */
 		class Effect : public GraphicsResource
 		{
+			friend class ModelInstanceBatch;
+			friend class ModelMesh;
+
 		private:
 			EffectParameterCollection _parameters;
 			EffectTechniqueCollection _techniques;
@@ -41,6 +46,17 @@ namespace XFX
 			 * Applies the effect state just prior to rendering the effect.
 			 */
 			virtual void OnApply();
+			/**
+			 * Changes only the world matrix of an effect that has just been applied, between draws of instances that share all of its other settings.
+			 * Effects that upload their matrices override this to send just the world transform; the default does nothing.
+			 * This is an XFX extension.
+			 */
+			virtual void OnApplyWorld(const Matrix& world);
+			/**
+			 * Sets the world, view and projection matrices of an effect that has them, before it is applied; the default does nothing.
+			 * This is an XFX extension.
+			 */
+			virtual void SetMatrices(const Matrix& world, const Matrix& view, const Matrix& projection);
 
 		public:
 			/**
@@ -8,7 +8,7 @@
 #define _XFX_GRAPHICS_EFFECTPARAMETERCOLLECTION_
 
 #include <Graphics/EffectParameter.h>
-#include <System/Collections/Generic/Interfaces.h>
+#include <System/Collections/Generic/List.h>
 
 using namespace System;
 using namespace System::Collections::Generic;
@@ -22,6 +22,10 @@ namespace XFX
 		 */
 		class EffectParameterCollection : public IEnumerable<EffectParameter *>, public Object
 		{
+		private:
+			// The parameters of the owning effect, which stays empty until effect code is loaded.
+			List<EffectParameter *> parameters;
+
 		public:
 			/**
 			 * Gets the number of EffectParameter objects in this EffectParameterCollection.
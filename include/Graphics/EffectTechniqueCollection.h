@@ -8,7 +8,7 @@
 #define _XFX_GRAPHICS_EFFECTTECHNIQUECOLLECTION_
 
 #include <Graphics/EffectTechnique.h>
-#include <System/Collections/Generic/Interfaces.h>
+#include <System/Collections/Generic/List.h>
 
 using namespace System;
 using namespace System::Collections::Generic;
@@ -22,6 +22,10 @@ namespace XFX
 		 */
 		class EffectTechniqueCollection : public IEnumerable<EffectTechnique *>, public Object
 		{
+		private:
+			// The techniques of the owning effect, which stays empty until effect code is loaded.
+			List<EffectTechnique *> techniques;
+
 		public:
 			/**
 			 * Gets the number of objects in the collection.
@@ -7,13 +7,17 @@
 #ifndef _XFX_GRAPHICS_GRAPHICSDEVICE_
 #define _XFX_GRAPHICS_GRAPHICSDEVICE_
 
+#include "BlendState.h"
 #include "Color.h"
+#include "DepthStencilState.h"
 #include "DisplayMode.h"
 #include "Enums.h"
 #include "GraphicsAdapter.h"
 #include "IndexBuffer.h"
 #include "PresentationParameters.h"
+#include "RasterizerState.h"
 #include "RenderTarget2D.h"
+#include "SamplerState.h"
 #include "TextureCollection.h"
 #include "VertexBuffer.h"
 #include "Viewport.h"
@@ -33,15 +37,39 @@ namespace XFX
 		 */
 		class GraphicsDevice : public IDisposable, public Object
 		{
+			friend class AlphaTestEffect;
+			friend class BasicEffect;
+			friend class SkinnedEffect;
+			friend class SpriteBatch;
+
 		private:
+			// The 3D class exposes 0x2000 bytes of methods, one 32-bit register every 4 bytes.
+			static const int StateRegisterCount = 0x2000 / 4;
+
 			IndexBuffer* _indices;
+			VertexBuffer* vertexBuffer;
+			int vertexOffset;
 			GraphicsAdapter* _adapter;
 			bool isDisposed;
 			PresentationParameters* p_cachedParameters;
 			TextureCollection textures;
 			Color clearColor;
 			Viewport viewport;
+			const BlendState* blendState;
+			const DepthStencilState* depthStencilState;
+			const RasterizerState* rasterizerState;
+
+			// Shadow of the last value written to each register, so that redundant writes can be dropped before they reach the push buffer.
+			uint stateShadow[StateRegisterCount];
+			uint stateValid[StateRegisterCount / 32];
+			int stateBytesSaved;
+			int lastFrameStateBytesSaved;
 
+			// Writes the filter and address modes of a sampler. The anisotropic filters are applied as linear ones: the NV2A takes the
+			// anisotropy from TX_ENABLE, which is written together with the texture (see SpriteBatch::SetTexture).
+			void ApplySamplerState(const int index, const SamplerState * const samplerState);
+			void InvalidateRenderState();
+			bool UpdateRenderState(const uint method, const uint value);
 			void setPresentationParameters(PresentationParameters* presentationParameters);
 			
 		protected:
@@ -57,7 +85,23 @@ namespace XFX
 			EventHandler DeviceResetting;
 			EventHandler Disposing;
 
+			const BlendState* getBlendState() const;
+			void setBlendState(const BlendState * const value);
+			const DepthStencilState* getDepthStencilState() const;
+			void setDepthStencilState(const DepthStencilState * const value);
+			/**
+			 * Gets or sets index data.
+			 */
+			IndexBuffer* getIndices() const;
+			void setIndices(IndexBuffer * const value);
 			PresentationParameters* getPresentationParameters() const;
+			const RasterizerState* getRasterizerState() const;
+			void setRasterizerState(const RasterizerState * const value);
+			/**
+			 * Gets the number of push buffer bytes that were not sent during the last frame because the render state they set was already current.
+			 * This is an XFX extension.
+			 */
+			int getStateBytesSaved() const;
 			TextureCollection getTextures() const;
 			Viewport getViewport() const;
 			void setViewport(const Viewport value);
@@ -69,6 +113,10 @@ namespace XFX
 			void Clear(const ClearOptions_t options, const Color color, const float depth, const int stencil);
 			void Clear(const ClearOptions_t options, const Vector4 color, const float depth, const int stencil);
 			void Dispose();
+			/**
+			 * Renders primitives from the vertex buffer and the index buffer set on the device.
+			 * The NV2A reads the indices straight from the push buffer, so minVertexIndex and numVertices are not used.
+			 */
 			void DrawIndexedPrimitives(const PrimitiveType_t primitiveType, const int baseVertex, const int minVertexIndex, int numVertices, int startIndex, int primitiveCount);
 			void DrawInstancedPrimitives(const PrimitiveType_t primitiveType, const int baseVertex, const int minVertexIndex, int numVertices, int startIndex, int primitiveCount);
 			void DrawPrimitives(const PrimitiveType_t primitiveType, const int startVertex, const int primitiveCount);
@@ -91,6 +139,17 @@ namespace XFX
 			void Reset();
 			void Reset(PresentationParameters * const presentationParameters);
 			void SetRenderTarget(RenderTarget2D * const renderTarget);
+			/**
+			 * Sets the vertex buffer that vertices are read from.
+			 *
+			 * @param vertexBuffer
+			 * The vertex buffer.
+			 *
+			 * @param vertexOffset
+			 * The offset, in vertices, from the beginning of the buffer.
+			 */
+			void SetVertexBuffer(VertexBuffer * const vertexBuffer, const int vertexOffset);
+			void SetVertexBuffer(VertexBuffer * const vertexBuffer);
 		};
 	}
 }
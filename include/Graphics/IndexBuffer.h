@@ -7,9 +7,15 @@
 #ifndef _XFX_GRAPHICS_INDEXBUFFER_
 #define _XFX_GRAPHICS_INDEXBUFFER_
 
+#include <System/FrameworkResources.h>
+#include <System/String.h>
 #include "Enums.h"
 #include "GraphicsResource.h"
 
+#include <string.h>
+
+#include <sassert.h>
+
 namespace XFX
 {
 	namespace Graphics
@@ -22,7 +28,11 @@ namespace XFX
 		class IndexBuffer : public GraphicsResource
 		{
 		private:
+			friend class GraphicsDevice;
+
 			BufferUsage_t _usage;
+			// The indices, which are copied into the push buffer when drawing.
+			byte* _data;
 			int _indexCount;
 			IndexElementSize_t _elementSize;
 
@@ -30,11 +40,14 @@ namespace XFX
 			void Dispose(bool disposing);
 
 		public:
+			BufferUsage_t getBufferUsage() const;
+			int getIndexCount() const;
+			IndexElementSize_t getIndexElementSize() const;
+
 			IndexBuffer();
 			IndexBuffer(GraphicsDevice * const graphicsDevice, IndexElementSize_t indexElementSize, int indexCount, BufferUsage_t usage);
+			~IndexBuffer();
 
-			template <typename T>
-			void CopyData(int offsetInBytes, T data[], int startIndex, int elementCount, uint options, bool isSetting);
 			template <typename T>
 			void GetData(int offsetInBytes, T data[], int startIndex, int elementCount);
 			template <typename T>
@@ -45,6 +58,54 @@ namespace XFX
 			template <typename T>
 			void SetData(T data[], int startIndex, int elementCount);
 		};
+
+		///////////////////////////////////////////////////////////////////////
+
+		template <typename T>
+		void IndexBuffer::GetData(int offsetInBytes, T data[], int startIndex, int elementCount)
+		{
+			const int size = _indexCount * ((_elementSize == IndexElementSize::SixteenBits) ? 2 : 4);
+
+			sassert(data != null, String::Format("data; %s", FrameworkResources::ArgumentNull_Generic));
+
+			sassert(offsetInBytes >= 0 && startIndex >= 0 && elementCount >= 0 && offsetInBytes + elementCount * (int)sizeof(T) <= size, FrameworkResources::Argument_InvalidOffLen);
+
+			if (data == null || _data == null || offsetInBytes < 0 || startIndex < 0 || elementCount <= 0 || offsetInBytes + elementCount * (int)sizeof(T) > size)
+			{
+				return;
+			}
+
+			memcpy(&data[startIndex], _data + offsetInBytes, elementCount * sizeof(T));
+		}
+
+		template <typename T>
+		void IndexBuffer::GetData(T data[], int startIndex, int elementCount)
+		{
+			GetData(0, data, startIndex, elementCount);
+		}
+
+		template <typename T>
+		void IndexBuffer::SetData(int offsetInBytes, T data[], int startIndex, int elementCount)
+		{
+			const int size = _indexCount * ((_elementSize == IndexElementSize::SixteenBits) ? 2 : 4);
+
+			sassert(data != null, String::Format("data; %s", FrameworkResources::ArgumentNull_Generic));
+
+			sassert(offsetInBytes >= 0 && startIndex >= 0 && elementCount >= 0 && offsetInBytes + elementCount * (int)sizeof(T) <= size, FrameworkResources::Argument_InvalidOffLen);
+
+			if (data == null || _data == null || offsetInBytes < 0 || startIndex < 0 || elementCount <= 0 || offsetInBytes + elementCount * (int)sizeof(T) > size)
+			{
+				return;
+			}
+
+			memcpy(_data + offsetInBytes, &data[startIndex], elementCount * sizeof(T));
+		}
+
+		template <typename T>
+		void IndexBuffer::SetData(T data[], int startIndex, int elementCount)
+		{
+			SetData(0, data, startIndex, elementCount);
+		}
 	}
 }
 
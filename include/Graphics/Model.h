@@ -27,12 +27,27 @@ namespace XFX
 		class Model
 		{
 		private:
+			friend class ModelBone;
+			friend class ModelInstanceBatch;
 			friend class XFX::Content::ModelReader;
 
 			List<ModelBone> bones;
 			List<ModelMesh> meshes;
-			static Matrix* sharedDrawBoneMatrices;
-			static int sharedDrawBoneMatrixCount;
+
+			// The bone hierarchy, flattened into arrays indexed by bone index.
+			List<int> boneParents;				// Index of the parent of each bone, or -1 for a root bone.
+			List<int> boneOrder;				// Every bone index, ordered so that parents come before their children.
+			List<Matrix> boneTransforms;		// Transform of each bone relative to its parent.
+			List<Matrix> absoluteBoneTransforms;// Cached transform of each bone relative to the model.
+			List<byte> dirtyBones;				// Non-zero for bones whose local transform changed since the cache was last updated.
+			int dirtyBoneCount;
+			List<int> bonesToUpdate;			// Scratch list of the bones to recompute, in parent-first order.
+
+			Model();
+
+			void InitializeBones();
+			void SetBoneTransform(const int index, const Matrix& transform);
+			void UpdateAbsoluteBoneTransforms();
 
 		public:
 			/**
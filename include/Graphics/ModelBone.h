@@ -23,6 +23,7 @@ namespace XFX
 
 	namespace Graphics
 	{
+		class Model;
 		class ModelBoneCollection;
 
 		/**
@@ -31,12 +32,17 @@ namespace XFX
 		class ModelBone
 		{
 		private:
+			friend class Model;
 			friend class XFX::Content::ModelReader;
 
 			List<ModelBone> children;
+			int index;
+			Model* model;
 			String name;
 
 		public:
+			ModelBone();
+
 			/**
 			 * Gets a collection of bones that are children of this bone.
 			 */
@@ -50,13 +56,17 @@ namespace XFX
 			 */
 			const String getName() const;
 			/**
-			 * Gets the paremt of this bone.
+			 * Gets the parent of this bone.
 			 */
 			ModelBone* getParent() const;
 			/**
 			 * Gets or sets the matrix used to transform this bone relative to its parent bone.
 			 */
-			Matrix Transform;
+			Matrix getTransform() const;
+			void setTransform(const Matrix& value);
+
+			bool operator!=(const ModelBone& other) const;
+			bool operator==(const ModelBone& other) const;
 		};
 	}
 }
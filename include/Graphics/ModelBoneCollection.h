@@ -27,6 +27,8 @@ namespace XFX
 			ModelBoneCollection(IList<ModelBone> * const list);
 
 		public:
+			using ReadOnlyCollection<ModelBone>::operator[];
+
 			/**
 			 * Finds a bone with a given name if it exists in the collection.
 			 *
@@ -0,0 +1,90 @@
+/*****************************************************************************
+ *	ModelInstanceBatch.h													 *
+ *																			 *
+ *	XFX::Graphics::ModelInstanceBatch class definition file 				 *
+ *	Copyright (c) XFX Team. All Rights Reserved 							 *
+ *****************************************************************************/
+#ifndef _XFX_GRAPHICS_MODELINSTANCEBATCH_
+#define _XFX_GRAPHICS_MODELINSTANCEBATCH_
+
+#include "Effect.h"
+#include "GraphicsResource.h"
+#include <Matrix.h>
+#include <System/Collections/Generic/List.h>
+
+using namespace System::Collections::Generic;
+
+namespace XFX
+{
+	namespace Graphics
+	{
+		class GraphicsDevice;
+		class Model;
+		class ModelMeshPart;
+
+		/**
+		 * Draws many copies of models, such as props and foliage, with as few state changes as possible.
+		 *
+		 * The instances queued between Begin and End are grouped by effect, and by mesh part within each effect.
+		 * Each effect is then applied once, each mesh part's buffers are bound once, and every instance is drawn after changing only the world matrix of the effect.
+		 * The effects of the drawn models keep the view and projection matrices passed to Begin.
+		 * This is an XFX extension.
+		 */
+		class ModelInstanceBatch : public GraphicsResource
+		{
+		private:
+			/**
+			 * The instances of one mesh part queued by a single Draw call, whose world matrices are consecutive in instanceWorlds.
+			 */
+			struct InstanceRun
+			{
+				ModelMeshPart* Part;
+				XFX::Graphics::Effect* Effect;
+				int FirstWorld;
+				int Count;
+
+				inline bool operator==(const InstanceRun& other) const { return (Part == other.Part) && (FirstWorld == other.FirstWorld); }
+			};
+
+			bool inBeginEndPair;
+			Matrix view;
+			Matrix projection;
+			List<Matrix> instanceWorlds;
+			List<InstanceRun> runs;
+
+		public:
+			ModelInstanceBatch(GraphicsDevice * const graphicsDevice);
+
+			/**
+			 * Begins a batch of model instances.
+			 *
+			 * @param view
+			 * The view matrix to draw the instances with.
+			 *
+			 * @param projection
+			 * The projection matrix to draw the instances with.
+			 */
+			void Begin(const Matrix& view, const Matrix& projection);
+			/**
+			 * Queues copies of every mesh of a model.
+			 *
+			 * @param model
+			 * The model to draw. Its meshes are placed by their parent bones, as in Model::Draw.
+			 *
+			 * @param worlds
+			 * The world matrix of each copy.
+			 *
+			 * @param count
+			 * The number of copies.
+			 */
+			void Draw(Model * const model, Matrix const worlds[], const int count);
+			/**
+			 * Draws the queued instances and ends the batch.
+			 */
+			void End();
+			static const Type& GetType();
+		};
+	}
+}
+
+#endif //_XFX_GRAPHICS_MODELINSTANCEBATCH_
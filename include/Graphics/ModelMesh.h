@@ -18,6 +18,11 @@ namespace XFX
 {
 	struct BoundingSphere;
 
+	namespace Content
+	{
+		class ModelReader;
+	}
+
 	namespace Graphics
 	{
 		/**
@@ -25,6 +30,14 @@ namespace XFX
 		 */
 		class ModelMesh
 		{
+		private:
+			friend class Model;
+			friend class ModelInstanceBatch;
+			friend class XFX::Content::ModelReader;
+
+			int parentBone;
+			List<ModelMeshPart> meshParts;
+
 		public:
 			/**
 			 * Gets the BoundingSphere that contains this mesh.
@@ -55,6 +68,9 @@ namespace XFX
 			 * Draws all of the ModelMeshPartObjects in this mesh, using their current Effect settings.
 			 */
 			void Draw();
+
+			bool operator!=(const ModelMesh& other) const;
+			bool operator==(const ModelMesh& other) const;
 		};
 	}
 }
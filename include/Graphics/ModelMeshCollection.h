@@ -27,6 +27,8 @@ namespace XFX
 			ModelMeshCollection(IList<ModelMesh>* list);
 
 		public:
+			using ReadOnlyCollection<ModelMesh>::operator[];
+
 			/**
 			 * Finds a mesh with a given name if it exists in the collection.
 			 *
@@ -13,6 +13,11 @@
 
 namespace XFX
 {
+	namespace Content
+	{
+		class ModelReader;
+	}
+
 	namespace Graphics
 	{
 		/**
@@ -20,6 +25,17 @@ namespace XFX
 		 */
 		class ModelMeshPart
 		{
+		private:
+			friend class ModelInstanceBatch;
+			friend class XFX::Content::ModelReader;
+
+			IndexBuffer* indexBuffer;
+			VertexBuffer* vertexBuffer;
+			int numVertices;
+			int primitiveCount;
+			int startIndex;
+			int vertexOffset;
+
 		public:
 			/**
 			 * Gets or sets the material effect for this mesh part.
@@ -28,7 +44,7 @@ namespace XFX
 			/**
 			 * Gets the index buffer for this mesh part.
 			 */
-			IndexBuffer getIndexBuffer();
+			IndexBuffer* getIndexBuffer();
 			/**
 			 * Gets the number of vertices used during a draw call.
 			 */
@@ -48,11 +64,14 @@ namespace XFX
 			/**
 			 * Gets the vertex buffer for this mesh part.
 			 */
-			VertexBuffer getVertexBuffer();
+			VertexBuffer* getVertexBuffer();
 			/**
 			 * Gets the offset (in vertices) from the top of vertex buffer.
 			 */
 			int getVertexOffset();
+
+			bool operator!=(const ModelMeshPart& other) const;
+			bool operator==(const ModelMeshPart& other) const;
 		};
 	}
 }
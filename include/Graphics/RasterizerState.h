@@ -27,6 +27,8 @@ namespace XFX
 			bool scissorTestEnable;
 			float slopeScaleDepthBias;
 
+			RasterizerState(const CullMode_t cullMode);
+
 		protected:
 			void Dispose(bool disposing);
 
@@ -28,6 +28,8 @@ namespace XFX
 			int maxMipLevel;
 			int mipMapLevelOfDetailBias;
 
+			SamplerState(const TextureFilter_t filter, const TextureAddressMode_t addressMode);
+
 		protected:
 			void Dispose(bool disposing);
 
@@ -0,0 +1,131 @@
+/*****************************************************************************
+ *	SkinnedEffect.h 														 *
+ *																			 *
+ *	XFX::Graphics::SkinnedEffect class definition file						 *
+ *	Copyright (c) XFX Team. All Rights Reserved 							 *
+ *****************************************************************************/
+#ifndef _XFX_GRAPHICS_SKINNEDEFFECT_
+#define _XFX_GRAPHICS_SKINNEDEFFECT_
+
+#include <Graphics/Effect.h>
+#include <Matrix.h>
+#include <Vector3.h>
+
+namespace XFX
+{
+	namespace Graphics
+	{
+		class GraphicsDevice;
+		class Texture2D;
+		struct VertexElement;
+
+		/**
+		 * Contains a configurable effect for rendering skinned character models.
+		 *
+		 * The bone transforms are uploaded to the vertex shader as a palette of constants, and only the bones that changed since the effect was last applied are sent again.
+		 * The vertex shader reads the position from v0, the blend weights from v1, the texture coordinate from v9 and the blend indices from v11.
+		 * Lighting is not applied yet: vertices are colored with (DiffuseColor + EmissiveColor) * Alpha, like an unlit BasicEffect.
+		 */
+		class SkinnedEffect : public Effect
+		{
+		public:
+			/**
+			 * The maximum number of bones: the palette takes three vertex shader constants per bone.
+			 */
+			static const int MaxBones = 29;
+
+		private:
+			Matrix bones[MaxBones];
+			int boneCount;
+			int dirtyFirstBone;
+			int dirtyLastBone;
+			int weightsPerVertex;
+			Matrix viewProjection;
+
+			void UploadBones(const int first, const int last);
+
+		protected:
+			SkinnedEffect(SkinnedEffect const * const cloneSource);
+			void OnApply();
+			void OnApplyWorld(const Matrix& world);
+			void SetMatrices(const Matrix& world, const Matrix& view, const Matrix& projection);
+
+		public:
+			float Alpha;
+			Vector3 AmbientLightColor;
+			Vector3 DiffuseColor;
+			Vector3 EmissiveColor;
+			Vector3 FogColor;
+			bool FogEnabled;
+			float FogEnd;
+			float FogStart;
+			bool PreferPerPixelLighting;
+			Matrix Projection;
+			Vector3 SpecularColor;
+			float SpecularPower;
+			Texture2D* Texture;
+			Matrix View;
+			/**
+			 * Gets or sets the number of per-vertex skinning weights to evaluate, which is either 1, 2, or 4.
+			 */
+			int getWeightsPerVertex() const;
+			void setWeightsPerVertex(const int value);
+			Matrix World;
+
+			SkinnedEffect(GraphicsDevice * const device);
+			~SkinnedEffect();
+
+			Effect* Clone() const;
+			void EnableDefaultLighting();
+			/**
+			 * Gets the bone transform matrices for this effect.
+			 *
+			 * @param boneTransforms
+			 * The array to receive the first count bone transforms.
+			 *
+			 * @param count
+			 * The number of bone transforms to copy.
+			 */
+			void GetBoneTransforms(Matrix boneTransforms[], const int count) const;
+			static const Type& GetType();
+			/**
+			 * Sets an array of skinning bone transform matrices.
+			 * Only the bones whose transform differs from the one previously set are uploaded again when the effect is applied.
+			 *
+			 * @param boneTransforms
+			 * The transforms of bones 0 to count - 1.
+			 *
+			 * @param count
+			 * The number of bone transforms, which can't exceed MaxBones.
+			 */
+			void SetBoneTransforms(Matrix boneTransforms[], const int count);
+			/**
+			 * Skins interleaved vertices on the CPU with the current bone transforms, for vertices that are drawn without this effect.
+			 * The vertices need Position (Vector3), BlendIndices (Byte4) and BlendWeight (Vector4) elements; a Normal (Vector3) element is skinned too if present.
+			 * Only the Position and Normal elements of the destination vertices are written, so their other elements only need to be filled once.
+			 * This is an XFX extension.
+			 *
+			 * @param sourceVertices
+			 * The vertices in their bind pose.
+			 *
+			 * @param destinationVertices
+			 * The vertices to receive the skinned positions and normals. This can be sourceVertices.
+			 *
+			 * @param vertexCount
+			 * The number of vertices.
+			 *
+			 * @param vertexStride
+			 * The size of a vertex, in bytes.
+			 *
+			 * @param elements
+			 * The elements of a vertex.
+			 *
+			 * @param elementCount
+			 * The number of elements.
+			 */
+			void SkinVertices(void const * const sourceVertices, void * const destinationVertices, const int vertexCount, const int vertexStride, VertexElement const * const elements, const int elementCount) const;
+		};
+	}
+}
+
+#endif //_XFX_GRAPHICS_SKINNEDEFFECT_
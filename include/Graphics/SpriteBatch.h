@@ -42,18 +42,45 @@ namespace XFX
 		class SpriteBatch : public GraphicsResource, public Object
 		{
 		private:
+			friend class SpriteFont;
+
+			/**
+			 * A transformed sprite corner as read by the GPU from the vertex ring buffer.
+			 */
+			struct SpriteVertex
+			{
+				float X, Y, Z;
+				uint Color;
+				float U, V;
+			};
+
+			// The number of sprites the vertex ring buffer holds before it wraps around.
+			static const int MaxBatchSize = 2048;
+			// The largest number of vertices a single VB_VERTEX_BATCH entry can draw.
+			static const int MaxVerticesPerBatch = 256;
+
+			SpriteVertex* vertexBuffer;
+			int vertexBufferPosition;
+			Texture2D* currentTexture;
+			List<int> sortIndices;
+
 			bool inBeginEndPair;
 			//SaveStateMode_t saveStateMode;
 			StateBlock* saveState;
 			SpriteSortMode_t spriteSortMode;
 			//SpriteBlendMode_t spriteBlendMode;
 			int spriteQueueCount;
-			BlendState oldBlendState;
-			BlendState blendState;
+			const BlendState* blendState;
+			const SamplerState* samplerState;
+			const DepthStencilState* depthStencilState;
+			const RasterizerState* rasterizerState;
 			List<Sprite> SpriteList;
 
 			void applyGraphicsDeviceSettings();
+			void DrawBatch(const int firstVertex, const int vertexCount);
 			void Flush();
+			void SetTexture(Texture2D * const texture);
+			static void WriteSprite(const Sprite& sprite, SpriteVertex * const vertices);
 			void restoreRenderState();
 			
 		protected:
@@ -24,6 +24,7 @@ namespace XFX
 	namespace Graphics
 	{
 		class SpriteBatch;
+		class TextLayoutCache;
 
 		// Represents a font texture.
 		class SpriteFont : public virtual Object
@@ -31,15 +32,26 @@ namespace XFX
 		private:
 			friend class SpriteBatch;
 
-			List<char> characterMap;
-			List<Rectangle> croppingData;
-			List<Rectangle> glyphData;
-			List<Vector3> kerning;
+			// Everything needed to lay out and draw one character, kept together so that a glyph is a single lookup.
+			struct Glyph
+			{
+				Rectangle Bounds;
+				Rectangle Cropping;
+				float LeftSideBearing;
+				float Width;
+				float RightSideBearing;
+			};
+
+			// The index into glyphs of every char value, or -1 for characters the font doesn't have.
+			short characterIndices[256];
+			Glyph* glyphs;
+			int glyphCount;
 			int lineSpacing;
 			float spacing;
 			Texture2D* textureValue;
+			TextLayoutCache* layoutCache;
 
-			int GetIndexForCharacter(char character);
+			const Glyph* GetGlyph(const char character) const;
 
 			SpriteFont(Texture2D * const texture, const List<Rectangle>& glyphs, const List<Rectangle>& cropping, const List<char>& charMap, const int lineSpacing, const float spacing, const List<Vector3>& kerning);
 
@@ -51,6 +63,19 @@ namespace XFX
 
 			virtual ~SpriteFont();
 
+			/**
+			 * The number of bytes of glyph layouts kept for strings this font has drawn. Strings that are drawn again with the same scale and effects reuse their layout.
+			 * Once the layouts take up more than this, the least recently used ones are dropped.
+			 */
+			int getLayoutCacheCapacity() const;
+			void setLayoutCacheCapacity(const int value);
+			/**
+			 * Returns how many strings were drawn from a cached layout, and how many had to be laid out.
+			 */
+			int LayoutCacheHits() const;
+			int LayoutCacheMisses() const;
+
+			void ClearLayoutCache();
 			Vector2 MeasureString(String& text) const;
 		};
 	}
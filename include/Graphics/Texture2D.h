@@ -8,6 +8,7 @@
 #define _XFX_GRAPHICS_TEXTURE2D_
 
 #include "Texture.h"
+#include <Content/ContentTypeReader.h>
 #include <System/IO/Stream.h>
 #include <System/Types.h>
 
@@ -33,6 +34,7 @@ namespace XFX
 		class Texture2D : public Texture
 		{
 			friend class XFX::Content::Texture2DReader;
+			friend class SpriteBatch;
 
 		private:
 			bool _isDisposed; // True when the texture has been disposed
@@ -68,6 +70,16 @@ namespace XFX
 			bool operator !=(const Texture2D& right) const;
 		};
 	}
+
+	namespace Content
+	{
+		// Lets ContentManager load Texture2D assets; reads them with Texture2DReader.
+		template <>
+		struct ContentTypeReaderFor<XFX::Graphics::Texture2D>
+		{
+			static XFX::Graphics::Texture2D* Read(ContentReader * const input, XFX::Graphics::Texture2D* existingInstance);
+		};
+	}
 }
 
 #endif //_XFX_GRAPHICS_TEXTURE2D_
@@ -1,5 +1,5 @@
 /*****************************************************************************
- *	Rectangle.h																 *
+ *	VertexBuffer.h															 *
  *																			 *
  *	XFX::Graphics::VertexBuffer class definition file						 *
  *	Copyright (c) XFX Team. All Rights Reserved 							 *
@@ -7,9 +7,15 @@
 #ifndef _XFX_GRAPHICS_VERTEXBUFFER_
 #define _XFX_GRAPHICS_VERTEXBUFFER_
 
+#include <System/FrameworkResources.h>
+#include <System/String.h>
 #include "GraphicsResource.h"
 #include "VertexDeclaration.h"
 
+#include <string.h>
+
+#include <sassert.h>
+
 namespace XFX
 {
 	namespace Graphics
@@ -19,9 +25,26 @@ namespace XFX
 		 */
 		class VertexBuffer : public GraphicsResource
 		{
+		private:
+			friend class GraphicsDevice;
+
+			BufferUsage_t bufferUsage;
+			// The vertices, which the GPU reads straight from this memory.
+			byte* data;
+			int vertexCount;
+			VertexDeclaration* vertexDeclaration;
+
+		protected:
+			void Dispose(bool disposing);
+
 		public:
+			BufferUsage_t getBufferUsage() const;
+			int getVertexCount() const;
+			VertexDeclaration* getVertexDeclaration() const;
+
 			VertexBuffer();
 			VertexBuffer(GraphicsDevice * const graphicsDevice, VertexDeclaration vertexDeclaration, int vertexCount, BufferUsage_t usage);
+			~VertexBuffer();
 
 			template <typename T>
 			void GetData(int offsetInBytes, T data[], int startIndex, int elementCount, int vertexStride);
@@ -33,6 +56,64 @@ namespace XFX
 			template <typename T>
 			void SetData(T data[], int startIndex, int elementCount);
 		};
+
+		///////////////////////////////////////////////////////////////////////
+
+		template <typename T>
+		void VertexBuffer::GetData(int offsetInBytes, T data[], int startIndex, int elementCount, int vertexStride)
+		{
+			const int size = (vertexDeclaration != null) ? vertexCount * vertexDeclaration->getVertexStride() : 0;
+
+			sassert(data != null, String::Format("data; %s", FrameworkResources::ArgumentNull_Generic));
+
+			sassert(vertexStride >= (int)sizeof(T) && offsetInBytes >= 0 && startIndex >= 0 && elementCount >= 0 &&
+				(elementCount == 0 || offsetInBytes + (elementCount - 1) * vertexStride + (int)sizeof(T) <= size), FrameworkResources::Argument_InvalidOffLen);
+
+			if (data == null || this->data == null || vertexStride < (int)sizeof(T) || offsetInBytes < 0 || startIndex < 0 || elementCount <= 0 ||
+				offsetInBytes + (elementCount - 1) * vertexStride + (int)sizeof(T) > size)
+			{
+				return;
+			}
+
+			for (int i = 0; i < elementCount; i++)
+			{
+				memcpy(&data[startIndex + i], this->data + offsetInBytes + i * vertexStride, sizeof(T));
+			}
+		}
+
+		template <typename T>
+		void VertexBuffer::GetData(T data[], int startIndex, int elementCount)
+		{
+			GetData(0, data, startIndex, elementCount, sizeof(T));
+		}
+
+		template <typename T>
+		void VertexBuffer::SetData(int offsetInBytes, T data[], int startIndex, int elementCount, int vertexStride)
+		{
+			const int size = (vertexDeclaration != null) ? vertexCount * vertexDeclaration->getVertexStride() : 0;
+
+			sassert(data != null, String::Format("data; %s", FrameworkResources::ArgumentNull_Generic));
+
+			sassert(vertexStride >= (int)sizeof(T) && offsetInBytes >= 0 && startIndex >= 0 && elementCount >= 0 &&
+				(elementCount == 0 || offsetInBytes + (elementCount - 1) * vertexStride + (int)sizeof(T) <= size), FrameworkResources::Argument_InvalidOffLen);
+
+			if (data == null || this->data == null || vertexStride < (int)sizeof(T) || offsetInBytes < 0 || startIndex < 0 || elementCount <= 0 ||
+				offsetInBytes + (elementCount - 1) * vertexStride + (int)sizeof(T) > size)
+			{
+				return;
+			}
+
+			for (int i = 0; i < elementCount; i++)
+			{
+				memcpy(this->data + offsetInBytes + i * vertexStride, &data[startIndex + i], sizeof(T));
+			}
+		}
+
+		template <typename T>
+		void VertexBuffer::SetData(T data[], int startIndex, int elementCount)
+		{
+			SetData(0, data, startIndex, elementCount, sizeof(T));
+		}
 	}
 }
 
@@ -28,6 +28,10 @@ namespace XFX
 			void Dispose(bool disposing);
 
 		public:
+			/**
+			 * Gets the number of elements returned by GetVertexElements. This is an XFX extension.
+			 */
+			int getElementCount() const;
 			int getVertexStride() const;
 
 			VertexDeclaration(int vertexStride, VertexElement const * const elements, const int elementCount);
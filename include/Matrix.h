@@ -19,10 +19,20 @@ namespace XFX
 	
 	/**
 	 * Defines a Matrix.
+	 *
+	 * Arguments are taken by const reference, and every out overload may be passed one of its own arguments as result.
+	 *
+	 * Defining XFX_ALIGNED_MATRIX (for the library and every program using it) places each row of the matrix on a 16-byte boundary,
+	 * which lets Multiply, Invert, Transpose and Decompose use SSE. The kernels use unaligned loads and stores, but the compiler may copy a Matrix
+	 * with aligned moves, so matrices on the heap must still be 16-byte aligned. List allocates its storage with the alignment of its element type.
 	 */
 	struct Matrix : IEquatable<Matrix>, Object
 	{
+#if XFX_ALIGNED_MATRIX
+		float M11 ALIGNED16;
+#else
 		float M11;
+#endif
 		float M12;
 		float M13;
 		float M14;
@@ -39,39 +49,39 @@ namespace XFX
 		float M43;
 		float M44;
 		Vector3 Backward();
-		void Backward(Vector3 vector);
+		void Backward(const Vector3& vector);
 		Vector3 Down();
-		void Down(Vector3 vector);
+		void Down(const Vector3& vector);
 		Vector3 Forward();
-		void Forward(Vector3 vector);
+		void Forward(const Vector3& vector);
 		static const Matrix Identity;
 		Vector3 Left();
-		void Left(Vector3 vector);
+		void Left(const Vector3& vector);
 		Vector3 Right();
-		void Right(Vector3 vector);
+		void Right(const Vector3& vector);
 		Vector3 Translation();
-		void Translation(Vector3 vector);
+		void Translation(const Vector3& vector);
 		Vector3 Up();
-		void Up(Vector3 vector);
+		void Up(const Vector3& vector);
 
 		Matrix(float m11, float m12, float m13, float m14, float m21, float m22, float m23, float m24, float m31, float m32, float m33, float m34, float m41, float m42, float m43, float m44);
 		Matrix(const Matrix& obj);
 		Matrix();
 		
-		static Matrix Add(Matrix matrix1, Matrix matrix2);
-		static void Add(Matrix matrix1, Matrix matrix2, out Matrix& result);
-		static Matrix CreateBillboard(Vector3 objectPosition, Vector3 cameraPosition, Vector3 cameraUpVector, Vector3* cameraForwardVector);
-		static void CreateBillboard(Vector3 objectPosition, Vector3 cameraPosition, Vector3 cameraUpVector, Vector3* cameraForwardVector, out Matrix& result);
-		static Matrix CreateConstrainedBillboard(Vector3 objectPosition, Vector3 cameraPosition, Vector3 rotateAxis, Vector3* cameraForwardVector, Vector3* objectForwardVector);
-		static void CreateConstrainedBillboard(Vector3 objectPosition, Vector3 cameraPosition, Vector3 rotateAxis, Vector3* cameraForwardVector, Vector3* objectForwardVector, out Matrix& result); 
-		static Matrix CreateFromAxisAngle(Vector3 axis,  float angle);
-		static void CreateFromAxisAngle(Vector3 axis, float angle, out Matrix& result);
-		static Matrix CreateFromQuaternion(Quaternion rotation);
-		static void CreateFromQuaternion(Quaternion rotation, out Matrix& result);
+		static Matrix Add(const Matrix& matrix1, const Matrix& matrix2);
+		static void Add(const Matrix& matrix1, const Matrix& matrix2, out Matrix& result);
+		static Matrix CreateBillboard(const Vector3& objectPosition, const Vector3& cameraPosition, const Vector3& cameraUpVector, Vector3* cameraForwardVector);
+		static void CreateBillboard(const Vector3& objectPosition, const Vector3& cameraPosition, const Vector3& cameraUpVector, Vector3* cameraForwardVector, out Matrix& result);
+		static Matrix CreateConstrainedBillboard(const Vector3& objectPosition, const Vector3& cameraPosition, const Vector3& rotateAxis, Vector3* cameraForwardVector, Vector3* objectForwardVector);
+		static void CreateConstrainedBillboard(const Vector3& objectPosition, const Vector3& cameraPosition, const Vector3& rotateAxis, Vector3* cameraForwardVector, Vector3* objectForwardVector, out Matrix& result); 
+		static Matrix CreateFromAxisAngle(const Vector3& axis,  float angle);
+		static void CreateFromAxisAngle(const Vector3& axis, float angle, out Matrix& result);
+		static Matrix CreateFromQuaternion(const Quaternion& rotation);
+		static void CreateFromQuaternion(const Quaternion& rotation, out Matrix& result);
 		static Matrix CreateFromYawPitchRoll(float yaw, float pitch, float roll);
 		static void CreateFromYawPitchRoll(float yaw, float pitch, float roll, out Matrix& result);
-		static Matrix CreateLookAt(Vector3 cameraPosition, Vector3 cameraTarget, Vector3 cameraUpVector);
-		static void CreateLookAt(Vector3 cameraPosition, Vector3 cameraTarget, Vector3 cameraUpVector, out Matrix& result);
+		static Matrix CreateLookAt(const Vector3& cameraPosition, const Vector3& cameraTarget, const Vector3& cameraUpVector);
+		static void CreateLookAt(const Vector3& cameraPosition, const Vector3& cameraTarget, const Vector3& cameraUpVector, out Matrix& result);
 		static Matrix CreateOrthographic(float width, float height, float zNearPlane, float zFarPlane);
 		static void CreateOrthographic(float width, float height, float zNearPlane, float zFarPlane, out Matrix& result);
 		static Matrix CreateOrthographicOffCenter(float left, float right, float bottom, float top, float zNearPlane, float zFarPlane);
@@ -82,8 +92,8 @@ namespace XFX
 		static void CreatePerspectiveFieldOfView(float fieldOfView, float aspectRatio, float nearPlaneDistance, float farPlaneDistance, out Matrix& result);
 		static Matrix CreatePerspectiveOffCenter(float left, float right, float bottom, float top, float nearPlaneDistance, float farPlaneDistance);
 		static void CreatePerspectiveOffCenter(float left, float right, float bottom, float top, float nearPlaneDistance, float farPlaneDistance, out Matrix& result);
-		static Matrix CreateReflection(Plane value);
-		static void CreateReflection(Plane value, out Matrix& result);
+		static Matrix CreateReflection(const Plane& value);
+		static void CreateReflection(const Plane& value, out Matrix& result);
 		static Matrix CreateRotationX(float radians);
 		static void CreateRotationX(float radians, out Matrix& result);
 		static Matrix CreateRotationY(float radians); 
@@ -94,43 +104,43 @@ namespace XFX
 		static void CreateScale(float scale, out Matrix& result);
 		static Matrix CreateScale(float xScale, float yScale, float zScale);
 		static void CreateScale(float xScale, float yScale, float zScale, out Matrix& result);
-		static Matrix CreateScale(Vector3 scales);
-		static void CreateScale(Vector3 scales, out Matrix& result);
-		static Matrix CreateShadow(Vector3 lightDirection, Plane plane);
-		static void CreateShadow(Vector3 lightDirection, Plane plane, out Matrix& result);
+		static Matrix CreateScale(const Vector3& scales);
+		static void CreateScale(const Vector3& scales, out Matrix& result);
+		static Matrix CreateShadow(const Vector3& lightDirection, const Plane& plane);
+		static void CreateShadow(const Vector3& lightDirection, const Plane& plane, out Matrix& result);
 		static Matrix CreateTranslation(float xPosition, float yPosition, float zPosition);
 		static void CreateTranslation(float xPosition, float yPosition, float zPosition, out Matrix& result);
-		static Matrix CreateTranslation(Vector3 position);
-		static void CreateTranslation(Vector3 position, out Matrix& result);
-		static Matrix CreateWorld(Vector3 position, Vector3 forward, Vector3 up);
-		static void CreateWorld(Vector3 position, Vector3 forward, Vector3 up, out Matrix& result);
+		static Matrix CreateTranslation(const Vector3& position);
+		static void CreateTranslation(const Vector3& position, out Matrix& result);
+		static Matrix CreateWorld(const Vector3& position, const Vector3& forward, const Vector3& up);
+		static void CreateWorld(const Vector3& position, const Vector3& forward, const Vector3& up, out Matrix& result);
 		int Decompose(out Vector3& scale, out Quaternion& rotation, out Vector3& translation);
 		float Determinant();
-		static Matrix Divide(Matrix matrix1, Matrix matrix2);
-		static void Divide(Matrix matrix1, Matrix matrix2, out Matrix& result);
-		static Matrix Divide(Matrix matrix1, float divider);
-		static void Divide(Matrix matrix1, float divider, out Matrix& result);
+		static Matrix Divide(const Matrix& matrix1, const Matrix& matrix2);
+		static void Divide(const Matrix& matrix1, const Matrix& matrix2, out Matrix& result);
+		static Matrix Divide(const Matrix& matrix1, float divider);
+		static void Divide(const Matrix& matrix1, float divider, out Matrix& result);
 		bool Equals(Object const * const obj) const;
 		bool Equals(const Matrix other) const;
 		int GetHashCode() const;
 		static const Type& GetType();
-		static Matrix Invert(Matrix matrix);
-		static void Invert(Matrix matrix, out Matrix& result);
-		static Matrix Lerp(Matrix value1, Matrix value2, float amount);
-		static void Lerp(Matrix matrix1, Matrix matrix2, float amount, out Matrix& result);
-		static Matrix Multiply(Matrix matrix1, Matrix matrix2);
-		static void Multiply(Matrix matrix1, Matrix matrix2, out Matrix& result);
-		static Matrix Multiply(Matrix matrix1, float scaleFactor);
-		static void Multiply(Matrix matrix1, float scaleFactor, out Matrix& result);
-		static Matrix Negate(Matrix matrix);
-		static void Negate(Matrix matrix, out Matrix& result);
-		static Matrix Subtract(Matrix matrix1, Matrix matrix2);
-		static void Subtract(Matrix matrix1, Matrix matrix2, out Matrix& result);
+		static Matrix Invert(const Matrix& matrix);
+		static void Invert(const Matrix& matrix, out Matrix& result);
+		static Matrix Lerp(const Matrix& value1, const Matrix& value2, float amount);
+		static void Lerp(const Matrix& matrix1, const Matrix& matrix2, float amount, out Matrix& result);
+		static Matrix Multiply(const Matrix& matrix1, const Matrix& matrix2);
+		static void Multiply(const Matrix& matrix1, const Matrix& matrix2, out Matrix& result);
+		static Matrix Multiply(const Matrix& matrix1, float scaleFactor);
+		static void Multiply(const Matrix& matrix1, float scaleFactor, out Matrix& result);
+		static Matrix Negate(const Matrix& matrix);
+		static void Negate(const Matrix& matrix, out Matrix& result);
+		static Matrix Subtract(const Matrix& matrix1, const Matrix& matrix2);
+		static void Subtract(const Matrix& matrix1, const Matrix& matrix2, out Matrix& result);
 		const String ToString() const;
-		static Matrix Transform(Matrix value, Quaternion rotation);
-		static void Transform(Matrix value, Quaternion rotation, out Matrix& result);
-		static Matrix Transpose(Matrix matrix);
-		static void Transpose(Matrix matrix, out Matrix& result);
+		static Matrix Transform(const Matrix& value, const Quaternion& rotation);
+		static void Transform(const Matrix& value, const Quaternion& rotation, out Matrix& result);
+		static Matrix Transpose(const Matrix& matrix);
+		static void Transpose(const Matrix& matrix, out Matrix& result);
 
 		Matrix operator+(const Matrix& other);
 		Matrix operator/(const Matrix& other);
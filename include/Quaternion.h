@@ -20,48 +20,48 @@ namespace XFX
 		static const Quaternion Identity;
 		
 		Quaternion(float x, float y, float z, float w);
-		Quaternion(Vector3 vectorPart, float scalarPart);
+		Quaternion(const Vector3& vectorPart, float scalarPart);
 		Quaternion(const Quaternion &obj);
 		Quaternion();
 		
-		static Quaternion Add(Quaternion quaternion1, Quaternion quaternion2);
-		static void Add(Quaternion quaternion1, Quaternion quaternion2, out Quaternion& result);
-		static Quaternion Concatenate(Quaternion quaternion1, Quaternion quaternion2);
-		static void Concatenate(Quaternion quaternion1, Quaternion quaternion2, out Quaternion& result);
+		static Quaternion Add(const Quaternion& quaternion1, const Quaternion& quaternion2);
+		static void Add(const Quaternion& quaternion1, const Quaternion& quaternion2, out Quaternion& result);
+		static Quaternion Concatenate(const Quaternion& quaternion1, const Quaternion& quaternion2);
+		static void Concatenate(const Quaternion& quaternion1, const Quaternion& quaternion2, out Quaternion& result);
 		void Conjugate();
-		static Quaternion Conjugate(Quaternion value);
-		static void Conjugate(Quaternion value, out Quaternion& result);
-		static Quaternion CreateFromAxisAngle(Vector3 axis, float angle);
-		static void CreateFromAxisAngle(Vector3 axis, float angle, out Quaternion& result);
-		static Quaternion CreateFromRotationMatrix(Matrix matrix);
-		static void CreateFromRotationMatrix(Matrix matrix, out Quaternion& result);
+		static Quaternion Conjugate(const Quaternion& value);
+		static void Conjugate(const Quaternion& value, out Quaternion& result);
+		static Quaternion CreateFromAxisAngle(const Vector3& axis, float angle);
+		static void CreateFromAxisAngle(const Vector3& axis, float angle, out Quaternion& result);
+		static Quaternion CreateFromRotationMatrix(const Matrix& matrix);
+		static void CreateFromRotationMatrix(const Matrix& matrix, out Quaternion& result);
 		static Quaternion CreateFromYawPitchRoll(float yaw, float pitch, float roll);
 		static void CreateFromYawPitchRoll(float yaw, float pitch, float roll, out Quaternion& result);
-		static Quaternion Divide(Quaternion quaternion1, Quaternion quaternion2);
-		static void Divide(Quaternion quaternion1, Quaternion quaternion2, out Quaternion& result);
-		static float Dot(Quaternion quaternion1, Quaternion quaternion2);
-		static void Dot(Quaternion quaternion1, Quaternion quaternion2, out float& result);
+		static Quaternion Divide(const Quaternion& quaternion1, const Quaternion& quaternion2);
+		static void Divide(const Quaternion& quaternion1, const Quaternion& quaternion2, out Quaternion& result);
+		static float Dot(const Quaternion& quaternion1, const Quaternion& quaternion2);
+		static void Dot(const Quaternion& quaternion1, const Quaternion& quaternion2, out float& result);
 		bool Equals(Object const * const obj) const;
 		bool Equals(const Quaternion obj) const;
 		int GetHashCode() const;
 		static const Type& GetType();
-		static Quaternion Inverse(Quaternion quaternion);
-		static void Inverse(Quaternion quaternion, out Quaternion& result);
+		static Quaternion Inverse(const Quaternion& quaternion);
+		static void Inverse(const Quaternion& quaternion, out Quaternion& result);
 		float Length();
 		float LengthSquared();
-		static Quaternion Lerp(Quaternion quaternion1, Quaternion quaternion2, float amount);
-		static void Lerp(Quaternion quaternion1, Quaternion quaternion2, float amount, out Quaternion& result);
-		static Quaternion Multiply(Quaternion quaternion1, Quaternion quaternion2);
-		static void Multiply(Quaternion quaternion1, Quaternion quaternion2, out Quaternion& result);
-		static Quaternion Multiply(Quaternion quaternion, float scaleFactor);
-		static void Multiply(Quaternion quaternion, float scaleFactor, out Quaternion& result);
-		static Quaternion Negate(Quaternion quaternion);
-		static void Negate(Quaternion quaternion, out Quaternion& result);
+		static Quaternion Lerp(const Quaternion& quaternion1, const Quaternion& quaternion2, float amount);
+		static void Lerp(const Quaternion& quaternion1, const Quaternion& quaternion2, float amount, out Quaternion& result);
+		static Quaternion Multiply(const Quaternion& quaternion1, const Quaternion& quaternion2);
+		static void Multiply(const Quaternion& quaternion1, const Quaternion& quaternion2, out Quaternion& result);
+		static Quaternion Multiply(const Quaternion& quaternion, float scaleFactor);
+		static void Multiply(const Quaternion& quaternion, float scaleFactor, out Quaternion& result);
+		static Quaternion Negate(const Quaternion& quaternion);
+		static void Negate(const Quaternion& quaternion, out Quaternion& result);
 		void Normalize();
-		static Quaternion Slerp(Quaternion quaternion1, Quaternion quaternion2, float amount);
-		static void Slerp(Quaternion quaternion1, Quaternion quaternion2, float amount, out Quaternion& result);
-		static Quaternion Subtract(Quaternion quaternion1, Quaternion quaternion2);
-		static void Subtract(Quaternion quaternion1, Quaternion quaternion2, out Quaternion& result);
+		static Quaternion Slerp(const Quaternion& quaternion1, const Quaternion& quaternion2, float amount);
+		static void Slerp(const Quaternion& quaternion1, const Quaternion& quaternion2, float amount, out Quaternion& result);
+		static Quaternion Subtract(const Quaternion& quaternion1, const Quaternion& quaternion2);
+		static void Subtract(const Quaternion& quaternion1, const Quaternion& quaternion2, out Quaternion& result);
 		char* ToString();
 		
 		Quaternion operator+(const Quaternion& other);
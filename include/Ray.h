@@ -26,7 +26,7 @@ namespace XFX
 		Vector3 Direction;
 		Vector3 Position;
 
-		Ray(const Vector3 direction, const Vector3 position);
+		Ray(const Vector3& direction, const Vector3& position);
 		Ray(const Ray &obj);
 		Ray();
 		
@@ -34,12 +34,12 @@ namespace XFX
 		bool Equals(const Ray other) const;
 		int GetHashCode() const;
 		static const Type& GetType();
-		float Intersects(BoundingBox boundingbox) const;
-		void Intersects(BoundingBox boundingbox, out float& result) const;
-		float Intersects(BoundingSphere sphere) const;
-		void Intersects(BoundingSphere sphere, out float& result) const;
-		float Intersects(Plane plane) const;
-		void Intersects(Plane plane, out float& result) const;
+		float Intersects(const BoundingBox& boundingbox) const;
+		void Intersects(const BoundingBox& boundingbox, out float& result) const;
+		float Intersects(const BoundingSphere& sphere) const;
+		void Intersects(const BoundingSphere& sphere, out float& result) const;
+		float Intersects(const Plane& plane) const;
+		void Intersects(const Plane& plane, out float& result) const;
 		const String ToString() const;
 		
 		bool operator==(const Ray& right) const;
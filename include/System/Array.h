@@ -9,6 +9,7 @@
 #define _SYSTEM_ARRAY_
 
 #include "FrameworkResources.h"
+#include <System/Collections/Generic/ArraySortHelper.h>
 #include <System/Collections/Generic/Interfaces.h>
 #include <System/String.h>
 #include <string.h>
@@ -59,6 +60,42 @@ namespace System
 			memset(&array[startIndex], 0, sizeof(U) * count);
 		}
 
+		/**
+		 * Sorts a range of elements in an array with an introsort. The sort is not stable.
+		 *
+		 * @param comparer
+		 * A functor called as comparer(x, y), or a pointer to an object with a Compare(x, y) method, returning less than zero, zero or greater than zero.
+		 */
+		template <typename U, typename TComparer>
+		inline static void Sort(U array[], const int index, const int length, const TComparer& comparer)
+		{
+			sassert(array != null, String::Format("array; %s", FrameworkResources::ArgumentNull_Generic));
+
+			ArraySortHelper::Sort(array, index, length, comparer);
+		}
+
+		/**
+		 * Sorts a range of elements in an array with a merge sort, keeping equal elements in their original order.
+		 */
+		template <typename U, typename TComparer>
+		inline static void StableSort(U array[], const int index, const int length, const TComparer& comparer)
+		{
+			sassert(array != null, String::Format("array; %s", FrameworkResources::ArgumentNull_Generic));
+
+			ArraySortHelper::StableSort(array, index, length, comparer);
+		}
+
+		/**
+		 * Sorts a range of elements in an array with a stable radix sort on the uint, int or float key returned by keySelector.
+		 */
+		template <typename U, typename TKeySelector>
+		inline static void RadixSort(U array[], const int index, const int length, const TKeySelector& keySelector)
+		{
+			sassert(array != null, String::Format("array; %s", FrameworkResources::ArgumentNull_Generic));
+
+			ArraySortHelper::RadixSort(array, index, length, keySelector);
+		}
+
 		inline void Clear()
 		{
 			Clear(_array, 0, Length);
@@ -116,6 +153,33 @@ namespace System
 			_version++;
 		}
 
+		inline void Sort()
+		{
+			Sort(0, Length, ArraySortHelper::LessThanComparer<T>());
+		}
+
+		template <typename TComparer>
+		inline void Sort(const TComparer& comparer)
+		{
+			Sort(0, Length, comparer);
+		}
+
+		template <typename TComparer>
+		void Sort(const int index, const int length, const TComparer& comparer)
+		{
+			sassert(index >= 0 && length >= 0 && index + length <= Length, "");
+
+			ArraySortHelper::Sort(_array, index, length, comparer);
+			_version++;
+		}
+
+		template <typename TComparer>
+		void StableSort(const TComparer& comparer)
+		{
+			ArraySortHelper::StableSort(_array, 0, Length, comparer);
+			_version++;
+		}
+
 		inline const T& operator[](const int index) const
 		{
 			sassert(index > 0 && index < Length, "");
@@ -255,6 +319,28 @@ namespace System
 			_version++;
 		}
 
+		template <typename TComparer>
+		inline void Sort(const TComparer& comparer)
+		{
+			Sort(0, Length, comparer);
+		}
+
+		template <typename TComparer>
+		void Sort(const int index, const int length, const TComparer& comparer)
+		{
+			sassert(index >= 0 && length >= 0 && index + length <= Length, "");
+
+			ArraySortHelper::Sort(_array, index, length, comparer);
+			_version++;
+		}
+
+		template <typename TComparer>
+		void StableSort(const TComparer& comparer)
+		{
+			ArraySortHelper::StableSort(_array, 0, Length, comparer);
+			_version++;
+		}
+
 		inline const T*& operator[](const int index) const
 		{
 			sassert(index > 0 && index < Length, "");
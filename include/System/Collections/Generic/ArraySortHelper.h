@@ -0,0 +1,451 @@
+/*****************************************************************************
+ *	ArraySortHelper.h														 *
+ *																			 *
+ *	XFX System::Collections::Generic::ArraySortHelper class definition file	 *
+ *	Copyright (c) XFX Team. All Rights Reserved 							 *
+ *****************************************************************************/
+#ifndef _SYSTEM_COLLECTIONS_GENERIC_ARRAYSORTHELPER_
+#define _SYSTEM_COLLECTIONS_GENERIC_ARRAYSORTHELPER_
+
+#include <System/Types.h>
+#include <System/TypeTraits.h>
+
+#include <new>
+#include <stdlib.h>
+#include <string.h>
+
+namespace System
+{
+	namespace Collections
+	{
+		namespace Generic
+		{
+			/**
+			 * Sorting algorithms shared by List<T> and Array<T>.
+			 *
+			 * Comparers are taken as a template parameter so the compiler can inline them. A comparer is either a functor called as comparer(x, y),
+			 * or a pointer to an object with a Compare(x, y) method such as IComparer<T>. Both return less than zero, zero or greater than zero,
+			 * like IComparer<T>::Compare.
+			 */
+			// This helper class is not meant to be used by the end user.
+			// Only XFX source files should reference this class.
+			class ArraySortHelper
+			{
+			private:
+				static const int IntrosortSizeThreshold = 16;
+
+				ArraySortHelper();
+
+				template <typename TComparer>
+				struct Invoker
+				{
+					template <typename T>
+					static inline int Compare(const TComparer& comparer, const T& x, const T& y) { return comparer(x, y); }
+				};
+
+				template <typename TComparer>
+				struct Invoker<TComparer *>
+				{
+					template <typename T>
+					static inline int Compare(TComparer * const comparer, const T& x, const T& y) { return comparer->Compare(x, y); }
+				};
+
+				template <typename T>
+				static inline void Swap(T keys[], const int i, const int j)
+				{
+					T temp = keys[i];
+					keys[i] = keys[j];
+					keys[j] = temp;
+				}
+
+				template <typename T, typename TComparer>
+				static inline void SwapIfGreater(T keys[], const TComparer& comparer, const int a, const int b)
+				{
+					if (Invoker<TComparer>::Compare(comparer, keys[a], keys[b]) > 0)
+					{
+						Swap(keys, a, b);
+					}
+				}
+
+				template <typename T, typename TComparer>
+				static void InsertionSort(T keys[], const int lo, const int hi, const TComparer& comparer)
+				{
+					for (int i = lo; i < hi; i++)
+					{
+						int j = i;
+						T t = keys[i + 1];
+
+						while (j >= lo && Invoker<TComparer>::Compare(comparer, t, keys[j]) < 0)
+						{
+							keys[j + 1] = keys[j];
+							j--;
+						}
+
+						keys[j + 1] = t;
+					}
+				}
+
+				template <typename T, typename TComparer>
+				static void DownHeap(T keys[], int i, const int n, const int lo, const TComparer& comparer)
+				{
+					T d = keys[lo + i - 1];
+
+					while (i <= n / 2)
+					{
+						int child = 2 * i;
+
+						if (child < n && Invoker<TComparer>::Compare(comparer, keys[lo + child - 1], keys[lo + child]) < 0)
+						{
+							child++;
+						}
+
+						if (!(Invoker<TComparer>::Compare(comparer, d, keys[lo + child - 1]) < 0))
+						{
+							break;
+						}
+
+						keys[lo + i - 1] = keys[lo + child - 1];
+						i = child;
+					}
+
+					keys[lo + i - 1] = d;
+				}
+
+				template <typename T, typename TComparer>
+				static void HeapSort(T keys[], const int lo, const int hi, const TComparer& comparer)
+				{
+					int n = hi - lo + 1;
+
+					for (int i = n / 2; i >= 1; i--)
+					{
+						DownHeap(keys, i, n, lo, comparer);
+					}
+
+					for (int i = n; i > 1; i--)
+					{
+						Swap(keys, lo, lo + i - 1);
+						DownHeap(keys, 1, i - 1, lo, comparer);
+					}
+				}
+
+				template <typename T, typename TComparer>
+				static int PickPivotAndPartition(T keys[], const int lo, const int hi, const TComparer& comparer)
+				{
+					// Median of three; afterwards keys[lo] <= pivot <= keys[hi], which bounds both scans below.
+					int middle = lo + ((hi - lo) >> 1);
+
+					SwapIfGreater(keys, comparer, lo, middle);
+					SwapIfGreater(keys, comparer, lo, hi);
+					SwapIfGreater(keys, comparer, middle, hi);
+
+					T pivot = keys[middle];
+					Swap(keys, middle, hi - 1);
+					int left = lo;
+					int right = hi - 1;
+
+					while (left < right)
+					{
+						while (Invoker<TComparer>::Compare(comparer, keys[++left], pivot) < 0) ;
+						while (Invoker<TComparer>::Compare(comparer, pivot, keys[--right]) < 0) ;
+
+						if (left >= right)
+						{
+							break;
+						}
+
+						Swap(keys, left, right);
+					}
+
+					Swap(keys, left, hi - 1);
+					return left;
+				}
+
+				template <typename T, typename TComparer>
+				static void IntroSort(T keys[], const int lo, int hi, int depthLimit, const TComparer& comparer)
+				{
+					while (hi > lo)
+					{
+						int partitionSize = hi - lo + 1;
+
+						if (partitionSize <= IntrosortSizeThreshold)
+						{
+							if (partitionSize == 2)
+							{
+								SwapIfGreater(keys, comparer, lo, hi);
+							}
+							else if (partitionSize == 3)
+							{
+								SwapIfGreater(keys, comparer, lo, hi - 1);
+								SwapIfGreater(keys, comparer, lo, hi);
+								SwapIfGreater(keys, comparer, hi - 1, hi);
+							}
+							else
+							{
+								InsertionSort(keys, lo, hi, comparer);
+							}
+
+							return;
+						}
+
+						if (depthLimit == 0)
+						{
+							HeapSort(keys, lo, hi, comparer);
+							return;
+						}
+
+						depthLimit--;
+
+						int p = PickPivotAndPartition(keys, lo, hi, comparer);
+						IntroSort(keys, p + 1, hi, depthLimit, comparer);
+						hi = p - 1;
+					}
+				}
+
+				// Sorts [lo, hi) using buffer, which has room for at least (hi - lo + 1) / 2 unconstructed elements.
+				template <typename T, typename TComparer>
+				static void MergeSort(T keys[], const int lo, const int hi, T buffer[], const TComparer& comparer)
+				{
+					if (hi - lo <= IntrosortSizeThreshold)
+					{
+						InsertionSort(keys, lo, hi - 1, comparer);
+						return;
+					}
+
+					int middle = lo + ((hi - lo) >> 1);
+
+					MergeSort(keys, lo, middle, buffer, comparer);
+					MergeSort(keys, middle, hi, buffer, comparer);
+
+					// Already in order, which is common for nearly sorted sprite lists.
+					if (!(Invoker<TComparer>::Compare(comparer, keys[middle], keys[middle - 1]) < 0))
+					{
+						return;
+					}
+
+					int count = middle - lo;
+					CopyConstruct(buffer, &keys[lo], count);
+
+					int i = 0;
+					int j = middle;
+					int k = lo;
+
+					// Taking from the left run unless the right element is strictly smaller keeps equal elements in order.
+					while (i < count && j < hi)
+					{
+						if (Invoker<TComparer>::Compare(comparer, keys[j], buffer[i]) < 0)
+						{
+							keys[k++] = keys[j++];
+						}
+						else
+						{
+							keys[k++] = buffer[i++];
+						}
+					}
+
+					while (i < count)
+					{
+						keys[k++] = buffer[i++];
+					}
+
+					Destroy(buffer, count);
+				}
+
+				template <typename T>
+				static void CopyConstruct(T* destination, const T* source, const int count)
+				{
+					if (IsTriviallyCopyable<T>::Value)
+					{
+						memcpy((void*)destination, source, count * sizeof(T));
+					}
+					else
+					{
+						for (int i = 0; i < count; i++)
+						{
+							new (&destination[i]) T(source[i]);
+						}
+					}
+				}
+
+				template <typename T>
+				static void Destroy(T* items, const int count)
+				{
+					if (!IsTriviallyCopyable<T>::Value)
+					{
+						for (int i = 0; i < count; i++)
+						{
+							items[i].~T();
+						}
+					}
+				}
+
+				// Maps keys to unsigned integers whose unsigned order matches the order of the original keys.
+				static inline uint RadixKey(const uint key) { return key; }
+				static inline uint RadixKey(const int key) { return (uint)key ^ 0x80000000u; }
+				static inline uint RadixKey(const float key)
+				{
+					uint bits;
+					memcpy(&bits, &key, sizeof(bits));
+
+					// Negative floats have all bits flipped so that larger magnitudes sort first; positive floats only get the sign bit set.
+					return bits ^ ((uint)((int)bits >> 31) | 0x80000000u);
+				}
+
+				template <typename T>
+				struct Identity
+				{
+					inline T operator()(const T& item) const { return item; }
+				};
+
+			public:
+				/**
+				 * Default comparer for types that provide a < operator.
+				 */
+				template <typename T>
+				struct LessThanComparer
+				{
+					inline int operator()(const T& x, const T& y) const { return (x < y) ? -1 : ((y < x) ? 1 : 0); }
+				};
+
+				/**
+				 * Sorts a range of elements with an introspective sort: quicksort with a median-of-three pivot, switching to heapsort when
+				 * the recursion gets too deep and to insertion sort for small partitions. This sort is not stable.
+				 */
+				template <typename T, typename TComparer>
+				static void Sort(T keys[], const int index, const int length, const TComparer& comparer)
+				{
+					if (length < 2)
+					{
+						return;
+					}
+
+					int depthLimit = 0;
+
+					for (int n = length; n > 0; n >>= 1)
+					{
+						depthLimit++;
+					}
+
+					IntroSort(keys, index, index + length - 1, 2 * depthLimit, comparer);
+				}
+
+				/**
+				 * Sorts a range of elements with a merge sort, keeping equal elements in their original order.
+				 * Allocates a scratch buffer of half the range.
+				 */
+				template <typename T, typename TComparer>
+				static void StableSort(T keys[], const int index, const int length, const TComparer& comparer)
+				{
+					if (length < 2)
+					{
+						return;
+					}
+
+					if (length <= IntrosortSizeThreshold)
+					{
+						InsertionSort(keys, index, index + length - 1, comparer);
+						return;
+					}
+
+					T* buffer = (T*)malloc(((length + 1) / 2) * sizeof(T));
+
+					MergeSort(keys, index, index + length, buffer, comparer);
+
+					free(buffer);
+				}
+
+				/**
+				 * Sorts a range of elements by an integer or floating point key with a stable least-significant-digit radix sort.
+				 * Four 8-bit passes are made over the keys; passes in which every key has the same digit are skipped.
+				 *
+				 * @param keySelector
+				 * A functor returning the sort key (uint, int or float) of an element, e.g. the layer depth or texture id of a sprite.
+				 */
+				template <typename T, typename TKeySelector>
+				static void RadixSort(T items[], const int index, const int length, const TKeySelector& keySelector)
+				{
+					if (length < 2)
+					{
+						return;
+					}
+
+					uint* keys = (uint*)malloc(length * sizeof(uint));
+					int* indices = (int*)malloc(2 * length * sizeof(int));
+					int* source = indices;
+					int* destination = indices + length;
+					int counts[4][256];
+
+					memset(counts, 0, sizeof(counts));
+
+					for (int i = 0; i < length; i++)
+					{
+						uint key = RadixKey(keySelector(items[index + i]));
+
+						keys[i] = key;
+						source[i] = i;
+						counts[0][key & 0xFF]++;
+						counts[1][(key >> 8) & 0xFF]++;
+						counts[2][(key >> 16) & 0xFF]++;
+						counts[3][key >> 24]++;
+					}
+
+					for (int pass = 0; pass < 4; pass++)
+					{
+						int shift = pass * 8;
+
+						if (counts[pass][(keys[0] >> shift) & 0xFF] == length)
+						{
+							continue;
+						}
+
+						int offsets[256];
+						int sum = 0;
+
+						for (int i = 0; i < 256; i++)
+						{
+							offsets[i] = sum;
+							sum += counts[pass][i];
+						}
+
+						for (int i = 0; i < length; i++)
+						{
+							int j = source[i];
+							destination[offsets[(keys[j] >> shift) & 0xFF]++] = j;
+						}
+
+						int* temp = source;
+						source = destination;
+						destination = temp;
+					}
+
+					T* sorted = (T*)malloc(length * sizeof(T));
+
+					for (int i = 0; i < length; i++)
+					{
+						CopyConstruct(&sorted[i], &items[index + source[i]], 1);
+					}
+
+					for (int i = 0; i < length; i++)
+					{
+						items[index + i] = sorted[i];
+					}
+
+					Destroy(sorted, length);
+					free(sorted);
+					free(indices);
+					free(keys);
+				}
+
+				/**
+				 * Sorts a range of integer or floating point values with a radix sort.
+				 */
+				template <typename T>
+				static inline void RadixSort(T keys[], const int index, const int length)
+				{
+					RadixSort(keys, index, length, Identity<T>());
+				}
+			};
+		}
+	}
+}
+
+#endif //_SYSTEM_COLLECTIONS_GENERIC_ARRAYSORTHELPER_
@@ -8,12 +8,17 @@
 #define _SYSTEM_COLLECTIONS_GENERIC_DICTIONARY_
 
 #include <System/Array.h>
+#include <System/FrameworkResources.h>
 #include <System/String.h>
+#include <System/Collections/HashHelpers.h>
 #include "EqualityComparer.h"
 #include "Interfaces.h"
 #include "KeyValuePair.h"
 #include "List.h"
 
+#include <new>
+#include <stdlib.h>
+
 #include <sassert.h>
 
 namespace System
@@ -24,39 +29,39 @@ namespace System
 		{
 			/**
 			 * Represents a collection of keys and values.
+			 *
+			 * Entries are stored in a single flat array and chained through bucket indices rather than pointers, so a lookup touches one int in the bucket array and then walks contiguous memory.
+			 * Removed entries are put on a free list and reused by the next insertion; the table grows to the next prime at least twice its size once the entry array is full.
+			 * NOTE: types used as keys must provide GetHashCode() and an == operator.
 			 */
 			template <class TKey, class TValue>
 			class Dictionary : public IDictionary<TKey, TValue>, public ICollection<KeyValuePair<TKey, TValue> >, public IEnumerable<KeyValuePair<TKey, TValue> >, public Object
 			{
 			private:
-				template <class UKey, class UValue>
+				// Key and Value are constructed in place, so neither type needs a default constructor or an assignment operator.
 				struct Entry
 				{
-					UKey Key;
-					UValue Value;
-					Entry* next;
-
-					Entry(UKey key, UValue value)
-						: Key(key), Value(value), next(NULL)
-					{
-					}
+					int hashCode;	// Lower 31 bits of the key's hash code, -1 if the entry is unused
+					int next;		// Index of the next entry in the same bucket or free list, -1 at the end
+					TKey Key;
+					TValue Value;
 				};
-				static const int defaultCapacity = 4;
-				
-				IEqualityComparer<TKey>* comparer;
-				int _count;
-				Entry<TKey, TValue>** _internalStorage;
+
+				int* _buckets;
+				Entry* _entries;
 				int _size;
+				int _count;
+				int _freeList;
+				int _freeCount;
 				int _version;
 
 				void Add(const KeyValuePair<TKey, TValue>& keyValuePair);
 				bool Contains(const KeyValuePair<TKey, TValue>& keyValuePair) const;
 				void CopyTo(KeyValuePair<TKey, TValue> array[], const int index) const;
-				void EnsureCapacity(int capacity);
-				Entry<TKey, TValue>* FindEntry(const TKey& key) const;
+				int FindEntry(const TKey& key) const;
 				bool Remove(const KeyValuePair<TKey, TValue>& keyValuePair);
 				void Initialize(const int capacity);
-				//void Insert(const TKey& key, const TValue& value, const bool add);
+				void Insert(const TKey& key, const TValue& value, const bool add);
 				void Resize();
 
 			public:
@@ -116,6 +121,7 @@ namespace System
 				Dictionary();
 				Dictionary(const IDictionary<TKey, TValue>* dictionary);
 				Dictionary(const int capacity);
+				Dictionary(const Dictionary<TKey, TValue>& obj);
 				virtual ~Dictionary();
 
 				void Add(const TKey& key, const TValue& value);
@@ -125,17 +131,22 @@ namespace System
 				IEnumerator<KeyValuePair<TKey, TValue> >* GetEnumerator();
 				static const Type& GetType();
 				bool Remove(const TKey& key);
-				bool TryGetValue(const TKey& key, out TValue value) const;
+				bool TryGetValue(const TKey& key, out TValue& value) const;
+
+				Dictionary<TKey, TValue>& operator=(const Dictionary<TKey, TValue>& right);
 
 			private:
 				struct DictionaryEnumerator : IEnumerator<KeyValuePair<TKey, TValue> >
 				{
 				private:
 					Dictionary<TKey, TValue>* _parentDictionary;
-					Entry<TKey, TValue>* currentEntry;
+					KeyValuePair<TKey, TValue>* _current;
+					int _index;
+					const int _version;
 
 				public:
 					DictionaryEnumerator(Dictionary<TKey, TValue>* _parentDictionary);
+					~DictionaryEnumerator();
 
 					KeyValuePair<TKey, TValue>& Current() const;
 					bool MoveNext();
@@ -148,7 +159,7 @@ namespace System
 			template <class TKey, class TValue>
 			int Dictionary<TKey, TValue>::Count() const
 			{
-				return _count;
+				return _count - _freeCount;
 			}
 
 			template <class TKey, class TValue>
@@ -171,241 +182,260 @@ namespace System
 
 			template <class TKey, class TValue>
 			Dictionary<TKey, TValue>::Dictionary()
-				: _count(0), _size(defaultCapacity), _version(0)
+				: _buckets(null), _entries(null), _size(0), _count(0), _freeList(-1), _freeCount(0), _version(0)
 			{
-				_internalStorage = new Entry<TKey, TValue>*[defaultCapacity];
-
-				for (int i = 0; i < _size; i++)
-					_internalStorage[i] = NULL;
 			}
 
 			template <class TKey, class TValue>
 			Dictionary<TKey, TValue>::Dictionary(const IDictionary<TKey, TValue>* dictionary)
-				: _count(0), _size(dictionary->Keys()->Count()), _version(0)
+				: _buckets(null), _entries(null), _size(0), _count(0), _freeList(-1), _freeCount(0), _version(0)
 			{
-				_internalStorage = new Entry<TKey, TValue>*[_size];
+				sassert(dictionary != null, String::Format("dictionary; %s", FrameworkResources::ArgumentNull_Generic));
 
-				IEnumerator<KeyValuePair<TKey, TValue> >* enumerator = dictionary->GetEnumerator();
-				enumerator->Reset();
+				ICollection<TKey>* keys = dictionary->getKeys();
+				int count = keys->Count();
+				TKey* keyArray = new TKey[count];
+				keys->CopyTo(keyArray, 0);
 
-				while (enumerator->MoveNext())
+				Initialize(count);
+
+				for (int i = 0; i < count; i++)
 				{
-					this->Add(enumerator->Current());
+					TValue value;
+					dictionary->TryGetValue(keyArray[i], value);
+					Insert(keyArray[i], value, true);
 				}
+
+				delete[] keyArray;
+				delete keys;
 			}
 
 			template <class TKey, class TValue>
 			Dictionary<TKey, TValue>::Dictionary(const int capacity)
-				: _count(0), _size(capacity), _version(0)
+				: _buckets(null), _entries(null), _size(0), _count(0), _freeList(-1), _freeCount(0), _version(0)
 			{
-				_internalStorage = new Entry<TKey, TValue>*[capacity];
+				sassert(capacity >= 0, String::Format("capacity; %s", FrameworkResources::ArgumentOutOfRange_NeedNonNegNum));
 
-				for (int i = 0; i < _size; i++)
-					_internalStorage[i] = NULL;
+				if (capacity > 0)
+				{
+					Initialize(capacity);
+				}
+			}
+
+			template <class TKey, class TValue>
+			Dictionary<TKey, TValue>::Dictionary(const Dictionary<TKey, TValue>& obj)
+				: _buckets(null), _entries(null), _size(0), _count(0), _freeList(-1), _freeCount(0), _version(0)
+			{
+				*this = obj;
 			}
 
 			template <class TKey, class TValue>
 			Dictionary<TKey, TValue>::~Dictionary()
 			{
-				for (int i = 0; i < _size; i++)
-				{
-					if (_internalStorage[i] != NULL)
-					{
-						Entry<TKey, TValue>* prevEntry = NULL;
-						Entry<TKey, TValue>* entry = _internalStorage[i];
-						while (entry != NULL)
-						{
-							prevEntry = entry;
-							entry = entry->next;
-							delete prevEntry;
-						}
-					}
-				}
+				Clear();
 
-				delete[] _internalStorage;
+				delete[] _buckets;
+				free(_entries);
 			}
 
 			template <class TKey, class TValue>
 			void Dictionary<TKey, TValue>::Add(const TKey& key, const TValue& value)
 			{
-				int hash = key.GetHashCode() % _size;
-
-				if (_internalStorage[hash] == NULL)
-					_internalStorage[hash] = new Entry<TKey, TValue>(TKey(key), TValue(value));
-				else
-				{
-					Entry<TKey, TValue>* entry = _internalStorage[hash];
-					while (entry->next != NULL)
-						entry = entry->next;
-
-					if (entry->Key == key)
-						return; // throw error
-					else
-						entry->next = new Entry<TKey, TValue>(TKey(key), TValue(value));
-				}
-
-				_count++;
+				Insert(key, value, true);
 			}
 
 			template <class TKey, class TValue>
 			void Dictionary<TKey, TValue>::Add(const KeyValuePair<TKey, TValue>& keyValuePair)
 			{
-				int hash = keyValuePair.Key.GetHashCode() % _size;
-
-				if (_internalStorage[hash] == NULL)
-					_internalStorage[hash] = new Entry<TKey, TValue>(keyValuePair.Key, keyValuePair.Value);
-				else
-				{
-					Entry<TKey, TValue>* entry = _internalStorage[hash];
-					while (entry->next != NULL)
-						entry = entry->next;
-
-					if (entry->Key == keyValuePair.Key)
-						return; // throw error
-					else
-						entry->next = new Entry<TKey, TValue>(keyValuePair.Key, keyValuePair.Value);
-				}
-
-				_count++;
+				Insert(keyValuePair.Key, keyValuePair.Value, true);
 			}
 
 			template <class TKey, class TValue>
 			bool Dictionary<TKey, TValue>::Contains(const KeyValuePair<TKey, TValue>& keyValuePair) const
 			{
-				// TODO: implement
-				return false;
+				int index = FindEntry(keyValuePair.Key);
+
+				return (index >= 0) && (_entries[index].Value == keyValuePair.Value);
 			}
 
 			template <class TKey, class TValue>
 			bool Dictionary<TKey, TValue>::ContainsKey(const TKey& key) const
 			{
-				int hash = key.GetHashCode() % _size;
-
-				if (_internalStorage[hash] != NULL)
-				{
-					Entry<TKey, TValue>* entry = _internalStorage[hash];
-					while (entry->next != NULL)
-						entry = entry->next;
-
-					return (entry->Key == key);
-				}
-				return false;
+				return FindEntry(key) >= 0;
 			}
 
 			template <class TKey, class TValue>
 			bool Dictionary<TKey, TValue>::ContainsValue(const TValue& value) const
 			{
-				// TODO: implement
+				for (int i = 0; i < _count; i++)
+				{
+					if (_entries[i].hashCode >= 0 && _entries[i].Value == value)
+					{
+						return true;
+					}
+				}
+
 				return false;
 			}
 
 			template <class TKey, class TValue>
 			void Dictionary<TKey, TValue>::CopyTo(KeyValuePair<TKey, TValue> array[], const int arrayIndex) const
 			{
-				sassert(false, "Function not implemented.");
+				sassert(array != null, String::Format("array; %s", FrameworkResources::ArgumentNull_Generic));
+
+				sassert(arrayIndex >= 0, String::Format("arrayIndex; %s", FrameworkResources::ArgumentOutOfRange_NeedNonNegNum));
+
+				int index = arrayIndex;
+
+				// Destination elements are re-constructed instead of assigned, since KeyValuePair (and key types such as Type) have const members.
+				for (int i = 0; i < _count; i++)
+				{
+					if (_entries[i].hashCode >= 0)
+					{
+						array[index].~KeyValuePair<TKey, TValue>();
+						new (&array[index]) KeyValuePair<TKey, TValue>(_entries[i].Key, _entries[i].Value);
+						index++;
+					}
+				}
 			}
 
 			template <class TKey, class TValue>
-			void Dictionary<TKey, TValue>::EnsureCapacity(int capacity)
+			int Dictionary<TKey, TValue>::FindEntry(const TKey& key) const
 			{
-				/*if (_actualSize < capacity)
+				if (_buckets != null)
 				{
-					int num = (_size == 0) ? defaultCapacity : _size * 2;
-					if (num > 0x7fefffff)
-					{
-						num = 0x7fefffff;
-					}
-					if (num < capacity)
-					{
-						num = capacity;
-					}
-					
-					if (num != _size)
+					int hashCode = key.GetHashCode() & 0x7FFFFFFF;
+
+					for (int i = _buckets[hashCode % _size]; i >= 0; i = _entries[i].next)
 					{
-						if (num > 0)
-						{
-							Entry<TKey, TValue>** destinationArray = new Entry<TKey, TValue>*[num];
-							if (_count > 0)
-							{
-								for(int i = 0; i < _count; i++)
-								{
-									destinationArray[i] = entries[i];
-								}
-							}
-							delete[] entries;
-							entries = destinationArray;
-						}
-						else
+						if (_entries[i].hashCode == hashCode && _entries[i].Key == key)
 						{
-							delete[] entries;
-							entries = new Entry<TKey, TValue>*[0];
-							
+							return i;
 						}
-						_size = num;
 					}
-				}*/
-			}
+				}
 
-			template <class TKey, class TValue>
-			Dictionary<TKey, TValue>::Entry<TKey, TValue>* Dictionary<TKey, TValue>::FindEntry(const TKey& key) const
-			{
-				// TODO: implement
-				/*for (Entry<TKey, TValue>* e = *entries; e != NULL; e = e->next)
-				{
-					if (e->key == key)
-						return e;
-				}*/
-				return NULL;
+				return -1;
 			}
 
 			template <class TKey, class TValue>
 			const Type& Dictionary<TKey, TValue>::GetType()
 			{
 				static const Type DictionaryTypeInfo("Dictionary", "System::Collections::Generic::Dictionary", TypeCode::Object, true);
-				
+
 				return DictionaryTypeInfo;
 			}
 
-			//template <class TKey, class TValue>
-			//void Dictionary<TKey, TValue>::Insert(const TKey& key, const TValue& value, const bool add)
-			//{
-			//	Entry<TKey, TValue>* e = FindEntry(key);
+			template <class TKey, class TValue>
+			void Dictionary<TKey, TValue>::Initialize(const int capacity)
+			{
+				_size = HashHelpers::GetPrime(capacity);
+				_buckets = new int[_size];
+
+				for (int i = 0; i < _size; i++)
+				{
+					_buckets[i] = -1;
+				}
+
+				// Aligned for the entry, so values such as the aligned Matrix layout may be copied with aligned moves.
+				_entries = List<Entry>::Allocate(_size);
+				_freeList = -1;
+			}
+
+			template <class TKey, class TValue>
+			void Dictionary<TKey, TValue>::Insert(const TKey& key, const TValue& value, const bool add)
+			{
+				if (_buckets == null)
+				{
+					Initialize(0);
+				}
+
+				int hashCode = key.GetHashCode() & 0x7FFFFFFF;
+				int targetBucket = hashCode % _size;
+
+				for (int i = _buckets[targetBucket]; i >= 0; i = _entries[i].next)
+				{
+					if (_entries[i].hashCode == hashCode && _entries[i].Key == key)
+					{
+						sassert(!add, "Attempting to add duplicate Key/Value pair to dictionary.");
 
-			//	if (e)
-			//	{
-			//		sassert(!add, "Attempting to add duplicate Key/Value pair to dictionary.");
+						_entries[i].Value.~TValue();
+						new (&_entries[i].Value) TValue(value);
+						_version++;
+						return;
+					}
+				}
 
-			//		e->value = value;
-			//		return;
-			//	}
+				int index;
 
-			//	while(e->next != NULL)
-			//	{
-			//		e = e->next;
-			//	}
+				if (_freeCount > 0)
+				{
+					index = _freeList;
+					_freeList = _entries[index].next;
+					_freeCount--;
+				}
+				else
+				{
+					if (_count == _size)
+					{
+						Resize();
+						targetBucket = hashCode % _size;
+					}
 
-			//	// e now points to the last element in the list
-			//	e->next = new Entry<TKey, TValue>();
-			//	e = e->next;
-			//	e->key = key;
-			//	e->value = value;
-			//	e->next = NULL;
+					index = _count;
+					_count++;
+				}
 
-			//	_count++;
-			//}
+				Entry& entry = _entries[index];
+				entry.hashCode = hashCode;
+				entry.next = _buckets[targetBucket];
+				new (&entry.Key) TKey(key);
+				new (&entry.Value) TValue(value);
+				_buckets[targetBucket] = index;
+				_version++;
+			}
 
 			template <class TKey, class TValue>
 			bool Dictionary<TKey, TValue>::Remove(const KeyValuePair<TKey, TValue>& keyValuePair)
 			{
-				Entry<TKey, TValue>* e = FindEntry(keyValuePair.Key);
+				return Contains(keyValuePair) && Remove(keyValuePair.Key);
+			}
+
+			template <class TKey, class TValue>
+			void Dictionary<TKey, TValue>::Resize()
+			{
+				int newSize = HashHelpers::GetPrime(_count * 2);
+				int* newBuckets = new int[newSize];
 
-				if (e)
+				for (int i = 0; i < newSize; i++)
 				{
-					// TODO: implement
-					return true;
+					newBuckets[i] = -1;
 				}
 
-				return false;
+				Entry* newEntries = List<Entry>::Allocate(newSize);
+
+				// Resize only happens when there are no free entries, so every entry below _count is in use.
+				for (int i = 0; i < _count; i++)
+				{
+					Entry& entry = newEntries[i];
+					int bucket = _entries[i].hashCode % newSize;
+
+					entry.hashCode = _entries[i].hashCode;
+					entry.next = newBuckets[bucket];
+					new (&entry.Key) TKey(_entries[i].Key);
+					new (&entry.Value) TValue(_entries[i].Value);
+					newBuckets[bucket] = i;
+
+					_entries[i].Key.~TKey();
+					_entries[i].Value.~TValue();
+				}
+
+				delete[] _buckets;
+				free(_entries);
+
+				_buckets = newBuckets;
+				_entries = newEntries;
+				_size = newSize;
 			}
 
 			template <class TKey, class TValue>
@@ -455,7 +485,18 @@ namespace System
 
 				sassert(arrayIndex >= 0, String::Format("arrayIndex; %s", FrameworkResources::ArgumentOutOfRange_NeedNonNegNum));
 
-				// TODO: implement
+				int index = arrayIndex;
+
+				// Destination elements are re-constructed instead of assigned; see Dictionary::CopyTo.
+				for (int i = 0; i < _dictionary->_count; i++)
+				{
+					if (_dictionary->_entries[i].hashCode >= 0)
+					{
+						array[index].~UKey();
+						new (&array[index]) UKey(_dictionary->_entries[i].Key);
+						index++;
+					}
+				}
 			}
 
 			template <class TKey, class TValue>
@@ -514,7 +555,18 @@ namespace System
 
 				sassert(arrayIndex >= 0, String::Format("arrayIndex; %s", FrameworkResources::ArgumentOutOfRange_NeedNonNegNum));
 
-				// TODO: implement
+				int index = arrayIndex;
+
+				// Destination elements are re-constructed instead of assigned; see Dictionary::CopyTo.
+				for (int i = 0; i < _dictionary->_count; i++)
+				{
+					if (_dictionary->_entries[i].hashCode >= 0)
+					{
+						array[index].~UValue();
+						new (&array[index]) UValue(_dictionary->_entries[i].Value);
+						index++;
+					}
+				}
 			}
 
 			template <class TKey, class TValue>
@@ -529,22 +581,27 @@ namespace System
 			template <class TKey, class TValue>
 			void Dictionary<TKey, TValue>::Clear()
 			{
-				for (int i = 0; i < _size; i++)
+				if (_count > 0)
 				{
-					if (_internalStorage[i] != NULL)
+					for (int i = 0; i < _size; i++)
+					{
+						_buckets[i] = -1;
+					}
+
+					for (int i = 0; i < _count; i++)
 					{
-						Entry<TKey, TValue>* prevEntry = NULL;
-						Entry<TKey, TValue>* entry = _internalStorage[i];
-						while (entry != NULL)
+						if (_entries[i].hashCode >= 0)
 						{
-							prevEntry = entry;
-							entry = entry->next;
-							delete prevEntry;
+							_entries[i].Key.~TKey();
+							_entries[i].Value.~TValue();
 						}
 					}
-				}
 
-				_count = 0;
+					_count = 0;
+					_freeList = -1;
+					_freeCount = 0;
+					_version++;
+				}
 			}
 
 			template <class TKey, class TValue>
@@ -556,32 +613,34 @@ namespace System
 			template <class TKey, class TValue>
 			bool Dictionary<TKey, TValue>::Remove(const TKey& key)
 			{
-				int hash = key.GetHashCode() % _size;
-
-				if (_internalStorage[hash] != NULL)
+				if (_buckets != null)
 				{
-					Entry<TKey, TValue>* prevEntry = NULL;
-					Entry<TKey, TValue>* entry = _internalStorage[hash];
-					while (entry->next != NULL && entry->Key != key)
-					{
-						prevEntry = entry;
-						entry = entry->next;
-					}
-					if (entry->Key == key)
+					int hashCode = key.GetHashCode() & 0x7FFFFFFF;
+					int bucket = hashCode % _size;
+					int last = -1;
+
+					for (int i = _buckets[bucket]; i >= 0; last = i, i = _entries[i].next)
 					{
-						if (prevEntry == NULL)
-						{
-							Entry<TKey, TValue>* nextEntry = entry->next;
-							delete entry;
-							_internalStorage[hash] = nextEntry;
-						}
-						else
+						if (_entries[i].hashCode == hashCode && _entries[i].Key == key)
 						{
-							Entry<TKey, TValue>* next = entry->next;
-							delete entry;
-							prevEntry->next = next;
+							if (last < 0)
+							{
+								_buckets[bucket] = _entries[i].next;
+							}
+							else
+							{
+								_entries[last].next = _entries[i].next;
+							}
+
+							_entries[i].Key.~TKey();
+							_entries[i].Value.~TValue();
+							_entries[i].hashCode = -1;
+							_entries[i].next = _freeList;
+							_freeList = i;
+							_freeCount++;
+							_version++;
+							return true;
 						}
-						return true;
 					}
 				}
 
@@ -589,67 +648,112 @@ namespace System
 			}
 
 			template <class TKey, class TValue>
-			bool Dictionary<TKey, TValue>::TryGetValue(const TKey& key, out TValue value) const
+			bool Dictionary<TKey, TValue>::TryGetValue(const TKey& key, out TValue& value) const
 			{
-				int hash = key.GetHashCode() % _size;
+				int index = FindEntry(key);
 
-				if (_internalStorage[hash] != NULL)
+				if (index >= 0)
 				{
-					// TODO: implement
+					value = _entries[index].Value;
 					return true;
 				}
+
 				return false;
 			}
 
 			template <class TKey, class TValue>
 			Dictionary<TKey, TValue>::DictionaryEnumerator::DictionaryEnumerator(Dictionary<TKey,TValue> *_parentDictionary)
-				: _parentDictionary(_parentDictionary)
+				: _parentDictionary(_parentDictionary), _current(null), _index(0), _version(_parentDictionary->_version)
+			{
+			}
+
+			template <class TKey, class TValue>
+			Dictionary<TKey, TValue>::DictionaryEnumerator::~DictionaryEnumerator()
 			{
+				delete _current;
 			}
 
 			template <class TKey, class TValue>
 			KeyValuePair<TKey, TValue>& Dictionary<TKey, TValue>::DictionaryEnumerator::Current() const
 			{
-				KeyValuePair<TKey, TValue>* kv = new KeyValuePair<TKey,TValue>(currentEntry->Key, currentEntry->Value);
-				return *kv;
+				sassert(_current != null, "Enumeration has either not started or has already finished.");
+
+				return *_current;
 			}
 
 			template <class TKey, class TValue>
 			bool Dictionary<TKey, TValue>::DictionaryEnumerator::MoveNext()
 			{
-				// TODO: implement
-				/*bool canMove = ((Entry<TKey, TValue>*)*(_parentDictionary->entries))->next != null;
-				if (currentEntry == NULL)
-					currentEntry = *(_parentDictionary->entries);
-				else
-					currentEntry = currentEntry->next;*/
+				sassert(_version == _parentDictionary->_version, "Collection was modified; enumeration operation may not execute.");
+
+				delete _current;
+				_current = null;
+
+				while (_index < _parentDictionary->_count)
+				{
+					Entry& entry = _parentDictionary->_entries[_index++];
+
+					if (entry.hashCode >= 0)
+					{
+						_current = new KeyValuePair<TKey, TValue>(entry.Key, entry.Value);
+						return true;
+					}
+				}
+
+				return false;
 			}
 
 			template <class TKey, class TValue>
 			void Dictionary<TKey, TValue>::DictionaryEnumerator::Reset()
 			{
-				currentEntry = NULL;
+				sassert(_version == _parentDictionary->_version, "Collection was modified; enumeration operation may not execute.");
+
+				delete _current;
+				_current = null;
+				_index = 0;
 			}
 
 			template <class TKey, class TValue>
 			TValue& Dictionary<TKey, TValue>::operator [](const TKey& key)
 			{
-				int hash = key.GetHashCode() % _size;
+				int index = FindEntry(key);
+
+				sassert(index >= 0, "The given key was not present in the dictionary."); // KeyNotFoundException
 
-				if (_internalStorage[hash] == NULL)
+				return _entries[index].Value;
+			}
+
+			template <class TKey, class TValue>
+			Dictionary<TKey, TValue>& Dictionary<TKey, TValue>::operator=(const Dictionary<TKey, TValue>& right)
+			{
+				if (this == &right)
 				{
-					sassert(false, ""); // KeyNotFoundException
+					return *this;
 				}
-				else
+
+				Clear();
+
+				if (right.Count() == 0)
+				{
+					return *this;
+				}
+
+				if (_size < right.Count())
 				{
-					Entry<TKey, TValue>* entry = _internalStorage[hash];
-					while (entry != NULL && entry->Key != key)
-						entry = entry->next;
-					if (entry == NULL)
-						sassert(false, ""); // KeyNotFoundException
-					else
-						return entry->Value;
+					delete[] _buckets;
+					free(_entries);
+					Initialize(right.Count());
 				}
+
+				for (int i = 0; i < right._count; i++)
+				{
+					if (right._entries[i].hashCode >= 0)
+					{
+						Insert(right._entries[i].Key, right._entries[i].Value, true);
+					}
+				}
+
+				return *this;
 			}
 		}
 	}
@@ -57,7 +57,7 @@ namespace System
 				virtual void Add(const TKey& key, const TValue& value)=0;
 				virtual bool ContainsKey(const TKey& key)const =0;
 				virtual bool Remove(const TKey& key)=0;
-				virtual bool TryGetValue(const TKey& key, out TValue value)const =0;
+				virtual bool TryGetValue(const TKey& key, out TValue& value)const =0;
 
 				virtual ICollection<TKey>* getKeys()const =0;
 				virtual ICollection<TValue>* getValues()const =0;
@@ -11,8 +11,12 @@
 #include <System/FrameworkResources.h>
 #include <System/Object.h>
 #include <System/String.h>
+#include <System/TypeTraits.h>
+#include "ArraySortHelper.h"
 #include "Interfaces.h"
 
+#include <malloc.h>
+#include <new>
 #include <stdlib.h>
 #include <string.h>
 
@@ -26,10 +30,19 @@ namespace System
 		{
 			// Represents a strongly typed list of objects that can be accessed by index. Provides methods to search, sort, and manipulate lists.
 			// NOTE: types used with the List<T> class must provide at least an == operator.
+			// Only the first Count() elements of the backing store are constructed. Trivially copyable types are moved around with memmove,
+			// everything else is copy-constructed into place and destroyed at its old location, so T needs no default constructor.
+			template <class TKey, class TValue>
+			class Dictionary;
+
 			template <typename T>
 			class List : public IList<T>, public IEnumerable<T>, public Object
 			{
 			private:
+				// Dictionary allocates its entry array with Allocate.
+				template <class TKey, class TValue>
+				friend class Dictionary;
+
 				static const int defaultCapacity = 4;
 				T* _items;
 				int _size;
@@ -53,11 +66,73 @@ namespace System
 					}
 				}
 
-				void swap(T* x, T* y)
+				// Allocates room for count elements, honouring the alignment of T (such as the 16-byte aligned Matrix layout).
+				static T* Allocate(const int count)
+				{
+					return (T*)((__alignof__(T) > 8) ? memalign(__alignof__(T), count * sizeof(T)) : malloc(count * sizeof(T)));
+				}
+
+				// Constructs count elements at destination from source. The ranges must not overlap.
+				static void CopyConstruct(T* destination, const T* source, const int count)
+				{
+					if (IsTriviallyCopyable<T>::Value)
+					{
+						memcpy((void*)destination, source, count * sizeof(T));
+					}
+					else
+					{
+						for (int i = 0; i < count; i++)
+						{
+							new (&destination[i]) T(source[i]);
+						}
+					}
+				}
+
+				static void Destroy(T* items, const int count)
+				{
+					if (!IsTriviallyCopyable<T>::Value)
+					{
+						for (int i = 0; i < count; i++)
+						{
+							items[i].~T();
+						}
+					}
+				}
+
+				// Moves the constructed range [index, _size) up by count slots, leaving [index, index + count) unconstructed.
+				void OpenGap(const int index, const int count)
+				{
+					if (IsTriviallyCopyable<T>::Value)
+					{
+						memmove((void*)&_items[index + count], &_items[index], (_size - index) * sizeof(T));
+					}
+					else
+					{
+						for (int i = _size - 1; i >= index; i--)
+						{
+							new (&_items[i + count]) T(_items[i]);
+							_items[i].~T();
+						}
+					}
+				}
+
+				// Destroys [index, index + count) and moves the elements after it down to close the gap.
+				void CloseGap(const int index, const int count)
 				{
-					T temp = *x;
-					*x = *y;
-					*y = temp;
+					Destroy(&_items[index], count);
+
+					if (IsTriviallyCopyable<T>::Value)
+					{
+						memmove((void*)&_items[index], &_items[index + count], (_size - index - count) * sizeof(T));
+					}
+					else
+					{
+						for (int i = index + count; i < _size; i++)
+						{
+							new (&_items[i - count]) T(_items[i]);
+							_items[i].~T();
+						}
+					}
 				}
 
 				class Enumerator : public IEnumerator<T>
@@ -79,7 +154,7 @@ namespace System
 					{
 						sassert(version == parent->_version, "");
 
-						return index++ < parent->_size;
+						return ++index < parent->_size;
 					}
 
 					void Reset()
@@ -107,25 +182,18 @@ namespace System
 
 					if (value != _actualSize)
 					{
+						T* destinationArray = null;
+
 						if (value > 0)
 						{
-							T* destinationArray = new T[value];
-
-							if (_size > 0)
-							{
-								memcpy(destinationArray, _items, _size * sizeof(T));
-							}
+							destinationArray = Allocate(value);
 
-							delete[] _items;
-							_items = destinationArray;
-						}
-						else
-						{
-							delete[] _items;
-							_items = new T[0];
-							
+							CopyConstruct(destinationArray, _items, _size);
 						}
 
+						Destroy(_items, _size);
+						free(_items);
+						_items = destinationArray;
 						_actualSize = value;
 					}
 				}
@@ -136,28 +204,29 @@ namespace System
 				List()
 					: _size(0), _actualSize(defaultCapacity), _version(0)
 				{
-					_items = new T[_actualSize];
+					_items = Allocate(_actualSize);
 				}
 
 				// Initializes a new instance of the List<> class that is empty and has the specified initial capacity.
 				List(const int capacity)
 					: _size(0), _actualSize((capacity < 0) ? defaultCapacity : capacity), _version(0)
 				{
-					_items = new T[_actualSize];
+					_items = (_actualSize > 0) ? Allocate(_actualSize) : null;
 				}
 
 				// Copy constructor
 				List(const List<T> &obj)
 					: _size(obj._size), _actualSize(obj._actualSize), _version(obj._version)
 				{
-					_items = new T[obj._actualSize];
+					_items = (_actualSize > 0) ? Allocate(_actualSize) : null;
 
-					memcpy(_items, obj._items, obj._size * sizeof(T));
+					CopyConstruct(_items, obj._items, obj._size);
 				}
 
 				~List()
 				{
-					delete[] _items;
+					Destroy(_items, _size);
+					free(_items);
 				}
 
 				/**
@@ -170,13 +239,13 @@ namespace System
 						EnsureCapacity(_size + 1);
 					}
 
-					_items[_size++] = item;
+					new (&_items[_size++]) T(item);
 					_version++;
 				}
 
-				void AddRange(IEnumerable<T> const * const collection)
+				void AddRange(IEnumerable<T> * const collection)
 				{
-					sassert(collection != NULL, "");
+					sassert(collection != NULL, String::Format("collection; %s", FrameworkResources::ArgumentNull_Generic));
 
 					IEnumerator<T>* enumerator = collection->GetEnumerator();
 
@@ -184,20 +253,54 @@ namespace System
 					{
 						Add(enumerator->Current());
 					}
+
+					delete enumerator;
 				}
 
 				/**
-				 * Removes all elements from the list
+				 * Adds count contiguous elements to the end of the list, growing the backing store at most once.
+				 *
+				 * @param items
+				 * The first of the elements to add. Must not point into this list.
+				 *
+				 * @param count
+				 * The number of elements to add.
 				 */
-				void Clear()
+				void AddRange(const T* items, const int count)
 				{
-					if (_size > 0)
+					sassert(count >= 0, String::Format("count; %s", FrameworkResources::ArgumentOutOfRange_NeedNonNegNum));
+
+					if (count == 0)
 					{
-						delete[] _items;
-						_items = new T[_actualSize];
-						_size = 0;
+						return;
 					}
 
+					sassert(items != null, String::Format("items; %s", FrameworkResources::ArgumentNull_Generic));
+
+					EnsureCapacity(_size + count);
+
+					CopyConstruct(&_items[_size], items, count);
+					_size += count;
+					_version++;
+				}
+
+				/**
+				 * Adds the elements of the specified list to the end of this list.
+				 */
+				void AddRange(const List<T>& list)
+				{
+					sassert(&list != this, "Cannot add a List to itself.");
+
+					AddRange(list._items, list._size);
+				}
+
+				/**
+				 * Removes all elements from the list. The capacity is kept, so refilling the list does not allocate.
+				 */
+				void Clear()
+				{
+					Destroy(_items, _size);
+					_size = 0;
 					_version++;
 				}
 
@@ -220,7 +323,17 @@ namespace System
 				{
 					sassert(array != null, String::Format("array; %s", FrameworkResources::ArgumentNull_Generic));
 
-					memcpy(&array[arrayIndex], _items, _size * sizeof(T));
+					if (IsTriviallyCopyable<T>::Value)
+					{
+						memcpy((void*)&array[arrayIndex], _items, _size * sizeof(T));
+					}
+					else
+					{
+						for (int i = 0; i < _size; i++)
+						{
+							array[arrayIndex + i] = _items[i];
+						}
+					}
 				}
 
 				Enumerator* GetEnumerator()
@@ -252,19 +365,16 @@ namespace System
 				// Inserts an element into the List<> at the specified index.
 				void Insert(const int index, const T& item)
 				{
-					sassert(index >= 0 && index < _size, "Index must be within the bounds of the List.");
+					sassert(index >= 0 && index <= _size, "Index must be within the bounds of the List.");
 
 					if (_size == _actualSize)
 					{
 						EnsureCapacity(_size + 1);
 					}
 
-					if (index < _size)
-					{
-						memcpy(&_items[index + 1], &_items[index], (_size - index) * sizeof(T));
-					}
+					OpenGap(index, 1);
 
-					_items[index] = T(item);
+					new (&_items[index]) T(item);
 					_size++;
 					_version++;
 				}
@@ -286,7 +396,9 @@ namespace System
 				// Removes the element at the specified index of the List<>.
 				void RemoveAt(const int index)
 				{
-					memcpy(&_items[index], &_items[index + 1], (_size - index) * sizeof(T));
+					sassert(index >= 0 && index < _size, "Index must be within the bounds of the List.");
+
+					CloseGap(index, 1);
 
 					_size--;
 					_version++;
@@ -303,14 +415,9 @@ namespace System
 
 					if (count > 0)
 					{
-						_size -= count;
-						if (index < _size)
-						{
-							memcpy(&_items[index], &_items[index + count], (_size - index) * sizeof(T));
-						}
-
-						memset(&_items[_size], 0, count * sizeof(T));
+						CloseGap(index, count);
 
+						_size -= count;
 						_version++;
 					}
 				}
@@ -338,49 +445,81 @@ namespace System
 					_version++;
 				}
 
-				void Sort(int index, int count, IComparer<T> * const comparer)
+				// Sorts the elements in the entire List<> using the < operator of T.
+				void Sort()
+				{
+					Sort(0, _size, ArraySortHelper::LessThanComparer<T>());
+				}
+
+				// Sorts the elements in the entire List<> using the specified comparer.
+				void Sort(IComparer<T> * const comparer)
+				{
+					sassert(comparer != null, String::Format("comparer; %s", FrameworkResources::ArgumentNull_Generic));
+
+					Sort(0, _size, comparer);
+				}
+
+				// Sorts the elements in a range of elements in List<> using the specified comparer.
+				void Sort(const int index, const int count, IComparer<T> * const comparer)
 				{
 					sassert(comparer != null, String::Format("comparer; %s", FrameworkResources::ArgumentNull_Generic));
 
+					Sort<IComparer<T> *>(index, count, comparer);
+				}
+
+				/**
+				 * Sorts a range of elements in the List<> with an introsort. The sort is not stable.
+				 *
+				 * @param comparer
+				 * A functor called as comparer(x, y), or a pointer to an object with a Compare(x, y) method, returning less than zero, zero or greater than zero.
+				 * Passing a functor by value lets the comparison be inlined.
+				 */
+				template <typename TComparer>
+				void Sort(const int index, const int count, const TComparer& comparer)
+				{
 					sassert(index >= 0, String::Format("index; %s", FrameworkResources::ArgumentOutOfRange_NeedNonNegNum));
 
-					sassert(index + count < _actualSize, "");
+					sassert(count >= 0, String::Format("count; %s", FrameworkResources::ArgumentOutOfRange_NeedNonNegNum));
 
-					int k = (index + count) / 2;
-					swap(&_items[index], &_items[k]);
-					T key = _items[index];
-					int i = index + 1;
-					int j = count;
+					sassert(!((_size - index) < count), "Offset and length were out of bounds for the array or count is greater than the number of elements from index to the end of the source collection.");
 
-					while (i <= j)
-					{
-						while ((i <= count) && (comparer->Compare(_items[i], key) <= 0))
-							i++;
-						while ((j >= index) && (comparer->Compare(_items[j], key) > 0))
-							j--;
-						if (i < j)
-							swap(&_items[i], &_items[j]);
-					}
+					ArraySortHelper::Sort(_items, index, count, comparer);
+					_version++;
+				}
 
-					// swap two elements
-					swap(&_items[index], &_items[j]);
-					// recursively sort the lesser list
-					Sort(index, j-1, comparer);
-					Sort(j+1, count, comparer);
+				// Sorts the elements in the entire List<> with an introsort, using the specified comparer.
+				template <typename TComparer>
+				void Sort(const TComparer& comparer)
+				{
+					Sort(0, _size, comparer);
 				}
 
-				void Sort(IComparer<T> * const comparer)
+				// Sorts the elements in the entire List<> with a merge sort, keeping equal elements in their original order.
+				template <typename TComparer>
+				void StableSort(const TComparer& comparer)
 				{
-					sassert(comparer != null, String::Format("comparer; %s", FrameworkResources::ArgumentNull_Generic));
+					ArraySortHelper::StableSort(_items, 0, _size, comparer);
+					_version++;
+				}
 
-					Sort(0, _size, comparer);
+				/**
+				 * Sorts the elements in the entire List<> with a stable radix sort on an integer or floating point key.
+				 *
+				 * @param keySelector
+				 * A functor returning the uint, int or float sort key of an element.
+				 */
+				template <typename TKeySelector>
+				void RadixSort(const TKeySelector& keySelector)
+				{
+					ArraySortHelper::RadixSort(_items, 0, _size, keySelector);
+					_version++;
 				}
 
 				T* ToArray() const
 				{
 					T* destinationArray = new T[_size];
 
-					memcpy(destinationArray, _items, _size * sizeof(T));
+					CopyTo(destinationArray, 0);
 
 					return destinationArray;
 				}
@@ -402,7 +541,7 @@ namespace System
 
 				T& operator[](const int index)
 				{
-					sassert(index > 0, FrameworkResources::ArgumentOutOfRange_NeedNonNegNum);
+					sassert(index >= 0, FrameworkResources::ArgumentOutOfRange_NeedNonNegNum);
 					sassert(index < Count(), "");
 
 					return _items[index];
@@ -410,7 +549,7 @@ namespace System
 
 				const T& operator[](const int index) const
 				{
-					sassert(index > 0, FrameworkResources::ArgumentOutOfRange_NeedNonNegNum);
+					sassert(index >= 0, FrameworkResources::ArgumentOutOfRange_NeedNonNegNum);
 					sassert(index < Count(), "");
 
 					return _items[index];
@@ -418,19 +557,16 @@ namespace System
 
 				const List<T>& operator =(const List<T>& other)
 				{
-					if (other == *this)
+					if (&other == this)
 					{
 						return *this;
 					}
 
-					delete[] _items;
-					_actualSize = other._actualSize;
-					_size = other._size;
-					_items = new T[other._actualSize];
-
-					memcpy(_items, other._items, other._size * sizeof(T));
+					Clear();
+					EnsureCapacity(other._size);
 
-					_version = other._version;
+					CopyConstruct(_items, other._items, other._size);
+					_size = other._size;
 					return *this;
 				}
 			};
@@ -26,6 +26,32 @@ namespace System
 			private:
 				IList<T>* items;
 
+				// IList does not expose an enumerator, so the collection walks the list by index.
+				class Enumerator : public IEnumerator<T>
+				{
+				private:
+					int index;
+					IList<T> * const items;
+
+				public:
+					T& Current() const { return (*items)[index]; }
+
+					Enumerator(IList<T> * const items)
+						: index(-1), items(items)
+					{
+					}
+
+					bool MoveNext()
+					{
+						return ++index < items->Count();
+					}
+
+					void Reset()
+					{
+						index = -1;
+					}
+				};
+
 			public:
 				/**
 				 * Gets the number of elements contained in the System::Collections::ObjectModel::ReadOnlyCollection<T> instance.
@@ -89,7 +115,7 @@ namespace System
 				 */
 				inline IEnumerator<T>* GetEnumerator()
 				{
-					return items->GetEnumerator();
+					return new Enumerator(items);
 				}
 
 				/**
@@ -115,7 +141,7 @@ namespace System
 				 * @return
 				 * The element at the specified index.
 				 */
-				inline T& operator[](int index) const { return *items[index]; }
+				inline T& operator[](int index) const { return (*items)[index]; }
 			};
 
 			///////////////////////////////////////////////////////////////////
@@ -126,6 +152,32 @@ namespace System
 			private:
 				IList<T *>* items;
 
+				// IList does not expose an enumerator, so the collection walks the list by index.
+				class Enumerator : public IEnumerator<T *>
+				{
+				private:
+					int index;
+					IList<T *> * const items;
+
+				public:
+					T*& Current() const { return (*items)[index]; }
+
+					Enumerator(IList<T *> * const items)
+						: index(-1), items(items)
+					{
+					}
+
+					bool MoveNext()
+					{
+						return ++index < items->Count();
+					}
+
+					void Reset()
+					{
+						index = -1;
+					}
+				};
+
 			public:
 				/**
 				 * Gets the number of elements contained in the System::Collections::ObjectModel::ReadOnlyCollection<T> instance.
@@ -189,7 +241,7 @@ namespace System
 				 */
 				inline IEnumerator<T *>* GetEnumerator()
 				{
-					return items->GetEnumerator();
+					return new Enumerator(items);
 				}
 
 				/**
@@ -215,7 +267,7 @@ namespace System
 				 * @return
 				 * The element at the specified index.
 				 */
-				inline T* operator[](int index) const { return *items[index]; }
+				inline T* operator[](int index) const { return (*items)[index]; }
 			};
 		}
 	}
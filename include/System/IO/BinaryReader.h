@@ -23,14 +23,26 @@ namespace System
 			char* m_singleChar;
 			Stream* m_stream;
 			bool m_isMemoryStream;
+			byte* m_spanBuffer;
+			int m_spanBufferSize;
+
+			// Primitives are served from [m_readPosition, m_readEnd). For memory backed streams this points into the stream's own data,
+			// otherwise into m_readAhead, which is filled with as few Stream::Read calls as possible.
+			byte* m_readAhead;
+			int m_readAheadSize;
+			const byte* m_readPosition;
+			const byte* m_readEnd;
 
 			//! 128 chars should cover most strings in one grab.
 			static const int MaxBufferSize = 128;
 
 			bool m_disposed;
 
+			void InitReadAhead(const int readAheadSize);
 			int InternalReadChars(char buffer[], int index, int count);
 			int InternalReadOneChar();
+			bool RefillReadAhead(const int count);
+			inline const byte* Take(const int count);
 
 		protected:
 			virtual void Dispose(bool disposing);
@@ -38,10 +50,27 @@ namespace System
 			int Read7BitEncodedInt();
 
 		public:
+			static const int DefaultReadAheadSize = 8192;
+			static const int MinReadAheadSize = 4096;
+			static const int MaxReadAheadSize = 65536;
+
+			/**
+			 * Returns the underlying stream. Bytes the reader has read ahead are given back first if the stream can seek,
+			 * so that the stream's position matches what has been read through the reader.
+			 */
 			virtual Stream* BaseStream();
 
 			BinaryReader(FILE * const file);
 			BinaryReader(Stream * const input);
+			/**
+			 * @param input
+			 * The stream to read from.
+			 *
+			 * @param readAheadSize
+			 * The number of bytes read from the stream at a time, between MinReadAheadSize and MaxReadAheadSize.
+			 * Streams that are already in memory, such as MemoryStream and MappedFileStream, are read in place and need no buffer.
+			 */
+			BinaryReader(Stream * const input, const int readAheadSize);
 			virtual ~BinaryReader();
 
 			virtual void Close();
@@ -65,6 +94,20 @@ namespace System
 			virtual ushort ReadUInt16();
 			virtual uint ReadUInt32();
 			virtual ulong ReadUInt64();
+
+			/**
+			 * Reads the specified number of bytes without allocating a new array.
+			 *
+			 * If the underlying stream is held in memory, such as a MappedFileStream, the returned pointer points straight into the stream's data and
+			 * stays valid until the stream is closed. Otherwise the pointer is into a buffer owned by the reader and is only valid until the next read.
+			 *
+			 * @param count
+			 * The number of bytes to read.
+			 *
+			 * @return
+			 * A pointer to count bytes, or null if the end of the stream is reached first.
+			 */
+			const byte* ReadSpan(const int count);
 		};
 	}
 }
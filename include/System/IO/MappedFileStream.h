@@ -0,0 +1,64 @@
+/*****************************************************************************
+ *	MappedFileStream.h														 *
+ *																			 *
+ *	XFX System::IO::MappedFileStream class definition file					 *
+ *	Copyright (c) XFX Team. All Rights Reserved 							 *
+ *****************************************************************************/
+#ifndef _SYSTEM_IO_MAPPEDFILESTREAM_
+#define _SYSTEM_IO_MAPPEDFILESTREAM_
+
+#include <System/Types.h>
+#include "Stream.h"
+
+namespace System
+{
+	class String;
+
+	namespace IO
+	{
+		/**
+		 * A read-only Stream over a file whose whole contents stay in memory for the lifetime of the stream.
+		 *
+		 * The Xbox has no memory mapped files, so there the file is read into physically contiguous memory with a single read when the stream is opened;
+		 * the GPU can use that memory directly. Other platforms map the file.
+		 * Read is a plain copy, and InternalReadSpan hands out pointers into the file data without copying it.
+		 */
+		class MappedFileStream : public Stream
+		{
+		private:
+			byte* _data;
+			int _length;
+
+			MappedFileStream(const MappedFileStream &obj);
+
+		protected:
+			void Dispose(bool disposing);
+
+		public:
+			bool CanRead();
+			bool CanSeek();
+			bool CanWrite();
+			long long Length();
+
+			/**
+			 * Opens the specified file for reading.
+			 *
+			 * @param path
+			 * The path of the file to open.
+			 */
+			MappedFileStream(const String& path);
+			~MappedFileStream();
+
+			void Flush();
+			static const Type& GetType();
+			const byte* InternalReadSpan(const int count);
+			int Read(byte buffer[], int offset, int count);
+			int ReadByte();
+			long long Seek(long long offset, SeekOrigin_t origin);
+			void SetLength(long long value);
+			void Write(byte buffer[], int offset, int count);
+		};
+	}
+}
+
+#endif //_SYSTEM_IO_MAPPEDFILESTREAM_
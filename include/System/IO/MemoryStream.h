@@ -57,6 +57,7 @@ namespace System
 			void Flush();
 			virtual byte* GetBuffer();
 			static const Type& GetType();
+			const byte* InternalReadSpan(const int count);
 			int Read(byte buffer[], int offset, int count);
 			int ReadByte();
 			long long Seek(long long offset, SeekOrigin_t loc);
@@ -54,6 +54,14 @@ namespace System
 			virtual void EndWrite(IAsyncResult* asyncResult);
 			virtual void Flush();
 			static const Type& GetType();
+			/**
+			 * Returns a pointer to the next count bytes of a stream whose contents are already in memory and advances the position past them,
+			 * so that readers can use the data in place instead of copying it. The pointer remains valid until the stream is closed.
+			 * Returns null, without advancing, if the stream is not backed by memory or fewer than count bytes are left.
+			 */
+			// This method is not meant to be used by the end user.
+			// Only XFX source files should reference this method.
+			virtual const byte* InternalReadSpan(const int count);
 			virtual int Read(byte buffer[], int offset, int count);
 			virtual int ReadByte();
 			virtual long long Seek(long long offset, SeekOrigin_t origin);
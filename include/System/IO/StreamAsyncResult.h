@@ -17,7 +17,7 @@ namespace System
 	namespace IO
 	{
 		/**
-		 * 
+		 * The result of Stream::BeginRead and Stream::BeginWrite, which carry out the operation before they return.
 		 */
 		class StreamAsyncResult : public IAsyncResult, public Object
 		{
@@ -31,8 +31,8 @@ namespace System
 		public:
 			Object* AsyncState();
 			Threading::WaitHandle* AsyncWaitHandle();
-			virtual bool CompletedSynchronously();
-			bool IsCompleted();
+			bool CompletedSynchronously() const;
+			bool IsCompleted() const;
 			//Exception* getException();
 			int NBytes();
 			bool Done;
@@ -59,6 +59,10 @@ namespace System
 			 */
 			StreamAsyncResult(const StreamAsyncResult &obj);
 
+			/**
+			 * Marks the operation as completed, having transferred nbytes bytes.
+			 */
+			void SetComplete(int nbytes);
 			//void SetComplete(Exception* e);
 			//void SetComplete(Exception* e, int nbytes);
 		};
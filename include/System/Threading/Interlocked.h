@@ -19,9 +19,9 @@ namespace System
 			//		The new value stored at location1.
 			static inline int Add(volatile int* const location1, const int value)
 			{
-				long retval = value;
-				__asm__("lock; xaddl %[retval], %[location1]" : [retval] "+r" (retval) : [location1] "m" (*location1) : "memory");
-				return retval;
+				int retval = value;
+				__asm__ __volatile__("lock; xaddl %[retval], %[location1]" : [retval] "+r" (retval), [location1] "+m" (*location1) : : "memory");
+				return retval + value;
 			}
 
 			// Compares two 32-bit signed integers for equality and, if they are equal, replaces one of the values.
@@ -33,10 +33,10 @@ namespace System
 			//		The value that is compared to the value at location1. 
 			//	Returns
 			//		The original value in location1.
-			static inline int CompareExchange(int location1, int value, int comparand)
+			static inline int CompareExchange(volatile int * const location1, const int value, const int comparand)
 			{
-				long retval = comparand;
-				__asm__("lock; cmpxchgl %k[value], %[location1]" : [retval] "+a" (retval) : [location1] "m" (*location1), [value] "q" (value): "memory");
+				int retval = comparand;
+				__asm__ __volatile__("lock; cmpxchgl %k[value], %[location1]" : [retval] "+a" (retval), [location1] "+m" (*location1) : [value] "q" (value) : "memory");
 				return retval;
 			}
 
@@ -53,13 +53,13 @@ namespace System
 			{
 				long long retval = comparand;
 
-				__asm__
+				__asm__ __volatile__
 				(
-					"cmpxchg8b %[location1]" :
-					[retval] "+A" (retval) :
-						[location1] "m" (*location1),
-						"b" ((unsigned long)((Exchange >>  0) & 0xFFFFFFFF)),
-						"c" ((unsigned long)((Exchange >> 32) & 0xFFFFFFFF)) :
+					"lock; cmpxchg8b %[location1]" :
+					[retval] "+A" (retval),
+						[location1] "+m" (*location1) :
+						"b" ((unsigned long)((value >>  0) & 0xFFFFFFFF)),
+						"c" ((unsigned long)((value >> 32) & 0xFFFFFFFF)) :
 					"memory"
 				);
 
@@ -78,7 +78,7 @@ namespace System
 			static inline void* CompareExchange(void * volatile * const location1, void * const value, void * const comparand)
 			{
 				void * retval = (void *)comparand;
-				__asm__("lock; cmpxchgl %k[value], %[location1]" : [retval] "=a" (retval) : "[retval]" (retval), [location1] "m" (*location1), [value] "q" (value) : "memory");
+				__asm__ __volatile__("lock; cmpxchg %[value], %[location1]" : [retval] "+a" (retval), [location1] "+m" (*location1) : [value] "q" (value) : "memory");
 				return retval;
 			}
 
@@ -87,9 +87,9 @@ namespace System
 			//		The variable whose value is to be decremented.
 			//	Returns
 			//		The decremented value.
-			static inline long Decrement(volatile int * const location)
+			static inline int Decrement(volatile int * const location)
 			{
-				return Add(location, -1) - 1;
+				return Add(location, -1);
 			}
 
 			// Sets a 32-bit signed integer to a specified value and returns the original value, as an atomic operation.
@@ -102,7 +102,7 @@ namespace System
 			static inline int Exchange(volatile int * const location1, const int value)
 			{
 				int retval = value;
-				__asm__("xchgl %[retval], %[location1]" : [retval] "+r" (retval) : [location1] "m" (*location1) : "memory");
+				__asm__ __volatile__("xchgl %[retval], %[location1]" : [retval] "+r" (retval), [location1] "+m" (*location1) : : "memory");
 				return retval;
 			}
 
@@ -116,7 +116,7 @@ namespace System
 			static inline void* Exchange(void * volatile * const Target, void * const Value)
 			{
 				void * retval = Value;
-				__asm__("xchgl %[retval], %[Target]" : [retval] "+r" (retval) : [Target] "m" (*Target) : "memory");
+				__asm__ __volatile__("xchg %[retval], %[Target]" : [retval] "+r" (retval), [Target] "+m" (*Target) : : "memory");
 				return retval;
 			}
 
@@ -127,7 +127,7 @@ namespace System
 			//		The incremented value.
 			static inline int Increment(volatile int * const location)
 			{
-				return Add(location, 1) + 1;
+				return Add(location, 1);
 			}
 		};
 	}
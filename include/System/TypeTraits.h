@@ -0,0 +1,24 @@
+/*****************************************************************************
+ *	TypeTraits.h															 *
+ *																			 *
+ *	Defines compile-time type queries used by the XFX collections			 *
+ *	Copyright (c) XFX Team. All Rights Reserved 							 *
+ *****************************************************************************/
+#ifndef _SYSTEM_TYPETRAITS_
+#define _SYSTEM_TYPETRAITS_
+
+namespace System
+{
+	/**
+	 * Determines whether values of type T can be copied and relocated with memcpy/memmove and discarded without running a destructor.
+	 * Types that derive from System::Object are never trivially copyable, since they carry a vtable pointer and usually own resources.
+	 * Specialize this template for types the compiler cannot see through but that are known to be safe.
+	 */
+	template <typename T>
+	struct IsTriviallyCopyable
+	{
+		static const bool Value = __has_trivial_copy(T) && __has_trivial_assign(T) && __has_trivial_destructor(T);
+	};
+}
+
+#endif //_SYSTEM_TYPETRAITS_
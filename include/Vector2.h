@@ -76,15 +76,18 @@ namespace XFX
 		static Vector2	Subtract(const Vector2 value1, const Vector2 value2);
 		static void 	Subtract(const Vector2& value1, const Vector2& value2, out Vector2& result);
 		const String	ToString() const;
-		static Vector2	Transform(const Vector2 position, const Matrix matrix);
+		static Vector2	Transform(const Vector2 position, const Matrix& matrix);
 		static void 	Transform(const Vector2& position, const Matrix& matrix, out Vector2& result);
-		static Vector2	Transform(const Vector2 position, const Quaternion rotation);
+		static Vector2	Transform(const Vector2 position, const Quaternion& rotation);
 		static void 	Transform(const Vector2& position, const Quaternion& rotation, out Vector2& result);
 		static void 	Transform(const Vector2 sourceArray[], const int sourceIndex, const Matrix& matrix, Vector2 destinationArray[], const int destinationIndex, const int length);
 		static void 	Transform(const Vector2 sourceArray[], const int sourceIndex, const Quaternion& rotation, Vector2 destinationArray[], const int destinationIndex, const int length);
-		static Vector2	TransformNormal(const Vector2 normal, const Matrix matrix);
+		static void 	Transform(const float sourceX[], const float sourceY[], const Matrix& matrix, float destinationX[], float destinationY[], const int length) NONNULL(1, 2, 4, 5);
+		static void 	Transform(const float sourceX[], const float sourceY[], const Quaternion& rotation, float destinationX[], float destinationY[], const int length) NONNULL(1, 2, 4, 5);
+		static Vector2	TransformNormal(const Vector2 normal, const Matrix& matrix);
 		static void 	TransformNormal(const Vector2& normal, const Matrix& matrix, out Vector2& result);
 		static void 	TransformNormal(const Vector2 sourceArray[], const int sourceIndex, const Matrix& matrix, Vector2 destinationArray[], const int destinationIndex, const int length);
+		static void 	TransformNormal(const float sourceX[], const float sourceY[], const Matrix& matrix, float destinationX[], float destinationY[], const int length) NONNULL(1, 2, 4, 5);
 
 		Vector2 operator -(const Vector2& other) const;
 		Vector2 operator -() const;
@@ -91,18 +91,21 @@ namespace XFX
 		static Vector3	Subtract(const Vector3 value1, const Vector3 value2);
 		static void 	Subtract(const Vector3 value1, const Vector3 value2, out Vector3& result);
 		const String	ToString() const;
-		static Vector3	Transform(const Vector3 position, const Matrix matrix);
-		static void 	Transform(const Vector3 position, const Matrix matrix, out Vector3& result);
-		static Vector3	Transform(const Vector3 position, const Quaternion rotation);
-		static void 	Transform(const Vector3 position, const Quaternion rotation, out Vector3& result);
-		static void 	Transform(const Vector3 sourceArray[], const int sourceIndex, const Matrix matrix, Vector3 destinationArray[], const int destinationIndex, const int length) NONNULL(1, 4);
-		static void 	Transform(const Vector3 sourceArray[], const int sourceIndex, const Quaternion rotation, Vector3 destinationArray[], const int destinationIndex, const int length) NONNULL(1, 4);
-		static void 	Transform(const Vector3 sourceArray[], const Matrix matrix, Vector3 destinationArray[]) NONNULL(1, 3);
-		static void 	Transform(const Vector3 sourceArray[], const Quaternion rotation, Vector3 destinationArray[]) NONNULL(1, 3);
-		static Vector3	TransformNormal(const Vector3 normal, const Matrix matrix);
-		static void 	TransformNormal(const Vector3 normal, const Matrix matrix, out Vector3& result);
-		static void 	TransformNormal(const Vector3 sourceArray[], const int sourceIndex, const Matrix matrix, Vector3 destinationArray[], const int destinationIndex, const int length) NONNULL(1, 4);
-		static void 	TransformNormal(const Vector3 sourceArray[], const Matrix matrix, Vector3 destinationArray[]) NONNULL(1, 3);
+		static Vector3	Transform(const Vector3 position, const Matrix& matrix);
+		static void 	Transform(const Vector3 position, const Matrix& matrix, out Vector3& result);
+		static Vector3	Transform(const Vector3 position, const Quaternion& rotation);
+		static void 	Transform(const Vector3 position, const Quaternion& rotation, out Vector3& result);
+		static void 	Transform(const Vector3 sourceArray[], const int sourceIndex, const Matrix& matrix, Vector3 destinationArray[], const int destinationIndex, const int length) NONNULL(1, 4);
+		static void 	Transform(const Vector3 sourceArray[], const int sourceIndex, const Quaternion& rotation, Vector3 destinationArray[], const int destinationIndex, const int length) NONNULL(1, 4);
+		static void 	Transform(const Vector3 sourceArray[], const Matrix& matrix, Vector3 destinationArray[]) NONNULL(1, 3);
+		static void 	Transform(const Vector3 sourceArray[], const Quaternion& rotation, Vector3 destinationArray[]) NONNULL(1, 3);
+		static void 	Transform(const float sourceX[], const float sourceY[], const float sourceZ[], const Matrix& matrix, float destinationX[], float destinationY[], float destinationZ[], const int length) NONNULL(1, 2, 3, 5, 6, 7);
+		static void 	Transform(const float sourceX[], const float sourceY[], const float sourceZ[], const Quaternion& rotation, float destinationX[], float destinationY[], float destinationZ[], const int length) NONNULL(1, 2, 3, 5, 6, 7);
+		static Vector3	TransformNormal(const Vector3 normal, const Matrix& matrix);
+		static void 	TransformNormal(const Vector3 normal, const Matrix& matrix, out Vector3& result);
+		static void 	TransformNormal(const Vector3 sourceArray[], const int sourceIndex, const Matrix& matrix, Vector3 destinationArray[], const int destinationIndex, const int length) NONNULL(1, 4);
+		static void 	TransformNormal(const Vector3 sourceArray[], const Matrix& matrix, Vector3 destinationArray[]) NONNULL(1, 3);
+		static void 	TransformNormal(const float sourceX[], const float sourceY[], const float sourceZ[], const Matrix& matrix, float destinationX[], float destinationY[], float destinationZ[], const int length) NONNULL(1, 2, 3, 5, 6, 7);
 
 		Vector3 operator+(const Vector3& other);
 		Vector3 operator/(const float divider);
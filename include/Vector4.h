@@ -86,22 +86,24 @@ namespace XFX
 		static Vector4 Subtract(Vector4 value1, Vector4 value2);
 		static void Subtract(Vector4 value1, Vector4 value2, out Vector4& result);
 		const String ToString() const;
-		static void Transform(Vector4 sourceArray[], Quaternion rotation, Vector4 destinationArray[]);
-		static void Transform(Vector4 sourceArray[], int sourceIndex, Quaternion rotation, Vector4 destinationArray[], int destinationIndex, int length);
-		static void Transform(Vector4 sourceArray[], Matrix matrix, Vector4 destinationArray[]);
-		static void Transform(Vector4 sourceArray[], int sourceIndex, Matrix matrix, Vector4 destinationArray[], int destinationIndex, int length);
-		static Vector4 Transform(Vector4 vector, Quaternion rotation);
-		static void Transform(Vector4 vector, Quaternion rotation, out Vector4& result);
-		static Vector4 Transform(Vector3 vector, Quaternion rotation);
-		static void Transform(Vector3 vector, Quaternion rotation, out Vector4& result);
-		static Vector4 Transform(Vector2 vector, Quaternion rotation);
-		static void Transform(Vector2 vector, Quaternion rotation, out Vector4& result);
-		static Vector4 Transform(Vector4 vector, Matrix matrix);
-		static void Transform(Vector4 vector, Matrix matrix, out Vector4& result);
-		static Vector4 Transform(Vector3 position, Matrix matrix);
-		static void Transform(Vector3 position, Matrix matrix, out Vector4& result);
-		static Vector4 Transform(Vector2 vector, Matrix matrix);
-		static void Transform(Vector2 vector, Matrix matrix, out Vector4& result);
+		static void Transform(Vector4 sourceArray[], const Quaternion& rotation, Vector4 destinationArray[]);
+		static void Transform(Vector4 sourceArray[], int sourceIndex, const Quaternion& rotation, Vector4 destinationArray[], int destinationIndex, int length);
+		static void Transform(Vector4 sourceArray[], const Matrix& matrix, Vector4 destinationArray[]);
+		static void Transform(Vector4 sourceArray[], int sourceIndex, const Matrix& matrix, Vector4 destinationArray[], int destinationIndex, int length);
+		static void Transform(const float sourceX[], const float sourceY[], const float sourceZ[], const float sourceW[], const Matrix& matrix, float destinationX[], float destinationY[], float destinationZ[], float destinationW[], const int length) NONNULL(1, 2, 3, 4, 6, 7, 8, 9);
+		static void Transform(const float sourceX[], const float sourceY[], const float sourceZ[], const float sourceW[], const Quaternion& rotation, float destinationX[], float destinationY[], float destinationZ[], float destinationW[], const int length) NONNULL(1, 2, 3, 4, 6, 7, 8, 9);
+		static Vector4 Transform(Vector4 vector, const Quaternion& rotation);
+		static void Transform(Vector4 vector, const Quaternion& rotation, out Vector4& result);
+		static Vector4 Transform(Vector3 vector, const Quaternion& rotation);
+		static void Transform(Vector3 vector, const Quaternion& rotation, out Vector4& result);
+		static Vector4 Transform(Vector2 vector, const Quaternion& rotation);
+		static void Transform(Vector2 vector, const Quaternion& rotation, out Vector4& result);
+		static Vector4 Transform(Vector4 vector, const Matrix& matrix);
+		static void Transform(Vector4 vector, const Matrix& matrix, out Vector4& result);
+		static Vector4 Transform(Vector3 position, const Matrix& matrix);
+		static void Transform(Vector3 position, const Matrix& matrix, out Vector4& result);
+		static Vector4 Transform(Vector2 vector, const Matrix& matrix);
+		static void Transform(Vector2 vector, const Matrix& matrix, out Vector4& result);
 
 		Vector4 operator-(const Vector4& other);
 		Vector4 operator-();
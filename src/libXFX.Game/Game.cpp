@@ -36,6 +36,7 @@ extern "C"
 }
 #endif
 
+#include <FrameworkDispatcher.h>
 #include <Game.h>
 #include <System/Collections/Generic/List.h>
 #include <Graphics/GraphicsDevice.h>
@@ -234,6 +235,11 @@ namespace XFX
 	
 	void Game::Tick()
 	{
+		// events signalled by the audio thread, such as BufferNeeded, are raised here on the game thread
+		FrameworkDispatcher::Update();
+		// assets streamed in since the last frame become visible to Update here
+		Content->DispatchCompletedLoads();
+
 		Update(gameTime);
 
 		if(BeginDraw())
@@ -26,9 +26,14 @@
 // POSSIBILITY OF SUCH DAMAGE.
 
 #include <Graphics/AlphaTestEffect.h>
+#include <Graphics/GraphicsDevice.h>
 #include <Graphics/Texture2D.h>
 #include <System/Type.h>
 
+extern "C" {
+#include "pbKit.h"
+}
+
 namespace XFX
 {
 	namespace Graphics
@@ -57,6 +62,29 @@ namespace XFX
 
 		void AlphaTestEffect::OnApply()
 		{
+			// Select the fixed function pipeline, in case a SkinnedEffect has loaded its vertex program.
+			GraphicsDevice* device = getGraphicsDevice();
+			DWORD* p = pb_begin();
+
+			if (device->UpdateRenderState(NV20_TCL_PRIMITIVE_3D_SHADER_TYPE, SHADER_TYPE_INTERNAL))
+			{
+				pb_push1(p, NV20_TCL_PRIMITIVE_3D_SHADER_TYPE, SHADER_TYPE_INTERNAL); p += 2;
+			}
+
+			pb_end(p);
+		}
+
+		void AlphaTestEffect::OnApplyWorld(const Matrix& world)
+		{
+			World = world;
+			OnApply();
+		}
+
+		void AlphaTestEffect::SetMatrices(const Matrix& world, const Matrix& view, const Matrix& projection)
+		{
+			World = world;
+			View = view;
+			Projection = projection;
 		}
 
 		Effect* AlphaTestEffect::Clone() const
@@ -0,0 +1,118 @@
+// Copyright (C) XFX Team
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without 
+// modification, are permitted provided that the following conditions are met:
+// 
+//* Redistributions of source code must retain the above copyright 
+//notice, this list of conditions and the following disclaimer.
+//* Redistributions in binary form must reproduce the above copyright 
+//notice, this list of conditions and the following disclaimer in the 
+//documentation and/or other materials provided with the distribution.
+//* Neither the name of the copyright holder nor the names of any 
+//contributors may be used to endorse or promote products derived from 
+//this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE 
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF 
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS 
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE 
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include "AudioBufferQueue.h"
+#include <System/Threading/Interlocked.h>
+
+#include <string.h>
+
+using namespace System::Threading;
+
+namespace XFX
+{
+	namespace Audio
+	{
+		// head and tail count modulo 2 * Capacity, so tail - head is Capacity when the queue is full rather than 0.
+		static const int IndexMask = (2 * AudioBufferQueue::Capacity) - 1;
+
+		AudioBufferQueue::AudioBufferQueue()
+			: head(0), tail(0), readOffset(0)
+		{
+		}
+
+		int AudioBufferQueue::Count()
+		{
+			return (Interlocked::Add(&tail, 0) - Interlocked::Add(&head, 0)) & IndexMask;
+		}
+
+		void AudioBufferQueue::Clear()
+		{
+			head = 0;
+			tail = 0;
+			readOffset = 0;
+		}
+
+		bool AudioBufferQueue::Enqueue(byte const * const data, const int count)
+		{
+			const int last = tail;
+
+			// head is only advanced by the consumer; reading a stale value just makes the queue look fuller than it is.
+			if (((last - Interlocked::Add(&head, 0)) & IndexMask) == Capacity)
+			{
+				return false;
+			}
+
+			Entry& entry = entries[last & (Capacity - 1)];
+			entry.Data = data;
+			entry.Count = count;
+
+			// Publish the entry only once it has been written.
+			Interlocked::Exchange(&tail, (last + 1) & IndexMask);
+
+			return true;
+		}
+
+		int AudioBufferQueue::Read(byte destination[], const int count, int& buffersReleased)
+		{
+			const int last = Interlocked::Add(&tail, 0);
+			int first = head;
+			int copied = 0;
+
+			buffersReleased = 0;
+
+			while (copied < count && first != last)
+			{
+				const Entry& entry = entries[first & (Capacity - 1)];
+				int length = entry.Count - readOffset;
+
+				if (length > count - copied)
+				{
+					length = count - copied;
+				}
+
+				memcpy(destination + copied, entry.Data + readOffset, length);
+				copied += length;
+				readOffset += length;
+
+				if (readOffset == entry.Count)
+				{
+					readOffset = 0;
+					first = (first + 1) & IndexMask;
+					buffersReleased++;
+				}
+			}
+
+			if (buffersReleased > 0)
+			{
+				// Hand the finished entries back to the producer only after they have been copied.
+				Interlocked::Exchange(&head, first);
+			}
+
+			return copied;
+		}
+	}
+}
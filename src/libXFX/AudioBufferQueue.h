@@ -0,0 +1,82 @@
+/*****************************************************************************
+ *	AudioBufferQueue.h														 *
+ *																			 *
+ *	XFX::Audio::AudioBufferQueue class definition file						 *
+ *	Copyright (c) XFX Team. All Rights Reserved 							 *
+ *****************************************************************************/
+#ifndef _XFX_AUDIO_AUDIOBUFFERQUEUE_
+#define _XFX_AUDIO_AUDIOBUFFERQUEUE_
+
+#include <System/Types.h>
+
+using namespace System;
+
+namespace XFX
+{
+	namespace Audio
+	{
+		/**
+		 * A fixed size queue of audio buffers, written by one thread and read by another without locking.
+		 *
+		 * The producer only ever writes tail and the consumer only ever writes head; each publishes its index with Interlocked::Exchange
+		 * after it is done with the entries, and reads the other's through an interlocked operation, so neither ever sees a half written entry.
+		 * Both indices count modulo twice the capacity, which tells a full queue apart from an empty one without giving up a slot.
+		 *
+		 * Buffers are referenced, not copied: the memory of a queued buffer must be left untouched until the consumer has read past it.
+		 */
+		// This class is not meant to be used by the end user.
+		// Only XFX source files should reference this class.
+		class AudioBufferQueue
+		{
+		public:
+			/**
+			 * The maximum number of buffers that can be queued at once.
+			 */
+			static const int Capacity = 64;
+
+		private:
+			struct Entry
+			{
+				byte const * Data;
+				int Count;
+			};
+
+			Entry entries[Capacity];
+			volatile int head;
+			volatile int tail;
+			int readOffset;
+
+		public:
+			AudioBufferQueue();
+
+			/**
+			 * Returns the number of buffers that have not been read completely.
+			 */
+			int Count();
+
+			/**
+			 * Removes every buffer from the queue. Neither thread may use the queue while it is cleared.
+			 */
+			void Clear();
+			/**
+			 * Queues count bytes of data. Only call this from the producer thread.
+			 *
+			 * @return
+			 * false if the queue is full, in which case nothing is queued.
+			 */
+			bool Enqueue(byte const * const data, const int count);
+			/**
+			 * Copies up to count bytes from the front of the queue into destination. Only call this from the consumer thread.
+			 *
+			 * @param buffersReleased
+			 * Receives the number of buffers that were read completely, and may now be reused by the producer.
+			 *
+			 * @return
+			 * The number of bytes copied, which is less than count if the queue ran out.
+			 */
+			int Read(byte destination[], const int count, int& buffersReleased);
+		};
+	}
+}
+
+#endif //_XFX_AUDIO_AUDIOBUFFERQUEUE_
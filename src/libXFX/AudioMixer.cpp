@@ -0,0 +1,495 @@
+// Copyright (C) XFX Team
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without 
+// modification, are permitted provided that the following conditions are met:
+// 
+//* Redistributions of source code must retain the above copyright 
+//notice, this list of conditions and the following disclaimer.
+//* Redistributions in binary form must reproduce the above copyright 
+//notice, this list of conditions and the following disclaimer in the 
+//documentation and/or other materials provided with the distribution.
+//* Neither the name of the copyright holder nor the names of any 
+//contributors may be used to endorse or promote products derived from 
+//this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE 
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF 
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS 
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE 
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include <Audio/AudioMixer.h>
+#include <Audio/SoundEffect.h>
+#include <Audio/SoundEffectInstance.h>
+#include <MathHelper.h>
+#include <System/FrameworkResources.h>
+#include <System/String.h>
+#include <System/Threading/Interlocked.h>
+#include <System/Threading/Thread.h>
+
+#include <math.h>
+#include <sassert.h>
+#include <string.h>
+
+#if __SSE__
+#include <xmmintrin.h>
+#endif
+
+using namespace System::Threading;
+
+namespace XFX
+{
+	namespace Audio
+	{
+		// Output frames mixed per pass; gains are ramped from one pass to the next.
+		static const int BlockFrames = 64;
+		// The most source frames a voice may advance by per output frame.
+		static const float MaxStep = 4.0f;
+		// A block at the maximum step, plus the frame before it and the taps after it.
+		static const int WindowFrames = (BlockFrames * 4) + 8;
+
+		/**
+		 * The mixer's state for one playing instance.
+		 *
+		 * Window holds source frames, converted to float, from the one before the current position onwards,
+		 * so that a block can be interpolated without checking for the end of the sound or wrapping around its loop.
+		 */
+		struct AudioMixer::Voice
+		{
+			SoundEffectInstance* volatile Instance;
+			int Buffered;
+			// Window index one past the last frame of the sound, or -1 while it has more.
+			int End;
+			uint Fraction;
+			float GainLeft;
+			float GainRight;
+			bool Ramped;
+			float Window[WindowFrames * 2];
+		};
+
+		AudioMixer::Voice AudioMixer::voices[AudioMixer::MaxVoices];
+		// The slot Render is mixing, which Remove waits on before letting an instance go.
+		static volatile int renderingVoice = -1;
+		static bool cubicInterpolation = false;
+
+		static float mix[BlockFrames * 2] ALIGNED16;
+		static float fractions[BlockFrames] ALIGNED16;
+		// The four interpolation taps of each output frame, for each channel.
+		static float taps[2][4][BlockFrames] ALIGNED16;
+		static short scratch[WindowFrames * 2];
+
+		bool AudioMixer::Add(SoundEffectInstance * const instance)
+		{
+			for (int i = 0; i < MaxVoices; i++)
+			{
+				Voice& voice = voices[i];
+
+				if (voice.Instance != null)
+				{
+					continue;
+				}
+
+				// The slot is reset before it is claimed, so Render never sees it half initialized.
+				voice.Buffered = 1;
+				voice.End = -1;
+				voice.Fraction = 0;
+				voice.Ramped = false;
+				voice.Window[0] = 0.0f;
+				voice.Window[1] = 0.0f;
+
+				if (Interlocked::CompareExchange((void * volatile *)&voice.Instance, instance, null) == null)
+				{
+					return true;
+				}
+			}
+
+			return false;
+		}
+
+		void AudioMixer::Remove(SoundEffect * const parent)
+		{
+			for (int i = 0; i < MaxVoices; i++)
+			{
+				SoundEffectInstance* const instance = voices[i].Instance;
+
+				if (instance == null || instance->_parent != parent ||
+					Interlocked::CompareExchange((void * volatile *)&voices[i].Instance, null, instance) != instance)
+				{
+					continue;
+				}
+
+				while (Interlocked::Add(&renderingVoice, 0) == i)
+				{
+					Thread::Sleep(1);
+				}
+
+				instance->_state = SoundState::Stopped;
+
+				if (instance->_fireAndForget)
+				{
+					delete instance;
+				}
+			}
+		}
+
+		void AudioMixer::Remove(SoundEffectInstance * const instance)
+		{
+			for (int i = 0; i < MaxVoices; i++)
+			{
+				if (voices[i].Instance != instance ||
+					Interlocked::CompareExchange((void * volatile *)&voices[i].Instance, null, instance) != instance)
+				{
+					continue;
+				}
+
+				// Render publishes the slot it is about to mix before reading its instance, so once the slot is cleared it only has to be waited on if it is that one.
+				while (Interlocked::Add(&renderingVoice, 0) == i)
+				{
+					Thread::Sleep(1);
+				}
+			}
+		}
+
+		int AudioMixer::getActiveVoiceCount()
+		{
+			int count = 0;
+
+			for (int i = 0; i < MaxVoices; i++)
+			{
+				if (voices[i].Instance != null)
+				{
+					count++;
+				}
+			}
+
+			return count;
+		}
+
+		bool AudioMixer::getCubicInterpolation()
+		{
+			return cubicInterpolation;
+		}
+
+		void AudioMixer::setCubicInterpolation(bool value)
+		{
+			cubicInterpolation = value;
+		}
+
+		// Tops the window of a voice up to count frames, padding past the end of the sound with silence.
+		void AudioMixer::Fill(Voice& voice, SoundEffectInstance * const instance, const int count)
+		{
+			const int channels = instance->_channels;
+			const int wanted = count - voice.Buffered;
+			const int read = (voice.End < 0) ? instance->ReadFrames(scratch, wanted) : 0;
+			float* destination = voice.Window + (voice.Buffered * channels);
+
+			for (int i = 0; i < read * channels; i++)
+			{
+				destination[i] = scratch[i];
+			}
+
+			memset(destination + (read * channels), 0, (wanted - read) * channels * sizeof(float));
+
+			if (read < wanted && voice.End < 0)
+			{
+				voice.End = voice.Buffered + read;
+			}
+
+			voice.Buffered = count;
+		}
+
+		// Collects the taps of count output frames that start fraction of a frame after window frame 1 and advance by step, as 32.32 fixed point.
+		static void Gather(const float window[], const int channels, const uint fraction, const unsigned long long step, const int count, const bool cubic)
+		{
+			unsigned long long position = fraction;
+
+			for (int i = 0; i < count; i++, position += step)
+			{
+				const float* frame = window + ((int)(position >> 32) * channels);
+
+				fractions[i] = (float)(int)((uint)position >> 1) * (1.0f / 2147483648.0f);
+
+				for (int c = 0; c < channels; c++)
+				{
+					taps[c][1][i] = frame[channels + c];
+					taps[c][2][i] = frame[(channels * 2) + c];
+
+					if (cubic)
+					{
+						taps[c][0][i] = frame[c];
+						taps[c][3][i] = frame[(channels * 3) + c];
+					}
+				}
+			}
+		}
+
+#if __SSE__
+		// Interpolates the gathered taps of frames first to first + 3 of one channel.
+		static inline __m128 Interpolate(const int channel, const int first, const __m128 t, const bool cubic)
+		{
+			const __m128 x1 = _mm_load_ps(&taps[channel][1][first]);
+			const __m128 x2 = _mm_load_ps(&taps[channel][2][first]);
+
+			if (!cubic)
+			{
+				return _mm_add_ps(x1, _mm_mul_ps(t, _mm_sub_ps(x2, x1)));
+			}
+
+			// Catmull-Rom: ((a * t + b) * t + c) * t + x1, with every coefficient halved.
+			const __m128 x0 = _mm_load_ps(&taps[channel][0][first]);
+			const __m128 x3 = _mm_load_ps(&taps[channel][3][first]);
+			const __m128 half = _mm_set1_ps(0.5f);
+			const __m128 a = _mm_add_ps(_mm_sub_ps(x3, x0), _mm_mul_ps(_mm_set1_ps(3.0f), _mm_sub_ps(x1, x2)));
+			const __m128 b = _mm_sub_ps(_mm_sub_ps(_mm_add_ps(_mm_add_ps(x0, x0), _mm_mul_ps(_mm_set1_ps(4.0f), x2)), _mm_mul_ps(_mm_set1_ps(5.0f), x1)), x3);
+			const __m128 c = _mm_sub_ps(x2, x0);
+			__m128 y = _mm_add_ps(_mm_mul_ps(a, t), b);
+			y = _mm_add_ps(_mm_mul_ps(y, t), c);
+
+			return _mm_add_ps(x1, _mm_mul_ps(_mm_mul_ps(y, t), half));
+		}
+#endif
+
+		// Returns the left and right gains of a voice.
+		void AudioMixer::GetGains(SoundEffectInstance * const instance, float& left, float& right)
+		{
+			const float volume = instance->_volume * instance->_distanceGain * SoundEffect::getMasterVolume();
+			const float pan = MathHelper::Clamp(instance->_pan + instance->_positionalPan, -1.0f, 1.0f);
+
+			if (instance->_channels == AudioChannels::Mono)
+			{
+				// Constant power, so a sound keeps its loudness as it moves across.
+				const float angle = (pan + 1.0f) * MathHelper::PiOver4;
+
+				left = volume * cosf(angle);
+				right = volume * sinf(angle);
+			}
+			else
+			{
+				// Stereo sounds are balanced: the far channel is attenuated and the near one is left alone.
+				left = volume * ((pan > 0.0f) ? 1.0f - pan : 1.0f);
+				right = volume * ((pan < 0.0f) ? 1.0f + pan : 1.0f);
+			}
+		}
+
+		// Mixes the next count frames of a voice into mix. Returns false once the sound has played to its end.
+		bool AudioMixer::MixVoice(Voice& voice, SoundEffectInstance * const instance, const int count)
+		{
+			const int channels = instance->_channels;
+			const int rounded = (count + 3) & ~3;
+			float step = ((float)instance->_sampleRate / SampleRate) * powf(2.0f, instance->_pitch) * instance->_dopplerFactor;
+			float gainLeft, gainRight;
+
+			step = (step > MaxStep) ? MaxStep : ((step < 1.0f / 1024.0f) ? 1.0f / 1024.0f : step);
+
+			const unsigned long long fixedStep = (unsigned long long)((double)step * 4294967296.0);
+			const bool direct = (fixedStep == 0x100000000ULL) && (voice.Fraction == 0);
+			const bool cubic = cubicInterpolation;
+
+			// Taps reach up to 2 frames past the last output frame, and the window keeps the frame before the next block's first one.
+			const int needed = (int)((voice.Fraction + (rounded * fixedStep)) >> 32) + 4;
+
+			if (voice.Buffered < needed)
+			{
+				Fill(voice, instance, needed);
+			}
+
+			GetGains(instance, gainLeft, gainRight);
+
+			if (!voice.Ramped)
+			{
+				voice.GainLeft = gainLeft;
+				voice.GainRight = gainRight;
+				voice.Ramped = true;
+			}
+
+			if (!direct)
+			{
+				Gather(voice.Window, channels, voice.Fraction, fixedStep, rounded, cubic);
+			}
+
+			const float rampLeft = (gainLeft - voice.GainLeft) / count;
+			const float rampRight = (gainRight - voice.GainRight) / count;
+			const float* source = voice.Window + channels;
+
+#if __SSE__
+			__m128 left = _mm_add_ps(_mm_set1_ps(voice.GainLeft), _mm_mul_ps(_mm_set1_ps(rampLeft), _mm_set_ps(3.0f, 2.0f, 1.0f, 0.0f)));
+			__m128 right = _mm_add_ps(_mm_set1_ps(voice.GainRight), _mm_mul_ps(_mm_set1_ps(rampRight), _mm_set_ps(3.0f, 2.0f, 1.0f, 0.0f)));
+			const __m128 leftStep = _mm_set1_ps(rampLeft * 4.0f);
+			const __m128 rightStep = _mm_set1_ps(rampRight * 4.0f);
+
+			for (int i = 0; i < rounded; i += 4)
+			{
+				__m128 l, r;
+
+				if (direct)
+				{
+					if (channels == 1)
+					{
+						l = r = _mm_loadu_ps(source + i);
+					}
+					else
+					{
+						const __m128 a = _mm_loadu_ps(source + (i * 2));
+						const __m128 b = _mm_loadu_ps(source + (i * 2) + 4);
+						l = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+						r = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+					}
+				}
+				else
+				{
+					const __m128 t = _mm_load_ps(&fractions[i]);
+					l = Interpolate(0, i, t, cubic);
+					r = (channels == 1) ? l : Interpolate(1, i, t, cubic);
+				}
+
+				l = _mm_mul_ps(l, left);
+				r = _mm_mul_ps(r, right);
+				left = _mm_add_ps(left, leftStep);
+				right = _mm_add_ps(right, rightStep);
+
+				_mm_store_ps(&mix[i * 2], _mm_add_ps(_mm_load_ps(&mix[i * 2]), _mm_unpacklo_ps(l, r)));
+				_mm_store_ps(&mix[(i * 2) + 4], _mm_add_ps(_mm_load_ps(&mix[(i * 2) + 4]), _mm_unpackhi_ps(l, r)));
+			}
+#else
+			for (int i = 0; i < rounded; i++)
+			{
+				float l, r;
+
+				if (direct)
+				{
+					l = source[i * channels];
+					r = source[(i * channels) + channels - 1];
+				}
+				else
+				{
+					const float t = fractions[i];
+					float y[2];
+
+					for (int c = 0; c < channels; c++)
+					{
+						const float x1 = taps[c][1][i];
+						const float x2 = taps[c][2][i];
+
+						if (cubic)
+						{
+							const float x0 = taps[c][0][i];
+							const float x3 = taps[c][3][i];
+							const float a = (x3 - x0) + (3.0f * (x1 - x2));
+							const float b = ((2.0f * x0) + (4.0f * x2)) - (5.0f * x1) - x3;
+
+							y[c] = x1 + (0.5f * t * ((((a * t) + b) * t) + (x2 - x0)));
+						}
+						else
+						{
+							y[c] = x1 + (t * (x2 - x1));
+						}
+					}
+
+					l = y[0];
+					r = y[channels - 1];
+				}
+
+				mix[i * 2] += l * (voice.GainLeft + (rampLeft * i));
+				mix[(i * 2) + 1] += r * (voice.GainRight + (rampRight * i));
+			}
+#endif
+
+			voice.GainLeft = gainLeft;
+			voice.GainRight = gainRight;
+
+			// Frames past count in a rounded block are never written out; the voice only advances by count.
+			const unsigned long long position = voice.Fraction + (count * fixedStep);
+			const int advance = (int)(position >> 32);
+
+			voice.Fraction = (uint)position;
+			voice.Buffered -= advance;
+			memmove(voice.Window, voice.Window + (advance * channels), voice.Buffered * channels * sizeof(float));
+
+			if (voice.End >= 0)
+			{
+				voice.End -= advance;
+
+				// Frame 1 is the next to be played; once it is past the end, so is everything left in the window.
+				if (voice.End <= 1)
+				{
+					return false;
+				}
+			}
+
+			return true;
+		}
+
+		// Converts count frames of mix to 16-bit samples, saturating anything that clipped.
+		static void WriteOutput(short output[], const int count)
+		{
+			int i = 0;
+
+#if __SSE__
+			for (; i + 2 <= count; i += 2)
+			{
+				*(__m64*)(output + (i * 2)) = _mm_cvtps_pi16(_mm_load_ps(&mix[i * 2]));
+			}
+
+			_mm_empty();
+#endif
+
+			for (; i < count * 2; i++)
+			{
+				const float sample = MathHelper::Clamp(mix[i], -32768.0f, 32767.0f);
+
+				output[i] = (short)((sample >= 0.0f) ? sample + 0.5f : sample - 0.5f);
+			}
+		}
+
+		void AudioMixer::Render(short output[], const int frameCount)
+		{
+			sassert(output != null, String::Format("output; %s", FrameworkResources::ArgumentNull_Generic));
+
+			if (output == null)
+			{
+				return;
+			}
+
+			for (int first = 0; first < frameCount; first += BlockFrames)
+			{
+				const int count = ((frameCount - first) < BlockFrames) ? frameCount - first : BlockFrames;
+
+				memset(mix, 0, sizeof(mix));
+
+				for (int i = 0; i < MaxVoices; i++)
+				{
+					if (voices[i].Instance == null)
+					{
+						continue;
+					}
+
+					Interlocked::Exchange(&renderingVoice, i);
+
+					SoundEffectInstance* const instance = voices[i].Instance;
+
+					if (instance != null && instance->_state == SoundState::Playing && !MixVoice(voices[i], instance, count) &&
+						Interlocked::CompareExchange((void * volatile *)&voices[i].Instance, null, instance) == instance)
+					{
+						instance->_state = SoundState::Stopped;
+
+						if (instance->_fireAndForget)
+						{
+							delete instance;
+						}
+					}
+
+					Interlocked::Exchange(&renderingVoice, -1);
+				}
+
+				WriteOutput(output + (first * 2), count);
+			}
+		}
+	}
+}
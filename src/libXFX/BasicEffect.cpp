@@ -29,8 +29,13 @@
 #include <Vector3.h>
 #include <Graphics/BasicEffect.h>
 #include <Graphics/DirectionalLight.h>
+#include <Graphics/GraphicsDevice.h>
 #include <System/Type.h>
 
+extern "C" {
+#include "pbKit.h"
+}
+
 namespace XFX
 {
 	namespace Graphics
@@ -92,6 +97,29 @@ namespace XFX
 
 		void BasicEffect::OnApply()
 		{
+			// Select the fixed function pipeline, in case a SkinnedEffect has loaded its vertex program.
+			GraphicsDevice* device = getGraphicsDevice();
+			DWORD* p = pb_begin();
+
+			if (device->UpdateRenderState(NV20_TCL_PRIMITIVE_3D_SHADER_TYPE, SHADER_TYPE_INTERNAL))
+			{
+				pb_push1(p, NV20_TCL_PRIMITIVE_3D_SHADER_TYPE, SHADER_TYPE_INTERNAL); p += 2;
+			}
+
+			pb_end(p);
+		}
+
+		void BasicEffect::OnApplyWorld(const Matrix& world)
+		{
+			World = world;
+			OnApply();
+		}
+
+		void BasicEffect::SetMatrices(const Matrix& world, const Matrix& view, const Matrix& projection)
+		{
+			World = world;
+			View = view;
+			Projection = projection;
 		}
 	}
 }
@@ -37,7 +37,24 @@ namespace XFX
 		const String BlendState::isBoundErrorString = "";
 		const Type BlendStateTypeInfo("BlendState", "XFX::Graphics::BlendState", TypeCode::Object);
 
+		const BlendState BlendState::Additive(Blend::SourceAlpha, Blend::One);
+		const BlendState BlendState::AlphaBlend(Blend::One, Blend::InverseSourceAlpha);
+		const BlendState BlendState::NonPremultiplied(Blend::SourceAlpha, Blend::InverseSourceAlpha);
+		const BlendState BlendState::Opague(Blend::One, Blend::Zero);
+
 		BlendState::BlendState()
+			: alphaBlendFunction(BlendFunction::Add), alphaDestinationBlend(Blend::Zero), alphaSourceBlend(Blend::One),
+			blendFactor(255, 255, 255, 255), colorBlendFunction(BlendFunction::Add), colorDestinationBlend(Blend::Zero), colorSourceBlend(Blend::One),
+			colorWriteChannels(ColorWriteChannels::All), colorWriteChannels1(ColorWriteChannels::All), colorWriteChannels2(ColorWriteChannels::All), colorWriteChannels3(ColorWriteChannels::All),
+			isBound(false), multiSampleMask(-1)
+		{
+		}
+
+		BlendState::BlendState(const Blend_t sourceBlend, const Blend_t destinationBlend)
+			: alphaBlendFunction(BlendFunction::Add), alphaDestinationBlend(destinationBlend), alphaSourceBlend(sourceBlend),
+			blendFactor(255, 255, 255, 255), colorBlendFunction(BlendFunction::Add), colorDestinationBlend(destinationBlend), colorSourceBlend(sourceBlend),
+			colorWriteChannels(ColorWriteChannels::All), colorWriteChannels1(ColorWriteChannels::All), colorWriteChannels2(ColorWriteChannels::All), colorWriteChannels3(ColorWriteChannels::All),
+			isBound(false), multiSampleMask(-1)
 		{
 		}
 
@@ -56,7 +73,90 @@ namespace XFX
 			sassert(!isBound, isBoundErrorString);
 
 			alphaBlendFunction = value;
-			// TODO: verify
+		}
+
+		Blend_t BlendState::getAlphaDestinationBlend() const
+		{
+			return alphaDestinationBlend;
+		}
+
+		void BlendState::setAlphaDestinationBlend(Blend_t value)
+		{
+			sassert(!isBound, isBoundErrorString);
+
+			alphaDestinationBlend = value;
+		}
+
+		Blend_t BlendState::getAlphaSourceBlend() const
+		{
+			return alphaSourceBlend;
+		}
+
+		void BlendState::setAlphaSourceBlend(Blend_t value)
+		{
+			sassert(!isBound, isBoundErrorString);
+
+			alphaSourceBlend = value;
+		}
+
+		Color BlendState::getBlendFactor() const
+		{
+			return blendFactor;
+		}
+
+		void BlendState::setBlendFactor(Color value)
+		{
+			sassert(!isBound, isBoundErrorString);
+
+			blendFactor = value;
+		}
+
+		BlendFunction_t BlendState::getColorBlendFunction() const
+		{
+			return colorBlendFunction;
+		}
+
+		void BlendState::setColorBlendFunction(BlendFunction_t value)
+		{
+			sassert(!isBound, isBoundErrorString);
+
+			colorBlendFunction = value;
+		}
+
+		Blend_t BlendState::getColorDestinationBlend() const
+		{
+			return colorDestinationBlend;
+		}
+
+		void BlendState::setColorDestinationBlend(Blend_t value)
+		{
+			sassert(!isBound, isBoundErrorString);
+
+			colorDestinationBlend = value;
+		}
+
+		Blend_t BlendState::getColorSourceBlend() const
+		{
+			return colorSourceBlend;
+		}
+
+		void BlendState::setColorSourceBlend(Blend_t value)
+		{
+			sassert(!isBound, isBoundErrorString);
+
+			colorSourceBlend = value;
+		}
+
+		ColorWriteChannels_t BlendState::getColorWriteChannels() const
+		{
+			return colorWriteChannels;
+		}
+
+		void BlendState::setColorWriteChannels(ColorWriteChannels_t value)
+		{
+			sassert(!isBound, isBoundErrorString);
+
+			colorWriteChannels = value;
 		}
 
 		int BlendState::getMultiSampleMask() const
@@ -69,7 +169,6 @@ namespace XFX
 			sassert(!isBound, isBoundErrorString);
 
 			multiSampleMask = value;
-			// TODO: verify
 		}
 
 		void BlendState::Dispose(bool disposing)
@@ -80,5 +179,19 @@ namespace XFX
 		{
 			return BlendStateTypeInfo;
 		}
+
+		bool BlendState::operator==(const BlendState& right) const
+		{
+			return ((alphaBlendFunction == right.alphaBlendFunction) && (alphaDestinationBlend == right.alphaDestinationBlend) &&
+				(alphaSourceBlend == right.alphaSourceBlend) && (blendFactor == right.blendFactor) &&
+				(colorBlendFunction == right.colorBlendFunction) && (colorDestinationBlend == right.colorDestinationBlend) &&
+				(colorSourceBlend == right.colorSourceBlend) && (colorWriteChannels == right.colorWriteChannels) &&
+				(multiSampleMask == right.multiSampleMask));
+		}
+
+		bool BlendState::operator!=(const BlendState& right) const
+		{
+			return !(*this == right);
+		}
 	}
 }
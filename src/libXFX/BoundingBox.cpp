@@ -44,7 +44,7 @@ namespace XFX
 	const int BoundingBox::CornerCount = 8;
 	const Type BoundingBoxTypeInfo("BoundingBox", "XFX::BoundingBox", TypeCode::Object);
 	
-	BoundingBox::BoundingBox(const Vector3 min, const Vector3 max)
+	BoundingBox::BoundingBox(const Vector3& min, const Vector3& max)
 		: Max(max), Min(min)
 	{
 	}
@@ -59,47 +59,51 @@ namespace XFX
 	{
 	}
 
-	ContainmentType_t BoundingBox::Contains(BoundingBox box) const
+	ContainmentType_t BoundingBox::Contains(const BoundingBox& box) const
 	{
 		ContainmentType_t result;
 		Contains(box, result);
 		return result;
 	}
 
-	void BoundingBox::Contains(BoundingBox box, out ContainmentType_t& result) const
+	void BoundingBox::Contains(const BoundingBox& box, out ContainmentType_t& result) const
 	{
 		if( Max.X < box.Min.X || Min.X > box.Max.X )
 		{
 			result = ContainmentType::Disjoint; 
+			return;
 		}
 
 		if( Max.Y < box.Min.Y || Min.Y > box.Max.Y )
 		{
 			result = ContainmentType::Disjoint; 
+			return;
 		}
 
 		if( Max.Z < box.Min.Z || Min.Z > box.Max.Z )
 		{
 			result = ContainmentType::Disjoint; 
+			return;
 		}
 
 		if( Min.X <= box.Min.X && box.Max.X <= Max.X && Min.Y <= box.Min.Y && 
 			box.Max.Y <= Max.Y && Min.Z <= box.Min.Z && box.Max.Z <= Max.Z )
 		{
-				result = ContainmentType::Contains; 
+			result = ContainmentType::Contains; 
+			return;
 		}
 
 		result = ContainmentType::Intersects; 
 	}
 	
-	ContainmentType_t BoundingBox::Contains(BoundingSphere sphere) const
+	ContainmentType_t BoundingBox::Contains(const BoundingSphere& sphere) const
 	{
 		ContainmentType_t result;
 		Contains(sphere, result);
 		return result;
 	}
 	
-	void BoundingBox::Contains(BoundingSphere sphere, out ContainmentType_t& result) const
+	void BoundingBox::Contains(const BoundingSphere& sphere, out ContainmentType_t& result) const
 	{
 		float dist; 
 		Vector3 clamped;
@@ -116,21 +120,23 @@ namespace XFX
 		if(dist > (radius * radius))
 		{
 			result = ContainmentType::Disjoint;
+			return;
 		}
 
 		if(Min.X + radius <= sphere.Center.X && sphere.Center.X <= Max.X - radius && 
 			Max.X - Min.X > radius && Min.Y + radius <= sphere.Center.Y && 
 			sphere.Center.Y <= Max.Y - radius && Max.Y - Min.Y > radius && 
 			Min.Z + radius <= sphere.Center.Z && sphere.Center.Z <= Max.Z - radius && 
-			Max.X - Min.X > radius)
+			Max.Z - Min.Z > radius)
 		{
 			result = ContainmentType::Contains;
+			return;
 		}
 
 		result = ContainmentType::Intersects;
 	}
 	
-	ContainmentType_t BoundingBox::Contains(const Vector3 vector) const
+	ContainmentType_t BoundingBox::Contains(const Vector3& vector) const
 	{
 		if(Min.X <= vector.X && vector.X <= Max.X && Min.Y <= vector.Y && 
 			vector.Y <= Max.Y && Min.Z <= vector.Z && vector.Z <= Max.Z)
@@ -141,12 +147,13 @@ namespace XFX
 		return ContainmentType::Disjoint; 
 	}
 	
-	void BoundingBox::Contains(Vector3 vector, out ContainmentType_t& result) const
+	void BoundingBox::Contains(const Vector3& vector, out ContainmentType_t& result) const
 	{
 		if (Min.X <= vector.X && vector.X <= Max.X && Min.Y <= vector.Y && 
 			vector.Y <= Max.Y && Min.Z <= vector.Z && vector.Z <= Max.Z)
 		{
 			result = ContainmentType::Contains; 
+			return;
 		}
 
 		result = ContainmentType::Disjoint;
@@ -168,7 +175,7 @@ namespace XFX
 		return BoundingBox(min, max);
 	}
 	
-	BoundingBox BoundingBox::CreateFromSphere(BoundingSphere sphere)
+	BoundingBox BoundingBox::CreateFromSphere(const BoundingSphere& sphere)
 	{
 		BoundingBox result;
 		result.Min = Vector3(sphere.Center.X - sphere.Radius, sphere.Center.Y - sphere.Radius, sphere.Center.Z - sphere.Radius );
@@ -176,13 +183,13 @@ namespace XFX
 		return result;
 	}
 	
-	void BoundingBox::CreateFromSphere(BoundingSphere sphere, out BoundingBox& result)
+	void BoundingBox::CreateFromSphere(const BoundingSphere& sphere, out BoundingBox& result)
 	{
 		result.Min = Vector3(sphere.Center.X - sphere.Radius, sphere.Center.Y - sphere.Radius, sphere.Center.Z - sphere.Radius );
 		result.Max = Vector3(sphere.Center.X + sphere.Radius, sphere.Center.Y + sphere.Radius, sphere.Center.Z + sphere.Radius );
 	}
 	
-	BoundingBox BoundingBox::CreateMerged(BoundingBox box1, BoundingBox box2)
+	BoundingBox BoundingBox::CreateMerged(const BoundingBox& box1, const BoundingBox& box2)
 	{
 		BoundingBox result; 
 		Vector3::Min(box1.Min, box2.Min, result.Min);
@@ -190,7 +197,7 @@ namespace XFX
 		return result;
 	}
 	
-	void BoundingBox::CreateMerged(BoundingBox box1, BoundingBox box2, out BoundingBox& result)
+	void BoundingBox::CreateMerged(const BoundingBox& box1, const BoundingBox& box2, out BoundingBox& result)
 	{
 		Vector3::Min(box1.Min, box2.Min, result.Min);
 		Vector3::Max(box1.Max, box2.Max, result.Max);
@@ -216,36 +223,38 @@ namespace XFX
 		return BoundingBoxTypeInfo;
 	}
 	
-	bool BoundingBox::Intersects(BoundingBox box) const
+	bool BoundingBox::Intersects(const BoundingBox& box) const
 	{
 		bool result;
 		Intersects(box, result);
 		return result;
 	}
 	
-	void BoundingBox::Intersects(BoundingBox box, out bool& result) const
+	void BoundingBox::Intersects(const BoundingBox& box, out bool& result) const
 	{
 		if (Max.X < box.Min.X || Min.X > box.Max.X)
 		{
 			result = false;
+			return;
 		}
 
 		if (Max.Y < box.Min.Y || Min.Y > box.Max.Y)
 		{
 			result = false;
+			return;
 		}
 
 		result = (Max.Z >= box.Min.Z && Min.Z <= box.Max.Z);
 	}
 	
-	bool BoundingBox::Intersects(BoundingSphere sphere) const
+	bool BoundingBox::Intersects(const BoundingSphere& sphere) const
 	{
 		bool result;
 		Intersects(sphere, result);
 		return result;
 	}
 	
-	void BoundingBox::Intersects(BoundingSphere sphere, out bool& result) const
+	void BoundingBox::Intersects(const BoundingSphere& sphere, out bool& result) const
 	{
 		float dist;
 		Vector3 clamped;
@@ -261,24 +270,24 @@ namespace XFX
 		result = (dist <= (sphere.Radius * sphere.Radius));
 	}
 	
-	PlaneIntersectionType_t BoundingBox::Intersects(Plane plane) const
+	PlaneIntersectionType_t BoundingBox::Intersects(const Plane& plane) const
 	{
 		return plane.Intersects(*this);
 	}
 	
-	void BoundingBox::Intersects(Plane plane, out PlaneIntersectionType_t& result) const
+	void BoundingBox::Intersects(const Plane& plane, out PlaneIntersectionType_t& result) const
 	{
 		result = plane.Intersects(*this);
 	}
 	
-	float BoundingBox::Intersects(Ray ray) const
+	float BoundingBox::Intersects(const Ray& ray) const
 	{
 		float distance = 0;
 		ray.Intersects(*this, distance);
 		return distance;
 	}
 	
-	void BoundingBox::Intersects(Ray ray, out float& distance) const
+	void BoundingBox::Intersects(const Ray& ray, out float& distance) const
 	{
 		ray.Intersects(*this, distance);
 	}
@@ -28,6 +28,7 @@
 #include <System/Array.h>
 #include <System/Math.h>
 #include <System/Single.h>
+#include <System/String.h>
 #include <System/Type.h>
 #include <BoundingBox.h>
 #include <BoundingSphere.h>
@@ -37,6 +38,10 @@
 
 #include <sassert.h>
 
+#if __SSE__
+#include <xmmintrin.h>
+#endif
+
 using namespace System;
 
 namespace XFX
@@ -61,7 +66,7 @@ namespace XFX
 		cornerArray[7] = Vector3();
 	}
 
-	BoundingFrustum::BoundingFrustum(Matrix value)
+	BoundingFrustum::BoundingFrustum(const Matrix& value)
 	{
 		planes[0] = Plane();
 		planes[1] = Plane();
@@ -121,7 +126,7 @@ namespace XFX
 		return matrix;
 	}
 
-	void BoundingFrustum::setMatrix(Matrix value)
+	void BoundingFrustum::setMatrix(const Matrix& value)
 	{
 		matrix = value;
 		planes[2].Normal.X = -value.M14 - value.M11;
@@ -185,22 +190,41 @@ namespace XFX
 		return planes[4];
 	}
 
-	Vector3 BoundingFrustum::ComputeIntersection(Plane plane, Ray ray)
+	Vector3 BoundingFrustum::ComputeIntersection(const Plane& plane, const Ray& ray)
 	{
 		float num = (-plane.D - Vector3::Dot(plane.Normal, ray.Position)) / Vector3::Dot(plane.Normal, ray.Direction);
-		return (ray.Position + (ray.Direction * num));
+		return Vector3::Add(ray.Position, Vector3::Multiply(ray.Direction, num));
 	}
 
-	Ray BoundingFrustum::ComputeIntersectionLine(Plane p1, Plane p2)
+	Ray BoundingFrustum::ComputeIntersectionLine(const Plane& p1, const Plane& p2)
 	{
 		Ray ray = Ray();
 		ray.Direction = Vector3::Cross(p1.Normal, p2.Normal);
 		float num = ray.Direction.LengthSquared();
-		ray.Position = (Vector3::Cross(((p2.Normal * -p1.D) + (p1.Normal * p2.D)), ray.Direction) / num);
+		ray.Position = Vector3::Divide(Vector3::Cross(Vector3::Add(Vector3::Multiply(p2.Normal, -p1.D), Vector3::Multiply(p1.Normal, p2.D)), ray.Direction), num);
 		return ray;
 	}
 
-	ContainmentType_t BoundingFrustum::Contains(BoundingBox box)
+	bool BoundingFrustum::SeparatedAlong(const Vector3& axis, const Vector3 corners1[], const Vector3 corners2[])
+	{
+		float min1 = Single::MaxValue, max1 = Single::MinValue;
+		float min2 = Single::MaxValue, max2 = Single::MinValue;
+
+		for (int i = 0; i < 8; i++)
+		{
+			float d1 = Vector3::Dot(corners1[i], axis);
+			float d2 = Vector3::Dot(corners2[i], axis);
+
+			min1 = Math::Min(min1, d1);
+			max1 = Math::Max(max1, d1);
+			min2 = Math::Min(min2, d2);
+			max2 = Math::Max(max2, d2);
+		}
+
+		return (max1 < min2 || max2 < min1);
+	}
+
+	ContainmentType_t BoundingFrustum::Contains(const BoundingBox& box)
 	{
 		bool flag = false;
 		for(int i = 0; i < 6; i++)
@@ -224,7 +248,7 @@ namespace XFX
 		return ContainmentType::Intersects;
 	}
 
-	ContainmentType_t BoundingFrustum::Contains(BoundingFrustum frustrum)
+	ContainmentType_t BoundingFrustum::Contains(const BoundingFrustum& frustrum)
 	{
 		ContainmentType_t disjoint = ContainmentType::Disjoint;
 
@@ -244,7 +268,7 @@ namespace XFX
 		return disjoint;
 	}
 
-	ContainmentType_t BoundingFrustum::Contains(BoundingSphere sphere)
+	ContainmentType_t BoundingFrustum::Contains(const BoundingSphere& sphere)
 	{
 		Vector3 center = sphere.Center;
 		float radius = sphere.Radius;
@@ -274,7 +298,7 @@ namespace XFX
 		return ContainmentType::Contains;
 	}
 
-	ContainmentType_t BoundingFrustum::Contains(Vector3 point)
+	ContainmentType_t BoundingFrustum::Contains(const Vector3& point)
 	{
 		for (int i = 0; i < 6; i++)
 		{
@@ -289,7 +313,7 @@ namespace XFX
 		return ContainmentType::Contains;
 	}
 
-	void BoundingFrustum::Contains(BoundingBox box, out ContainmentType_t& result)
+	void BoundingFrustum::Contains(const BoundingBox& box, out ContainmentType_t& result)
 	{
 		bool flag = false;
 
@@ -310,7 +334,7 @@ namespace XFX
 		result = flag ? ContainmentType::Intersects : ContainmentType::Contains;
 	}
 
-	void BoundingFrustum::Contains(BoundingSphere sphere, out ContainmentType_t& result)
+	void BoundingFrustum::Contains(const BoundingSphere& sphere, out ContainmentType_t& result)
 	{
 		Vector3 center = sphere.Center;
 		float radius = sphere.Radius;
@@ -336,7 +360,7 @@ namespace XFX
 		result = (num2 == 6) ? ContainmentType::Contains : ContainmentType::Intersects;
 	}
 
-	void BoundingFrustum::Contains(Vector3 point, out ContainmentType_t& result)
+	void BoundingFrustum::Contains(const Vector3& point, out ContainmentType_t& result)
 	{
 		for (int i = 0; i < 6; i++)
 		{
@@ -352,6 +376,208 @@ namespace XFX
 		result = ContainmentType::Contains;
 	}
 
+#if __SSE__
+	/**
+	 * Returns a lane mask that is set for every box lying completely in front of the plane (nx, ny, nz, d).
+	 * The corner of each box nearest to the back of the plane is picked per lane, so each lane may test a different plane.
+	 */
+	static inline __m128 BoxOutside(const __m128 nx, const __m128 ny, const __m128 nz, const __m128 d, const __m128 minX, const __m128 minY, const __m128 minZ, const __m128 maxX, const __m128 maxY, const __m128 maxZ)
+	{
+		const __m128 zero = _mm_setzero_ps();
+		__m128 sx = _mm_cmpge_ps(nx, zero);
+		__m128 sy = _mm_cmpge_ps(ny, zero);
+		__m128 sz = _mm_cmpge_ps(nz, zero);
+		__m128 x = _mm_or_ps(_mm_and_ps(sx, minX), _mm_andnot_ps(sx, maxX));
+		__m128 y = _mm_or_ps(_mm_and_ps(sy, minY), _mm_andnot_ps(sy, maxY));
+		__m128 z = _mm_or_ps(_mm_and_ps(sz, minZ), _mm_andnot_ps(sz, maxZ));
+
+		__m128 distance = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, x), _mm_mul_ps(ny, y)), _mm_mul_ps(nz, z)), d);
+		return _mm_cmpgt_ps(distance, zero);
+	}
+
+	/**
+	 * Returns a lane mask that is set for every sphere lying completely in front of the plane (nx, ny, nz, d).
+	 */
+	static inline __m128 SphereOutside(const __m128 nx, const __m128 ny, const __m128 nz, const __m128 d, const __m128 x, const __m128 y, const __m128 z, const __m128 radius)
+	{
+		__m128 distance = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, x), _mm_mul_ps(ny, y)), _mm_mul_ps(nz, z)), d);
+		return _mm_cmpgt_ps(distance, radius);
+	}
+#endif
+
+	void BoundingFrustum::Cull(const float minX[], const float minY[], const float minZ[], const float maxX[], const float maxY[], const float maxZ[], const int count, uint visibility[], byte lastPlane[]) const
+	{
+		sassert(minX != null && minY != null && minZ != null && maxX != null && maxY != null && maxZ != null, String::Format("box arrays; %s", FrameworkResources::ArgumentNull_Generic));
+
+		sassert(visibility != null, String::Format("visibility; %s", FrameworkResources::ArgumentNull_Generic));
+
+		for (int i = 0; i < (count + 31) / 32; i++)
+		{
+			visibility[i] = 0;
+		}
+
+		int i = 0;
+
+#if __SSE__
+		for (; i + 4 <= count; i += 4)
+		{
+			__m128 x0 = _mm_loadu_ps(&minX[i]), y0 = _mm_loadu_ps(&minY[i]), z0 = _mm_loadu_ps(&minZ[i]);
+			__m128 x1 = _mm_loadu_ps(&maxX[i]), y1 = _mm_loadu_ps(&maxY[i]), z1 = _mm_loadu_ps(&maxZ[i]);
+			__m128 outside = _mm_setzero_ps();
+
+			if (lastPlane != null)
+			{
+				const Plane& p0 = planes[lastPlane[i]];
+				const Plane& p1 = planes[lastPlane[i + 1]];
+				const Plane& p2 = planes[lastPlane[i + 2]];
+				const Plane& p3 = planes[lastPlane[i + 3]];
+
+				outside = BoxOutside(_mm_set_ps(p3.Normal.X, p2.Normal.X, p1.Normal.X, p0.Normal.X),
+									 _mm_set_ps(p3.Normal.Y, p2.Normal.Y, p1.Normal.Y, p0.Normal.Y),
+									 _mm_set_ps(p3.Normal.Z, p2.Normal.Z, p1.Normal.Z, p0.Normal.Z),
+									 _mm_set_ps(p3.D, p2.D, p1.D, p0.D), x0, y0, z0, x1, y1, z1);
+			}
+
+			for (int j = 0; j < 6 && _mm_movemask_ps(outside) != 15; j++)
+			{
+				__m128 rejected = BoxOutside(_mm_set1_ps(planes[j].Normal.X), _mm_set1_ps(planes[j].Normal.Y), _mm_set1_ps(planes[j].Normal.Z), _mm_set1_ps(planes[j].D), x0, y0, z0, x1, y1, z1);
+				int newlyRejected = _mm_movemask_ps(_mm_andnot_ps(outside, rejected));
+
+				if (lastPlane != null)
+				{
+					for (int k = 0; k < 4; k++)
+					{
+						if (newlyRejected & (1 << k))
+						{
+							lastPlane[i + k] = (byte)j;
+						}
+					}
+				}
+
+				outside = _mm_or_ps(outside, rejected);
+			}
+
+			visibility[i >> 5] |= (uint)(~_mm_movemask_ps(outside) & 15) << (i & 31);
+		}
+#endif
+
+		for (; i < count; i++)
+		{
+			int first = (lastPlane != null) ? lastPlane[i] : 0;
+			bool visible = true;
+
+			for (int j = 0; j < 6; j++)
+			{
+				int index = (j == 0) ? first : ((j == first) ? 0 : j);
+				const Plane& plane = planes[index];
+				float x = (plane.Normal.X >= 0.0f) ? minX[i] : maxX[i];
+				float y = (plane.Normal.Y >= 0.0f) ? minY[i] : maxY[i];
+				float z = (plane.Normal.Z >= 0.0f) ? minZ[i] : maxZ[i];
+
+				if ((((plane.Normal.X * x) + (plane.Normal.Y * y)) + (plane.Normal.Z * z)) + plane.D > 0.0f)
+				{
+					if (lastPlane != null)
+					{
+						lastPlane[i] = (byte)index;
+					}
+
+					visible = false;
+					break;
+				}
+			}
+
+			if (visible)
+			{
+				visibility[i >> 5] |= 1u << (i & 31);
+			}
+		}
+	}
+
+	void BoundingFrustum::Cull(const float centerX[], const float centerY[], const float centerZ[], const float radius[], const int count, uint visibility[], byte lastPlane[]) const
+	{
+		sassert(centerX != null && centerY != null && centerZ != null && radius != null, String::Format("sphere arrays; %s", FrameworkResources::ArgumentNull_Generic));
+
+		sassert(visibility != null, String::Format("visibility; %s", FrameworkResources::ArgumentNull_Generic));
+
+		for (int i = 0; i < (count + 31) / 32; i++)
+		{
+			visibility[i] = 0;
+		}
+
+		int i = 0;
+
+#if __SSE__
+		for (; i + 4 <= count; i += 4)
+		{
+			__m128 x = _mm_loadu_ps(&centerX[i]), y = _mm_loadu_ps(&centerY[i]), z = _mm_loadu_ps(&centerZ[i]);
+			__m128 r = _mm_loadu_ps(&radius[i]);
+			__m128 outside = _mm_setzero_ps();
+
+			if (lastPlane != null)
+			{
+				const Plane& p0 = planes[lastPlane[i]];
+				const Plane& p1 = planes[lastPlane[i + 1]];
+				const Plane& p2 = planes[lastPlane[i + 2]];
+				const Plane& p3 = planes[lastPlane[i + 3]];
+
+				outside = SphereOutside(_mm_set_ps(p3.Normal.X, p2.Normal.X, p1.Normal.X, p0.Normal.X),
+										_mm_set_ps(p3.Normal.Y, p2.Normal.Y, p1.Normal.Y, p0.Normal.Y),
+										_mm_set_ps(p3.Normal.Z, p2.Normal.Z, p1.Normal.Z, p0.Normal.Z),
+										_mm_set_ps(p3.D, p2.D, p1.D, p0.D), x, y, z, r);
+			}
+
+			for (int j = 0; j < 6 && _mm_movemask_ps(outside) != 15; j++)
+			{
+				__m128 rejected = SphereOutside(_mm_set1_ps(planes[j].Normal.X), _mm_set1_ps(planes[j].Normal.Y), _mm_set1_ps(planes[j].Normal.Z), _mm_set1_ps(planes[j].D), x, y, z, r);
+				int newlyRejected = _mm_movemask_ps(_mm_andnot_ps(outside, rejected));
+
+				if (lastPlane != null)
+				{
+					for (int k = 0; k < 4; k++)
+					{
+						if (newlyRejected & (1 << k))
+						{
+							lastPlane[i + k] = (byte)j;
+						}
+					}
+				}
+
+				outside = _mm_or_ps(outside, rejected);
+			}
+
+			visibility[i >> 5] |= (uint)(~_mm_movemask_ps(outside) & 15) << (i & 31);
+		}
+#endif
+
+		for (; i < count; i++)
+		{
+			int first = (lastPlane != null) ? lastPlane[i] : 0;
+			bool visible = true;
+
+			for (int j = 0; j < 6; j++)
+			{
+				int index = (j == 0) ? first : ((j == first) ? 0 : j);
+				const Plane& plane = planes[index];
+
+				if ((((plane.Normal.X * centerX[i]) + (plane.Normal.Y * centerY[i])) + (plane.Normal.Z * centerZ[i])) + plane.D > radius[i])
+				{
+					if (lastPlane != null)
+					{
+						lastPlane[i] = (byte)index;
+					}
+
+					visible = false;
+					break;
+				}
+			}
+
+			if (visible)
+			{
+				visibility[i >> 5] |= 1u << (i & 31);
+			}
+		}
+	}
+
 	bool BoundingFrustum::Equals(Object const * const obj) const
 	{
 		return (obj != null && is(this, obj)) ? this->Equals(*(BoundingFrustum *)obj) : false;
@@ -387,28 +613,65 @@ namespace XFX
 		return BoundingFrustumTypeInfo;
 	}
 
-	bool BoundingFrustum::Intersects(BoundingBox box)
+	bool BoundingFrustum::Intersects(const BoundingBox& box)
 	{
 		bool flag = false;
 		Intersects(box, flag);
 		return flag;
 	}
 
-	bool BoundingFrustum::Intersects(BoundingFrustum frustrum)
+	bool BoundingFrustum::Intersects(const BoundingFrustum& frustrum)
 	{
-		sassert(false, "function not implemented.");
+		// Separating axis test: two convex hulls are disjoint if and only if their projections onto one of the face normals,
+		// or onto the cross product of an edge from each, do not overlap.
+		static const int edges[12][2] =
+		{
+			{ 0, 1 }, { 1, 2 }, { 2, 3 }, { 3, 0 },
+			{ 4, 5 }, { 5, 6 }, { 6, 7 }, { 7, 4 },
+			{ 0, 4 }, { 1, 5 }, { 2, 6 }, { 3, 7 }
+		};
+
+		for (int i = 0; i < 6; i++)
+		{
+			if (SeparatedAlong(planes[i].Normal, cornerArray, frustrum.cornerArray) || SeparatedAlong(frustrum.planes[i].Normal, cornerArray, frustrum.cornerArray))
+			{
+				return false;
+			}
+		}
 
-		return false;
+		for (int i = 0; i < 12; i++)
+		{
+			Vector3 edge1 = Vector3::Subtract(cornerArray[edges[i][1]], cornerArray[edges[i][0]]);
+
+			for (int j = 0; j < 12; j++)
+			{
+				Vector3 edge2 = Vector3::Subtract(frustrum.cornerArray[edges[j][1]], frustrum.cornerArray[edges[j][0]]);
+				Vector3 axis = Vector3::Cross(edge1, edge2);
+
+				// parallel edges don't define an axis
+				if (axis.LengthSquared() < 1E-12f)
+				{
+					continue;
+				}
+
+				if (SeparatedAlong(axis, cornerArray, frustrum.cornerArray))
+				{
+					return false;
+				}
+			}
+		}
+
+		return true;
 	}
 
-	bool BoundingFrustum::Intersects(BoundingSphere sphere)
+	bool BoundingFrustum::Intersects(const BoundingSphere& sphere)
 	{
 		bool flag = false;
 		Intersects(sphere, flag);
 		return flag;
 	}
 
-	PlaneIntersectionType_t BoundingFrustum::Intersects(Plane plane)
+	PlaneIntersectionType_t BoundingFrustum::Intersects(const Plane& plane)
 	{
 		int num = 0;
 
@@ -440,24 +703,28 @@ namespace XFX
 		return PlaneIntersectionType::Front;
 	}
 
-	float BoundingFrustum::Intersects(Ray ray)
+	float BoundingFrustum::Intersects(const Ray& ray)
 	{
 		float result = 0;
 		Intersects(ray, result);
 		return result;
 	}
 
-	void BoundingFrustum::Intersects(BoundingBox box, out bool& result)
+	void BoundingFrustum::Intersects(const BoundingBox& box, out bool& result)
 	{
-		sassert(false, "function not implemented.");
+		ContainmentType_t containment;
+		Contains(box, containment);
+		result = (containment != ContainmentType::Disjoint);
 	}
 
-	void BoundingFrustum::Intersects(BoundingSphere sphere, out bool& result)
+	void BoundingFrustum::Intersects(const BoundingSphere& sphere, out bool& result)
 	{
-		sassert(false, "function not implemented.");
+		ContainmentType_t containment;
+		Contains(sphere, containment);
+		result = (containment != ContainmentType::Disjoint);
 	}
 
-	void BoundingFrustum::Intersects(Plane plane, out PlaneIntersectionType_t& result)
+	void BoundingFrustum::Intersects(const Plane& plane, out PlaneIntersectionType_t& result)
 	{
 		int num = 0;
 
@@ -485,7 +752,7 @@ namespace XFX
 		result = (num == 1) ? PlaneIntersectionType::Front : PlaneIntersectionType::Back;
 	}
 
-	void BoundingFrustum::Intersects(Ray ray, out float& result)
+	void BoundingFrustum::Intersects(const Ray& ray, out float& result)
 	{
 		ContainmentType_t type = Contains(ray.Position);
 
@@ -555,6 +822,12 @@ namespace XFX
 		}
 	}
 
+	const String BoundingFrustum::ToString() const
+	{
+		return String::Format("{Near:%s Far:%s Left:%s Right:%s Top:%s Bottom:%s}", (const char*)planes[0].ToString(), (const char*)planes[1].ToString(),
+			(const char*)planes[2].ToString(), (const char*)planes[3].ToString(), (const char*)planes[4].ToString(), (const char*)planes[5].ToString());
+	}
+
 	bool BoundingFrustum::operator !=(const BoundingFrustum& right) const
 	{
 		return !Equals(right);
@@ -33,7 +33,7 @@ namespace XFX
 {
 	const Type BoundingSphereTypeInfo("BoundingSphere", "XFX::BoundingSphere", TypeCode::Object);
 
-	BoundingSphere::BoundingSphere(const Vector3 center, const float radius)
+	BoundingSphere::BoundingSphere(const Vector3& center, const float radius)
 		: Center(center), Radius(radius)
 	{
 	}
@@ -185,7 +185,7 @@ namespace XFX
 		const Color Color::Turquoise = Color(((uint)255 << 24) + ((uint)64 << 16) + ((uint)224 << 8) + 208);
 		const Color Color::Violet = Color(((uint)255 << 24) + ((uint)238 << 16) + ((uint)130 << 8) + 238);
 		const Color Color::Wheat = Color(((uint)255 << 24) + ((uint)245 << 16) + ((uint)222 << 8) + 179);
-		const Color Color::White = Color(0xFFFFFF);
+		const Color Color::White = Color(((uint)255 << 24) + ((uint)255 << 16) + ((uint)255 << 8) + 255);
 		const Color Color::WhiteSmoke = Color(((uint)255 << 24) + ((uint)245 << 16) + ((uint)245 << 8) + 245);
 		const Color Color::Yellow = Color(((uint)255 << 24) + ((uint)255 << 16) + ((uint)255 << 8) + 0);
 		const Color Color::YellowGreen = Color(((uint)255 << 24) + ((uint)154 << 16) + ((uint)205 << 8) + 50);
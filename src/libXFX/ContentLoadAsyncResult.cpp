@@ -0,0 +1,72 @@
+// Copyright (C) XFX Team
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without 
+// modification, are permitted provided that the following conditions are met:
+// 
+//     * Redistributions of source code must retain the above copyright 
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright 
+//       notice, this list of conditions and the following disclaimer in the 
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the copyright holder nor the names of any 
+//       contributors may be used to endorse or promote products derived from 
+//       this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE 
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF 
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS 
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE 
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include <Content/ContentManager.h>
+
+#include "ContentLoadAsyncResult.h"
+
+namespace XFX
+{
+	namespace Content
+	{
+		ContentLoadAsyncResult::ContentLoadAsyncResult(ContentManager * const contentManager, const String& assetName, const Type& assetType,
+			void* (*readAsset)(ContentReader * const), void (*releaseAsset)(void * const), AsyncCallback callback, Object * const state)
+			: contentManager(contentManager), assetName(assetName), assetType(&assetType), readAsset(readAsset), releaseAsset(releaseAsset),
+			  callback(callback), asyncState(state), asset(null), decoded(0), completed(false), completedSynchronously(false), next(null)
+		{
+		}
+
+		Object* ContentLoadAsyncResult::AsyncState()
+		{
+			return asyncState;
+		}
+
+		WaitHandle* ContentLoadAsyncResult::AsyncWaitHandle()
+		{
+			return null;
+		}
+
+		bool ContentLoadAsyncResult::CompletedSynchronously() const
+		{
+			return completedSynchronously;
+		}
+
+		void ContentLoadAsyncResult::Decode()
+		{
+			asset = contentManager->ReadAsset(assetName, readAsset);
+
+			// x86 does not reorder stores, so the asset is visible to the game thread once it sees the flag; the barrier keeps the compiler from reordering them.
+			__asm__ __volatile__("" : : : "memory");
+			decoded = 1;
+		}
+
+		bool ContentLoadAsyncResult::IsCompleted() const
+		{
+			return completed;
+		}
+	}
+}
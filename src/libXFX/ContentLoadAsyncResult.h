@@ -0,0 +1,60 @@
+/*****************************************************************************
+ *	ContentLoadAsyncResult.h												 *
+ *																			 *
+ *	XFX::Content::ContentLoadAsyncResult class definition file				 *
+ *	Copyright (c) XFX Team. All Rights Reserved 							 *
+ *****************************************************************************/
+#ifndef _XFX_CONTENT_CONTENTLOADASYNCRESULT_
+#define _XFX_CONTENT_CONTENTLOADASYNCRESULT_
+
+#include <System/Delegates.h>
+#include <System/Interfaces.h>
+#include <System/String.h>
+
+using namespace System;
+using namespace System::Threading;
+
+namespace XFX
+{
+	namespace Content
+	{
+		class ContentManager;
+		class ContentReader;
+
+		// The state of a single ContentManager::LoadAsync call.
+		// The asset is decoded on the content thread; everything else is only touched on the game thread.
+		class ContentLoadAsyncResult : public IAsyncResult
+		{
+			friend class ContentManager;
+
+		private:
+			ContentManager* contentManager;
+			String assetName;
+			const Type* assetType;
+			void* (*readAsset)(ContentReader * const input);
+			void (*releaseAsset)(void * const asset);
+			AsyncCallback callback;
+			Object* asyncState;
+			void* asset;
+			volatile int decoded;
+			bool completed;
+			bool completedSynchronously;
+			ContentLoadAsyncResult* next;
+
+			ContentLoadAsyncResult(ContentManager * const contentManager, const String& assetName, const Type& assetType,
+				void* (*readAsset)(ContentReader * const), void (*releaseAsset)(void * const), AsyncCallback callback, Object * const state);
+			ContentLoadAsyncResult(const ContentLoadAsyncResult &obj);
+
+			void Decode();
+
+		public:
+			Object* AsyncState();
+			// There is no kernel-backed WaitHandle yet; use ContentManager::EndLoad to wait for the asset.
+			WaitHandle* AsyncWaitHandle();
+			bool CompletedSynchronously() const;
+			bool IsCompleted() const;
+		};
+	}
+}
+
+#endif //_XFX_CONTENT_CONTENTLOADASYNCRESULT_
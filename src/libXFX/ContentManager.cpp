@@ -26,14 +26,16 @@
 // POSSIBILITY OF SUCH DAMAGE.
 
 #include <System/String.h>
-#include <System/IO/File.h>
-#include <System/IO/FileStream.h>
+#include <System/IO/MappedFileStream.h>
 #include <System/IO/IOException.h>
 #include <System/IO/Path.h>
+#include <System/Threading/Thread.h>
 #include <Content/ContentLoadException.h>
 #include <Content/ContentManager.h>
 #include <Content/ContentReader.h>
 
+#include "ContentLoadAsyncResult.h"
+
 #include <string.h>
 
 #if ENABLE_XBOX
@@ -47,13 +49,65 @@ extern "C" {
 #include <sassert.h>
 
 using namespace System;
+using namespace System::Threading;
 
 namespace XFX
 {
 	namespace Content
-	{	
+	{
+		const Type ContentManagerTypeInfo("ContentManager", "XFX::Content::ContentManager", TypeCode::Object);
+
+#if ENABLE_XBOX
+		// One background thread decodes the assets of every ContentManager, in the order in which they were requested.
+		static Thread* loaderThread = null;
+		static RTL_CRITICAL_SECTION loaderLock;
+		static KEVENT loaderEvent;
+		static ContentLoadAsyncResult* loaderQueueHead = null;
+		static ContentLoadAsyncResult* loaderQueueTail = null;
+
+		static VOID NTAPI LoaderThreadProc(PVOID StartContext1, PVOID StartContext2)
+		{
+			while (true)
+			{
+				KeWaitForSingleObject(&loaderEvent, Executive, KernelMode, FALSE, NULL);
+
+				// the event resets itself on wake-up, so drain everything that was queued in the meantime
+				while (true)
+				{
+					RtlEnterCriticalSection(&loaderLock);
+
+					ContentLoadAsyncResult* result = loaderQueueHead;
+
+					if (result != null)
+					{
+						loaderQueueHead = result->next;
+
+						if (loaderQueueHead == null)
+						{
+							loaderQueueTail = null;
+						}
+					}
+
+					RtlLeaveCriticalSection(&loaderLock);
+
+					if (result == null)
+					{
+						break;
+					}
+
+					result->Decode();
+				}
+			}
+		}
+#endif
+
+		IServiceProvider* ContentManager::getServiceProvider() const
+		{
+			return _provider;
+		}
+
 		ContentManager::ContentManager(IServiceProvider* provider)
-			: RootDirectory(String::Empty)
+			: disposed(false), RootDirectory(String::Empty)
 		{
 			sassert(provider != null, String::Format("provider; %s", FrameworkResources::ArgumentNull_Generic));
 
@@ -61,6 +115,7 @@ namespace XFX
 		}
 
 		ContentManager::ContentManager(IServiceProvider* provider, const String& rootDirectory)
+			: disposed(false)
 		{
 			sassert(provider != null, String::Format("provider; %s", FrameworkResources::ArgumentNull_Generic));
 
@@ -75,6 +130,109 @@ namespace XFX
 			Dispose(false);
 		}
 
+		void ContentManager::AddAsset(const String& assetName, const Type& assetType, void * const asset, void (*release)(void*))
+		{
+			AssetEntry entry;
+
+			entry.Asset = asset;
+			entry.AssetType = &assetType;
+			entry.Release = release;
+			entry.ReferenceCount = 1;
+
+			loadedAssets.Add(assetName, entry);
+		}
+
+		IAsyncResult* ContentManager::BeginLoad(const String& assetName, const Type& assetType, void* (*read)(ContentReader * const), void (*release)(void*), AsyncCallback callback, Object* state)
+		{
+			sassert(!disposed, "ContentManager; Cannot access a disposed object.");
+
+			sassert(!String::IsNullOrEmpty(assetName), String::Format("assetName; %s", FrameworkResources::ArgumentNull_Generic));
+
+			ContentLoadAsyncResult* result = new ContentLoadAsyncResult(this, GetCleanPath(assetName), assetType, read, release, callback, state);
+
+			pendingLoads.Add(result);
+
+			if (loadedAssets.ContainsKey(result->assetName))
+			{
+				// Already cached; the reference is added when the result is handed back, like any other load.
+				result->completedSynchronously = true;
+				result->decoded = 1;
+			}
+			else
+			{
+				QueueLoad(result);
+			}
+
+			return result;
+		}
+
+		void ContentManager::CompleteLoad(ContentLoadAsyncResult * const result)
+		{
+			if (result->completed)
+			{
+				return;
+			}
+
+			// EndLoad may be called before the content thread is done with the asset
+			while (!result->decoded)
+			{
+				Thread::Sleep(1);
+			}
+
+			AssetEntry entry;
+
+			if (loadedAssets.TryGetValue(result->assetName, entry))
+			{
+				sassert(entry.AssetType == result->assetType, String::Format("Error loading \"%s\". Asset was loaded before as a different type.", (const char*)result->assetName));
+
+				// Another load of the same asset got there first; keep one instance.
+				if (result->asset != null)
+				{
+					result->releaseAsset(result->asset);
+				}
+
+				loadedAssets[result->assetName].ReferenceCount++;
+				result->asset = entry.Asset;
+			}
+			else
+			{
+				// the cached instance this request was going to share has been unloaded in the meantime
+				if (result->asset == null)
+				{
+					result->asset = ReadAsset(result->assetName, result->readAsset);
+				}
+
+				AddAsset(result->assetName, *result->assetType, result->asset, result->releaseAsset);
+			}
+
+			result->completed = true;
+		}
+
+		void ContentManager::DispatchCompletedLoads()
+		{
+			List<ContentLoadAsyncResult*> completedLoads;
+
+			for (int i = 0; i < pendingLoads.Count(); i++)
+			{
+				ContentLoadAsyncResult* result = pendingLoads[i];
+
+				if (!result->completed && result->decoded)
+				{
+					CompleteLoad(result);
+					completedLoads.Add(result);
+				}
+			}
+
+			// Callbacks usually call EndLoad, which removes the result from pendingLoads, so they are invoked after the loop above.
+			for (int i = 0; i < completedLoads.Count(); i++)
+			{
+				if (completedLoads[i]->callback != null)
+				{
+					completedLoads[i]->callback(completedLoads[i]);
+				}
+			}
+		}
+
 		void ContentManager::Dispose(bool disposing)
 		{
 			if (!disposed)
@@ -94,94 +252,165 @@ namespace XFX
 			Dispose(true);
 		}
 
-		const Type& ContentManager::GetType()
+		void ContentManager::DisposeAsset(IDisposable * const asset)
+		{
+			asset->Dispose();
+		}
+
+		void ContentManager::DisposeAsset(...)
 		{
 		}
 
-		template <class T>
-		T* ContentManager::Load(const String& assetName)
+		void* ContentManager::EndLoad(IAsyncResult * const asyncResult, const Type& assetType)
 		{
-			T dummyVal;
-			Object* obj2;
+			// there is no RTTI to verify the cast with, so check that the result came from this ContentManager instead
+			ContentLoadAsyncResult* result = (ContentLoadAsyncResult*)asyncResult;
 
-			sassert(!disposed, "" + GetType().ToString());
+			sassert(result != null, String::Format("asyncResult; %s", FrameworkResources::ArgumentNull_Generic));
 
-			sassert(!String::IsNullOrEmpty(assetName), String::Format("assetName; %s", FrameworkResources::ArgumentNull_Generic));
+			sassert(result->contentManager == this, "asyncResult; The IAsyncResult was not returned by this ContentManager.");
 
-			assetName = GetCleanPath(assetName);
+			sassert(result->assetType == &assetType, String::Format("Error loading \"%s\". The asset was requested as a different type.", (const char*)result->assetName));
 
-			/* TODO: port the C# code below to C++
-			object obj2;
-			if (this.loadedAssets == null)
-			{
-				throw new ObjectDisposedException(this.ToString());
-			}
-			if (string.IsNullOrEmpty(assetName))
-			{
-				throw new ArgumentNullException("assetName");
-			}
-			assetName = GetCleanPath(assetName);
-			if (this.loadedAssets.TryGetValue(assetName, out obj2))
+			CompleteLoad(result);
+			pendingLoads.Remove(result);
+
+			void* asset = result->asset;
+			delete result;
+			return asset;
+		}
+
+		String ContentManager::GetCleanPath(const String& path)
+		{
+			// Both separators are accepted and "." and ".." segments are folded, so each asset has exactly one cache key.
+			int length = path.Length;
+			char* buffer = new char[length + 1];
+			int* segmentStarts = new int[length + 1];
+			int segmentCount = 0;
+			int position = 0;
+
+			for (int start = 0; start <= length; )
 			{
-				if (!(obj2 is T))
+				int end = start;
+
+				while (end < length && path[end] != '/' && path[end] != '\\')
+				{
+					end++;
+				}
+
+				int segmentLength = end - start;
+
+				if (segmentLength == 1 && path[start] == '.')
+				{
+					// "." refers to the current directory
+				}
+				else if (segmentLength == 2 && path[start] == '.' && path[start + 1] == '.' && segmentCount > 0 &&
+						 !(position - segmentStarts[segmentCount - 1] == 2 && buffer[position - 1] == '.' && buffer[position - 2] == '.'))
+				{
+					// ".." cancels out the previous segment, unless that segment is a ".." we could not resolve either
+					position = segmentStarts[--segmentCount];
+
+					if (position > 0)
+					{
+						position--;
+					}
+				}
+				else if (segmentLength > 0 || segmentCount == 0)
 				{
-					throw new ContentLoadException(string.Format(CultureInfo.CurrentCulture, FrameworkResources.BadXnbWrongType, new object[] { assetName, obj2.GetType(), typeof(T) }));
+					if (segmentCount > 0)
+					{
+						buffer[position++] = Path::DirectorySeparatorChar;
+					}
+
+					segmentStarts[segmentCount++] = position;
+
+					for (int i = start; i < end; i++)
+					{
+						buffer[position++] = path[i];
+					}
 				}
-				return (T) obj2;
+
+				start = end + 1;
 			}
-			T local = this.ReadAsset<T>(assetName, null);
-			this.loadedAssets.Add(assetName, local);
-			return local;
-			*/
+
+			buffer[position] = '\0';
+
+			String result(buffer);
+			delete[] segmentStarts;
+			delete[] buffer;
+			return result;
+		}
+
+		const Type& ContentManager::GetType()
+		{
+			return ContentManagerTypeInfo;
+		}
+
+		void* ContentManager::LoadAsset(const String& assetName, const Type& assetType, void* (*read)(ContentReader * const), void (*release)(void*))
+		{
+			sassert(!disposed, "ContentManager; Cannot access a disposed object.");
 
 			sassert(!String::IsNullOrEmpty(assetName), String::Format("assetName; %s", FrameworkResources::ArgumentNull_Generic));
-			/*if (this->loadedAssets.TryGetValue(assetName, obj2))
+
+			String cleanName = GetCleanPath(assetName);
+			AssetEntry entry;
+
+			if (loadedAssets.TryGetValue(cleanName, entry))
 			{
-				sassert(is(obj2, &dummyVal), "");
+				sassert(entry.AssetType == &assetType, String::Format("Error loading \"%s\". Asset was loaded before as a different type.", (const char*)cleanName));
 
-				return (T)obj2;
-			}*/
-			T local = ReadAsset<T>(assetName);
-			loadedAssets.Add(assetName, local);
-			return local;
+				loadedAssets[cleanName].ReferenceCount++;
+				return entry.Asset;
+			}
+
+			void* asset = ReadAsset(cleanName, read);
+			AddAsset(cleanName, assetType, asset, release);
+			return asset;
 		}
 
 		Stream* ContentManager::OpenStream(const String& assetName)
 		{
-			Stream* stream;
-			/*try
+			String path = Path::Combine(RootDirectory, assetName + ".xnb");
+
+			// MappedFileStream reports a file that is missing, so it is not looked up twice; the whole file is kept in memory while the asset is read, so readers can use its data in place
+			return new MappedFileStream(path);
+		}
+
+		void ContentManager::QueueLoad(ContentLoadAsyncResult * const result)
+		{
+#if ENABLE_XBOX
+			if (loaderThread == null)
 			{
-				int len = strlen(assetName);
+				RtlInitializeCriticalSection(&loaderLock);
+				KeInitializeEvent(&loaderEvent, SynchronizationEvent, FALSE);
 
-				if (assetName[len-4] != '.')
-				{
-					//! XNA-style assetName, huh? Then it must be an .xnb file.
-					char* path = Path::Combine(RootDirectory, strcat(assetName, ".xnb"));
-					stream = File::OpenRead(path);
-				}
-				else
-				{
-					//! just a normal, for example, .png file
-					stream = File::OpenRead(assetName);
-				}
+				loaderThread = new Thread((PKSTART_ROUTINE)LoaderThreadProc);
+				loaderThread->Start();
 			}
-			catch(FileNotFoundException fileNotFound)
+
+			RtlEnterCriticalSection(&loaderLock);
+
+			if (loaderQueueTail != null)
 			{
-				throw ContentLoadException("The content file was not found.", fileNotFound);
+				loaderQueueTail->next = result;
 			}
-			catch(DirectoryNotFoundException directoryNotFound)
+			else
 			{
-				throw ContentLoadException("The directory was not found.", directoryNotFound);
+				loaderQueueHead = result;
 			}
-			catch(Exception exception)
-			{
-				throw ContentLoadException("Error opening stream.", exception);
-			}*/
-			return stream;
+
+			loaderQueueTail = result;
+
+			RtlLeaveCriticalSection(&loaderLock);
+
+			KeSetEvent(&loaderEvent, 0, FALSE);
+#else
+			// no content thread on this platform; the asset is still handed back at the next frame boundary
+			result->Decode();
+#endif
 		}
 
-		template <class T>
-		T* ContentManager::ReadAsset(const String& assetName)
+		void* ContentManager::ReadAsset(const String& assetName, void* (*read)(ContentReader * const))
 		{
 			sassert(!disposed, "");
 
@@ -193,10 +422,24 @@ namespace XFX
 			sassert(!String::IsNullOrEmpty(assetName), String::Format("assetName; %s", FrameworkResources::ArgumentNull_Generic));
 
 			Stream* assetStream = OpenStream(assetName);
-			
-			ContentReader reader = ContentReader(this, assetStream, assetName);
-			
-			return reader.ReadAsset<T>();
+			Stream* body;
+			void* asset;
+
+			{
+				ContentReader reader(this, assetStream, assetName);
+
+				asset = reader.ReadAsset(read);
+				body = reader.BaseStream();
+			}
+
+			// The reader closes the streams, but does not free them; a compressed asset was read through a stream of its own.
+			if (body != assetStream)
+			{
+				delete body;
+			}
+
+			delete assetStream;
+			return asset;
 		}
 
 		void ContentManager::Unload()
@@ -208,12 +451,44 @@ namespace XFX
 				//throw ObjectDisposedException("ContentManager");
 			}
 
-			for(int i = 0; i < disposableAssets.Count(); i++)
+			// The content thread still refers to anything it has not finished, so wait for it before freeing the assets.
+			for (int i = 0; i < pendingLoads.Count(); i++)
+			{
+				CompleteLoad(pendingLoads[i]);
+				pendingLoads[i]->asset = null;
+			}
+
+			IEnumerator<KeyValuePair<String, AssetEntry> >* enumerator = loadedAssets.GetEnumerator();
+
+			while (enumerator->MoveNext())
+			{
+				AssetEntry entry = enumerator->Current().Value;
+				entry.Release(entry.Asset);
+			}
+
+			delete enumerator;
+			loadedAssets.Clear();
+		}
+
+		void ContentManager::UnloadAsset(const String& assetName)
+		{
+			sassert(!disposed, "ContentManager; Cannot access a disposed object.");
+
+			sassert(!String::IsNullOrEmpty(assetName), String::Format("assetName; %s", FrameworkResources::ArgumentNull_Generic));
+
+			String cleanName = GetCleanPath(assetName);
+			AssetEntry entry;
+
+			if (!loadedAssets.TryGetValue(cleanName, entry))
+			{
+				return;
+			}
+
+			if (--loadedAssets[cleanName].ReferenceCount == 0)
 			{
-				disposableAssets[i]->Dispose();
+				entry.Release(entry.Asset);
+				loadedAssets.Remove(cleanName);
 			}
-			//loadedAssets.Clear();
-			disposableAssets.Clear();
 		}
 	}
 }
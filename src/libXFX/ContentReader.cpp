@@ -26,12 +26,20 @@
 // POSSIBILITY OF SUCH DAMAGE.
 
 #include <Content/ContentReader.h>
+#include <Graphics/IGraphicsDeviceService.h>
+#include <System/String.h>
 #include <Matrix.h>
 #include <Quaternion.h>
 #include <Vector2.h>
 #include <Vector3.h>
 #include <Vector4.h>
 
+#include "LzxDecoderStream.h"
+#include "XNBFile.h"
+
+#include <sassert.h>
+#include <string.h>
+
 namespace XFX
 {
 	namespace Content
@@ -48,13 +56,34 @@ namespace XFX
 			return contentManager;
 		}
 
+		GraphicsDevice* ContentReader::getGraphicsDevice() const
+		{
+			if (_graphicsDevice != null || contentManager == null)
+			{
+				return _graphicsDevice;
+			}
+
+			// Readers created by ContentManager find the device the way XNA does, through the manager's IGraphicsDeviceService.
+			IGraphicsDeviceService* graphicsService = (IGraphicsDeviceService *)contentManager->getServiceProvider()->GetService(IGraphicsDeviceService::GetType());
+
+			sassert(graphicsService != null, "No Graphics Device Service");
+
+			return (graphicsService != null) ? graphicsService->getGraphicsDevice() : null;
+		}
+
+		int ContentReader::getVersion() const
+		{
+			// PrepareStream refuses any other version.
+			return XnbVersion;
+		}
+
 		ContentReader::ContentReader(ContentManager * const manager, Stream * const stream, GraphicsDevice * const graphicsDevice) 
 			: BinaryReader(stream), contentManager(manager), _graphicsDevice(graphicsDevice)
 		{
 		}
 
 		ContentReader::ContentReader(ContentManager * const manager, Stream * const input, const String& assetName)
-			: BinaryReader(PrepareStream(input, assetName)), contentManager(manager), _assetName(assetName)
+			: BinaryReader(PrepareStream(input, assetName)), contentManager(manager), _graphicsDevice(null), _assetName(assetName)
 		{
 		}
 
@@ -63,67 +92,182 @@ namespace XFX
 			// TODO: implement
 		}
 
-		Stream* ContentReader::PrepareStream(Stream * const, const String& assetName)
+		Stream* ContentReader::PrepareStream(Stream * const input, const String& assetName)
 		{
-			// TODO: implement
+			// the header is 10 bytes: "XNB", the target platform, the format version, flags and the size of the whole file
+			byte header[10];
+			XNBFile xnb;
+
+			for (int read = 0; read < 10; )
+			{
+				int num = input->Read(header, read, 10 - read);
+
+				sassert(num > 0, String::Format("Error loading \"%s\". File is not a valid XNB file.", (const char*)assetName));
+
+				if (num <= 0)
+				{
+					return null;
+				}
+
+				read += num;
+			}
+
+			xnb.FormatID1 = header[0];
+			xnb.FormatID2 = header[1];
+			xnb.FormatID3 = header[2];
+			xnb.TargetPlatform = header[3];
+			xnb.XNBVersion = header[4];
+			xnb.FlagBits = header[5];
+			xnb.CompressedSize = header[6] | (header[7] << 8) | (header[8] << 16) | (header[9] << 24);
+
+			sassert(xnb.FormatID1 == 'X' && xnb.FormatID2 == 'N' && xnb.FormatID3 == 'B', String::Format("Error loading \"%s\". File is not a valid XNB file.", (const char*)assetName));
+
+			sassert(xnb.XNBVersion == XnbVersion, String::Format("Error loading \"%s\". This file was built for a different version of XNA.", (const char*)assetName));
+
+			if ((xnb.FlagBits & 0x80) == 0)
+			{
+				xnb.UncompressedSize = xnb.CompressedSize;
+				return input;
+			}
+
+			// compressed files store the decompressed size of the body next; the body is decompressed while it is read
+			for (int read = 0; read < 4; )
+			{
+				int num = input->Read(header, read, 4 - read);
+
+				sassert(num > 0, String::Format("Error loading \"%s\". File is not a valid XNB file.", (const char*)assetName));
+
+				if (num <= 0)
+				{
+					return null;
+				}
+
+				read += num;
+			}
+
+			xnb.UncompressedSize = header[0] | (header[1] << 8) | (header[2] << 16) | (header[3] << 24);
+
+			return new LzxDecoderStream(input, xnb.CompressedSize - 14, xnb.UncompressedSize);
+		}
+
+		void* ContentReader::ReadAsset(void* (*read)(ContentReader * const input))
+		{
+			// The type readers the file names are skipped rather than looked up: the type the asset is loaded as picks its reader.
+			const int typeReaderCount = Read7BitEncodedInt();
+
+			for (int i = 0; i < typeReaderCount; i++)
+			{
+				ReadSpan(Read7BitEncodedInt());
+				ReadInt32();
+			}
+
+			const int sharedResourceCount = Read7BitEncodedInt();
+
+			sassert(sharedResourceCount == 0, String::Format("Error loading \"%s\". Shared resources are not supported.", (const char*)_assetName));
+
+			// a type id of zero is a null asset
+			if (Read7BitEncodedInt() == 0)
+			{
+				return null;
+			}
+
+			return read(this);
+		}
+
+		// one span per value instead of a virtual ReadSingle call per component
+		static inline float ToSingle(const byte* data, const int index)
+		{
+			float value;
+			memcpy(&value, &data[index * sizeof(float)], sizeof(value));
+			return value;
 		}
 
 		Matrix ContentReader::ReadMatrix()
 		{
 			Matrix result;
-			result.M11 = ReadSingle();
-			result.M12 = ReadSingle();
-			result.M13 = ReadSingle();
-			result.M14 = ReadSingle();
-			result.M21 = ReadSingle();
-			result.M22 = ReadSingle();
-			result.M23 = ReadSingle();
-			result.M24 = ReadSingle();
-			result.M31 = ReadSingle();
-			result.M32 = ReadSingle();
-			result.M33 = ReadSingle();
-			result.M34 = ReadSingle();
-			result.M41 = ReadSingle();
-			result.M42 = ReadSingle();
-			result.M43 = ReadSingle();
-			result.M44 = ReadSingle();
+			const byte* data = ReadSpan(16 * sizeof(float));
+
+			if (data != null)
+			{
+				result.M11 = ToSingle(data, 0);
+				result.M12 = ToSingle(data, 1);
+				result.M13 = ToSingle(data, 2);
+				result.M14 = ToSingle(data, 3);
+				result.M21 = ToSingle(data, 4);
+				result.M22 = ToSingle(data, 5);
+				result.M23 = ToSingle(data, 6);
+				result.M24 = ToSingle(data, 7);
+				result.M31 = ToSingle(data, 8);
+				result.M32 = ToSingle(data, 9);
+				result.M33 = ToSingle(data, 10);
+				result.M34 = ToSingle(data, 11);
+				result.M41 = ToSingle(data, 12);
+				result.M42 = ToSingle(data, 13);
+				result.M43 = ToSingle(data, 14);
+				result.M44 = ToSingle(data, 15);
+			}
+
 			return result;
 		}
 
 		Quaternion ContentReader::ReadQuaternion()
 		{
 			Quaternion result;
-			result.X = ReadSingle();
-			result.Y = ReadSingle();
-			result.Z = ReadSingle();
-			result.W = ReadSingle();
+			const byte* data = ReadSpan(4 * sizeof(float));
+
+			if (data != null)
+			{
+				result.X = ToSingle(data, 0);
+				result.Y = ToSingle(data, 1);
+				result.Z = ToSingle(data, 2);
+				result.W = ToSingle(data, 3);
+			}
+
 			return result;
 		}
 
 		Vector2 ContentReader::ReadVector2()
 		{
 			Vector2 result;
-			result.X = ReadSingle();
-			result.Y = ReadSingle();
+			const byte* data = ReadSpan(2 * sizeof(float));
+
+			if (data != null)
+			{
+				result.X = ToSingle(data, 0);
+				result.Y = ToSingle(data, 1);
+			}
+
 			return result;
 		}
 
 		Vector3 ContentReader::ReadVector3()
 		{
 			Vector3 result;
-			result.X = ReadSingle();
-			result.Y = ReadSingle();
-			result.Z = ReadSingle();
+			const byte* data = ReadSpan(3 * sizeof(float));
+
+			if (data != null)
+			{
+				result.X = ToSingle(data, 0);
+				result.Y = ToSingle(data, 1);
+				result.Z = ToSingle(data, 2);
+			}
+
 			return result;
 		}
 
 		Vector4 ContentReader::ReadVector4()
 		{
 			Vector4 result;
-			result.X = ReadSingle();
-			result.Y = ReadSingle();
-			result.Z = ReadSingle();
-			result.W = ReadSingle();
+			const byte* data = ReadSpan(4 * sizeof(float));
+
+			if (data != null)
+			{
+				result.X = ToSingle(data, 0);
+				result.Y = ToSingle(data, 1);
+				result.Z = ToSingle(data, 2);
+				result.W = ToSingle(data, 3);
+			}
+
 			return result;
 		}
 	}
@@ -0,0 +1,265 @@
+// Copyright (C) XFX Team
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without 
+// modification, are permitted provided that the following conditions are met:
+// 
+//     * Redistributions of source code must retain the above copyright 
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright 
+//       notice, this list of conditions and the following disclaimer in the 
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the copyright holder nor the names of any 
+//       contributors may be used to endorse or promote products derived from 
+//       this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE 
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF 
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS 
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE 
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include <Graphics/DepthStencilState.h>
+#include <System/Type.h>
+
+#include <sassert.h>
+
+namespace XFX
+{
+	namespace Graphics
+	{
+		const String isBoundErrorString = "Cannot change a DepthStencilState while it is bound to a GraphicsDevice.";
+		const Type DepthStencilStateTypeInfo("DepthStencilState", "XFX::Graphics::DepthStencilState", TypeCode::Object);
+
+		const DepthStencilState DepthStencilState::Default(true, true);
+		const DepthStencilState DepthStencilState::DepthRead(true, false);
+		const DepthStencilState DepthStencilState::None(false, false);
+
+		DepthStencilState::DepthStencilState()
+			: counterClockwiseStencilDepthBufferFail(StencilOperation::Keep), counterClockwiseStencilFail(StencilOperation::Keep), counterClockwiseStencilFunction(CompareFunction::Always),
+			depthBufferEnable(true), depthBufferFunction(CompareFunction::LessEqual), depthBufferWriteEnable(true), isBound(false), referenceStencil(0),
+			stencilDepthBufferFail(StencilOperation::Keep), stencilEnable(false), stencilFail(StencilOperation::Keep), stencilFunction(CompareFunction::Always),
+			stencilMask(-1), stencilPass(StencilOperation::Keep), stencilWriteMask(-1)
+		{
+		}
+
+		DepthStencilState::DepthStencilState(const bool depthBufferEnable, const bool depthBufferWriteEnable)
+			: counterClockwiseStencilDepthBufferFail(StencilOperation::Keep), counterClockwiseStencilFail(StencilOperation::Keep), counterClockwiseStencilFunction(CompareFunction::Always),
+			depthBufferEnable(depthBufferEnable), depthBufferFunction(CompareFunction::LessEqual), depthBufferWriteEnable(depthBufferWriteEnable), isBound(false), referenceStencil(0),
+			stencilDepthBufferFail(StencilOperation::Keep), stencilEnable(false), stencilFail(StencilOperation::Keep), stencilFunction(CompareFunction::Always),
+			stencilMask(-1), stencilPass(StencilOperation::Keep), stencilWriteMask(-1)
+		{
+		}
+
+		DepthStencilState::~DepthStencilState()
+		{
+			Dispose(false);
+		}
+
+		StencilOperation_t DepthStencilState::getCounterClockwiseStencilDepthBufferFail() const
+		{
+			return counterClockwiseStencilDepthBufferFail;
+		}
+
+		void DepthStencilState::setCounterClockwiseStencilDepthBufferFail(StencilOperation_t value)
+		{
+			sassert(!isBound, isBoundErrorString);
+
+			counterClockwiseStencilDepthBufferFail = value;
+		}
+
+		StencilOperation_t DepthStencilState::getCounterClockwiseStencilFail() const
+		{
+			return counterClockwiseStencilFail;
+		}
+
+		void DepthStencilState::setCounterClockwiseStencilFail(StencilOperation_t value)
+		{
+			sassert(!isBound, isBoundErrorString);
+
+			counterClockwiseStencilFail = value;
+		}
+
+		CompareFunction_t DepthStencilState::getCounterClockwiseStencilFunction() const
+		{
+			return counterClockwiseStencilFunction;
+		}
+
+		void DepthStencilState::setCounterClockwiseStencilFunction(CompareFunction_t value)
+		{
+			sassert(!isBound, isBoundErrorString);
+
+			counterClockwiseStencilFunction = value;
+		}
+
+		bool DepthStencilState::getDepthBufferEnable() const
+		{
+			return depthBufferEnable;
+		}
+
+		void DepthStencilState::setDepthBufferEnable(bool value)
+		{
+			sassert(!isBound, isBoundErrorString);
+
+			depthBufferEnable = value;
+		}
+
+		CompareFunction_t DepthStencilState::getDepthBufferFunction() const
+		{
+			return depthBufferFunction;
+		}
+
+		void DepthStencilState::setDepthBufferFunction(CompareFunction_t value)
+		{
+			sassert(!isBound, isBoundErrorString);
+
+			depthBufferFunction = value;
+		}
+
+		bool DepthStencilState::getDepthBufferWriteEnable() const
+		{
+			return depthBufferWriteEnable;
+		}
+
+		void DepthStencilState::setDepthBufferWriteEnable(bool value)
+		{
+			sassert(!isBound, isBoundErrorString);
+
+			depthBufferWriteEnable = value;
+		}
+
+		int DepthStencilState::getReferenceStencil() const
+		{
+			return referenceStencil;
+		}
+
+		void DepthStencilState::setReferenceStencil(int value)
+		{
+			sassert(!isBound, isBoundErrorString);
+
+			referenceStencil = value;
+		}
+
+		StencilOperation_t DepthStencilState::getStencilDepthBufferFail() const
+		{
+			return stencilDepthBufferFail;
+		}
+
+		void DepthStencilState::setStencilDepthBufferFail(StencilOperation_t value)
+		{
+			sassert(!isBound, isBoundErrorString);
+
+			stencilDepthBufferFail = value;
+		}
+
+		bool DepthStencilState::getStencilEnable() const
+		{
+			return stencilEnable;
+		}
+
+		void DepthStencilState::setStencilEnable(bool value)
+		{
+			sassert(!isBound, isBoundErrorString);
+
+			stencilEnable = value;
+		}
+
+		StencilOperation_t DepthStencilState::getStencilFail() const
+		{
+			return stencilFail;
+		}
+
+		void DepthStencilState::setStencilFail(StencilOperation_t value)
+		{
+			sassert(!isBound, isBoundErrorString);
+
+			stencilFail = value;
+		}
+
+		CompareFunction_t DepthStencilState::getStencilFunction() const
+		{
+			return stencilFunction;
+		}
+
+		void DepthStencilState::setStencilFunction(CompareFunction_t value)
+		{
+			sassert(!isBound, isBoundErrorString);
+
+			stencilFunction = value;
+		}
+
+		int DepthStencilState::getStencilMask() const
+		{
+			return stencilMask;
+		}
+
+		void DepthStencilState::setStencilMask(int value)
+		{
+			sassert(!isBound, isBoundErrorString);
+
+			stencilMask = value;
+		}
+
+		StencilOperation_t DepthStencilState::getStencilPass() const
+		{
+			return stencilPass;
+		}
+
+		void DepthStencilState::setStencilPass(StencilOperation_t value)
+		{
+			sassert(!isBound, isBoundErrorString);
+
+			stencilPass = value;
+		}
+
+		int DepthStencilState::getStencilWriteMask() const
+		{
+			return stencilWriteMask;
+		}
+
+		void DepthStencilState::setStencilWriteMask(int value)
+		{
+			sassert(!isBound, isBoundErrorString);
+
+			stencilWriteMask = value;
+		}
+
+		void DepthStencilState::Dispose(bool disposing)
+		{
+		}
+
+		const Type& DepthStencilState::GetType()
+		{
+			return DepthStencilStateTypeInfo;
+		}
+
+		bool DepthStencilState::operator==(const DepthStencilState& right) const
+		{
+			return ((counterClockwiseStencilDepthBufferFail == right.counterClockwiseStencilDepthBufferFail) &&
+				(counterClockwiseStencilFail == right.counterClockwiseStencilFail) &&
+				(counterClockwiseStencilFunction == right.counterClockwiseStencilFunction) &&
+				(depthBufferEnable == right.depthBufferEnable) &&
+				(depthBufferFunction == right.depthBufferFunction) &&
+				(depthBufferWriteEnable == right.depthBufferWriteEnable) &&
+				(referenceStencil == right.referenceStencil) &&
+				(stencilDepthBufferFail == right.stencilDepthBufferFail) &&
+				(stencilEnable == right.stencilEnable) &&
+				(stencilFail == right.stencilFail) &&
+				(stencilFunction == right.stencilFunction) &&
+				(stencilMask == right.stencilMask) &&
+				(stencilPass == right.stencilPass) &&
+				(stencilWriteMask == right.stencilWriteMask));
+		}
+
+		bool DepthStencilState::operator!=(const DepthStencilState& right) const
+		{
+			return !(*this == right);
+		}
+	}
+}
@@ -0,0 +1,493 @@
+// Copyright (C) XFX Team
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without 
+// modification, are permitted provided that the following conditions are met:
+// 
+//* Redistributions of source code must retain the above copyright 
+//notice, this list of conditions and the following disclaimer.
+//* Redistributions in binary form must reproduce the above copyright 
+//notice, this list of conditions and the following disclaimer in the 
+//documentation and/or other materials provided with the distribution.
+//* Neither the name of the copyright holder nor the names of any 
+//contributors may be used to endorse or promote products derived from 
+//this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE 
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF 
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS 
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE 
+// POSSIBILITY OF SUCH DAMAGE.
+
+
+#include "DxtUtil.h"
+
+#include <string.h>
+
+#if __SSE__
+#include <xmmintrin.h>
+#endif
+
+namespace XFX
+{
+	namespace Graphics
+	{
+		// 5- and 6-bit channels are widened to 8 bits by replicating their high bits, as the hardware does.
+		static const byte Expand5[32] =
+		{
+			0x00, 0x08, 0x10, 0x18, 0x21, 0x29, 0x31, 0x39, 0x42, 0x4A, 0x52, 0x5A, 0x63, 0x6B, 0x73, 0x7B,
+			0x84, 0x8C, 0x94, 0x9C, 0xA5, 0xAD, 0xB5, 0xBD, 0xC6, 0xCE, 0xD6, 0xDE, 0xE7, 0xEF, 0xF7, 0xFF
+		};
+
+		static const byte Expand6[64] =
+		{
+			0x00, 0x04, 0x08, 0x0C, 0x10, 0x14, 0x18, 0x1C, 0x20, 0x24, 0x28, 0x2C, 0x30, 0x34, 0x38, 0x3C,
+			0x41, 0x45, 0x49, 0x4D, 0x51, 0x55, 0x59, 0x5D, 0x61, 0x65, 0x69, 0x6D, 0x71, 0x75, 0x79, 0x7D,
+			0x82, 0x86, 0x8A, 0x8E, 0x92, 0x96, 0x9A, 0x9E, 0xA2, 0xA6, 0xAA, 0xAE, 0xB2, 0xB6, 0xBA, 0xBE,
+			0xC3, 0xC7, 0xCB, 0xCF, 0xD3, 0xD7, 0xDB, 0xDF, 0xE3, 0xE7, 0xEB, 0xEF, 0xF3, 0xF7, 0xFB, 0xFF
+		};
+
+		enum BlockFormat
+		{
+			Dxt1Block,
+			Dxt3Block,
+			Dxt5Block
+		};
+
+		/**
+		 * Packs a pixel so that it is stored as R, G, B, A bytes on the little-endian targets XFX runs on.
+		 */
+		static inline uint Pack(const int r, const int g, const int b, const int a)
+		{
+			return (uint)r | ((uint)g << 8) | ((uint)b << 16) | ((uint)a << 24);
+		}
+
+		static inline uint ReadUInt32(const byte data[])
+		{
+			return (uint)data[0] | ((uint)data[1] << 8) | ((uint)data[2] << 16) | ((uint)data[3] << 24);
+		}
+
+		static inline void WriteUInt16(byte data[], const int value)
+		{
+			data[0] = (byte)value;
+			data[1] = (byte)(value >> 8);
+		}
+
+		/**
+		 * Builds the four colours of a colour block.
+		 * DXT1 blocks whose first endpoint is not greater than the second have three colours and transparent black; DXT3 and DXT5 blocks always have four colours.
+		 */
+		static inline void ColorPalette(const byte block[], const bool dxt1, uint palette[4])
+		{
+			const int c0 = block[0] | (block[1] << 8);
+			const int c1 = block[2] | (block[3] << 8);
+			const int r0 = Expand5[c0 >> 11], g0 = Expand6[(c0 >> 5) & 0x3F], b0 = Expand5[c0 & 0x1F];
+			const int r1 = Expand5[c1 >> 11], g1 = Expand6[(c1 >> 5) & 0x3F], b1 = Expand5[c1 & 0x1F];
+
+			palette[0] = Pack(r0, g0, b0, 255);
+			palette[1] = Pack(r1, g1, b1, 255);
+
+			if (c0 > c1 || !dxt1)
+			{
+				palette[2] = Pack((2 * r0 + r1) / 3, (2 * g0 + g1) / 3, (2 * b0 + b1) / 3, 255);
+				palette[3] = Pack((r0 + 2 * r1) / 3, (g0 + 2 * g1) / 3, (b0 + 2 * b1) / 3, 255);
+			}
+			else
+			{
+				palette[2] = Pack((r0 + r1) / 2, (g0 + g1) / 2, (b0 + b1) / 2, 255);
+				palette[3] = 0;
+			}
+		}
+
+		/**
+		 * Builds the eight alphas of a DXT5 alpha block. Blocks whose first endpoint is not greater than the second have six alphas, 0 and 255.
+		 */
+		static inline void AlphaPalette(const int a0, const int a1, int alphas[8])
+		{
+			alphas[0] = a0;
+			alphas[1] = a1;
+
+			if (a0 > a1)
+			{
+				for (int i = 1; i < 7; i++)
+				{
+					alphas[i + 1] = ((7 - i) * a0 + i * a1) / 7;
+				}
+			}
+			else
+			{
+				for (int i = 1; i < 5; i++)
+				{
+					alphas[i + 1] = ((5 - i) * a0 + i * a1) / 5;
+				}
+				alphas[6] = 0;
+				alphas[7] = 255;
+			}
+		}
+
+		static inline void DecodeColors(const byte block[], const bool dxt1, uint pixels[16])
+		{
+			uint palette[4];
+			ColorPalette(block, dxt1, palette);
+
+			uint indices = ReadUInt32(block + 4);
+			for (int i = 0; i < 16; i++, indices >>= 2)
+			{
+				pixels[i] = palette[indices & 3];
+			}
+		}
+
+		static inline void DecodeExplicitAlpha(const byte block[], uint pixels[16])
+		{
+			for (int i = 0; i < 16; i += 2)
+			{
+				const int alpha = block[i >> 1];
+				pixels[i] = (pixels[i] & 0x00FFFFFF) | ((uint)((alpha & 0x0F) * 17) << 24);
+				pixels[i + 1] = (pixels[i + 1] & 0x00FFFFFF) | ((uint)((alpha >> 4) * 17) << 24);
+			}
+		}
+
+		static inline void DecodeInterpolatedAlpha(const byte block[], uint pixels[16])
+		{
+			int alphas[8];
+			AlphaPalette(block[0], block[1], alphas);
+
+			uint palette[8];
+			for (int i = 0; i < 8; i++)
+			{
+				palette[i] = (uint)alphas[i] << 24;
+			}
+
+			// 48 bits of 3-bit indices, read as two halves of eight pixels each
+			for (int half = 0; half < 2; half++)
+			{
+				const byte* data = block + 2 + half * 3;
+				uint indices = data[0] | (data[1] << 8) | (data[2] << 16);
+				uint* halfPixels = pixels + half * 8;
+
+				for (int i = 0; i < 8; i++, indices >>= 3)
+				{
+					halfPixels[i] = (halfPixels[i] & 0x00FFFFFF) | palette[indices & 7];
+				}
+			}
+		}
+
+		/**
+		 * Writes the rows of a decoded block that lie inside the image.
+		 */
+		static inline void StoreBlock(const uint pixels[16], byte output[], const int width, const int height, const int x, const int y)
+		{
+			const int rowPitch = width * 4;
+			const int rows = (height - y < 4) ? height - y : 4;
+			byte* row = output + y * rowPitch + x * 4;
+
+			if (width - x >= 4)
+			{
+				for (int j = 0; j < rows; j++, row += rowPitch)
+				{
+					memcpy(row, pixels + j * 4, 16);
+				}
+			}
+			else
+			{
+				const int rowSize = (width - x) * 4;
+				for (int j = 0; j < rows; j++, row += rowPitch)
+				{
+					memcpy(row, pixels + j * 4, rowSize);
+				}
+			}
+		}
+
+		template <int Format>
+		static void DecompressBlocks(const byte imageData[], const int width, const int height, byte output[], const int firstBlockRow, const int blockRowCount)
+		{
+			const int blockSize = (Format == Dxt1Block) ? 8 : 16;
+			const int blocksWide = DxtUtil::GetBlockCount(width);
+			const int blocksHigh = DxtUtil::GetBlockCount(height);
+			const int first = (firstBlockRow > 0) ? firstBlockRow : 0;
+			const int last = (firstBlockRow + blockRowCount < blocksHigh) ? firstBlockRow + blockRowCount : blocksHigh;
+
+			const byte* block = imageData + first * blocksWide * blockSize;
+			uint pixels[16];
+
+			for (int blockY = first; blockY < last; blockY++)
+			{
+				for (int blockX = 0; blockX < blocksWide; blockX++, block += blockSize)
+				{
+					switch (Format)
+					{
+					case Dxt1Block:
+						DecodeColors(block, true, pixels);
+						break;
+					case Dxt3Block:
+						DecodeColors(block + 8, false, pixels);
+						DecodeExplicitAlpha(block, pixels);
+						break;
+					case Dxt5Block:
+						DecodeColors(block + 8, false, pixels);
+						DecodeInterpolatedAlpha(block, pixels);
+						break;
+					}
+
+					StoreBlock(pixels, output, width, height, blockX * 4, blockY * 4);
+				}
+			}
+		}
+
+		/**
+		 * Gathers the 4x4 block at x, y. Pixels past the right or bottom edge repeat the last column or row, so they don't widen the block's endpoints.
+		 */
+		static inline void LoadBlock(const byte imageData[], const int width, const int height, const int x, const int y, uint pixels[16])
+		{
+			for (int j = 0; j < 4; j++)
+			{
+				const int sourceY = (y + j < height) ? y + j : height - 1;
+				const byte* row = imageData + sourceY * width * 4;
+
+				for (int i = 0; i < 4; i++)
+				{
+					const int sourceX = (x + i < width) ? x + i : width - 1;
+					pixels[j * 4 + i] = ReadUInt32(row + sourceX * 4);
+				}
+			}
+		}
+
+		/**
+		 * Finds the per-channel minimum and maximum of a block.
+		 */
+		static inline void GetMinMax(const uint pixels[16], uint& minColor, uint& maxColor)
+		{
+#if __SSE__
+			// pminub/pmaxub compare two pixels per MMX register
+			const __m64* source = reinterpret_cast<const __m64*>(pixels);
+			__m64 low = source[0];
+			__m64 high = source[0];
+
+			for (int i = 1; i < 8; i++)
+			{
+				low = _mm_min_pu8(low, source[i]);
+				high = _mm_max_pu8(high, source[i]);
+			}
+
+			low = _mm_min_pu8(low, _mm_srli_si64(low, 32));
+			high = _mm_max_pu8(high, _mm_srli_si64(high, 32));
+			minColor = (uint)_mm_cvtsi64_si32(low);
+			maxColor = (uint)_mm_cvtsi64_si32(high);
+			_mm_empty();
+#else
+			minColor = 0;
+			maxColor = 0;
+
+			for (int c = 0; c < 32; c += 8)
+			{
+				uint low = 0xFF, high = 0;
+				for (int i = 0; i < 16; i++)
+				{
+					const uint value = (pixels[i] >> c) & 0xFF;
+					low = (value < low) ? value : low;
+					high = (value > high) ? value : high;
+				}
+				minColor |= low << c;
+				maxColor |= high << c;
+			}
+#endif
+		}
+
+		/**
+		 * Writes a four colour block whose endpoints are the bounding box of the block's colours, inset by 1/16 of its size to reduce the error at the centre.
+		 */
+		static inline void EncodeColors(const uint pixels[16], const uint minColor, const uint maxColor, byte block[8])
+		{
+			int low[3], high[3];
+			for (int c = 0; c < 3; c++)
+			{
+				low[c] = (minColor >> (c * 8)) & 0xFF;
+				high[c] = (maxColor >> (c * 8)) & 0xFF;
+				const int inset = (high[c] - low[c]) >> 4;
+				low[c] += inset;
+				high[c] -= inset;
+			}
+
+			// every channel of high is at least that of low, so c0 >= c1
+			const int c0 = ((high[0] >> 3) << 11) | ((high[1] >> 2) << 5) | (high[2] >> 3);
+			const int c1 = ((low[0] >> 3) << 11) | ((low[1] >> 2) << 5) | (low[2] >> 3);
+			WriteUInt16(block, c0);
+			WriteUInt16(block + 2, c1);
+
+			// A DXT1 block with equal endpoints is in three colour mode, where index 3 is transparent; index 0 is the only colour anyway.
+			uint indices = 0;
+			if (c0 != c1)
+			{
+				uint palette[4];
+				ColorPalette(block, false, palette);
+
+				for (int i = 15; i >= 0; i--)
+				{
+					const int r = pixels[i] & 0xFF, g = (pixels[i] >> 8) & 0xFF, b = (pixels[i] >> 16) & 0xFF;
+					int best = 0;
+					int bestDistance = 0x7FFFFFFF;
+
+					for (int k = 0; k < 4; k++)
+					{
+						const int dr = r - (int)(palette[k] & 0xFF);
+						const int dg = g - (int)((palette[k] >> 8) & 0xFF);
+						const int db = b - (int)((palette[k] >> 16) & 0xFF);
+						const int distance = dr * dr + dg * dg + db * db;
+						if (distance < bestDistance)
+						{
+							bestDistance = distance;
+							best = k;
+						}
+					}
+
+					indices = (indices << 2) | best;
+				}
+			}
+
+			WriteUInt16(block + 4, indices);
+			WriteUInt16(block + 6, indices >> 16);
+		}
+
+		/**
+		 * Writes an eight alpha block spanning the block's alphas. The endpoints are not inset so fully transparent and fully opaque pixels stay exact.
+		 */
+		static inline void EncodeAlpha(const uint pixels[16], const uint minColor, const uint maxColor, byte block[8])
+		{
+			const int a0 = maxColor >> 24;
+			const int a1 = minColor >> 24;
+			block[0] = (byte)a0;
+			block[1] = (byte)a1;
+
+			int alphas[8];
+			AlphaPalette(a0, a1, alphas);
+
+			for (int half = 0; half < 2; half++)
+			{
+				uint indices = 0;
+				if (a0 != a1)
+				{
+					for (int i = 7; i >= 0; i--)
+					{
+						const int alpha = pixels[half * 8 + i] >> 24;
+						int best = 0;
+						int bestDistance = 256;
+
+						for (int k = 0; k < 8; k++)
+						{
+							const int distance = (alpha > alphas[k]) ? alpha - alphas[k] : alphas[k] - alpha;
+							if (distance < bestDistance)
+							{
+								bestDistance = distance;
+								best = k;
+							}
+						}
+
+						indices = (indices << 3) | best;
+					}
+				}
+
+				byte* data = block + 2 + half * 3;
+				data[0] = (byte)indices;
+				data[1] = (byte)(indices >> 8);
+				data[2] = (byte)(indices >> 16);
+			}
+		}
+
+		int DxtUtil::GetBlockCount(const int length)
+		{
+			return (length + 3) >> 2;
+		}
+
+		int DxtUtil::GetCompressedSize(const int width, const int height, const int blockSize)
+		{
+			return GetBlockCount(width) * GetBlockCount(height) * blockSize;
+		}
+
+		byte* DxtUtil::DecompressDxt1(const byte imageData[], const int width, const int height)
+		{
+			byte* result = new byte[width * height * 4];
+			DecompressBlocks<Dxt1Block>(imageData, width, height, result, 0, GetBlockCount(height));
+			return result;
+		}
+
+		byte* DxtUtil::DecompressDxt3(const byte imageData[], const int width, const int height)
+		{
+			byte* result = new byte[width * height * 4];
+			DecompressBlocks<Dxt3Block>(imageData, width, height, result, 0, GetBlockCount(height));
+			return result;
+		}
+
+		byte* DxtUtil::DecompressDxt5(const byte imageData[], const int width, const int height)
+		{
+			byte* result = new byte[width * height * 4];
+			DecompressBlocks<Dxt5Block>(imageData, width, height, result, 0, GetBlockCount(height));
+			return result;
+		}
+
+		void DxtUtil::DecompressDxt1(const byte imageData[], const int width, const int height, byte output[], const int firstBlockRow, const int blockRowCount)
+		{
+			DecompressBlocks<Dxt1Block>(imageData, width, height, output, firstBlockRow, blockRowCount);
+		}
+
+		void DxtUtil::DecompressDxt3(const byte imageData[], const int width, const int height, byte output[], const int firstBlockRow, const int blockRowCount)
+		{
+			DecompressBlocks<Dxt3Block>(imageData, width, height, output, firstBlockRow, blockRowCount);
+		}
+
+		void DxtUtil::DecompressDxt5(const byte imageData[], const int width, const int height, byte output[], const int firstBlockRow, const int blockRowCount)
+		{
+			DecompressBlocks<Dxt5Block>(imageData, width, height, output, firstBlockRow, blockRowCount);
+		}
+
+		byte* DxtUtil::CompressDxt1(const byte imageData[], const int width, const int height)
+		{
+			const int blocksWide = GetBlockCount(width);
+			const int blocksHigh = GetBlockCount(height);
+			byte* result = new byte[GetCompressedSize(width, height, 8)];
+			byte* block = result;
+			uint pixels[16];
+			uint minColor, maxColor;
+
+			for (int blockY = 0; blockY < blocksHigh; blockY++)
+			{
+				for (int blockX = 0; blockX < blocksWide; blockX++, block += 8)
+				{
+					LoadBlock(imageData, width, height, blockX * 4, blockY * 4, pixels);
+					GetMinMax(pixels, minColor, maxColor);
+					EncodeColors(pixels, minColor, maxColor, block);
+				}
+			}
+
+			return result;
+		}
+
+		byte* DxtUtil::CompressDxt5(const byte imageData[], const int width, const int height)
+		{
+			const int blocksWide = GetBlockCount(width);
+			const int blocksHigh = GetBlockCount(height);
+			byte* result = new byte[GetCompressedSize(width, height, 16)];
+			byte* block = result;
+			uint pixels[16];
+			uint minColor, maxColor;
+
+			for (int blockY = 0; blockY < blocksHigh; blockY++)
+			{
+				for (int blockX = 0; blockX < blocksWide; blockX++, block += 16)
+				{
+					LoadBlock(imageData, width, height, blockX * 4, blockY * 4, pixels);
+					GetMinMax(pixels, minColor, maxColor);
+					EncodeAlpha(pixels, minColor, maxColor, block);
+					EncodeColors(pixels, minColor, maxColor, block + 8);
+				}
+			}
+
+			return result;
+		}
+	}
+}
@@ -0,0 +1,77 @@
+/*****************************************************************************
+ *	DxtUtil.h																 *
+ *																			 *
+ *	XFX::Graphics::DxtUtil class definition file							 *
+ *	Copyright (c) XFX Team. All Rights Reserved 							 *
+ *****************************************************************************/
+#ifndef _XFX_GRAPHICS_DXTUTIL_
+#define _XFX_GRAPHICS_DXTUTIL_
+
+#include <System/Types.h>
+
+using namespace System;
+
+namespace XFX
+{
+	namespace Graphics
+	{
+		/**
+		 * Converts between S3TC (DXT1, DXT3 and DXT5) compressed data and 32-bit RGBA pixels, stored as R, G, B, A bytes like SurfaceFormat::Color.
+		 *
+		 * The decoder builds the colour and alpha palettes of each 4x4 block once and then looks every pixel up by its index, writing whole rows of a block at a time.
+		 * Images whose width or height is not a multiple of 4 are padded to whole blocks, as in the compressed formats; the padding is never written to or read from.
+		 *
+		 * The overloads that take a range of block rows decode into a caller supplied image and only write the rows of that range,
+		 * so an image can be split between several threads that decode disjoint ranges into the same buffer.
+		 */
+		// This class is not meant to be used by the end user.
+		// Only XFX source files should reference this class.
+		class DxtUtil
+		{
+		private:
+			DxtUtil(); // Private constructor to prevent instantiation.
+
+		public:
+			/**
+			 * Decodes a whole DXT1, DXT3 or DXT5 image.
+			 *
+			 * @return
+			 * width * height * 4 bytes of RGBA data, allocated with new[].
+			 */
+			static byte* DecompressDxt1(const byte imageData[], const int width, const int height);
+			static byte* DecompressDxt3(const byte imageData[], const int width, const int height);
+			static byte* DecompressDxt5(const byte imageData[], const int width, const int height);
+
+			/**
+			 * Decodes blockRowCount rows of 4x4 blocks, starting at firstBlockRow, into an image of width * height * 4 bytes.
+			 * Rows of the range that lie outside the image are ignored.
+			 */
+			static void DecompressDxt1(const byte imageData[], const int width, const int height, byte output[], const int firstBlockRow, const int blockRowCount);
+			static void DecompressDxt3(const byte imageData[], const int width, const int height, byte output[], const int firstBlockRow, const int blockRowCount);
+			static void DecompressDxt5(const byte imageData[], const int width, const int height, byte output[], const int firstBlockRow, const int blockRowCount);
+
+			/**
+			 * Encodes RGBA pixels as DXT1 (opaque) or DXT5.
+			 *
+			 * The endpoints of each block are taken from the bounding box of its colours (and alphas), which is fast enough for textures generated at runtime
+			 * but lower quality than an offline compressor.
+			 *
+			 * @return
+			 * GetCompressedSize bytes of data, allocated with new[].
+			 */
+			static byte* CompressDxt1(const byte imageData[], const int width, const int height);
+			static byte* CompressDxt5(const byte imageData[], const int width, const int height);
+
+			/**
+			 * Returns the number of 4x4 blocks in a row (or column) of an image that is length pixels wide (or high).
+			 */
+			static int GetBlockCount(const int length);
+			/**
+			 * Returns the size in bytes of a DXT1 (blockSize 8) or DXT3/DXT5 (blockSize 16) image.
+			 */
+			static int GetCompressedSize(const int width, const int height, const int blockSize);
+		};
+	}
+}
+
+#endif //_XFX_GRAPHICS_DXTUTIL_
@@ -26,35 +26,212 @@
 // POSSIBILITY OF SUCH DAMAGE.
 
 #include <Audio/DynamicSoundEffectInstance.h>
+#include <Audio/SoundEffect.h>
+#include "AudioBufferQueue.h"
+
+#include <System/FrameworkResources.h>
+#include <System/String.h>
+#include <System/Threading/Interlocked.h>
+
+#include <sassert.h>
+#include <string.h>
+
+using namespace System::Threading;
 
 namespace XFX
 {
 	namespace Audio
 	{
+		DynamicSoundEffectInstance* DynamicSoundEffectInstance::first = null;
+		DynamicSoundEffectInstance* DynamicSoundEffectInstance::dispatchNext = null;
+
 		DynamicSoundEffectInstance::DynamicSoundEffectInstance(int sampleRate, AudioChannels_t channels)
-			: channels(channels), sampleRate(sampleRate)
+			: next(first), previous(null), bufferQueue(new AudioBufferQueue()), bufferNeededPending(0), bufferNeededThreshold(2), underrunCount(0)
+		{
+			sassert(sampleRate >= 8000 && sampleRate <= 48000, "sampleRate; The sample rate must be between 8000 and 48000 Hz.");
+
+			sassert(channels == AudioChannels::Mono || channels == AudioChannels::Stereo, "channels; Only mono and stereo audio is supported.");
+
+			_channels = channels;
+			_sampleRate = sampleRate;
+
+			if (first != null)
+			{
+				first->previous = this;
+			}
+
+			first = this;
+		}
+
+		DynamicSoundEffectInstance::~DynamicSoundEffectInstance()
+		{
+			Dispose(true);
+		}
+
+		int DynamicSoundEffectInstance::getBufferNeededThreshold() const
+		{
+			return bufferNeededThreshold;
+		}
+
+		void DynamicSoundEffectInstance::setBufferNeededThreshold(int value)
+		{
+			sassert(value >= 0 && value < AudioBufferQueue::Capacity, String::Format("value; %s", FrameworkResources::ArgumentOutOfRange_Index));
+
+			bufferNeededThreshold = (value < 0) ? 0 : ((value >= AudioBufferQueue::Capacity) ? AudioBufferQueue::Capacity - 1 : value);
+		}
+
+		int DynamicSoundEffectInstance::getPendingBufferCount() const
 		{
-			// TODO: implement remainder
+			return (bufferQueue != null) ? bufferQueue->Count() : 0;
+		}
+
+		int DynamicSoundEffectInstance::getUnderrunCount() const
+		{
+			return underrunCount;
+		}
+
+		void DynamicSoundEffectInstance::DispatchBufferNeeded()
+		{
+			for (DynamicSoundEffectInstance* instance = first; instance != null; instance = dispatchNext)
+			{
+				// A handler may dispose of the next instance, which then moves dispatchNext past itself.
+				dispatchNext = instance->next;
+
+				if (Interlocked::Exchange(&instance->bufferNeededPending, 0) != 0)
+				{
+					instance->BufferNeeded(instance, EventArgs::Empty);
+				}
+			}
+
+			dispatchNext = null;
 		}
 
 		void DynamicSoundEffectInstance::Dispose(bool disposing)
 		{
-			// TODO: implement remainder
+			Unregister();
+
+			// Stops the voice first, so the mixer is no longer reading the queue.
+			SoundEffectInstance::Dispose(disposing);
+
+			if (disposing)
+			{
+				delete bufferQueue;
+				bufferQueue = null;
+			}
+		}
+
+		TimeSpan DynamicSoundEffectInstance::GetSampleDuration(int sizeInBytes)
+		{
+			return SoundEffect::GetSampleDuration(sizeInBytes, _sampleRate, _channels);
+		}
+
+		int DynamicSoundEffectInstance::GetSampleSizeInBytes(TimeSpan duration)
+		{
+			return SoundEffect::GetSampleSizeInBytes(duration, _sampleRate, _channels);
 		}
 
 		void DynamicSoundEffectInstance::Play()
 		{
-			if (bufferQueue.Count() == 0)
+			SoundEffectInstance::Play();
+
+			if (bufferQueue != null && bufferQueue->Count() <= bufferNeededThreshold)
 			{
 				BufferNeeded(this, EventArgs::Empty);
 			}
+		}
 
-			// TODO: implement remainder
+		int DynamicSoundEffectInstance::ReadSamples(byte buffer[], int offset, int count)
+		{
+			sassert(buffer != null, FrameworkResources::ArgumentNull_Buffer);
+
+			sassert(offset >= 0, String::Format("offset; %s", FrameworkResources::ArgumentOutOfRange_NeedNonNegNum));
+
+			sassert(count >= 0, String::Format("count; %s", FrameworkResources::ArgumentOutOfRange_NeedNonNegNum));
+
+			if (buffer == null || offset < 0 || count <= 0)
+			{
+				return 0;
+			}
+
+			if (_state != SoundState::Playing || bufferQueue == null)
+			{
+				memset(buffer + offset, 0, count);
+				return 0;
+			}
+
+			int buffersReleased;
+			const int read = bufferQueue->Read(buffer + offset, count, buffersReleased);
+
+			if (read < count)
+			{
+				// Only this thread writes the count, so it doesn't need to be incremented atomically.
+				memset(buffer + offset + read, 0, count - read);
+				underrunCount++;
+			}
+
+			// Running dry always asks for more, even if no buffer was finished, so that a producer that missed an event catches up.
+			// The event itself is raised on the game thread by FrameworkDispatcher::Update.
+			if (read < count || (buffersReleased > 0 && bufferQueue->Count() <= bufferNeededThreshold))
+			{
+				Interlocked::Exchange(&bufferNeededPending, 1);
+			}
+
+			return read;
+		}
+
+		int DynamicSoundEffectInstance::ReadFrames(short destination[], const int count)
+		{
+			// Underruns are filled with silence, so a dynamic sound never ends by itself.
+			ReadSamples((byte*)destination, 0, count * _channels * 2);
+
+			return count;
 		}
 
 		void DynamicSoundEffectInstance::SubmitBuffer(byte buffer[], int offset, int count)
 		{
-			// TODO: implement remainder
+			const int blockAlign = _channels * 2;
+
+			sassert(buffer != null, FrameworkResources::ArgumentNull_Buffer);
+
+			sassert(offset >= 0, String::Format("offset; %s", FrameworkResources::ArgumentOutOfRange_NeedNonNegNum));
+
+			sassert(count > 0, String::Format("count; %s", FrameworkResources::ArgumentOutOfRange_NeedPosNum));
+
+			sassert((offset % blockAlign) == 0 && (count % blockAlign) == 0, "Ensure that the buffer meets the block alignment requirements for the audio format.");
+
+			if (buffer == null || bufferQueue == null || offset < 0 || count <= 0 || (offset % blockAlign) != 0 || (count % blockAlign) != 0)
+			{
+				return;
+			}
+
+			const bool queued = bufferQueue->Enqueue(buffer + offset, count);
+
+			sassert(queued, "Too many buffers are pending; wait for BufferNeeded before submitting more.");
+		}
+
+		void DynamicSoundEffectInstance::Unregister()
+		{
+			if (dispatchNext == this)
+			{
+				dispatchNext = next;
+			}
+
+			if (previous != null)
+			{
+				previous->next = next;
+			}
+			else if (first == this)
+			{
+				first = next;
+			}
+
+			if (next != null)
+			{
+				next->previous = previous;
+			}
+
+			next = null;
+			previous = null;
 		}
 	}
 }
@@ -48,6 +48,11 @@ namespace XFX
 			// TODO: implement the remainder
 		}
 
+		void Effect::Dispose(bool disposing)
+		{
+			GraphicsResource::Dispose(disposing);
+		}
+
 		Effect* Effect::Clone() const
 		{
 			return new Effect(this);
@@ -57,5 +62,17 @@ namespace XFX
 		{
 			return EffectTypeInfo;
 		}
+
+		void Effect::OnApply()
+		{
+		}
+
+		void Effect::OnApplyWorld(const Matrix& world)
+		{
+		}
+
+		void Effect::SetMatrices(const Matrix& world, const Matrix& view, const Matrix& projection)
+		{
+		}
 	}
 }
@@ -43,16 +43,342 @@ extern "C" {
 }
 
 #include <sassert.h>
+#include <string.h>
 
 using namespace System;
 using namespace XFX;
 
+// Each render state is written with a single pb_push1: one method header and one value.
+#define RENDER_STATE_SIZE	(2 * sizeof(DWORD))
+
+// Formats of the vertex attribute arrays. UB_D3D reads four bytes in BGRA order, S1 normalizes shorts, S32K doesn't.
+#define VERTEX_ATTR_UB_D3D		0
+#define VERTEX_ATTR_S1			1
+#define VERTEX_ATTR_FLOAT		2
+#define VERTEX_ATTR_UB_OGL		4
+#define VERTEX_ATTR_S32K		5
+#define VERTEX_ATTR_DISABLED	VERTEX_ATTR_FLOAT
+#define VERTEX_ATTR(type, size, stride) ((type) | ((size) << 4) | ((stride) << 8))
+
+// Indices are sent in bursts of this many dwords, which keeps each push buffer block under 128 dwords.
+#define INDEX_DWORDS_PER_BURST	120
+
 namespace XFX
 {
 	namespace Graphics
 	{
 		const Type GraphicsDeviceTypeInfo("GraphicsDevice", "XFX:Graphics::GraphicsDevice", TypeCode::Object);
 
+		// The NV2A takes OpenGL enumerants for blend, compare and stencil state.
+		static DWORD BlendToNV(const Blend_t blend)
+		{
+			switch (blend)
+			{
+			case Blend::Zero:						return 0;
+			case Blend::One:						return 1;
+			case Blend::SourceColor:				return 0x300;
+			case Blend::InversourceColor:			return 0x301;
+			case Blend::SourceAlpha:				return 0x302;
+			case Blend::InverseSourceAlpha:			return 0x303;
+			case Blend::DestinationAlpha:			return 0x304;
+			case Blend::InverseDestinationAlpha:	return 0x305;
+			case Blend::DestinationColor:			return 0x306;
+			case Blend::InverseDestinationColor:	return 0x307;
+			case Blend::SourceAlphaSaturation:		return 0x308;
+			case Blend::BlendFactor:				return 0x8001;
+			case Blend::InverseBlendFactor:			return 0x8002;
+			default:								return 1;
+			}
+		}
+
+		static DWORD BlendFunctionToNV(const BlendFunction_t blendFunction)
+		{
+			switch (blendFunction)
+			{
+			case BlendFunction::Min:				return 0x8007;
+			case BlendFunction::Max:				return 0x8008;
+			case BlendFunction::Subtract:			return 0x800a;
+			case BlendFunction::ReverseSubtract:	return 0x800b;
+			default:								return 0x8006;
+			}
+		}
+
+		static DWORD CompareFunctionToNV(const CompareFunction_t compareFunction)
+		{
+			// Never (1) through Always (8) are in the same order as GL_NEVER (0x200) through GL_ALWAYS (0x207).
+			return 0x1ff + compareFunction;
+		}
+
+		static DWORD StencilOperationToNV(const StencilOperation_t stencilOperation)
+		{
+			switch (stencilOperation)
+			{
+			case StencilOperation::Zero:				return 0;
+			case StencilOperation::Replace:				return 0x1e01;
+			case StencilOperation::IncrementSaturation:	return 0x1e02;
+			case StencilOperation::DecrementSaturation:	return 0x1e03;
+			case StencilOperation::Invert:				return 0x150a;
+			case StencilOperation::Increment:			return 0x8507;
+			case StencilOperation::Decrement:			return 0x8508;
+			default:									return 0x1e00;
+			}
+		}
+
+		static DWORD FloatToDWORD(const float value)
+		{
+			DWORD result;
+			memcpy(&result, &value, sizeof(result));
+			return result;
+		}
+
+		static int GetIndexCount(const PrimitiveType_t primitiveType, const int primitiveCount)
+		{
+			switch (primitiveType)
+			{
+			case PrimitiveType::LineList:		return primitiveCount * 2;
+			case PrimitiveType::LineStrip:		return primitiveCount + 1;
+			case PrimitiveType::TriangleList:	return primitiveCount * 3;
+			case PrimitiveType::TriangleStrip:	return primitiveCount + 2;
+			default:							return primitiveCount;
+			}
+		}
+
+		// Vertex elements are read into the attributes the Xbox Direct3D assigns them: these are the v registers of a vertex program,
+		// and the arrays the fixed function pipeline reads. BlendIndices are read into v11, where SkinnedEffect expects them.
+		static int GetVertexAttribute(const VertexElementUsage_t usage, const int usageIndex)
+		{
+			switch (usage)
+			{
+			case VertexElementUsage::Position:			return (usageIndex == 0) ? 0 : -1;
+			case VertexElementUsage::BlendWeight:		return (usageIndex == 0) ? 1 : -1;
+			case VertexElementUsage::Normal:			return (usageIndex == 0) ? 2 : -1;
+			case VertexElementUsage::Color:				return (usageIndex < 2) ? 3 + usageIndex : -1;
+			case VertexElementUsage::Fog:				return (usageIndex == 0) ? 5 : -1;
+			case VertexElementUsage::PointSize:			return (usageIndex == 0) ? 6 : -1;
+			case VertexElementUsage::TextureCoordinate:	return (usageIndex < 4) ? 9 + usageIndex : -1;
+			case VertexElementUsage::BlendIndices:		return (usageIndex == 0) ? 11 : -1;
+			default:									return -1;
+			}
+		}
+
+		// Byte4 is read with UB_OGL, the only unsigned byte format in the same order as the vertex, so it arrives divided by 255.
+		// The NV2A can't read half precision floats.
+		static DWORD GetVertexAttributeFormat(const VertexElementFormat_t format, const int stride)
+		{
+			switch (format)
+			{
+			case VertexElementFormat::Byte4:			return VERTEX_ATTR(VERTEX_ATTR_UB_OGL, 4, stride);
+			case VertexElementFormat::Color:			return VERTEX_ATTR(VERTEX_ATTR_UB_D3D, 4, stride);
+			case VertexElementFormat::NormalizedShort2:	return VERTEX_ATTR(VERTEX_ATTR_S1, 2, stride);
+			case VertexElementFormat::NormalizedShort4:	return VERTEX_ATTR(VERTEX_ATTR_S1, 4, stride);
+			case VertexElementFormat::Short2:			return VERTEX_ATTR(VERTEX_ATTR_S32K, 2, stride);
+			case VertexElementFormat::Short4:			return VERTEX_ATTR(VERTEX_ATTR_S32K, 4, stride);
+			case VertexElementFormat::Single:			return VERTEX_ATTR(VERTEX_ATTR_FLOAT, 1, stride);
+			case VertexElementFormat::Vector2:			return VERTEX_ATTR(VERTEX_ATTR_FLOAT, 2, stride);
+			case VertexElementFormat::Vector3:			return VERTEX_ATTR(VERTEX_ATTR_FLOAT, 3, stride);
+			case VertexElementFormat::Vector4:			return VERTEX_ATTR(VERTEX_ATTR_FLOAT, 4, stride);
+			default:									return VERTEX_ATTR_DISABLED;
+			}
+		}
+
+		void GraphicsDevice::ApplySamplerState(const int index, const SamplerState * const samplerState)
+		{
+			sassert(index >= 0 && index < 4, "index; Value must be between 0 and 3.");
+			sassert(samplerState != null, String::Format("samplerState; %s", FrameworkResources::ArgumentNull_Generic));
+
+			// minification: 3 point/mip point, 4 linear/mip point, 5 point/mip linear, 6 linear/mip linear; magnification: 1 point, 2 linear
+			DWORD minFilter, magFilter;
+
+			switch (samplerState->getFilter())
+			{
+			case TextureFilter::Point:						minFilter = 3; magFilter = 1; break;
+			case TextureFilter::LinearMipPoint:				minFilter = 4; magFilter = 2; break;
+			case TextureFilter::PointMipLinear:				minFilter = 5; magFilter = 1; break;
+			case TextureFilter::MinLinearMagPointMipLinear:	minFilter = 6; magFilter = 1; break;
+			case TextureFilter::MinLinearMagPointMipPoint:	minFilter = 4; magFilter = 1; break;
+			case TextureFilter::MinPointMagLinearMipLinear:	minFilter = 5; magFilter = 2; break;
+			case TextureFilter::MinPointMagLinearMipPoint:	minFilter = 3; magFilter = 2; break;
+			default:										minFilter = 6; magFilter = 2; break;
+			}
+
+			// the level of detail bias is a signed 5.8 fixed point value; the 0x2000 bit selects the quincunx kernel
+			DWORD filter = (magFilter << 24) | (minFilter << 16) | 0x2000 | ((samplerState->getMipMapLevelOfDetailBias() << 8) & 0x1fff);
+			// TextureAddressMode Wrap (1), Mirror (2) and Clamp (3) match the hardware values
+			DWORD wrap = samplerState->getAddressU() | (samplerState->getAddressV() << 8) | (samplerState->getAddressW() << 16);
+
+			DWORD* p = pb_begin();
+
+			if (UpdateRenderState(NV20_TCL_PRIMITIVE_3D_TX_FILTER(index), filter))
+			{
+				pb_push1(p, NV20_TCL_PRIMITIVE_3D_TX_FILTER(index), filter); p += 2;
+			}
+
+			if (UpdateRenderState(NV20_TCL_PRIMITIVE_3D_TX_WRAP(index), wrap))
+			{
+				pb_push1(p, NV20_TCL_PRIMITIVE_3D_TX_WRAP(index), wrap); p += 2;
+			}
+
+			pb_end(p);
+		}
+
+		const BlendState* GraphicsDevice::getBlendState() const
+		{
+			return blendState;
+		}
+
+		void GraphicsDevice::setBlendState(const BlendState * const value)
+		{
+			sassert(value != null, String::Format("value; %s", FrameworkResources::ArgumentNull_Generic));
+
+			blendState = value;
+
+			Blend_t colorSource = value->getColorSourceBlend();
+			Blend_t colorDestination = value->getColorDestinationBlend();
+			Blend_t alphaSource = value->getAlphaSourceBlend();
+			Blend_t alphaDestination = value->getAlphaDestinationBlend();
+			BlendFunction_t colorFunction = value->getColorBlendFunction();
+			ColorWriteChannels_t channels = value->getColorWriteChannels();
+
+			// One * source + Zero * destination is a plain overwrite, so blending can be switched off altogether
+			bool enable = !(colorSource == Blend::One && colorDestination == Blend::Zero && colorFunction == BlendFunction::Add &&
+							alphaSource == Blend::One && alphaDestination == Blend::Zero && value->getAlphaBlendFunction() == BlendFunction::Add);
+
+			DWORD* p = pb_begin();
+
+			if (UpdateRenderState(NV20_TCL_PRIMITIVE_3D_BLEND_FUNC_ENABLE, enable))
+			{
+				pb_push1(p, NV20_TCL_PRIMITIVE_3D_BLEND_FUNC_ENABLE, enable); p += 2;
+			}
+
+			if (enable)
+			{
+				DWORD source = (BlendToNV(alphaSource) << 16) | BlendToNV(colorSource);
+				DWORD destination = (BlendToNV(alphaDestination) << 16) | BlendToNV(colorDestination);
+				DWORD equation = BlendFunctionToNV(colorFunction);
+				DWORD blendColor = value->getBlendFactor().PackedValue();
+
+				if (UpdateRenderState(NV20_TCL_PRIMITIVE_3D_BLEND_FUNC_SRC, source))
+				{
+					pb_push1(p, NV20_TCL_PRIMITIVE_3D_BLEND_FUNC_SRC, source); p += 2;
+				}
+
+				if (UpdateRenderState(NV20_TCL_PRIMITIVE_3D_BLEND_FUNC_DST, destination))
+				{
+					pb_push1(p, NV20_TCL_PRIMITIVE_3D_BLEND_FUNC_DST, destination); p += 2;
+				}
+
+				if (UpdateRenderState(NV20_TCL_PRIMITIVE_3D_BLEND_EQUATION, equation))
+				{
+					pb_push1(p, NV20_TCL_PRIMITIVE_3D_BLEND_EQUATION, equation); p += 2;
+				}
+
+				if (UpdateRenderState(NV20_TCL_PRIMITIVE_3D_BLEND_COLOR, blendColor))
+				{
+					pb_push1(p, NV20_TCL_PRIMITIVE_3D_BLEND_COLOR, blendColor); p += 2;
+				}
+			}
+
+			// one byte per channel, laid out as ARGB
+			DWORD colorMask = ((channels & ColorWriteChannels::Alpha) ? 0x01000000 : 0) |
+							  ((channels & ColorWriteChannels::Red) ? 0x00010000 : 0) |
+							  ((channels & ColorWriteChannels::Green) ? 0x00000100 : 0) |
+							  ((channels & ColorWriteChannels::Blue) ? 0x00000001 : 0);
+
+			if (UpdateRenderState(NV20_TCL_PRIMITIVE_3D_COLOR_MASK, colorMask))
+			{
+				pb_push1(p, NV20_TCL_PRIMITIVE_3D_COLOR_MASK, colorMask); p += 2;
+			}
+
+			pb_end(p);
+		}
+
+		const DepthStencilState* GraphicsDevice::getDepthStencilState() const
+		{
+			return depthStencilState;
+		}
+
+		void GraphicsDevice::setDepthStencilState(const DepthStencilState * const value)
+		{
+			sassert(value != null, String::Format("value; %s", FrameworkResources::ArgumentNull_Generic));
+
+			depthStencilState = value;
+
+			DWORD depthEnable = value->getDepthBufferEnable();
+			DWORD stencilEnable = value->getStencilEnable();
+
+			DWORD* p = pb_begin();
+
+			if (UpdateRenderState(NV20_TCL_PRIMITIVE_3D_DEPTH_TEST_ENABLE, depthEnable))
+			{
+				pb_push1(p, NV20_TCL_PRIMITIVE_3D_DEPTH_TEST_ENABLE, depthEnable); p += 2;
+			}
+
+			if (depthEnable)
+			{
+				DWORD depthWrite = value->getDepthBufferWriteEnable();
+				DWORD depthFunction = CompareFunctionToNV(value->getDepthBufferFunction());
+
+				if (UpdateRenderState(NV20_TCL_PRIMITIVE_3D_DEPTH_WRITE_ENABLE, depthWrite))
+				{
+					pb_push1(p, NV20_TCL_PRIMITIVE_3D_DEPTH_WRITE_ENABLE, depthWrite); p += 2;
+				}
+
+				if (UpdateRenderState(NV20_TCL_PRIMITIVE_3D_DEPTH_FUNC, depthFunction))
+				{
+					pb_push1(p, NV20_TCL_PRIMITIVE_3D_DEPTH_FUNC, depthFunction); p += 2;
+				}
+			}
+
+			if (UpdateRenderState(NV20_TCL_PRIMITIVE_3D_STENCIL_TEST_ENABLE, stencilEnable))
+			{
+				pb_push1(p, NV20_TCL_PRIMITIVE_3D_STENCIL_TEST_ENABLE, stencilEnable); p += 2;
+			}
+
+			if (stencilEnable)
+			{
+				const DWORD methods[] =
+				{
+					NV20_TCL_PRIMITIVE_3D_STENCIL_MASK,
+					NV20_TCL_PRIMITIVE_3D_STENCIL_FUNC_FUNC,
+					NV20_TCL_PRIMITIVE_3D_STENCIL_FUNC_REF,
+					NV20_TCL_PRIMITIVE_3D_STENCIL_FUNC_MASK,
+					NV20_TCL_PRIMITIVE_3D_STENCIL_OP_FAIL,
+					NV20_TCL_PRIMITIVE_3D_STENCIL_OP_ZFAIL,
+					NV20_TCL_PRIMITIVE_3D_STENCIL_OP_ZPASS
+				};
+				const DWORD values[] =
+				{
+					(DWORD)value->getStencilWriteMask() & 0xff,
+					CompareFunctionToNV(value->getStencilFunction()),
+					(DWORD)value->getReferenceStencil() & 0xff,
+					(DWORD)value->getStencilMask() & 0xff,
+					StencilOperationToNV(value->getStencilFail()),
+					StencilOperationToNV(value->getStencilDepthBufferFail()),
+					StencilOperationToNV(value->getStencilPass())
+				};
+
+				for (int i = 0; i < 7; i++)
+				{
+					if (UpdateRenderState(methods[i], values[i]))
+					{
+						pb_push1(p, methods[i], values[i]); p += 2;
+					}
+				}
+			}
+
+			pb_end(p);
+		}
+
+		IndexBuffer* GraphicsDevice::getIndices() const
+		{
+			return _indices;
+		}
+
+		void GraphicsDevice::setIndices(IndexBuffer * const value)
+		{
+			_indices = value;
+		}
+
 		PresentationParameters* GraphicsDevice::getPresentationParameters() const
 		{
 			return p_cachedParameters;
@@ -82,6 +408,88 @@ namespace XFX
 			pb_end(p);
 
 			pb_set_viewport(viewport.X, viewport.Y, viewport.Width, viewport.Height, viewport.MinDepth, viewport.MaxDepth);
+
+			// pbKit programs its own defaults during initialization, so nothing we shadowed can be trusted anymore
+			InvalidateRenderState();
+		}
+
+		const RasterizerState* GraphicsDevice::getRasterizerState() const
+		{
+			return rasterizerState;
+		}
+
+		void GraphicsDevice::setRasterizerState(const RasterizerState * const value)
+		{
+			sassert(value != null, String::Format("value; %s", FrameworkResources::ArgumentNull_Generic));
+
+			rasterizerState = value;
+
+			CullMode_t cullMode = value->getCullMode();
+			DWORD cullEnable = (cullMode != CullMode::None);
+			// Polygon modes GL_POINT (0x1b00) through GL_FILL (0x1b02) follow FillMode::Point (1) through FillMode::Solid (3).
+			DWORD polygonMode = 0x1aff + value->getFillMode();
+			DWORD offsetEnable = (value->getDepthBias() != 0 || value->getSlopeScaleDepthBias() != 0);
+
+			DWORD* p = pb_begin();
+
+			if (UpdateRenderState(NV20_TCL_PRIMITIVE_3D_CULL_FACE_ENABLE, cullEnable))
+			{
+				pb_push1(p, NV20_TCL_PRIMITIVE_3D_CULL_FACE_ENABLE, cullEnable); p += 2;
+			}
+
+			if (cullEnable)
+			{
+				// Front faces are wound clockwise (GL_CW), so culling counter-clockwise faces means culling the back (GL_BACK).
+				DWORD cullFace = (cullMode == CullMode::CullCounterClockwiseFace) ? 0x405 : 0x404;
+
+				if (UpdateRenderState(NV20_TCL_PRIMITIVE_3D_FRONT_FACE, 0x900))
+				{
+					pb_push1(p, NV20_TCL_PRIMITIVE_3D_FRONT_FACE, 0x900); p += 2;
+				}
+
+				if (UpdateRenderState(NV20_TCL_PRIMITIVE_3D_CULL_FACE, cullFace))
+				{
+					pb_push1(p, NV20_TCL_PRIMITIVE_3D_CULL_FACE, cullFace); p += 2;
+				}
+			}
+
+			if (UpdateRenderState(NV20_TCL_PRIMITIVE_3D_POLYGON_MODE_FRONT, polygonMode))
+			{
+				pb_push1(p, NV20_TCL_PRIMITIVE_3D_POLYGON_MODE_FRONT, polygonMode); p += 2;
+			}
+
+			if (UpdateRenderState(NV20_TCL_PRIMITIVE_3D_POLYGON_MODE_BACK, polygonMode))
+			{
+				pb_push1(p, NV20_TCL_PRIMITIVE_3D_POLYGON_MODE_BACK, polygonMode); p += 2;
+			}
+
+			if (UpdateRenderState(NV20_TCL_PRIMITIVE_3D_POLYGON_OFFSET_FILL_ENABLE, offsetEnable))
+			{
+				pb_push1(p, NV20_TCL_PRIMITIVE_3D_POLYGON_OFFSET_FILL_ENABLE, offsetEnable); p += 2;
+			}
+
+			if (offsetEnable)
+			{
+				DWORD factor = FloatToDWORD(value->getSlopeScaleDepthBias());
+				DWORD units = FloatToDWORD(value->getDepthBias());
+
+				if (UpdateRenderState(NV20_TCL_PRIMITIVE_3D_POLYGON_OFFSET_FACTOR, factor))
+				{
+					pb_push1(p, NV20_TCL_PRIMITIVE_3D_POLYGON_OFFSET_FACTOR, factor); p += 2;
+				}
+
+				if (UpdateRenderState(NV20_TCL_PRIMITIVE_3D_POLYGON_OFFSET_UNITS, units))
+				{
+					pb_push1(p, NV20_TCL_PRIMITIVE_3D_POLYGON_OFFSET_UNITS, units); p += 2;
+				}
+			}
+
+			pb_end(p);
+		}
+
+		int GraphicsDevice::getStateBytesSaved() const
+		{
+			return lastFrameStateBytesSaved;
 		}
 
 		TextureCollection GraphicsDevice::getTextures() const
@@ -104,6 +512,9 @@ namespace XFX
 		}
 
 		GraphicsDevice::GraphicsDevice(GraphicsAdapter * const adapter, PresentationParameters * const presentationParameters)
+			: _indices(null), vertexBuffer(null), vertexOffset(0),
+			  blendState(null), depthStencilState(null), rasterizerState(null),
+			  stateBytesSaved(0), lastFrameStateBytesSaved(0)
 		{
 			//sassert(adapter != null, String::Format("adapter; %s", FrameworkResources::ArgumentNull_Generic));
 
@@ -111,6 +522,8 @@ namespace XFX
 
 			//this->_adapter = adapter;
 
+			InvalidateRenderState();
+
 			int err = pb_init();
 
 			switch (err)
@@ -257,16 +670,124 @@ namespace XFX
 			}
 		}
 
+		void GraphicsDevice::DrawIndexedPrimitives(const PrimitiveType_t primitiveType, const int baseVertex, const int minVertexIndex, int numVertices, int startIndex, int primitiveCount)
+		{
+			sassert(vertexBuffer != null, "A valid vertex buffer must be set on the device before any draw operations may be performed.");
+			sassert(_indices != null, "A valid index buffer must be set on the device before any draw operations may be performed.");
+
+			if (vertexBuffer == null || _indices == null || vertexBuffer->data == null || _indices->_data == null || primitiveCount <= 0)
+			{
+				return;
+			}
+
+			const int indexCount = GetIndexCount(primitiveType, primitiveCount);
+
+			sassert(startIndex >= 0 && startIndex + indexCount <= _indices->_indexCount, String::Format("startIndex; %s", FrameworkResources::ArgumentOutOfRange_Index));
+
+			if (startIndex < 0 || startIndex + indexCount > _indices->_indexCount)
+			{
+				return;
+			}
+
+			// The arrays start at the vertex the indices count from, so the indices are sent as they are stored.
+			const VertexDeclaration* declaration = vertexBuffer->vertexDeclaration;
+			const VertexElement* elements = declaration->GetVertexElements();
+			const int stride = declaration->getVertexStride();
+			const DWORD address = ((DWORD)(size_t)vertexBuffer->data & 0x03FFFFFF) + (vertexOffset + baseVertex) * stride;
+			DWORD formats[NV20_TCL_PRIMITIVE_3D_VERTEX_ATTR__SIZE];
+			DWORD pointers[NV20_TCL_PRIMITIVE_3D_VERTEX_ATTR__SIZE];
+
+			for (int i = 0; i < NV20_TCL_PRIMITIVE_3D_VERTEX_ATTR__SIZE; i++)
+			{
+				formats[i] = VERTEX_ATTR_DISABLED;
+			}
+
+			for (int i = 0; i < declaration->getElementCount(); i++)
+			{
+				const int attribute = GetVertexAttribute(elements[i].VertexElementUsage, elements[i].UsageIndex);
+
+				if (attribute < 0)
+				{
+					continue;
+				}
+
+				formats[attribute] = GetVertexAttributeFormat(elements[i].VertexElementFormat, stride);
+				pointers[attribute] = address + elements[i].Offset;
+
+				sassert(formats[attribute] != VERTEX_ATTR_DISABLED, "vertexBuffer; Half precision vertex elements are not supported.");
+			}
+
+			DWORD* p = pb_begin();
+
+			for (int i = 0; i < NV20_TCL_PRIMITIVE_3D_VERTEX_ATTR__SIZE; i++)
+			{
+				if (UpdateRenderState(NV20_TCL_PRIMITIVE_3D_VERTEX_ATTR(i), formats[i]))
+				{
+					pb_push1(p, NV20_TCL_PRIMITIVE_3D_VERTEX_ATTR(i), formats[i]); p += 2;
+				}
+
+				if (formats[i] != VERTEX_ATTR_DISABLED && UpdateRenderState(NV20_TCL_PRIMITIVE_3D_VB_POINTER_ATTR0_POS + i * 4, pointers[i]))
+				{
+					pb_push1(p, NV20_TCL_PRIMITIVE_3D_VB_POINTER_ATTR0_POS + i * 4, pointers[i]); p += 2;
+				}
+			}
+
+			pb_push1(p, NV20_TCL_PRIMITIVE_3D_BEGIN_END, primitiveType); p += 2;
+
+			pb_end(p);
+
+			// 16-bit indices go two to a dword, the first one in the low half, which is how they are laid out in memory.
+			// An odd one out is sent on its own as a 32-bit index.
+			const bool sixteenBits = (_indices->_elementSize == IndexElementSize::SixteenBits);
+			const byte* indices = _indices->_data + startIndex * (sixteenBits ? 2 : 4);
+			const DWORD method = sixteenBits ? NV20_TCL_PRIMITIVE_3D_INDEX_DATA : NV20_TCL_PRIMITIVE_3D_INDEX_DATA32;
+			const int dwords = sixteenBits ? indexCount / 2 : indexCount;
+
+			for (int i = 0; i < dwords; i += INDEX_DWORDS_PER_BURST)
+			{
+				const int burst = (dwords - i < INDEX_DWORDS_PER_BURST) ? dwords - i : INDEX_DWORDS_PER_BURST;
+
+				p = pb_begin();
+
+				pb_push(p++, 0x40000000 | method, burst);
+				memcpy(p, indices + i * sizeof(DWORD), burst * sizeof(DWORD)); p += burst;
+
+				pb_end(p);
+			}
+
+			p = pb_begin();
+
+			if (sixteenBits && (indexCount & 1))
+			{
+				ushort last;
+				memcpy(&last, indices + (indexCount - 1) * 2, sizeof(last));
+
+				pb_push1(p, NV20_TCL_PRIMITIVE_3D_INDEX_DATA32, last); p += 2;
+			}
+
+			pb_push1(p, NV20_TCL_PRIMITIVE_3D_BEGIN_END, STOP); p += 2;
+
+			pb_end(p);
+		}
+
 		const Type& GraphicsDevice::GetType()
 		{
 			return GraphicsDeviceTypeInfo;
 		}
 
+		void GraphicsDevice::InvalidateRenderState()
+		{
+			memset(stateValid, 0, sizeof(stateValid));
+		}
+
 		void GraphicsDevice::Present()
 		{
 			while(pb_finished());
 
 			pb_reset();
+
+			lastFrameStateBytesSaved = stateBytesSaved;
+			stateBytesSaved = 0;
 		}
 
 		void GraphicsDevice::raise_DeviceLost(Object * const sender, EventArgs * const e)
@@ -311,6 +832,38 @@ namespace XFX
 			{
 				//! TODO: set the render target.
 			}
+
+			// Switching targets re-programs surface state behind our back.
+			InvalidateRenderState();
+		}
+
+		void GraphicsDevice::SetVertexBuffer(VertexBuffer * const vertexBuffer, const int vertexOffset)
+		{
+			this->vertexBuffer = vertexBuffer;
+			this->vertexOffset = vertexOffset;
+		}
+
+		void GraphicsDevice::SetVertexBuffer(VertexBuffer * const vertexBuffer)
+		{
+			SetVertexBuffer(vertexBuffer, 0);
+		}
+
+		bool GraphicsDevice::UpdateRenderState(const uint method, const uint value)
+		{
+			uint index = method >> 2;
+			uint bit = 1u << (index & 31);
+
+			sassert(index < (uint)StateRegisterCount, "method; Value is outside the 3D class method range.");
+
+			if ((stateValid[index >> 5] & bit) && stateShadow[index] == value)
+			{
+				stateBytesSaved += RENDER_STATE_SIZE;
+				return false;
+			}
+
+			stateShadow[index] = value;
+			stateValid[index >> 5] |= bit;
+			return true;
 		}
 	}
 }
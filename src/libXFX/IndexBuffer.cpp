@@ -0,0 +1,97 @@
+// Copyright (C) XFX Team
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without 
+// modification, are permitted provided that the following conditions are met:
+// 
+//     * Redistributions of source code must retain the above copyright 
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright 
+//       notice, this list of conditions and the following disclaimer in the 
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the copyright holder nor the names of any 
+//       contributors may be used to endorse or promote products derived from 
+//       this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE 
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF 
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS 
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE 
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include <Graphics/GraphicsDevice.h>
+#include <Graphics/IndexBuffer.h>
+#include <System/Type.h>
+
+#include <stdlib.h>
+
+namespace XFX
+{
+	namespace Graphics
+	{
+		const Type IndexBufferTypeInfo("IndexBuffer", "XFX::Graphics::IndexBuffer", TypeCode::Object);
+
+		BufferUsage_t IndexBuffer::getBufferUsage() const
+		{
+			return _usage;
+		}
+
+		int IndexBuffer::getIndexCount() const
+		{
+			return _indexCount;
+		}
+
+		IndexElementSize_t IndexBuffer::getIndexElementSize() const
+		{
+			return _elementSize;
+		}
+
+		IndexBuffer::IndexBuffer()
+			: _usage(BufferUsage::None), _data(null), _indexCount(0), _elementSize(IndexElementSize::SixteenBits)
+		{
+		}
+
+		IndexBuffer::IndexBuffer(GraphicsDevice * const graphicsDevice, IndexElementSize_t indexElementSize, int indexCount, BufferUsage_t usage)
+			: _usage(usage), _data(null), _indexCount(indexCount), _elementSize(indexElementSize)
+		{
+			sassert(graphicsDevice != null, String::Format("graphicsDevice; %s", FrameworkResources::ArgumentNull_Generic));
+			sassert(indexCount > 0, String::Format("indexCount; %s", FrameworkResources::ArgumentOutOfRange_NeedPosNum));
+
+			this->graphicsDevice = graphicsDevice;
+
+			if (indexCount <= 0)
+			{
+				_indexCount = 0;
+				return;
+			}
+
+			// The indices are copied into the push buffer by DrawIndexedPrimitives, so the GPU never reads this memory.
+			_data = (byte*)malloc(indexCount * ((indexElementSize == IndexElementSize::SixteenBits) ? 2 : 4));
+		}
+
+		IndexBuffer::~IndexBuffer()
+		{
+			Dispose(false);
+		}
+
+		void IndexBuffer::Dispose(bool disposing)
+		{
+			free(_data);
+			_data = null;
+			_indexCount = 0;
+
+			GraphicsResource::Dispose(disposing);
+		}
+
+		const Type& IndexBuffer::GetType()
+		{
+			return IndexBufferTypeInfo;
+		}
+	}
+}
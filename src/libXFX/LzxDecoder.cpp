@@ -0,0 +1,652 @@
+// Copyright (C) XFX Team
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without 
+// modification, are permitted provided that the following conditions are met:
+// 
+//     * Redistributions of source code must retain the above copyright 
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright 
+//       notice, this list of conditions and the following disclaimer in the 
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the copyright holder nor the names of any 
+//       contributors may be used to endorse or promote products derived from 
+//       this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE 
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF 
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS 
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE 
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include "LzxDecoder.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <sassert.h>
+
+// LZX decoding as described in Microsoft's LZX DELTA/CAB documentation, following the structure of libmspack's lzxd.c.
+
+namespace XFX
+{
+	namespace Content
+	{
+		const byte LzxDecoder::ExtraBits[51] =
+		{
+			0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13, 14, 14,
+			15, 15, 16, 16, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17
+		};
+
+		const uint LzxDecoder::PositionBase[51] =
+		{
+			0, 1, 2, 3, 4, 6, 8, 12, 16, 24, 32, 48, 64, 96, 128, 192, 256, 384, 512, 768, 1024, 1536, 2048, 3072, 4096, 6144,
+			8192, 12288, 16384, 24576, 32768, 49152, 65536, 98304, 131072, 196608, 262144, 393216, 524288, 655360, 786432,
+			917504, 1048576, 1179648, 1310720, 1441792, 1572864, 1703936, 1835008, 1966080, 2097152
+		};
+
+		// Block types
+		static const int BlockTypeVerbatim = 1;
+		static const int BlockTypeAligned = 2;
+		static const int BlockTypeUncompressed = 3;
+
+		LzxDecoder::LzxDecoder(const int windowBits)
+		{
+			sassert(windowBits >= 15 && windowBits <= 21, "windowBits; Value must be between 15 and 21.");
+
+			windowSize = 1u << windowBits;
+			window = (byte*)malloc(windowSize);
+			memset(window, 0xDC, windowSize);
+
+			// 2 position slots per window bit up to 2^19; the larger windows need 42 and 50
+			int positionSlots = (windowBits == 21) ? 50 : ((windowBits == 20) ? 42 : windowBits << 1);
+			mainElements = NumChars + (positionSlots << 3);
+
+			windowPosition = 0;
+			R0 = R1 = R2 = 1;
+			headerRead = false;
+			blockType = 0;
+			blockLength = 0;
+			blockRemaining = 0;
+			framesRead = 0;
+			intelStarted = false;
+			intelFileSize = 0;
+			intelCurrentPosition = 0;
+
+			// code lengths are sent as deltas against the previous tree, starting from all zeroes
+			memset(mainTreeLengths, 0, sizeof(mainTreeLengths));
+			memset(lengthLengths, 0, sizeof(lengthLengths));
+
+			input = null;
+			inputEnd = null;
+			bitBuffer = 0;
+			bitsLeft = 0;
+		}
+
+		LzxDecoder::~LzxDecoder()
+		{
+			free(window);
+		}
+
+		inline void LzxDecoder::EnsureBits(const int count)
+		{
+			while (bitsLeft < count)
+			{
+				// Past the end of the frame the stream reads as zeroes; corrupt data is caught by the table and range checks.
+				uint word = 0;
+
+				if (input + 1 < inputEnd)
+				{
+					word = (input[1] << 8) | input[0];
+				}
+
+				input += 2;
+				bitBuffer |= word << (16 - bitsLeft);
+				bitsLeft += 16;
+			}
+		}
+
+		inline uint LzxDecoder::PeekBits(const int count) const
+		{
+			return bitBuffer >> (32 - count);
+		}
+
+		inline void LzxDecoder::RemoveBits(const int count)
+		{
+			bitBuffer <<= count;
+			bitsLeft -= count;
+		}
+
+		inline uint LzxDecoder::ReadBits(const int count)
+		{
+			EnsureBits(count);
+			uint result = PeekBits(count);
+			RemoveBits(count);
+			return result;
+		}
+
+		void LzxDecoder::InitBitStream(const byte * const data, const int length)
+		{
+			input = data;
+			inputEnd = data + length;
+			bitBuffer = 0;
+			bitsLeft = 0;
+		}
+
+		bool LzxDecoder::MakeDecodeTable(const int symbolCount, const int tableBits, const byte lengths[], ushort table[])
+		{
+			uint position = 0;
+			uint tableMask = 1u << tableBits;
+			uint bitMask = tableMask >> 1;
+
+			// codes that fit in tableBits fill all the table entries they prefix
+			for (int bitNum = 1; bitNum <= tableBits; bitNum++)
+			{
+				for (int symbol = 0; symbol < symbolCount; symbol++)
+				{
+					if (lengths[symbol] != bitNum)
+					{
+						continue;
+					}
+
+					uint leaf = position;
+
+					if ((position += bitMask) > tableMask)
+					{
+						return false;
+					}
+
+					for (uint fill = bitMask; fill > 0; fill--)
+					{
+						table[leaf++] = symbol;
+					}
+				}
+
+				bitMask >>= 1;
+			}
+
+			if (position != tableMask)
+			{
+				// longer codes continue as a binary tree stored behind the direct lookup entries
+				for (uint symbol = position; symbol < tableMask; symbol++)
+				{
+					table[symbol] = 0xFFFF;
+				}
+
+				uint nextSymbol = ((tableMask >> 1) < (uint)symbolCount) ? symbolCount : (tableMask >> 1);
+
+				position <<= 16;
+				tableMask <<= 16;
+				bitMask = 1 << 15;
+
+				for (int bitNum = tableBits + 1; bitNum <= 16; bitNum++)
+				{
+					for (int symbol = 0; symbol < symbolCount; symbol++)
+					{
+						if (lengths[symbol] != bitNum)
+						{
+							continue;
+						}
+
+						uint leaf = position >> 16;
+
+						for (int fill = 0; fill < bitNum - tableBits; fill++)
+						{
+							if (table[leaf] == 0xFFFF)
+							{
+								table[nextSymbol << 1] = 0xFFFF;
+								table[(nextSymbol << 1) + 1] = 0xFFFF;
+								table[leaf] = nextSymbol++;
+							}
+
+							leaf = table[leaf] << 1;
+
+							if ((position >> (15 - fill)) & 1)
+							{
+								leaf++;
+							}
+						}
+
+						table[leaf] = symbol;
+
+						if ((position += bitMask) > tableMask)
+						{
+							return false;
+						}
+					}
+
+					bitMask >>= 1;
+				}
+			}
+
+			if (position == tableMask)
+			{
+				return true;
+			}
+
+			// an incomplete table is only valid if no symbols are used at all
+			for (int symbol = 0; symbol < symbolCount; symbol++)
+			{
+				if (lengths[symbol] != 0)
+				{
+					return false;
+				}
+			}
+
+			return true;
+		}
+
+		bool LzxDecoder::ReadHuffmanSymbol(const ushort table[], const byte lengths[], const int symbolCount, const int tableBits, int& symbol)
+		{
+			EnsureBits(16);
+
+			uint i = table[PeekBits(tableBits)];
+
+			if (i >= (uint)symbolCount)
+			{
+				uint j = 1u << (32 - tableBits);
+
+				do
+				{
+					j >>= 1;
+
+					if (j == 0)
+					{
+						return false;
+					}
+
+					i = (i << 1) | ((bitBuffer & j) ? 1 : 0);
+					i = table[i];
+				}
+				while (i >= (uint)symbolCount);
+			}
+
+			symbol = i;
+			RemoveBits(lengths[i]);
+			return true;
+		}
+
+		bool LzxDecoder::ReadLengths(byte lengths[], const int first, const int last)
+		{
+			// The code lengths are themselves Huffman coded with a 20 symbol pretree.
+			for (int i = 0; i < PretreeMaxSymbols; i++)
+			{
+				pretreeLengths[i] = ReadBits(4);
+			}
+
+			if (!MakeDecodeTable(PretreeMaxSymbols, PretreeTableBits, pretreeLengths, pretreeTable))
+			{
+				return false;
+			}
+
+			for (int x = first; x < last; )
+			{
+				int z;
+
+				if (!ReadHuffmanSymbol(pretreeTable, pretreeLengths, PretreeMaxSymbols, PretreeTableBits, z))
+				{
+					return false;
+				}
+
+				if (z == 17)
+				{
+					// run of 4-19 zeroes
+					for (int y = ReadBits(4) + 4; y > 0 && x < last + LengthTableSafety; y--)
+					{
+						lengths[x++] = 0;
+					}
+				}
+				else if (z == 18)
+				{
+					// run of 20-51 zeroes
+					for (int y = ReadBits(5) + 20; y > 0 && x < last + LengthTableSafety; y--)
+					{
+						lengths[x++] = 0;
+					}
+				}
+				else if (z == 19)
+				{
+					// run of 4-5 copies of the same delta
+					int y = ReadBits(1) + 4;
+
+					if (!ReadHuffmanSymbol(pretreeTable, pretreeLengths, PretreeMaxSymbols, PretreeTableBits, z))
+					{
+						return false;
+					}
+
+					z = lengths[x] - z;
+
+					if (z < 0)
+					{
+						z += 17;
+					}
+
+					for ( ; y > 0 && x < last + LengthTableSafety; y--)
+					{
+						lengths[x++] = z;
+					}
+				}
+				else
+				{
+					z = lengths[x] - z;
+
+					if (z < 0)
+					{
+						z += 17;
+					}
+
+					lengths[x++] = z;
+				}
+			}
+
+			return true;
+		}
+
+		bool LzxDecoder::Decompress(const byte data[], const int inputLength, byte output[], const int outputLength)
+		{
+			InitBitStream(data, inputLength);
+
+			if (!headerRead)
+			{
+				// the stream starts with a flag telling whether x86 CALL translation was applied, followed by the translation size
+				if (ReadBits(1))
+				{
+					uint high = ReadBits(16);
+					uint low = ReadBits(16);
+					intelFileSize = (int)((high << 16) | low);
+				}
+
+				headerRead = true;
+			}
+
+			// frames never straddle the end of the window, so each one is decoded into a contiguous range
+			windowPosition &= windowSize - 1;
+
+			uint frameStart = windowPosition;
+			int togo = outputLength;
+
+			if (frameStart + outputLength > windowSize)
+			{
+				return false;
+			}
+
+			while (togo > 0)
+			{
+				if (blockRemaining == 0)
+				{
+					if (blockType == BlockTypeUncompressed)
+					{
+						// uncompressed blocks are padded to an even length
+						if (blockLength & 1)
+						{
+							input++;
+						}
+
+						bitBuffer = 0;
+						bitsLeft = 0;
+					}
+
+					blockType = ReadBits(3);
+					uint high = ReadBits(16);
+					uint low = ReadBits(8);
+					blockRemaining = blockLength = (high << 8) | low;
+
+					switch (blockType)
+					{
+					case BlockTypeAligned:
+						for (int i = 0; i < AlignedMaxSymbols; i++)
+						{
+							alignedLengths[i] = ReadBits(3);
+						}
+
+						if (!MakeDecodeTable(AlignedMaxSymbols, AlignedTableBits, alignedLengths, alignedTable))
+						{
+							return false;
+						}
+						// aligned blocks carry the same trees as verbatim blocks after the aligned offset tree
+					case BlockTypeVerbatim:
+						if (!ReadLengths(mainTreeLengths, 0, NumChars) || !ReadLengths(mainTreeLengths, NumChars, mainElements) ||
+							!MakeDecodeTable(MainTreeMaxSymbols, MainTreeTableBits, mainTreeLengths, mainTreeTable))
+						{
+							return false;
+						}
+
+						if (mainTreeLengths[0xE8] != 0)
+						{
+							intelStarted = true;
+						}
+
+						if (!ReadLengths(lengthLengths, 0, NumSecondaryLengths) ||
+							!MakeDecodeTable(LengthMaxSymbols, LengthTableBits, lengthLengths, lengthTable))
+						{
+							return false;
+						}
+						break;
+					case BlockTypeUncompressed:
+						intelStarted = true;
+
+						// skip the 1-16 bits of padding up to the next 16-bit boundary, then read R0-R2 as raw little-endian values
+						EnsureBits(16);
+
+						if (bitsLeft > 16)
+						{
+							input -= 2;
+						}
+
+						if (input + 12 > inputEnd)
+						{
+							return false;
+						}
+
+						R0 = input[0] | (input[1] << 8) | (input[2] << 16) | (input[3] << 24);
+						R1 = input[4] | (input[5] << 8) | (input[6] << 16) | (input[7] << 24);
+						R2 = input[8] | (input[9] << 8) | (input[10] << 16) | (input[11] << 24);
+						input += 12;
+						break;
+					default:
+						return false;
+					}
+				}
+
+				int thisRun;
+
+				while ((thisRun = (int)blockRemaining) > 0 && togo > 0)
+				{
+					if (thisRun > togo)
+					{
+						thisRun = togo;
+					}
+
+					togo -= thisRun;
+					blockRemaining -= thisRun;
+
+					if (blockType == BlockTypeUncompressed)
+					{
+						if (input + thisRun > inputEnd)
+						{
+							return false;
+						}
+
+						memcpy(&window[windowPosition], input, thisRun);
+						input += thisRun;
+						windowPosition += thisRun;
+						continue;
+					}
+
+					while (thisRun > 0)
+					{
+						int mainElement;
+
+						if (!ReadHuffmanSymbol(mainTreeTable, mainTreeLengths, MainTreeMaxSymbols, MainTreeTableBits, mainElement))
+						{
+							return false;
+						}
+
+						if (mainElement < NumChars)
+						{
+							window[windowPosition++] = mainElement;
+							thisRun--;
+							continue;
+						}
+
+						mainElement -= NumChars;
+
+						int matchLength = mainElement & NumPrimaryLengths;
+
+						if (matchLength == NumPrimaryLengths)
+						{
+							int lengthFooter;
+
+							if (!ReadHuffmanSymbol(lengthTable, lengthLengths, LengthMaxSymbols, LengthTableBits, lengthFooter))
+							{
+								return false;
+							}
+
+							matchLength += lengthFooter;
+						}
+
+						matchLength += MinMatch;
+
+						uint matchOffset = mainElement >> 3;
+
+						if (matchOffset > 2)
+						{
+							// not one of the three repeated offsets
+							int extra = ExtraBits[matchOffset];
+							matchOffset = PositionBase[matchOffset] - 2;
+
+							if (blockType == BlockTypeAligned && extra >= 3)
+							{
+								// the lowest three bits of the offset come from the aligned offset tree
+								int alignedBits;
+
+								if (extra > 3)
+								{
+									matchOffset += ReadBits(extra - 3) << 3;
+								}
+
+								if (!ReadHuffmanSymbol(alignedTable, alignedLengths, AlignedMaxSymbols, AlignedTableBits, alignedBits))
+								{
+									return false;
+								}
+
+								matchOffset += alignedBits;
+							}
+							else if (extra > 0)
+							{
+								matchOffset += ReadBits(extra);
+							}
+							else
+							{
+								matchOffset = 1;
+							}
+
+							R2 = R1;
+							R1 = R0;
+							R0 = matchOffset;
+						}
+						else if (matchOffset == 0)
+						{
+							matchOffset = R0;
+						}
+						else if (matchOffset == 1)
+						{
+							matchOffset = R1;
+							R1 = R0;
+							R0 = matchOffset;
+						}
+						else
+						{
+							matchOffset = R2;
+							R2 = R0;
+							R0 = matchOffset;
+						}
+
+						if (matchOffset == 0 || matchOffset > windowSize || windowPosition + matchLength > windowSize)
+						{
+							return false;
+						}
+
+						// copy byte by byte, as overlapping matches repeat the bytes they just wrote
+						byte* destination = &window[windowPosition];
+						uint source = (windowPosition >= matchOffset) ? windowPosition - matchOffset : windowPosition + (windowSize - matchOffset);
+
+						thisRun -= matchLength;
+						windowPosition += matchLength;
+
+						while (matchLength-- > 0)
+						{
+							*destination++ = window[source];
+							source = (source + 1) & (windowSize - 1);
+						}
+					}
+
+					// a match may run on past the end of this run; take its overhang out of the block
+					if (thisRun < 0)
+					{
+						if ((uint)-thisRun > blockRemaining)
+						{
+							return false;
+						}
+
+						blockRemaining -= -thisRun;
+					}
+				}
+			}
+
+			// matches are not allowed to cross into the next frame
+			if (windowPosition - frameStart != (uint)outputLength)
+			{
+				return false;
+			}
+
+			memcpy(output, &window[frameStart], outputLength);
+
+			// x86 CALL translation is only applied to the first 32768 frames
+			if (intelStarted && intelFileSize != 0 && framesRead++ < 32768 && outputLength > 10)
+			{
+				UndoE8Translation(output, outputLength);
+			}
+
+			intelCurrentPosition += outputLength;
+
+			return true;
+		}
+
+		void LzxDecoder::UndoE8Translation(byte data[], const int length)
+		{
+			int currentPosition = intelCurrentPosition;
+			byte* end = data + length - 10;
+
+			while (data < end)
+			{
+				if (*data++ != 0xE8)
+				{
+					currentPosition++;
+					continue;
+				}
+
+				int absoluteOffset = data[0] | (data[1] << 8) | (data[2] << 16) | (data[3] << 24);
+
+				if (absoluteOffset >= -currentPosition && absoluteOffset < intelFileSize)
+				{
+					int relativeOffset = (absoluteOffset >= 0) ? absoluteOffset - currentPosition : absoluteOffset + intelFileSize;
+
+					data[0] = (byte)relativeOffset;
+					data[1] = (byte)(relativeOffset >> 8);
+					data[2] = (byte)(relativeOffset >> 16);
+					data[3] = (byte)(relativeOffset >> 24);
+				}
+
+				data += 4;
+				currentPosition += 5;
+			}
+		}
+	}
+}
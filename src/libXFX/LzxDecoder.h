@@ -0,0 +1,114 @@
+/*****************************************************************************
+ *	LzxDecoder.h															 *
+ *																			 *
+ *	XFX::Content::LzxDecoder class definition file							 *
+ *	Copyright (c) XFX Team. All Rights Reserved 							 *
+ *****************************************************************************/
+#ifndef _XFX_CONTENT_LZXDECODER_
+#define _XFX_CONTENT_LZXDECODER_
+
+#include <System/Types.h>
+
+using namespace System;
+
+namespace XFX
+{
+	namespace Content
+	{
+		/**
+		 * Decodes the LZX frames of compressed .xnb files.
+		 *
+		 * The window, the repeated offsets and the Huffman code lengths carry over from one frame to the next,
+		 * so frames have to be passed to Decompress in order. All memory is allocated up front.
+		 */
+		// This class is not meant to be used by the end user.
+		// Only XFX source files should reference this class.
+		class LzxDecoder
+		{
+		private:
+			static const int MinMatch = 2;
+			static const int NumChars = 256;
+			static const int NumPrimaryLengths = 7;
+			static const int NumSecondaryLengths = 249;
+
+			static const int PretreeMaxSymbols = 20;
+			static const int PretreeTableBits = 6;
+			static const int MainTreeMaxSymbols = NumChars + 50 * 8;
+			static const int MainTreeTableBits = 12;
+			static const int LengthMaxSymbols = NumSecondaryLengths + 1;
+			static const int LengthTableBits = 12;
+			static const int AlignedMaxSymbols = 8;
+			static const int AlignedTableBits = 7;
+
+			// read_lengths may write a run past the last symbol of a corrupt tree
+			static const int LengthTableSafety = 64;
+
+			static const byte ExtraBits[51];
+			static const uint PositionBase[51];
+
+			byte* window;
+			uint windowSize;
+			uint windowPosition;
+			uint R0, R1, R2;
+			int mainElements;
+			bool headerRead;
+			int blockType;
+			uint blockLength;
+			uint blockRemaining;
+			uint framesRead;
+			bool intelStarted;
+			int intelFileSize;
+			int intelCurrentPosition;
+
+			ushort pretreeTable[(1 << PretreeTableBits) + (PretreeMaxSymbols << 1)];
+			byte pretreeLengths[PretreeMaxSymbols + LengthTableSafety];
+			ushort mainTreeTable[(1 << MainTreeTableBits) + (MainTreeMaxSymbols << 1)];
+			byte mainTreeLengths[MainTreeMaxSymbols + LengthTableSafety];
+			ushort lengthTable[(1 << LengthTableBits) + (LengthMaxSymbols << 1)];
+			byte lengthLengths[LengthMaxSymbols + LengthTableSafety];
+			ushort alignedTable[(1 << AlignedTableBits) + (AlignedMaxSymbols << 1)];
+			byte alignedLengths[AlignedMaxSymbols];
+
+			// The bit reader; only valid during a call to Decompress.
+			const byte* input;
+			const byte* inputEnd;
+			uint bitBuffer;
+			int bitsLeft;
+
+			LzxDecoder(const LzxDecoder &obj);
+
+			inline void EnsureBits(const int count);
+			inline uint PeekBits(const int count) const;
+			inline void RemoveBits(const int count);
+			inline uint ReadBits(const int count);
+			void InitBitStream(const byte * const data, const int length);
+			static bool MakeDecodeTable(const int symbolCount, const int tableBits, const byte lengths[], ushort table[]);
+			bool ReadHuffmanSymbol(const ushort table[], const byte lengths[], const int symbolCount, const int tableBits, int& symbol);
+			bool ReadLengths(byte lengths[], const int first, const int last);
+			void UndoE8Translation(byte data[], const int length);
+
+		public:
+			/**
+			 * Creates a decoder for a window of 2^windowBits bytes. XNA uses 16, which gives a 64KB window.
+			 */
+			LzxDecoder(const int windowBits);
+			~LzxDecoder();
+
+			/**
+			 * Decodes a single frame.
+			 *
+			 * @param input
+			 * The compressed bytes of the frame, starting at a 16-bit boundary of the LZX bitstream.
+			 *
+			 * @param output
+			 * Receives outputLength uncompressed bytes.
+			 *
+			 * @return
+			 * false if the data is corrupt.
+			 */
+			bool Decompress(const byte input[], const int inputLength, byte output[], const int outputLength);
+		};
+	}
+}
+
+#endif //_XFX_CONTENT_LZXDECODER_
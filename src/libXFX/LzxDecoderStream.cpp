@@ -0,0 +1,238 @@
+// Copyright (C) XFX Team
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without 
+// modification, are permitted provided that the following conditions are met:
+// 
+//     * Redistributions of source code must retain the above copyright 
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright 
+//       notice, this list of conditions and the following disclaimer in the 
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the copyright holder nor the names of any 
+//       contributors may be used to endorse or promote products derived from 
+//       this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE 
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF 
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS 
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE 
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include <System/FrameworkResources.h>
+#include <System/String.h>
+#include <System/Type.h>
+
+#include "LzxDecoderStream.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <sassert.h>
+
+namespace XFX
+{
+	namespace Content
+	{
+		const Type LzxDecoderStreamTypeInfo("LzxDecoderStream", "XFX::Content::LzxDecoderStream", TypeCode::Object);
+
+		bool LzxDecoderStream::CanRead()
+		{
+			return baseStream != null;
+		}
+
+		bool LzxDecoderStream::CanSeek()
+		{
+			return false;
+		}
+
+		bool LzxDecoderStream::CanWrite()
+		{
+			return false;
+		}
+
+		long long LzxDecoderStream::Length()
+		{
+			return decompressedSize;
+		}
+
+		LzxDecoderStream::LzxDecoderStream(Stream * const stream, const int compressedSize, const int decompressedSize)
+			: baseStream(stream), decoder(16), frameLength(0), framePosition(0), compressedRemaining(compressedSize), decompressedSize(decompressedSize)
+		{
+			sassert(stream != null, String::Format("stream; %s", FrameworkResources::ArgumentNull_Generic));
+
+			compressedBuffer = (byte*)malloc(MaxBlockSize);
+			frameBuffer = (byte*)malloc(MaxBlockSize);
+			Position = 0;
+		}
+
+		LzxDecoderStream::~LzxDecoderStream()
+		{
+			Dispose(false);
+		}
+
+		void LzxDecoderStream::Dispose(bool disposing)
+		{
+			if (disposing && baseStream != null)
+			{
+				baseStream->Close();
+			}
+
+			baseStream = null;
+
+			free(compressedBuffer);
+			compressedBuffer = null;
+			free(frameBuffer);
+			frameBuffer = null;
+
+			Stream::Dispose(disposing);
+		}
+
+		void LzxDecoderStream::Flush()
+		{
+		}
+
+		const Type& LzxDecoderStream::GetType()
+		{
+			return LzxDecoderStreamTypeInfo;
+		}
+
+		int LzxDecoderStream::Read(byte buffer[], int offset, int count)
+		{
+			sassert(baseStream != null, FrameworkResources::ObjectDisposed_StreamClosed);
+
+			sassert(buffer != null, FrameworkResources::ArgumentNull_Buffer);
+
+			sassert(offset >= 0, String::Format("%s; %s", String::Format(FrameworkResources::Arg_ParamName_Name, "offset"), FrameworkResources::ArgumentOutOfRange_NeedNonNegNum));
+
+			sassert(count >= 0, String::Format("%s; %s", String::Format(FrameworkResources::Arg_ParamName_Name, "count"), FrameworkResources::ArgumentOutOfRange_NeedNonNegNum));
+
+			int read = 0;
+
+			while (read < count)
+			{
+				if (framePosition == frameLength && !ReadFrame())
+				{
+					break;
+				}
+
+				int available = frameLength - framePosition;
+				int num = (count - read < available) ? count - read : available;
+
+				memcpy(&buffer[offset + read], &frameBuffer[framePosition], num);
+				framePosition += num;
+				read += num;
+			}
+
+			Position += read;
+			return read;
+		}
+
+		int LzxDecoderStream::ReadByte()
+		{
+			if (framePosition == frameLength && !ReadFrame())
+			{
+				return -1;
+			}
+
+			Position++;
+			return frameBuffer[framePosition++];
+		}
+
+		bool LzxDecoderStream::ReadFrame()
+		{
+			if (compressedRemaining <= 0 || Position >= decompressedSize)
+			{
+				return false;
+			}
+
+			// 0xFF marks a frame with an explicit size; all others decompress to 32KB
+			byte header[5];
+			int frameSize = DefaultFrameSize;
+			int blockSize;
+
+			if (!ReadFully(header, 2))
+			{
+				return false;
+			}
+
+			if (header[0] == 0xFF)
+			{
+				if (!ReadFully(&header[2], 3))
+				{
+					return false;
+				}
+
+				frameSize = (header[1] << 8) | header[2];
+				blockSize = (header[3] << 8) | header[4];
+				compressedRemaining -= 5;
+			}
+			else
+			{
+				blockSize = (header[0] << 8) | header[1];
+				compressedRemaining -= 2;
+			}
+
+			if (blockSize == 0 || frameSize == 0 || !ReadFully(compressedBuffer, blockSize))
+			{
+				return false;
+			}
+
+			compressedRemaining -= blockSize;
+
+			bool decompressed = decoder.Decompress(compressedBuffer, blockSize, frameBuffer, frameSize);
+
+			sassert(decompressed, "The compressed content is corrupt.");
+
+			if (!decompressed)
+			{
+				return false;
+			}
+
+			// the last frame may decode to more than is left of the content
+			frameLength = (frameSize < decompressedSize - Position) ? frameSize : (int)(decompressedSize - Position);
+			framePosition = 0;
+			return true;
+		}
+
+		bool LzxDecoderStream::ReadFully(byte buffer[], const int count)
+		{
+			for (int read = 0; read < count; )
+			{
+				int num = baseStream->Read(buffer, read, count - read);
+
+				if (num <= 0)
+				{
+					return false;
+				}
+
+				read += num;
+			}
+
+			return true;
+		}
+
+		long long LzxDecoderStream::Seek(long long offset, SeekOrigin_t origin)
+		{
+			sassert(false, FrameworkResources::NotSupported_UnseekableStream);
+
+			return Position;
+		}
+
+		void LzxDecoderStream::SetLength(long long value)
+		{
+			sassert(false, FrameworkResources::NotSupported_UnwritableStream);
+		}
+
+		void LzxDecoderStream::Write(byte buffer[], int offset, int count)
+		{
+			sassert(false, FrameworkResources::NotSupported_UnwritableStream);
+		}
+	}
+}
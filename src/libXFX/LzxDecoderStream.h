@@ -0,0 +1,82 @@
+/*****************************************************************************
+ *	LzxDecoderStream.h														 *
+ *																			 *
+ *	XFX::Content::LzxDecoderStream class definition file					 *
+ *	Copyright (c) XFX Team. All Rights Reserved 							 *
+ *****************************************************************************/
+#ifndef _XFX_CONTENT_LZXDECODERSTREAM_
+#define _XFX_CONTENT_LZXDECODERSTREAM_
+
+#include <System/IO/Stream.h>
+
+#include "LzxDecoder.h"
+
+using namespace System;
+using namespace System::IO;
+
+namespace XFX
+{
+	namespace Content
+	{
+		/**
+		 * A read-only stream over the LZX compressed body of an .xnb file.
+		 *
+		 * The body is a sequence of frames, each preceded by its compressed size and, if it is not 32KB, its uncompressed size.
+		 * Frames are decompressed one at a time as they are read, so only one compressed and one uncompressed frame are held in memory.
+		 */
+		// This class is not meant to be used by the end user.
+		// Only XFX source files should reference this class.
+		class LzxDecoderStream : public Stream
+		{
+		private:
+			static const int DefaultFrameSize = 0x8000;
+			static const int MaxBlockSize = 0xFFFF;
+
+			Stream* baseStream;
+			LzxDecoder decoder;
+			byte* compressedBuffer;
+			byte* frameBuffer;
+			int frameLength;
+			int framePosition;
+			int compressedRemaining;
+			int decompressedSize;
+
+			LzxDecoderStream(const LzxDecoderStream &obj);
+
+			bool ReadFrame();
+			bool ReadFully(byte buffer[], const int count);
+
+		protected:
+			void Dispose(bool disposing);
+
+		public:
+			bool CanRead();
+			bool CanSeek();
+			bool CanWrite();
+			long long Length();
+
+			/**
+			 * @param stream
+			 * The .xnb file, positioned after the decompressed size field.
+			 *
+			 * @param compressedSize
+			 * The number of compressed bytes following the current position.
+			 *
+			 * @param decompressedSize
+			 * The number of bytes the data decompresses to.
+			 */
+			LzxDecoderStream(Stream * const stream, const int compressedSize, const int decompressedSize);
+			~LzxDecoderStream();
+
+			void Flush();
+			static const Type& GetType();
+			int Read(byte buffer[], int offset, int count);
+			int ReadByte();
+			long long Seek(long long offset, SeekOrigin_t origin);
+			void SetLength(long long value);
+			void Write(byte buffer[], int offset, int count);
+		};
+	}
+}
+
+#endif //_XFX_CONTENT_LZXDECODERSTREAM_
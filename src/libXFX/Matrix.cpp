@@ -33,6 +33,7 @@
 #include <Plane.h>
 #include <Quaternion.h>
 #include <Vector3.h>
+#include "MatrixKernels.h"
 
 #include <sassert.h>
 
@@ -72,7 +73,7 @@ namespace XFX
 		return Vector3(M31, M32, M33);
 	}
 	
-	void Matrix::Backward(Vector3 vector)
+	void Matrix::Backward(const Vector3& vector)
 	{
 		M31 = vector.X;
 		M32 = vector.Y;
@@ -84,7 +85,7 @@ namespace XFX
 		return Vector3(-M21, -M22, -M23);
 	}
 	
-	void Matrix::Down(Vector3 vector)
+	void Matrix::Down(const Vector3& vector)
 	{
 		M21 = -vector.X;
 		M22 = -vector.Y;
@@ -96,7 +97,7 @@ namespace XFX
 		return Vector3(-M31, -M32, -M33);
 	}
 	
-	void Matrix::Forward(Vector3 vector)
+	void Matrix::Forward(const Vector3& vector)
 	{
 		M31 = -vector.X;
 		M32 = -vector.Y;
@@ -108,7 +109,7 @@ namespace XFX
 		return Vector3(-M11, -M12, -M13);
 	}
 	
-	void Matrix::Left(Vector3 vector)
+	void Matrix::Left(const Vector3& vector)
 	{
 		M11 = -vector.X;
 		M12 = -vector.Y;
@@ -120,7 +121,7 @@ namespace XFX
 		return Vector3(M11, M12, M13);
 	}
 	
-	void Matrix::Right(Vector3 vector)
+	void Matrix::Right(const Vector3& vector)
 	{
 		M11 = vector.X;
 		M12 = vector.Y;
@@ -132,7 +133,7 @@ namespace XFX
 		return Vector3(M41, M42, M43);
 	}
 	
-	void Matrix::Translation(Vector3 vector)
+	void Matrix::Translation(const Vector3& vector)
 	{
 		M41 = vector.X;
 		M42 = vector.Y;
@@ -144,21 +145,21 @@ namespace XFX
 		return Vector3(M21, M22, M23);
 	}
 	
-	void Matrix::Up(Vector3 vector)
+	void Matrix::Up(const Vector3& vector)
 	{
 		M21 = vector.X;
 		M22 = vector.Y;
 		M23 = vector.Z;
 	}
 	
-	Matrix Matrix::Add(Matrix matrix1, Matrix matrix2)
+	Matrix Matrix::Add(const Matrix& matrix1, const Matrix& matrix2)
 	{
 		Matrix result;
 		Add(matrix1, matrix2, result);
 		return result;
 	}
 	
-	void Matrix::Add(Matrix matrix1, Matrix matrix2, out Matrix& result)
+	void Matrix::Add(const Matrix& matrix1, const Matrix& matrix2, out Matrix& result)
 	{
 		result.M11 = matrix1.M11 + matrix2.M11;
 		result.M12 = matrix1.M12 + matrix2.M12;
@@ -178,14 +179,14 @@ namespace XFX
 		result.M44 = matrix1.M44 + matrix2.M44;
 	}
 	
-	Matrix Matrix::CreateBillboard(Vector3 objectPosition, Vector3 cameraPosition, Vector3 cameraUpVector, Vector3* cameraForwardVector)
+	Matrix Matrix::CreateBillboard(const Vector3& objectPosition, const Vector3& cameraPosition, const Vector3& cameraUpVector, Vector3* cameraForwardVector)
 	{
 		Matrix result;
 		CreateBillboard(objectPosition, cameraPosition, cameraUpVector, cameraForwardVector, result);
 		return result;
 	}
 	
-	void Matrix::CreateBillboard(Vector3 objectPosition, Vector3 cameraPosition, Vector3 cameraUpVector, Vector3* cameraForwardVector, out Matrix& result)
+	void Matrix::CreateBillboard(const Vector3& objectPosition, const Vector3& cameraPosition, const Vector3& cameraUpVector, Vector3* cameraForwardVector, out Matrix& result)
 	{
 		Vector3 vector;
 		Vector3 vector2;
@@ -225,14 +226,14 @@ namespace XFX
 		result.M44 = 1.0f;
 	} 
 
-	Matrix Matrix::CreateConstrainedBillboard(Vector3 objectPosition, Vector3 cameraPosition, Vector3 rotateAxis, Vector3* cameraForwardVector, Vector3* objectForwardVector)
+	Matrix Matrix::CreateConstrainedBillboard(const Vector3& objectPosition, const Vector3& cameraPosition, const Vector3& rotateAxis, Vector3* cameraForwardVector, Vector3* objectForwardVector)
 	{
 		Matrix result;
 		CreateConstrainedBillboard(objectPosition, cameraPosition, rotateAxis, cameraForwardVector, objectForwardVector, result);
 		return result;
 	}
 
-	void Matrix::CreateConstrainedBillboard(Vector3 objectPosition, Vector3 cameraPosition, Vector3 rotateAxis, Vector3* cameraForwardVector, Vector3* objectForwardVector, out Matrix& result)
+	void Matrix::CreateConstrainedBillboard(const Vector3& objectPosition, const Vector3& cameraPosition, const Vector3& rotateAxis, Vector3* cameraForwardVector, Vector3* objectForwardVector, out Matrix& result)
 	{
 		float num = 0.0f;
 		Vector3 vector;
@@ -305,23 +306,25 @@ namespace XFX
 		result.M44 = 1.0f;
 	}
 
-	Matrix Matrix::CreateFromAxisAngle(Vector3 axis,float angle)
+	Matrix Matrix::CreateFromAxisAngle(const Vector3& axis,float angle)
 	{
 		Matrix result;
 		CreateFromAxisAngle(axis, angle, result);
 		return result;
 	}
 	
-	void Matrix::CreateFromAxisAngle(Vector3 axis, float angle, out Matrix& result) 
+	void Matrix::CreateFromAxisAngle(const Vector3& axis, float angle, out Matrix& result) 
 	{
-		if(axis.LengthSquared() != 1.0f)
+		Vector3 normal = axis;
+
+		if(normal.LengthSquared() != 1.0f)
 		{
-			axis.Normalize();
+			normal.Normalize();
 		}
 
-		float x = axis.X;
-		float y = axis.Y;
-		float z = axis.Z;
+		float x = normal.X;
+		float y = normal.Y;
+		float z = normal.Z;
 		float cos = Math::Cos(angle);
 		float sin = Math::Sin(angle);
 		float xx = x * x;
@@ -349,14 +352,14 @@ namespace XFX
 		result.M44 = 1.0f;
 	}
 
-	Matrix Matrix::CreateFromQuaternion(Quaternion rotation)
+	Matrix Matrix::CreateFromQuaternion(const Quaternion& rotation)
 	{
 		Matrix result;
 		CreateFromQuaternion(rotation, result);
 		return result;
 	}
 	
-	void Matrix::CreateFromQuaternion(Quaternion rotation, out Matrix& result)
+	void Matrix::CreateFromQuaternion(const Quaternion& rotation, out Matrix& result)
 	{
 		float xx = rotation.X * rotation.X; 
 		float yy = rotation.Y * rotation.Y; 
@@ -400,14 +403,14 @@ namespace XFX
 		CreateFromQuaternion(quaternion, result);
 	}
 	
-	Matrix Matrix::CreateLookAt(Vector3 cameraPosition, Vector3 cameraTarget, Vector3 cameraUpVector)
+	Matrix Matrix::CreateLookAt(const Vector3& cameraPosition, const Vector3& cameraTarget, const Vector3& cameraUpVector)
 	{
 		Matrix result;
 		CreateLookAt(cameraPosition, cameraTarget, cameraUpVector, result);
 		return result;
 	}
 
-	void Matrix::CreateLookAt(Vector3 cameraPosition, Vector3 cameraTarget, Vector3 cameraUpVector, out Matrix& result)
+	void Matrix::CreateLookAt(const Vector3& cameraPosition, const Vector3& cameraTarget, const Vector3& cameraUpVector, out Matrix& result)
 	{
 		Vector3 xaxis, yaxis, zaxis;
 		Vector3::Subtract(cameraPosition, cameraTarget, zaxis);
@@ -471,7 +474,7 @@ namespace XFX
 	Matrix Matrix::CreatePerspective(float width, float height, float zNearPlane, float zFarPlane)
 	{
 		Matrix result;
-		CreatePerspective(width, height, zNearPlane, zFarPlane);
+		CreatePerspective(width, height, zNearPlane, zFarPlane, result);
 		return result;
 	}
 
@@ -485,7 +488,7 @@ namespace XFX
 	Matrix Matrix::CreatePerspectiveFieldOfView(float fieldOfView, float aspectRatio, float nearPlaneDistance, float farPlaneDistance)
 	{
 		Matrix result;
-		CreatePerspectiveFieldOfView(fieldOfView, aspectRatio, nearPlaneDistance, farPlaneDistance);
+		CreatePerspectiveFieldOfView(fieldOfView, aspectRatio, nearPlaneDistance, farPlaneDistance, result);
 		return result;
 	}
 
@@ -525,12 +528,13 @@ namespace XFX
 		result.M41 = result.M42 = result.M44 = 0.0f;
 	}
 	
-	void Matrix::CreateReflection(Plane value, out Matrix& result) 
+	void Matrix::CreateReflection(const Plane& value, out Matrix& result) 
 	{
-		value.Normalize();
-		float x = value.Normal.X;
-		float y = value.Normal.Y;
-		float z = value.Normal.Z;
+		Plane plane;
+		Plane::Normalize(value, plane);
+		float x = plane.Normal.X;
+		float y = plane.Normal.Y;
+		float z = plane.Normal.Z;
 		float x2 = -2.0f * x;
 		float y2 = -2.0f * y;
 		float z2 = -2.0f * z;
@@ -546,38 +550,16 @@ namespace XFX
 		result.M32 = y2 * z;
 		result.M33 = (z2 * z) + 1.0f;
 		result.M34 = 0.0f;
-		result.M41 = x2 * value.D;
-		result.M42 = y2 * value.D;
-		result.M43 = z2 * value.D;
+		result.M41 = x2 * plane.D;
+		result.M42 = y2 * plane.D;
+		result.M43 = z2 * plane.D;
 		result.M44 = 1.0f;
 	}
 
-	Matrix Matrix::CreateReflection(Plane value)
+	Matrix Matrix::CreateReflection(const Plane& value)
 	{
 		Matrix result;
-		value.Normalize();
-		float x = value.Normal.X;
-		float y = value.Normal.Y;
-		float z = value.Normal.Z;
-		float x2 = -2.0f * x;
-		float y2 = -2.0f * y;
-		float z2 = -2.0f * z;
-		result.M11 = (x2 * x) + 1.0f;
-		result.M12 = y2 * x;
-		result.M13 = z2 * x;
-		result.M14 = 0.0f;
-		result.M21 = x2 * y;
-		result.M22 = (y2 * y) + 1.0f;
-		result.M23 = z2 * y;
-		result.M24 = 0.0f;
-		result.M31 = x2 * z;
-		result.M32 = y2 * z;
-		result.M33 = (z2 * z) + 1.0f;
-		result.M34 = 0.0f;
-		result.M41 = x2 * value.D;
-		result.M42 = y2 * value.D;
-		result.M43 = z2 * value.D;
-		result.M44 = 1.0f;
+		CreateReflection(value, result);
 		return result;
 	}
 
@@ -726,7 +708,7 @@ namespace XFX
 		return result;
 	}
 
-	void Matrix::CreateScale(Vector3 scales, out Matrix& result)
+	void Matrix::CreateScale(const Vector3& scales, out Matrix& result)
 	{
 		float x = scales.X;
 		float y = scales.Y;
@@ -749,16 +731,17 @@ namespace XFX
 		result.M44 = 1.0f;
 	}
 
-	Matrix Matrix::CreateScale(Vector3 scales) 
+	Matrix Matrix::CreateScale(const Vector3& scales) 
 	{
 		Matrix result;
 		CreateScale(scales, result);
 		return result;
 	}
 
-	void Matrix::CreateShadow(Vector3 lightDirection, Plane plane, out Matrix& result)
+	void Matrix::CreateShadow(const Vector3& lightDirection, const Plane& value, out Matrix& result)
 	{
-		plane.Normalize();
+		Plane plane;
+		Plane::Normalize(value, plane);
 		float dot = ((plane.Normal.X * lightDirection.X) + (plane.Normal.Y * lightDirection.Y)) + (plane.Normal.Z * lightDirection.Z);
 		float x = -plane.Normal.X;
 		float y = -plane.Normal.Y;
@@ -782,7 +765,7 @@ namespace XFX
 		result.M44 = dot;
 	}
 
-	Matrix Matrix::CreateShadow(Vector3 lightDirection, Plane plane)
+	Matrix Matrix::CreateShadow(const Vector3& lightDirection, const Plane& plane)
 	{
 		Matrix result;
 		CreateShadow(lightDirection, plane, result);
@@ -816,7 +799,7 @@ namespace XFX
 		return result;
 	}
 
-	void Matrix::CreateTranslation(Vector3 position, out Matrix& result)
+	void Matrix::CreateTranslation(const Vector3& position, out Matrix& result)
 	{
 		result.M11 = 1.0f;
 		result.M12 = 0.0f;
@@ -836,23 +819,23 @@ namespace XFX
 		result.M44 = 1.0f;
 	}
 
-	Matrix Matrix::CreateTranslation(Vector3 position)
+	Matrix Matrix::CreateTranslation(const Vector3& position)
 	{
 		Matrix result;
 		CreateTranslation(position, result);
 		return result;
 	}
 
-	Matrix Matrix::CreateWorld(Vector3 position, Vector3 forward, Vector3 up)
+	Matrix Matrix::CreateWorld(const Vector3& position, const Vector3& forward, const Vector3& up)
 	{
 		Matrix ret;
 		CreateWorld(position, forward, up, out ret);
 		return ret;
 	}
 
-	void Matrix::CreateWorld(Vector3 position, Vector3 forward, Vector3 up, out Matrix& result)
+	void Matrix::CreateWorld(const Vector3& position, const Vector3& forward, const Vector3& up, out Matrix& result)
 	{
-		Vector3 vector = Vector3::Normalize(position - forward);
+		Vector3 vector = Vector3::Normalize(Vector3::Subtract(position, forward));
 		Vector3 vector2 = Vector3::Normalize(Vector3::Cross(up, vector));
 		Vector3 vector3 = Vector3::Cross(vector, vector2);
 		result.M11 = vector2.X;
@@ -878,6 +861,19 @@ namespace XFX
 		translation.X = M41;
 		translation.Y = M42;
 		translation.Z = M43;
+
+#if XFX_MATRIX_SSE
+		Matrix m1;
+
+		if (!MatrixKernels::Decompose(*this, scale, m1))
+		{
+			rotation = Quaternion::Identity;
+			return false;
+		}
+
+		rotation = Quaternion::CreateFromRotationMatrix(m1);
+		return true;
+#else
 		float xs, ys, zs;
 
 		if (Math::Sign(M11 * M12 * M13 * M14) < 0)
@@ -923,6 +919,7 @@ namespace XFX
 			0, 0, 0, 1);
 		rotation = Quaternion::CreateFromRotationMatrix(m1);
 		return true;
+#endif
 	}
 
 	float Matrix::Determinant()
@@ -939,20 +936,20 @@ namespace XFX
 			(M14 * (((M21 * temp3) - (M22 * temp5)) + (M23 * temp6))));
 	}
 
-	Matrix Matrix::Divide(Matrix matrix1, Matrix matrix2)
+	Matrix Matrix::Divide(const Matrix& matrix1, const Matrix& matrix2)
 	{
 		Matrix result;
 		Divide(matrix1, matrix2, result);
 		return result;
 	}
 
-	void Matrix::Divide(Matrix matrix1, Matrix matrix2, out Matrix& result)
+	void Matrix::Divide(const Matrix& matrix1, const Matrix& matrix2, out Matrix& result)
 	{
 		Matrix inverse = Matrix::Invert(matrix2);
 		Matrix::Multiply(matrix1, inverse, result);
 	}
 
-	void Matrix::Divide(Matrix matrix1, float divider, out Matrix& result)
+	void Matrix::Divide(const Matrix& matrix1, float divider, out Matrix& result)
 	{
 		float num = 1 / divider;
 		result.M11 = matrix1.M11 * num;
@@ -973,7 +970,7 @@ namespace XFX
 		result.M44 = matrix1.M44 * num;
 	}
 
-	Matrix Matrix::Divide(Matrix matrix1, float divider)
+	Matrix Matrix::Divide(const Matrix& matrix1, float divider)
 	{
 		Matrix result;
 		Divide(matrix1, divider, result);
@@ -1001,8 +998,11 @@ namespace XFX
 		return MatrixTypeInfo;
 	}
 
-	void Matrix::Invert(Matrix matrix, out Matrix& result)
+	void Matrix::Invert(const Matrix& matrix, out Matrix& result)
 	{
+#if XFX_MATRIX_SSE
+		MatrixKernels::Invert(matrix, result);
+#else
 		float num5 = matrix.M11;
 		float num4 = matrix.M12;
 		float num3 = matrix.M13;
@@ -1058,15 +1058,17 @@ namespace XFX
 		result.M24 = (((num5 * num29) - (num3 * num26)) + (num2 * num25)) * num;
 		result.M34 = -(((num5 * num28) - (num4 * num26)) + (num2 * num24)) * num;
 		result.M44 = (((num5 * num27) - (num4 * num25)) + (num3 * num24)) * num;
+#endif
 	}
 	
-	Matrix Matrix::Invert(Matrix matrix)
+	Matrix Matrix::Invert(const Matrix& matrix)
 	{
-		Invert(matrix, matrix);
-		return matrix;
+		Matrix result;
+		Invert(matrix, result);
+		return result;
 	}
 	
-	void Matrix::Lerp(Matrix matrix1, Matrix matrix2, float amount, out Matrix& result)
+	void Matrix::Lerp(const Matrix& matrix1, const Matrix& matrix2, float amount, out Matrix& result)
 	{
 		result.M11 = matrix1.M11 + ((matrix2.M11 - matrix1.M11) * amount);
 		result.M12 = matrix1.M12 + ((matrix2.M12 - matrix1.M12) * amount);
@@ -1086,22 +1088,25 @@ namespace XFX
 		result.M44 = matrix1.M44 + ((matrix2.M44 - matrix1.M44) * amount);
 	}
 	
-	Matrix Matrix::Lerp(Matrix value1, Matrix value2, float amount)
+	Matrix Matrix::Lerp(const Matrix& value1, const Matrix& value2, float amount)
 	{
 		Matrix result;
 		Lerp(value1, value2, amount, result);
 		return result;
 	}
 
-	Matrix Matrix::Multiply(Matrix matrix1, Matrix matrix2)
+	Matrix Matrix::Multiply(const Matrix& matrix1, const Matrix& matrix2)
 	{
 		Matrix result;
 		Multiply(matrix1, matrix2, result);
 		return result;
 	}
 	
-	void Matrix::Multiply(Matrix matrix1, Matrix matrix2, out Matrix& result)
+	void Matrix::Multiply(const Matrix& matrix1, const Matrix& matrix2, out Matrix& result)
 	{
+#if XFX_MATRIX_SSE
+		MatrixKernels::Multiply(matrix1, matrix2, result);
+#else
 		float num16 = (((matrix1.M11 * matrix2.M11) + (matrix1.M12 * matrix2.M21)) + (matrix1.M13 * matrix2.M31)) + (matrix1.M14 * matrix2.M41);
 		float num15 = (((matrix1.M11 * matrix2.M12) + (matrix1.M12 * matrix2.M22)) + (matrix1.M13 * matrix2.M32)) + (matrix1.M14 * matrix2.M42);
 		float num14 = (((matrix1.M11 * matrix2.M13) + (matrix1.M12 * matrix2.M23)) + (matrix1.M13 * matrix2.M33)) + (matrix1.M14 * matrix2.M43);
@@ -1134,16 +1139,17 @@ namespace XFX
 		result.M42 = num3;
 		result.M43 = num2;
 		result.M44 = num;
+#endif
 	}
 
-	Matrix Matrix::Multiply(Matrix matrix1, float scaleFactor)
+	Matrix Matrix::Multiply(const Matrix& matrix1, float scaleFactor)
 	{
 		Matrix result;
 		Multiply(matrix1, scaleFactor, result);
 		return result;
 	}
 
-	void Matrix::Multiply(Matrix matrix1, float scaleFactor, out Matrix& result)
+	void Matrix::Multiply(const Matrix& matrix1, float scaleFactor, out Matrix& result)
 	{
 		float num = scaleFactor;
 		result.M11 = matrix1.M11 * num;
@@ -1164,14 +1170,14 @@ namespace XFX
 		result.M44 = matrix1.M44 * num;
 	}
 
-	Matrix Matrix::Negate(Matrix matrix)
+	Matrix Matrix::Negate(const Matrix& matrix)
 	{
 		Matrix result;
 		Negate(matrix, result);
 		return result;
 	}
 
-	void Matrix::Negate(Matrix matrix, out Matrix& result)
+	void Matrix::Negate(const Matrix& matrix, out Matrix& result)
 	{
 		result.M11 = -matrix.M11;
 		result.M12 = -matrix.M12;
@@ -1191,14 +1197,14 @@ namespace XFX
 		result.M44 = -matrix.M44;
 	}
 
-	Matrix Matrix::Subtract(Matrix matrix1, Matrix matrix2)
+	Matrix Matrix::Subtract(const Matrix& matrix1, const Matrix& matrix2)
 	{
 		Matrix result;
 		Subtract(matrix1, matrix2, result);
 		return result;
 	}
 
-	void Matrix::Subtract(Matrix matrix1, Matrix matrix2, out Matrix& result)
+	void Matrix::Subtract(const Matrix& matrix1, const Matrix& matrix2, out Matrix& result)
 	{
 		result.M11 = matrix1.M11 - matrix2.M11;
 		result.M12 = matrix1.M12 - matrix2.M12;
@@ -1228,31 +1234,43 @@ namespace XFX
 			M31, M32, M33, M34, M41, M42, M43, M44);
 	}
 
-	Matrix Matrix::Transpose(Matrix matrix)
+	Matrix Matrix::Transpose(const Matrix& matrix)
 	{
 		Matrix ret;
 		Transpose(matrix, ret);
 		return ret;
 	}
 
-	void Matrix::Transpose(Matrix matrix, out Matrix& result)
+	void Matrix::Transpose(const Matrix& matrix, out Matrix& result)
 	{
+#if XFX_MATRIX_SSE
+		MatrixKernels::Transpose(matrix, result);
+#else
+		// matrix and result may be the same object, so read the mirrored elements before writing them
+		float m12 = matrix.M12;
+		float m13 = matrix.M13;
+		float m14 = matrix.M14;
+		float m23 = matrix.M23;
+		float m24 = matrix.M24;
+		float m34 = matrix.M34;
+
 		result.M11 = matrix.M11;
 		result.M12 = matrix.M21;
 		result.M13 = matrix.M31;
 		result.M14 = matrix.M41;
-		result.M21 = matrix.M12;
+		result.M21 = m12;
 		result.M22 = matrix.M22;
 		result.M23 = matrix.M32;
 		result.M24 = matrix.M42;
-		result.M31 = matrix.M13;
-		result.M32 = matrix.M23;
+		result.M31 = m13;
+		result.M32 = m23;
 		result.M33 = matrix.M33;
 		result.M34 = matrix.M43;
-		result.M41 = matrix.M14;
-		result.M42 = matrix.M24;
-		result.M43 = matrix.M34;
-		result.M44 = matrix.M44;  
+		result.M41 = m14;
+		result.M42 = m24;
+		result.M43 = m34;
+		result.M44 = matrix.M44;
+#endif
 	}
 
 	Matrix Matrix::operator+(const Matrix& other)
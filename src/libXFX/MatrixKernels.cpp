@@ -0,0 +1,223 @@
+// Copyright (C) XFX Team
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without 
+// modification, are permitted provided that the following conditions are met:
+// 
+//     * Redistributions of source code must retain the above copyright 
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright 
+//       notice, this list of conditions and the following disclaimer in the 
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the copyright holder nor the names of any 
+//       contributors may be used to endorse or promote products derived from 
+//       this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE 
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF 
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS 
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE 
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include <Matrix.h>
+#include <Vector3.h>
+#include "MatrixKernels.h"
+
+#if XFX_MATRIX_SSE
+#include <xmmintrin.h>
+
+namespace XFX
+{
+	// Swizzles shared by the cofactor expansion in Invert; lane order is listed from lane 0.
+#define SWIZZLE_2211(v) _mm_shuffle_ps((v), (v), _MM_SHUFFLE(1, 1, 2, 2))
+#define SWIZZLE_3332(v) _mm_shuffle_ps((v), (v), _MM_SHUFFLE(2, 3, 3, 3))
+#define SWIZZLE_1000(v) _mm_shuffle_ps((v), (v), _MM_SHUFFLE(0, 0, 0, 1))
+
+	/**
+	 * Computes one column of the adjugate from the 2x2 sub-determinants of rows p and q, expanded along row r.
+	 * Lane k holds ((a * x) - (b * y)) + (c * z), the expression Matrix::Invert uses for element k of that column.
+	 */
+	static inline __m128 Cofactors(const __m128 p, const __m128 q, const __m128 r, const __m128 sign)
+	{
+		__m128 p2211 = SWIZZLE_2211(p), p3332 = SWIZZLE_3332(p), p1000 = SWIZZLE_1000(p);
+		__m128 q2211 = SWIZZLE_2211(q), q3332 = SWIZZLE_3332(q), q1000 = SWIZZLE_1000(q);
+
+		__m128 x = _mm_sub_ps(_mm_mul_ps(p2211, q3332), _mm_mul_ps(p3332, q2211));
+		__m128 y = _mm_sub_ps(_mm_mul_ps(p1000, q3332), _mm_mul_ps(p3332, q1000));
+		__m128 z = _mm_sub_ps(_mm_mul_ps(p1000, q2211), _mm_mul_ps(p2211, q1000));
+
+		__m128 column = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(SWIZZLE_1000(r), x), _mm_mul_ps(SWIZZLE_2211(r), y)), _mm_mul_ps(SWIZZLE_3332(r), z));
+
+		return _mm_xor_ps(column, sign);
+	}
+
+	/**
+	 * Replaces lane 3 of v with zero.
+	 */
+	static inline __m128 ClearW(const __m128 v, const __m128 zero)
+	{
+		return _mm_shuffle_ps(v, _mm_unpackhi_ps(v, zero), _MM_SHUFFLE(1, 0, 1, 0));
+	}
+
+	bool MatrixKernels::Decompose(const Matrix& matrix, out Vector3& scale, out Matrix& rotation)
+	{
+		__m128 row1 = _mm_loadu_ps(&matrix.M11);
+		__m128 row2 = _mm_loadu_ps(&matrix.M21);
+		__m128 row3 = _mm_loadu_ps(&matrix.M31);
+		__m128 row4 = _mm_loadu_ps(&matrix.M41);
+		__m128 c1 = row1, c2 = row2, c3 = row3, c4 = row4;
+		_MM_TRANSPOSE4_PS(c1, c2, c3, c4);
+
+		const __m128 zero = _mm_setzero_ps();
+		const __m128 signBit = _mm_set1_ps(-0.0f);
+
+		// lane i holds the values of row i: the sign of M_i1 * M_i2 * M_i3 * M_i4 and the length of the row's first three elements
+		__m128 negative = _mm_cmplt_ps(_mm_mul_ps(_mm_mul_ps(_mm_mul_ps(c1, c2), c3), c4), zero);
+		__m128 length = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(c1, c1), _mm_mul_ps(c2, c2)), _mm_mul_ps(c3, c3)));
+		__m128 scales = _mm_xor_ps(length, _mm_and_ps(negative, signBit));
+
+		float s[4] ALIGNED16;
+		_mm_store_ps(s, scales);
+		scale.X = s[0];
+		scale.Y = s[1];
+		scale.Z = s[2];
+
+		if (_mm_movemask_ps(_mm_cmpeq_ps(scales, zero)) & 7)
+		{
+			return false;
+		}
+
+		_mm_storeu_ps(&rotation.M11, ClearW(_mm_div_ps(row1, _mm_shuffle_ps(scales, scales, _MM_SHUFFLE(0, 0, 0, 0))), zero));
+		_mm_storeu_ps(&rotation.M21, ClearW(_mm_div_ps(row2, _mm_shuffle_ps(scales, scales, _MM_SHUFFLE(1, 1, 1, 1))), zero));
+		_mm_storeu_ps(&rotation.M31, ClearW(_mm_div_ps(row3, _mm_shuffle_ps(scales, scales, _MM_SHUFFLE(2, 2, 2, 2))), zero));
+		_mm_storeu_ps(&rotation.M41, _mm_set_ps(1.0f, 0.0f, 0.0f, 0.0f));
+		return true;
+	}
+
+	void MatrixKernels::Invert(const Matrix& matrix, out Matrix& result)
+	{
+		__m128 row1 = _mm_loadu_ps(&matrix.M11);
+		__m128 row2 = _mm_loadu_ps(&matrix.M21);
+		__m128 row3 = _mm_loadu_ps(&matrix.M31);
+		__m128 row4 = _mm_loadu_ps(&matrix.M41);
+
+		const __m128 even = _mm_set_ps(-0.0f, 0.0f, -0.0f, 0.0f); // negates lanes 1 and 3
+		const __m128 odd = _mm_set_ps(0.0f, -0.0f, 0.0f, -0.0f); // negates lanes 0 and 2
+
+		__m128 column1 = Cofactors(row3, row4, row2, even);
+		__m128 column2 = Cofactors(row3, row4, row1, odd);
+		__m128 column3 = Cofactors(row2, row4, row1, even);
+		__m128 column4 = Cofactors(row2, row3, row1, odd);
+
+		// the determinant is summed in the same order as the scalar code
+		float c[4] ALIGNED16;
+		_mm_store_ps(c, column1);
+		float num = 1.0f / ((((matrix.M11 * c[0]) + (matrix.M12 * c[1])) + (matrix.M13 * c[2])) + (matrix.M14 * c[3]));
+		__m128 determinant = _mm_set1_ps(num);
+
+		column1 = _mm_mul_ps(column1, determinant);
+		column2 = _mm_mul_ps(column2, determinant);
+		column3 = _mm_mul_ps(column3, determinant);
+		column4 = _mm_mul_ps(column4, determinant);
+		_MM_TRANSPOSE4_PS(column1, column2, column3, column4);
+
+		_mm_storeu_ps(&result.M11, column1);
+		_mm_storeu_ps(&result.M21, column2);
+		_mm_storeu_ps(&result.M31, column3);
+		_mm_storeu_ps(&result.M41, column4);
+	}
+
+	void MatrixKernels::Multiply(const Matrix& matrix1, const Matrix& matrix2, out Matrix& result)
+	{
+		__m128 b1 = _mm_loadu_ps(&matrix2.M11);
+		__m128 b2 = _mm_loadu_ps(&matrix2.M21);
+		__m128 b3 = _mm_loadu_ps(&matrix2.M31);
+		__m128 b4 = _mm_loadu_ps(&matrix2.M41);
+		const float* a = &matrix1.M11;
+		__m128 rows[4];
+
+		for (int i = 0; i < 4; i++)
+		{
+			const float* row = a + (i * 4);
+			rows[i] = _mm_add_ps(_mm_add_ps(_mm_add_ps(
+				_mm_mul_ps(_mm_set1_ps(row[0]), b1),
+				_mm_mul_ps(_mm_set1_ps(row[1]), b2)),
+				_mm_mul_ps(_mm_set1_ps(row[2]), b3)),
+				_mm_mul_ps(_mm_set1_ps(row[3]), b4));
+		}
+
+		_mm_storeu_ps(&result.M11, rows[0]);
+		_mm_storeu_ps(&result.M21, rows[1]);
+		_mm_storeu_ps(&result.M31, rows[2]);
+		_mm_storeu_ps(&result.M41, rows[3]);
+	}
+
+	void MatrixKernels::MultiplyHierarchy(const Matrix local[], const int parents[], const int bones[], const int count, Matrix absolute[])
+	{
+		__m128 b1 = _mm_setzero_ps(), b2 = b1, b3 = b1, b4 = b1;
+		int loadedParent = -1;
+
+		for (int i = 0; i < count; i++)
+		{
+			const int bone = bones[i];
+			const int parent = parents[bone];
+			const float* a = &local[bone].M11;
+			float* r = &absolute[bone].M11;
+
+			if (parent < 0)
+			{
+				_mm_storeu_ps(r, _mm_loadu_ps(a));
+				_mm_storeu_ps(r + 4, _mm_loadu_ps(a + 4));
+				_mm_storeu_ps(r + 8, _mm_loadu_ps(a + 8));
+				_mm_storeu_ps(r + 12, _mm_loadu_ps(a + 12));
+				continue;
+			}
+
+			// A parent is final once it has been computed, so its rows can be reused for all of its children.
+			if (parent != loadedParent)
+			{
+				const float* p = &absolute[parent].M11;
+				b1 = _mm_loadu_ps(p);
+				b2 = _mm_loadu_ps(p + 4);
+				b3 = _mm_loadu_ps(p + 8);
+				b4 = _mm_loadu_ps(p + 12);
+				loadedParent = parent;
+			}
+
+			for (int j = 0; j < 4; j++)
+			{
+				const float* row = a + (j * 4);
+				_mm_storeu_ps(r + (j * 4), _mm_add_ps(_mm_add_ps(_mm_add_ps(
+					_mm_mul_ps(_mm_set1_ps(row[0]), b1),
+					_mm_mul_ps(_mm_set1_ps(row[1]), b2)),
+					_mm_mul_ps(_mm_set1_ps(row[2]), b3)),
+					_mm_mul_ps(_mm_set1_ps(row[3]), b4)));
+			}
+		}
+	}
+
+	void MatrixKernels::Transpose(const Matrix& matrix, out Matrix& result)
+	{
+		__m128 row1 = _mm_loadu_ps(&matrix.M11);
+		__m128 row2 = _mm_loadu_ps(&matrix.M21);
+		__m128 row3 = _mm_loadu_ps(&matrix.M31);
+		__m128 row4 = _mm_loadu_ps(&matrix.M41);
+		_MM_TRANSPOSE4_PS(row1, row2, row3, row4);
+
+		_mm_storeu_ps(&result.M11, row1);
+		_mm_storeu_ps(&result.M21, row2);
+		_mm_storeu_ps(&result.M31, row3);
+		_mm_storeu_ps(&result.M41, row4);
+	}
+
+#undef SWIZZLE_2211
+#undef SWIZZLE_3332
+#undef SWIZZLE_1000
+}
+#endif
@@ -0,0 +1,55 @@
+/*****************************************************************************
+ *	MatrixKernels.h															 *
+ *																			 *
+ *	XFX::MatrixKernels class definition file								 *
+ *	Copyright (c) XFX Team. All Rights Reserved 							 *
+ *****************************************************************************/
+#ifndef _XFX_MATRIXKERNELS_
+#define _XFX_MATRIXKERNELS_
+
+#include <System/Types.h>
+
+/**
+ * The SSE matrix kernels are only used when the library is compiled with SSE enabled (-msse) and with the aligned Matrix layout (-DXFX_ALIGNED_MATRIX).
+ */
+#if __SSE__ && XFX_ALIGNED_MATRIX
+#define XFX_MATRIX_SSE 1
+#endif
+
+namespace XFX
+{
+	struct Matrix;
+	struct Vector3;
+
+	/**
+	 * SSE implementations of the Matrix operations that dominate bone hierarchy and view-projection updates.
+	 *
+	 * Every kernel evaluates the same expressions in the same order as the scalar code in Matrix.cpp, so both paths produce bit-identical results.
+	 * All kernels may be called with result aliasing one of the arguments.
+	 * Matrices are read and written with unaligned accesses, so a misaligned Matrix does not fault inside a kernel.
+	 */
+	class MatrixKernels
+	{
+	private:
+		MatrixKernels(); // Private constructor to prevent instantiation.
+
+	public:
+		/**
+		 * Computes scale and the unscaled 3x3 rotation of matrix, as used by Matrix::Decompose.
+		 *
+		 * @return
+		 *		false if a scale component is zero, in which case rotation is left untouched.
+		 */
+		static bool Decompose(const Matrix& matrix, out Vector3& scale, out Matrix& rotation);
+		static void Invert(const Matrix& matrix, out Matrix& result);
+		static void Multiply(const Matrix& matrix1, const Matrix& matrix2, out Matrix& result);
+		/**
+		 * Computes absolute[bone] = local[bone] * absolute[parents[bone]] for each bone listed in bones, in order, and copies the local transform of bones whose parent is -1.
+		 * bones must list every parent before its children. The rows of a parent stay in registers across consecutive siblings.
+		 */
+		static void MultiplyHierarchy(const Matrix local[], const int parents[], const int bones[], const int count, Matrix absolute[]);
+		static void Transpose(const Matrix& matrix, out Matrix& result);
+	};
+}
+
+#endif //_XFX_MATRIXKERNELS_
@@ -26,11 +26,20 @@
 // POSSIBILITY OF SUCH DAMAGE.
 
 #include <Graphics/Model.h>
+#include <Matrix.h>
+#include "MatrixKernels.h"
+
+#include <sassert.h>
 
 namespace XFX
 {
 	namespace Graphics
 	{
+		Model::Model()
+			: dirtyBoneCount(0), Tag(null)
+		{
+		}
+
 		ModelBoneCollection Model::getBones()
 		{
 			return ModelBoneCollection(&bones);
@@ -43,61 +52,170 @@ namespace XFX
 
 		ModelBone Model::getRoot()
 		{
-			// TODO: implement
+			sassert(bones.Count() > 0, "");
+
+			return bones[boneOrder[0]];
 		}
 
-		void Model::CopyAbsoluteBoneTransformsTo(Matrix destinationBoneTransforms[])
+		void Model::InitializeBones()
 		{
-			sassert(destinationBoneTransforms != null, FrameworkResources::ArgumentNull_Generic);
-
-			int count = bones.Count;
-			for (int index1 = 0; index1 < count; ++index1)
+			const int count = bones.Count();
+			List<int> depths(count);
+			int maxDepth = 0;
+
+			absoluteBoneTransforms.Clear();
+			boneOrder.Clear();
+			dirtyBones.Clear();
+			bonesToUpdate.Clear();
+			bonesToUpdate.setCapacity(count);
+
+			// Every bone starts out dirty so that the first update computes the whole hierarchy.
+			for (int i = 0; i < count; i++)
 			{
-				ModelBone modelBone = bones[index1];
-				if (modelBone.getParent() == null)
+				int depth = 0;
+
+				for (int parent = boneParents[i]; parent >= 0 && depth <= count; parent = boneParents[parent])
 				{
-					destinationBoneTransforms[index1] = modelBone.Transform;
+					depth++;
 				}
-				else
+
+				sassert(depth <= count, "The bone hierarchy contains a cycle.");
+
+				depths.Add(depth);
+				maxDepth = (depth > maxDepth) ? depth : maxDepth;
+				absoluteBoneTransforms.Add(boneTransforms[i]);
+				dirtyBones.Add(1);
+			}
+
+			dirtyBoneCount = count;
+
+			// Order the bones by depth, keeping bone order within a depth so siblings stay next to each other.
+			boneOrder.setCapacity(count);
+
+			for (int depth = 0; depth <= maxDepth; depth++)
+			{
+				for (int i = 0; i < count; i++)
 				{
-					int index2 = modelBone.getParent()->getIndex();
-					Matrix::Multiply(modelBone.Transform, destinationBoneTransforms[index2], out destinationBoneTransforms[index1]);
+					if (depths[i] == depth)
+					{
+						boneOrder.Add(i);
+					}
 				}
 			}
+		}
 
+		void Model::SetBoneTransform(const int index, const Matrix& transform)
+		{
+			boneTransforms[index] = transform;
+
+			if (!dirtyBones[index])
+			{
+				dirtyBones[index] = 1;
+				dirtyBoneCount++;
+			}
 		}
 
-		void Model::CopyBoneTransformsFrom(Matrix sourceBoneTransforms[])
+		void Model::UpdateAbsoluteBoneTransforms()
 		{
-			sassert(sourceBoneTransforms != null, FrameworkResources::ArgumentNull_Generic);
+			if (dirtyBoneCount == 0)
+			{
+				return;
+			}
+
+			const int count = boneOrder.Count();
+
+			// Collect the dirty bones and everything below them, pushing the flag down as we go.
+			bonesToUpdate.Clear();
+
+			for (int i = 0; i < count; i++)
+			{
+				const int bone = boneOrder[i];
+				const int parent = boneParents[bone];
+
+				if (dirtyBones[bone] || (parent >= 0 && dirtyBones[parent]))
+				{
+					dirtyBones[bone] = 1;
+					bonesToUpdate.Add(bone);
+				}
+			}
+
+			const int updateCount = bonesToUpdate.Count();
 
-			// TODO: implement
+#if XFX_MATRIX_SSE
+			MatrixKernels::MultiplyHierarchy(&boneTransforms[0], &boneParents[0], &bonesToUpdate[0], updateCount, &absoluteBoneTransforms[0]);
+#else
+			for (int i = 0; i < updateCount; i++)
+			{
+				const int bone = bonesToUpdate[i];
+				const int parent = boneParents[bone];
+
+				if (parent < 0)
+				{
+					absoluteBoneTransforms[bone] = boneTransforms[bone];
+				}
+				else
+				{
+					Matrix::Multiply(boneTransforms[bone], absoluteBoneTransforms[parent], out absoluteBoneTransforms[bone]);
+				}
+			}
+#endif
+
+			for (int i = 0; i < updateCount; i++)
+			{
+				dirtyBones[bonesToUpdate[i]] = 0;
+			}
+
+			dirtyBoneCount = 0;
 		}
 
-		void Model::CopyBoneTransformsTo(Matrix destinationBoneTransforms[])
+		void Model::CopyAbsoluteBoneTransformsTo(Matrix destinationBoneTransforms[])
 		{
 			sassert(destinationBoneTransforms != null, FrameworkResources::ArgumentNull_Generic);
 
-			// TODO: implement
+			if (destinationBoneTransforms == null)
+			{
+				return;
+			}
+
+			UpdateAbsoluteBoneTransforms();
+			absoluteBoneTransforms.CopyTo(destinationBoneTransforms, 0);
 		}
 
-		void Model::Draw(Matrix world, Matrix view, Matrix projection)
+		void Model::CopyBoneTransformsFrom(Matrix sourceBoneTransforms[])
 		{
-			int boneCount = bones.Count;
+			sassert(sourceBoneTransforms != null, FrameworkResources::ArgumentNull_Generic);
 
-			if (sharedDrawBoneMatrices == null || sharedDrawBoneMatrixCount < boneCount)
+			if (sourceBoneTransforms == null)
 			{
-				if (sharedDrawBoneMatrices != null)
+				return;
+			}
+
+			// Bones that are handed back unchanged stay clean, so only the animated subtrees get recomputed.
+			for (int i = 0; i < boneTransforms.Count(); i++)
+			{
+				if (boneTransforms[i] != sourceBoneTransforms[i])
 				{
-					delete sharedDrawBoneMatrices;
+					SetBoneTransform(i, sourceBoneTransforms[i]);
 				}
+			}
+		}
 
-				sharedDrawBoneMatrices = new Matrix[boneCount];
-				sharedDrawBoneMatrixCount = boneCount;
+		void Model::CopyBoneTransformsTo(Matrix destinationBoneTransforms[])
+		{
+			sassert(destinationBoneTransforms != null, FrameworkResources::ArgumentNull_Generic);
+
+			if (destinationBoneTransforms == null)
+			{
+				return;
 			}
 
-			// Look up combined bone matrices for the entire model.
-			CopyAbsoluteBoneTransformsTo(sharedDrawBoneMatrices);
+			boneTransforms.CopyTo(destinationBoneTransforms, 0);
+		}
+
+		void Model::Draw(Matrix world, Matrix view, Matrix projection)
+		{
+			// Bring the combined bone matrices for the entire model up to date.
+			UpdateAbsoluteBoneTransforms();
 
 			for (int i = 0; i < meshes.Count(); i++)
 			{
@@ -0,0 +1,77 @@
+// Copyright (C) XFX Team
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without 
+// modification, are permitted provided that the following conditions are met:
+// 
+//* Redistributions of source code must retain the above copyright 
+//notice, this list of conditions and the following disclaimer.
+//* Redistributions in binary form must reproduce the above copyright 
+//notice, this list of conditions and the following disclaimer in the 
+//documentation and/or other materials provided with the distribution.
+//* Neither the name of the copyright holder nor the names of any 
+//contributors may be used to endorse or promote products derived from 
+//this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE 
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF 
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS 
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE 
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include <Graphics/Model.h>
+#include <Graphics/ModelBone.h>
+
+namespace XFX
+{
+	namespace Graphics
+	{
+		ModelBone::ModelBone()
+			: index(-1), model(null)
+		{
+		}
+
+		int ModelBone::getIndex() const
+		{
+			return index;
+		}
+
+		const String ModelBone::getName() const
+		{
+			return name;
+		}
+
+		ModelBone* ModelBone::getParent() const
+		{
+			const int parent = model->boneParents[index];
+
+			return (parent >= 0) ? &model->bones[parent] : null;
+		}
+
+		Matrix ModelBone::getTransform() const
+		{
+			return model->boneTransforms[index];
+		}
+
+		void ModelBone::setTransform(const Matrix& value)
+		{
+			model->SetBoneTransform(index, value);
+		}
+
+		bool ModelBone::operator!=(const ModelBone& other) const
+		{
+			return !(*this == other);
+		}
+
+		bool ModelBone::operator==(const ModelBone& other) const
+		{
+			return ((index == other.index) && (model == other.model) && (name == other.name));
+		}
+	}
+}
@@ -0,0 +1,180 @@
+// Copyright (C) XFX Team
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without 
+// modification, are permitted provided that the following conditions are met:
+// 
+//* Redistributions of source code must retain the above copyright 
+//notice, this list of conditions and the following disclaimer.
+//* Redistributions in binary form must reproduce the above copyright 
+//notice, this list of conditions and the following disclaimer in the 
+//documentation and/or other materials provided with the distribution.
+//* Neither the name of the copyright holder nor the names of any 
+//contributors may be used to endorse or promote products derived from 
+//this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE 
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF 
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS 
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE 
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include <Graphics/GraphicsDevice.h>
+#include <Graphics/Model.h>
+#include <Graphics/ModelInstanceBatch.h>
+#include <Matrix.h>
+#include <System/FrameworkResources.h>
+#include <System/String.h>
+#include <System/Type.h>
+
+#include <sassert.h>
+
+namespace XFX
+{
+	namespace Graphics
+	{
+		const Type ModelInstanceBatchTypeInfo("ModelInstanceBatch", "XFX::Graphics::ModelInstanceBatch", TypeCode::Object);
+
+		// Selects the radix sort key of an instance run when grouping by effect.
+		struct EffectKeySelector
+		{
+			template <typename T>
+			inline uint operator()(const T& run) const { return (uint)(size_t)run.Effect; }
+		};
+
+		// Selects the radix sort key of an instance run when grouping by mesh part.
+		struct PartKeySelector
+		{
+			template <typename T>
+			inline uint operator()(const T& run) const { return (uint)(size_t)run.Part; }
+		};
+
+		ModelInstanceBatch::ModelInstanceBatch(GraphicsDevice * const graphicsDevice)
+			: inBeginEndPair(false), view(Matrix::Identity), projection(Matrix::Identity)
+		{
+			sassert(graphicsDevice != null, String::Format("graphicsDevice; %s", FrameworkResources::ArgumentNull_Generic));
+
+			this->graphicsDevice = graphicsDevice;
+		}
+
+		void ModelInstanceBatch::Begin(const Matrix& view, const Matrix& projection)
+		{
+			sassert(!inBeginEndPair, "Begin cannot be called again until End has been successfully called.");
+
+			this->view = view;
+			this->projection = projection;
+
+			inBeginEndPair = true;
+		}
+
+		void ModelInstanceBatch::Draw(Model * const model, Matrix const worlds[], const int count)
+		{
+			sassert(inBeginEndPair, "Begin must be called successfully before Draw can be called.");
+			sassert(model != null, String::Format("model; %s", FrameworkResources::ArgumentNull_Generic));
+			sassert(worlds != null, String::Format("worlds; %s", FrameworkResources::ArgumentNull_Generic));
+
+			if (model == null || worlds == null || count <= 0)
+			{
+				return;
+			}
+
+			// Bring the combined bone matrices for the entire model up to date.
+			model->UpdateAbsoluteBoneTransforms();
+
+			for (int i = 0; i < model->meshes.Count(); i++)
+			{
+				ModelMesh& mesh = model->meshes[i];
+				// Read in place: List keeps its matrices aligned for Matrix::Multiply.
+				const Matrix& bone = (mesh.parentBone >= 0) ? model->absoluteBoneTransforms[mesh.parentBone] : Matrix::Identity;
+				const int firstWorld = instanceWorlds.Count();
+
+				for (int j = 0; j < count; j++)
+				{
+					Matrix world;
+
+					Matrix::Multiply(bone, worlds[j], out world);
+					instanceWorlds.Add(world);
+				}
+
+				for (int j = 0; j < mesh.meshParts.Count(); j++)
+				{
+					ModelMeshPart& part = mesh.meshParts[j];
+
+					if (part.Effect == null || part.primitiveCount <= 0)
+					{
+						continue;
+					}
+
+					InstanceRun run = { &part, part.Effect, firstWorld, count };
+
+					runs.Add(run);
+				}
+			}
+		}
+
+		void ModelInstanceBatch::End()
+		{
+			sassert(inBeginEndPair, "Begin must be called successfully before End can be called.");
+
+			// Both passes are stable, so the runs end up ordered by effect, and by mesh part within each effect.
+			// Runs are sorted rather than instances: each one stands for every copy of a part queued by a single Draw call.
+			runs.RadixSort(PartKeySelector());
+			runs.RadixSort(EffectKeySelector());
+
+			const int runCount = runs.Count();
+			int i = 0;
+
+			while (i < runCount)
+			{
+				Effect* effect = runs[i].Effect;
+				bool applied = false;
+
+				while (i < runCount && runs[i].Effect == effect)
+				{
+					ModelMeshPart* part = runs[i].Part;
+
+					graphicsDevice->SetVertexBuffer(part->vertexBuffer, part->vertexOffset);
+					graphicsDevice->setIndices(part->indexBuffer);
+
+					for (; i < runCount && runs[i].Part == part; i++)
+					{
+						const int lastWorld = runs[i].FirstWorld + runs[i].Count;
+
+						for (int j = runs[i].FirstWorld; j < lastWorld; j++)
+						{
+							// The first instance applies the whole effect; the rest only change its world matrix.
+							if (applied)
+							{
+								effect->OnApplyWorld(instanceWorlds[j]);
+							}
+							else
+							{
+								effect->SetMatrices(instanceWorlds[j], view, projection);
+								effect->OnApply();
+								applied = true;
+							}
+
+							graphicsDevice->DrawIndexedPrimitives(PrimitiveType::TriangleList, 0, 0, part->numVertices, part->startIndex, part->primitiveCount);
+						}
+					}
+				}
+			}
+
+			runs.Clear();
+			instanceWorlds.Clear();
+
+			inBeginEndPair = false;
+		}
+
+		const Type& ModelInstanceBatch::GetType()
+		{
+			return ModelInstanceBatchTypeInfo;
+		}
+	}
+}
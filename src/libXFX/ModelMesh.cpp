@@ -0,0 +1,72 @@
+// Copyright (C) XFX Team
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without 
+// modification, are permitted provided that the following conditions are met:
+// 
+//* Redistributions of source code must retain the above copyright 
+//notice, this list of conditions and the following disclaimer.
+//* Redistributions in binary form must reproduce the above copyright 
+//notice, this list of conditions and the following disclaimer in the 
+//documentation and/or other materials provided with the distribution.
+//* Neither the name of the copyright holder nor the names of any 
+//contributors may be used to endorse or promote products derived from 
+//this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE 
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF 
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS 
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE 
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include <Graphics/GraphicsDevice.h>
+#include <Graphics/ModelMesh.h>
+
+namespace XFX
+{
+	namespace Graphics
+	{
+		void ModelMesh::Draw()
+		{
+			for (int i = 0; i < meshParts.Count(); i++)
+			{
+				ModelMeshPart& part = meshParts[i];
+				GraphicsDevice* graphicsDevice = part.getVertexBuffer()->getGraphicsDevice();
+
+				graphicsDevice->SetVertexBuffer(part.getVertexBuffer(), part.getVertexOffset());
+				graphicsDevice->setIndices(part.getIndexBuffer());
+				part.Effect->OnApply();
+				graphicsDevice->DrawIndexedPrimitives(PrimitiveType::TriangleList, 0, 0, part.getNumVertices(), part.getStartIndex(), part.getPrimitiveCount());
+			}
+		}
+
+		bool ModelMesh::operator!=(const ModelMesh& other) const
+		{
+			return !(*this == other);
+		}
+
+		bool ModelMesh::operator==(const ModelMesh& other) const
+		{
+			if ((parentBone != other.parentBone) || (Tag != other.Tag) || (meshParts.Count() != other.meshParts.Count()))
+			{
+				return false;
+			}
+
+			for (int i = 0; i < meshParts.Count(); i++)
+			{
+				if (meshParts[i] != other.meshParts[i])
+				{
+					return false;
+				}
+			}
+
+			return true;
+		}
+	}
+}
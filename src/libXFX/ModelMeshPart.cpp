@@ -0,0 +1,75 @@
+// Copyright (C) XFX Team
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without 
+// modification, are permitted provided that the following conditions are met:
+// 
+//* Redistributions of source code must retain the above copyright 
+//notice, this list of conditions and the following disclaimer.
+//* Redistributions in binary form must reproduce the above copyright 
+//notice, this list of conditions and the following disclaimer in the 
+//documentation and/or other materials provided with the distribution.
+//* Neither the name of the copyright holder nor the names of any 
+//contributors may be used to endorse or promote products derived from 
+//this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE 
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF 
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS 
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE 
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include <Graphics/ModelMeshPart.h>
+
+namespace XFX
+{
+	namespace Graphics
+	{
+		IndexBuffer* ModelMeshPart::getIndexBuffer()
+		{
+			return indexBuffer;
+		}
+
+		int ModelMeshPart::getNumVertices()
+		{
+			return numVertices;
+		}
+
+		int ModelMeshPart::getPrimitiveCount()
+		{
+			return primitiveCount;
+		}
+
+		int ModelMeshPart::getStartIndex()
+		{
+			return startIndex;
+		}
+
+		VertexBuffer* ModelMeshPart::getVertexBuffer()
+		{
+			return vertexBuffer;
+		}
+
+		int ModelMeshPart::getVertexOffset()
+		{
+			return vertexOffset;
+		}
+
+		bool ModelMeshPart::operator!=(const ModelMeshPart& other) const
+		{
+			return !(*this == other);
+		}
+
+		bool ModelMeshPart::operator==(const ModelMeshPart& other) const
+		{
+			return ((indexBuffer == other.indexBuffer) && (vertexBuffer == other.vertexBuffer) && (numVertices == other.numVertices) &&
+				(primitiveCount == other.primitiveCount) && (startIndex == other.startIndex) && (vertexOffset == other.vertexOffset) && (Effect == other.Effect));
+		}
+	}
+}
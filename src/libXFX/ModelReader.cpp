@@ -31,6 +31,8 @@
 
 #include <System/Diagnostics/Debug.h>
 
+#include <sassert.h>
+
 using namespace System::Diagnostics;
 
 namespace XFX
@@ -43,13 +45,16 @@ namespace XFX
 
 			if (existingInstance == NULL)
 			{
-				
+				model = new Model();
 			}
 			else
 			{
 				model = existingInstance;
 
-				// TODO: clean up the old model data
+				model->bones.Clear();
+				model->boneParents.Clear();
+				model->boneTransforms.Clear();
+				model->meshes.Clear();
 			}
 
 			uint boneCount = reader->ReadUInt32();
@@ -58,14 +63,16 @@ namespace XFX
 			{
 				ModelBone bone;
 
-				bone.Transform = reader->ReadMatrix();
+				bone.index = i;
+				bone.model = model;
 
 				model->bones.Add(bone);
+				model->boneTransforms.Add(reader->ReadMatrix());
 			}
 
 			for (uint i = 0; i < boneCount; i++)
 			{
-				ReadBoneReference(reader, boneCount);
+				model->boneParents.Add(ReadBoneReference(reader, boneCount));
 
 				// Read the child bone references.
 				uint childCount = reader->ReadUInt32();
@@ -86,9 +93,13 @@ namespace XFX
 			{
 
 			}
+
+			model->InitializeBones();
+
+			return model;
 		}
 
-		void ModelReader::ReadBoneReference(ContentReader * const reader, uint boneCount)
+		int ModelReader::ReadBoneReference(ContentReader * const reader, uint boneCount)
 		{
 			uint boneId;
 
@@ -101,6 +112,11 @@ namespace XFX
 			{
 				boneId = reader->ReadUInt32();
 			}
+
+			// Bone references are stored as the index plus one, with zero meaning no bone.
+			sassert(boneId <= boneCount, "Invalid bone reference.");
+
+			return (boneId != 0 && boneId <= boneCount) ? (int)boneId - 1 : -1;
 		}
 	}
 }
@@ -19,7 +19,7 @@ namespace XFX
 		class ModelReader : public ContentTypeReader<Model>
 		{
 		private:
-			void ReadBoneReference(ContentReader * const input, uint boneCount);
+			int ReadBoneReference(ContentReader * const input, uint boneCount);
 
 		public:
 			Model* Read(ContentReader * const input, Model* existingInstance);
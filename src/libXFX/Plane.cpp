@@ -47,12 +47,12 @@ namespace XFX
 	{
 	}
 
-	Plane::Plane(const Vector3 normal, const float d)
+	Plane::Plane(const Vector3& normal, const float d)
 		: D(d), Normal(normal)
 	{
 	}
 
-	Plane::Plane(const Vector3 point1, const Vector3 point2, const Vector3 point3)
+	Plane::Plane(const Vector3& point1, const Vector3& point2, const Vector3& point3)
 	{
 		float x1 = point2.X - point1.X;
 		float y1 = point2.Y - point1.Y;
@@ -71,7 +71,7 @@ namespace XFX
 		D = -((Normal.X * point1.X) + (Normal.Y * point1.Y) + (Normal.Z * point1.Z));
 	}
 
-	Plane::Plane(const Vector4 value)
+	Plane::Plane(const Vector4& value)
 		: D(value.W), Normal(value.X, value.Y, value.Z)
 	{
 	}
@@ -86,32 +86,32 @@ namespace XFX
 	{
 	}
 
-	float Plane::Dot(const Vector4 value) const
+	float Plane::Dot(const Vector4& value) const
 	{
 		return (Normal.X * value.X) + (Normal.Y * value.Y) + (Normal.Z * value.Z) + (D * value.W);
 	}
 
-	void Plane::Dot(const Vector4 value, out float& result) const
+	void Plane::Dot(const Vector4& value, out float& result) const
 	{
 		result = (Normal.X * value.X) + (Normal.Y * value.Y) + (Normal.Z * value.Z) + (D * value.W);
 	}
 
-	float Plane::DotCoordinate(const Vector3 value) const
+	float Plane::DotCoordinate(const Vector3& value) const
 	{
 		return (Normal.X * value.X) + (Normal.Y * value.Y) + (Normal.Z * value.Z) + D;
 	}
 
-	void Plane::DotCoordinate(const Vector3 value, out float& result) const
+	void Plane::DotCoordinate(const Vector3& value, out float& result) const
 	{
 		result = (Normal.X * value.X) + (Normal.Y * value.Y) + (Normal.Z * value.Z) + D;
 	}
 
-	float Plane::DotNormal(const Vector3 value) const
+	float Plane::DotNormal(const Vector3& value) const
 	{
 		return (Normal.X * value.X) + (Normal.Y * value.Y) + (Normal.Z * value.Z); 
 	}
 
-	void Plane::DotNormal(const Vector3 value, out float& result) const
+	void Plane::DotNormal(const Vector3& value, out float& result) const
 	{
 		result = (Normal.X * value.X) + (Normal.Y * value.Y) + (Normal.Z * value.Z); 
 	}
@@ -136,14 +136,14 @@ namespace XFX
 		return PlaneTypeInfo;
 	}
 
-	PlaneIntersectionType_t Plane::Intersects(const BoundingBox boundingbox) const
+	PlaneIntersectionType_t Plane::Intersects(const BoundingBox& boundingbox) const
 	{
 		PlaneIntersectionType_t result;
 		Intersects(boundingbox, result);
 		return result;
 	}
 
-	void Plane::Intersects(const BoundingBox boundingbox, out PlaneIntersectionType_t& result) const
+	void Plane::Intersects(const BoundingBox& boundingbox, out PlaneIntersectionType_t& result) const
 	{
 		Vector3 min;
 		Vector3 max;
@@ -159,6 +159,7 @@ namespace XFX
 		if(dot + D > 0.0f)
 		{
 			result = PlaneIntersectionType::Front;
+			return;
 		}
 
 		dot = (Normal.X * min.X) + (Normal.Y * min.Y) + (Normal.Z * min.Z);
@@ -166,30 +167,33 @@ namespace XFX
 		if(dot + D < 0.0f)
 		{
 			result = PlaneIntersectionType::Back;
+			return;
 		}
 
 		result = PlaneIntersectionType::Intersecting;
 	}
 
-	PlaneIntersectionType_t Plane::Intersects(const BoundingSphere sphere) const
+	PlaneIntersectionType_t Plane::Intersects(const BoundingSphere& sphere) const
 	{
 		PlaneIntersectionType_t result;
 		Intersects(sphere, result);
 		return result;
 	}
 
-	void Plane::Intersects(const BoundingSphere sphere, out PlaneIntersectionType_t& result) const
+	void Plane::Intersects(const BoundingSphere& sphere, out PlaneIntersectionType_t& result) const
 	{
 		float dot = (sphere.Center.X * Normal.X) + (sphere.Center.Y * Normal.Y) + (sphere.Center.Z * Normal.Z) + D;
 
 		if(dot > sphere.Radius)
 		{
 			result = PlaneIntersectionType::Front;
+			return;
 		}
 
 		if(dot < -sphere.Radius)
 		{
 			result = PlaneIntersectionType::Back;
+			return;
 		}
 
 		result = PlaneIntersectionType::Intersecting;
@@ -205,14 +209,14 @@ namespace XFX
 		D *= magnitude;
 	}
 
-	Plane Plane::Normalize(const Plane plane)
+	Plane Plane::Normalize(const Plane& plane)
 	{
 		float magnitude = 1.0f / Math::Sqrt((plane.Normal.X * plane.Normal.X) + (plane.Normal.Y * plane.Normal.Y) + (plane.Normal.Z * plane.Normal.Z));
 
 		return Plane(plane.Normal.X * magnitude, plane.Normal.Y * magnitude, plane.Normal.Z * magnitude, plane.D * magnitude);
 	}
 
-	void Plane::Normalize(const Plane plane, out Plane& result)
+	void Plane::Normalize(const Plane& plane, out Plane& result)
 	{
 		result = Normalize(plane);
 	}
@@ -222,35 +226,36 @@ namespace XFX
 		return String::Format("{Normal:%s D:%g}", (const char*)Normal.ToString(), D);
 	}
 
-	Plane Plane::Transform(Plane plane, Matrix matrix)
+	Plane Plane::Transform(const Plane& plane, const Matrix& matrix)
 	{
 		Plane result; 
 		Transform(plane, matrix, result);
 		return result; 
 	}
 
-	void Plane::Transform(Plane plane, Matrix matrix, out Plane& result)
+	void Plane::Transform(const Plane& plane, const Matrix& matrix, out Plane& result)
 	{
 		float x = plane.Normal.X;
 		float y = plane.Normal.Y;
 		float z = plane.Normal.Z;
 		float d = plane.D;
 
-		matrix = Matrix::Invert(matrix);
-		result.Normal.X = (((x * matrix.M11) + (y * matrix.M12)) + (z * matrix.M13)) + (d * matrix.M14);
-		result.Normal.Y = (((x * matrix.M21) + (y * matrix.M22)) + (z * matrix.M23)) + (d * matrix.M24);
-		result.Normal.Z = (((x * matrix.M31) + (y * matrix.M32)) + (z * matrix.M33)) + (d * matrix.M34);
-		result.D = (((x * matrix.M41) + (y * matrix.M42)) + (z * matrix.M43)) + (d * matrix.M44);
+		Matrix inverse;
+		Matrix::Invert(matrix, inverse);
+		result.Normal.X = (((x * inverse.M11) + (y * inverse.M12)) + (z * inverse.M13)) + (d * inverse.M14);
+		result.Normal.Y = (((x * inverse.M21) + (y * inverse.M22)) + (z * inverse.M23)) + (d * inverse.M24);
+		result.Normal.Z = (((x * inverse.M31) + (y * inverse.M32)) + (z * inverse.M33)) + (d * inverse.M34);
+		result.D = (((x * inverse.M41) + (y * inverse.M42)) + (z * inverse.M43)) + (d * inverse.M44);
 	}
 
-	Plane Plane::Transform(Plane plane, Quaternion quaternion)
+	Plane Plane::Transform(const Plane& plane, const Quaternion& quaternion)
 	{
 		Plane result;
 		Transform(plane, quaternion, result);
 		return result;
 	}
 
-	void Plane::Transform(Plane plane, Quaternion quaternion, out Plane& result)
+	void Plane::Transform(const Plane& plane, const Quaternion& quaternion, out Plane& result)
 	{
 		float x2 = quaternion.X + quaternion.X;
 		float y2 = quaternion.Y + quaternion.Y;
@@ -44,7 +44,7 @@ namespace XFX
 	{
 	}
 
-	Quaternion::Quaternion(Vector3 vectorPart, float scalarPart)
+	Quaternion::Quaternion(const Vector3& vectorPart, float scalarPart)
 		: W(scalarPart), X(vectorPart.X), Y(vectorPart.Y), Z(vectorPart.Z)
 	{
 	}
@@ -59,15 +59,14 @@ namespace XFX
 	{
 	}
 
-	Quaternion Quaternion::Add(Quaternion quaternion1, Quaternion quaternion2)
+	Quaternion Quaternion::Add(const Quaternion& quaternion1, const Quaternion& quaternion2)
 	{
-		return Quaternion(quaternion1.X + quaternion2.X,
-					quaternion1.Y + quaternion2.Y,
-					quaternion1.Z + quaternion2.Z,
-					quaternion1.W + quaternion2.W);
+		Quaternion result;
+		Add(quaternion1, quaternion2, result);
+		return result;
 	}
 
-	void Quaternion::Add(Quaternion quaternion1, Quaternion quaternion2, out Quaternion& result)
+	void Quaternion::Add(const Quaternion& quaternion1, const Quaternion& quaternion2, out Quaternion& result)
 	{
 		result.X = quaternion1.X + quaternion2.X;
 		result.Y = quaternion1.Y + quaternion2.Y;
@@ -75,31 +74,14 @@ namespace XFX
 		result.W = quaternion1.W + quaternion2.W;
 	}
 	
-	Quaternion Quaternion::Concatenate(Quaternion quaternion1, Quaternion quaternion2)
+	Quaternion Quaternion::Concatenate(const Quaternion& quaternion1, const Quaternion& quaternion2)
 	{
-		Quaternion quaternion; 
-		float rx = quaternion2.X;
-		float ry = quaternion2.Y;
-		float rz = quaternion2.Z;
-		float rw = quaternion2.W;
-		float lx = quaternion1.X;
-		float ly = quaternion1.Y;
-		float lz = quaternion1.Z;
-		float lw = quaternion1.W;
-		float yz = (ry * lz) - (rz * ly);
-		float xz = (rz * lx) - (rx * lz);
-		float xy = (rx * ly) - (ry * lx);
-		float lengthSq = ((rx * lx) + (ry * ly)) + (rz * lz);
-
-		quaternion.X = ((rx * lw) + (lx * rw)) + yz;
-		quaternion.Y = ((ry * lw) + (ly * rw)) + xz;
-		quaternion.Z = ((rz * lw) + (lz * rw)) + xy;
-		quaternion.W = (rw * lw) - lengthSq;
-
-		return quaternion;
+		Quaternion result;
+		Concatenate(quaternion1, quaternion2, result);
+		return result;
 	}
 	
-	void Quaternion::Concatenate(Quaternion quaternion1, Quaternion quaternion2, out Quaternion& result)
+	void Quaternion::Concatenate(const Quaternion& quaternion1, const Quaternion& quaternion2, out Quaternion& result)
 	{
 		float rx = quaternion2.X;
 		float ry = quaternion2.Y;
@@ -127,17 +109,14 @@ namespace XFX
 		Z = -Z;
 	}
 
-	Quaternion Quaternion::Conjugate(Quaternion value)
+	Quaternion Quaternion::Conjugate(const Quaternion& value)
 	{
 		Quaternion result;
-		result.X = -value.X;
-		result.Y = -value.Y;
-		result.Z = -value.Z;
-		result.W = value.W;
+		Conjugate(value, result);
 		return result;
 	}
 	
-	void Quaternion::Conjugate(Quaternion value, out Quaternion& result)
+	void Quaternion::Conjugate(const Quaternion& value, out Quaternion& result)
 	{
 		result.X = -value.X;
 		result.Y = -value.Y;
@@ -145,95 +124,36 @@ namespace XFX
 		result.W = value.W;
 	}
 
-	Quaternion Quaternion::CreateFromAxisAngle(Vector3 axis, float angle)
+	Quaternion Quaternion::CreateFromAxisAngle(const Vector3& axis, float angle)
 	{
 		Quaternion result;
-		
-		Vector3::Normalize(axis, axis);
-		
-		float half = angle * 0.5f;
-		float Sin = Math::Sin(half);
-		float Cos = Math::Cos(half);
-
-		result.X = axis.X * Sin;
-		result.Y = axis.Y * Sin;
-		result.Z = axis.Z * Sin;
-		result.W = Cos;
-
+		CreateFromAxisAngle(axis, angle, result);
 		return result;
 	}
 
-	void Quaternion::CreateFromAxisAngle(Vector3 axis, float angle, out Quaternion& result)
+	void Quaternion::CreateFromAxisAngle(const Vector3& axis, float angle, out Quaternion& result)
 	{
-		Vector3::Normalize(axis, axis);
+		Vector3 normal;
+		Vector3::Normalize(axis, normal);
 		
 		float half = angle * 0.5f;
 		float Sin = Math::Sin(half);
 		float Cos = Math::Cos(half);
 
-		result.X = axis.X * Sin;
-		result.Y = axis.Y * Sin;
-		result.Z = axis.Z * Sin;
+		result.X = normal.X * Sin;
+		result.Y = normal.Y * Sin;
+		result.Z = normal.Z * Sin;
 		result.W = Cos;
 	}
 
-	Quaternion Quaternion::CreateFromRotationMatrix(Matrix matrix)
+	Quaternion Quaternion::CreateFromRotationMatrix(const Matrix& matrix)
 	{
 		Quaternion result;
-		float scale = matrix.M11 + matrix.M22 + matrix.M33;
-
-		if(scale > 0.0f)
-		{
-			float Sqrt = Math::Sqrt(scale + 1.0f);
-			
-			result.W = Sqrt + 0.5f;
-			Sqrt = 0.5f / Sqrt;
-
-			result.X = (matrix.M23 - matrix.M32) * Sqrt;
-			result.Y = (matrix.M31 - matrix.M13) * Sqrt;
-			result.Z = (matrix.M12 - matrix.M21) * Sqrt;
-
-			return result;
-		}
-
-		if((matrix.M11 >= matrix.M22) && (matrix.M11 >= matrix.M33))
-		{
-			float Sqrt = Math::Sqrt(1.0f + matrix.M11 - matrix.M22 - matrix.M33);
-			float half = 0.f / Sqrt;
-
-			result.X = 0.5f * Sqrt;
-			result.Y = (matrix.M12 + matrix.M21) * half;
-			result.Z = (matrix.M13 + matrix.M31) * half;
-			result.W = (matrix.M23 - matrix.M32) * half;
-
-			return result;
-		}
-
-		if(matrix.M22 > matrix.M33)
-		{
-			float Sqrt = Math::Sqrt(1.0f + matrix.M22 - matrix.M11 - matrix.M33);
-			float half = 0.5f / Sqrt;
-
-			result.X = (matrix.M21 + matrix.M12) * half;
-			result.Y = 0.5f * Sqrt;
-			result.Z = (matrix.M32 + matrix.M23) * half;
-			result.W = (matrix.M31 - matrix.M21) * half;
-
-			return result;
-		}
-
-		float Sqrt = Math::Sqrt(1.0f + matrix.M33 - matrix.M11 - matrix.M22);
-		float half = 0.5f / Sqrt;
-
-		result.X = (matrix.M31 + matrix.M13) * half;
-		result.Y = (matrix.M32 + matrix.M23) * half;
-		result.Z = 0.5f * Sqrt;
-		result.W = (matrix.M12 - matrix.M21) * half;
-
+		CreateFromRotationMatrix(matrix, result);
 		return result;
 	}
 
-	void Quaternion::CreateFromRotationMatrix(Matrix matrix, out Quaternion& result)
+	void Quaternion::CreateFromRotationMatrix(const Matrix& matrix, out Quaternion& result)
 	{
 		float scale = matrix.M11 + matrix.M22 + matrix.M33;
 
@@ -241,7 +161,7 @@ namespace XFX
 		{
 			float Sqrt = Math::Sqrt(scale + 1.0f);
 
-			result.W = Sqrt + 0.5f;
+			result.W = Sqrt * 0.5f;
 			Sqrt = 0.5f / Sqrt;
 
 			result.X = (matrix.M23 - matrix.M32) * Sqrt;
@@ -253,7 +173,7 @@ namespace XFX
 		if((matrix.M11 >= matrix.M22) && (matrix.M11 >= matrix.M33))
 		{
 			float Sqrt = Math::Sqrt(1.0f + matrix.M11 - matrix.M22 - matrix.M33);
-			float half = 0.f / Sqrt;
+			float half = 0.5f / Sqrt;
 
 			result.X = 0.5f * Sqrt;
 			result.Y = (matrix.M12 + matrix.M21) * half;
@@ -270,7 +190,7 @@ namespace XFX
 			result.X = (matrix.M21 + matrix.M12) * half;
 			result.Y = 0.5f * Sqrt;
 			result.Z = (matrix.M32 + matrix.M23) * half;
-			result.W = (matrix.M31 - matrix.M21) * half;
+			result.W = (matrix.M31 - matrix.M13) * half;
 			return;
 		}
 
@@ -286,22 +206,7 @@ namespace XFX
 	Quaternion Quaternion::CreateFromYawPitchRoll(float yaw, float pitch, float roll)
 	{
 		Quaternion result;
-
-		float halfRoll = roll * 0.5f;
-		float sinRoll = Math::Sin(halfRoll);
-		float cosRoll = Math::Cos(halfRoll);
-		float halfPitch = pitch * 0.5f;
-		float sinPitch = Math::Sin(halfPitch);
-		float cosPitch = Math::Cos(halfPitch);
-		float halfYaw = yaw * 0.5f;
-		float sinYaw = Math::Sin(halfYaw);
-		float cosYaw = Math::Cos(halfYaw);
-
-		result.X = (cosYaw * sinPitch * cosRoll) + (sinYaw * cosPitch * sinRoll);
-		result.Y = (sinYaw * cosPitch * cosRoll) + (cosYaw * sinPitch * sinRoll);
-		result.Z = (cosYaw * cosPitch * sinRoll) + (sinYaw * sinPitch * cosRoll);
-		result.W = (cosYaw * cosPitch * cosRoll) + (sinYaw * sinPitch * sinRoll);
-
+		CreateFromYawPitchRoll(yaw, pitch, roll, result);
 		return result;
 	}
 
@@ -323,17 +228,14 @@ namespace XFX
 		result.W = (cosYaw * cosPitch * cosRoll) + (sinYaw * sinPitch * sinRoll);
 	}
 
-	Quaternion Quaternion::Divide(Quaternion quaternion1, Quaternion quaternion2)
+	Quaternion Quaternion::Divide(const Quaternion& quaternion1, const Quaternion& quaternion2)
 	{
 		Quaternion result;
-		result.X = quaternion1.X / quaternion2.X;
-		result.Y = quaternion1.Y / quaternion2.Y;
-		result.Z = quaternion1.Z / quaternion2.Z;
-		result.W = quaternion1.W / quaternion2.W;
+		Divide(quaternion1, quaternion2, result);
 		return result;
 	}
 	
-	void Quaternion::Divide(Quaternion quaternion1, Quaternion quaternion2, out Quaternion& result)
+	void Quaternion::Divide(const Quaternion& quaternion1, const Quaternion& quaternion2, out Quaternion& result)
 	{
 		result.X = quaternion1.X / quaternion2.X;
 		result.Y = quaternion1.Y / quaternion2.Y;
@@ -341,12 +243,12 @@ namespace XFX
 		result.W = quaternion1.W / quaternion2.W;
 	}
 
-	float Quaternion::Dot(Quaternion quaternion1, Quaternion quaternion2)
+	float Quaternion::Dot(const Quaternion& quaternion1, const Quaternion& quaternion2)
 	{
 		return (quaternion1.X * quaternion2.X) + (quaternion1.Y * quaternion2.Y) + (quaternion1.Z * quaternion2.Z) + (quaternion1.W * quaternion2.W);
 	}
 
-	void Quaternion::Dot(Quaternion quaternion1, Quaternion quaternion2, out float& result)
+	void Quaternion::Dot(const Quaternion& quaternion1, const Quaternion& quaternion2, out float& result)
 	{
 		result = (quaternion1.X * quaternion2.X) + (quaternion1.Y * quaternion2.Y) + (quaternion1.Z * quaternion2.Z) + (quaternion1.W * quaternion2.W);
 	}
@@ -371,18 +273,14 @@ namespace XFX
 		return QuaternionTypeInfo;
 	}
 
-	Quaternion Quaternion::Inverse(Quaternion quaternion)
+	Quaternion Quaternion::Inverse(const Quaternion& quaternion)
 	{
 		Quaternion result;
-		float lengthSq = 1.0f / ( (quaternion.X * quaternion.X) + (quaternion.Y * quaternion.Y) + (quaternion.Z * quaternion.Z) + (quaternion.W * quaternion.W) );
-		result.X = -quaternion.X * lengthSq;
-		result.Y = -quaternion.Y * lengthSq;
-		result.Z = -quaternion.Z * lengthSq;
-		result.W = quaternion.W * lengthSq;
+		Inverse(quaternion, result);
 		return result;
 	}
 
-	void Quaternion::Inverse(Quaternion quaternion, out Quaternion& result)
+	void Quaternion::Inverse(const Quaternion& quaternion, out Quaternion& result)
 	{
 		float lengthSq = 1.0f / ( (quaternion.X * quaternion.X) + (quaternion.Y * quaternion.Y) + (quaternion.Z * quaternion.Z) + (quaternion.W * quaternion.W) );
 		result.X = -quaternion.X * lengthSq;
@@ -401,17 +299,14 @@ namespace XFX
 		return (X * X) + (Y * Y) + (Z * Z) + (W * W);
 	}
 
-	Quaternion Quaternion::Lerp(Quaternion quaternion1, Quaternion quaternion2, float amount)
+	Quaternion Quaternion::Lerp(const Quaternion& quaternion1, const Quaternion& quaternion2, float amount)
 	{
 		Quaternion result;
-		result.X = MathHelper::Lerp(quaternion1.X, quaternion2.X, amount);
-		result.Y = MathHelper::Lerp(quaternion1.Y, quaternion2.Y, amount);
-		result.Z = MathHelper::Lerp(quaternion1.Z, quaternion2.Z, amount);
-		result.W = MathHelper::Lerp(quaternion1.W, quaternion2.W, amount);
+		Lerp(quaternion1, quaternion2, amount, result);
 		return result;
 	}
 
-	void Quaternion::Lerp(Quaternion quaternion1, Quaternion quaternion2, float amount, out Quaternion& result)
+	void Quaternion::Lerp(const Quaternion& quaternion1, const Quaternion& quaternion2, float amount, out Quaternion& result)
 	{
 		result.X = MathHelper::Lerp(quaternion1.X, quaternion2.X, amount);
 		result.Y = MathHelper::Lerp(quaternion1.Y, quaternion2.Y, amount);
@@ -419,31 +314,14 @@ namespace XFX
 		result.W = MathHelper::Lerp(quaternion1.W, quaternion2.W, amount);
 	}
 
-	Quaternion Quaternion::Multiply(Quaternion quaternion1, Quaternion quaternion2)
+	Quaternion Quaternion::Multiply(const Quaternion& quaternion1, const Quaternion& quaternion2)
 	{
 		Quaternion result;
-		float rx = quaternion2.X;
-		float ry = quaternion2.Y;
-		float rz = quaternion2.Z;
-		float rw = quaternion2.W;
-		float lx = quaternion1.X;
-		float ly = quaternion1.Y;
-		float lz = quaternion1.Z;
-		float lw = quaternion1.W;
-		float yz = (ry * lz) - (rz * ly);
-		float xz = (rz * lx) - (rx * lz);
-		float xy = (rx * ly) - (ry * lx);
-		float lengthSq = ((rx * lx) + (ry * ly)) + (rz * lz);
-
-		result.X = ((rx * lw) + (lx * rw)) + yz;
-		result.Y = ((ry * lw) + (ly * rw)) + xz;
-		result.Z = ((rz * lw) + (lz * rw)) + xy;
-		result.W = (rw * lw) - lengthSq;
-
+		Multiply(quaternion1, quaternion2, result);
 		return result;
 	}
 
-	void Quaternion::Multiply(Quaternion quaternion1, Quaternion quaternion2, out Quaternion& result)
+	void Quaternion::Multiply(const Quaternion& quaternion1, const Quaternion& quaternion2, out Quaternion& result)
 	{
 		float rx = quaternion2.X; 
 		float ry = quaternion2.Y; 
@@ -464,17 +342,14 @@ namespace XFX
 		result.W = (rw * lw) - lengthSq; 
 	}
 
-	Quaternion Quaternion::Multiply(Quaternion quaternion, float scaleFactor)
+	Quaternion Quaternion::Multiply(const Quaternion& quaternion, float scaleFactor)
 	{
 		Quaternion result;
-		result.X = quaternion.X * scaleFactor;
-		result.Y = quaternion.Y * scaleFactor;
-		result.Z = quaternion.Z * scaleFactor;
-		result.W = quaternion.W * scaleFactor;
+		Multiply(quaternion, scaleFactor, result);
 		return result;
 	}
 
-	void Quaternion::Multiply(Quaternion quaternion, float scaleFactor, out Quaternion& result)
+	void Quaternion::Multiply(const Quaternion& quaternion, float scaleFactor, out Quaternion& result)
 	{
 		result.X = quaternion.X * scaleFactor;
 		result.Y = quaternion.Y * scaleFactor;
@@ -482,17 +357,14 @@ namespace XFX
 		result.W = quaternion.W * scaleFactor;
 	}
 
-	Quaternion Quaternion::Negate(Quaternion quaternion)
+	Quaternion Quaternion::Negate(const Quaternion& quaternion)
 	{
 		Quaternion result;
-		result.X = -quaternion.X;
-		result.Y = -quaternion.Y;
-		result.Z = -quaternion.Z;
-		result.W = -quaternion.W;
+		Negate(quaternion, result);
 		return result;
 	}
 
-	void Quaternion::Negate(Quaternion quaternion, out Quaternion& result)
+	void Quaternion::Negate(const Quaternion& quaternion, out Quaternion& result)
 	{
 		result.X = -quaternion.X;
 		result.Y = -quaternion.Y;
@@ -509,44 +381,14 @@ namespace XFX
 		W *= length;
 	}
 
-	Quaternion Quaternion::Slerp(Quaternion quaternion1, Quaternion quaternion2, float amount)
+	Quaternion Quaternion::Slerp(const Quaternion& quaternion1, const Quaternion& quaternion2, float amount)
 	{
 		Quaternion result;
-
-		float opposite;
-		float inverse;
-		float dot = (quaternion1.X * quaternion2.X) + (quaternion1.Y * quaternion2.Y) + (quaternion1.Z * quaternion2.Z) + (quaternion1.W * quaternion2.W);
-		int flag = false;
-
-		if( dot < 0.0f )
-		{
-			flag = true;
-			dot = -dot;
-		}
-
-		if( dot > 0.999999f )
-		{
-			inverse = 1.0f - amount;
-			opposite = flag ? -amount : amount;
-		}
-		else
-		{
-			float Acos = Math::Acos(dot);
-			float invSin = (1.0f / Math::Sin(Acos));
-
-			inverse = (Math::Sin((1.0f - amount) * Acos)* invSin);
-			opposite = flag ? ( -Math::Sin(amount * Acos ) * invSin) : (Math::Sin(amount * Acos) * invSin);
-		}
-
-		result.X = (inverse * quaternion1.X) + (opposite * quaternion2.X);
-		result.Y = (inverse * quaternion1.Y) + (opposite * quaternion2.Y);
-		result.Z = (inverse * quaternion1.Z) + (opposite * quaternion2.Z);
-		result.W = (inverse * quaternion1.W) + (opposite * quaternion2.W);
-
+		Slerp(quaternion1, quaternion2, amount, result);
 		return result;
 	}
 
-	void Quaternion::Slerp(Quaternion quaternion1, Quaternion quaternion2, float amount, out Quaternion& result)
+	void Quaternion::Slerp(const Quaternion& quaternion1, const Quaternion& quaternion2, float amount, out Quaternion& result)
 	{
 		float opposite;
 		float inverse;
@@ -579,12 +421,14 @@ namespace XFX
 		result.W = (inverse * quaternion1.W) + (opposite * quaternion2.W);
 	}
 
-	Quaternion Quaternion::Subtract(Quaternion quaternion1, Quaternion quaternion2)
+	Quaternion Quaternion::Subtract(const Quaternion& quaternion1, const Quaternion& quaternion2)
 	{
-		return Quaternion(quaternion1.X - quaternion2.X, quaternion1.Y - quaternion2.Y, quaternion1.Z - quaternion2.Z, quaternion1.W - quaternion2.W);
+		Quaternion result;
+		Subtract(quaternion1, quaternion2, result);
+		return result;
 	}
 
-	void Quaternion::Subtract(Quaternion quaternion1, Quaternion quaternion2, out Quaternion& result)
+	void Quaternion::Subtract(const Quaternion& quaternion1, const Quaternion& quaternion2, out Quaternion& result)
 	{
 		result.X = quaternion1.X - quaternion2.X;
 		result.Y = quaternion1.Y - quaternion2.Y;
@@ -614,26 +458,7 @@ namespace XFX
 	
 	Quaternion Quaternion::operator*(const Quaternion& other)
 	{
-		Quaternion result;
-		float rx = other.X;
-		float ry = other.Y;
-		float rz = other.Z;
-		float rw = other.W;
-		float lx = X;
-		float ly = Y;
-		float lz = Z;
-		float lw = W;
-		float yz = (ry * lz) - (rz * ly);
-		float xz = (rz * lx) - (rx * lz);
-		float xy = (rx * ly) - (ry * lx);
-		float lengthSq = ((rx * lx) + (ry * ly)) + (rz * lz);
-
-		result.X = ((rx * lw) + (lx * rw)) + yz;
-		result.Y = ((ry * lw) + (ly * rw)) + xz;
-		result.Z = ((rz * lw) + (lz * rw)) + xy;
-		result.W = (rw * lw) - lengthSq;
-
-		return result;
+		return Multiply(*this, other);
 	}
 	
 	Quaternion Quaternion::operator*(const float scaleFactor)
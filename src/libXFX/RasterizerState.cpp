@@ -34,7 +34,83 @@ namespace XFX
 	{
 		const Type RasterizerStateTypeInfo("RasterizerState", "XFX::Graphics::RasterizerState", TypeCode::Object);
 
+		const RasterizerState RasterizerState::CullClockwise(CullMode::CullClockwiseFace);
+		const RasterizerState RasterizerState::CullCounterClockwise(CullMode::CullCounterClockwiseFace);
+		const RasterizerState RasterizerState::CullNone(CullMode::None);
+
 		RasterizerState::RasterizerState()
+			: cullMode(CullMode::CullCounterClockwiseFace), dephtBias(0.0f), fillMode(FillMode::Solid), isBound(false),
+			multiSampleAntiAlias(true), scissorTestEnable(false), slopeScaleDepthBias(0.0f)
+		{
+		}
+
+		RasterizerState::RasterizerState(const CullMode_t cullMode)
+			: cullMode(cullMode), dephtBias(0.0f), fillMode(FillMode::Solid), isBound(false),
+			multiSampleAntiAlias(true), scissorTestEnable(false), slopeScaleDepthBias(0.0f)
+		{
+		}
+
+		CullMode_t RasterizerState::getCullMode() const
+		{
+			return cullMode;
+		}
+
+		void RasterizerState::setCullMode(CullMode_t value)
+		{
+			cullMode = value;
+		}
+
+		float RasterizerState::getDepthBias() const
+		{
+			return dephtBias;
+		}
+
+		void RasterizerState::setDepthBias(float value)
+		{
+			dephtBias = value;
+		}
+
+		FillMode_t RasterizerState::getFillMode() const
+		{
+			return fillMode;
+		}
+
+		void RasterizerState::setFillMode(FillMode_t value)
+		{
+			fillMode = value;
+		}
+
+		bool RasterizerState::getMultiSampleAntiAlias() const
+		{
+			return multiSampleAntiAlias;
+		}
+
+		void RasterizerState::setMultiSampleAntiAlias(bool value)
+		{
+			multiSampleAntiAlias = value;
+		}
+
+		bool RasterizerState::getScissorTestEnable() const
+		{
+			return scissorTestEnable;
+		}
+
+		void RasterizerState::setScissorTestEnable(bool value)
+		{
+			scissorTestEnable = value;
+		}
+
+		float RasterizerState::getSlopeScaleDepthBias() const
+		{
+			return slopeScaleDepthBias;
+		}
+
+		void RasterizerState::setSlopeScaleDepthBias(float value)
+		{
+			slopeScaleDepthBias = value;
+		}
+
+		void RasterizerState::Dispose(bool disposing)
 		{
 		}
 
@@ -42,5 +118,17 @@ namespace XFX
 		{
 			return RasterizerStateTypeInfo;
 		}
+
+		bool RasterizerState::operator==(const RasterizerState& right) const
+		{
+			return ((cullMode == right.cullMode) && (dephtBias == right.dephtBias) && (fillMode == right.fillMode) &&
+				(multiSampleAntiAlias == right.multiSampleAntiAlias) && (scissorTestEnable == right.scissorTestEnable) &&
+				(slopeScaleDepthBias == right.slopeScaleDepthBias));
+		}
+
+		bool RasterizerState::operator!=(const RasterizerState& right) const
+		{
+			return !(*this == right);
+		}
 	}
 }
@@ -41,7 +41,7 @@ namespace XFX
 {
 	const Type RayTypeInfo("Ray", "XFX::Ray", TypeCode::Object);
 
-	Ray::Ray(Vector3 direction, Vector3 position)
+	Ray::Ray(const Vector3& direction, const Vector3& position)
 		: Direction(direction), Position(position)
 	{
 	}
@@ -76,7 +76,7 @@ namespace XFX
 		return RayTypeInfo;
 	}
 
-	float Ray::Intersects(BoundingBox boundingbox) const
+	float Ray::Intersects(const BoundingBox& boundingbox) const
 	{
 		float distance;
 		float d = 0.0f; 
@@ -179,12 +179,12 @@ namespace XFX
 		return distance;
 	}
 	
-	void Ray::Intersects(BoundingBox boundingbox, out float& distance) const
+	void Ray::Intersects(const BoundingBox& boundingbox, out float& distance) const
 	{
 		distance = Intersects(boundingbox);
 	}
 
-	float Ray::Intersects(BoundingSphere sphere) const
+	float Ray::Intersects(const BoundingSphere& sphere) const
 	{
 		float distance;
 		float x = sphere.Center.X - Position.X;
@@ -217,12 +217,12 @@ namespace XFX
 		return distance;
 	}
 	
-	void Ray::Intersects(BoundingSphere sphere, out float& distance) const
+	void Ray::Intersects(const BoundingSphere& sphere, out float& distance) const
 	{
 		distance = Intersects(sphere);
 	}
 
-	float Ray::Intersects(Plane plane) const
+	float Ray::Intersects(const Plane& plane) const
 	{
 		float dotDirection = (plane.Normal.X * Direction.X) + (plane.Normal.Y * Direction.Y) + (plane.Normal.Z * Direction.Z);
 		float distance;
@@ -250,7 +250,7 @@ namespace XFX
 		return distance;
 	}
 	
-	void Ray::Intersects(Plane plane, out float& distance) const
+	void Ray::Intersects(const Plane& plane, out float& distance) const
 	{ 
 		distance = Intersects(plane);
 	}
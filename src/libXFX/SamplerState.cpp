@@ -0,0 +1,171 @@
+// Copyright (C) XFX Team
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without 
+// modification, are permitted provided that the following conditions are met:
+// 
+//     * Redistributions of source code must retain the above copyright 
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright 
+//       notice, this list of conditions and the following disclaimer in the 
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the copyright holder nor the names of any 
+//       contributors may be used to endorse or promote products derived from 
+//       this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE 
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF 
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS 
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE 
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include <Graphics/SamplerState.h>
+#include <System/Type.h>
+
+#include <sassert.h>
+
+namespace XFX
+{
+	namespace Graphics
+	{
+		const String isBoundErrorString = "Cannot change a SamplerState while it is bound to a GraphicsDevice.";
+		const Type SamplerStateTypeInfo("SamplerState", "XFX::Graphics::SamplerState", TypeCode::Object);
+
+		const SamplerState SamplerState::AnisotropicClamp(TextureFilter::Anisotropic, TextureAddressMode::Clamp);
+		const SamplerState SamplerState::AnisotropicWrap(TextureFilter::Anisotropic, TextureAddressMode::Wrap);
+		const SamplerState SamplerState::LinearClamp(TextureFilter::Linear, TextureAddressMode::Clamp);
+		const SamplerState SamplerState::LinearWrap(TextureFilter::Linear, TextureAddressMode::Wrap);
+		const SamplerState SamplerState::PointClamp(TextureFilter::Point, TextureAddressMode::Clamp);
+		const SamplerState SamplerState::PointWrap(TextureFilter::Point, TextureAddressMode::Wrap);
+
+		SamplerState::SamplerState()
+			: addressU(TextureAddressMode::Wrap), addressV(TextureAddressMode::Wrap), addressW(TextureAddressMode::Wrap), filter(TextureFilter::Linear), isBound(false), maxAnisotropy(4), maxMipLevel(0), mipMapLevelOfDetailBias(0)
+		{
+		}
+
+		SamplerState::SamplerState(const TextureFilter_t filter, const TextureAddressMode_t addressMode)
+			: addressU(addressMode), addressV(addressMode), addressW(addressMode), filter(filter), isBound(false), maxAnisotropy(4), maxMipLevel(0), mipMapLevelOfDetailBias(0)
+		{
+		}
+
+		SamplerState::~SamplerState()
+		{
+			Dispose(false);
+		}
+
+		TextureAddressMode_t SamplerState::getAddressU() const
+		{
+			return addressU;
+		}
+
+		void SamplerState::setAddressU(TextureAddressMode_t value)
+		{
+			sassert(!isBound, isBoundErrorString);
+
+			addressU = value;
+		}
+
+		TextureAddressMode_t SamplerState::getAddressV() const
+		{
+			return addressV;
+		}
+
+		void SamplerState::setAddressV(TextureAddressMode_t value)
+		{
+			sassert(!isBound, isBoundErrorString);
+
+			addressV = value;
+		}
+
+		TextureAddressMode_t SamplerState::getAddressW() const
+		{
+			return addressW;
+		}
+
+		void SamplerState::setAddressW(TextureAddressMode_t value)
+		{
+			sassert(!isBound, isBoundErrorString);
+
+			addressW = value;
+		}
+
+		TextureFilter_t SamplerState::getFilter() const
+		{
+			return filter;
+		}
+
+		void SamplerState::setFilter(TextureFilter_t value)
+		{
+			sassert(!isBound, isBoundErrorString);
+
+			filter = value;
+		}
+
+		int SamplerState::getMaxAnisotropy() const
+		{
+			return maxAnisotropy;
+		}
+
+		void SamplerState::setMaxAnisotropy(int value)
+		{
+			sassert(!isBound, isBoundErrorString);
+
+			maxAnisotropy = value;
+		}
+
+		int SamplerState::getMaxMipLevel() const
+		{
+			return maxMipLevel;
+		}
+
+		void SamplerState::setMaxMipLevel(int value)
+		{
+			sassert(!isBound, isBoundErrorString);
+
+			maxMipLevel = value;
+		}
+
+		int SamplerState::getMipMapLevelOfDetailBias() const
+		{
+			return mipMapLevelOfDetailBias;
+		}
+
+		void SamplerState::setMipMapLevelOfDetailBias(int value)
+		{
+			sassert(!isBound, isBoundErrorString);
+
+			mipMapLevelOfDetailBias = value;
+		}
+
+		void SamplerState::Dispose(bool disposing)
+		{
+		}
+
+		const Type& SamplerState::GetType()
+		{
+			return SamplerStateTypeInfo;
+		}
+
+		bool SamplerState::operator==(const SamplerState& right) const
+		{
+			return ((addressU == right.addressU) &&
+				(addressV == right.addressV) &&
+				(addressW == right.addressW) &&
+				(filter == right.filter) &&
+				(maxAnisotropy == right.maxAnisotropy) &&
+				(maxMipLevel == right.maxMipLevel) &&
+				(mipMapLevelOfDetailBias == right.mipMapLevelOfDetailBias));
+		}
+
+		bool SamplerState::operator!=(const SamplerState& right) const
+		{
+			return !(*this == right);
+		}
+	}
+}
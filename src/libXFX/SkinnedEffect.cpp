@@ -0,0 +1,570 @@
+// Copyright (C) XFX Team
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without 
+// modification, are permitted provided that the following conditions are met:
+// 
+//* Redistributions of source code must retain the above copyright 
+//notice, this list of conditions and the following disclaimer.
+//* Redistributions in binary form must reproduce the above copyright 
+//notice, this list of conditions and the following disclaimer in the 
+//documentation and/or other materials provided with the distribution.
+//* Neither the name of the copyright holder nor the names of any 
+//contributors may be used to endorse or promote products derived from 
+//this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE 
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF 
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS 
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE 
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include <Matrix.h>
+#include <Vector3.h>
+#include <Graphics/GraphicsDevice.h>
+#include <Graphics/SkinnedEffect.h>
+#include <Graphics/VertexElement.h>
+#include <Graphics/Viewport.h>
+#include <System/FrameworkResources.h>
+#include <System/String.h>
+#include <System/Type.h>
+#include "VertexSkinning.h"
+
+extern "C" {
+#include "pbKit.h"
+}
+
+#include <sassert.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Vertex shader constant registers used by the skinning program.
+// pb_pcode2mcode can only encode c0 to c15 directly, so the bone palette that follows them is addressed relative to a0.x.
+#define WORLDVIEWPROJECTION_REGISTER	0	// c0-c3: World * View * Projection, transposed
+#define VIEWPORT_SCALE_REGISTER			4
+#define VIEWPORT_OFFSET_REGISTER		5
+#define SKINNING_CONSTANTS_REGISTER		6	// (3 * 255, PALETTE_REGISTER + 0.25, 0, 1)
+#define COLOR_REGISTER					7
+#define PALETTE_REGISTER				8	// three registers per bone, up to c95
+#define CONSTANT_REGISTER_COUNT			8
+
+// Constant register cn is uploaded to slot n + 96.
+#define CONSTANT_SLOT(n)				((n) + 96)
+
+// The depth scale pbKit uses for its D24S8 depth buffer.
+#define DEPTH_SCALE						16777215.0f
+
+// Bones uploaded per push buffer block: 24 registers are sent as three 32 dword bursts, which keeps the block under 128 dwords.
+#define BONES_PER_BLOCK					8
+#define CONSTANTS_PER_BURST				32
+
+// vs.1.1 tokens, as read by pb_pcode2mcode.
+#define VS_VERSION						0xfffe0101
+#define VS_END							0x0000ffff
+#define VS_MOV							0x00000001
+#define VS_MAD							0x00000004
+#define VS_MUL							0x00000005
+#define VS_DP4							0x00000009
+#define VS_RCC							0x00000101	// pbKit extension: clamped reciprocal
+#define VS_MAX_TOKENS					256
+
+#define REG_TEMP						0
+#define REG_INPUT						1
+#define REG_CONST						2
+#define REG_ADDRESS						3
+#define REG_POSITION_OUT				4
+#define REG_COLOR_OUT					5
+#define REG_TEXCOORD_OUT				6
+
+#define MASK_X							1
+#define MASK_XYZ						7
+#define MASK_XYZW						15
+
+#define SWIZZLE_X						0x00
+#define SWIZZLE_Y						0x55
+#define SWIZZLE_Z						0xaa
+#define SWIZZLE_W						0xff
+#define SWIZZLE_XYZW					0xe4
+
+namespace XFX
+{
+	namespace Graphics
+	{
+		const Type SkinnedEffectTypeInfo("SkinnedEffect", "XFX::Graphics::SkinnedEffect", TypeCode::Object);
+
+		// Micro-code of the skinning program for 1, 2 and 4 weights per vertex, built on first use.
+		static DWORD* programs[3];
+		static bool programsBuilt[3];
+		// The program in vertex program memory, and the effect whose bones are in the palette registers.
+		static const DWORD* loadedProgram = NULL;
+		static const SkinnedEffect* paletteOwner = NULL;
+
+		static inline DWORD Destination(const DWORD type, const DWORD number, const DWORD mask)
+		{
+			return 0x80000000 | (type << 28) | (mask << 16) | number;
+		}
+
+		static inline DWORD Source(const DWORD type, const DWORD number, const DWORD swizzle)
+		{
+			return 0x80000000 | (type << 28) | (swizzle << 16) | number;
+		}
+
+		// c[a0.x + number]
+		static inline DWORD RelativeConstant(const DWORD number)
+		{
+			return Source(REG_CONST, number, SWIZZLE_XYZW) | 0x2000;
+		}
+
+		/**
+		 * Writes the vs.1.1 pseudo-code of the skinning program:
+		 *
+		 *	mad r1, v11, c6.x, c6.y			; palette register of each bone
+		 *	mov a0.x, r1.x					; for each weight k (x, y, z, w):
+		 *	dp4 r3.x, v0, c[a0.x + 0]
+		 *	dp4 r3.y, v0, c[a0.x + 1]
+		 *	dp4 r3.z, v0, c[a0.x + 2]
+		 *	mul r2.xyz, r3, v1.x			; mad r2.xyz, r3, v1.k, r2 for the following weights
+		 *	mov r2.w, c6.w
+		 *	dp4 r0.x, r2, c0				; through r0.w and c3
+		 *	mul r1.xyz, r0, c4				; viewport transform, which the program does itself on the NV2A
+		 *	rcc r1.w, r0.w
+		 *	mad oPos.xyz, r1, r1.w, c5
+		 *	mov oPos.w, r0.w
+		 *	mov oD0, c7
+		 *	mov oT0, v9
+		 */
+		static void BuildProgram(const int weightsPerVertex, DWORD pcode[])
+		{
+			static const DWORD weightSwizzles[4] = { SWIZZLE_X, SWIZZLE_Y, SWIZZLE_Z, SWIZZLE_W };
+			DWORD* p = pcode;
+
+			*(p++) = VS_VERSION;
+
+			*(p++) = VS_MAD;
+			*(p++) = Destination(REG_TEMP, 1, MASK_XYZW);
+			*(p++) = Source(REG_INPUT, 11, SWIZZLE_XYZW);
+			*(p++) = Source(REG_CONST, SKINNING_CONSTANTS_REGISTER, SWIZZLE_X);
+			*(p++) = Source(REG_CONST, SKINNING_CONSTANTS_REGISTER, SWIZZLE_Y);
+
+			for (int k = 0; k < weightsPerVertex; k++)
+			{
+				*(p++) = VS_MOV;
+				*(p++) = Destination(REG_ADDRESS, 0, MASK_X);
+				*(p++) = Source(REG_TEMP, 1, weightSwizzles[k]);
+
+				for (int column = 0; column < 3; column++)
+				{
+					*(p++) = VS_DP4;
+					*(p++) = Destination(REG_TEMP, 3, 1 << column);
+					*(p++) = Source(REG_INPUT, 0, SWIZZLE_XYZW);
+					*(p++) = RelativeConstant(column);
+				}
+
+				*(p++) = (k == 0) ? VS_MUL : VS_MAD;
+				*(p++) = Destination(REG_TEMP, 2, MASK_XYZ);
+				*(p++) = Source(REG_TEMP, 3, SWIZZLE_XYZW);
+				*(p++) = Source(REG_INPUT, 1, weightSwizzles[k]);
+
+				if (k != 0)
+				{
+					*(p++) = Source(REG_TEMP, 2, SWIZZLE_XYZW);
+				}
+			}
+
+			*(p++) = VS_MOV;
+			*(p++) = Destination(REG_TEMP, 2, 1 << 3);
+			*(p++) = Source(REG_CONST, SKINNING_CONSTANTS_REGISTER, SWIZZLE_W);
+
+			for (int row = 0; row < 4; row++)
+			{
+				*(p++) = VS_DP4;
+				*(p++) = Destination(REG_TEMP, 0, 1 << row);
+				*(p++) = Source(REG_TEMP, 2, SWIZZLE_XYZW);
+				*(p++) = Source(REG_CONST, WORLDVIEWPROJECTION_REGISTER + row, SWIZZLE_XYZW);
+			}
+
+			*(p++) = VS_MUL;
+			*(p++) = Destination(REG_TEMP, 1, MASK_XYZ);
+			*(p++) = Source(REG_TEMP, 0, SWIZZLE_XYZW);
+			*(p++) = Source(REG_CONST, VIEWPORT_SCALE_REGISTER, SWIZZLE_XYZW);
+
+			*(p++) = VS_RCC;
+			*(p++) = Destination(REG_TEMP, 1, 1 << 3);
+			*(p++) = Source(REG_TEMP, 0, SWIZZLE_W);
+
+			*(p++) = VS_MAD;
+			*(p++) = Destination(REG_POSITION_OUT, 0, MASK_XYZ);
+			*(p++) = Source(REG_TEMP, 1, SWIZZLE_XYZW);
+			*(p++) = Source(REG_TEMP, 1, SWIZZLE_W);
+			*(p++) = Source(REG_CONST, VIEWPORT_OFFSET_REGISTER, SWIZZLE_XYZW);
+
+			*(p++) = VS_MOV;
+			*(p++) = Destination(REG_POSITION_OUT, 0, 1 << 3);
+			*(p++) = Source(REG_TEMP, 0, SWIZZLE_W);
+
+			*(p++) = VS_MOV;
+			*(p++) = Destination(REG_COLOR_OUT, 0, MASK_XYZW);
+			*(p++) = Source(REG_CONST, COLOR_REGISTER, SWIZZLE_XYZW);
+
+			*(p++) = VS_MOV;
+			*(p++) = Destination(REG_TEXCOORD_OUT, 0, MASK_XYZW);
+			*(p++) = Source(REG_INPUT, 9, SWIZZLE_XYZW);
+
+			*(p++) = VS_END;
+		}
+
+		// The program transforms with dp4, so each register holds a column of the matrix.
+		static inline void TransposeToRegisters(const Matrix& matrix, float registers[])
+		{
+			const float* m = &matrix.M11;
+
+			for (int row = 0; row < 4; row++)
+			{
+				for (int column = 0; column < 4; column++)
+				{
+					registers[row * 4 + column] = m[column * 4 + row];
+				}
+			}
+		}
+
+		static DWORD* GetProgram(const int weightsPerVertex)
+		{
+			const int index = weightsPerVertex >> 1;
+
+			if (!programsBuilt[index])
+			{
+				DWORD pcode[VS_MAX_TOKENS];
+
+				BuildProgram(weightsPerVertex, pcode);
+
+				// pb_pcode2mcode returns a static buffer, so the micro-code is copied. It returns NULL for a program it cannot encode.
+				DWORD* mcode = pb_pcode2mcode(pcode);
+
+				if (mcode != NULL)
+				{
+					const size_t size = ((mcode[0] & 0xffff) + 1) * sizeof(DWORD);
+
+					programs[index] = (DWORD*)malloc(size);
+					memcpy(programs[index], mcode, size);
+				}
+
+				programsBuilt[index] = true;
+			}
+
+			return programs[index];
+		}
+
+		SkinnedEffect::SkinnedEffect(SkinnedEffect const * const cloneSource)
+			: Effect(cloneSource),
+			boneCount(cloneSource->boneCount), dirtyFirstBone(MaxBones), dirtyLastBone(-1), weightsPerVertex(cloneSource->weightsPerVertex), viewProjection(cloneSource->viewProjection),
+			Alpha(cloneSource->Alpha), AmbientLightColor(cloneSource->AmbientLightColor), DiffuseColor(cloneSource->DiffuseColor),
+			EmissiveColor(cloneSource->EmissiveColor), FogColor(cloneSource->FogColor), FogEnabled(cloneSource->FogEnabled),
+			FogEnd(cloneSource->FogEnd), FogStart(cloneSource->FogStart), PreferPerPixelLighting(cloneSource->PreferPerPixelLighting),
+			Projection(cloneSource->Projection), SpecularColor(cloneSource->SpecularColor), SpecularPower(cloneSource->SpecularPower),
+			Texture(cloneSource->Texture), View(cloneSource->View), World(cloneSource->World)
+		{
+			// The clone doesn't own the palette, so all of its bones are uploaded the first time it is applied.
+			for (int i = 0; i < MaxBones; i++)
+			{
+				bones[i] = cloneSource->bones[i];
+			}
+		}
+
+		SkinnedEffect::SkinnedEffect(GraphicsDevice * const device)
+			: Effect(device, null),
+			boneCount(0), dirtyFirstBone(MaxBones), dirtyLastBone(-1), weightsPerVertex(4), viewProjection(Matrix::Identity),
+			Alpha(1), DiffuseColor(Vector3::One), EmissiveColor(Vector3::Zero),
+			FogEnabled(false), FogEnd(1.0f), FogStart(0), PreferPerPixelLighting(false),
+			Projection(Matrix::Identity), SpecularColor(Vector3::One), SpecularPower(16.0f),
+			Texture(null), View(Matrix::Identity), World(Matrix::Identity)
+		{
+			for (int i = 0; i < MaxBones; i++)
+			{
+				bones[i] = Matrix::Identity;
+			}
+
+			EnableDefaultLighting();
+		}
+
+		SkinnedEffect::~SkinnedEffect()
+		{
+			if (paletteOwner == this)
+			{
+				paletteOwner = NULL;
+			}
+		}
+
+		int SkinnedEffect::getWeightsPerVertex() const
+		{
+			return weightsPerVertex;
+		}
+
+		void SkinnedEffect::setWeightsPerVertex(const int value)
+		{
+			sassert(value == 1 || value == 2 || value == 4, "value; WeightsPerVertex must be 1, 2, or 4.");
+
+			if (value == 1 || value == 2 || value == 4)
+			{
+				weightsPerVertex = value;
+			}
+		}
+
+		Effect* SkinnedEffect::Clone() const
+		{
+			return new SkinnedEffect(this);
+		}
+
+		void SkinnedEffect::EnableDefaultLighting()
+		{
+			AmbientLightColor = Vector3(0.05333332f, 0.09882354f, 0.1819608f);
+		}
+
+		void SkinnedEffect::GetBoneTransforms(Matrix boneTransforms[], const int count) const
+		{
+			sassert(boneTransforms != null, String::Format("boneTransforms; %s", FrameworkResources::ArgumentNull_Generic));
+			sassert(count >= 0 && count <= MaxBones, "count; Value must be between 0 and MaxBones.");
+
+			if (boneTransforms == null)
+			{
+				return;
+			}
+
+			for (int i = 0; i < count && i < MaxBones; i++)
+			{
+				boneTransforms[i] = bones[i];
+			}
+		}
+
+		const Type& SkinnedEffect::GetType()
+		{
+			return SkinnedEffectTypeInfo;
+		}
+
+		void SkinnedEffect::OnApply()
+		{
+			GraphicsDevice* device = getGraphicsDevice();
+			DWORD* program = GetProgram(weightsPerVertex);
+			DWORD* p;
+
+			if (program != NULL)
+			{
+				// SpriteBatch and the fixed function effects switch back to SHADER_TYPE_INTERNAL, which doesn't preserve the program.
+				// The micro-code selects SHADER_TYPE_EXTERNAL itself, so the shadow only needs to be told.
+				if (device->UpdateRenderState(NV20_TCL_PRIMITIVE_3D_SHADER_TYPE, SHADER_TYPE_EXTERNAL))
+				{
+					loadedProgram = NULL;
+				}
+
+				if (program != loadedProgram)
+				{
+					p = pb_begin();
+					p = pb_push_mcode(p, program);
+					pb_end(p);
+
+					loadedProgram = program;
+				}
+			}
+
+			// View * Projection is kept for OnApplyWorld, which only changes the world matrix.
+			viewProjection = Matrix::Multiply(View, Projection);
+
+			const Viewport viewport = device->getViewport();
+			const float width = 0.5f * viewport.Width;
+			const float height = -0.5f * viewport.Height;
+			float constants[CONSTANT_REGISTER_COUNT * 4];
+
+			TransposeToRegisters(Matrix::Multiply(World, viewProjection), &constants[WORLDVIEWPROJECTION_REGISTER * 4]);
+
+			// The same scale and offset pb_set_viewport gives the fixed function pipeline.
+			constants[VIEWPORT_SCALE_REGISTER * 4 + 0] = width;
+			constants[VIEWPORT_SCALE_REGISTER * 4 + 1] = height;
+			constants[VIEWPORT_SCALE_REGISTER * 4 + 2] = (viewport.MaxDepth - viewport.MinDepth) * DEPTH_SCALE;
+			constants[VIEWPORT_SCALE_REGISTER * 4 + 3] = 0.0f;
+			constants[VIEWPORT_OFFSET_REGISTER * 4 + 0] = (0.53125f + viewport.X) + width;
+			constants[VIEWPORT_OFFSET_REGISTER * 4 + 1] = (0.53125f + viewport.Y) - height;
+			constants[VIEWPORT_OFFSET_REGISTER * 4 + 2] = viewport.MinDepth * DEPTH_SCALE;
+			constants[VIEWPORT_OFFSET_REGISTER * 4 + 3] = 0.0f;
+
+			// Byte4 blend indices arrive divided by 255. The quarter keeps a0.x on the right register however the hardware rounds it.
+			constants[SKINNING_CONSTANTS_REGISTER * 4 + 0] = 3.0f * 255.0f;
+			constants[SKINNING_CONSTANTS_REGISTER * 4 + 1] = PALETTE_REGISTER + 0.25f;
+			constants[SKINNING_CONSTANTS_REGISTER * 4 + 2] = 0.0f;
+			constants[SKINNING_CONSTANTS_REGISTER * 4 + 3] = 1.0f;
+
+			constants[COLOR_REGISTER * 4 + 0] = (DiffuseColor.X + EmissiveColor.X) * Alpha;
+			constants[COLOR_REGISTER * 4 + 1] = (DiffuseColor.Y + EmissiveColor.Y) * Alpha;
+			constants[COLOR_REGISTER * 4 + 2] = (DiffuseColor.Z + EmissiveColor.Z) * Alpha;
+			constants[COLOR_REGISTER * 4 + 3] = Alpha;
+
+			p = pb_begin();
+			pb_push1(p, NV20_TCL_PRIMITIVE_3D_VP_UPLOAD_CONST_ID, CONSTANT_SLOT(0)); p += 2;
+			pb_push(p++, NV20_TCL_PRIMITIVE_3D_VP_UPLOAD_CONST_X, CONSTANT_REGISTER_COUNT * 4);
+			memcpy(p, constants, sizeof(constants)); p += CONSTANT_REGISTER_COUNT * 4;
+			pb_end(p);
+
+			// Another effect has overwritten the palette since this one was applied, so all of its bones go up again.
+			if (paletteOwner != this)
+			{
+				dirtyFirstBone = 0;
+				dirtyLastBone = boneCount - 1;
+				paletteOwner = this;
+			}
+
+			if (dirtyFirstBone <= dirtyLastBone)
+			{
+				UploadBones(dirtyFirstBone, dirtyLastBone);
+			}
+
+			dirtyFirstBone = MaxBones;
+			dirtyLastBone = -1;
+		}
+
+		void SkinnedEffect::OnApplyWorld(const Matrix& world)
+		{
+			float constants[16];
+
+			World = world;
+			TransposeToRegisters(Matrix::Multiply(World, viewProjection), constants);
+
+			// Everything else the program reads is still in place from OnApply, so only c0-c3 are sent.
+			DWORD* p = pb_begin();
+			pb_push1(p, NV20_TCL_PRIMITIVE_3D_VP_UPLOAD_CONST_ID, CONSTANT_SLOT(WORLDVIEWPROJECTION_REGISTER)); p += 2;
+			pb_push(p++, NV20_TCL_PRIMITIVE_3D_VP_UPLOAD_CONST_X, 16);
+			memcpy(p, constants, sizeof(constants)); p += 16;
+			pb_end(p);
+		}
+
+		void SkinnedEffect::SetBoneTransforms(Matrix boneTransforms[], const int count)
+		{
+			sassert(boneTransforms != null, String::Format("boneTransforms; %s", FrameworkResources::ArgumentNull_Generic));
+			sassert(count >= 0 && count <= MaxBones, "count; Value must be between 0 and MaxBones.");
+
+			if (boneTransforms == null || count < 0 || count > MaxBones)
+			{
+				return;
+			}
+
+			for (int i = 0; i < count; i++)
+			{
+				if (bones[i] != boneTransforms[i])
+				{
+					bones[i] = boneTransforms[i];
+
+					dirtyFirstBone = (i < dirtyFirstBone) ? i : dirtyFirstBone;
+					dirtyLastBone = (i > dirtyLastBone) ? i : dirtyLastBone;
+				}
+			}
+
+			// Palette registers past the bones that were set before hold whatever was last uploaded there.
+			if (count > boneCount)
+			{
+				dirtyFirstBone = (boneCount < dirtyFirstBone) ? boneCount : dirtyFirstBone;
+				dirtyLastBone = (count - 1 > dirtyLastBone) ? count - 1 : dirtyLastBone;
+				boneCount = count;
+			}
+		}
+
+		void SkinnedEffect::SetMatrices(const Matrix& world, const Matrix& view, const Matrix& projection)
+		{
+			World = world;
+			View = view;
+			Projection = projection;
+		}
+
+		void SkinnedEffect::SkinVertices(void const * const sourceVertices, void * const destinationVertices, const int vertexCount, const int vertexStride, VertexElement const * const elements, const int elementCount) const
+		{
+			sassert(sourceVertices != null, String::Format("sourceVertices; %s", FrameworkResources::ArgumentNull_Generic));
+			sassert(destinationVertices != null, String::Format("destinationVertices; %s", FrameworkResources::ArgumentNull_Generic));
+			sassert(elements != null, String::Format("elements; %s", FrameworkResources::ArgumentNull_Generic));
+
+			if (sourceVertices == null || destinationVertices == null || elements == null)
+			{
+				return;
+			}
+
+			int positionOffset = -1;
+			int normalOffset = -1;
+			int indicesOffset = -1;
+			int weightsOffset = -1;
+
+			for (int i = 0; i < elementCount; i++)
+			{
+				if (elements[i].UsageIndex != 0)
+				{
+					continue;
+				}
+
+				switch (elements[i].VertexElementUsage)
+				{
+				case VertexElementUsage::Position:
+					positionOffset = (elements[i].VertexElementFormat == VertexElementFormat::Vector3) ? elements[i].Offset : -1; break;
+				case VertexElementUsage::Normal:
+					normalOffset = (elements[i].VertexElementFormat == VertexElementFormat::Vector3) ? elements[i].Offset : -1; break;
+				case VertexElementUsage::BlendIndices:
+					indicesOffset = (elements[i].VertexElementFormat == VertexElementFormat::Byte4) ? elements[i].Offset : -1; break;
+				case VertexElementUsage::BlendWeight:
+					weightsOffset = (elements[i].VertexElementFormat == VertexElementFormat::Vector4) ? elements[i].Offset : -1; break;
+				default:
+					break;
+				}
+			}
+
+			sassert(positionOffset >= 0 && indicesOffset >= 0 && weightsOffset >= 0,
+				"elements; The vertices need Vector3 Position, Byte4 BlendIndices and Vector4 BlendWeight elements.");
+
+			if (positionOffset < 0 || indicesOffset < 0 || weightsOffset < 0)
+			{
+				return;
+			}
+
+			VertexSkinning::Skin(bones, MaxBones, weightsPerVertex, sourceVertices, destinationVertices, vertexCount, vertexStride,
+				positionOffset, normalOffset, indicesOffset, weightsOffset);
+		}
+
+		void SkinnedEffect::UploadBones(const int first, const int last)
+		{
+			float registers[BONES_PER_BLOCK * 12];
+
+			for (int bone = first; bone <= last; bone += BONES_PER_BLOCK)
+			{
+				const int count = (last - bone + 1 < BONES_PER_BLOCK) ? last - bone + 1 : BONES_PER_BLOCK;
+				float* r = registers;
+
+				// Like the world-view-projection matrix, each register holds a column of the bone matrix.
+				for (int i = 0; i < count; i++)
+				{
+					const float* m = &bones[bone + i].M11;
+
+					for (int column = 0; column < 3; column++, r += 4)
+					{
+						r[0] = m[column];
+						r[1] = m[column + 4];
+						r[2] = m[column + 8];
+						r[3] = m[column + 12];
+					}
+				}
+
+				const int dwords = count * 12;
+				DWORD* p = pb_begin();
+
+				pb_push1(p, NV20_TCL_PRIMITIVE_3D_VP_UPLOAD_CONST_ID, CONSTANT_SLOT(PALETTE_REGISTER + bone * 3)); p += 2;
+
+				for (int i = 0; i < dwords; i += CONSTANTS_PER_BURST)
+				{
+					const int burst = (dwords - i < CONSTANTS_PER_BURST) ? dwords - i : CONSTANTS_PER_BURST;
+
+					pb_push(p++, NV20_TCL_PRIMITIVE_3D_VP_UPLOAD_CONST_X, burst);
+					memcpy(p, &registers[i], burst * sizeof(DWORD)); p += burst;
+				}
+
+				pb_end(p);
+			}
+		}
+	}
+}
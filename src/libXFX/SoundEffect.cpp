@@ -25,20 +25,27 @@
 // ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE 
 // POSSIBILITY OF SUCH DAMAGE.
 
+#include <Audio/AudioMixer.h>
 #include <Audio/SoundEffect.h>
 #include <Audio/SoundEffectInstance.h>
+#include "WaveDecoder.h"
 
 #include <System/FrameworkResources.h>
 #include <System/Single.h>
+#include <System/String.h>
 #include <System/Type.h>
 
 #include <sassert.h>
+#include <string.h>
 
 namespace XFX
 {
 	namespace Audio
 	{
+		float SoundEffect::distanceScale = 1.0f;
+		float SoundEffect::dopplerScale = 1.0f;
 		float SoundEffect::masterVolume = 1.0f;
+		float SoundEffect::speedOfSound = 343.5f;
 
 		const Type SoundEffectTypeInfo("SoundEffect", "XFX::Audio::SoundEffect", TypeCode::Object);
 
@@ -49,11 +56,9 @@ namespace XFX
 
 		void SoundEffect::setDistanceScale(float value)
 		{
-			sassert(value >= 0, "");
-
-			value = (value <= Single::MinValue) ? Single::MinValue : value;
+			sassert(value >= 0, String::Format("value; %s", FrameworkResources::ArgumentOutOfRange_NeedNonNegNum));
 
-			// TODO: set in hardware
+			distanceScale = (value <= Single::Epsilon) ? Single::Epsilon : value;
 		}
 
 		float SoundEffect::getDopplerScale()
@@ -65,9 +70,7 @@ namespace XFX
 		{
 			sassert(value >= 0, String::Format("value; %s", FrameworkResources::ArgumentOutOfRange_NeedNonNegNum));
 		
-			dopplerScale = value;
-
-			// TODO: set in hardware
+			dopplerScale = (value < 0) ? 0 : value;
 		}
 
 		TimeSpan SoundEffect::getDuration() const
@@ -90,14 +93,70 @@ namespace XFX
 			masterVolume = value;
 		}
 
+		float SoundEffect::getSpeedOfSound()
+		{
+			return speedOfSound;
+		}
+
+		void SoundEffect::setSpeedOfSound(float value)
+		{
+			sassert(value > 0, String::Format("value; %s", FrameworkResources::ArgumentOutOfRange_NeedPosNum));
+
+			speedOfSound = (value <= Single::Epsilon) ? Single::Epsilon : value;
+		}
+
+		SoundEffect::SoundEffect(byte buffer[], const int offset, const int count, const int sampleRate, AudioChannels_t channels, const int loopStart, const int loopLength)
+			: channels(channels), decoder(null), frameCount(0), isDisposed(false), loopLength(0), loopStart(0), referenceCount(0), sampleRate(sampleRate), samples(null), volume(masterVolume)
+		{
+			const int blockAlign = channels * 2;
+
+			sassert(buffer != null, FrameworkResources::ArgumentNull_Buffer);
+
+			sassert(offset >= 0 && count >= 0, FrameworkResources::Argument_InvalidOffLen);
+
+			sassert((count % blockAlign) == 0, "Ensure that the buffer meets the block alignment requirements for the audio format.");
+
+			sassert(sampleRate >= 8000 && sampleRate <= 48000, "sampleRate; The sample rate must be between 8000 and 48000 Hz.");
+
+			sassert(loopStart >= 0 && loopLength >= 0 && loopStart + loopLength <= count / blockAlign, "The loop region must lie within the sound.");
+
+			if (buffer == null || offset < 0 || count <= 0 || sampleRate <= 0)
+			{
+				return;
+			}
+
+			frameCount = count / blockAlign;
+			samples = new short[frameCount * channels];
+			memcpy(samples, buffer + offset, frameCount * blockAlign);
+
+			if (loopStart >= 0 && loopLength > 0 && loopStart + loopLength <= frameCount)
+			{
+				this->loopStart = loopStart;
+				this->loopLength = loopLength;
+			}
+
+			duration = GetSampleDuration(count, sampleRate, channels);
+		}
+
 		SoundEffect::SoundEffect(byte buffer[], int sampleRate, AudioChannels_t numChannels)
-			: volume(masterVolume)
+			: channels(numChannels), decoder(null), frameCount(0), isDisposed(false), loopLength(0), loopStart(0), referenceCount(0), sampleRate(sampleRate), samples(null), volume(masterVolume)
 		{
 		}
 
 		SoundEffect::SoundEffect(const SoundEffect &obj)
-			: duration(obj.duration), volume(obj.volume)
+			: channels(obj.channels), decoder(null), duration(obj.duration), frameCount(obj.frameCount), isDisposed(false), loopLength(obj.loopLength), loopStart(obj.loopStart),
+			referenceCount(0), sampleRate(obj.sampleRate), samples(null), volume(obj.volume)
 		{
+			if (obj.samples != null)
+			{
+				samples = new short[frameCount * channels];
+				memcpy(samples, obj.samples, frameCount * channels * sizeof(short));
+			}
+
+			if (obj.decoder != null)
+			{
+				decoder = new WaveDecoder(*obj.decoder);
+			}
 		}
 
 		SoundEffect::~SoundEffect()
@@ -119,15 +178,89 @@ namespace XFX
 		{
 			if (!isDisposed)
 			{
-				if (disposing)
-				{
-				}
+				// Instances still playing the samples have to stop before they are freed.
+				AudioMixer::Remove(this);
+
+				delete decoder;
+				decoder = null;
+				delete[] samples;
+				samples = null;
+				frameCount = 0;
+				isDisposed = true;
 			}
 		}
 
 		SoundEffect* SoundEffect::FromStream(Stream * const stream)
 		{
-			// TODO: implement
+			return FromStream(stream, false);
+		}
+
+		SoundEffect* SoundEffect::FromStream(Stream * const stream, const bool streamed)
+		{
+			WaveDecoder decoder;
+
+			sassert(!streamed || stream == null || stream->CanSeek(), FrameworkResources::NotSupported_UnseekableStream);
+
+			if ((streamed && stream != null && !stream->CanSeek()) || !decoder.Open(stream))
+			{
+				return null;
+			}
+
+			SoundEffect* effect = new SoundEffect(null, decoder.getSampleRate(), decoder.getChannels());
+
+			if (streamed)
+			{
+				// Instances decode from their own copy of the decoder.
+				effect->decoder = new WaveDecoder(decoder);
+				effect->frameCount = decoder.getFrameCount();
+			}
+			else
+			{
+				effect->samples = new short[decoder.getFrameCount() * decoder.getChannels()];
+				effect->frameCount = decoder.Read(effect->samples, decoder.getFrameCount());
+			}
+
+			if (decoder.getLoopStart() + decoder.getLoopLength() <= effect->frameCount)
+			{
+				effect->loopStart = decoder.getLoopStart();
+				effect->loopLength = decoder.getLoopLength();
+			}
+
+			effect->duration = TimeSpan::FromTicks((effect->frameCount * TimeSpan::TicksPerSecond) / effect->sampleRate);
+
+			return effect;
+		}
+
+		TimeSpan SoundEffect::GetSampleDuration(int sizeInBytes, int sampleRate, AudioChannels_t channels)
+		{
+			sassert(sizeInBytes >= 0, String::Format("sizeInBytes; %s", FrameworkResources::ArgumentOutOfRange_NeedNonNegNum));
+
+			sassert(sampleRate > 0, String::Format("sampleRate; %s", FrameworkResources::ArgumentOutOfRange_NeedPosNum));
+
+			if (sizeInBytes <= 0 || sampleRate <= 0)
+			{
+				return TimeSpan::Zero;
+			}
+
+			const long long frames = sizeInBytes / (channels * 2);
+
+			return TimeSpan::FromTicks((frames * TimeSpan::TicksPerSecond) / sampleRate);
+		}
+
+		int SoundEffect::GetSampleSizeInBytes(TimeSpan duration, int sampleRate, AudioChannels_t channels)
+		{
+			sassert(duration.Ticks() >= 0, String::Format("duration; %s", FrameworkResources::ArgumentOutOfRange_NeedNonNegNum));
+
+			sassert(sampleRate > 0, String::Format("sampleRate; %s", FrameworkResources::ArgumentOutOfRange_NeedPosNum));
+
+			if (duration.Ticks() <= 0 || sampleRate <= 0)
+			{
+				return 0;
+			}
+
+			const long long frames = (duration.Ticks() * sampleRate) / TimeSpan::TicksPerSecond;
+
+			return (int)frames * channels * 2;
 		}
 
 		const Type& SoundEffect::GetType()
@@ -137,16 +270,25 @@ namespace XFX
 
 		bool SoundEffect::Play()
 		{
-			SoundEffectInstance(this, true).Play();
+			return Play(1.0f, 0.0f, 0.0f);
 		}
 
 		bool SoundEffect::Play(float volume, float pitch, float pan)
 		{
-			SoundEffectInstance sei(this, true);
-			sei.setPan(pan);
-			sei.setPitch(pitch);
-			sei.setVolume(volume);
-			sei.Play();
+			SoundEffectInstance* sei = new SoundEffectInstance(this, true);
+			sei->setPan(pan);
+			sei->setPitch(pitch);
+			sei->setVolume(volume);
+			sei->_state = SoundState::Playing;
+
+			// Once added, the instance belongs to the mixer, which deletes it when it has played to the end.
+			if (!AudioMixer::Add(sei))
+			{
+				delete sei;
+				return false;
+			}
+
+			return true;
 		}
 	}
 }
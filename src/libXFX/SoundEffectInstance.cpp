@@ -4,14 +4,14 @@
 // Redistribution and use in source and binary forms, with or without 
 // modification, are permitted provided that the following conditions are met:
 // 
-//     * Redistributions of source code must retain the above copyright 
-//       notice, this list of conditions and the following disclaimer.
-//     * Redistributions in binary form must reproduce the above copyright 
-//       notice, this list of conditions and the following disclaimer in the 
-//       documentation and/or other materials provided with the distribution.
-//     * Neither the name of the copyright holder nor the names of any 
-//       contributors may be used to endorse or promote products derived from 
-//       this software without specific prior written permission.
+//* Redistributions of source code must retain the above copyright 
+//notice, this list of conditions and the following disclaimer.
+//* Redistributions in binary form must reproduce the above copyright 
+//notice, this list of conditions and the following disclaimer in the 
+//documentation and/or other materials provided with the distribution.
+//* Neither the name of the copyright holder nor the names of any 
+//contributors may be used to endorse or promote products derived from 
+//this software without specific prior written permission.
 // 
 // THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
 // AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
@@ -25,15 +25,23 @@
 // ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE 
 // POSSIBILITY OF SUCH DAMAGE.
 
+#include <Audio/AudioMixer.h>
 #include <Audio/SoundEffectInstance.h>
 #include <Audio/AudioEmitter.h>
 #include <Audio/AudioListener.h>
 #include <Audio/SoundEffect.h>
+#include "WaveDecoder.h"
+#include <System/FrameworkResources.h>
+#include <System/String.h>
+
+#include <sassert.h>
+#include <string.h>
 
 namespace XFX
 {
 	namespace Audio
 	{
+		const Type AudioEmitter::AudioEmitterTypeInfo = Type("AudioEmitter", "XFX::Audio::AudioEmitter", TypeCode::Object);
 		const Type SoundEffectInstanceTypeInfo("SoundEffectInstance", "XFX::Audio::SoundEffectInstance", TypeCode::Object);
 
 		bool SoundEffectInstance::IsDisposed() const
@@ -43,37 +51,41 @@ namespace XFX
 
 		bool SoundEffectInstance::IsLooped() const
 		{
-			// TODO: implement
+			return _isLooped;
 		}
 
 		void SoundEffectInstance::IsLooped(bool value)
 		{
-			// TODO: implement
+			_isLooped = value;
 		}
 
 		float SoundEffectInstance::getPan() const
 		{
-			// TODO: implement
+			return _pan;
 		}
 
 		void SoundEffectInstance::setPan(float value)
 		{
-			// TODO: implement
+			sassert(value >= -1.0f && value <= 1.0f, "value; Pan must be between -1.0 and 1.0.");
+
+			_pan = (value < -1.0f) ? -1.0f : ((value > 1.0f) ? 1.0f : value);
 		}
 
 		float SoundEffectInstance::getPitch() const
 		{
-			// TODO: implement
+			return _pitch;
 		}
 
 		void SoundEffectInstance::setPitch(float value)
 		{
-			// TODO: implement
+			sassert(value >= -1.0f && value <= 1.0f, "value; Pitch must be between -1.0 and 1.0.");
+
+			_pitch = (value < -1.0f) ? -1.0f : ((value > 1.0f) ? 1.0f : value);
 		}
 
 		SoundState_t SoundEffectInstance::getState() const
 		{
-			// TODO: implement
+			return _state;
 		}
 
 		float SoundEffectInstance::getVolume() const
@@ -83,28 +95,92 @@ namespace XFX
 
 		void SoundEffectInstance::setVolume(float value)
 		{
-			// TODO: implement
+			sassert(value >= 0.0f && value <= 1.0f, "value; Volume must be between 0.0 and 1.0.");
+
+			_volume = (value < 0.0f) ? 0.0f : ((value > 1.0f) ? 1.0f : value);
+		}
+
+		SoundEffectInstance::SoundEffectInstance()
+			: _channels(AudioChannels::Mono), _decoder(null), _distanceGain(1.0f), _dopplerFactor(1.0f), _fireAndForget(false), _isLooped(false), _pan(0.0f), _parent(null),
+			_pitch(0.0f), _positionalPan(0.0f), _readPosition(0), _sampleRate(AudioMixer::SampleRate), _state(SoundState::Stopped), _volume(1.0f)
+		{
 		}
 
 		SoundEffectInstance::SoundEffectInstance(SoundEffect * const parent, bool fireAndForget)
-			: _parent(parent), _volume(parent->volume)
+			: _channels(parent->channels), _decoder(null), _distanceGain(1.0f), _dopplerFactor(1.0f), _fireAndForget(fireAndForget), _isLooped(false), _pan(0.0f), _parent(parent),
+			_pitch(0.0f), _positionalPan(0.0f), _readPosition(0), _sampleRate(parent->sampleRate), _state(SoundState::Stopped), _volume(1.0f)
 		{
 			_parent->referenceCount++;
+
+			// A streamed sound is decoded by each of its instances as it plays.
+			if (parent->decoder != null)
+			{
+				_decoder = new WaveDecoder(*parent->decoder);
+			}
 		}
 
 		SoundEffectInstance::~SoundEffectInstance()
 		{
-			_parent->referenceCount--;
+			AudioMixer::Remove(this);
+
+			delete _decoder;
+
+			if (_parent != null)
+			{
+				_parent->referenceCount--;
+			}
 		}
 
 		void SoundEffectInstance::Apply3D(AudioListener listener, AudioEmitter emitter)
 		{
-			// TODO: implement
+			const Vector3 offset = Vector3::Subtract(emitter.Position, listener.Position);
+			const float distance = offset.Length();
+			const float distanceScale = SoundEffect::getDistanceScale();
+
+			// Full volume within DistanceScale of the listener, falling off with the inverse of the distance beyond it.
+			_distanceGain = (distance > distanceScale) ? distanceScale / distance : 1.0f;
+
+			if (distance < 1e-6f)
+			{
+				_positionalPan = 0.0f;
+				_dopplerFactor = 1.0f;
+				return;
+			}
+
+			const Vector3 direction = Vector3::Divide(offset, distance);
+			Vector3 right = Vector3::Cross(listener.Forward, listener.Up);
+
+			if (right.LengthSquared() > 1e-12f)
+			{
+				right.Normalize();
+				_positionalPan = Vector3::Dot(direction, right);
+			}
+			else
+			{
+				_positionalPan = 0.0f;
+			}
+
+			// Speeds are positive towards the other party, and kept below half the speed of sound so that the shift stays within two octaves.
+			const float speedOfSound = SoundEffect::getSpeedOfSound();
+			const float scale = SoundEffect::getDopplerScale() * emitter.DopplerScale;
+			const float limit = speedOfSound * 0.5f;
+			float listenerSpeed = scale * Vector3::Dot(listener.Velocity, direction);
+			float emitterSpeed = -scale * Vector3::Dot(emitter.Velocity, direction);
+
+			listenerSpeed = (listenerSpeed < -limit) ? -limit : ((listenerSpeed > limit) ? limit : listenerSpeed);
+			emitterSpeed = (emitterSpeed < -limit) ? -limit : ((emitterSpeed > limit) ? limit : emitterSpeed);
+
+			_dopplerFactor = (speedOfSound + listenerSpeed) / (speedOfSound - emitterSpeed);
 		}
 
 		void SoundEffectInstance::Apply3D(AudioListener listeners[], AudioEmitter emitter)
 		{
-			// TODO: implement
+			sassert(listeners != null, String::Format("listeners; %s", FrameworkResources::ArgumentNull_Generic));
+
+			if (listeners != null)
+			{
+				Apply3D(listeners[0], emitter);
+			}
 		}
 
 		void SoundEffectInstance::Dispose()
@@ -116,7 +192,8 @@ namespace XFX
 		{
 			if (disposing)
 			{
-				
+				AudioMixer::Remove(this);
+				_state = SoundState::Stopped;
 			}
 		}
 
@@ -127,17 +204,107 @@ namespace XFX
 
 		void SoundEffectInstance::Pause()
 		{
-			// TODO: implement
+			if (_state == SoundState::Playing)
+			{
+				_state = SoundState::Paused;
+			}
 		}
 
 		void SoundEffectInstance::Play()
 		{
-			// TODO: implement
+			if (_state == SoundState::Paused)
+			{
+				Resume();
+				return;
+			}
+
+			if (_state == SoundState::Playing)
+			{
+				return;
+			}
+
+			_readPosition = 0;
+			_state = SoundState::Playing;
+
+			if (_decoder != null)
+			{
+				_decoder->Seek(0);
+			}
+
+			if (!AudioMixer::Add(this))
+			{
+				_state = SoundState::Stopped;
+			}
+		}
+
+		int SoundEffectInstance::ReadFrames(short destination[], const int count)
+		{
+			if (_parent == null || (_parent->samples == null && _parent->decoder == null))
+			{
+				return 0;
+			}
+
+			const int channels = _channels;
+			const bool looped = _isLooped;
+			const int loopStart = (_parent->loopLength > 0) ? _parent->loopStart : 0;
+			const int loopEnd = (_parent->loopLength > 0) ? loopStart + _parent->loopLength : _parent->frameCount;
+			const int end = looped ? loopEnd : _parent->frameCount;
+			int read = 0;
+
+			while (read < count)
+			{
+				if (_readPosition >= end)
+				{
+					if (!looped || loopEnd <= loopStart)
+					{
+						break;
+					}
+
+					_readPosition = loopStart;
+
+					if (_decoder != null)
+					{
+						_decoder->Seek(loopStart);
+					}
+				}
+
+				int frames = end - _readPosition;
+
+				if (frames > count - read)
+				{
+					frames = count - read;
+				}
+
+				if (_decoder != null)
+				{
+					const int decoded = _decoder->Read(destination + (read * channels), frames);
+
+					read += decoded;
+					_readPosition += decoded;
+
+					// The stream ended early.
+					if (decoded < frames)
+					{
+						break;
+					}
+
+					continue;
+				}
+
+				memcpy(destination + (read * channels), _parent->samples + (_readPosition * channels), frames * channels * sizeof(short));
+				read += frames;
+				_readPosition += frames;
+			}
+
+			return read;
 		}
 
 		void SoundEffectInstance::Resume()
 		{
-			// TODO: implement
+			if (_state == SoundState::Paused)
+			{
+				_state = SoundState::Playing;
+			}
 		}
 
 		void SoundEffectInstance::Stop()
@@ -147,7 +314,15 @@ namespace XFX
 
 		void SoundEffectInstance::Stop(bool immediate)
 		{
-			// TODO: implement
+			if (!immediate && _state == SoundState::Playing)
+			{
+				// Stopping as authored lets the sound play out its loop and then end.
+				_isLooped = false;
+				return;
+			}
+
+			AudioMixer::Remove(this);
+			_state = SoundState::Stopped;
 		}
 	}
 }
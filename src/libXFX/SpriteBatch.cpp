@@ -27,7 +27,11 @@
 
 extern "C"
 {
-#include "pbkit.h"
+#include "pbKit.h"
+#include "nv_objects.h"
+#if ENABLE_XBOX
+#include <xboxkrnl/xboxkrnl.h>
+#endif
 }
 
 #include <Graphics/Color.h>
@@ -44,17 +48,65 @@ extern "C"
 
 #include <sassert.h>
 
+#include <System/FrameworkResources.h>
+#include <System/Math.h>
 #include <System/Type.h>
 
+#include <stddef.h>
+#include <stdlib.h>
+
+// NV2A vertex attribute formats: type in bits 0-3, component count in bits 4-7, stride in bits 8-31.
+// A float attribute with no components is disabled.
+#define VERTEX_ATTR_UB_D3D		0
+#define VERTEX_ATTR_FLOAT		2
+#define VERTEX_ATTR_DISABLED	VERTEX_ATTR_FLOAT
+#define VERTEX_ATTR(type, size, stride) ((type) | ((size) << 4) | ((stride) << 8))
+
 namespace XFX
 {
 	namespace Graphics
 	{
 		const Type SpriteBatchTypeInfo("SpriteBatch", "XFX::Graphics::SpriteBatch", TypeCode::Object);
 
+		// Selects the radix sort key of a queued sprite for the depth sorted SpriteSortModes.
+		struct DepthKeySelector
+		{
+			const List<Sprite>& sprites;
+			const float sign;
+
+			DepthKeySelector(const List<Sprite>& sprites, const float sign)
+				: sprites(sprites), sign(sign)
+			{
+			}
+
+			inline float operator()(const int index) const { return sign * sprites[index].LayerDepth(); }
+		};
+
+		// Selects the radix sort key of a queued sprite for SpriteSortMode::Texture.
+		struct TextureKeySelector
+		{
+			const List<Sprite>& sprites;
+
+			TextureKeySelector(const List<Sprite>& sprites)
+				: sprites(sprites)
+			{
+			}
+
+			inline uint operator()(const int index) const { return (uint)(size_t)sprites[index].getTexture(); }
+		};
+
 		SpriteBatch::SpriteBatch(GraphicsDevice * const graphicsDevice)
+			: vertexBufferPosition(0), currentTexture(null), inBeginEndPair(false), saveState(null), spriteSortMode(SpriteSortMode::Deferred), spriteQueueCount(0),
+			  blendState(null), samplerState(null), depthStencilState(null), rasterizerState(null)
 		{
 			this->graphicsDevice = graphicsDevice;
+
+			// The GPU reads the vertices straight from this buffer, so on the Xbox it has to live in physically contiguous, write-combined memory.
+#if ENABLE_XBOX
+			vertexBuffer = (SpriteVertex*)MmAllocateContiguousMemoryEx(MaxBatchSize * 4 * sizeof(SpriteVertex), 0, 0x03FFAFFF, 0, PAGE_READWRITE | PAGE_WRITECOMBINE);
+#else
+			vertexBuffer = (SpriteVertex*)malloc(MaxBatchSize * 4 * sizeof(SpriteVertex));
+#endif
 		}
 
 		SpriteBatch::~SpriteBatch()
@@ -69,17 +121,17 @@ namespace XFX
 
 		void SpriteBatch::Begin(SpriteSortMode_t sortMode, const BlendState& blendState)
 		{
-
+			Begin(sortMode, blendState, SamplerState::LinearClamp, DepthStencilState::None, RasterizerState::CullCounterClockwise, null, Matrix::Identity);
 		}
 
 		void SpriteBatch::Begin(SpriteSortMode_t sortMode, const BlendState& blendState, const SamplerState& samplerState, const DepthStencilState& depthStencilState, const RasterizerState& rasterizerState)
 		{
-
+			Begin(sortMode, blendState, samplerState, depthStencilState, rasterizerState, null, Matrix::Identity);
 		}
 
 		void SpriteBatch::Begin(SpriteSortMode_t sortMode, const BlendState& blendState, const SamplerState& samplerState, const DepthStencilState& depthStencilState, const RasterizerState& rasterizerState, Effect* effect)
 		{
-
+			Begin(sortMode, blendState, samplerState, depthStencilState, rasterizerState, effect, Matrix::Identity);
 		}
 
 		void SpriteBatch::Begin(SpriteSortMode_t sortMode, const BlendState& blendState, const SamplerState& samplerState, const DepthStencilState& depthStencilState, const RasterizerState& rasterizerState, Effect* effect, Matrix transformMatrix)
@@ -87,6 +139,10 @@ namespace XFX
 			sassert(!inBeginEndPair, "Begin cannot be called again until End has been successfully called.");
 
 			spriteSortMode = sortMode;
+			this->blendState = &blendState;
+			this->samplerState = &samplerState;
+			this->depthStencilState = &depthStencilState;
+			this->rasterizerState = &rasterizerState;
 
 			if (sortMode == SpriteSortMode::Immediate)
 			{
@@ -103,6 +159,18 @@ namespace XFX
 				// TODO: dispose of resources
 			}
 
+			if (vertexBuffer != null)
+			{
+				// Make sure the GPU is no longer reading from the ring buffer before releasing it.
+				while (pb_busy());
+#if ENABLE_XBOX
+				MmFreeContiguousMemory(vertexBuffer);
+#else
+				free(vertexBuffer);
+#endif
+				vertexBuffer = null;
+			}
+
 			GraphicsResource::Dispose(disposing);
 		}
 
@@ -130,6 +198,13 @@ namespace XFX
 
 		void SpriteBatch::Draw(Texture2D * const texture, const Rectangle destinationRectangle, const Nullable<Rectangle> sourceRectangle, const Color color, const float rotation, const Vector2 origin, const SpriteEffects_t effects, const float layerDepth)
 		{
+			sassert(texture != null, String::Format("texture; %s", FrameworkResources::ArgumentNull_Generic));
+
+			if (texture == null)
+			{
+				return;
+			}
+
 			Sprite sprite = Sprite(texture, 
 				sourceRectangle.HasValue() ? sourceRectangle.getValue() : Rectangle(0, 0, texture->Width, texture->Height), 
 				destinationRectangle, 
@@ -238,48 +313,22 @@ namespace XFX
 	
 		void SpriteBatch::applyGraphicsDeviceSettings() 
 		{
-			DWORD* p;
+			// The device drops every register that already holds the requested value, so applying the same states on each End is cheap.
+			graphicsDevice->setBlendState(blendState);
+			graphicsDevice->setDepthStencilState(depthStencilState);
+			graphicsDevice->setRasterizerState(rasterizerState);
+			graphicsDevice->ApplySamplerState(0, samplerState);
 
-			p = pb_begin();
+			// Sprites are drawn by the fixed function pipeline, which a SkinnedEffect may have replaced with its vertex program.
+			DWORD* p = pb_begin();
 
-			
+			if (graphicsDevice->UpdateRenderState(NV20_TCL_PRIMITIVE_3D_SHADER_TYPE, SHADER_TYPE_INTERNAL))
+			{
+				pb_push1(p, NV20_TCL_PRIMITIVE_3D_SHADER_TYPE, SHADER_TYPE_INTERNAL); p += 2;
+			}
 
 			pb_end(p);
 
-            // Set the blend mode 
-     //       switch (spriteBlendMode) 
-     //       { 
-     //           case SpriteBlendMode::AlphaBlend: 
-     //               p = pb_begin();
-					////Enable blending
-					//pb_push(p, NV20_TCL_PRIMITIVE_3D_BLEND_FUNC_ENABLE, 1); p+=2;
-					////set blendmode
-					//pb_push2(p, NV20_TCL_PRIMITIVE_3D_BLEND_FUNC_SRC, (0x302<<16) | 0x302, (0x303<<16) | 0x303); p+=3;
-					////send data to GPU
-					//pb_end(p);
-     //               break; 
-     //           case SpriteBlendMode::Additive:
-					//p = pb_begin();
-					////Enable blending
-					//pb_push(p, NV20_TCL_PRIMITIVE_3D_BLEND_FUNC_ENABLE, 1); p+=2;
-					////set blendmode
-					//pb_push2(p, NV20_TCL_PRIMITIVE_3D_BLEND_FUNC_SRC, (0x302<<16) | 0x302, (1<<16) | 1); p+=3;
-					////send data to GPU
-					//pb_end(p);
-     //               break; 
-     //           case SpriteBlendMode::None: 
-     //               p = pb_begin();
-					////Disable Blending
-					//pb_push(p, NV20_TCL_PRIMITIVE_3D_BLEND_FUNC_ENABLE, 0); p+=2;
-					////send data to GPU
-					//pb_end(p);
-     //               break; 
-     //           default: 
-     //               return; 
-     //       } 
-                          
-            //glEnable(GL_TEXTURE_2D); 
-  
             // Reset the projection matrix and use the orthographic matrix 
             /*int viewPort[4]; 
             glGetIntegerv(GL_VIEWPORT, viewPort); 
@@ -292,90 +341,256 @@ namespace XFX
             glLoadIdentity();*/
         }
 
+		void SpriteBatch::DrawBatch(const int firstVertex, const int vertexCount)
+		{
+			DWORD* p = pb_begin();
+			int batches = (vertexCount + MaxVerticesPerBatch - 1) / MaxVerticesPerBatch;
+
+			pb_push1(p, NV20_TCL_PRIMITIVE_3D_BEGIN_END, QUADS); p += 2;
+
+			// Each VB_VERTEX_BATCH entry draws up to 256 vertices from the bound arrays, starting at the given vertex.
+			pb_push(p++, 0x40000000 | NV20_TCL_PRIMITIVE_3D_VB_VERTEX_BATCH, batches);
+
+			for (int first = firstVertex, remaining = vertexCount; remaining > 0; first += MaxVerticesPerBatch, remaining -= MaxVerticesPerBatch)
+			{
+				int count = (remaining < MaxVerticesPerBatch) ? remaining : MaxVerticesPerBatch;
+				*(p++) = ((count - 1) << 24) | first;
+			}
+
+			pb_push1(p, NV20_TCL_PRIMITIVE_3D_BEGIN_END, STOP); p += 2;
+
+			pb_end(p);
+		}
+
 		void SpriteBatch::Flush()
-        {
-			DWORD* p;
+		{
+			int count = SpriteList.Count();
 
+			if (count == 0)
+			{
+				return;
+			}
+
+			// Sprites are sorted through an index list so that the sort only moves ints around.
+			sortIndices.Clear();
+
+			for (int i = 0; i < count; i++)
+			{
+				if (SpriteList[i].getColor().A() > 0)
+				{
+					sortIndices.Add(i);
+				}
+			}
+
+			// The radix sort is stable, so sprites with equal keys keep the order in which they were drawn.
 			switch (spriteSortMode)
 			{
 			case SpriteSortMode::BackToFront:
-				//SpriteList.Sort(BackToFrontSpriteComparer<Sprite>());
+				sortIndices.RadixSort(DepthKeySelector(SpriteList, -1.0f));
 				break;
 			case SpriteSortMode::FrontToBack:
-				//SpriteList.Sort(FrontToBackSpriteComparer<Sprite>());
+				sortIndices.RadixSort(DepthKeySelector(SpriteList, 1.0f));
 				break;
-			case SpriteSortMode::Texture: // nothing here?
+			case SpriteSortMode::Texture:
+				sortIndices.RadixSort(TextureKeySelector(SpriteList));
+				break;
+			default:
 				break;
 			}
-			for (int i = 0; i < SpriteList.Count(); i++)
+
+			count = sortIndices.Count();
+
+			// Point the position, color and texture coordinate arrays at the ring buffer; the draws below only pass vertex offsets.
+			// These rarely change between flushes, so they go through the device's state shadow and are normally dropped.
+			DWORD address = (DWORD)(size_t)vertexBuffer & 0x03FFFFFF;
+			DWORD* p = pb_begin();
+
+			for (int i = 0; i < NV20_TCL_PRIMITIVE_3D_VERTEX_ATTR__SIZE; i++)
 			{
-				// Set the color, bind the texture for drawing and prepare the texture source
-				if (SpriteList[i].getColor().A() <= 0) continue;
-				//glColor4f((float)sprite.Color_().R() / 255f, (float)sprite.getColor().G() / 255f, (float)sprite.getColor().B() / 255f, (float)sprite.getColor().A() / 255f);
-				//glBindTexture(GL_TEXTURE_2D, sprite.getTexture().textureId);
-				// Setup the matrix
-				//if ((SpriteList[i].DestinationRectangle().X != 0) || (SpriteList[i].DestinationRectangle().Y != 0))
-				//	glTranslatef(SpriteList[i].DestinationRectangle().X, SpriteList[i].DestinationRectangle().Y, 0.0f); // Position
-
-				//if (SpriteList[i].Rotation() != 0)
-				//	glRotatef(MathHelper::ToDegrees(SpriteList[i].Rotation()), 0.0f, 0.0f, 1.0f); // Rotation
-
-				/*if ((SpriteList[i].DestinationRectangle().Width != 0 && SpriteList[i].Origin().X != 0) || (SpriteList[i].DestinationRectangle().Height != 0 && SpriteList[i].Origin().Y != 0))
-					glTranslatef(
-					// Orientation
-					-SpriteList[i].Origin.X * (float)SpriteList[i].DestinationRectangle().Width / (float)SpriteList[i].SourceRectangle().Width,
-					-SpriteList[i].Origin.Y * (float)SpriteList[i].DestinationRectangle().Height / (float)SpriteList[i].SourceRectangle().Height, 0.0f);*/
-				// Calculate the points on the texture
-				float x = (float)SpriteList[i].SourceRectangle().X / (float)SpriteList[i].getTexture()->Width;
-				float y = (float)SpriteList[i].SourceRectangle().Y / (float)SpriteList[i].getTexture()->Height;
-				float twidth = (float)SpriteList[i].SourceRectangle().Width / (float)SpriteList[i].getTexture()->Width;
-				float theight = (float)SpriteList[i].SourceRectangle().Height / (float)SpriteList[i].getTexture()->Height;
-
-				p = pb_begin();
-				pb_push1(p, NV20_TCL_PRIMITIVE_3D_BEGIN_END, QUADS); p+=2;
-				pb_push(p++, (0x40000000 | NV20_TCL_PRIMITIVE_3D_VERTEX_DATA), 16);
-
-				*((float *)(p++)) = 0.0f;
-				*((float *)(p++)) = 0.0f;
-				*((float *)(p++)) = x;
-				*((float *)(p++)) = y;
-
-				*((float *)(p++)) = SpriteList[i].DestinationRectangle().Width;
-				*((float *)(p++)) = 0.0f;
-				*((float *)(p++)) = x + twidth;
-				*((float *)(p++)) = y;
-
-				*((float *)(p++)) = SpriteList[i].DestinationRectangle().Width;
-				*((float *)(p++)) = SpriteList[i].DestinationRectangle().Height;
-				*((float *)(p++)) = x + twidth;
-				*((float *)(p++)) = y + theight;
-
-				*((float *)(p++)) = 0.0f;
-				*((float *)(p++)) = SpriteList[i].DestinationRectangle().Height;
-				*((float *)(p++)) = x;
-				*((float *)(p++)) = y + theight;
-
-				pb_push(p++, NV20_TCL_PRIMITIVE_3D_BEGIN_END, 1);
-				*(p++) = STOP;
-
-				pb_end(p);
-
-				// Draw
-				/*glBegin(GL_QUADS);
+				DWORD format;
+
+				switch (i)
 				{
-					glTexCoord2f(x,y + theight);
-					glVertex2f(0f, SpriteList[i].DestinationRectangle().Height);
-					glTexCoord2f(x + twidth, y + theight);
-					glVertex2f(SpriteList[i].DestinationRectangle().Width, SpriteList[i].DestinationRectangle().Height);
-					glTexCoord2f(x + twidth,y);
-					glVertex2f(SpriteList[i].DestinationRectangle().Width, 0f);
-					glTexCoord2f(x,y);
-					glVertex2f(0f, 0f);
+				case 0:
+					format = VERTEX_ATTR(VERTEX_ATTR_FLOAT, 3, sizeof(SpriteVertex));
+					break;
+				case 3:
+					format = VERTEX_ATTR(VERTEX_ATTR_UB_D3D, 4, sizeof(SpriteVertex));
+					break;
+				case 8:
+					format = VERTEX_ATTR(VERTEX_ATTR_FLOAT, 2, sizeof(SpriteVertex));
+					break;
+				default:
+					format = VERTEX_ATTR_DISABLED;
+					break;
+				}
+
+				if (graphicsDevice->UpdateRenderState(NV20_TCL_PRIMITIVE_3D_VERTEX_ATTR(i), format))
+				{
+					pb_push1(p, NV20_TCL_PRIMITIVE_3D_VERTEX_ATTR(i), format); p += 2;
 				}
-				glEnd();
-				glPopMatrix(); // Finish with the matrix*/
 			}
-			SpriteList.Clear();  
-        }
+
+			const DWORD pointers[][2] =
+			{
+				{ NV20_TCL_PRIMITIVE_3D_VB_POINTER_ATTR0_POS, address + (DWORD)offsetof(SpriteVertex, X) },
+				{ NV20_TCL_PRIMITIVE_3D_VB_POINTER_ATTR3_COL, address + (DWORD)offsetof(SpriteVertex, Color) },
+				{ NV20_TCL_PRIMITIVE_3D_VB_POINTER_ATTR8_TX0, address + (DWORD)offsetof(SpriteVertex, U) }
+			};
+
+			for (int i = 0; i < 3; i++)
+			{
+				if (graphicsDevice->UpdateRenderState(pointers[i][0], pointers[i][1]))
+				{
+					pb_push1(p, pointers[i][0], pointers[i][1]); p += 2;
+				}
+			}
+
+			pb_end(p);
+
+			currentTexture = null;
+
+			for (int i = 0; i < count; )
+			{
+				// Consecutive sprites that share a texture are drawn together.
+				Texture2D* texture = SpriteList[sortIndices[i]].getTexture();
+				int end = i + 1;
+
+				while (end < count && SpriteList[sortIndices[end]].getTexture() == texture)
+				{
+					end++;
+				}
+
+				SetTexture(texture);
+
+				while (i < end)
+				{
+					if (vertexBufferPosition == MaxBatchSize)
+					{
+						// Wrap around once the GPU has consumed everything queued so far.
+						while (pb_busy());
+						vertexBufferPosition = 0;
+					}
+
+					int batchSize = end - i;
+
+					if (batchSize > MaxBatchSize - vertexBufferPosition)
+					{
+						batchSize = MaxBatchSize - vertexBufferPosition;
+					}
+
+					SpriteVertex* vertices = &vertexBuffer[vertexBufferPosition * 4];
+
+					for (int j = 0; j < batchSize; j++, vertices += 4)
+					{
+						WriteSprite(SpriteList[sortIndices[i + j]], vertices);
+					}
+
+					DrawBatch(vertexBufferPosition * 4, batchSize * 4);
+
+					vertexBufferPosition += batchSize;
+					i += batchSize;
+				}
+			}
+
+			SpriteList.Clear();
+		}
+
+		void SpriteBatch::SetTexture(Texture2D * const texture)
+		{
+			sassert(texture != null, String::Format("texture; %s", FrameworkResources::ArgumentNull_Generic));
+
+			if (texture == null || texture == currentTexture)
+			{
+				return;
+			}
+
+			currentTexture = texture;
+
+			// Textures are stored as linear A8R8G8B8, which the NV2A samples with texel rather than normalized coordinates.
+			const DWORD registers[][2] =
+			{
+				{ NV20_TCL_PRIMITIVE_3D_TX_OFFSET(0), (DWORD)(size_t)texture->textureData & 0x03FFFFFF },
+				{ NV20_TCL_PRIMITIVE_3D_TX_FORMAT(0), 0x0001122a },
+				{ NV20_TCL_PRIMITIVE_3D_TX_ENABLE(0), 0x4003ffc0 },
+				{ NV20_TCL_PRIMITIVE_3D_TX_NPOT_PITCH(0), (DWORD)(texture->Width * 4) << 16 },
+				{ NV20_TCL_PRIMITIVE_3D_TX_NPOT_SIZE(0), (DWORD)(texture->Width << 16) | texture->Height }
+			};
+			DWORD* p = pb_begin();
+
+			for (int i = 0; i < 5; i++)
+			{
+				if (graphicsDevice->UpdateRenderState(registers[i][0], registers[i][1]))
+				{
+					pb_push1(p, registers[i][0], registers[i][1]); p += 2;
+				}
+			}
+
+			pb_end(p);
+		}
+
+		void SpriteBatch::WriteSprite(const Sprite& sprite, SpriteVertex * const vertices)
+		{
+			Rectangle destination = sprite.DestinationRectangle();
+			Rectangle source = sprite.SourceRectangle();
+			Vector2 origin = sprite.Origin();
+			float rotation = sprite.Rotation();
+			SpriteEffects_t effects = sprite.Effects();
+
+			// The origin is given in source texels; scale it to the size the sprite is drawn at.
+			float scaleX = (source.Width != 0) ? (float)destination.Width / source.Width : 0.0f;
+			float scaleY = (source.Height != 0) ? (float)destination.Height / source.Height : 0.0f;
+			float left = -origin.X * scaleX;
+			float top = -origin.Y * scaleY;
+			float right = left + destination.Width;
+			float bottom = top + destination.Height;
+
+			float cornersX[4] = { left, right, right, left };
+			float cornersY[4] = { top, top, bottom, bottom };
+
+			float u0 = (float)source.X;
+			float v0 = (float)source.Y;
+			float u1 = u0 + source.Width;
+			float v1 = v0 + source.Height;
+
+			if (effects & SpriteEffects::FlipHorizontally)
+			{
+				float temp = u0;
+				u0 = u1;
+				u1 = temp;
+			}
+
+			if (effects & SpriteEffects::FlipVertically)
+			{
+				float temp = v0;
+				v0 = v1;
+				v1 = temp;
+			}
+
+			float cornersU[4] = { u0, u1, u1, u0 };
+			float cornersV[4] = { v0, v0, v1, v1 };
+
+			float cos = 1.0f;
+			float sin = 0.0f;
+
+			if (rotation != 0.0f)
+			{
+				cos = (float)Math::Cos(rotation);
+				sin = (float)Math::Sin(rotation);
+			}
+
+			uint color = sprite.getColor().PackedValue();
+			float depth = sprite.LayerDepth();
+
+			for (int i = 0; i < 4; i++)
+			{
+				vertices[i].X = destination.X + cornersX[i] * cos - cornersY[i] * sin;
+				vertices[i].Y = destination.Y + cornersX[i] * sin + cornersY[i] * cos;
+				vertices[i].Z = depth;
+				vertices[i].Color = color;
+				vertices[i].U = cornersU[i];
+				vertices[i].V = cornersV[i];
+			}
+		}
 	}
 }
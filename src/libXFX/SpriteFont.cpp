@@ -27,7 +27,6 @@
 
 #include <Graphics/SpriteBatch.h>
 #include <Graphics/SpriteFont.h>
-#include <Matrix.h>
 #include <System/Array.h>
 #include <System/FrameworkResources.h>
 #include <System/Math.h>
@@ -35,138 +34,261 @@
 
 #include <sassert.h>
 
+#include "TextLayoutCache.h"
+
 namespace XFX
 {
 	namespace Graphics
 	{
 		SpriteFont::SpriteFont(Texture2D * const texture, const List<Rectangle>& glyphs, const List<Rectangle>& cropping, const List<char>& charMap, const int lineSpacing, const float spacing, const List<Vector3>& kerning)
-			: characterMap(charMap), croppingData(cropping), glyphData(glyphs), kerning(kerning), textureValue(texture)
+			: glyphCount(charMap.Count()), lineSpacing(lineSpacing), spacing(spacing), textureValue(texture), layoutCache(new TextLayoutCache(TextLayoutCache::DefaultCapacity)), Spacing(spacing)
 		{
-			this->lineSpacing = lineSpacing;
-			this->spacing = spacing;
+			sassert(glyphs.Count() == glyphCount && cropping.Count() == glyphCount && kerning.Count() == glyphCount, "The glyph, cropping, character and kerning lists of a font must have the same length.");
+
+			this->glyphs = new Glyph[glyphCount];
+
+			for (int i = 0; i < 256; i++)
+			{
+				characterIndices[i] = -1;
+			}
+
+			for (int i = 0; i < glyphCount; i++)
+			{
+				this->glyphs[i].Bounds = glyphs[i];
+				this->glyphs[i].Cropping = cropping[i];
+				this->glyphs[i].LeftSideBearing = kerning[i].X;
+				this->glyphs[i].Width = kerning[i].Y;
+				this->glyphs[i].RightSideBearing = kerning[i].Z;
+
+				characterIndices[(byte)charMap[i]] = (short)i;
+			}
 		}
 
 		SpriteFont::~SpriteFont()
 		{
+			delete layoutCache;
+			delete[] glyphs;
 			delete textureValue;
 		}
 
-		void SpriteFont::Draw(String& text, SpriteBatch * const spriteBatch, const Vector2 textblockPosition, const Color color, const float rotation, const Vector2 origin, const Vector2 scale, const SpriteEffects_t spriteEffects, const float depth)
+		void SpriteFont::ClearLayoutCache()
 		{
-			Vector2 vector2;
+			layoutCache->Clear();
+		}
 
+		void SpriteFont::Draw(String& text, SpriteBatch * const spriteBatch, const Vector2 textblockPosition, const Color color, const float rotation, const Vector2 origin, const Vector2 scale, const SpriteEffects_t spriteEffects, const float depth)
+		{
 			sassert(text != null, String::Format("text; %s", FrameworkResources::ArgumentNull_Generic));
 
 			sassert(spriteBatch != null, String::Format("spriteBatch; %s", FrameworkResources::ArgumentNull_Generic));
 
-			Matrix matrix2 = Matrix::CreateRotationZ(rotation);
-			Matrix matrix = Matrix::CreateTranslation(-origin.X * scale.X, -origin.Y * scale.Y, 0.0f);
-			matrix2 = matrix * matrix2;
-			int num2 = 1;
-			float num4 = 0.0f;
-			bool flag = true;
-			if ((spriteEffects & SpriteEffects::FlipHorizontally) != 0)
-			{
-				num4 = MeasureString(text).X * scale.X;
-				num2 = -1;
-			}
-			if ((spriteEffects & SpriteEffects::FlipVertically) != 0)
+			TextLayoutCache::TextLayout* layout = layoutCache->Find((const char*)text, text.Length, scale, spriteEffects);
+
+			if (layout == null)
 			{
-				vector2.Y = (MeasureString(text).Y - lineSpacing) * scale.Y;
+				// each character produces at most one glyph
+				layout = layoutCache->Add((const char*)text, text.Length, scale, spriteEffects, text.Length);
+
+				const bool flipHorizontally = (spriteEffects & SpriteEffects::FlipHorizontally) != 0;
+				const bool flipVertically = (spriteEffects & SpriteEffects::FlipVertically) != 0;
+				const float advanceScale = flipHorizontally ? -scale.X : scale.X;
+				const float lineAdvance = flipVertically ? -lineSpacing * scale.Y : lineSpacing * scale.Y;
+				const Vector2 size = (flipHorizontally || flipVertically) ? MeasureString(text) : Vector2::Zero;
+				Vector2 offset(flipHorizontally ? size.X * scale.X : 0.0f, flipVertically ? (size.Y - lineSpacing) * scale.Y : 0.0f);
+				const float lineStart = offset.X;
+				bool firstInLine = true;
+
+				for (int i = 0; i < text.Length; i++)
+				{
+					const char character = text[i];
+
+					if (character == '\r')
+					{
+						continue;
+					}
+
+					if (character == '\n')
+					{
+						firstInLine = true;
+						offset.X = lineStart;
+						offset.Y += lineAdvance;
+						continue;
+					}
+
+					const Glyph* glyph = GetGlyph(character);
+
+					if (glyph == null)
+					{
+						continue;
+					}
+
+					if (firstInLine)
+					{
+						offset.X += Math::Max(glyph->LeftSideBearing, 0.0f) * advanceScale;
+					}
+					else
+					{
+						offset.X += (spacing + glyph->LeftSideBearing) * advanceScale;
+					}
+
+					int croppingX = glyph->Cropping.X;
+					int croppingY = glyph->Cropping.Y;
+
+					if (flipVertically)
+					{
+						croppingY = (lineSpacing - glyph->Bounds.Height) - croppingY;
+					}
+
+					if (flipHorizontally)
+					{
+						croppingX -= glyph->Cropping.Width;
+					}
+
+					TextLayoutCache::GlyphQuad& quad = layout->Quads[layout->QuadCount++];
+					quad.Glyph = (int)(glyph - glyphs);
+					quad.X = offset.X + croppingX * scale.X;
+					quad.Y = offset.Y + croppingY * scale.Y;
+					quad.Width = (int)(glyph->Bounds.Width * scale.X);
+					quad.Height = (int)(glyph->Bounds.Height * scale.Y);
+
+					firstInLine = false;
+					offset.X += (glyph->Width + glyph->RightSideBearing) * advanceScale;
+				}
 			}
-			else
+
+			// The origin, rotation and position aren't part of the layout, so they are applied as the glyphs are queued.
+			// The glyphs go straight into the batch, which is flushed once for the whole string in immediate mode.
+			List<Sprite>& sprites = spriteBatch->SpriteList;
+			const float originX = origin.X * scale.X;
+			const float originY = origin.Y * scale.Y;
+			float cos = 1.0f;
+			float sin = 0.0f;
+
+			if (rotation != 0.0f)
 			{
-				vector2.Y = 0.0f;
+				cos = (float)Math::Cos(rotation);
+				sin = (float)Math::Sin(rotation);
 			}
-			vector2.X = num4;
-			for (int i = 0; i < text.Length; i++)
+
+			for (int i = 0; i < layout->QuadCount; i++)
 			{
-				char character = text[i];
-				switch (character)
+				const TextLayoutCache::GlyphQuad& quad = layout->Quads[i];
+				float x = quad.X - originX;
+				float y = quad.Y - originY;
+
+				if (rotation != 0.0f)
 				{
-					case '\r':
-						break;
-
-					case '\n':
-						flag = true;
-						vector2.X = num4;
-						if ((spriteEffects & SpriteEffects::FlipVertically) == SpriteEffects::FlipVertically)
-						{
-							vector2.Y -= lineSpacing * scale.Y;
-						}
-						else
-						{
-							vector2.Y += lineSpacing * scale.Y;
-						}
-						break;
-
-					default:
-					{
-						int indexForCharacter = GetIndexForCharacter(character);
-						Vector3 vector3 = kerning[indexForCharacter];
-						if (flag)
-						{
-							vector3.X = Math::Max(vector3.X, 0.0f);
-						}
-						else
-						{
-							vector2.X += (spacing * scale.X) * num2;
-						}
-						vector2.X += (vector3.X * scale.X) * num2;
-						Rectangle rectangle = glyphData[indexForCharacter];
-						Rectangle rectangle2 = croppingData[indexForCharacter];
-						if ((spriteEffects & SpriteEffects::FlipVertically) == SpriteEffects::FlipVertically)
-						{
-							rectangle2.Y = (lineSpacing - rectangle.Height) - rectangle2.Y;
-						}
-						if ((spriteEffects & SpriteEffects::FlipHorizontally) == SpriteEffects::FlipHorizontally)
-						{
-							rectangle2.X -= rectangle2.Width;
-						}
-						Vector2 position = vector2;
-						position.X += rectangle2.X * scale.X;
-						position.Y += rectangle2.Y * scale.Y;
-						Vector2::Transform(position, matrix2, position);
-						position.X += textblockPosition.X;
-						position.Y += textblockPosition.Y;
-						spriteBatch->Draw(textureValue, position, rectangle, color, rotation, Vector2::Zero, scale, spriteEffects, depth);
-						flag = false;
-						vector2.X += ((vector3.Y + vector3.Z) * scale.X) * num2;
-						break;
-					}
+					const float rotatedX = x * cos - y * sin;
+					y = x * sin + y * cos;
+					x = rotatedX;
 				}
+
+				Rectangle destination((int)(x + textblockPosition.X), (int)(y + textblockPosition.Y), quad.Width, quad.Height);
+
+				sprites.Add(Sprite(textureValue, glyphs[quad.Glyph].Bounds, destination, color, rotation, Vector2::Zero, spriteEffects, depth));
+			}
+
+			if (spriteBatch->spriteSortMode == SpriteSortMode::Immediate)
+			{
+				spriteBatch->Flush();
 			}
 		}
 
-		int SpriteFont::GetIndexForCharacter(char character)
+		const SpriteFont::Glyph* SpriteFont::GetGlyph(const char character) const
+		{
+			const int index = characterIndices[(byte)character];
+
+			sassert(index >= 0, "character; Character not in Font.");
+
+			return (index >= 0) ? &glyphs[index] : null;
+		}
+
+		int SpriteFont::getLayoutCacheCapacity() const
+		{
+			return layoutCache->getCapacity();
+		}
+
+		void SpriteFont::setLayoutCacheCapacity(const int value)
+		{
+			layoutCache->setCapacity(value);
+		}
+
+		int SpriteFont::LayoutCacheHits() const
+		{
+			return layoutCache->Hits();
+		}
+
+		int SpriteFont::LayoutCacheMisses() const
 		{
-			int num2 = 0;
-			int num3 = characterMap.Count() - 1;
-			while (num2 <= num3)
+			return layoutCache->Misses();
+		}
+
+		int SpriteFont::LineSpacing()
+		{
+			return lineSpacing;
+		}
+
+		Vector2 SpriteFont::MeasureString(String& text) const
+		{
+			Vector2 size = Vector2::Zero;
+			float lineWidth = 0.0f;
+			float lineHeight = (float)lineSpacing;
+			float rightSideBearing = 0.0f;
+			int lineCount = 0;
+			bool firstInLine = true;
+
+			if (text.Length == 0)
 			{
-				int num = num2 + ((num3 - num2) >> 1);
-				char ch = characterMap[num];
-				if (ch == character)
+				return size;
+			}
+
+			for (int i = 0; i < text.Length; i++)
+			{
+				const char character = text[i];
+
+				if (character == '\r')
 				{
-					return num;
+					continue;
 				}
-				if (ch < character)
+
+				if (character == '\n')
 				{
-					num2 = num + 1;
+					// only the last glyph of a line extends it by its right side bearing, and only if that is positive
+					size.X = Math::Max(size.X, lineWidth + Math::Max(rightSideBearing, 0.0f));
+					lineWidth = 0.0f;
+					lineHeight = (float)lineSpacing;
+					rightSideBearing = 0.0f;
+					lineCount++;
+					firstInLine = true;
+					continue;
+				}
+
+				const Glyph* glyph = GetGlyph(character);
+
+				if (glyph == null)
+				{
+					continue;
+				}
+
+				if (firstInLine)
+				{
+					lineWidth += Math::Max(glyph->LeftSideBearing, 0.0f);
 				}
 				else
 				{
-					num3 = num - 1;
+					lineWidth += spacing + rightSideBearing + glyph->LeftSideBearing;
 				}
+
+				lineWidth += glyph->Width;
+				rightSideBearing = glyph->RightSideBearing;
+				lineHeight = Math::Max(lineHeight, (float)glyph->Cropping.Height);
+				firstInLine = false;
 			}
 
-			sassert(false, "character; Character not in Font.");
-		}
+			size.X = Math::Max(size.X, lineWidth + Math::Max(rightSideBearing, 0.0f));
+			size.Y = lineHeight + lineCount * lineSpacing;
 
-		Vector2 SpriteFont::MeasureString(String& text) const
-		{
-			//! TODO: implement
-			return Vector2::Zero;
+			return size;
 		}
 	}
 }
@@ -0,0 +1,253 @@
+// Copyright (C) XFX Team
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without 
+// modification, are permitted provided that the following conditions are met:
+// 
+//* Redistributions of source code must retain the above copyright 
+//notice, this list of conditions and the following disclaimer.
+//* Redistributions in binary form must reproduce the above copyright 
+//notice, this list of conditions and the following disclaimer in the 
+//documentation and/or other materials provided with the distribution.
+//* Neither the name of the copyright holder nor the names of any 
+//contributors may be used to endorse or promote products derived from 
+//this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE 
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF 
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS 
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE 
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include "TextLayoutCache.h"
+
+#include <string.h>
+
+namespace XFX
+{
+	namespace Graphics
+	{
+		TextLayoutCache::TextLayoutCache(const int capacity)
+			: head(null), tail(null), transient(null), capacity(capacity), size(0), hits(0), misses(0)
+		{
+			for (int i = 0; i < BucketCount; i++)
+			{
+				buckets[i] = null;
+			}
+		}
+
+		TextLayoutCache::~TextLayoutCache()
+		{
+			Clear();
+		}
+
+		TextLayoutCache::TextLayout* TextLayoutCache::Add(const char text[], const int length, const Vector2 scale, const SpriteEffects_t effects, const int maxQuadCount)
+		{
+			// the layout, its glyphs and a copy of the text share one allocation
+			const int layoutSize = sizeof(TextLayout) + maxQuadCount * sizeof(GlyphQuad) + length;
+
+			delete[] (byte*)transient;
+			transient = null;
+
+			if (layoutSize <= capacity)
+			{
+				Evict(layoutSize);
+			}
+
+			byte* block = new byte[layoutSize];
+			TextLayout* layout = (TextLayout*)block;
+			char* storedText = (char*)(block + sizeof(TextLayout) + maxQuadCount * sizeof(GlyphQuad));
+
+			memcpy(storedText, text, length);
+
+			layout->Quads = (GlyphQuad*)(block + sizeof(TextLayout));
+			layout->QuadCount = 0;
+			layout->text = storedText;
+			layout->length = length;
+			layout->hash = Hash(text, length, scale, effects);
+			layout->scaleX = scale.X;
+			layout->scaleY = scale.Y;
+			layout->effects = effects;
+			layout->size = layoutSize;
+
+			if (layoutSize > capacity)
+			{
+				transient = layout;
+				return layout;
+			}
+
+			TextLayout** bucket = &buckets[layout->hash & (BucketCount - 1)];
+			layout->nextInBucket = *bucket;
+			*bucket = layout;
+
+			layout->previous = null;
+			layout->next = head;
+
+			if (head != null)
+			{
+				head->previous = layout;
+			}
+			else
+			{
+				tail = layout;
+			}
+
+			head = layout;
+			size += layoutSize;
+
+			return layout;
+		}
+
+		void TextLayoutCache::Clear()
+		{
+			delete[] (byte*)transient;
+			transient = null;
+
+			while (tail != null)
+			{
+				Remove(tail);
+			}
+		}
+
+		void TextLayoutCache::Evict(const int required)
+		{
+			while (tail != null && size + required > capacity)
+			{
+				Remove(tail);
+			}
+		}
+
+		TextLayoutCache::TextLayout* TextLayoutCache::Find(const char text[], const int length, const Vector2 scale, const SpriteEffects_t effects)
+		{
+			const uint hash = Hash(text, length, scale, effects);
+
+			for (TextLayout* layout = buckets[hash & (BucketCount - 1)]; layout != null; layout = layout->nextInBucket)
+			{
+				if (layout->hash == hash && layout->length == length && layout->scaleX == scale.X && layout->scaleY == scale.Y && layout->effects == effects &&
+					memcmp(layout->text, text, length) == 0)
+				{
+					hits++;
+					MoveToFront(layout);
+					return layout;
+				}
+			}
+
+			misses++;
+			return null;
+		}
+
+		int TextLayoutCache::getCapacity() const
+		{
+			return capacity;
+		}
+
+		void TextLayoutCache::setCapacity(const int value)
+		{
+			capacity = value;
+			Evict(0);
+		}
+
+		uint TextLayoutCache::Hash(const char text[], const int length, const Vector2 scale, const SpriteEffects_t effects)
+		{
+			// FNV-1a over the text, followed by the bits of the scale and the effects
+			uint hash = 2166136261u;
+			uint bits[3];
+
+			memcpy(&bits[0], &scale.X, sizeof(uint));
+			memcpy(&bits[1], &scale.Y, sizeof(uint));
+			bits[2] = (uint)effects;
+
+			for (int i = 0; i < length; i++)
+			{
+				hash = (hash ^ (byte)text[i]) * 16777619u;
+			}
+
+			for (int i = 0; i < 3; i++)
+			{
+				hash = (hash ^ bits[i]) * 16777619u;
+			}
+
+			return hash;
+		}
+
+		int TextLayoutCache::Hits() const
+		{
+			return hits;
+		}
+
+		int TextLayoutCache::Misses() const
+		{
+			return misses;
+		}
+
+		void TextLayoutCache::MoveToFront(TextLayout * const layout)
+		{
+			if (layout == head)
+			{
+				return;
+			}
+
+			// layout isn't the head, so it has a previous layout
+			layout->previous->next = layout->next;
+
+			if (layout->next != null)
+			{
+				layout->next->previous = layout->previous;
+			}
+			else
+			{
+				tail = layout->previous;
+			}
+
+			layout->previous = null;
+			layout->next = head;
+			head->previous = layout;
+			head = layout;
+		}
+
+		void TextLayoutCache::Remove(TextLayout * const layout)
+		{
+			TextLayout** link = &buckets[layout->hash & (BucketCount - 1)];
+
+			while (*link != layout)
+			{
+				link = &(*link)->nextInBucket;
+			}
+
+			*link = layout->nextInBucket;
+
+			if (layout->previous != null)
+			{
+				layout->previous->next = layout->next;
+			}
+			else
+			{
+				head = layout->next;
+			}
+
+			if (layout->next != null)
+			{
+				layout->next->previous = layout->previous;
+			}
+			else
+			{
+				tail = layout->previous;
+			}
+
+			size -= layout->size;
+
+			delete[] (byte*)layout;
+		}
+
+		int TextLayoutCache::Size() const
+		{
+			return size;
+		}
+	}
+}
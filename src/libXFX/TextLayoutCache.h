@@ -0,0 +1,114 @@
+/*****************************************************************************
+ *	TextLayoutCache.h														 *
+ *																			 *
+ *	XFX::Graphics::TextLayoutCache class definition file					 *
+ *	Copyright (c) XFX Team. All Rights Reserved 							 *
+ *****************************************************************************/
+#ifndef _XFX_GRAPHICS_TEXTLAYOUTCACHE_
+#define _XFX_GRAPHICS_TEXTLAYOUTCACHE_
+
+#include <Graphics/Enums.h>
+#include <Vector2.h>
+#include <System/Types.h>
+
+using namespace System;
+
+namespace XFX
+{
+	namespace Graphics
+	{
+		/**
+		 * Remembers where SpriteFont placed the glyphs of the strings it drew, so that text which is drawn again with the same scale and effects
+		 * doesn't have to be laid out again.
+		 *
+		 * Layouts are kept until their total size exceeds the capacity, after which the least recently used ones are dropped.
+		 */
+		// This class is not meant to be used by the end user.
+		// Only XFX source files should reference this class.
+		class TextLayoutCache
+		{
+		public:
+			/**
+			 * A glyph of a laid out string: the index of the glyph in its font, and where and how large it is drawn, relative to the text position
+			 * before the origin and rotation are applied.
+			 *
+			 * Layouts live in raw memory, so this and TextLayout must stay plain data.
+			 */
+			struct GlyphQuad
+			{
+				int Glyph;
+				float X;
+				float Y;
+				int Width;
+				int Height;
+			};
+
+			struct TextLayout
+			{
+				GlyphQuad* Quads;
+				int QuadCount;
+
+			private:
+				friend class TextLayoutCache;
+
+				TextLayout* nextInBucket;
+				TextLayout* previous;
+				TextLayout* next;
+				const char* text;
+				int length;
+				uint hash;
+				float scaleX;
+				float scaleY;
+				SpriteEffects_t effects;
+				int size;
+			};
+
+		private:
+			static const int BucketCount = 64;
+
+			TextLayout* buckets[BucketCount];
+			// The most and least recently used layouts.
+			TextLayout* head;
+			TextLayout* tail;
+			// The last layout too large to cache, which is only kept until the next one.
+			TextLayout* transient;
+			int capacity;
+			int size;
+			int hits;
+			int misses;
+
+			static uint Hash(const char text[], const int length, const Vector2 scale, const SpriteEffects_t effects);
+			void Evict(const int required);
+			void MoveToFront(TextLayout * const layout);
+			void Remove(TextLayout * const layout);
+
+		public:
+			/**
+			 * The capacity of the cache of each SpriteFont, in bytes.
+			 */
+			static const int DefaultCapacity = 32 * 1024;
+
+			TextLayoutCache(const int capacity);
+			~TextLayoutCache();
+
+			/**
+			 * Allocates and returns a layout for text, with room for maxQuadCount glyphs, that the caller fills in.
+			 * Least recently used layouts are dropped to make room for it. A layout larger than the whole cache is not cached:
+			 * it is returned without touching the cached ones, and only stays valid until the next call to Add or Clear.
+			 */
+			TextLayout* Add(const char text[], const int length, const Vector2 scale, const SpriteEffects_t effects, const int maxQuadCount);
+			void Clear();
+			/**
+			 * Returns the layout of text drawn at scale with effects and marks it as recently used, or returns null if it isn't cached.
+			 */
+			TextLayout* Find(const char text[], const int length, const Vector2 scale, const SpriteEffects_t effects);
+			int getCapacity() const;
+			void setCapacity(const int value);
+			int Hits() const;
+			int Misses() const;
+			int Size() const;
+		};
+	}
+}
+
+#endif //_XFX_GRAPHICS_TEXTLAYOUTCACHE_
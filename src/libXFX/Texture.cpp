@@ -33,6 +33,7 @@
 #include <System/IO/File.h>
 #include <System/IO/FileStream.h>
 #include <System/IO/Path.h>
+#include <System/Type.h>
 
 #include <string.h>
 #include <sassert.h>
@@ -41,6 +42,22 @@ namespace XFX
 {
 	namespace Graphics
 	{
+		static const Type TextureTypeInfo("Texture", "XFX::Graphics::Texture", TypeCode::Object);
+
+		Texture::Texture()
+			: _levelCount(1)
+		{
+		}
+
+		Texture::~Texture()
+		{
+		}
+
+		void Texture::Dispose(bool disposing)
+		{
+			GraphicsResource::Dispose(disposing);
+		}
+
 		int Texture::getLevelCount() const
 		{
 			return _levelCount;
@@ -137,7 +154,12 @@ namespace XFX
 
 		const Type& Texture::GetType()
 		{
+			return TextureTypeInfo;
+		}
 
+		bool Texture::MustClamp() const
+		{
+			return false;
 		}
 	}
 }
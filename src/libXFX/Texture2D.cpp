@@ -48,7 +48,7 @@ namespace XFX
 		}
 
 		Texture2D::Texture2D(GraphicsDevice * const graphicsDevice, const int width, const int height)
-			: textureData(new uint[width * height]), Height(height), Width(width)
+			: _isDisposed(false), textureData(new uint[width * height]), Height(height), Width(width)
 		{
 			textureId = -1;
 			this->graphicsDevice = graphicsDevice;
@@ -57,16 +57,22 @@ namespace XFX
 		}
 
 		Texture2D::Texture2D(GraphicsDevice * const graphicsDevice, const int width, const int height, bool mipmap, const SurfaceFormat_t format)
-			: textureData(new uint[width * height]), Height(height), Width(width)
+			: _isDisposed(false), textureData(new uint[width * height]), Height(height), Width(width)
 		{
 			// TODO: see if there are more supported surfaceformats (likely)
 			sassert(format == SurfaceFormat::Color, "Invalid surface format. Valid SurfaceFormats are: Color");
 
 			this->graphicsDevice = graphicsDevice;
+			textureId = -1;
 			this->graphicsDevice->getTextures().textures.Add(this);
 			_surfaceFormat = format;
 		}
 
+		Texture2D::~Texture2D()
+		{
+			Dispose(false);
+		}
+
 		void Texture2D::Dispose(bool disposing)
 		{
 			if(!_isDisposed)
@@ -86,6 +92,8 @@ namespace XFX
 					graphicsDevice->getTextures().textures.Remove(this);
 			}
 			_isDisposed = true;
+
+			Texture::Dispose(disposing);
 		}
 
 		const Type& Texture2D::GetType()
@@ -97,7 +105,7 @@ namespace XFX
 		{
 			sassert(data != null, FrameworkResources::ArgumentNull_Generic);
 
-			sassert(elementCount < (Width * Height), "");
+			sassert(elementCount <= (Width * Height), "elementCount is larger than the texture size");
 
 			uint valueMask;
 
@@ -25,12 +25,14 @@
 // ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE 
 // POSSIBILITY OF SUCH DAMAGE.
 
+#include "DxtUtil.h"
 #include "Enums.h"
 #include "Texture2DReader.h"
 
-#include <System/BitConverter.h>
+#include <sassert.h>
 #include <Content/ContentReader.h>
-#include <System/Diagnostics/Debug.h>
+
+#include <string.h>
 
 using namespace System;
 
@@ -38,6 +40,23 @@ namespace XFX
 {
 	namespace Content
 	{
+		// The XNA 4.0 SurfaceFormat values, which .xnb files are written with, are the indices into this table.
+		static const SurfaceFormat_t Xna4SurfaceFormats[] =
+		{
+			SurfaceFormat::Color, SurfaceFormat::Bgr565, SurfaceFormat::Bgra5551, SurfaceFormat::Bgra4444,
+			SurfaceFormat::Dxt1, SurfaceFormat::Dxt3, SurfaceFormat::Dxt5,
+			SurfaceFormat::NormalizedByte2, SurfaceFormat::NormalizedByte4, SurfaceFormat::Rgba1010102, SurfaceFormat::Rg32, SurfaceFormat::Rgba64,
+			SurfaceFormat::Alpha8, SurfaceFormat::Single, SurfaceFormat::Vector2, SurfaceFormat::Vector4,
+			SurfaceFormat::HalfSingle, SurfaceFormat::HalfVector2, SurfaceFormat::HalfVector4, SurfaceFormat::HdrBlendable
+		};
+
+		Texture2D* ContentTypeReaderFor<Texture2D>::Read(ContentReader * const input, Texture2D* existingInstance)
+		{
+			Texture2DReader reader;
+
+			return reader.Read(input, existingInstance);
+		}
+
 		Texture2D* Texture2DReader::Read(ContentReader * reader, Texture2D * existingInstance)
 		{
 			Texture2D* texture = null;
@@ -68,63 +87,45 @@ namespace XFX
 			}
 			else
 			{
-				surfaceFormat = (SurfaceFormat_t)reader->ReadInt32();
+				const int format = reader->ReadInt32();
+
+				sassert(format >= 0 && format < (int)(sizeof(Xna4SurfaceFormats) / sizeof(Xna4SurfaceFormats[0])), "Unknown surface format.");
+
+				surfaceFormat = (format >= 0 && format < (int)(sizeof(Xna4SurfaceFormats) / sizeof(Xna4SurfaceFormats[0]))) ? Xna4SurfaceFormats[format] : SurfaceFormat::Color;
 			}
 
 			int width = reader->ReadInt32();
 			int height = reader->ReadInt32();
 			int levelCount = reader->ReadInt32();
-			int levelCountOutput = levelCount;
-
-			// If the system does not fully support Power of Two textures,
-			// skip any mip maps supplied with any non PoT textures.
-			if (levelCount > 1 && !GraphicsCapabilities.SupportsNonPowerOfTwo &&
-				(!MathHelper::IsPowerOfTwo(width) || !MathHelper::IsPowerOfTwo(height)))
-			{
-				levelCountOutput = 1;
-				System::Diagnostics::Debug::WriteLine(
-					"Device does not support non Power of Two textures. Skipping mipmaps.");
-			}
 
-			SurfaceFormat_t convertedFormat = surfaceFormat;
-			switch (surfaceFormat)
+			// Texture2D holds a single level of 32-bit texels, so every format is converted to Color,
+			// and an existing instance can only be reused when it has the same size.
+			if (existingInstance != null && existingInstance->Width == width && existingInstance->Height == height)
 			{
-			case SurfaceFormat::Dxt1:
-			//case SurfaceFormat::Dxt1a:
-				if (!GraphicsCapabilities.SupportsDxt1)
-					convertedFormat = SurfaceFormat::Color;
-				break;
-			case SurfaceFormat::Dxt3:
-			case SurfaceFormat::Dxt5:
-				if (!GraphicsCapabilities.SupportsS3tc)
-					convertedFormat = SurfaceFormat::Color;
-				break;
-			case SurfaceFormat::NormalizedByte4:
-				convertedFormat = SurfaceFormat::Color;
-				break;
-			}
-
-			if (existingInstance == null)
-			{
-				texture = new Texture2D(reader->getGraphicsDevice(), width, height, levelCountOutput > 1, convertedFormat);
+				texture = existingInstance;
 			}
 			else
 			{
-				texture = existingInstance;
-
-				texture->Dispose();
-
-				texture = new Texture2D(reader->getGraphicsDevice(), width, height, levelCountOutput > 1, convertedFormat);
+				texture = new Texture2D(reader->getGraphicsDevice(), width, height, false, SurfaceFormat::Color);
 			}
 
+			// Texture2D only stores the top level, as 32-bit texels, so that level is converted straight into the texture in a single pass
+			// and the other levels are skipped without being converted.
+			byte* textureBytes = reinterpret_cast<byte*>(texture->textureData);
+			const int textureSize = width * height * 4;
+
 			for (int level=0; level<levelCount; level++)
 			{
 				int levelDataSizeInBytes = reader->ReadInt32();
-				byte* levelData = reader->ReadBytes(levelDataSizeInBytes);
-				int levelWidth = width >> level;
-				int levelHeight = height >> level;
+				// when the asset comes from a MappedFileStream this points straight into the file data
+				const byte* levelData = reader->ReadSpan(levelDataSizeInBytes);
+
+				if (levelData == null)
+				{
+					break;
+				}
 
-				if (level >= levelCountOutput)
+				if (level > 0)
 				{
 					continue;
 				}
@@ -133,94 +134,53 @@ namespace XFX
 				{
 				case SurfaceFormat::Dxt1:
 				//case SurfaceFormat::Dxt1a:
-					if (!GraphicsCapabilities.SupportsDxt1)
-						levelData = DxtUtil::DecompressDxt1(levelData, levelWidth, levelHeight);
-					break;
 				case SurfaceFormat::Dxt3:
-					if (!GraphicsCapabilities.SupportsS3tc)
-						levelData = DxtUtil::DecompressDxt3(levelData, levelWidth, levelHeight);
-					break;
 				case SurfaceFormat::Dxt5:
-					if (!GraphicsCapabilities.SupportsS3tc)
-						levelData = DxtUtil::DecompressDxt5(levelData, levelWidth, levelHeight);
-					break;
-				case SurfaceFormat::Bgr565:
 					{
-						/*
-						// BGR -> BGR
-						int offset = 0;
-						for (int y = 0; y < levelHeight; y++)
+						const int compressedSize = DxtUtil::GetCompressedSize(width, height, (surfaceFormat == SurfaceFormat::Dxt1) ? 8 : 16);
+						sassert(levelDataSizeInBytes >= compressedSize, "The texture data is smaller than its size and format require.");
+
+						if (levelDataSizeInBytes < compressedSize)
 						{
-							for (int x = 0; x < levelWidth; x++)
-							{
-								ushort pixel = BitConverter.ToUInt16(levelData, offset);
-								pixel = (ushort)(((pixel & 0x0FFF) << 4) | ((pixel & 0xF000) >> 12));
-								levelData[offset] = (byte)(pixel);
-								levelData[offset + 1] = (byte)(pixel >> 8);
-								offset += 2;
-							}
+							break;
 						}
-							*/
-					}
-					break;
-				case SurfaceFormat::Bgra5551:
-					{
-#if OPENGL
-						// Shift the channels to suit OPENGL
-						int offset = 0;
-						for (int y = 0; y < levelHeight; y++)
+
+						const int blockRows = DxtUtil::GetBlockCount(height);
+
+						if (surfaceFormat == SurfaceFormat::Dxt1)
 						{
-							for (int x = 0; x < levelWidth; x++)
-							{
-								ushort pixel = BitConverter::ToUInt16(levelData, offset);
-								pixel = (ushort)(((pixel & 0x7FFF) << 1) | ((pixel & 0x8000) >> 15));
-								levelData[offset] = (byte)(pixel);
-								levelData[offset + 1] = (byte)(pixel >> 8);
-								offset += 2;
-							}
+							DxtUtil::DecompressDxt1(levelData, width, height, textureBytes, 0, blockRows);
 						}
-#endif
-					}
-					break;
-				case SurfaceFormat::Bgra4444:
-					{
-#if OPENGL
-						// Shift the channels to suit OPENGL
-						int offset = 0;
-						for (int y = 0; y < levelHeight; y++)
+						else if (surfaceFormat == SurfaceFormat::Dxt3)
+						{
+							DxtUtil::DecompressDxt3(levelData, width, height, textureBytes, 0, blockRows);
+						}
+						else
 						{
-							for (int x = 0; x < levelWidth; x++)
-							{
-								ushort pixel = BitConverter::ToUInt16(levelData, offset);
-								pixel = (ushort)(((pixel & 0x0FFF) << 4) | ((pixel & 0xF000) >> 12));
-								levelData[offset] = (byte)(pixel);
-								levelData[offset + 1] = (byte)(pixel >> 8);
-								offset += 2;
-							}
+							DxtUtil::DecompressDxt5(levelData, width, height, textureBytes, 0, blockRows);
 						}
-#endif
 					}
 					break;
 				case SurfaceFormat::NormalizedByte4:
 					{
-						int bytesPerPixel = surfaceFormat.Size();
-						int pitch = levelWidth * bytesPerPixel;
-						for (int y = 0; y < levelHeight; y++)
+						const int size = (levelDataSizeInBytes < textureSize) ? levelDataSizeInBytes : textureSize;
+
+						for (int offset = 0; offset + 4 <= size; offset += 4)
 						{
-							for (int x = 0; x < levelWidth; x++)
-							{
-								int color = BitConverter::ToInt32(levelData, y * pitch + x * bytesPerPixel);
-								levelData[y * pitch + x * 4] = (byte)(((color >> 16) & 0xff)); //R:=W
-								levelData[y * pitch + x * 4 + 1] = (byte)(((color >> 8) & 0xff)); //G:=V
-								levelData[y * pitch + x * 4 + 2] = (byte)(((color) & 0xff)); //B:=U
-								levelData[y * pitch + x * 4 + 3] = (byte)(((color >> 24) & 0xff)); //A:=Q
-							}
+							textureBytes[offset] = levelData[offset + 2];		//R:=W
+							textureBytes[offset + 1] = levelData[offset + 1];	//G:=V
+							textureBytes[offset + 2] = levelData[offset];		//B:=U
+							textureBytes[offset + 3] = levelData[offset + 3];	//A:=Q
 						}
 					}
 					break;
+				case SurfaceFormat::Color:
+					memcpy(textureBytes, levelData, (levelDataSizeInBytes < textureSize) ? levelDataSizeInBytes : textureSize);
+					break;
+				default:
+					sassert(false, "Texture2D cannot hold this surface format; only Color, Dxt1, Dxt3, Dxt5 and NormalizedByte4 textures can be loaded.");
+					break;
 				}
-
-				//texture->SetData(levelData, 0, 
 			}
 			return texture;
 		}
@@ -18,7 +18,7 @@ namespace XFX
 	{
 		class Texture2DReader : public ContentTypeReader<Texture2D>
 		{
-		protected:
+		public:
 			Texture2D* Read(ContentReader * const input, Texture2D* existingInstance);
 		};
 	}
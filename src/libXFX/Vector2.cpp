@@ -34,6 +34,7 @@
 #include <System/Math.h>
 #include <System/String.h>
 #include <System/Type.h>
+#include "VectorBatch.h"
 
 #include <sassert.h>
 
@@ -336,7 +337,7 @@ namespace XFX
 		return String::Format("{X:%f Y:%f}", X, Y);
 	}
 
-	Vector2 Vector2::Transform(const Vector2 position, const Matrix matrix)
+	Vector2 Vector2::Transform(const Vector2 position, const Matrix& matrix)
 	{
 		Vector2 result;
 		Transform(position, matrix, result);
@@ -347,16 +348,16 @@ namespace XFX
 	{
 		Vector4 vector;
 
-		vector.X = (vector.X * matrix.M11) + (vector.Y * matrix.M21) + matrix.M41;
-		vector.Y = (vector.X * matrix.M12) + (vector.Y * matrix.M22) + matrix.M42;
-		vector.Z = (vector.X * matrix.M13) + (vector.Y * matrix.M23) + matrix.M43;
-		vector.W = 1 / ((vector.X * matrix.M14) + (vector.Y * matrix.M24) + matrix.M44);
+		vector.X = (position.X * matrix.M11) + (position.Y * matrix.M21) + matrix.M41;
+		vector.Y = (position.X * matrix.M12) + (position.Y * matrix.M22) + matrix.M42;
+		vector.Z = (position.X * matrix.M13) + (position.Y * matrix.M23) + matrix.M43;
+		vector.W = 1 / ((position.X * matrix.M14) + (position.Y * matrix.M24) + matrix.M44);
 
 		result.X = vector.X * vector.W;
 		result.Y = vector.Y * vector.W;
 	}
 
-	Vector2 Vector2::Transform(const Vector2 position, const Quaternion rotation)
+	Vector2 Vector2::Transform(const Vector2 position, const Quaternion& rotation)
 	{
 		Vector2 result;
 		Transform(position, rotation, result);
@@ -380,9 +381,28 @@ namespace XFX
 
 		sassert(destinationArray != null, "destinationArray cannot be null.");
 
-		for(int i = sourceIndex, j = destinationIndex; i < (sourceIndex + length); i++, j++)
+		float x[VectorBatch::BatchSize];
+		float y[VectorBatch::BatchSize];
+
+		for (int offset = 0; offset < length; offset += VectorBatch::BatchSize)
 		{
-			TransformNormal(sourceArray[i], matrix, destinationArray[j]);
+			const Vector2* source = &sourceArray[sourceIndex + offset];
+			Vector2* destination = &destinationArray[destinationIndex + offset];
+			int count = Math::Min(length - offset, VectorBatch::BatchSize);
+
+			for (int i = 0; i < count; i++)
+			{
+				x[i] = source[i].X;
+				y[i] = source[i].Y;
+			}
+
+			VectorBatch::Transform(x, y, matrix, x, y, count);
+
+			for (int i = 0; i < count; i++)
+			{
+				destination[i].X = x[i];
+				destination[i].Y = y[i];
+			}
 		}
 	}
 
@@ -392,13 +412,42 @@ namespace XFX
 
 		sassert(destinationArray != null, String::Format("destinationArray; %s", FrameworkResources::ArgumentNull_Generic));
 
-		for(int i = sourceIndex, j = destinationIndex; i < (sourceIndex + length); i++, j++)
+		float x[VectorBatch::BatchSize];
+		float y[VectorBatch::BatchSize];
+
+		for (int offset = 0; offset < length; offset += VectorBatch::BatchSize)
 		{
-			Transform(sourceArray[i], rotation, destinationArray[j]);
+			const Vector2* source = &sourceArray[sourceIndex + offset];
+			Vector2* destination = &destinationArray[destinationIndex + offset];
+			int count = Math::Min(length - offset, VectorBatch::BatchSize);
+
+			for (int i = 0; i < count; i++)
+			{
+				x[i] = source[i].X;
+				y[i] = source[i].Y;
+			}
+
+			VectorBatch::Transform(x, y, rotation, x, y, count);
+
+			for (int i = 0; i < count; i++)
+			{
+				destination[i].X = x[i];
+				destination[i].Y = y[i];
+			}
 		}
 	}
 
-	Vector2 Vector2::TransformNormal(const Vector2 normal, const Matrix matrix)
+	void Vector2::Transform(const float sourceX[], const float sourceY[], const Matrix& matrix, float destinationX[], float destinationY[], const int length)
+	{
+		VectorBatch::Transform(sourceX, sourceY, matrix, destinationX, destinationY, length);
+	}
+
+	void Vector2::Transform(const float sourceX[], const float sourceY[], const Quaternion& rotation, float destinationX[], float destinationY[], const int length)
+	{
+		VectorBatch::Transform(sourceX, sourceY, rotation, destinationX, destinationY, length);
+	}
+
+	Vector2 Vector2::TransformNormal(const Vector2 normal, const Matrix& matrix)
 	{
 		Vector2 result;
 		result.X = (normal.X * matrix.M11) + (normal.Y * matrix.M21);
@@ -419,12 +468,36 @@ namespace XFX
 
 		sassert(destinationArray != null, String::Format("destinationArray; %s", FrameworkResources::ArgumentNull_Generic));
 
-		for(int i = sourceIndex, j = destinationIndex; i < (sourceIndex + length); i++, j++)
+		float x[VectorBatch::BatchSize];
+		float y[VectorBatch::BatchSize];
+
+		for (int offset = 0; offset < length; offset += VectorBatch::BatchSize)
 		{
-			TransformNormal(sourceArray[i], matrix, destinationArray[j]);
+			const Vector2* source = &sourceArray[sourceIndex + offset];
+			Vector2* destination = &destinationArray[destinationIndex + offset];
+			int count = Math::Min(length - offset, VectorBatch::BatchSize);
+
+			for (int i = 0; i < count; i++)
+			{
+				x[i] = source[i].X;
+				y[i] = source[i].Y;
+			}
+
+			VectorBatch::TransformNormal(x, y, matrix, x, y, count);
+
+			for (int i = 0; i < count; i++)
+			{
+				destination[i].X = x[i];
+				destination[i].Y = y[i];
+			}
 		}
 	}
 
+	void Vector2::TransformNormal(const float sourceX[], const float sourceY[], const Matrix& matrix, float destinationX[], float destinationY[], const int length)
+	{
+		VectorBatch::TransformNormal(sourceX, sourceY, matrix, destinationX, destinationY, length);
+	}
+
 	Vector2 Vector2::operator+(const Vector2& other) const
 	{
 		return Vector2(X + other.X, Y + other.Y);
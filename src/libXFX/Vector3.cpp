@@ -35,6 +35,7 @@
 #include <System/Math.h>
 #include <System/String.h>
 #include <System/Type.h>
+#include "VectorBatch.h"
 
 #include <sassert.h>
 
@@ -454,35 +455,35 @@ namespace XFX
 		return String::Format("{X:%f Y:%f Z:%f}", X, Y, Z);
 	}
 
-	Vector3 Vector3::Transform(Vector3 position, Matrix matrix)
+	Vector3 Vector3::Transform(Vector3 position, const Matrix& matrix)
 	{
 		Vector3 result;
 		Transform(position, matrix, result);
 		return result;
 	}
 
-	void Vector3::Transform(Vector3 position, Matrix matrix, out Vector3& result)
+	void Vector3::Transform(Vector3 position, const Matrix& matrix, out Vector3& result)
 	{
 		Vector4 vector;
 
-		vector.X = (((vector.X * matrix.M11) + (vector.Y * matrix.M21)) + (vector.Z * matrix.M31)) + matrix.M41;
-		vector.Y = (((vector.X * matrix.M12) + (vector.Y * matrix.M22)) + (vector.Z * matrix.M32)) + matrix.M42;
-		vector.Z = (((vector.X * matrix.M13) + (vector.Y * matrix.M23)) + (vector.Z * matrix.M33)) + matrix.M43;
-		vector.W = 1 / ((((vector.X * matrix.M14) + (vector.Y * matrix.M24)) + (vector.Z * matrix.M34)) + matrix.M44);
+		vector.X = (((position.X * matrix.M11) + (position.Y * matrix.M21)) + (position.Z * matrix.M31)) + matrix.M41;
+		vector.Y = (((position.X * matrix.M12) + (position.Y * matrix.M22)) + (position.Z * matrix.M32)) + matrix.M42;
+		vector.Z = (((position.X * matrix.M13) + (position.Y * matrix.M23)) + (position.Z * matrix.M33)) + matrix.M43;
+		vector.W = 1 / ((((position.X * matrix.M14) + (position.Y * matrix.M24)) + (position.Z * matrix.M34)) + matrix.M44);
 
 		result.X = vector.X * vector.W;
 		result.Y = vector.Y * vector.W;
 		result.Z = vector.Z * vector.W;
 	}
 
-	Vector3 Vector3::Transform(Vector3 position, Quaternion rotation)
+	Vector3 Vector3::Transform(Vector3 position, const Quaternion& rotation)
 	{
 		Vector3 result;
 		Transform(position, rotation, result);
 		return result;
 	}
 
-	void Vector3::Transform(Vector3 position, Quaternion rotation, out Vector3& result)
+	void Vector3::Transform(Vector3 position, const Quaternion& rotation, out Vector3& result)
 	{
 		Vector3 xyz = Vector3(rotation.X,rotation.Y, rotation.Z), temp, temp2;
 		Cross(xyz, position, temp);
@@ -493,56 +494,137 @@ namespace XFX
 		Add(position, temp, result);
 	}
 
-	void Vector3::Transform(const Vector3 sourceArray[], const int sourceIndex, const Matrix matrix, Vector3 destinationArray[], const int destinationIndex, const int length)
+	void Vector3::Transform(const Vector3 sourceArray[], const int sourceIndex, const Matrix& matrix, Vector3 destinationArray[], const int destinationIndex, const int length)
 	{
 		sassert(sourceArray != null, String::Format("sourceArray; %s", FrameworkResources::ArgumentNull_Generic));
 
 		sassert(destinationArray != null, String::Format("destinationArray; %s", FrameworkResources::ArgumentNull_Generic));
 
-		for (int i = sourceIndex, j = destinationIndex; i < (sourceIndex + length); i++, j++)
+		float x[VectorBatch::BatchSize];
+		float y[VectorBatch::BatchSize];
+		float z[VectorBatch::BatchSize];
+
+		for (int offset = 0; offset < length; offset += VectorBatch::BatchSize)
 		{
-			Transform(sourceArray[i], matrix, destinationArray[j]);
+			const Vector3* source = &sourceArray[sourceIndex + offset];
+			Vector3* destination = &destinationArray[destinationIndex + offset];
+			int count = Math::Min(length - offset, VectorBatch::BatchSize);
+
+			for (int i = 0; i < count; i++)
+			{
+				x[i] = source[i].X;
+				y[i] = source[i].Y;
+				z[i] = source[i].Z;
+			}
+
+			VectorBatch::Transform(x, y, z, matrix, x, y, z, count);
+
+			for (int i = 0; i < count; i++)
+			{
+				destination[i].X = x[i];
+				destination[i].Y = y[i];
+				destination[i].Z = z[i];
+			}
 		}
 	}
 
-	void Vector3::Transform(const Vector3 sourceArray[], const int sourceIndex, const Quaternion rotation, Vector3 destinationArray[], const int destinationIndex, const int length)
+	void Vector3::Transform(const Vector3 sourceArray[], const int sourceIndex, const Quaternion& rotation, Vector3 destinationArray[], const int destinationIndex, const int length)
 	{
 		sassert(sourceArray != null, String::Format("sourceArray; %s", FrameworkResources::ArgumentNull_Generic));
 
 		sassert(destinationArray != null, String::Format("destinationArray; %s", FrameworkResources::ArgumentNull_Generic));
 
-		for (int i = sourceIndex, j = destinationIndex; i < (sourceIndex + length); i++, j++)
+		float x[VectorBatch::BatchSize];
+		float y[VectorBatch::BatchSize];
+		float z[VectorBatch::BatchSize];
+
+		for (int offset = 0; offset < length; offset += VectorBatch::BatchSize)
 		{
-			Transform(sourceArray[i], rotation, destinationArray[j]);
+			const Vector3* source = &sourceArray[sourceIndex + offset];
+			Vector3* destination = &destinationArray[destinationIndex + offset];
+			int count = Math::Min(length - offset, VectorBatch::BatchSize);
+
+			for (int i = 0; i < count; i++)
+			{
+				x[i] = source[i].X;
+				y[i] = source[i].Y;
+				z[i] = source[i].Z;
+			}
+
+			VectorBatch::Transform(x, y, z, rotation, x, y, z, count);
+
+			for (int i = 0; i < count; i++)
+			{
+				destination[i].X = x[i];
+				destination[i].Y = y[i];
+				destination[i].Z = z[i];
+			}
 		}
 	}
 
-	Vector3 Vector3::TransformNormal(Vector3 normal, Matrix matrix)
+	void Vector3::Transform(const float sourceX[], const float sourceY[], const float sourceZ[], const Matrix& matrix, float destinationX[], float destinationY[], float destinationZ[], const int length)
+	{
+		VectorBatch::Transform(sourceX, sourceY, sourceZ, matrix, destinationX, destinationY, destinationZ, length);
+	}
+
+	void Vector3::Transform(const float sourceX[], const float sourceY[], const float sourceZ[], const Quaternion& rotation, float destinationX[], float destinationY[], float destinationZ[], const int length)
+	{
+		VectorBatch::Transform(sourceX, sourceY, sourceZ, rotation, destinationX, destinationY, destinationZ, length);
+	}
+
+	Vector3 Vector3::TransformNormal(Vector3 normal, const Matrix& matrix)
 	{
 		Vector3 result; 
 		TransformNormal(normal, matrix, result);
 		return result; 
 	}
 
-	void Vector3::TransformNormal(Vector3 normal, Matrix matrix, out Vector3& result)
+	void Vector3::TransformNormal(Vector3 normal, const Matrix& matrix, out Vector3& result)
 	{
 		result.X = ((normal.X * matrix.M11) + (normal.Y * matrix.M21)) + (normal.Z * matrix.M31); 
 		result.Y = ((normal.X * matrix.M12) + (normal.Y * matrix.M22)) + (normal.Z * matrix.M32); 
 		result.Z = ((normal.X * matrix.M13) + (normal.Y * matrix.M23)) + (normal.Z * matrix.M33); 
 	}
 	
-	void Vector3::TransformNormal(const Vector3 sourceArray[], const int sourceIndex, const Matrix matrix, Vector3 destinationArray[], const int destinationIndex, const int length)
+	void Vector3::TransformNormal(const Vector3 sourceArray[], const int sourceIndex, const Matrix& matrix, Vector3 destinationArray[], const int destinationIndex, const int length)
 	{
 		sassert(sourceArray != null, String::Format("sourceArray; %s", FrameworkResources::ArgumentNull_Generic));
 
 		sassert(destinationArray != null, String::Format("destinationArray; %s", FrameworkResources::ArgumentNull_Generic));
 
-		for(int i = sourceIndex, j = destinationIndex; i < (sourceIndex + length); i++, j++)
+		float x[VectorBatch::BatchSize];
+		float y[VectorBatch::BatchSize];
+		float z[VectorBatch::BatchSize];
+
+		for (int offset = 0; offset < length; offset += VectorBatch::BatchSize)
 		{
-			TransformNormal(sourceArray[i], matrix, destinationArray[j]);
+			const Vector3* source = &sourceArray[sourceIndex + offset];
+			Vector3* destination = &destinationArray[destinationIndex + offset];
+			int count = Math::Min(length - offset, VectorBatch::BatchSize);
+
+			for (int i = 0; i < count; i++)
+			{
+				x[i] = source[i].X;
+				y[i] = source[i].Y;
+				z[i] = source[i].Z;
+			}
+
+			VectorBatch::TransformNormal(x, y, z, matrix, x, y, z, count);
+
+			for (int i = 0; i < count; i++)
+			{
+				destination[i].X = x[i];
+				destination[i].Y = y[i];
+				destination[i].Z = z[i];
+			}
 		}
 	}
 
+	void Vector3::TransformNormal(const float sourceX[], const float sourceY[], const float sourceZ[], const Matrix& matrix, float destinationX[], float destinationY[], float destinationZ[], const int length)
+	{
+		VectorBatch::TransformNormal(sourceX, sourceY, sourceZ, matrix, destinationX, destinationY, destinationZ, length);
+	}
+
 	Vector3 Vector3::operator+(const Vector3& other)
 	{
 		Vector3 result;
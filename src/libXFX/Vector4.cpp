@@ -34,6 +34,7 @@
 #include <System/Array.h>
 #include <System/Math.h>
 #include <System/Type.h>
+#include "VectorBatch.h"
 
 #include <sassert.h>
 
@@ -403,30 +404,90 @@ namespace XFX
 		return String::Format("{X:%f Y:%f Z:%f W:%f}", X, Y, Z, W);
 	}
 
-	void Vector4::Transform(Vector4 sourceArray[], int sourceIndex, Quaternion rotation, Vector4 destinationArray[], int destinationIndex, int length)
+	void Vector4::Transform(Vector4 sourceArray[], int sourceIndex, const Quaternion& rotation, Vector4 destinationArray[], int destinationIndex, int length)
 	{
-		for(int i = sourceIndex, j = destinationIndex; i < (sourceIndex + length); i++, j++)
+		float x[VectorBatch::BatchSize];
+		float y[VectorBatch::BatchSize];
+		float z[VectorBatch::BatchSize];
+		float w[VectorBatch::BatchSize];
+
+		for (int offset = 0; offset < length; offset += VectorBatch::BatchSize)
 		{
-			Transform(sourceArray[i], rotation, destinationArray[j]);
+			const Vector4* source = &sourceArray[sourceIndex + offset];
+			Vector4* destination = &destinationArray[destinationIndex + offset];
+			int count = Math::Min(length - offset, VectorBatch::BatchSize);
+
+			for (int i = 0; i < count; i++)
+			{
+				x[i] = source[i].X;
+				y[i] = source[i].Y;
+				z[i] = source[i].Z;
+				w[i] = source[i].W;
+			}
+
+			VectorBatch::Transform(x, y, z, w, rotation, x, y, z, w, count);
+
+			for (int i = 0; i < count; i++)
+			{
+				destination[i].X = x[i];
+				destination[i].Y = y[i];
+				destination[i].Z = z[i];
+				destination[i].W = w[i];
+			}
 		}
 	}
 
-	void Vector4::Transform(Vector4 sourceArray[], int sourceIndex, Matrix matrix, Vector4 destinationArray[], int destinationIndex, int length)
+	void Vector4::Transform(Vector4 sourceArray[], int sourceIndex, const Matrix& matrix, Vector4 destinationArray[], int destinationIndex, int length)
 	{
-		for(int i = sourceIndex, j = destinationIndex; i < (sourceIndex + length); i++, j++)
+		float x[VectorBatch::BatchSize];
+		float y[VectorBatch::BatchSize];
+		float z[VectorBatch::BatchSize];
+		float w[VectorBatch::BatchSize];
+
+		for (int offset = 0; offset < length; offset += VectorBatch::BatchSize)
 		{
-			Transform(sourceArray[i], matrix, destinationArray[i]);
+			const Vector4* source = &sourceArray[sourceIndex + offset];
+			Vector4* destination = &destinationArray[destinationIndex + offset];
+			int count = Math::Min(length - offset, VectorBatch::BatchSize);
+
+			for (int i = 0; i < count; i++)
+			{
+				x[i] = source[i].X;
+				y[i] = source[i].Y;
+				z[i] = source[i].Z;
+				w[i] = source[i].W;
+			}
+
+			VectorBatch::Transform(x, y, z, w, matrix, x, y, z, w, count);
+
+			for (int i = 0; i < count; i++)
+			{
+				destination[i].X = x[i];
+				destination[i].Y = y[i];
+				destination[i].Z = z[i];
+				destination[i].W = w[i];
+			}
 		}
 	}
 
-	Vector4 Vector4::Transform(Vector4 vector, Quaternion rotation)
+	void Vector4::Transform(const float sourceX[], const float sourceY[], const float sourceZ[], const float sourceW[], const Matrix& matrix, float destinationX[], float destinationY[], float destinationZ[], float destinationW[], const int length)
+	{
+		VectorBatch::Transform(sourceX, sourceY, sourceZ, sourceW, matrix, destinationX, destinationY, destinationZ, destinationW, length);
+	}
+
+	void Vector4::Transform(const float sourceX[], const float sourceY[], const float sourceZ[], const float sourceW[], const Quaternion& rotation, float destinationX[], float destinationY[], float destinationZ[], float destinationW[], const int length)
+	{
+		VectorBatch::Transform(sourceX, sourceY, sourceZ, sourceW, rotation, destinationX, destinationY, destinationZ, destinationW, length);
+	}
+
+	Vector4 Vector4::Transform(Vector4 vector, const Quaternion& rotation)
 	{
 		Vector4 result;
 		Transform(vector, rotation, result);
 		return result;
 	}
 
-	void Vector4::Transform(Vector4 vector, Quaternion rotation, out Vector4& result)
+	void Vector4::Transform(Vector4 vector, const Quaternion& rotation, out Vector4& result)
 	{
 		float x = rotation.X + rotation.X;
 		float y = rotation.Y + rotation.Y;
@@ -446,14 +507,14 @@ namespace XFX
 		result.W = vector.W;
 	}
 
-	Vector4 Vector4::Transform(Vector3 vector, Quaternion rotation)
+	Vector4 Vector4::Transform(Vector3 vector, const Quaternion& rotation)
 	{
 		Vector4 result;
 		Transform(vector, rotation, result);
 		return result;
 	}
 
-	void Vector4::Transform(Vector3 vector, Quaternion rotation, out Vector4& result)
+	void Vector4::Transform(Vector3 vector, const Quaternion& rotation, out Vector4& result)
 	{
 		float x = rotation.X + rotation.X;
 		float y = rotation.Y + rotation.Y;
@@ -473,14 +534,14 @@ namespace XFX
 		result.W = 1.0f;
 	}
 
-	Vector4 Vector4::Transform(Vector2 vector, Quaternion rotation)
+	Vector4 Vector4::Transform(Vector2 vector, const Quaternion& rotation)
 	{
 		Vector4 result;
 		Transform(vector, rotation, result);
 		return result;
 	}
 
-	void Vector4::Transform(Vector2 vector, Quaternion rotation, out Vector4& result)
+	void Vector4::Transform(Vector2 vector, const Quaternion& rotation, out Vector4& result)
 	{
 		float x = rotation.X + rotation.X;
 		float y = rotation.Y + rotation.Y;
@@ -500,14 +561,14 @@ namespace XFX
 		result.W = 1.0f;
 	}
 
-	Vector4 Vector4::Transform(Vector4 vector, Matrix matrix)
+	Vector4 Vector4::Transform(Vector4 vector, const Matrix& matrix)
 	{
 		Vector4 vector2;
 		Transform(vector, matrix, vector2);
-		return vector;
+		return vector2;
 	}
 
-	void Vector4::Transform(Vector4 vector, Matrix matrix, out Vector4& result)
+	void Vector4::Transform(Vector4 vector, const Matrix& matrix, out Vector4& result)
 	{
 		result.X = (vector.X * matrix.M11) + (vector.Y * matrix.M21) + (vector.Z * matrix.M31) + (vector.W * matrix.M41);
 		result.Y = (vector.X * matrix.M12) + (vector.Y * matrix.M22) + (vector.Z * matrix.M32) + (vector.W * matrix.M42);
@@ -515,14 +576,14 @@ namespace XFX
 		result.W = (vector.X * matrix.M14) + (vector.Y * matrix.M24) + (vector.Z * matrix.M34) + (vector.W * matrix.M44);
 	}
 
-	Vector4 Vector4::Transform(Vector3 vector, Matrix matrix)
+	Vector4 Vector4::Transform(Vector3 vector, const Matrix& matrix)
 	{
 		Vector4 result;
 		Transform(vector, matrix, result);
 		return result;
 	}
 
-	void Vector4::Transform(Vector3 vector, Matrix matrix, out Vector4& result)
+	void Vector4::Transform(Vector3 vector, const Matrix& matrix, out Vector4& result)
 	{
 		result.X = (vector.X * matrix.M11) + (vector.Y * matrix.M21) + (vector.Z * matrix.M31) + matrix.M41;
 		result.Y = (vector.X * matrix.M12) + (vector.Y * matrix.M22) + (vector.Z * matrix.M32) + matrix.M42;
@@ -530,14 +591,14 @@ namespace XFX
 		result.W = (vector.X * matrix.M14) + (vector.Y * matrix.M24) + (vector.Z * matrix.M34) + matrix.M44; 
 	}
 
-	Vector4 Vector4::Transform(Vector2 vector, Matrix matrix)
+	Vector4 Vector4::Transform(Vector2 vector, const Matrix& matrix)
 	{
 		Vector4 result;
 		Transform(vector, matrix, result);
 		return result;
 	}
 
-	void Vector4::Transform(Vector2 vector, Matrix matrix, out Vector4& result)
+	void Vector4::Transform(Vector2 vector, const Matrix& matrix, out Vector4& result)
 	{
 		result.X = (vector.X * matrix.M11) + (vector.Y * matrix.M21) + matrix.M41;
 		result.Y = (vector.X * matrix.M12) + (vector.Y * matrix.M22) + matrix.M42;
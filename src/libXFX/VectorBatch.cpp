@@ -0,0 +1,309 @@
+// Copyright (C) XFX Team
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without 
+// modification, are permitted provided that the following conditions are met:
+// 
+//     * Redistributions of source code must retain the above copyright 
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright 
+//       notice, this list of conditions and the following disclaimer in the 
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the copyright holder nor the names of any 
+//       contributors may be used to endorse or promote products derived from 
+//       this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE 
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF 
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS 
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE 
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include <Matrix.h>
+#include <Quaternion.h>
+#include "VectorBatch.h"
+
+#if __SSE__
+#include <xmmintrin.h>
+#endif
+
+namespace XFX
+{
+	void VectorBatch::FromQuaternion(const Quaternion& rotation, float rows[16])
+	{
+		float x = rotation.X + rotation.X;
+		float y = rotation.Y + rotation.Y;
+		float z = rotation.Z + rotation.Z;
+		float wx = rotation.W * x;
+		float wy = rotation.W * y;
+		float wz = rotation.W * z;
+		float xx = rotation.X * x;
+		float xy = rotation.X * y;
+		float xz = rotation.X * z;
+		float yy = rotation.Y * y;
+		float yz = rotation.Y * z;
+		float zz = rotation.Z * z;
+
+		rows[0] = (1.0f - yy) - zz;
+		rows[1] = xy + wz;
+		rows[2] = xz - wy;
+		rows[3] = 0.0f;
+
+		rows[4] = xy - wz;
+		rows[5] = (1.0f - xx) - zz;
+		rows[6] = yz + wx;
+		rows[7] = 0.0f;
+
+		rows[8] = xz + wy;
+		rows[9] = yz - wx;
+		rows[10] = (1.0f - xx) - yy;
+		rows[11] = 0.0f;
+
+		rows[12] = 0.0f;
+		rows[13] = 0.0f;
+		rows[14] = 0.0f;
+		rows[15] = 1.0f;
+	}
+
+	void VectorBatch::Coordinate2(const float m[16], const float sourceX[], const float sourceY[], float destinationX[], float destinationY[], const int length)
+	{
+		int i = 0;
+
+#if __SSE__
+		const __m128 m11 = _mm_set1_ps(m[0]), m12 = _mm_set1_ps(m[1]), m14 = _mm_set1_ps(m[3]);
+		const __m128 m21 = _mm_set1_ps(m[4]), m22 = _mm_set1_ps(m[5]), m24 = _mm_set1_ps(m[7]);
+		const __m128 m41 = _mm_set1_ps(m[12]), m42 = _mm_set1_ps(m[13]), m44 = _mm_set1_ps(m[15]);
+		const __m128 one = _mm_set1_ps(1.0f);
+
+		for (; i + 4 <= length; i += 4)
+		{
+			__m128 x = _mm_loadu_ps(&sourceX[i]);
+			__m128 y = _mm_loadu_ps(&sourceY[i]);
+
+			__m128 rx = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, m11), _mm_mul_ps(y, m21)), m41);
+			__m128 ry = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, m12), _mm_mul_ps(y, m22)), m42);
+			__m128 rw = _mm_div_ps(one, _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, m14), _mm_mul_ps(y, m24)), m44));
+
+			_mm_storeu_ps(&destinationX[i], _mm_mul_ps(rx, rw));
+			_mm_storeu_ps(&destinationY[i], _mm_mul_ps(ry, rw));
+		}
+#endif
+
+		for (; i < length; i++)
+		{
+			float x = sourceX[i];
+			float y = sourceY[i];
+
+			float rx = ((x * m[0]) + (y * m[4])) + m[12];
+			float ry = ((x * m[1]) + (y * m[5])) + m[13];
+			float rw = 1.0f / (((x * m[3]) + (y * m[7])) + m[15]);
+
+			destinationX[i] = rx * rw;
+			destinationY[i] = ry * rw;
+		}
+	}
+
+	void VectorBatch::Normal2(const float m[16], const float sourceX[], const float sourceY[], float destinationX[], float destinationY[], const int length)
+	{
+		int i = 0;
+
+#if __SSE__
+		const __m128 m11 = _mm_set1_ps(m[0]), m12 = _mm_set1_ps(m[1]);
+		const __m128 m21 = _mm_set1_ps(m[4]), m22 = _mm_set1_ps(m[5]);
+
+		for (; i + 4 <= length; i += 4)
+		{
+			__m128 x = _mm_loadu_ps(&sourceX[i]);
+			__m128 y = _mm_loadu_ps(&sourceY[i]);
+
+			_mm_storeu_ps(&destinationX[i], _mm_add_ps(_mm_mul_ps(x, m11), _mm_mul_ps(y, m21)));
+			_mm_storeu_ps(&destinationY[i], _mm_add_ps(_mm_mul_ps(x, m12), _mm_mul_ps(y, m22)));
+		}
+#endif
+
+		for (; i < length; i++)
+		{
+			float x = sourceX[i];
+			float y = sourceY[i];
+
+			destinationX[i] = (x * m[0]) + (y * m[4]);
+			destinationY[i] = (x * m[1]) + (y * m[5]);
+		}
+	}
+
+	void VectorBatch::Coordinate3(const float m[16], const float sourceX[], const float sourceY[], const float sourceZ[], float destinationX[], float destinationY[], float destinationZ[], const int length)
+	{
+		int i = 0;
+
+#if __SSE__
+		const __m128 m11 = _mm_set1_ps(m[0]), m12 = _mm_set1_ps(m[1]), m13 = _mm_set1_ps(m[2]), m14 = _mm_set1_ps(m[3]);
+		const __m128 m21 = _mm_set1_ps(m[4]), m22 = _mm_set1_ps(m[5]), m23 = _mm_set1_ps(m[6]), m24 = _mm_set1_ps(m[7]);
+		const __m128 m31 = _mm_set1_ps(m[8]), m32 = _mm_set1_ps(m[9]), m33 = _mm_set1_ps(m[10]), m34 = _mm_set1_ps(m[11]);
+		const __m128 m41 = _mm_set1_ps(m[12]), m42 = _mm_set1_ps(m[13]), m43 = _mm_set1_ps(m[14]), m44 = _mm_set1_ps(m[15]);
+		const __m128 one = _mm_set1_ps(1.0f);
+
+		for (; i + 4 <= length; i += 4)
+		{
+			__m128 x = _mm_loadu_ps(&sourceX[i]);
+			__m128 y = _mm_loadu_ps(&sourceY[i]);
+			__m128 z = _mm_loadu_ps(&sourceZ[i]);
+
+			__m128 rx = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, m11), _mm_mul_ps(y, m21)), _mm_mul_ps(z, m31)), m41);
+			__m128 ry = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, m12), _mm_mul_ps(y, m22)), _mm_mul_ps(z, m32)), m42);
+			__m128 rz = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, m13), _mm_mul_ps(y, m23)), _mm_mul_ps(z, m33)), m43);
+			__m128 rw = _mm_div_ps(one, _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, m14), _mm_mul_ps(y, m24)), _mm_mul_ps(z, m34)), m44));
+
+			_mm_storeu_ps(&destinationX[i], _mm_mul_ps(rx, rw));
+			_mm_storeu_ps(&destinationY[i], _mm_mul_ps(ry, rw));
+			_mm_storeu_ps(&destinationZ[i], _mm_mul_ps(rz, rw));
+		}
+#endif
+
+		for (; i < length; i++)
+		{
+			float x = sourceX[i];
+			float y = sourceY[i];
+			float z = sourceZ[i];
+
+			float rx = (((x * m[0]) + (y * m[4])) + (z * m[8])) + m[12];
+			float ry = (((x * m[1]) + (y * m[5])) + (z * m[9])) + m[13];
+			float rz = (((x * m[2]) + (y * m[6])) + (z * m[10])) + m[14];
+			float rw = 1.0f / ((((x * m[3]) + (y * m[7])) + (z * m[11])) + m[15]);
+
+			destinationX[i] = rx * rw;
+			destinationY[i] = ry * rw;
+			destinationZ[i] = rz * rw;
+		}
+	}
+
+	void VectorBatch::Normal3(const float m[16], const float sourceX[], const float sourceY[], const float sourceZ[], float destinationX[], float destinationY[], float destinationZ[], const int length)
+	{
+		int i = 0;
+
+#if __SSE__
+		const __m128 m11 = _mm_set1_ps(m[0]), m12 = _mm_set1_ps(m[1]), m13 = _mm_set1_ps(m[2]);
+		const __m128 m21 = _mm_set1_ps(m[4]), m22 = _mm_set1_ps(m[5]), m23 = _mm_set1_ps(m[6]);
+		const __m128 m31 = _mm_set1_ps(m[8]), m32 = _mm_set1_ps(m[9]), m33 = _mm_set1_ps(m[10]);
+
+		for (; i + 4 <= length; i += 4)
+		{
+			__m128 x = _mm_loadu_ps(&sourceX[i]);
+			__m128 y = _mm_loadu_ps(&sourceY[i]);
+			__m128 z = _mm_loadu_ps(&sourceZ[i]);
+
+			_mm_storeu_ps(&destinationX[i], _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, m11), _mm_mul_ps(y, m21)), _mm_mul_ps(z, m31)));
+			_mm_storeu_ps(&destinationY[i], _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, m12), _mm_mul_ps(y, m22)), _mm_mul_ps(z, m32)));
+			_mm_storeu_ps(&destinationZ[i], _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, m13), _mm_mul_ps(y, m23)), _mm_mul_ps(z, m33)));
+		}
+#endif
+
+		for (; i < length; i++)
+		{
+			float x = sourceX[i];
+			float y = sourceY[i];
+			float z = sourceZ[i];
+
+			destinationX[i] = ((x * m[0]) + (y * m[4])) + (z * m[8]);
+			destinationY[i] = ((x * m[1]) + (y * m[5])) + (z * m[9]);
+			destinationZ[i] = ((x * m[2]) + (y * m[6])) + (z * m[10]);
+		}
+	}
+
+	void VectorBatch::Transform4(const float m[16], const float sourceX[], const float sourceY[], const float sourceZ[], const float sourceW[], float destinationX[], float destinationY[], float destinationZ[], float destinationW[], const int length)
+	{
+		int i = 0;
+
+#if __SSE__
+		const __m128 m11 = _mm_set1_ps(m[0]), m12 = _mm_set1_ps(m[1]), m13 = _mm_set1_ps(m[2]), m14 = _mm_set1_ps(m[3]);
+		const __m128 m21 = _mm_set1_ps(m[4]), m22 = _mm_set1_ps(m[5]), m23 = _mm_set1_ps(m[6]), m24 = _mm_set1_ps(m[7]);
+		const __m128 m31 = _mm_set1_ps(m[8]), m32 = _mm_set1_ps(m[9]), m33 = _mm_set1_ps(m[10]), m34 = _mm_set1_ps(m[11]);
+		const __m128 m41 = _mm_set1_ps(m[12]), m42 = _mm_set1_ps(m[13]), m43 = _mm_set1_ps(m[14]), m44 = _mm_set1_ps(m[15]);
+
+		for (; i + 4 <= length; i += 4)
+		{
+			__m128 x = _mm_loadu_ps(&sourceX[i]);
+			__m128 y = _mm_loadu_ps(&sourceY[i]);
+			__m128 z = _mm_loadu_ps(&sourceZ[i]);
+			__m128 w = _mm_loadu_ps(&sourceW[i]);
+
+			_mm_storeu_ps(&destinationX[i], _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, m11), _mm_mul_ps(y, m21)), _mm_mul_ps(z, m31)), _mm_mul_ps(w, m41)));
+			_mm_storeu_ps(&destinationY[i], _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, m12), _mm_mul_ps(y, m22)), _mm_mul_ps(z, m32)), _mm_mul_ps(w, m42)));
+			_mm_storeu_ps(&destinationZ[i], _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, m13), _mm_mul_ps(y, m23)), _mm_mul_ps(z, m33)), _mm_mul_ps(w, m43)));
+			_mm_storeu_ps(&destinationW[i], _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, m14), _mm_mul_ps(y, m24)), _mm_mul_ps(z, m34)), _mm_mul_ps(w, m44)));
+		}
+#endif
+
+		for (; i < length; i++)
+		{
+			float x = sourceX[i];
+			float y = sourceY[i];
+			float z = sourceZ[i];
+			float w = sourceW[i];
+
+			destinationX[i] = (((x * m[0]) + (y * m[4])) + (z * m[8])) + (w * m[12]);
+			destinationY[i] = (((x * m[1]) + (y * m[5])) + (z * m[9])) + (w * m[13]);
+			destinationZ[i] = (((x * m[2]) + (y * m[6])) + (z * m[10])) + (w * m[14]);
+			destinationW[i] = (((x * m[3]) + (y * m[7])) + (z * m[11])) + (w * m[15]);
+		}
+	}
+
+	void VectorBatch::Transform(const float sourceX[], const float sourceY[], const Matrix& matrix, float destinationX[], float destinationY[], const int length)
+	{
+		Coordinate2(&matrix.M11, sourceX, sourceY, destinationX, destinationY, length);
+	}
+
+	void VectorBatch::Transform(const float sourceX[], const float sourceY[], const Quaternion& rotation, float destinationX[], float destinationY[], const int length)
+	{
+		float rows[16];
+		FromQuaternion(rotation, rows);
+		Normal2(rows, sourceX, sourceY, destinationX, destinationY, length);
+	}
+
+	void VectorBatch::TransformNormal(const float sourceX[], const float sourceY[], const Matrix& matrix, float destinationX[], float destinationY[], const int length)
+	{
+		Normal2(&matrix.M11, sourceX, sourceY, destinationX, destinationY, length);
+	}
+
+	void VectorBatch::Transform(const float sourceX[], const float sourceY[], const float sourceZ[], const Matrix& matrix, float destinationX[], float destinationY[], float destinationZ[], const int length)
+	{
+		Coordinate3(&matrix.M11, sourceX, sourceY, sourceZ, destinationX, destinationY, destinationZ, length);
+	}
+
+	void VectorBatch::Transform(const float sourceX[], const float sourceY[], const float sourceZ[], const Quaternion& rotation, float destinationX[], float destinationY[], float destinationZ[], const int length)
+	{
+		float rows[16];
+		FromQuaternion(rotation, rows);
+		Normal3(rows, sourceX, sourceY, sourceZ, destinationX, destinationY, destinationZ, length);
+	}
+
+	void VectorBatch::TransformNormal(const float sourceX[], const float sourceY[], const float sourceZ[], const Matrix& matrix, float destinationX[], float destinationY[], float destinationZ[], const int length)
+	{
+		Normal3(&matrix.M11, sourceX, sourceY, sourceZ, destinationX, destinationY, destinationZ, length);
+	}
+
+	void VectorBatch::Transform(const float sourceX[], const float sourceY[], const float sourceZ[], const float sourceW[], const Matrix& matrix, float destinationX[], float destinationY[], float destinationZ[], float destinationW[], const int length)
+	{
+		Transform4(&matrix.M11, sourceX, sourceY, sourceZ, sourceW, destinationX, destinationY, destinationZ, destinationW, length);
+	}
+
+	void VectorBatch::Transform(const float sourceX[], const float sourceY[], const float sourceZ[], const float sourceW[], const Quaternion& rotation, float destinationX[], float destinationY[], float destinationZ[], float destinationW[], const int length)
+	{
+		float rows[16];
+		FromQuaternion(rotation, rows);
+		Normal3(rows, sourceX, sourceY, sourceZ, destinationX, destinationY, destinationZ, length);
+
+		if (destinationW != sourceW)
+		{
+			for (int i = 0; i < length; i++)
+			{
+				destinationW[i] = sourceW[i];
+			}
+		}
+	}
+}
@@ -0,0 +1,53 @@
+/*****************************************************************************
+ *	VectorBatch.h															 *
+ *																			 *
+ *	XFX::VectorBatch class definition file									 *
+ *	Copyright (c) XFX Team. All Rights Reserved 							 *
+ *****************************************************************************/
+#ifndef _XFX_VECTORBATCH_
+#define _XFX_VECTORBATCH_
+
+namespace XFX
+{
+	struct Matrix;
+	struct Quaternion;
+
+	/**
+	 * Transforms structure-of-arrays vector streams.
+	 *
+	 * Four elements are processed per iteration when the library is compiled with SSE enabled (-msse), otherwise a portable scalar loop is used.
+	 * Both paths evaluate the same expressions in the same order, so they produce identical results.
+	 */
+	class VectorBatch
+	{
+	private:
+		VectorBatch(); // Private constructor to prevent instantiation.
+
+		static void FromQuaternion(const Quaternion& rotation, float rows[16]);
+
+		static void Coordinate2(const float m[16], const float sourceX[], const float sourceY[], float destinationX[], float destinationY[], const int length);
+		static void Normal2(const float m[16], const float sourceX[], const float sourceY[], float destinationX[], float destinationY[], const int length);
+		static void Coordinate3(const float m[16], const float sourceX[], const float sourceY[], const float sourceZ[], float destinationX[], float destinationY[], float destinationZ[], const int length);
+		static void Normal3(const float m[16], const float sourceX[], const float sourceY[], const float sourceZ[], float destinationX[], float destinationY[], float destinationZ[], const int length);
+		static void Transform4(const float m[16], const float sourceX[], const float sourceY[], const float sourceZ[], const float sourceW[], float destinationX[], float destinationY[], float destinationZ[], float destinationW[], const int length);
+
+	public:
+		/**
+		 * The number of elements the array overloads of the vector types gather into their stack buffers per pass.
+		 */
+		static const int BatchSize = 64;
+
+		static void Transform(const float sourceX[], const float sourceY[], const Matrix& matrix, float destinationX[], float destinationY[], const int length);
+		static void Transform(const float sourceX[], const float sourceY[], const Quaternion& rotation, float destinationX[], float destinationY[], const int length);
+		static void TransformNormal(const float sourceX[], const float sourceY[], const Matrix& matrix, float destinationX[], float destinationY[], const int length);
+
+		static void Transform(const float sourceX[], const float sourceY[], const float sourceZ[], const Matrix& matrix, float destinationX[], float destinationY[], float destinationZ[], const int length);
+		static void Transform(const float sourceX[], const float sourceY[], const float sourceZ[], const Quaternion& rotation, float destinationX[], float destinationY[], float destinationZ[], const int length);
+		static void TransformNormal(const float sourceX[], const float sourceY[], const float sourceZ[], const Matrix& matrix, float destinationX[], float destinationY[], float destinationZ[], const int length);
+
+		static void Transform(const float sourceX[], const float sourceY[], const float sourceZ[], const float sourceW[], const Matrix& matrix, float destinationX[], float destinationY[], float destinationZ[], float destinationW[], const int length);
+		static void Transform(const float sourceX[], const float sourceY[], const float sourceZ[], const float sourceW[], const Quaternion& rotation, float destinationX[], float destinationY[], float destinationZ[], float destinationW[], const int length);
+	};
+}
+
+#endif //_XFX_VECTORBATCH_
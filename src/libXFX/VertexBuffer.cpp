@@ -0,0 +1,123 @@
+// Copyright (C) XFX Team
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without 
+// modification, are permitted provided that the following conditions are met:
+// 
+//     * Redistributions of source code must retain the above copyright 
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright 
+//       notice, this list of conditions and the following disclaimer in the 
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the copyright holder nor the names of any 
+//       contributors may be used to endorse or promote products derived from 
+//       this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE 
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF 
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS 
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE 
+// POSSIBILITY OF SUCH DAMAGE.
+
+extern "C"
+{
+#include "pbKit.h"
+#if ENABLE_XBOX
+#include <xboxkrnl/xboxkrnl.h>
+#endif
+}
+
+#include <Graphics/GraphicsDevice.h>
+#include <Graphics/VertexBuffer.h>
+#include <System/Type.h>
+
+#include <stdlib.h>
+
+namespace XFX
+{
+	namespace Graphics
+	{
+		const Type VertexBufferTypeInfo("VertexBuffer", "XFX::Graphics::VertexBuffer", TypeCode::Object);
+
+		BufferUsage_t VertexBuffer::getBufferUsage() const
+		{
+			return bufferUsage;
+		}
+
+		int VertexBuffer::getVertexCount() const
+		{
+			return vertexCount;
+		}
+
+		VertexDeclaration* VertexBuffer::getVertexDeclaration() const
+		{
+			return vertexDeclaration;
+		}
+
+		VertexBuffer::VertexBuffer()
+			: bufferUsage(BufferUsage::None), data(null), vertexCount(0), vertexDeclaration(null)
+		{
+		}
+
+		VertexBuffer::VertexBuffer(GraphicsDevice * const graphicsDevice, VertexDeclaration vertexDeclaration, int vertexCount, BufferUsage_t usage)
+			: bufferUsage(usage), data(null), vertexCount(vertexCount), vertexDeclaration(new VertexDeclaration(vertexDeclaration))
+		{
+			sassert(graphicsDevice != null, String::Format("graphicsDevice; %s", FrameworkResources::ArgumentNull_Generic));
+			sassert(vertexCount > 0, String::Format("vertexCount; %s", FrameworkResources::ArgumentOutOfRange_NeedPosNum));
+
+			this->graphicsDevice = graphicsDevice;
+
+			if (vertexCount <= 0)
+			{
+				this->vertexCount = 0;
+				return;
+			}
+
+			const int size = vertexCount * vertexDeclaration.getVertexStride();
+
+			// The GPU reads the vertices straight from this buffer, so on the Xbox it has to live in physically contiguous, write-combined memory.
+#if ENABLE_XBOX
+			data = (byte*)MmAllocateContiguousMemoryEx(size, 0, 0x03FFAFFF, 0, PAGE_READWRITE | PAGE_WRITECOMBINE);
+#else
+			data = (byte*)malloc(size);
+#endif
+		}
+
+		VertexBuffer::~VertexBuffer()
+		{
+			Dispose(false);
+		}
+
+		void VertexBuffer::Dispose(bool disposing)
+		{
+			if (data != null)
+			{
+				// Make sure the GPU is no longer reading from the buffer before releasing it.
+				while (pb_busy());
+#if ENABLE_XBOX
+				MmFreeContiguousMemory(data);
+#else
+				free(data);
+#endif
+				data = null;
+			}
+
+			delete vertexDeclaration;
+			vertexDeclaration = null;
+			vertexCount = 0;
+
+			GraphicsResource::Dispose(disposing);
+		}
+
+		const Type& VertexBuffer::GetType()
+		{
+			return VertexBufferTypeInfo;
+		}
+	}
+}
@@ -26,11 +26,48 @@
 // POSSIBILITY OF SUCH DAMAGE.
 
 #include <Graphics/VertexDeclaration.h>
+#include <System/Type.h>
+
+#include <stdlib.h>
+#include <string.h>
 
 namespace XFX
 {
 	namespace Graphics
 	{
+		const Type VertexDeclarationTypeInfo("VertexDeclaration", "XFX::Graphics::VertexDeclaration", TypeCode::Object);
+
+		// Returns the size in bytes of an element of the given format.
+		static int GetElementSize(const VertexElementFormat_t format)
+		{
+			switch (format)
+			{
+			case VertexElementFormat::Single:
+			case VertexElementFormat::Byte4:
+			case VertexElementFormat::Color:
+			case VertexElementFormat::HalfVector2:
+			case VertexElementFormat::NormalizedShort2:
+			case VertexElementFormat::Short2:
+				return 4;
+			case VertexElementFormat::HalfVector4:
+			case VertexElementFormat::NormalizedShort4:
+			case VertexElementFormat::Short4:
+			case VertexElementFormat::Vector2:
+				return 8;
+			case VertexElementFormat::Vector3:
+				return 12;
+			case VertexElementFormat::Vector4:
+				return 16;
+			default:
+				return 0;
+			}
+		}
+
+		int VertexDeclaration::getElementCount() const
+		{
+			return elementCount;
+		}
+
 		int VertexDeclaration::getVertexStride() const
 		{
 			return vertexStride;
@@ -50,6 +87,17 @@ namespace XFX
 			vertexElements = (VertexElement*)calloc(elementCount, sizeof(VertexElement));
 
 			memcpy(vertexElements, elements, elementCount * sizeof(VertexElement));
+
+			// The vertices are packed: the stride ends with the last byte of any element.
+			for (int i = 0; i < elementCount; i++)
+			{
+				const int end = elements[i].Offset + GetElementSize(elements[i].VertexElementFormat);
+
+				if (end > vertexStride)
+				{
+					vertexStride = end;
+				}
+			}
 		}
 
 		VertexDeclaration::VertexDeclaration(const VertexDeclaration &obj)
@@ -59,28 +107,26 @@ namespace XFX
 			vertexElements = (VertexElement*)calloc(elementCount, sizeof(VertexElement));
 
 			// copy over the VertexElement data
-			memcpy(vertexElements, obj.vertexElements, elementCount * sizeof(VertexElement);
+			memcpy(vertexElements, obj.vertexElements, elementCount * sizeof(VertexElement));
 		}
 
 		VertexDeclaration::~VertexDeclaration()
 		{
-			if (!IsDisposed)
-			{
-				free(vertexElements);
-			}
+			Dispose(true);
 		}
 
 		void VertexDeclaration::Dispose(bool disposing)
 		{
-			if (!IsDisposed)
-			{
-				free(vertexElements);
-			}
+			free(vertexElements);
+			vertexElements = NULL;
+			elementCount = 0;
+
+			GraphicsResource::Dispose(disposing);
 		}
 
-		int VertexDeclaration::GetType()
+		const Type& VertexDeclaration::GetType()
 		{
-			// TODO: implement
+			return VertexDeclarationTypeInfo;
 		}
 
 		VertexElement* VertexDeclaration::GetVertexElements() const
@@ -0,0 +1,147 @@
+// Copyright (C) XFX Team
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without 
+// modification, are permitted provided that the following conditions are met:
+// 
+//* Redistributions of source code must retain the above copyright 
+//notice, this list of conditions and the following disclaimer.
+//* Redistributions in binary form must reproduce the above copyright 
+//notice, this list of conditions and the following disclaimer in the 
+//documentation and/or other materials provided with the distribution.
+//* Neither the name of the copyright holder nor the names of any 
+//contributors may be used to endorse or promote products derived from 
+//this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE 
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF 
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS 
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE 
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include <Matrix.h>
+#include "VertexSkinning.h"
+
+#include <sassert.h>
+
+#if __SSE__
+#include <xmmintrin.h>
+#endif
+
+namespace XFX
+{
+	namespace Graphics
+	{
+		// Returns the rows of the bone a vertex references, falling back to the first bone for indices past the palette.
+		static inline const float* BoneRows(const Matrix bones[], const int boneCount, const int index)
+		{
+			sassert(index < boneCount, "Blend index is outside the bone palette.");
+
+			return &bones[(index < boneCount) ? index : 0].M11;
+		}
+
+		void VertexSkinning::Skin(const Matrix bones[], const int boneCount, const int weightsPerVertex,
+			void const * const source, void * const destination, const int vertexCount, const int vertexStride,
+			const int positionOffset, const int normalOffset, const int indicesOffset, const int weightsOffset)
+		{
+			const byte* sourceVertex = (const byte*)source;
+			byte* destinationVertex = (byte*)destination;
+
+			for (int i = 0; i < vertexCount; i++, sourceVertex += vertexStride, destinationVertex += vertexStride)
+			{
+				const byte* indices = sourceVertex + indicesOffset;
+				const float* weights = (const float*)(sourceVertex + weightsOffset);
+				const float* position = (const float*)(sourceVertex + positionOffset);
+				float* skinnedPosition = (float*)(destinationVertex + positionOffset);
+				const float* bone = BoneRows(bones, boneCount, indices[0]);
+
+#if __SSE__
+				__m128 weight = _mm_set1_ps(weights[0]);
+				__m128 r1 = _mm_mul_ps(weight, _mm_loadu_ps(bone));
+				__m128 r2 = _mm_mul_ps(weight, _mm_loadu_ps(bone + 4));
+				__m128 r3 = _mm_mul_ps(weight, _mm_loadu_ps(bone + 8));
+				__m128 r4 = _mm_mul_ps(weight, _mm_loadu_ps(bone + 12));
+
+				for (int j = 1; j < weightsPerVertex; j++)
+				{
+					bone = BoneRows(bones, boneCount, indices[j]);
+					weight = _mm_set1_ps(weights[j]);
+
+					r1 = _mm_add_ps(r1, _mm_mul_ps(weight, _mm_loadu_ps(bone)));
+					r2 = _mm_add_ps(r2, _mm_mul_ps(weight, _mm_loadu_ps(bone + 4)));
+					r3 = _mm_add_ps(r3, _mm_mul_ps(weight, _mm_loadu_ps(bone + 8)));
+					r4 = _mm_add_ps(r4, _mm_mul_ps(weight, _mm_loadu_ps(bone + 12)));
+				}
+
+				// Vector3 elements are 12 bytes, so results are stored as x and y, then z, to stay inside the element.
+				__m128 result = _mm_add_ps(_mm_add_ps(_mm_add_ps(
+					_mm_mul_ps(_mm_set1_ps(position[0]), r1),
+					_mm_mul_ps(_mm_set1_ps(position[1]), r2)),
+					_mm_mul_ps(_mm_set1_ps(position[2]), r3)),
+					r4);
+
+				_mm_storel_pi((__m64*)skinnedPosition, result);
+				_mm_store_ss(skinnedPosition + 2, _mm_movehl_ps(result, result));
+
+				if (normalOffset >= 0)
+				{
+					const float* normal = (const float*)(sourceVertex + normalOffset);
+					float* skinnedNormal = (float*)(destinationVertex + normalOffset);
+
+					result = _mm_add_ps(_mm_add_ps(
+						_mm_mul_ps(_mm_set1_ps(normal[0]), r1),
+						_mm_mul_ps(_mm_set1_ps(normal[1]), r2)),
+						_mm_mul_ps(_mm_set1_ps(normal[2]), r3));
+
+					_mm_storel_pi((__m64*)skinnedNormal, result);
+					_mm_store_ss(skinnedNormal + 2, _mm_movehl_ps(result, result));
+				}
+#else
+				float m[16];
+
+				for (int k = 0; k < 16; k++)
+				{
+					m[k] = weights[0] * bone[k];
+				}
+
+				for (int j = 1; j < weightsPerVertex; j++)
+				{
+					bone = BoneRows(bones, boneCount, indices[j]);
+
+					for (int k = 0; k < 16; k++)
+					{
+						m[k] = m[k] + (weights[j] * bone[k]);
+					}
+				}
+
+				const float x = position[0];
+				const float y = position[1];
+				const float z = position[2];
+
+				skinnedPosition[0] = (((x * m[0]) + (y * m[4])) + (z * m[8])) + m[12];
+				skinnedPosition[1] = (((x * m[1]) + (y * m[5])) + (z * m[9])) + m[13];
+				skinnedPosition[2] = (((x * m[2]) + (y * m[6])) + (z * m[10])) + m[14];
+
+				if (normalOffset >= 0)
+				{
+					const float* normal = (const float*)(sourceVertex + normalOffset);
+					float* skinnedNormal = (float*)(destinationVertex + normalOffset);
+					const float nx = normal[0];
+					const float ny = normal[1];
+					const float nz = normal[2];
+
+					skinnedNormal[0] = ((nx * m[0]) + (ny * m[4])) + (nz * m[8]);
+					skinnedNormal[1] = ((nx * m[1]) + (ny * m[5])) + (nz * m[9]);
+					skinnedNormal[2] = ((nx * m[2]) + (ny * m[6])) + (nz * m[10]);
+				}
+#endif
+			}
+		}
+	}
+}
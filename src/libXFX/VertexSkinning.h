@@ -0,0 +1,47 @@
+/*****************************************************************************
+ *	VertexSkinning.h														 *
+ *																			 *
+ *	XFX::Graphics::VertexSkinning class definition file 					 *
+ *	Copyright (c) XFX Team. All Rights Reserved 							 *
+ *****************************************************************************/
+#ifndef _XFX_GRAPHICS_VERTEXSKINNING_
+#define _XFX_GRAPHICS_VERTEXSKINNING_
+
+#include <System/Types.h>
+
+using namespace System;
+
+namespace XFX
+{
+	struct Matrix;
+
+	namespace Graphics
+	{
+		/**
+		 * Skins interleaved vertex streams on the CPU.
+		 *
+		 * With SSE enabled (-msse) the blended bone matrix is kept as four rows in registers and each position and normal is transformed with its x, y, z and w in the four lanes;
+		 * for interleaved vertices this is cheaper than transposing groups of vertices into structure-of-arrays form. Otherwise a portable scalar loop is used.
+		 * Both paths evaluate the same expressions in the same order, so they produce identical results.
+		 */
+		// This class is not meant to be used by the end user.
+		// Only XFX source files should reference this class.
+		class VertexSkinning
+		{
+		private:
+			VertexSkinning(); // Private constructor to prevent instantiation.
+
+		public:
+			/**
+			 * Blends the bones referenced by each vertex and transforms its position, and its normal when normalOffset is not negative.
+			 * Positions and normals are Vector3, blend indices are Byte4 and blend weights are Vector4, of which the first weightsPerVertex are used.
+			 * Only the position and normal of each destination vertex are written; source and destination may be the same stream.
+			 */
+			static void Skin(const Matrix bones[], const int boneCount, const int weightsPerVertex,
+				void const * const source, void * const destination, const int vertexCount, const int vertexStride,
+				const int positionOffset, const int normalOffset, const int indicesOffset, const int weightsOffset);
+		};
+	}
+}
+
+#endif //_XFX_GRAPHICS_VERTEXSKINNING_
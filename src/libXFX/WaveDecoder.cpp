@@ -0,0 +1,562 @@
+// Copyright (C) XFX Team
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without 
+// modification, are permitted provided that the following conditions are met:
+// 
+//* Redistributions of source code must retain the above copyright 
+//notice, this list of conditions and the following disclaimer.
+//* Redistributions in binary form must reproduce the above copyright 
+//notice, this list of conditions and the following disclaimer in the 
+//documentation and/or other materials provided with the distribution.
+//* Neither the name of the copyright holder nor the names of any 
+//contributors may be used to endorse or promote products derived from 
+//this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE 
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF 
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS 
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE 
+// POSSIBILITY OF SUCH DAMAGE.
+
+
+#include "WaveDecoder.h"
+#include <System/FrameworkResources.h>
+#include <System/IO/Stream.h>
+#include <System/String.h>
+
+#include <sassert.h>
+#include <string.h>
+
+using namespace System::IO;
+
+namespace XFX
+{
+	namespace Audio
+	{
+		struct WaveFormatTag
+		{
+			enum type
+			{
+				Pcm = 0x0001,
+				ImaAdpcm = 0x0011,
+				XboxAdpcm = 0x0069,
+				Extensible = 0xFFFE
+			};
+		};
+
+		// IMA ADPCM step sizes, indexed by the step index of each channel.
+		static const short StepTable[89] =
+		{
+			7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45,
+			50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130, 143, 157, 173, 190, 209, 230, 253, 279, 307,
+			337, 371, 408, 449, 494, 544, 598, 658, 724, 796, 876, 963, 1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066,
+			2272, 2499, 2749, 3024, 3327, 3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487, 12635, 13899,
+			15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767
+		};
+
+		// How each IMA ADPCM code moves the step index.
+		static const int IndexTable[16] =
+		{
+			-1, -1, -1, -1, 2, 4, 6, 8,
+			-1, -1, -1, -1, 2, 4, 6, 8
+		};
+
+		static inline int ReadUInt16(byte const * const data)
+		{
+			return data[0] | (data[1] << 8);
+		}
+
+		static inline uint ReadUInt32(byte const * const data)
+		{
+			return data[0] | (data[1] << 8) | (data[2] << 16) | ((uint)data[3] << 24);
+		}
+
+		static inline short DecodeNibble(const int nibble, int& predictor, int& index)
+		{
+			const int step = StepTable[index];
+			int difference = step >> 3;
+
+			if (nibble & 4)
+			{
+				difference += step;
+			}
+
+			if (nibble & 2)
+			{
+				difference += step >> 1;
+			}
+
+			if (nibble & 1)
+			{
+				difference += step >> 2;
+			}
+
+			predictor += (nibble & 8) ? -difference : difference;
+			predictor = (predictor < -32768) ? -32768 : ((predictor > 32767) ? 32767 : predictor);
+
+			index += IndexTable[nibble];
+			index = (index < 0) ? 0 : ((index > 88) ? 88 : index);
+
+			return (short)predictor;
+		}
+
+		AudioChannels_t WaveDecoder::getChannels() const
+		{
+			return channels;
+		}
+
+		int WaveDecoder::getFrameCount() const
+		{
+			return frameCount;
+		}
+
+		int WaveDecoder::getLoopLength() const
+		{
+			return loopLength;
+		}
+
+		int WaveDecoder::getLoopStart() const
+		{
+			return loopStart;
+		}
+
+		int WaveDecoder::getSampleRate() const
+		{
+			return sampleRate;
+		}
+
+		WaveDecoder::WaveDecoder()
+			: bitsPerSample(0), blockSize(0), canSeek(false), channels(AudioChannels::Mono), dataOffset(0), dataSize(0), decoded(null), decodedCount(0), decodedPosition(0),
+			encoded(null), encodedCount(0), encodedPosition(0), encodedSize(0), formatTag(0), frameCount(0), framePosition(0), framesPerBlock(0), loopLength(0), loopStart(0),
+			readPosition(0), sampleRate(0), skipFrames(0), stream(null)
+		{
+		}
+
+		WaveDecoder::WaveDecoder(const WaveDecoder &obj)
+			: bitsPerSample(obj.bitsPerSample), blockSize(obj.blockSize), canSeek(obj.canSeek), channels(obj.channels), dataOffset(obj.dataOffset), dataSize(obj.dataSize),
+			decoded(null), decodedCount(0), decodedPosition(0), encoded(null), encodedCount(0), encodedPosition(0), encodedSize(0), formatTag(obj.formatTag),
+			frameCount(obj.frameCount), framePosition(0), framesPerBlock(obj.framesPerBlock), loopLength(obj.loopLength), loopStart(obj.loopStart),
+			readPosition(0), sampleRate(obj.sampleRate), skipFrames(0), stream(obj.stream)
+		{
+			if (obj.encoded != null)
+			{
+				Allocate();
+			}
+		}
+
+		WaveDecoder::~WaveDecoder()
+		{
+			delete[] decoded;
+			delete[] encoded;
+		}
+
+		void WaveDecoder::Allocate()
+		{
+			const int blocks = EncodedBufferSize / blockSize;
+
+			encodedSize = ((blocks > 0) ? blocks : 1) * blockSize;
+			encoded = new byte[encodedSize];
+			decoded = new short[framesPerBlock * channels];
+		}
+
+		bool WaveDecoder::DecodeBlock()
+		{
+			int remaining = encodedCount - encodedPosition;
+
+			// Refill the buffer once it no longer holds a whole block, keeping the partial block at its front.
+			if (remaining < blockSize && readPosition < dataSize)
+			{
+				memmove(encoded, encoded + encodedPosition, remaining);
+				encodedCount = remaining;
+				encodedPosition = 0;
+
+				int count = encodedSize - remaining;
+
+				if (count > dataSize - readPosition)
+				{
+					count = dataSize - readPosition;
+				}
+
+				if (canSeek)
+				{
+					stream->Seek(dataOffset + readPosition, SeekOrigin::Begin);
+				}
+
+				const int read = ReadStream(encoded + remaining, count);
+
+				encodedCount += read;
+				readPosition = (read == count) ? readPosition + read : dataSize;
+				remaining = encodedCount;
+			}
+
+			const int count = (remaining < blockSize) ? remaining : blockSize;
+
+			if (count <= 0)
+			{
+				return false;
+			}
+
+			decodedCount = (formatTag == WaveFormatTag::Pcm) ? DecodePcm(encoded + encodedPosition, count) : DecodeImaAdpcm(encoded + encodedPosition, count);
+			decodedPosition = 0;
+			encodedPosition += count;
+
+			return (decodedCount > 0);
+		}
+
+		int WaveDecoder::DecodeImaAdpcm(byte const * source, const int count)
+		{
+			const int channelCount = channels;
+			const int headerSize = 4 * channelCount;
+
+			if (count < headerSize)
+			{
+				return 0;
+			}
+
+			int predictor[2];
+			int index[2];
+
+			// Each channel's header holds its first sample and step index.
+			for (int c = 0; c < channelCount; c++, source += 4)
+			{
+				predictor[c] = (short)ReadUInt16(source);
+				index[c] = (source[2] > 88) ? 88 : source[2];
+				decoded[c] = (short)predictor[c];
+			}
+
+			// The rest of the block interleaves 4 bytes, or 8 samples, of each channel in turn, low nibble first.
+			const int groups = (count - headerSize) / headerSize;
+
+			for (int g = 0; g < groups; g++)
+			{
+				for (int c = 0; c < channelCount; c++)
+				{
+					short* sample = decoded + ((1 + (g * 8)) * channelCount) + c;
+
+					for (int i = 0; i < 4; i++, source++)
+					{
+						*sample = DecodeNibble(*source & 0x0F, predictor[c], index[c]);
+						sample += channelCount;
+						*sample = DecodeNibble(*source >> 4, predictor[c], index[c]);
+						sample += channelCount;
+					}
+				}
+			}
+
+			return 1 + (groups * 8);
+		}
+
+		int WaveDecoder::DecodePcm(byte const * source, const int count)
+		{
+			const int samples = (count / ((bitsPerSample / 8) * channels)) * channels;
+
+			if (bitsPerSample == 16)
+			{
+				memcpy(decoded, source, samples * sizeof(short));
+			}
+			else
+			{
+				for (int i = 0; i < samples; i++)
+				{
+					decoded[i] = (short)((source[i] - 128) * 256);
+				}
+			}
+
+			return samples / channels;
+		}
+
+		bool WaveDecoder::Open(Stream * const stream)
+		{
+			sassert(stream != null, String::Format("stream; %s", FrameworkResources::ArgumentNull_Generic));
+
+			sassert(stream == null || stream->CanRead(), FrameworkResources::NotSupported_UnreadableStream);
+
+			if (stream == null || encoded != null)
+			{
+				return false;
+			}
+
+			this->stream = stream;
+			canSeek = stream->CanSeek();
+
+			byte header[12];
+			long long position = canSeek ? stream->Seek(0, SeekOrigin::Current) : 0;
+			bool hasData = false;
+			bool hasFormat = false;
+			int factFrames = -1;
+
+			if (ReadStream(header, 12) != 12 || memcmp(header, "RIFF", 4) != 0 || memcmp(header + 8, "WAVE", 4) != 0)
+			{
+				return false;
+			}
+
+			position += 12;
+
+			// Walk the chunks; each is padded to an even size.
+			while (ReadStream(header, 8) == 8)
+			{
+				const uint size = ReadUInt32(header + 4);
+				const uint padded = size + (size & 1);
+				byte chunk[64];
+				int read = 0;
+
+				position += 8;
+
+				if (memcmp(header, "data", 4) == 0)
+				{
+					dataOffset = position;
+					dataSize = (size > 0x7FFFFFFF) ? 0x7FFFFFFF : (int)size;
+					hasData = true;
+
+					// An unseekable stream has to be decoded from here on.
+					if (!canSeek)
+					{
+						break;
+					}
+				}
+				else if (memcmp(header, "fmt ", 4) == 0 || memcmp(header, "fact", 4) == 0 || memcmp(header, "smpl", 4) == 0)
+				{
+					read = ReadStream(chunk, (size < sizeof(chunk)) ? size : sizeof(chunk));
+
+					if (memcmp(header, "fmt ", 4) == 0)
+					{
+						if (!ReadFormat(chunk, read))
+						{
+							return false;
+						}
+
+						hasFormat = true;
+					}
+					else if (memcmp(header, "fact", 4) == 0 && read >= 4)
+					{
+						factFrames = (int)(ReadUInt32(chunk) & 0x7FFFFFFF);
+					}
+					// The first sample loop, whose end frame is inclusive.
+					else if (memcmp(header, "smpl", 4) == 0 && read >= 60 && ReadUInt32(chunk + 28) > 0)
+					{
+						loopStart = (int)(ReadUInt32(chunk + 44) & 0x7FFFFFFF);
+						loopLength = (int)(ReadUInt32(chunk + 48) & 0x7FFFFFFF) - loopStart + 1;
+					}
+				}
+
+				if (!SkipStream((long long)padded - read))
+				{
+					break;
+				}
+
+				position += padded;
+			}
+
+			if (!hasFormat || !hasData)
+			{
+				return false;
+			}
+
+			// Files that were still being written when they were closed claim more data than they hold.
+			if (canSeek && dataOffset + dataSize > stream->Length())
+			{
+				dataSize = (stream->Length() > dataOffset) ? (int)(stream->Length() - dataOffset) : 0;
+			}
+
+			if (formatTag == WaveFormatTag::Pcm)
+			{
+				frameCount = dataSize / ((bitsPerSample / 8) * channels);
+			}
+			else
+			{
+				const int headerSize = 4 * channels;
+				const int rest = dataSize % blockSize;
+
+				frameCount = ((dataSize / blockSize) * framesPerBlock) + ((rest >= headerSize) ? 1 + (((rest - headerSize) / headerSize) * 8) : 0);
+
+				if (factFrames >= 0 && factFrames < frameCount)
+				{
+					frameCount = factFrames;
+				}
+			}
+
+			if (loopStart < 0 || loopLength <= 0 || loopStart + loopLength > frameCount)
+			{
+				loopStart = 0;
+				loopLength = 0;
+			}
+
+			Allocate();
+
+			return true;
+		}
+
+		int WaveDecoder::Read(short destination[], const int count)
+		{
+			const int channelCount = channels;
+			const int total = (count < frameCount - framePosition) ? count : frameCount - framePosition;
+			int read = 0;
+
+			while (read < total)
+			{
+				if (decodedPosition >= decodedCount)
+				{
+					if (!DecodeBlock())
+					{
+						break;
+					}
+
+					// Seek lands on the block holding its frame, and skips to the frame once the block is decoded.
+					decodedPosition = (skipFrames < decodedCount) ? skipFrames : decodedCount;
+					skipFrames = 0;
+					continue;
+				}
+
+				int frames = decodedCount - decodedPosition;
+
+				if (frames > total - read)
+				{
+					frames = total - read;
+				}
+
+				memcpy(destination + (read * channelCount), decoded + (decodedPosition * channelCount), frames * channelCount * sizeof(short));
+				decodedPosition += frames;
+				read += frames;
+			}
+
+			framePosition += read;
+
+			return read;
+		}
+
+		bool WaveDecoder::ReadFormat(byte const * const chunk, const int size)
+		{
+			if (size < 16)
+			{
+				return false;
+			}
+
+			const int blockAlign = ReadUInt16(chunk + 12);
+
+			formatTag = ReadUInt16(chunk);
+			channels = (AudioChannels_t)ReadUInt16(chunk + 2);
+			sampleRate = (int)ReadUInt32(chunk + 4);
+			bitsPerSample = ReadUInt16(chunk + 14);
+
+			// The format of an extensible file is the first two bytes of its sub-format GUID.
+			if (formatTag == WaveFormatTag::Extensible && size >= 26)
+			{
+				formatTag = ReadUInt16(chunk + 24);
+			}
+
+			sassert(channels == AudioChannels::Mono || channels == AudioChannels::Stereo, "Only mono and stereo sounds are supported.");
+
+			sassert(sampleRate >= 8000 && sampleRate <= 48000, "The sample rate must be between 8000 and 48000 Hz.");
+
+			if ((channels != AudioChannels::Mono && channels != AudioChannels::Stereo) || sampleRate < 8000 || sampleRate > 48000)
+			{
+				return false;
+			}
+
+			switch (formatTag)
+			{
+			case WaveFormatTag::Pcm:
+				if ((bitsPerSample != 8 && bitsPerSample != 16) || blockAlign != (bitsPerSample / 8) * channels)
+				{
+					break;
+				}
+
+				framesPerBlock = PcmBlockFrames;
+				blockSize = PcmBlockFrames * blockAlign;
+				return true;
+			case WaveFormatTag::ImaAdpcm:
+			case WaveFormatTag::XboxAdpcm:
+				if (bitsPerSample != 4 || blockAlign <= 4 * channels || (blockAlign % (4 * channels)) != 0)
+				{
+					break;
+				}
+
+				// The first sample of each channel is stored whole in its header.
+				framesPerBlock = 1 + (((blockAlign - (4 * channels)) / (4 * channels)) * 8);
+				blockSize = blockAlign;
+				return true;
+			}
+
+			sassert(false, "Only 8 and 16-bit PCM, IMA ADPCM and Xbox ADPCM sounds are supported.");
+
+			return false;
+		}
+
+		int WaveDecoder::ReadStream(byte destination[], const int count)
+		{
+			int total = 0;
+
+			while (total < count)
+			{
+				const int read = stream->Read(destination, total, count - total);
+
+				if (read <= 0)
+				{
+					break;
+				}
+
+				total += read;
+			}
+
+			return total;
+		}
+
+		void WaveDecoder::Seek(const int frame)
+		{
+			sassert(canSeek, FrameworkResources::NotSupported_UnseekableStream);
+
+			if (blockSize <= 0)
+			{
+				return;
+			}
+
+			const int target = (frame < 0) ? 0 : ((frame > frameCount) ? frameCount : frame);
+			const int block = target / framesPerBlock;
+
+			decodedCount = 0;
+			decodedPosition = 0;
+			encodedCount = 0;
+			encodedPosition = 0;
+			framePosition = target;
+			readPosition = block * blockSize;
+			skipFrames = target - (block * framesPerBlock);
+		}
+
+		bool WaveDecoder::SkipStream(const long long count)
+		{
+			if (count <= 0)
+			{
+				return true;
+			}
+
+			if (canSeek)
+			{
+				stream->Seek(count, SeekOrigin::Current);
+				return true;
+			}
+
+			byte discard[64];
+
+			for (long long skipped = 0; skipped < count; )
+			{
+				const int chunk = (count - skipped < (long long)sizeof(discard)) ? (int)(count - skipped) : (int)sizeof(discard);
+
+				if (ReadStream(discard, chunk) != chunk)
+				{
+					return false;
+				}
+
+				skipped += chunk;
+			}
+
+			return true;
+		}
+	}
+}
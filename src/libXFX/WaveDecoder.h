@@ -0,0 +1,120 @@
+/*****************************************************************************
+ *	WaveDecoder.h															 *
+ *																			 *
+ *	XFX::Audio::WaveDecoder class definition file							 *
+ *	Copyright (c) XFX Team. All Rights Reserved 							 *
+ *****************************************************************************/
+#ifndef _XFX_AUDIO_WAVEDECODER_
+#define _XFX_AUDIO_WAVEDECODER_
+
+#include <Audio/Enums.h>
+#include <System/Types.h>
+
+using namespace System;
+
+namespace System
+{
+	namespace IO
+	{
+		class Stream;
+	}
+}
+
+namespace XFX
+{
+	namespace Audio
+	{
+		/**
+		 * Reads 16-bit PCM frames from the data chunk of a RIFF WAVE file, one fixed size block at a time.
+		 *
+		 * 8 and 16-bit PCM, IMA ADPCM and Xbox ADPCM (IMA ADPCM in 36-byte blocks per channel) are supported.
+		 * At most EncodedBufferSize bytes of the file, and one block of decoded frames, are held in memory at once.
+		 *
+		 * A copy reads the same stream from its own position, seeking before each read, so any number of them can play one file.
+		 * All copies must read on the same thread.
+		 */
+		// This class is not meant to be used by the end user.
+		// Only XFX source files should reference this class.
+		class WaveDecoder
+		{
+		public:
+			/**
+			 * The number of bytes read from the stream at a time, rounded down to whole blocks.
+			 */
+			static const int EncodedBufferSize = 4096;
+
+		private:
+			// The number of frames of PCM data decoded at a time.
+			static const int PcmBlockFrames = 512;
+
+			int bitsPerSample;
+			// Bytes decoded at a time: one ADPCM block, or PcmBlockFrames frames of PCM.
+			int blockSize;
+			bool canSeek;
+			AudioChannels_t channels;
+			long long dataOffset;
+			int dataSize;
+			short* decoded;
+			int decodedCount;
+			int decodedPosition;
+			byte* encoded;
+			int encodedCount;
+			int encodedPosition;
+			int encodedSize;
+			int formatTag;
+			int frameCount;
+			int framePosition;
+			int framesPerBlock;
+			int loopLength;
+			int loopStart;
+			int readPosition;
+			int sampleRate;
+			int skipFrames;
+			System::IO::Stream* stream;
+
+			void Allocate();
+			bool DecodeBlock();
+			int DecodeImaAdpcm(byte const * source, const int count);
+			int DecodePcm(byte const * source, const int count);
+			bool ReadFormat(byte const * const chunk, const int size);
+			int ReadStream(byte destination[], const int count);
+			bool SkipStream(const long long count);
+
+		public:
+			AudioChannels_t getChannels() const;
+			int getFrameCount() const;
+			int getLoopLength() const;
+			int getLoopStart() const;
+			int getSampleRate() const;
+
+			WaveDecoder();
+			/**
+			 * Creates a decoder for the same file as obj, positioned at its first frame.
+			 */
+			WaveDecoder(const WaveDecoder &obj);
+			~WaveDecoder();
+
+			/**
+			 * Reads the chunks of a RIFF WAVE file up to its data, starting at the current position of stream.
+			 * A seekable stream is read to the end of the file, for loop points stored after the data.
+			 *
+			 * @return
+			 * false if the stream does not hold a WAVE file in a supported format.
+			 */
+			bool Open(System::IO::Stream * const stream);
+			/**
+			 * Decodes up to count frames into destination, reading from the stream as needed.
+			 *
+			 * @return
+			 * The number of frames decoded, which is less than count at the end of the data.
+			 */
+			int Read(short destination[], const int count);
+			/**
+			 * Moves to a frame. The stream is not touched until the next Read, so a decoder that isn't being read may be moved from any thread.
+			 */
+			void Seek(const int frame);
+		};
+	}
+}
+
+#endif //_XFX_AUDIO_WAVEDECODER_
@@ -1195,6 +1195,7 @@ NV20_TCL_PRIMITIVE_3D      [0x1d78/4] = 0x00000001 | UNKNOWN = 00000001
 #define NV20_TCL_PRIMITIVE_3D_TX_UNK07_UNIT(n)				(0x00001A1C + (n * 32))
 
 #define NV20_TCL_PRIMITIVE_3D_INDEX_DATA				0x00001800
+#define NV20_TCL_PRIMITIVE_3D_INDEX_DATA32				0x00001808
 #define NV20_TCL_PRIMITIVE_3D_VB_VERTEX_BATCH				0x00001810
 #define NV20_TCL_PRIMITIVE_3D_VERTEX_DATA				0x00001818
 //									0x00001c18
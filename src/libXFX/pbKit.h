@@ -4,7 +4,12 @@
 #ifndef _PBKIT_H_
 #define _PBKIT_H_
 
+#ifdef PBKIT_RECORDER
+#include <stdint.h>
+typedef uint32_t DWORD;
+#else
 #include <xboxkrnl/types.h>
+#endif
 #include "nv_objects.h"
 
 //4x4 matrices indexes
@@ -96,4 +101,20 @@ void	pb_set_viewport(int dwx,int dwy,int width,int height,float zmin,float zmax)
 
 int	pb_busy(void);
 
+#ifdef PBKIT_RECORDER
+//host-side recording backend (pbKitRecorder.c replaces pbKit.c)
+struct s_PbStats
+{
+	DWORD	Methods;	//method headers sent
+	DWORD	Dwords;		//headers and parameters sent
+	DWORD	DrawCalls;	//BEGIN_END blocks opened with a primitive, and clears
+	DWORD	StateChanges;	//methods that are neither vertex data, draw nor synchronization commands
+};
+
+void	pb_get_stats(struct s_PbStats *stats);	//counters accumulated since last pb_finished
+void	pb_get_frame_stats(struct s_PbStats *stats);	//counters of the frame ended by last pb_finished
+void	pb_reset_stats(void);
+DWORD	*pb_recorded_stream(DWORD *count);	//commands recorded since last pb_reset (count in dwords)
+#endif
+
 #endif
@@ -0,0 +1,489 @@
+//pbKit recording backend
+//see AFL license
+
+//Host-side replacement for pbKit.c, selected at compile time (PBKIT_RECORDER).
+//It implements the pbKit.h API without touching any hardware: every block sent
+//with pb_end is kept in an in-memory push buffer and parsed into per frame
+//counters (methods, dwords, draw calls and state changes), so that rendering
+//code can be benchmarked and regression-tested headlessly.
+//The recorded stream runs from the last pb_reset (frame start) to the current
+//put pointer; counters are latched by pb_finished (frame end).
+//The shader compiler (pb_pcode2mcode and pb_push_mcode) is in pbKitShader.c,
+//which is linked with either backend.
+
+#ifdef PBKIT_RECORDER
+
+#include "pbKit.h"
+#include "nv_objects.h"
+
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+
+
+
+#define DEFAULT_SIZE					(512*1024)	//same default as pbKit.c
+
+#define MAX_EXTRA_BUFFERS				8
+
+#define FRAMEBUFFER_WIDTH				640
+#define FRAMEBUFFER_HEIGHT				480
+
+#define GUARD_DWORDS					2048	//room always left for one more block
+
+#define PB_FINISHED					0xFAB
+
+static	int			pb_running=0;
+
+static	DWORD			pb_Size=DEFAULT_SIZE;
+static	DWORD			*pb_Head=NULL;	//recorded stream starts here
+static	DWORD			*pb_Tail;	//pb_begin wraps to head past this point
+static	DWORD			*pb_Put;	//next block starts here
+static	DWORD			*pb_PushStart;	//start of current begin-end block
+
+static	int			pb_BeginEndPair=0;
+
+static	int			pb_ExtraBuffersCount=0;
+static	DWORD			*pb_FrameBuffer;
+static	DWORD			*pb_ExtraBuffer[MAX_EXTRA_BUFFERS];
+
+static	DWORD			pb_vbl_counter=0;
+
+static	struct s_PbStats	pb_Stats;	//accumulated since last pb_finished
+static	struct s_PbStats	pb_FrameStats;	//latched by pb_finished
+
+
+
+//vertex data and draw commands (as opposed to render state)
+static int pb_is_vertex_method(DWORD method)
+{
+	if ((method>=NV20_TCL_PRIMITIVE_3D_VERTEX_POS_3F_X)&&(method<NV20_TCL_PRIMITIVE_3D_VB_POINTER_ATTR0_POS)) return 1; //immediate vertex attributes
+	if ((method>=0x00001800)&&(method<=NV20_TCL_PRIMITIVE_3D_VERTEX_DATA)) return 1; //array elements, vertex batches and inline arrays
+	if ((method>=0x00001880)&&(method<0x00001a00)) return 1; //immediate generic vertex attributes
+	return 0;
+}
+
+//synchronization and interrupt commands (as opposed to render state)
+static int pb_is_sync_method(DWORD method)
+{
+	if ((method>=NV20_TCL_PRIMITIVE_3D_NOP)&&(method<=NV20_TCL_PRIMITIVE_3D_STALL_PIPELINE)) return 1;
+	if (method==NV20_TCL_PRIMITIVE_3D_PARAMETER_A) return 1;
+	return 0;
+}
+
+//parses a begin-end block and updates counters
+static void pb_record(DWORD *p, DWORD *pEnd)
+{
+	DWORD			header;
+	DWORD			method;
+	DWORD			subchannel;
+	DWORD			n;
+
+	while (p<pEnd)
+	{
+		header=*(p++);
+		n=(header>>18)&0x7FF;
+		method=header&0x1FFC;
+		subchannel=(header>>13)&7;
+
+		pb_Stats.Methods++;
+		pb_Stats.Dwords+=1+n;
+
+		if (subchannel==SUBCH_3D)
+		{
+			if (method==NV20_TCL_PRIMITIVE_3D_BEGIN_END)
+			{
+				if ((n>0)&&(*p!=STOP)) pb_Stats.DrawCalls++;
+			}
+			else
+			if ((method<=NV20_TCL_PRIMITIVE_3D_CLEAR_WHICH_BUFFERS)&&(method+n*4>NV20_TCL_PRIMITIVE_3D_CLEAR_WHICH_BUFFERS))
+			{
+				pb_Stats.DrawCalls++;	//clear trigger, usually sent along with the clear values
+			}
+			else
+			if ((!pb_is_vertex_method(method))&&(!pb_is_sync_method(method)))
+			{
+				pb_Stats.StateChanges++;
+			}
+		}
+		else
+			pb_Stats.StateChanges++;
+
+		p+=n;
+	}
+}
+
+
+
+void pb_get_stats(struct s_PbStats *stats)
+{
+	*stats=pb_Stats;
+}
+
+void pb_get_frame_stats(struct s_PbStats *stats)
+{
+	*stats=pb_FrameStats;
+}
+
+void pb_reset_stats(void)
+{
+	memset(&pb_Stats,0,sizeof(pb_Stats));
+	memset(&pb_FrameStats,0,sizeof(pb_FrameStats));
+}
+
+DWORD *pb_recorded_stream(DWORD *count)
+{
+	if (count) *count=(DWORD)(pb_Put-pb_Head);
+	return pb_Head;
+}
+
+
+
+void pb_show_front_screen(void)
+{
+}
+
+void pb_show_debug_screen(void)
+{
+}
+
+void pb_show_depth_screen(void)
+{
+}
+
+DWORD pb_get_vbl_counter(void)
+{
+	return pb_vbl_counter;
+}
+
+DWORD pb_wait_for_vbl(void)
+{
+	return ++pb_vbl_counter; //no display: every wait is a new VBlank
+}
+
+void pb_erase_depth_stencil_buffer(int x, int y, int w, int h)
+{
+	DWORD		*p;
+
+	int		x1,y1,x2,y2;
+
+	x1=x;
+	y1=y;
+	x2=x+w;
+	y2=y+h;
+
+	p=pb_begin();
+	pb_push(p++,NV20_TCL_PRIMITIVE_3D_CLEAR_VALUE_HORIZ,2);		//sets rectangle coordinates
+	*(p++)=((x2-1)<<16)|x1;
+	*(p++)=((y2-1)<<16)|y1;
+	pb_push(p++,NV20_TCL_PRIMITIVE_3D_CLEAR_VALUE_DEPTH,3);		//sets data used to fill in rectangle
+	*(p++)=0xffffff00;		//(depth<<8)|stencil
+	*(p++)=0;			//color
+	*(p++)=0x03; 			//triggers the HW rectangle fill (only on D&S)
+	pb_end(p);
+}
+
+void pb_reset(void)
+{
+	pb_Put=pb_Head;
+}
+
+int pb_finished(void)
+{
+	DWORD			*p;
+
+	//same swap sequence as pbKit.c, so that frame sizes match the hardware backend
+	p=pb_begin();
+	pb_push1(p,NV20_TCL_PRIMITIVE_3D_ASK_FOR_IDLE,0); p+=2;
+	pb_push1(p,NV20_TCL_PRIMITIVE_3D_NOP,0); p+=2;
+	pb_push1(p,NV20_TCL_PRIMITIVE_3D_WAIT_MAKESPACE,0); p+=2;
+	pb_push1(p,NV20_TCL_PRIMITIVE_3D_PARAMETER_A,0); p+=2;
+	pb_push1(p,NV20_TCL_PRIMITIVE_3D_FIRE_INTERRUPT,PB_FINISHED); p+=2;
+	pb_end(p);
+
+	pb_FrameStats=pb_Stats;
+	memset(&pb_Stats,0,sizeof(pb_Stats));
+	pb_vbl_counter++;
+
+	return 0;
+}
+
+DWORD *pb_begin(void)
+{
+	if (pb_BeginEndPair==1) fprintf(stderr,"pb_begin: pb_begin without a pb_end earlier\n");
+	pb_BeginEndPair=1;
+
+	//keep recording instead of overflowing when pb_reset isn't called often enough
+	if (pb_Put>=pb_Tail) pb_Put=pb_Head;
+
+	pb_PushStart=pb_Put;
+	return pb_Put;
+}
+
+void pb_push1to(DWORD subchannel, DWORD *p, DWORD command, DWORD param1)
+{
+	*(p+0)=EncodeMethod(subchannel,command,1);
+	*(p+1)=param1;
+}
+
+void pb_push2to(DWORD subchannel, DWORD *p, DWORD command, DWORD param1, DWORD param2)
+{
+	*(p+0)=EncodeMethod(subchannel,command,2);
+	*(p+1)=param1;
+	*(p+2)=param2;
+}
+
+void pb_push3to(DWORD subchannel, DWORD *p, DWORD command, DWORD param1, DWORD param2, DWORD param3)
+{
+	*(p+0)=EncodeMethod(subchannel,command,3);
+	*(p+1)=param1;
+	*(p+2)=param2;
+	*(p+3)=param3;
+}
+
+void pb_push4to(DWORD subchannel, DWORD *p, DWORD command, DWORD param1, DWORD param2, DWORD param3, DWORD param4)
+{
+	*(p+0)=EncodeMethod(subchannel,command,4);
+	*(p+1)=param1;
+	*(p+2)=param2;
+	*(p+3)=param3;
+	*(p+4)=param4;
+}
+
+void pb_push1(DWORD *p, DWORD command, DWORD param1)
+{
+	pb_push1to(SUBCH_3D,p,command,param1);
+}
+
+void pb_push2(DWORD *p, DWORD command, DWORD param1, DWORD param2)
+{
+	pb_push2to(SUBCH_3D,p,command,param1,param2);
+}
+
+void pb_push3(DWORD *p, DWORD command, DWORD param1, DWORD param2, DWORD param3)
+{
+	pb_push3to(SUBCH_3D,p,command,param1,param2,param3);
+}
+
+void pb_push4(DWORD *p, DWORD command, DWORD param1, DWORD param2, DWORD param3, DWORD param4)
+{
+	pb_push4to(SUBCH_3D,p,command,param1,param2,param3,param4);
+}
+
+void pb_push4f(DWORD *p, DWORD command, float param1, float param2, float param3, float param4)
+{
+	*(p+0)=EncodeMethod(SUBCH_3D,command,4);
+	memcpy(p+1,&param1,4);
+	memcpy(p+2,&param2,4);
+	memcpy(p+3,&param3,4);
+	memcpy(p+4,&param4,4);
+}
+
+void pb_push_transposed_matrix(DWORD *p, DWORD command, float *m)
+{
+	int			i,j;
+
+	*(p++)=EncodeMethod(SUBCH_3D,command,16);
+
+	for(i=0;i<4;i++)
+	for(j=0;j<4;j++)
+		memcpy(p++,&m[j*4+i],4);
+}
+
+void pb_end(DWORD *pEnd)
+{
+	if (pb_BeginEndPair==0) fprintf(stderr,"pb_end: pb_end without a pb_begin\n");
+	pb_BeginEndPair=0;
+
+	if (pEnd-pb_PushStart>GUARD_DWORDS) fprintf(stderr,"pb_end: block of %d dwords overflowed the recorder guard area\n",(int)(pEnd-pb_PushStart));
+
+	pb_record(pb_PushStart,pEnd);
+
+	pb_Put=pEnd;
+}
+
+void pb_extra_buffers(int n)
+{
+	if (n>MAX_EXTRA_BUFFERS)
+		fprintf(stderr,"Too many extra buffers\n");
+	else
+		pb_ExtraBuffersCount=n;
+}
+
+void pb_size(DWORD size)
+{
+	if (pb_running)
+		fprintf(stderr,"Can't set size while push buffer recorder is running.\n");
+	else
+	{
+		if (size<64*1024)
+			fprintf(stderr,"Push buffer size must be equal or larger than 64Kb.\n");
+		else
+		if ((size-1)&size)
+			fprintf(stderr,"Push buffer size must be a power of 2.\n");
+		else
+		pb_Size=size;
+	}
+}
+
+int pb_init(void)
+{
+	int			i;
+
+	if (pb_running) return 0;
+
+	//the guard area lets a block started just before pb_Tail complete without overflowing
+	pb_Head=(DWORD *)malloc(pb_Size+GUARD_DWORDS*4);
+	pb_FrameBuffer=(DWORD *)calloc(FRAMEBUFFER_WIDTH*FRAMEBUFFER_HEIGHT,4);
+	if ((pb_Head==NULL)||(pb_FrameBuffer==NULL))
+	{
+		free(pb_Head);
+		free(pb_FrameBuffer);
+		pb_Head=NULL;
+		return -1;
+	}
+
+	for(i=0;i<pb_ExtraBuffersCount;i++)
+		pb_ExtraBuffer[i]=(DWORD *)calloc(FRAMEBUFFER_WIDTH*FRAMEBUFFER_HEIGHT,4);
+
+	pb_Tail=pb_Head+pb_Size/4;
+	pb_Put=pb_Head;
+	pb_BeginEndPair=0;
+	pb_vbl_counter=0;
+	pb_reset_stats();
+
+	pb_running=1;
+
+	return 0;
+}
+
+void pb_kill(void)
+{
+	int			i;
+
+	if (!pb_running) return;
+
+	for(i=0;i<pb_ExtraBuffersCount;i++)
+		free(pb_ExtraBuffer[i]);
+
+	free(pb_FrameBuffer);
+	free(pb_Head);
+	pb_Head=NULL;
+
+	pb_running=0;
+}
+
+void pb_print(char *format, ...)
+{
+}
+
+void pb_printat(int row, int col, char *format, ...)
+{
+}
+
+void pb_erase_text_screen(void)
+{
+}
+
+void pb_draw_text_screen(void)
+{
+}
+
+void pb_target_extra_buffer(int n)
+{
+}
+
+void pb_target_back_buffer(void)
+{
+}
+
+DWORD *pb_extra_buffer(int n)
+{
+	if ((n<0)||(n>=pb_ExtraBuffersCount))
+	{
+		fprintf(stderr,"pb_extra_buffer: buffer index out of range\n");
+		return pb_back_buffer();
+	}
+
+	return pb_ExtraBuffer[n];
+}
+
+DWORD *pb_back_buffer(void)
+{
+	return pb_FrameBuffer;
+}
+
+DWORD pb_back_buffer_width(void)
+{
+	return FRAMEBUFFER_WIDTH;
+}
+
+DWORD pb_back_buffer_height(void)
+{
+	return FRAMEBUFFER_HEIGHT;
+}
+
+DWORD pb_back_buffer_pitch(void)
+{
+	return FRAMEBUFFER_WIDTH*4;
+}
+
+void pb_fill(int x, int y, int w, int h, DWORD color)
+{
+	DWORD		*p;
+
+	int		x1,y1,x2,y2;
+
+	x1=x;
+	y1=y;
+	x2=x+w;
+	y2=y+h;
+
+	p=pb_begin();
+	pb_push(p++,NV20_TCL_PRIMITIVE_3D_CLEAR_VALUE_HORIZ,2);		//sets rectangle coordinates
+	*(p++)=((x2-1)<<16)|x1;
+	*(p++)=((y2-1)<<16)|y1;
+	pb_push(p++,NV20_TCL_PRIMITIVE_3D_CLEAR_VALUE_DEPTH,3);		//sets data used to fill in rectangle
+	*(p++)=0;			//(depth<<8)|stencil
+	*(p++)=color;			//color
+	*(p++)=0xF0; 			//triggers the HW rectangle fill (0x03 for D&S)
+	pb_end(p);
+}
+
+void pb_set_viewport(int dwx,int dwy,int width,int height,float zmin,float zmax)
+{
+	DWORD			*p;
+	DWORD			dwzminscaled;
+	DWORD			dwzmaxscaled;
+	float			x,y,w,h;
+	float			zscale=16777215.0f;	//D24S8
+	float			zminscaled,zmaxscaled;
+
+	if (dwx<0) dwx=0;
+	if (dwy<0) dwy=0;
+	if (dwx+width>FRAMEBUFFER_WIDTH) width=FRAMEBUFFER_WIDTH-dwx;
+	if (dwy+height>FRAMEBUFFER_HEIGHT) height=FRAMEBUFFER_HEIGHT-dwy;
+
+	x=0.53125f+(float)dwx;
+	y=0.53125f+(float)dwy;
+	w=0.5f*((float)width);
+	h=-0.5f*((float)height);
+	zminscaled=zmin*zscale;
+	zmaxscaled=zmax*zscale;
+	memcpy(&dwzminscaled,&zminscaled,4);
+	memcpy(&dwzmaxscaled,&zmaxscaled,4);
+
+	p=pb_begin();
+	pb_push4f(p,NV20_TCL_PRIMITIVE_3D_VIEWPORT_OX,x+w,y-h,zmin*zscale,0.0f); p+=5;
+	pb_push4f(p,NV20_TCL_PRIMITIVE_3D_VIEWPORT_PX_DIV2,w,h,(zmax-zmin)*zscale,0.0f); p+=5;
+	pb_push2(p,NV20_TCL_PRIMITIVE_3D_DEPTH_RANGE_NEAR,dwzminscaled,dwzmaxscaled); p+=3;
+	pb_end(p);
+}
+
+int pb_busy(void)
+{
+	return 0; //commands are consumed as soon as pb_end records them
+}
+
+#endif
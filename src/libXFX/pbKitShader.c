@@ -0,0 +1,1434 @@
+//pbKit vertex and pixel shader compiler, shared by pbKit.c and pbKitRecorder.c
+//see AFL license
+
+#include <openxdk/debug.h>
+
+#include "pbKit.h"
+#include "nv_objects.h"  //shared with renouveau files
+#include "nv20_shader.h" //(search "nouveau" on wiki)
+
+#include <string.h>
+
+
+
+struct s_PseudoReg
+{
+	int reg;
+	int num;
+	union {
+		int msk;
+		int swz;
+	};
+	int mod;
+	int idx;
+};
+
+struct s_PseudoRegs
+{
+	int			n;
+	struct s_PseudoReg	dest;
+	struct s_PseudoReg	src0;
+	struct s_PseudoReg	src1;
+	struct s_PseudoReg	src2;
+};
+
+				//temporary storage for pb_pcode2mcode()
+static	DWORD			pb_gpu_programnc[136*5+192*7+8];//vertex shader micro-code setup (max:136 instructions + 192 constants)
+static	DWORD			pb_gpu_registers[6*8+7];//pixel shader registers values
+static int			pb_tmp_registers[16];//some vertex shader macros need to find free temp registers
+static int			pb_exp_constflag;
+static int			pb_log_constflag;
+
+
+
+//enqueues shaders micro-code into push buffer stream
+//(not recommended for pixel shader: slow and redundant)
+DWORD *pb_push_mcode(DWORD *p,DWORD *mcode)
+{
+	DWORD		size;
+
+	if (((*mcode)&0xFFFF0000)!=0x43210000) //pixel shader registers values
+	{
+		//Pixel shader initialization (on xbox it's just registers initialization)
+		//1-8 stages where (alpha and rgb processed in parallel)
+		//2x4 inputs redirected to (a,b,c,d) can produce 2x3 outputs (a*b,c*d or a*b+c*d) 
+		//redirected to v0-v1, t0-t3, or r0-r1 (r0=final result at final stage)
+		pb_push2(p,NV20_TCL_PRIMITIVE_3D_RC_COLOR0,pb_gpu_registers[48],pb_gpu_registers[49]); p+=3; //PSFinalCombinerC0 & C1
+		pb_push1(p,NV20_TCL_PRIMITIVE_3D_TX_SHADER_CULL_MODE,pb_gpu_registers[50]); p+=2; //PSCompareMode (0 means fragment killed if r<0 or s<0 or t<0 or q<0, used in clipplane mode)
+		pb_push1(p,NV20_TCL_PRIMITIVE_3D_TX_SHADER_OP,pb_gpu_registers[51]); p+=2; //PSTextureModes=1 (1<<(stage*5) is project 2D: argb=texture(r/q,s/q) usually q=1.0f)
+		pb_push1(p,NV20_TCL_PRIMITIVE_3D_TX_SHADER_DOTMAPPING,pb_gpu_registers[52]); p+=2; //PSDotMapping (0 means [0,255]argb from texture=>[0.0,1.0](r,g,b))
+		pb_push1(p,NV20_TCL_PRIMITIVE_3D_TX_SHADER_PREVIOUS,pb_gpu_registers[53]); p+=2; //PSInputTextureSource (usual value for 4 stages: 0x00210000, what previous stage each stage uses)
+		pb_push1(p,NV20_TCL_PRIMITIVE_3D_RC_ENABLE,pb_gpu_registers[54]); p+=2; //PSCombinerCount (stages usage count=1, r0.a LSB controls mux, C0's & C1's may be different)
+		pb_push(p++,NV20_TCL_PRIMITIVE_3D_RC_IN_ALPHA(0),8); memcpy(p,&pb_gpu_registers[0],8*4); p+=8;    //8 PSAlphaInputs
+		//Inputs: 8x 0xaabbccdd 
+		//0=0 1=c0 2=c1 3=fog.rgb 4=v0 5=v1 8=t0 0xb=t3 0xc=r0 0xd=r1 0x10=x.a default=|0.rgb| 
+		//0x20=1-|x| 0x40=2*max(0,x)-1("_bx2") 0x60=1-2*max(0,x) 0x80=max(0,x)-0.5f("_bias") 0xa0=0.5f-max(0,x) 0xc0=x 0xf0=-x
+		pb_push(p++,NV20_TCL_PRIMITIVE_3D_RC_OUT_ALPHA(0),8); memcpy(p,&pb_gpu_registers[8],8*4); p+=8;  //8 PSAlphaOutputs
+		pb_push(p++,NV20_TCL_PRIMITIVE_3D_RC_IN_RGB(0),8); memcpy(p,&pb_gpu_registers[16],8*4); p+=8;  //8 PSRGBInputs
+		pb_push(p++,NV20_TCL_PRIMITIVE_3D_RC_OUT_RGB(0),8); memcpy(p,&pb_gpu_registers[24],8*4); p+=8;  //8 PSRGBOutputs
+		//Outputs: 8x 0xFlags+<> <:a*b dest >:c*d dest +:a*b+c*d dest with 0xc=r0 0=discared, i.e no destination
+		//Flags: 2(ab)/1(cd)="* is replaced with dot product", 4="+ is replaced with (r0.a LSB or MSB not set)?(a*b):(c*d)"
+		//Flags: 8=-0.5f (then) 0x10=*2.0f 0x20=*4.0f 0x40=*0.5f
+		//Flags: 0x80(ab)/0x40(cd)=result.b propagates to result.a on rgb side (case of dp3 r0,?n,?n for example)
+		pb_push(p++,NV20_TCL_PRIMITIVE_3D_RC_CONSTANT_COLOR0(0),16); memcpy(p,&pb_gpu_registers[32],16*4); p+=16; //8 C0's 8 C1's
+		return p;
+	}
+		
+	//enqueues a vertex shader setup:
+	size=(*(mcode++))&0xFFFF;
+	if (size>136*5+96*7+8)
+	{
+		debugPrint("pb_push_mcode: Wrong vertex shader size\n");
+		return NULL;
+	}
+
+	memcpy(p,mcode,size*4); p+=size;
+
+	return p;
+}
+
+//converts pseudo-code register into encoded xbox gpu pixel shader input register
+static int pb_preg2psreg(struct s_PseudoReg *pReg)
+{
+	int reg=0xc; //r0
+
+	switch(pReg->reg) 
+	{
+		case 8: reg=0xc+pReg->num; break; //r0-r1 (side effect: r2=0(0) r3=fog.rgb r4=v0 r5=v1 r6=v1r0sum(0xe) r7=EFprod(0xf))
+		case 9: reg=4+pReg->num; break; //v0-v1 (side effect: v2=v1r0sum(0xe) v3=EFprod(0xf) v4=c0 v5=c1 v6=0 v7=0)
+		case 0xa: reg=1+pReg->num; //c0-c1 (ps constants Cn are 0xaarrggbb dwords)
+		//Pseudo code created by psa.exe allows to define C0-C7 but
+		//NVidia pixel shaders only refers to C0-C1, but they may be different
+		//at each stage. So there is not only one way to map them.
+		//Since this function supports only 1 stage, we use only c0-c1 (c2-c3 for 2nd stage, later, eventually)
+		//thus, we can choose to have c4-c7 match non standard xbox gpu specific registers at any stage
+		if (pReg->num==4) reg=0; 	//c4=zero
+		if (pReg->num==5) reg=3; 	//c5=fog.rgb
+		if (pReg->num==6) reg=0xe;	//c6=v1r0sum
+		if (pReg->num==7) reg=0xf;	//c7=EFprod (see final combiner comment below)
+		break;
+		case 0xb: reg=8+pReg->num; break; //t0-t3
+	}
+	switch(pReg->mod)
+	{
+		case 0: reg|=0xc0; break; //x
+		case 1: reg|=0xe0; break; //-x
+		case 2: reg|=0x80; break; //x_bias (x-0.5f)
+		case 3: reg|=0xa0; break; //-x_bias -(x-0.5f)
+		case 4: reg|=0x40; break; //x_bx2 (|x|*2.0f-1.0f)
+		case 5: reg|=0x60; break; //-x_bx2 -(|x|*2.0f-1.0f)
+		case 6: reg|=0x20; break; //1-|x| (0x00=|x|)
+		case 7: debugPrint("pb_preg2psreg: ?n_x2 modifier is not supported\n"); break; //x_x2 (|x|*2) is not supported
+		default: debugPrint("pb_preg2psreg: Unrecognized modifier %d\n",pReg->mod); break;
+	}
+	return reg;
+}
+
+//reads data from pseudo-code stream and fills in structure
+static void pb_read_pregs(DWORD *pcode, struct s_PseudoRegs *pRegs, int n)
+{
+	DWORD			code;
+	struct	s_PseudoReg	*pReg;
+
+	pRegs->n=n;
+
+	if (n>=1) //dest
+	{
+		code=*(pcode++);
+		pReg=&pRegs->dest;		//ps: 8=r 9=v 0xa=c 0xb=t
+		pReg->reg=(code>>28)&0xf;	//vs: 8=r 0xa=c 0xb=a 0xc=oP(oP0=oPos oP1=oFog oP2=oPts) 0xd=oD 0xe=oT
+		pReg->num=(code>> 0)&0xf;
+		pReg->msk=(code>>16)&0xf;	//bit0=x/r bit1=y/g bit2=z/b bit3=w/a (need to reverse order for xbox gpu)
+		pReg->msk=((pReg->msk&8)>>3)|((pReg->msk&4)>>1)|((pReg->msk&2)<<1)|((pReg->msk&1)<<3);
+		if (pReg->reg==8) pb_tmp_registers[pReg->num]=1; //markup for actually used temporary registers
+	}
+	if (n>=2) //src0
+	{
+		code=*(pcode++);
+		pReg=&pRegs->src0;		//ps: 8=r 9=v 0xa=c 0xb=t
+		pReg->reg=(code>>28)&0xf;	//vs: 8=r 9=v 0xa=c 0xb=a
+		pReg->num=(code>> 0)&0xf;
+		pReg->mod=(code>>24)&0xf;	//0=x 1=-x (ps: 2=x_bias 3=-x_bias 4=x_bx2 5=-x_bx2 6=1-x 7=x_x2(not supported))
+		pReg->swz=(code>>16)&0xff;	//.p0p1p2p3=>p3p2p1p0 with 00=x/r 01=y/g 10=z/b 11=w/a (need to reverse order for xbox gpu)
+		pReg->swz=((pReg->swz&0xc0)>>6)|((pReg->swz&0x30)>>2)|((pReg->swz&0xc)<<2)|((pReg->swz&3)<<6);
+		pReg->idx=(code>>13)&1;	//vs: if set, means cn to be replaced with c[a0.x+n]
+	}
+	if (n>=3) //src1
+	{
+		code=*(pcode++);
+		pReg=&pRegs->src1;		//ps: 8=r 9=v 0xa=c 0xb=t
+		pReg->reg=(code>>28)&0xf;	//vs: 8=r 9=v 0xa=c 0xb=a
+		pReg->num=(code>> 0)&0xf;
+		pReg->mod=(code>>24)&0xf;	//0=x 1=-x (ps: 2=x_bias 3=-x_bias 4=x_bx2 5=-x_bx2 6=1-x 7=x_x2(not supported))
+		pReg->swz=(code>>16)&0xff;	//.p0p1p2p3=>p3p2p1p0 with 00=x/r 01=y/g 10=z/b 11=w/a (need to reverse order for xbox gpu)
+		pReg->swz=((pReg->swz&0xc0)>>6)|((pReg->swz&0x30)>>2)|((pReg->swz&0xc)<<2)|((pReg->swz&3)<<6);
+		pReg->idx=(code>>13)&1;	//vs: if set, means cn to be replaced with c[a0.x+n]
+	}
+	if (n>=4) //src2
+	{
+		code=*(pcode++);
+		pReg=&pRegs->src2;		//ps: 8=r 9=v 0xa=c 0xb=t
+		pReg->reg=(code>>28)&0xf;	//vs: 8=r 9=v 0xa=c 0xb=a
+		pReg->num=(code>> 0)&0xf;
+		pReg->mod=(code>>24)&0xf;	//0=x 1=-x (ps: 2=x_bias 3=-x_bias 4=x_bx2 5=-x_bx2 6=1-x 7=x_x2(not supported))
+		pReg->swz=(code>>16)&0xff;	//.p0p1p2p3=>p3p2p1p0 with 00=x/r 01=y/g 10=z/b 11=w/a (need to reverse order for xbox gpu)
+		pReg->swz=((pReg->swz&0xc0)>>6)|((pReg->swz&0x30)>>2)|((pReg->swz&0xc)<<2)|((pReg->swz&3)<<6);
+		pReg->idx=(code>>13)&1;	//vs: if set, means cn to be replaced with c[a0.x+n]
+	}
+}					
+
+//sets usual parts of vertex shader micro-code (instruction independant parts)
+static int pb_set_mcode(DWORD *p,struct s_PseudoRegs *pRegs)
+{
+//xbox gpu micro-code format:
+//renouveau constants:
+//|       |       |       |       |       |       |       |       | DWORD#0 (0)
+//|     |scalar#|vector#|(0-95)const_src|inp_src|  source0_high   | DWORD#1
+//|source0_low|         source1             |    source2_high     | DWORD#2
+//|src2low|vtmpmsk|temp_id|stmpmsk|destmsk|x|  (const) dest |p|i| | DWORD#3
+//'x' bit allows to choose a constant as destination. 
+//Shader must be declared with a special type previously
+//in order to get this priviledge and runs much slower.
+//x=1 : destination is not a constant register
+//x=0 : destination is a constant register (4 bits dest field becomes 8 bits const dest field)
+
+//The way I describe things (using c,v,r characters):
+//|       |       |       |       |       |       |       |       | DWORD#0 (0)
+//|     |sc_code|op_code|(0-191) c_numbr|v_numbr|m|source0_swizzle| DWORD#1 (96=>C0 on xbox)
+//|r_numbr|cvr|m|source1_swizzle|r_numbr|cvr|m|source2_swizzle|r_n  DWORD#2
+//r? dest:
+//umbr|cvr|dst_msk|r_numbr|sdstmsk|0 0 0 0|1|1 1 1 1 1 1 1 1|0|i| | DWORD#3
+//o? dest: (o0=oPos o1-2=oT6-7(n/a) o3-4=oD0-1(ff) o5=oFog o6=oPts o7-8=oT4-5(bf) o9-12=oT0-3)
+//umbr|cvr|0 0 0 0|0 1 1 1|0 0 0 0|dst_msk|1|0 0 0 0|o_numbr|s|i| | DWORD#3
+//c? dest: (shaders that can write into constants run slower and have special type)
+//umbr|cvr|0 0 0 0|0 1 1 1|0 0 0 0|dst_msk|0|(0-191) c_numbr|s|i| | DWORD#3 (96=>C0 on xbox)
+//a0 dest: (only allowed in instruction mov a0.x,...)
+//|   |cvr|0 0 0 0|0 1 1 1|0 0 0 0|0 0 0 0|1 1 1 1 1 1 1 1 1|0|i| | DWORD#3
+//i: 0=cn 1=c[a0.x+n] (if any constant is used as any of the sources)
+//s: set if scalar function result is expected in destination
+//no c: c_numbr=0
+//no v: v_numbr=0
+//m: 0=x 1=-x
+//cvr: (can't set more than 1 c and more than 1 v as src)
+//01=r
+//10=v
+//11=c
+//missing src: m=0(x) swizzle=00011011(.xyzw) r_numbr=0(0) cvr=10(v)
+
+	DWORD src0,src1,src2;
+
+	*(p+0)=NV20_VP_INST0_KNOWN; //always 0
+	*(p+1)=0;
+	*(p+2)=0;
+	*(p+3)=0;
+
+	if (pRegs->n<2) //it's a nop
+	{	//src0, src1 & src2 are missing (set them to v0.xyzw)
+		*(p+1)|=0x1b;
+		*(p+2)|=(NV20_VP_SRC_REG_TYPE_INPUT<<NV20_VP_SRC_REG_TYPE_SHIFT)<<NV20_VP_INST_SRC0L_SHIFT;
+		*(p+2)|=((0x1b<<NV20_VP_SRC_REG_SWZ_ALL_SHIFT)|(NV20_VP_SRC_REG_TYPE_INPUT<<NV20_VP_SRC_REG_TYPE_SHIFT))<<NV20_VP_INST_SRC1_SHIFT;
+		*(p+2)|=((0x1b<<NV20_VP_SRC_REG_SWZ_ALL_SHIFT)>>NV20_VP_SRC2_HIGH_SHIFT)<<NV20_VP_INST_SRC2H_SHIFT;
+		*(p+3)|=(NV20_VP_SRC_REG_TYPE_INPUT<<NV20_VP_SRC_REG_TYPE_SHIFT)<<NV20_VP_INST_SRC2L_SHIFT;
+		*(p+3)|=0x00700ff8;
+		return 0;
+	}
+	
+	switch(pRegs->dest.reg) //8=r 0xa=c 0xb=a 0xc=oP(oP0=oPos oP1=oFog oP2=oPts) 0xd=oD 0xe=oT
+	{
+		case 8  : *(p+3)|=0x00000ff8|(pRegs->dest.msk<<NV20_VP_INST_VTEMP_WRITEMASK_SHIFT)|(pRegs->dest.num<<NV20_VP_INST_DEST_TEMP_ID_SHIFT); break; //r (dest=255 NV20_VP_INST_CONST_DEST_FLAG set)
+		case 0xa: *(p+3)|=0x00700000|(pRegs->dest.msk<<NV20_VP_INST_DEST_WRITEMASK_SHIFT)|(pRegs->dest.num<<NV20_VP_INST_CONST_DEST_SHIFT); break; //c (shaders that can write into constants run slower, NV20_VP_INST_CONST_DEST_FLAG cleared)
+		case 0xb: *(p+3)|=0x00700ff8; break; //dest a0 (mask is zero in micro-code but is considered as .x) (only valid for "mov a0.x,...") (r_dest=7 dest=255 NV20_VP_INST_CONST_DEST_FLAG set)
+		case 0xc: *(p+3)|=0x00700800|(pRegs->dest.msk<<NV20_VP_INST_DEST_WRITEMASK_SHIFT)|((pRegs->dest.num?(pRegs->dest.num==1?NV20_VP_INST_DEST_FOG:NV20_VP_INST_DEST_PTS):NV20_VP_INST_DEST_POS)<<NV20_VP_INST_DEST_SHIFT);break; //o(oP0=oPos=o0 oP1=oFog=o5 oP2=oPts=o6) (r_dest=7 NV20_VP_INST_CONST_DEST_FLAG set)
+		case 0xd: *(p+3)|=0x00700800|(pRegs->dest.msk<<NV20_VP_INST_DEST_WRITEMASK_SHIFT)|((pRegs->dest.num?NV20_VP_INST_DEST_COL1:NV20_VP_INST_DEST_COL0)<<NV20_VP_INST_DEST_SHIFT);break; //o(oD0-1=o3-4(front faces)) (r_dest=7 NV20_VP_INST_CONST_DEST_FLAG set)
+		case 0xe: *(p+3)|=0x00700800|(pRegs->dest.msk<<NV20_VP_INST_DEST_WRITEMASK_SHIFT)|(((pRegs->dest.num<4)?NV20_VP_INST_DEST_TC(pRegs->dest.num):((pRegs->dest.num<6)?pRegs->dest.num+3:pRegs->dest.num-5))<<NV20_VP_INST_DEST_SHIFT); break; //o(oT0-3=o9-12 oT4-5=o7-8(bf) oT6-7=o1-2(n/a)) (r_dest=7 NV20_VP_INST_CONST_DEST_FLAG set)
+		//(on xbox, oT4-5 act as oD0-1 for back faces, oT6-7 do not exist, and r12 is an alias for oPos)
+		default : debugPrint("Unrecognized destination register\n"); return -1; break; 
+	}
+	
+	src0=(pRegs->src0.mod*NV20_VP_SRC_REG_NEGATE)|(pRegs->src0.swz<<NV20_VP_SRC_REG_SWZ_ALL_SHIFT);
+	switch(pRegs->src0.reg) //8=r 9=v 0xa=c 0xb=a
+	{
+		case 8  : src0|=(NV20_VP_SRC_REG_TYPE_TEMP<<NV20_VP_SRC_REG_TYPE_SHIFT)|(pRegs->src0.num<<NV20_VP_SRC_REG_TEMP_ID_SHIFT); break; //r
+		case 9  : src0|=(NV20_VP_SRC_REG_TYPE_INPUT<<NV20_VP_SRC_REG_TYPE_SHIFT); *(p+1)|=(pRegs->src0.num<<NV20_VP_INST_INPUT_SRC_SHIFT); break; //v
+		case 0xa: src0|=(NV20_VP_SRC_REG_TYPE_CONST<<NV20_VP_SRC_REG_TYPE_SHIFT); *(p+1)|=((pRegs->src0.num+96)<<NV20_VP_INST_CONST_SRC_SHIFT); break; //c
+		default : debugPrint("Unrecognized src0 register\n"); return -2; break;
+	}
+	*(p+1)|=((src0&NV20_VP_SRC0_HIGH_MASK)>>NV20_VP_SRC0_HIGH_SHIFT)<<NV20_VP_INST_SRC0H_SHIFT;
+	*(p+2)|=(src0&NV20_VP_SRC0_LOW_MASK)<<NV20_VP_INST_SRC0L_SHIFT;
+	*(p+3)|=pRegs->src0.idx*NV20_VP_INST_INDEX_CONST;
+	
+	if (pRegs->n==2)
+	{	//src1 & src2 are missing (set them to v0.xyzw)
+		*(p+2)|=((0x1b<<NV20_VP_SRC_REG_SWZ_ALL_SHIFT)|(NV20_VP_SRC_REG_TYPE_INPUT<<NV20_VP_SRC_REG_TYPE_SHIFT))<<NV20_VP_INST_SRC1_SHIFT;
+		*(p+2)|=((0x1b<<NV20_VP_SRC_REG_SWZ_ALL_SHIFT)>>NV20_VP_SRC2_HIGH_SHIFT)<<NV20_VP_INST_SRC2H_SHIFT;
+		*(p+3)|=(NV20_VP_SRC_REG_TYPE_INPUT<<NV20_VP_SRC_REG_TYPE_SHIFT)<<NV20_VP_INST_SRC2L_SHIFT;
+		return 0;
+	}
+
+	src1=(pRegs->src1.mod*NV20_VP_SRC_REG_NEGATE)|(pRegs->src1.swz<<NV20_VP_SRC_REG_SWZ_ALL_SHIFT);
+	switch(pRegs->src1.reg) //8=r 9=v 0xa=c 0xb=a
+	{
+		case 8  : src1|=(NV20_VP_SRC_REG_TYPE_TEMP<<NV20_VP_SRC_REG_TYPE_SHIFT)|(pRegs->src1.num<<NV20_VP_SRC_REG_TEMP_ID_SHIFT); break; //r
+		case 9  : src1|=(NV20_VP_SRC_REG_TYPE_INPUT<<NV20_VP_SRC_REG_TYPE_SHIFT); *(p+1)|=(pRegs->src1.num<<NV20_VP_INST_INPUT_SRC_SHIFT); break; //v
+		case 0xa: src1|=(NV20_VP_SRC_REG_TYPE_CONST<<NV20_VP_SRC_REG_TYPE_SHIFT); *(p+1)|=((pRegs->src1.num+96)<<NV20_VP_INST_CONST_SRC_SHIFT); break; //c
+		default : debugPrint("Unrecognized src1 register\n"); return -3; break;
+	}
+	*(p+2)|=src1<<NV20_VP_INST_SRC1_SHIFT;
+	*(p+3)|=pRegs->src1.idx*NV20_VP_INST_INDEX_CONST;
+
+	if (pRegs->n==3)
+	{	//src2 is missing (set it to v0.xyzw)
+		*(p+2)|=((0x1b<<NV20_VP_SRC_REG_SWZ_ALL_SHIFT)>>NV20_VP_SRC2_HIGH_SHIFT)<<NV20_VP_INST_SRC2H_SHIFT;
+		*(p+3)|=(NV20_VP_SRC_REG_TYPE_INPUT<<NV20_VP_SRC_REG_TYPE_SHIFT)<<NV20_VP_INST_SRC2L_SHIFT;
+		return 0;
+	}
+
+	src2=(pRegs->src2.mod*NV20_VP_SRC_REG_NEGATE)|(pRegs->src2.swz<<NV20_VP_SRC_REG_SWZ_ALL_SHIFT);
+	switch(pRegs->src2.reg) //8=r 9=v 0xa=c 0xb=a
+	{
+		case 8  : src2|=(NV20_VP_SRC_REG_TYPE_TEMP<<NV20_VP_SRC_REG_TYPE_SHIFT)|(pRegs->src2.num<<NV20_VP_SRC_REG_TEMP_ID_SHIFT); break; //r
+		case 9  : src2|=(NV20_VP_SRC_REG_TYPE_INPUT<<NV20_VP_SRC_REG_TYPE_SHIFT); *(p+1)|=(pRegs->src2.num<<NV20_VP_INST_INPUT_SRC_SHIFT); break; //v
+		case 0xa: src2|=(NV20_VP_SRC_REG_TYPE_CONST<<NV20_VP_SRC_REG_TYPE_SHIFT); *(p+1)|=((pRegs->src2.num+96)<<NV20_VP_INST_CONST_SRC_SHIFT); break; //c
+		default : return -4; debugPrint("Unrecognized src2 register\n"); break;
+	}
+	*(p+2)|=((src2&NV20_VP_SRC2_HIGH_MASK)>>NV20_VP_SRC2_HIGH_SHIFT)<<NV20_VP_INST_SRC2H_SHIFT;
+	*(p+3)|=(src2&NV20_VP_SRC2_LOW_MASK)<<NV20_VP_INST_SRC2L_SHIFT;
+	*(p+3)|=pRegs->src2.idx*NV20_VP_INST_INDEX_CONST;
+	
+	return 0;
+}
+
+//converts shaders pseudo-code into xbox gpu micro-code
+//(not recommended for pixel shader: slow and incomplete)
+DWORD *pb_pcode2mcode(const DWORD *pseudocode)
+{
+	DWORD			*p;
+	DWORD			constant;
+	DWORD			size;
+	DWORD			*pcode;
+	int			i,n;
+	
+	struct	s_PseudoRegs	sRegs;
+	
+	pcode=(DWORD *)pseudocode;
+	
+	if (pcode==NULL) 
+	{
+		debugPrint("pb_pcode2mcode: NULL parameter\n");
+		return NULL;
+	}
+
+	//pb_tmp_registers will tell us unused registers.
+	//this array is updated by pb_read_regs() when tmp registers are detected as destination
+	memset(pb_tmp_registers,0,sizeof(pb_tmp_registers));
+
+	if (*pcode==0xffff0101) //ps_1_1
+	{
+		pcode++;
+		//currently supported (not a lot, but manual ps registers setting is possible): 
+		//- only 1 stage (1 or 2 instructions to set r0, with or without 1 'tex t0' instruction)
+		//- modifier -?n
+		//- modifier ?n_bias (-0.5f)
+		//- modifier ?n_bx2 (*2.0f)
+		//- modifier 1-|?n|
+		//- def cn, r, g, b, a
+		//- nop
+		//- tex t0
+		//- mov r0, ?n         (r0=?n)
+		//- mul r0, ?n, ?n     (r0=?n*?n)
+		//- dp3 r0, ?n, ?n     (r0=?n.?n)
+		//- add r0, ?n, ?n     (r0=?n+?n)
+		//- sub r0, ?n, ?n     (r0=?n-n)
+		//- mad r0, ?n, ?n, ?n (r0=?n*?n+?n)
+		//- lrp r0, src0, src1, src2 (r0=src0*src1+(1-src0)*src2)
+		//- cnd r0, r0.a, src1, src2 (r0=(r0.a>0.5f)?src1:src2) (if r0.a MSB is used for mux)
+		//- coherent destination mask & swizzle (no swizzle or .rgba, .xyzw, .a, .x, .rgb, .xyz for separate rgb/alpha processing)
+
+		p=&pb_gpu_registers[0];
+		//It's recommended to learn initializing registers oneself
+		//in order to avoid resetting most of this -probably useless- default values
+		memset(&pb_gpu_registers[0],0,sizeof(pb_gpu_registers));
+		p[0] =0xd4301010; //PSAlphaInput for stage 0: a.a=v0.a b.a=1.a-|0.a|
+		p[8] =0x000000c0; //PSAlphaOutput for stage 0: r0.a=a*b
+		p[16]=0xc4200000; //PSRGBInput for stage 0: a.rgb=v0.rgb b.rgb=1.rgb-|0.rgb|
+		p[24]=0x000000c0; //PSRGBOutput for stage 0: r0.rgb=a*b
+		//p[32] //C0's constants
+		//p[40] //C1's constants
+		//p[48] //final combiner C0 constant
+		//p[49] //final combiner C1 constant
+		//p[50] //PSCompareMode (used only for texture mode clipplane)
+		//p[51] //PSTextureModes (1 is project 2D: argb=texture(r/q,s/q) usually q=1.0f)
+		//p[52] //PSDotMapping (0 means [0,255]argb from texture=>[0.0,1.0](r,g,b))
+		//p[53] //PSInputTextureSource (most logical value is 0x00210000 when texture stages 2 & 3 are used)
+		p[54]=0x11101; //PSCombinerCount ("stages usage count" | "C0 & C1 may be different from stage to stage" | "r0.a MSB used for mux")
+		//These default settings do "mov r0,v0"
+
+		//'final combiner' is an additional invisible (free) stage doing this:
+		//final pixel.rgb = A * B + (1 - A) * C + D
+		//final pixel.alpha = G.b or G.a (.a modifier must be used if you want .a)
+		//Also all values are clamped to 0..1 (negative values become zero)
+
+		//Inner registers NV20_TCL_PRIMITIVE_3D_RC_FINAL0 and following one
+		//define inputs and modifiers for the 7 parameters A,B,C,D and E,F,G,? (?=0x80, unknown)
+		//Here are a few useful values depending what you want to do:
+		//fog on  & specular on  : 0x130e0300,0x00001c80 (means pixel.rgb=fog.a * (r0.rgb + v1.rgb) + (1 - fog.a) * fog.rgb & pixel.a=r0.a)
+		//fog on  & specular off : 0x130c0300,0x00001c80 (means pixel.rgb=fog.a * r0.rgb + (1 - fog.a) * fog.rgb & pixel.a=r0.a)
+		//fog off & specular on  : 0x0000000e,0x00001c80 (means pixel.rgb=r0.rgb + v1.rgb & pixel.a=r0.a)
+		//fog off & specular off : 0x0000000c,0x00001c80 (means D=r0.rgb & G=r0.a, so final pixel.rgb=r0.rgb & pixel.a=r0.a)
+		
+		//These special read-only registers are also available at final combiner stage (maybe also at any stage?):
+		//zero    = 0       (0x0 is the numeric code for this register, modifier is bits 7-4, mapped to C4)
+		//fog     = fog     (0x3, fog.rgb returns the fog color inner register value, mapped to pseudocode C5 -fog.a is fog transparency, coming from fog table, I guess-)
+		//v1r0sum = r0 + v1 (0xe, I've mapped it to pseudocode C6 in pcode2mcode, useful when specular v1 is to be used)
+		//EFprod  = E * F   (0xf, I've mapped it to pseudocode C7 in pcode2mcode, useful for pixel shader optimization, i.e reduce number of stages)
+
+		//Codes for normal registers:
+		//C0 => 0x1
+		//C1 => 0x2
+		//v0 => 0x4
+		//v1 => 0x5
+		//t0 => 0x8
+		//t1 => 0x9
+		//t2 => 0xa
+		//t3 => 0xb
+		//r0 => 0xc
+		//r1 => 0xd
+
+		//Modifiers (Or it to code above):
+		//default 0x00=|0.rgb| 0x10=x.a
+		//0x20=1-|x| 0x40=2*max(0,x)-1("_bx2") 0x60=1-2*max(0,x) 0x80=max(0,x)-0.5f("_bias") 0xa0=0.5f-max(0,x) 0xc0=x 0xf0=-x
+
+		while (*pcode!=0x0000ffff)
+		{
+			switch(*(pcode++))
+			{
+				case 0x00000000: //nop
+				case 0x40000000: //+nop...
+					break;
+
+				case 0x00000001: //mov r0, ?n (r0=?n)
+				case 0x40000001: //+mov...
+					pb_read_pregs(pcode,&sRegs,2); pcode+=2;
+					if ((sRegs.dest.reg!=8)||(sRegs.dest.num!=0)) { debugPrint("pb_pcode2mcode: Unsupported destination register\n"); return NULL; }
+					if (sRegs.dest.msk&1) p[0]=0x10301010|(pb_preg2psreg(&sRegs.src0)<<24); //PSAlphaInput for stage 0: a.a=?.a b.a=1-|0.a|
+					if ((sRegs.dest.msk&0xe)==0xe) p[16]=0x00200000|(pb_preg2psreg(&sRegs.src0)<<24); //PSRGBInput for stage 0: a.rgb=?.rgb b.rgb=1.rgb-|0.rgb|
+					break;
+
+				case 0x00000002: //add r0, ?n, ?n (r0=?n+?n)
+				case 0x40000002: //+add...
+					pb_read_pregs(pcode,&sRegs,3); pcode+=3;
+					if ((sRegs.dest.reg!=8)||(sRegs.dest.num!=0)) { debugPrint("pb_pcode2mcode: Unsupported destination register\n"); return NULL; }
+					if (sRegs.dest.msk&1)
+					{
+						p[0]=0x10301030|(pb_preg2psreg(&sRegs.src0)<<24)|(pb_preg2psreg(&sRegs.src1)<<8); //PSAlphaInput for stage 0: a.a=?.a b.a=1.a-|0.a| c.a=?.a d=1.a-|0.a|
+						p[8]=0x00000c00; //PSAlphaOutput for stage 0: r0.a=a*b+c*d
+					}
+					if ((sRegs.dest.msk&0xe)==0xe) 
+					{
+						p[16]=0x00200020|(pb_preg2psreg(&sRegs.src0)<<24)|(pb_preg2psreg(&sRegs.src1)<<8); //PSRGBInput for stage 0: a.rgb=?.rgb b.rgb=1.rgb-|0.rgb| c.rgb=?.rgb d.rgb=1.rgb-|0.rgb|
+						p[24]=0x00000c00; //PSRGBOutput for stage 0: r0.rgb=a*b+c*d
+					}
+					break;
+						
+				case 0x00000003: //sub r0, ?n, ?n (r0=?n-?n)
+				case 0x40000003: //+sub...
+					pb_read_pregs(pcode,&sRegs,3); pcode+=3;
+					if ((sRegs.dest.reg!=8)||(sRegs.dest.num!=0)) { debugPrint("pb_pcode2mcode: Unsupported destination register\n"); return NULL; }					
+					if (sRegs.src1.mod<6) 
+						sRegs.src1.mod^=1; //inverts src1 sign
+					else
+					{
+						debugPrint("pb_pcode2mcode: sub not supported if src1 has 1-|x| modifier\n");
+						return NULL;
+					}
+					if (sRegs.dest.msk&1)
+					{
+						p[0]=0x10301030|(pb_preg2psreg(&sRegs.src0)<<24)|(pb_preg2psreg(&sRegs.src1)<<8); //PSAlphaInput for stage 0: a.a=?.a b.a=1.a-|0.a| c.a=?.a d=1.a-|0.a|
+						p[8]=0x00000c00; //PSAlphaOutput for stage 0: r0.a=a*b+c*d
+					}
+					if ((sRegs.dest.msk&0xe)==0xe) 
+					{
+						p[16]=0x00200020|(pb_preg2psreg(&sRegs.src0)<<24)|(pb_preg2psreg(&sRegs.src1)<<8); //PSRGBInput for stage 0: a.rgb=?.rgb b.rgb=1.rgb-|0.rgb| c.rgb=?.rgb d.rgb=1.rgb-|0.rgb|
+						p[24]=0x00000c00; //PSRGBOutput for stage 0: r0.rgb=a*b+c*d
+					}
+					break;
+
+				case 0x00000004: //mad r0, ?n, ?n, ?n (r0=?n*?n+?n)
+				case 0x40000004: //+mad...
+					pb_read_pregs(pcode,&sRegs,4); pcode+=4;
+					if ((sRegs.dest.reg!=8)||(sRegs.dest.num!=0)) { debugPrint("pb_pcode2mcode: Unsupported destination register\n"); return NULL; }
+					if (sRegs.dest.msk&1)
+					{
+						p[0]=0x10101030|(pb_preg2psreg(&sRegs.src0)<<24)|(pb_preg2psreg(&sRegs.src1)<<16)|(pb_preg2psreg(&sRegs.src2)<<8); //PSAlphaInput for stage 0: a.a=?.a b.a=?.a c.a=?.a d.a=1-|0.a|
+						p[8]=0x00000c00; //PSAlphaOutput for stage 0: r0.a=a*b+c*d
+					}
+					if ((sRegs.dest.msk&0xe)==0xe)
+					{
+						p[16]=0x00000020|(pb_preg2psreg(&sRegs.src0)<<24)|(pb_preg2psreg(&sRegs.src1)<<16)|(pb_preg2psreg(&sRegs.src2)<<8); //PSRGBInput for stage 0: a.rgb=?.rgb b.rgb=?.rgb c.rgb=?.rgb d.rgb=1-|0.rgb|
+						p[24]=0x00000c00; //PSRGBOutput for stage 0: r0.rgb=a*b+c*d
+					}
+					break;
+						
+				case 0x00000005: //mul r0, ?n, ?n (r0=?n*?n)
+				case 0x40000005: //+mul...
+					pb_read_pregs(pcode,&sRegs,3); pcode+=3;
+					if ((sRegs.dest.reg!=8)||(sRegs.dest.num!=0)) { debugPrint("pb_pcode2mcode: Unsupported destination register\n"); return NULL; }
+					if (sRegs.dest.msk&1) p[0]=0x10101010|(pb_preg2psreg(&sRegs.src0)<<24)|(pb_preg2psreg(&sRegs.src1)<<16); //PSAlphaInput for stage 0: a.a=?.a b.a=?.a
+					if ((sRegs.dest.msk&0xe)==0xe) p[16]=0x00000000|(pb_preg2psreg(&sRegs.src0)<<24)|(pb_preg2psreg(&sRegs.src1)<<16); //PSRGBInput for stage 0: a.rgb=?.rgb b.rgb=?.rgb
+					break;
+
+				case 0x00000008: //dp3 r0, ?n, ?n (r0=?n.?n)
+				case 0x40000008: //+dp3...
+					pb_read_pregs(pcode,&sRegs,3); pcode+=3;
+					if ((sRegs.dest.reg!=8)||(sRegs.dest.num!=0)) { debugPrint("pb_pcode2mcode: Unsupported destination register\n"); return NULL; }
+					if ((sRegs.dest.msk&0xf)==0xe) //dp3 r0.xyz, ...
+					{
+						p[16]=0x00000000|(pb_preg2psreg(&sRegs.src0)<<24)|(pb_preg2psreg(&sRegs.src1)<<16); //PSRGBInput for stage 0: a.rgb=?.rgb b.rgb=?.rgb
+						p[24]=0x000020c0; //PSRGBOutput for stage 0: r0.rgb=a.b (dot product)
+					}
+					if ((sRegs.dest.msk&0xf)==0xf) //dp3 r0, ...
+					{
+						p[0]=0x10101010;
+						p[8]=0x00000000; //PSAlphaOutput for stage 0: discarded (we will use the b->a propagate bit on rgb side)
+						p[16]=0x00000000|(pb_preg2psreg(&sRegs.src0)<<24)|(pb_preg2psreg(&sRegs.src1)<<16); //PSRGBInput for stage 0: a.rgb=?.rgb b.rgb=?.rgb
+						p[24]=0x000820c0; //PSRGBOutput for stage 0: r0.rgb=a.b (dot product) (and r0.b propagates to r0.a)
+					}
+					break;
+						
+				case 0x00000012: //lrp r0, src0, src1, src2 (r0=src0*src1+(1-src0)*src2)
+				case 0x40000012: //+lrp...
+					pb_read_pregs(pcode,&sRegs,4); pcode+=4;
+					if ((sRegs.dest.reg!=8)||(sRegs.dest.num!=0)) { debugPrint("pb_pcode2mcode: Unsupported destination register\n"); return NULL; }
+					if (sRegs.src0.mod) { debugPrint("pb_pcode2mcode(lrp): Unsupported source 0 modifier\n"); return NULL; }
+					if (sRegs.dest.msk&1)
+					{
+						p[0]=0x10101030|(pb_preg2psreg(&sRegs.src0)<<24)|(pb_preg2psreg(&sRegs.src1)<<16)|(pb_preg2psreg(&sRegs.src2)<<8)|(pb_preg2psreg(&sRegs.src0)&0xf); //PSAlphaInput for stage 0: a.a=src0.a b.a=src1.a c.a=src2.a d.a=1-|src0.a|
+						p[8]=0x00000c00; //PSAlphaOutput for stage 0: r0.a=a*b+c*d
+					}
+					if ((sRegs.dest.msk&0xe)==0xe)
+					{
+						p[16]=0x00000020|(pb_preg2psreg(&sRegs.src0)<<24)|(pb_preg2psreg(&sRegs.src1)<<16)|(pb_preg2psreg(&sRegs.src2)<<8)|(pb_preg2psreg(&sRegs.src0)&0xf); //PSRGBInput for stage 0: a.rgb=src0.rgb b.rgb=src1.rgb c.rgb=src2.rgb d.rgb=1-|src0.rgb|
+						p[24]=0x00000c00; //PSRGBOutput for stage 0: r0.rgb=a*b+c*d
+					}
+					break;
+					
+				case 0x00000042: //tex t0
+				case 0x40000042: //+tex...
+					//We assume tn has been replaced with texture color
+					//because of a previous correct texture stage initialization
+					pb_read_pregs(pcode,&sRegs,1); pcode+=1;
+					if (sRegs.dest.num) { debugPrint("pb_pcode2mcode: Only 'tex t0' is supported\n"); return NULL; }
+					p[51]=0x00000001; //PSTextureModes (1<<(stage*5) is project 2D: argb=texture(r/q,s/q) usually q=1.0f)
+					break;
+
+				case 0x00000050: //cnd r0, r0.a, src1, src2 (r0=(r0.a>0.5f)?src1:src2) (if r0.a MSB used for mux)
+				case 0x40000050: //+cnd...
+					pb_read_pregs(pcode,&sRegs,4); pcode+=4;
+					if ((sRegs.dest.reg!=8)||(sRegs.dest.num!=0)) { debugPrint("pb_pcode2mcode: Unsupported destination register\n"); return NULL; }
+					if (sRegs.dest.msk&1)
+					{
+						p[0]=0x10301030|(pb_preg2psreg(&sRegs.src2)<<24)|(pb_preg2psreg(&sRegs.src1)<<8); //PSAlphaInput for stage 0: a.a=src2.a b.a=1-|0.a| c.a=src1.a d.a=1-|0.a|
+						p[8]=0x00004c00; //PSAlphaOutput for stage 0: r0.rgb=(r0.a MSB not set)?(a*b):(c*d)=(r0.a<=0.5f)?src2.rgb:src1.rgb
+					}
+					if ((sRegs.dest.msk&0xe)==0xe)
+					{
+						p[16]=0x00200020|(pb_preg2psreg(&sRegs.src2)<<24)|(pb_preg2psreg(&sRegs.src1)<<8); //PSRGBInput for stage 0: a.rgb=src2.rgb b.rgb=1.rgb-|0.rgb| c.rgb=src1.rgb d.rgb=1.rgb-|0.rgb|
+						p[24]=0x00004c00; //PSRGBOutput for stage 0: r0.rgb=(r0.a MSB not set)?(a*b):(c*d)=(r0.a<=0.5f)?src2.rgb:src1.rgb
+					}
+					break;
+
+				case 0x00000051: //def cn, r, g, b, a
+					pb_read_pregs(pcode,&sRegs,1); pcode+=1;
+					//converts 4 floats (r,g,b,a) into 1 dword 0xaarrggbb ([0,1.0f]=>[0,0xff])
+					constant=0;
+					constant|=((DWORD)(255.0f*(*((float *)(pcode+3)))))<<24;
+					constant|=((DWORD)(255.0f*(*((float *)(pcode+0)))))<<16;
+					constant|=((DWORD)(255.0f*(*((float *)(pcode+1)))))<<8;
+					constant|=((DWORD)(255.0f*(*((float *)(pcode+2)))))<<0;
+					//distribute c0=>c0 stage 0, c1=>c1 stage 0, c2=>c0 stage 1, etc...
+					p[32+8*(sRegs.dest.num&1)+(sRegs.dest.num>>1)]=constant;
+					pcode+=4;
+					break;
+
+				default:
+					debugPrint("pb_pcode2mcode: Unrecognized ps token #%08x\n",*(pcode-1));
+					return NULL;
+			}
+		}
+		return &pb_gpu_registers[0];
+	}
+
+	if (*pcode!=0xfffe0101) //vs_1_1
+	{
+		debugPrint("pb_pcode2mcode: Shader version not supported\n");
+		return NULL;
+	}
+	
+	//it's a vertex shader! (vs_1_1 should be entirely supported by code below -report any issue-)
+	pcode++;
+	
+	pb_exp_constflag=0; //in order to not set taylor series exp macro constants up more than once
+	pb_log_constflag=0; //in order to not set taylor series log macro constants up more than once
+	
+	n=0; //instructions counter (can't exceed 136 on xbox)
+
+	p=&pb_gpu_programnc[1]; //push buffer compatible sequence setting up program and constants
+	pb_push(p++,NV20_TCL_PRIMITIVE_3D_VP_PROGRAM_START_ID,1); *(p++)=0; //set run address of shader
+	pb_push(p++,NV20_TCL_PRIMITIVE_3D_SHADER_TYPE,2); *(p++)=SHADER_TYPE_EXTERNAL; *(p++)=SHADER_SUBTYPE_REGULAR; //set shader vertex type (external shader, regular: not allowed to write into constants -faster-)
+	pb_push(p++,NV20_TCL_PRIMITIVE_3D_VP_UPLOAD_FROM_ID,1); *(p++)=0; //set cursor in order to load data into program area
+	
+	while(*pcode!=0x0000ffff)
+	{
+		if (n==136) { debugPrint("pb_pcode2mcode: Too many instructions: max=136 (including expanded macros)\n"); return NULL; }
+
+		switch(*(pcode++))
+		{
+			//standard pseudo-code:
+
+			case 0x00000000: //nop
+			case 0x40000000: //+nop
+				pb_push(p++,NV20_TCL_PRIMITIVE_3D_VP_UPLOAD_INST0,4); n++;
+				pb_read_pregs(pcode,&sRegs,0); pcode+=0;
+				if (pb_set_mcode(p,&sRegs)) { debugPrint("pb_pcode2mcode: Unrecognized token\n"); return NULL; }
+				*(p+1)|=NV20_VP_INST_OPCODE_NOP<<NV20_VP_INST_VEC_OPCODE_SHIFT;
+				p+=4;
+				break;
+
+			case 0x00000001: //mov dest,src0
+			case 0x40000001: //+mov
+				pb_push(p++,NV20_TCL_PRIMITIVE_3D_VP_UPLOAD_INST0,4);  n++;
+				pb_read_pregs(pcode,&sRegs,2); pcode+=2;
+				if (pb_set_mcode(p,&sRegs)) { debugPrint("pb_pcode2mcode: Unrecognized token\n"); return NULL; }
+				if (sRegs.dest.reg==0xb) 
+					*(p+1)|=NV20_VP_INST_OPCODE_ARL<<NV20_VP_INST_VEC_OPCODE_SHIFT; //mov a0,...
+				else
+					*(p+1)|=NV20_VP_INST_OPCODE_MOV<<NV20_VP_INST_VEC_OPCODE_SHIFT;
+				p+=4;
+				break;
+
+			case 0x00000002: //add dest,src0,src1
+			case 0x40000002: //+add
+				pb_push(p++,NV20_TCL_PRIMITIVE_3D_VP_UPLOAD_INST0,4); n++;
+				pb_read_pregs(pcode,&sRegs,3); pcode+=3;
+				//src2 is used instead of src1 for add
+				sRegs.n=4;
+				sRegs.src2=sRegs.src1;
+				sRegs.src1.reg=9; //v0.xyzw for unused src
+				sRegs.src1.num=0;
+				sRegs.src1.mod=0;
+				sRegs.src1.swz=0x1b;
+				sRegs.src1.idx=0;
+				if (pb_set_mcode(p,&sRegs)) { debugPrint("pb_pcode2mcode: Unrecognized token\n"); return NULL; }
+				*(p+1)|=NV20_VP_INST_OPCODE_ADD<<NV20_VP_INST_VEC_OPCODE_SHIFT;
+				p+=4;
+				break;
+
+			case 0x00000003: //sub dest,src0,src1
+			case 0x40000003: //+sub
+				pb_push(p++,NV20_TCL_PRIMITIVE_3D_VP_UPLOAD_INST0,4); n++;
+				pb_read_pregs(pcode,&sRegs,3); pcode+=3;
+				sRegs.src1.mod^=1; //inverts src1 sign
+				//src2 is used instead of src1 for add
+				sRegs.n=4;
+				sRegs.src2=sRegs.src1;
+				sRegs.src1.reg=9; //v0.xyzw for unused src
+				sRegs.src1.num=0;
+				sRegs.src1.mod=0;
+				sRegs.src1.swz=0x1b;
+				sRegs.src1.idx=0;
+				if (pb_set_mcode(p,&sRegs)) { debugPrint("pb_pcode2mcode: Unrecognized token\n"); return NULL; }
+				*(p+1)|=NV20_VP_INST_OPCODE_ADD<<NV20_VP_INST_VEC_OPCODE_SHIFT;
+				p+=4;
+				break;
+
+			case 0x00000004: //mad dest,src0,src1,src2
+			case 0x40000004: //+mad
+				pb_push(p++,NV20_TCL_PRIMITIVE_3D_VP_UPLOAD_INST0,4); n++;
+				pb_read_pregs(pcode,&sRegs,4); pcode+=4;
+				if (pb_set_mcode(p,&sRegs)) { debugPrint("pb_pcode2mcode: Unrecognized token\n"); return NULL; }
+				*(p+1)|=NV20_VP_INST_OPCODE_MAD<<NV20_VP_INST_VEC_OPCODE_SHIFT;
+				p+=4;
+				break;
+				
+			case 0x00000005: //mul dest,src0,src1
+			case 0x40000005: //+mul
+				pb_push(p++,NV20_TCL_PRIMITIVE_3D_VP_UPLOAD_INST0,4); n++;
+				pb_read_pregs(pcode,&sRegs,3); pcode+=3;
+				if (pb_set_mcode(p,&sRegs)) { debugPrint("pb_pcode2mcode: Unrecognized token\n"); return NULL; }
+				*(p+1)|=NV20_VP_INST_OPCODE_MUL<<NV20_VP_INST_VEC_OPCODE_SHIFT;
+				p+=4;
+				break;
+
+			case 0x00000006: //rcp dest,src0 (scalar 1/x function)
+			case 0x40000006: //+rcp
+				pb_push(p++,NV20_TCL_PRIMITIVE_3D_VP_UPLOAD_INST0,4); n++;
+				pb_read_pregs(pcode,&sRegs,2); pcode+=2;
+				//src2 is used instead of src0 in scalar functions
+				sRegs.n=4;
+				sRegs.src2=sRegs.src0;
+				sRegs.src0.reg=9; //v0.xyzw for unused src
+				sRegs.src0.num=0;
+				sRegs.src0.mod=0;
+				sRegs.src0.swz=0x1b;
+				sRegs.src0.idx=0;
+				sRegs.src1.reg=9; //v0.xyzw for unused src
+				sRegs.src1.num=0;
+				sRegs.src1.mod=0;
+				sRegs.src1.swz=0x1b;
+				sRegs.src1.idx=0;
+				if (pb_set_mcode(p,&sRegs)) { debugPrint("pb_pcode2mcode: Unrecognized token\n"); return NULL; }
+				*(p+1)|=NV20_VP_INST_OPCODE_RCP<<NV20_VP_INST_SCA_OPCODE_SHIFT;
+				if (sRegs.dest.reg!=8) //not r
+					*(p+3)|=NV20_VP_INST_DEST_SCA; //warns GPU that destination will receive scalar function result
+				else
+				{
+					//scalar temp dest mask=temp dest mask & temp dest mask=0
+					*(p+3)|=((*(p+3))&NV20_VP_INST_VTEMP_WRITEMASK_MASK)>>(NV20_VP_INST_VTEMP_WRITEMASK_SHIFT-NV20_VP_INST_STEMP_WRITEMASK_SHIFT);
+					*(p+3)&=~NV20_VP_INST_VTEMP_WRITEMASK_MASK;
+				}			
+				p+=4;
+				break;
+
+			case 0x00000007: //rsq dest,src0 (scalar 1/sqrt(x) function)
+			case 0x40000007: //+rsq
+				pb_push(p++,NV20_TCL_PRIMITIVE_3D_VP_UPLOAD_INST0,4); n++;
+				pb_read_pregs(pcode,&sRegs,2); pcode+=2;
+				//src2 is used instead of src0 in scalar functions
+				sRegs.n=4;
+				sRegs.src2=sRegs.src0;
+				sRegs.src0.reg=9; //v0.xyzw for unused src
+				sRegs.src0.num=0;
+				sRegs.src0.mod=0;
+				sRegs.src0.swz=0x1b;
+				sRegs.src0.idx=0;
+				sRegs.src1.reg=9; //v0.xyzw for unused src
+				sRegs.src1.num=0;
+				sRegs.src1.mod=0;
+				sRegs.src1.swz=0x1b;
+				sRegs.src1.idx=0;
+				if (pb_set_mcode(p,&sRegs)) { debugPrint("pb_pcode2mcode: Unrecognized token\n"); return NULL; }
+				*(p+1)|=NV20_VP_INST_OPCODE_RSQ<<NV20_VP_INST_SCA_OPCODE_SHIFT;
+				if (sRegs.dest.reg!=8) //not r
+					*(p+3)|=NV20_VP_INST_DEST_SCA; //warns GPU that destination will receive scalar function result
+				else
+				{
+					//scalar temp dest mask=temp dest mask & temp dest mask=0
+					*(p+3)|=((*(p+3))&NV20_VP_INST_VTEMP_WRITEMASK_MASK)>>(NV20_VP_INST_VTEMP_WRITEMASK_SHIFT-NV20_VP_INST_STEMP_WRITEMASK_SHIFT);
+					*(p+3)&=~NV20_VP_INST_VTEMP_WRITEMASK_MASK;
+				}
+				p+=4;
+				break;
+
+			case 0x00000008: //dp3 dest,src0,src1
+			case 0x40000008: //+dp3
+				pb_push(p++,NV20_TCL_PRIMITIVE_3D_VP_UPLOAD_INST0,4); n++;
+				pb_read_pregs(pcode,&sRegs,3); pcode+=3;
+				if (pb_set_mcode(p,&sRegs)) { debugPrint("pb_pcode2mcode: Unrecognized token\n"); return NULL; }
+				*(p+1)|=NV20_VP_INST_OPCODE_DP3<<NV20_VP_INST_VEC_OPCODE_SHIFT;
+				p+=4;
+				break;
+
+			case 0x00000009: //dp4 dest,src0,src1
+			case 0x40000009: //+dp4
+				pb_push(p++,NV20_TCL_PRIMITIVE_3D_VP_UPLOAD_INST0,4); n++;
+				pb_read_pregs(pcode,&sRegs,3); pcode+=3;
+				if (pb_set_mcode(p,&sRegs)) { debugPrint("pb_pcode2mcode: Unrecognized token\n"); return NULL; }
+				*(p+1)|=NV20_VP_INST_OPCODE_DP4<<NV20_VP_INST_VEC_OPCODE_SHIFT;
+				p+=4;
+				break;
+
+			case 0x0000000a: //min dest,src0,src1
+			case 0x4000000a: //+min
+				pb_push(p++,NV20_TCL_PRIMITIVE_3D_VP_UPLOAD_INST0,4); n++;
+				pb_read_pregs(pcode,&sRegs,3); pcode+=3;
+				if (pb_set_mcode(p,&sRegs)) { debugPrint("pb_pcode2mcode: Unrecognized token\n"); return NULL; }
+				*(p+1)|=NV20_VP_INST_OPCODE_MIN<<NV20_VP_INST_VEC_OPCODE_SHIFT;
+				p+=4;
+				break;
+
+			case 0x0000000b: //max dest,src0,src1
+			case 0x4000000b: //+max
+				pb_push(p++,NV20_TCL_PRIMITIVE_3D_VP_UPLOAD_INST0,4); n++;
+				pb_read_pregs(pcode,&sRegs,3); pcode+=3;
+				if (pb_set_mcode(p,&sRegs)) { debugPrint("pb_pcode2mcode: Unrecognized token\n"); return NULL; }
+				*(p+1)|=NV20_VP_INST_OPCODE_MAX<<NV20_VP_INST_VEC_OPCODE_SHIFT;
+				p+=4;
+				break;
+
+			case 0x0000000c: //slt dest,src0,src1 (set dest=1 if src0<src1)
+			case 0x4000000c: //+slt
+				pb_push(p++,NV20_TCL_PRIMITIVE_3D_VP_UPLOAD_INST0,4); n++;
+				pb_read_pregs(pcode,&sRegs,3); pcode+=3;
+				if (pb_set_mcode(p,&sRegs)) { debugPrint("pb_pcode2mcode: Unrecognized token\n"); return NULL; }
+				*(p+1)|=NV20_VP_INST_OPCODE_SLT<<NV20_VP_INST_VEC_OPCODE_SHIFT;
+				p+=4;
+				break;
+
+			case 0x0000000d: //sge dest,src0,src1 (set dest=1 if src0>=src1)
+			case 0x4000000d: //+sge
+				pb_push(p++,NV20_TCL_PRIMITIVE_3D_VP_UPLOAD_INST0,4); n++;
+				pb_read_pregs(pcode,&sRegs,3); pcode+=3;
+				if (pb_set_mcode(p,&sRegs)) { debugPrint("pb_pcode2mcode: Unrecognized token\n"); return NULL; }
+				*(p+1)|=NV20_VP_INST_OPCODE_SGE<<NV20_VP_INST_VEC_OPCODE_SHIFT;
+				p+=4;
+				break;
+
+			case 0x0000000e: //exp dest,src0 (macro expanding many full precision instructions: slow)
+			case 0x4000000e: //+exp
+				if (pb_exp_constflag==0) //exp macro constants already set?
+				{
+					pb_exp_constflag=1;
+					pb_push(p++,NV20_TCL_PRIMITIVE_3D_VP_UPLOAD_CONST_ID,1); *(p++)=94; //set cursor in order to load data into C-2 and C-1 (xbox accepts C-96 up to C-1)
+					pb_push(p++,NV20_TCL_PRIMITIVE_3D_VP_UPLOAD_CONST_X,4); //Taylor series related coefficients
+					*((float *)(p++))=1.0f; 		//C-2.x a
+					*((float *)(p++))=-6.93147182e-1; 	//C-2.y b
+					*((float *)(p++))=2.40226462e-1; 	//C-2.z c
+					*((float *)(p++))=-5.55036440e-2;	//C-2.w d
+					pb_push(p++,NV20_TCL_PRIMITIVE_3D_VP_UPLOAD_CONST_X,4); 
+					*((float *)(p++))=9.61597636e-3; 	//C-1.x e
+					*((float *)(p++))=-1.32823968e-3; 	//C-1.y f
+					*((float *)(p++))=1.47491097e-4; 	//C-1.z g
+					*((float *)(p++))=-1.08635004e-5;	//C-1.w h
+				}
+				//after a first step x=expp(src0)
+				//we will compute ri.w=ax^0+bx^1+cx^2+dx^3+...+hx^7
+				//i.e ri.w=x*(x*(x*(x*(x*(x*(x*h+g)+f)+e)+d)+c)+b)+a
+				//then exp(x)=x*(1/ri.w)
+				//expp ri, src0 (first partial precision calculation & preserve x in ri.x)
+				pb_push(p++,NV20_TCL_PRIMITIVE_3D_VP_UPLOAD_INST0,4); n++; if (n==136) { debugPrint("pb_pcode2mcode(exp): Too many instructions: max=136 (including expanded macros)\n"); return NULL; }
+				pb_read_pregs(pcode,&sRegs,2); //but don't increment pcode yet (so we can read again dest later)
+				//look for unused temp register i
+				for(i=0;i<16;i++) if (pb_tmp_registers[i]==0) break;
+				if (i==16) { debugPrint("pb_pcode2mcode: exp macro needs 1 temporary register (none left)\n"); return NULL; }
+				sRegs.dest.reg=8; //replace dest with ri.x
+				sRegs.dest.num=i;
+				sRegs.dest.msk=8; //.x
+				//src2 is used instead of src0 in scalar functions
+				sRegs.n=4;
+				sRegs.src2=sRegs.src0;
+				sRegs.src0.reg=9; //v0.xyzw for unused src
+				sRegs.src0.num=0;
+				sRegs.src0.mod=0;
+				sRegs.src0.swz=0x1b;
+				sRegs.src0.idx=0;
+				sRegs.src1.reg=9; //v0.xyzw for unused src
+				sRegs.src1.num=0;
+				sRegs.src1.mod=0;
+				sRegs.src1.swz=0x1b;
+				sRegs.src1.idx=0;
+				if (pb_set_mcode(p,&sRegs)) { debugPrint("pb_pcode2mcode(exp): Unrecognized token\n"); return NULL; }
+				*(p+1)|=NV20_VP_INST_OPCODE_EXP<<NV20_VP_INST_SCA_OPCODE_SHIFT;
+				//scalar temp dest mask=temp dest mask & temp dest mask=0
+				*(p+3)|=((*(p+3))&NV20_VP_INST_VTEMP_WRITEMASK_MASK)>>(NV20_VP_INST_VTEMP_WRITEMASK_SHIFT-NV20_VP_INST_STEMP_WRITEMASK_SHIFT);
+				*(p+3)&=~NV20_VP_INST_VTEMP_WRITEMASK_MASK;
+				p+=4;
+				//mov ri.w, C-1.w
+				pb_push(p++,NV20_TCL_PRIMITIVE_3D_VP_UPLOAD_INST0,4); n++; if (n==136) { debugPrint("pb_pcode2mcode(exp): Too many instructions: max=136 (including expanded macros)\n"); return NULL; }
+				sRegs.n=2;
+				sRegs.dest.msk=1; //.w
+				sRegs.src0.reg=0xa; //c
+				sRegs.src0.num=-1;
+				sRegs.src0.swz=0xff; //.wwww
+				sRegs.src0.mod=0;
+				sRegs.src0.idx=0;
+				if (pb_set_mcode(p,&sRegs)) { debugPrint("pb_pcode2mcode(exp): Unrecognized token\n"); return NULL; }
+				*(p+1)|=NV20_VP_INST_OPCODE_MOV<<NV20_VP_INST_VEC_OPCODE_SHIFT;
+				p+=4;
+				//mad ri.w, ri.w, ri.x, C-1.z (next=x*(previous+constant))
+				pb_push(p++,NV20_TCL_PRIMITIVE_3D_VP_UPLOAD_INST0,4); n++; if (n==136) { debugPrint("pb_pcode2mcode(exp): Too many instructions: max=136 (including expanded macros)\n"); return NULL; }
+				sRegs.n=4;
+				sRegs.src0.reg=8; //r
+				sRegs.src0.num=i;
+				sRegs.src1.reg=8; //r
+				sRegs.src1.num=i;
+				sRegs.src1.swz=0; //.xxxx
+				sRegs.src1.mod=0;
+				sRegs.src1.idx=0;
+				sRegs.src2.reg=0xa; //c
+				sRegs.src2.num=-1;
+				sRegs.src2.swz=0xaa; //.zzzz
+				sRegs.src2.mod=0;
+				sRegs.src2.idx=0;
+				if (pb_set_mcode(p,&sRegs)) { debugPrint("pb_pcode2mcode(exp): Unrecognized token\n"); return NULL; }
+				*(p+1)|=NV20_VP_INST_OPCODE_MAD<<NV20_VP_INST_VEC_OPCODE_SHIFT;
+				p+=4;
+				//mad ri.w, ri.w, ri.x, C-1.y
+				pb_push(p++,NV20_TCL_PRIMITIVE_3D_VP_UPLOAD_INST0,4); n++; if (n==136) { debugPrint("pb_pcode2mcode(exp): Too many instructions: max=136 (including expanded macros)\n"); return NULL; }
+				sRegs.src2.swz=0x55; //.yyyy
+				if (pb_set_mcode(p,&sRegs)) { debugPrint("pb_pcode2mcode(exp): Unrecognized token\n"); return NULL; }
+				*(p+1)|=NV20_VP_INST_OPCODE_MAD<<NV20_VP_INST_VEC_OPCODE_SHIFT;
+				p+=4;
+				//mad ri.w, ri.w, ri.x, C-1.x
+				pb_push(p++,NV20_TCL_PRIMITIVE_3D_VP_UPLOAD_INST0,4); n++; if (n==136) { debugPrint("pb_pcode2mcode(exp): Too many instructions: max=136 (including expanded macros)\n"); return NULL; }
+				sRegs.src2.swz=0; //.xxxx
+				if (pb_set_mcode(p,&sRegs)) { debugPrint("pb_pcode2mcode(exp): Unrecognized token\n"); return NULL; }
+				*(p+1)|=NV20_VP_INST_OPCODE_MAD<<NV20_VP_INST_VEC_OPCODE_SHIFT;
+				p+=4;
+				//mad ri.w, ri.w, ri.x, C-2.w
+				pb_push(p++,NV20_TCL_PRIMITIVE_3D_VP_UPLOAD_INST0,4); n++; if (n==136) { debugPrint("pb_pcode2mcode(exp): Too many instructions: max=136 (including expanded macros)\n"); return NULL; }
+				sRegs.src2.num=-2;
+				sRegs.src2.swz=0xff; //.wwww
+				if (pb_set_mcode(p,&sRegs)) { debugPrint("pb_pcode2mcode(exp): Unrecognized token\n"); return NULL; }
+				*(p+1)|=NV20_VP_INST_OPCODE_MAD<<NV20_VP_INST_VEC_OPCODE_SHIFT;
+				p+=4;
+				//mad ri.w, ri.w, ri.x, C-2.z
+				pb_push(p++,NV20_TCL_PRIMITIVE_3D_VP_UPLOAD_INST0,4); n++; if (n==136) { debugPrint("pb_pcode2mcode(exp): Too many instructions: max=136 (including expanded macros)\n"); return NULL; }
+				sRegs.src2.swz=0xaa; //.zzzz
+				if (pb_set_mcode(p,&sRegs)) { debugPrint("pb_pcode2mcode(exp): Unrecognized token\n"); return NULL; }
+				*(p+1)|=NV20_VP_INST_OPCODE_MAD<<NV20_VP_INST_VEC_OPCODE_SHIFT;
+				p+=4;
+				//mad ri.w, ri.w, ri.x, C-2.y
+				pb_push(p++,NV20_TCL_PRIMITIVE_3D_VP_UPLOAD_INST0,4); n++; if (n==136) { debugPrint("pb_pcode2mcode(exp): Too many instructions: max=136 (including expanded macros)\n"); return NULL; }
+				sRegs.src2.swz=0x55; //.yyyy
+				if (pb_set_mcode(p,&sRegs)) { debugPrint("pb_pcode2mcode(exp): Unrecognized token\n"); return NULL; }
+				*(p+1)|=NV20_VP_INST_OPCODE_MAD<<NV20_VP_INST_VEC_OPCODE_SHIFT;
+				p+=4;
+				//mad ri.w, ri.w, ri.x, C-2.x
+				pb_push(p++,NV20_TCL_PRIMITIVE_3D_VP_UPLOAD_INST0,4); n++; if (n==136) { debugPrint("pb_pcode2mcode(exp): Too many instructions: max=136 (including expanded macros)\n"); return NULL; }
+				sRegs.src2.swz=0; //.xxxx
+				if (pb_set_mcode(p,&sRegs)) { debugPrint("pb_pcode2mcode(exp): Unrecognized token\n"); return NULL; }
+				*(p+1)|=NV20_VP_INST_OPCODE_MAD<<NV20_VP_INST_VEC_OPCODE_SHIFT;
+				p+=4;
+				//rcp ri.w, ri.w (ri.w=1/ri.w)
+				pb_push(p++,NV20_TCL_PRIMITIVE_3D_VP_UPLOAD_INST0,4); n++; if (n==136) { debugPrint("pb_pcode2mcode(exp): Too many instructions: max=136 (including expanded macros)\n"); return NULL; }
+				//src2 is used instead of src0 in scalar functions
+				sRegs.n=4;
+				sRegs.src2=sRegs.src0;
+				sRegs.src0.reg=9; //v0.xyzw for unused src
+				sRegs.src0.num=0;
+				sRegs.src0.mod=0;
+				sRegs.src0.swz=0x1b;
+				sRegs.src0.idx=0;
+				sRegs.src1.reg=9; //v0.xyzw for unused src
+				sRegs.src1.num=0;
+				sRegs.src1.mod=0;
+				sRegs.src1.swz=0x1b;
+				sRegs.src1.idx=0;			
+				if (pb_set_mcode(p,&sRegs)) { debugPrint("pb_pcode2mcode(exp): Unrecognized token\n"); return NULL; }
+				*(p+1)|=NV20_VP_INST_OPCODE_RCP<<NV20_VP_INST_SCA_OPCODE_SHIFT;
+				//scalar temp dest mask=temp dest mask & temp dest mask=0
+				*(p+3)|=((*(p+3))&NV20_VP_INST_VTEMP_WRITEMASK_MASK)>>(NV20_VP_INST_VTEMP_WRITEMASK_SHIFT-NV20_VP_INST_STEMP_WRITEMASK_SHIFT);
+				*(p+3)&=~NV20_VP_INST_VTEMP_WRITEMASK_MASK;
+				p+=4;
+				//mul dest, ri.w, ri.x
+				pb_push(p++,NV20_TCL_PRIMITIVE_3D_VP_UPLOAD_INST0,4); n++; if (n==136) { debugPrint("pb_pcode2mcode(exp): Too many instructions: max=136 (including expanded macros)\n"); return NULL; }
+				pb_read_pregs(pcode,&sRegs,2); pcode+=2; //read dest again and preserve it
+				sRegs.n=3;
+				sRegs.src0.reg=8; //r
+				sRegs.src0.num=i;
+				sRegs.src0.swz=0xff; //.wwww
+				sRegs.src0.mod=0;
+				sRegs.src0.idx=0;
+				sRegs.src1.reg=8; //r
+				sRegs.src1.num=i;
+				sRegs.src1.swz=0; //.xxxx
+				sRegs.src1.mod=0;
+				sRegs.src1.idx=0;				
+				if (pb_set_mcode(p,&sRegs)) { debugPrint("pb_pcode2mcode(exp): Unrecognized token\n"); return NULL; }
+				*(p+1)|=NV20_VP_INST_OPCODE_MUL<<NV20_VP_INST_VEC_OPCODE_SHIFT;
+				p+=4;
+				break;
+
+			case 0x0000000f: //log dest,src0 (macro expanding many full precision instructions: slow)
+			case 0x4000000f: //+log
+				if (pb_log_constflag==0) //log macro constants already set?
+				{
+					pb_log_constflag=1;
+					pb_push(p++,NV20_TCL_PRIMITIVE_3D_VP_UPLOAD_CONST_ID,1); *(p++)=93; //set cursor in order to load data into C-5, C-4 and C-3 (xbox accepts C-96 up to C-1)
+					pb_push(p++,NV20_TCL_PRIMITIVE_3D_VP_UPLOAD_CONST_X,4); //Taylor series related coefficients
+					*((float *)(p++))=1.0f; 		//C-5.x
+					*((float *)(p++))=0.0f;
+					*((float *)(p++))=0.0f;
+					*((float *)(p++))=0.0f;
+					pb_push(p++,NV20_TCL_PRIMITIVE_3D_VP_UPLOAD_CONST_X,4);
+					*((float *)(p++))=1.44268966f;	//C-4.x a
+					*((float *)(p++))=-7.21165776e-1; 	//C-4.y b
+					*((float *)(p++))=4.78684813e-1; 	//C-4.z c
+					*((float *)(p++))=-3.47305417e-1;	//C-4.w d
+					pb_push(p++,NV20_TCL_PRIMITIVE_3D_VP_UPLOAD_CONST_X,4); 
+					*((float *)(p++))=2.41873696e-1; 	//C-3.x e
+					*((float *)(p++))=-1.37531206e-1; 	//C-3.y f
+					*((float *)(p++))=5.20646796e-2; 	//C-3.z g
+					*((float *)(p++))=-9.31049418e-3;	//C-3.w h
+				}
+				//after a first step y=logp(src0)
+				//we will compute ri.w=ax^0+bx^1+cx^2+dx^3+...+hx^7
+				//i.e ri.w=x*(x*(x*(x*(x*(x*(x*h+g)+f)+e)+d)+c)+b)+a
+				//then log(y)=x*ri.w+y (with x=y-1)
+				//logp ri.xy, src0 (first partial precision calculation & preserve y in ri.y)
+				pb_push(p++,NV20_TCL_PRIMITIVE_3D_VP_UPLOAD_INST0,4); n++; if (n==136) { debugPrint("pb_pcode2mcode(log): Too many instructions: max=136 (including expanded macros)\n"); return NULL; }
+				pb_read_pregs(pcode,&sRegs,2); //but don't increment pcode yet (so we can read again dest later)
+				//look for unused temp register i
+				for(i=0;i<16;i++) if (pb_tmp_registers[i]==0) break;
+				if (i==16) { debugPrint("pb_pcode2mcode: log macro needs 1 temporary register (none left)\n"); return NULL; }
+				sRegs.dest.reg=8; //replace dest with ri.x
+				sRegs.dest.num=i;
+				sRegs.dest.msk=0xc; //.xy
+				//src2 is used instead of src0 in scalar functions
+				sRegs.n=4;
+				sRegs.src2=sRegs.src0;
+				sRegs.src0.reg=9; //v0.xyzw for unused src
+				sRegs.src0.num=0;
+				sRegs.src0.mod=0;
+				sRegs.src0.swz=0x1b;
+				sRegs.src0.idx=0;
+				sRegs.src1.reg=9; //v0.xyzw for unused src
+				sRegs.src1.num=0;
+				sRegs.src1.mod=0;
+				sRegs.src1.swz=0x1b;
+				sRegs.src1.idx=0;
+				if (pb_set_mcode(p,&sRegs)) { debugPrint("pb_pcode2mcode(log): Unrecognized token\n"); return NULL; }
+				*(p+1)|=NV20_VP_INST_OPCODE_LOG<<NV20_VP_INST_SCA_OPCODE_SHIFT;
+				//scalar temp dest mask=temp dest mask & temp dest mask=0
+				*(p+3)|=((*(p+3))&NV20_VP_INST_VTEMP_WRITEMASK_MASK)>>(NV20_VP_INST_VTEMP_WRITEMASK_SHIFT-NV20_VP_INST_STEMP_WRITEMASK_SHIFT);
+				*(p+3)&=~NV20_VP_INST_VTEMP_WRITEMASK_MASK;
+				p+=4;
+				//sub ri.x, ri.x, C-5.x (x=y-1)
+				pb_push(p++,NV20_TCL_PRIMITIVE_3D_VP_UPLOAD_INST0,4); n++; if (n==136) { debugPrint("pb_pcode2mcode(log): Too many instructions: max=136 (including expanded macros)\n"); return NULL; }
+				sRegs.n=3;
+				sRegs.dest.msk=8; //.x
+				sRegs.src0.reg=8;
+				sRegs.src0.num=i;
+				sRegs.src0.swz=0; //.xxxx
+				sRegs.src0.mod=0;
+				sRegs.src0.idx=0;
+				//src2 is used instead of src1 for add
+				sRegs.n=4;
+				sRegs.src2.reg=0xa; //c
+				sRegs.src2.num=-5;
+				sRegs.src2.swz=0; //.xxxx
+				sRegs.src2.mod=1; //-
+				sRegs.src2.idx=0;
+				sRegs.src1.reg=9; //v0.xyzw for unused src
+				sRegs.src1.num=0;
+				sRegs.src1.mod=0;
+				sRegs.src1.swz=0x1b;
+				sRegs.src1.idx=0;	
+				if (pb_set_mcode(p,&sRegs)) { debugPrint("pb_pcode2mcode(log): Unrecognized token\n"); return NULL; }
+				*(p+1)|=NV20_VP_INST_OPCODE_ADD<<NV20_VP_INST_VEC_OPCODE_SHIFT;
+				p+=4;
+				//mov ri.w, C-3.w
+				pb_push(p++,NV20_TCL_PRIMITIVE_3D_VP_UPLOAD_INST0,4); n++; if (n==136) { debugPrint("pb_pcode2mcode(log): Too many instructions: max=136 (including expanded macros)\n"); return NULL; }
+				sRegs.n=2;
+				sRegs.dest.msk=1; //.w
+				sRegs.src0.reg=0xa; //c
+				sRegs.src0.num=-3;
+				sRegs.src0.swz=0xff; //.wwww
+				sRegs.src0.mod=0;
+				if (pb_set_mcode(p,&sRegs)) { debugPrint("pb_pcode2mcode(log): Unrecognized token\n"); return NULL; }
+				*(p+1)|=NV20_VP_INST_OPCODE_MOV<<NV20_VP_INST_VEC_OPCODE_SHIFT;
+				p+=4;
+				//mad ri.w, ri.w, ri.x, C-3.z (next=x*(previous+constant))
+				pb_push(p++,NV20_TCL_PRIMITIVE_3D_VP_UPLOAD_INST0,4); n++; if (n==136) { debugPrint("pb_pcode2mcode(log): Too many instructions: max=136 (including expanded macros)\n"); return NULL; }
+				sRegs.n=4;
+				sRegs.src0.reg=8; //r
+				sRegs.src0.num=i;
+				sRegs.src1.reg=8; //r
+				sRegs.src1.num=i;
+				sRegs.src1.swz=0; //.xxxx
+				sRegs.src1.mod=0;
+				sRegs.src2.reg=0xa; //c
+				sRegs.src2.num=-3;
+				sRegs.src2.swz=0xaa; //.zzzz
+				sRegs.src2.mod=0;
+				sRegs.src2.idx=0;
+				if (pb_set_mcode(p,&sRegs)) { debugPrint("pb_pcode2mcode(log): Unrecognized token\n"); return NULL; }
+				*(p+1)|=NV20_VP_INST_OPCODE_MAD<<NV20_VP_INST_VEC_OPCODE_SHIFT;
+				p+=4;
+				//mad ri.w, ri.w, ri.x, C-3.y
+				pb_push(p++,NV20_TCL_PRIMITIVE_3D_VP_UPLOAD_INST0,4); n++; if (n==136) { debugPrint("pb_pcode2mcode(log): Too many instructions: max=136 (including expanded macros)\n"); return NULL; }
+				sRegs.src2.swz=0x55; //.yyyy
+				if (pb_set_mcode(p,&sRegs)) { debugPrint("pb_pcode2mcode(log): Unrecognized token\n"); return NULL; }
+				*(p+1)|=NV20_VP_INST_OPCODE_MAD<<NV20_VP_INST_VEC_OPCODE_SHIFT;
+				p+=4;
+				//mad ri.w, ri.w, ri.x, C-3.x
+				pb_push(p++,NV20_TCL_PRIMITIVE_3D_VP_UPLOAD_INST0,4); n++; if (n==136) { debugPrint("pb_pcode2mcode(log): Too many instructions: max=136 (including expanded macros)\n"); return NULL; }
+				sRegs.src2.swz=0; //.xxxx
+				if (pb_set_mcode(p,&sRegs)) { debugPrint("pb_pcode2mcode(log): Unrecognized token\n"); return NULL; }
+				*(p+1)|=NV20_VP_INST_OPCODE_MAD<<NV20_VP_INST_VEC_OPCODE_SHIFT;
+				p+=4;
+				//mad ri.w, ri.w, ri.x, C-4.w
+				pb_push(p++,NV20_TCL_PRIMITIVE_3D_VP_UPLOAD_INST0,4); n++; if (n==136) { debugPrint("pb_pcode2mcode(log): Too many instructions: max=136 (including expanded macros)\n"); return NULL; }
+				sRegs.src2.num=-4;
+				sRegs.src2.swz=0xff; //.wwww
+				if (pb_set_mcode(p,&sRegs)) { debugPrint("pb_pcode2mcode(log): Unrecognized token\n"); return NULL; }
+				*(p+1)|=NV20_VP_INST_OPCODE_MAD<<NV20_VP_INST_VEC_OPCODE_SHIFT;
+				p+=4;
+				//mad ri.w, ri.w, ri.x, C-4.z
+				pb_push(p++,NV20_TCL_PRIMITIVE_3D_VP_UPLOAD_INST0,4); n++; if (n==136) { debugPrint("pb_pcode2mcode(log): Too many instructions: max=136 (including expanded macros)\n"); return NULL; }
+				sRegs.src2.swz=0xaa; //.zzzz
+				if (pb_set_mcode(p,&sRegs)) { debugPrint("pb_pcode2mcode(log): Unrecognized token\n"); return NULL; }
+				*(p+1)|=NV20_VP_INST_OPCODE_MAD<<NV20_VP_INST_VEC_OPCODE_SHIFT;
+				p+=4;
+				//mad ri.w, ri.w, ri.x, C-4.y
+				pb_push(p++,NV20_TCL_PRIMITIVE_3D_VP_UPLOAD_INST0,4); n++; if (n==136) { debugPrint("pb_pcode2mcode(log): Too many instructions: max=136 (including expanded macros)\n"); return NULL; }
+				sRegs.src2.swz=0x55; //.yyyy
+				if (pb_set_mcode(p,&sRegs)) { debugPrint("pb_pcode2mcode(log): Unrecognized token\n"); return NULL; }
+				*(p+1)|=NV20_VP_INST_OPCODE_MAD<<NV20_VP_INST_VEC_OPCODE_SHIFT;
+				p+=4;
+				//mad ri.w, ri.w, ri.x, C-4.x
+				pb_push(p++,NV20_TCL_PRIMITIVE_3D_VP_UPLOAD_INST0,4); n++; if (n==136) { debugPrint("pb_pcode2mcode(log): Too many instructions: max=136 (including expanded macros)\n"); return NULL; }
+				sRegs.src2.swz=0; //.xxxx
+				if (pb_set_mcode(p,&sRegs)) { debugPrint("pb_pcode2mcode(log): Unrecognized token\n"); return NULL; }
+				*(p+1)|=NV20_VP_INST_OPCODE_MAD<<NV20_VP_INST_VEC_OPCODE_SHIFT;
+				p+=4;
+				//mad dest, ri.w, ri.x, ri.y
+				pb_push(p++,NV20_TCL_PRIMITIVE_3D_VP_UPLOAD_INST0,4); n++; if (n==136) { debugPrint("pb_pcode2mcode(log): Too many instructions: max=136 (including expanded macros)\n"); return NULL; }
+				pb_read_pregs(pcode,&sRegs,2); pcode+=2; //read dest again and preserve it
+				sRegs.n=4;
+				sRegs.src0.reg=8; //r
+				sRegs.src0.num=i;
+				sRegs.src0.swz=0xff; //.wwww
+				sRegs.src0.mod=0;
+				sRegs.src0.idx=0;
+				//pb_read_pregs shouldn't have changed src1
+				sRegs.src2.reg=8; //r
+				sRegs.src2.num=i;
+				sRegs.src2.swz=0x55; //.yyyy
+				if (pb_set_mcode(p,&sRegs)) { debugPrint("pb_pcode2mcode(log): Unrecognized token\n"); return NULL; }
+				*(p+1)|=NV20_VP_INST_OPCODE_MAD<<NV20_VP_INST_VEC_OPCODE_SHIFT;
+				p+=4;
+				break;
+
+			case 0x00000010: //lit dest,src0 (scalar lighting calculation function)
+			case 0x40000010: //+lit
+				pb_push(p++,NV20_TCL_PRIMITIVE_3D_VP_UPLOAD_INST0,4); n++;
+				pb_read_pregs(pcode,&sRegs,2); pcode+=2;
+				//src2 is used instead of src0 in scalar functions
+				sRegs.n=4;
+				sRegs.src2=sRegs.src0;
+				sRegs.src0.reg=9; //v0.xyzw for unused src
+				sRegs.src0.num=0;
+				sRegs.src0.mod=0;
+				sRegs.src0.swz=0x1b;
+				sRegs.src0.idx=0;
+				sRegs.src1.reg=9; //v0.xyzw for unused src
+				sRegs.src1.num=0;
+				sRegs.src1.mod=0;
+				sRegs.src1.swz=0x1b;
+				sRegs.src1.idx=0;
+				if (pb_set_mcode(p,&sRegs)) { debugPrint("pb_pcode2mcode: Unrecognized token\n"); return NULL; }
+				*(p+1)|=NV20_VP_INST_OPCODE_LIT<<NV20_VP_INST_SCA_OPCODE_SHIFT;
+				if (sRegs.dest.reg!=8) //not r
+					*(p+3)|=NV20_VP_INST_DEST_SCA; //warns GPU that destination will receive scalar function result
+				else
+				{
+					//scalar temp dest mask=temp dest mask & temp dest mask=0
+					*(p+3)|=((*(p+3))&NV20_VP_INST_VTEMP_WRITEMASK_MASK)>>(NV20_VP_INST_VTEMP_WRITEMASK_SHIFT-NV20_VP_INST_STEMP_WRITEMASK_SHIFT);
+					*(p+3)&=~NV20_VP_INST_VTEMP_WRITEMASK_MASK;
+				}			
+				p+=4;
+				break;
+
+			case 0x00000011: //dst dest,src0,src1 (calculates distance)
+			case 0x40000011: //+dst
+				pb_push(p++,NV20_TCL_PRIMITIVE_3D_VP_UPLOAD_INST0,4); n++;
+				pb_read_pregs(pcode,&sRegs,3); pcode+=3;
+				if (pb_set_mcode(p,&sRegs)) { debugPrint("pb_pcode2mcode: Unrecognized token\n"); return NULL; }
+				*(p+1)|=NV20_VP_INST_OPCODE_DST<<NV20_VP_INST_VEC_OPCODE_SHIFT;
+				p+=4;
+				break;
+
+			case 0x00000012: //frc dest,src0 (calculates fractional part -let's consider it same as expp for now-)
+			case 0x40000012: //+frc
+			case 0x00000013: //frc dest,src0 (calculates fractional part -let's consider it same as expp for now-)
+			case 0x40000013: //+frc
+				pb_push(p++,NV20_TCL_PRIMITIVE_3D_VP_UPLOAD_INST0,4); n++;
+				pb_read_pregs(pcode,&sRegs,2); pcode+=2;
+				//src2 is used instead of src0 in scalar functions
+				sRegs.n=4;
+				sRegs.src2=sRegs.src0;
+				sRegs.src0.reg=9; //v0.xyzw for unused src
+				sRegs.src0.num=0;
+				sRegs.src0.mod=0;
+				sRegs.src0.swz=0x1b;
+				sRegs.src0.idx=0;
+				sRegs.src1.reg=9; //v0.xyzw for unused src
+				sRegs.src1.num=0;
+				sRegs.src1.mod=0;
+				sRegs.src1.swz=0x1b;
+				sRegs.src1.idx=0;
+				if (pb_set_mcode(p,&sRegs)) { debugPrint("pb_pcode2mcode: Unrecognized token\n"); return NULL; }
+				*(p+1)|=NV20_VP_INST_OPCODE_EXP<<NV20_VP_INST_SCA_OPCODE_SHIFT;
+				if (sRegs.dest.reg!=8) //not r
+					*(p+3)|=NV20_VP_INST_DEST_SCA; //warns GPU that destination will receive scalar function result
+				else
+				{
+					//scalar temp dest mask=temp dest mask & temp dest mask=0
+					*(p+3)|=((*(p+3))&NV20_VP_INST_VTEMP_WRITEMASK_MASK)>>(NV20_VP_INST_VTEMP_WRITEMASK_SHIFT-NV20_VP_INST_STEMP_WRITEMASK_SHIFT);
+					*(p+3)&=~NV20_VP_INST_VTEMP_WRITEMASK_MASK;
+				}
+				p+=4;
+				break;
+
+			case 0x00000014: //m4x4 dest, src0, ?i (matrix multiply)
+			case 0x40000014: //+m4x4
+				//dp4 dest.x, src0, ?i
+				pb_push(p++,NV20_TCL_PRIMITIVE_3D_VP_UPLOAD_INST0,4); n++; if (n==136) { debugPrint("pb_pcode2mcode(m4x4): Too many instructions: max=136 (including expanded macros)\n"); return NULL; }
+				pb_read_pregs(pcode,&sRegs,3); pcode+=3;
+				if (	(sRegs.src0.swz!=0x1b)||
+					(sRegs.src1.swz!=0x1b)||
+					(sRegs.src0.mod)||
+					(sRegs.src1.mod)	) { debugPrint("pb_pcode2mcode: Modifiers or swizles not allowed in matrices multiplication macros\n"); return NULL; }
+				sRegs.dest.msk=8; //.x
+				if (pb_set_mcode(p,&sRegs)) { debugPrint("pb_pcode2mcode: Unrecognized token\n"); return NULL; }
+				*(p+1)|=NV20_VP_INST_OPCODE_DP4<<NV20_VP_INST_VEC_OPCODE_SHIFT;
+				p+=4;
+				//dp4 dest.y, src0, ?i+1
+				pb_push(p++,NV20_TCL_PRIMITIVE_3D_VP_UPLOAD_INST0,4); n++; if (n==136) { debugPrint("pb_pcode2mcode(m4x4): Too many instructions: max=136 (including expanded macros)\n"); return NULL; }
+				sRegs.dest.msk=4; //.y				
+				if (sRegs.src1.reg==0xc) sRegs.src1.num=(sRegs.src1.num+1)%96; else sRegs.src1.num=(sRegs.src1.num+1)%16;
+				if (pb_set_mcode(p,&sRegs)) { debugPrint("pb_pcode2mcode: Unrecognized token\n"); return NULL; }
+				*(p+1)|=NV20_VP_INST_OPCODE_DP4<<NV20_VP_INST_VEC_OPCODE_SHIFT;
+				p+=4;
+				//dp4 dest.z, src0, ?i+2
+				pb_push(p++,NV20_TCL_PRIMITIVE_3D_VP_UPLOAD_INST0,4); n++; if (n==136) { debugPrint("pb_pcode2mcode(m4x4): Too many instructions: max=136 (including expanded macros)\n"); return NULL; }
+				sRegs.dest.msk=2; //.z
+				if (sRegs.src1.reg==0xc) sRegs.src1.num=(sRegs.src1.num+1)%96; else sRegs.src1.num=(sRegs.src1.num+1)%16;
+				if (pb_set_mcode(p,&sRegs)) { debugPrint("pb_pcode2mcode: Unrecognized token\n"); return NULL; }
+				*(p+1)|=NV20_VP_INST_OPCODE_DP4<<NV20_VP_INST_VEC_OPCODE_SHIFT;
+				p+=4;
+				//dp4 dest.w, src0, ?i+3
+				pb_push(p++,NV20_TCL_PRIMITIVE_3D_VP_UPLOAD_INST0,4); n++; if (n==136) { debugPrint("pb_pcode2mcode(m4x4): Too many instructions: max=136 (including expanded macros)\n"); return NULL; }
+				sRegs.dest.msk=1; //.w
+				if (sRegs.src1.reg==0xc) sRegs.src1.num=(sRegs.src1.num+1)%96; else sRegs.src1.num=(sRegs.src1.num+1)%16;
+				if (pb_set_mcode(p,&sRegs)) { debugPrint("pb_pcode2mcode: Unrecognized token\n"); return NULL; }
+				*(p+1)|=NV20_VP_INST_OPCODE_DP4<<NV20_VP_INST_VEC_OPCODE_SHIFT;
+				p+=4;
+				break;
+				
+			case 0x00000015: //m4x3 dest, src0, ?i (matrix multiply)
+			case 0x40000015: //+m4x3
+				//dp4 dest.x, src0, ?i
+				pb_push(p++,NV20_TCL_PRIMITIVE_3D_VP_UPLOAD_INST0,4); n++; if (n==136) { debugPrint("pb_pcode2mcode(m4x3): Too many instructions: max=136 (including expanded macros)\n"); return NULL; }
+				pb_read_pregs(pcode,&sRegs,3); pcode+=3;
+				if (	(sRegs.src0.swz!=0x1b)||
+					(sRegs.src1.swz!=0x1b)||
+					(sRegs.src0.mod)||
+					(sRegs.src1.mod)	) { debugPrint("pb_pcode2mcode: Modifiers or swizles not allowed in matrices multiplication macros\n"); return NULL; }
+				sRegs.dest.msk=8; //.x
+				if (pb_set_mcode(p,&sRegs)) { debugPrint("pb_pcode2mcode: Unrecognized token\n"); return NULL; }
+				*(p+1)|=NV20_VP_INST_OPCODE_DP4<<NV20_VP_INST_VEC_OPCODE_SHIFT;
+				p+=4;
+				//dp4 dest.y, src0, ?i+1
+				pb_push(p++,NV20_TCL_PRIMITIVE_3D_VP_UPLOAD_INST0,4); n++; if (n==136) { debugPrint("pb_pcode2mcode(m4x3): Too many instructions: max=136 (including expanded macros)\n"); return NULL; }
+				sRegs.dest.msk=4; //.y				
+				if (sRegs.src1.reg==0xc) sRegs.src1.num=(sRegs.src1.num+1)%96; else sRegs.src1.num=(sRegs.src1.num+1)%16;
+				if (pb_set_mcode(p,&sRegs)) { debugPrint("pb_pcode2mcode: Unrecognized token\n"); return NULL; }
+				*(p+1)|=NV20_VP_INST_OPCODE_DP4<<NV20_VP_INST_VEC_OPCODE_SHIFT;
+				p+=4;
+				//dp4 dest.z, src0, ?i+2
+				pb_push(p++,NV20_TCL_PRIMITIVE_3D_VP_UPLOAD_INST0,4); n++; if (n==136) { debugPrint("pb_pcode2mcode(m4x3): Too many instructions: max=136 (including expanded macros)\n"); return NULL; }
+				sRegs.dest.msk=2; //.z
+				if (sRegs.src1.reg==0xc) sRegs.src1.num=(sRegs.src1.num+1)%96; else sRegs.src1.num=(sRegs.src1.num+1)%16;
+				if (pb_set_mcode(p,&sRegs)) { debugPrint("pb_pcode2mcode: Unrecognized token\n"); return NULL; }
+				*(p+1)|=NV20_VP_INST_OPCODE_DP4<<NV20_VP_INST_VEC_OPCODE_SHIFT;
+				p+=4;
+				break;
+
+			case 0x00000016: //m3x4 dest, src0, ?i (matrix multiply)
+			case 0x40000016: //+m3x4
+				//dp3 dest.x, src0, ?i
+				pb_push(p++,NV20_TCL_PRIMITIVE_3D_VP_UPLOAD_INST0,4); n++; if (n==136) { debugPrint("pb_pcode2mcode(m3x4): Too many instructions: max=136 (including expanded macros)\n"); return NULL; }
+				pb_read_pregs(pcode,&sRegs,3); pcode+=3;
+				if (	(sRegs.src0.swz!=0x1b)||
+					(sRegs.src1.swz!=0x1b)||
+					(sRegs.src0.mod)||
+					(sRegs.src1.mod)	) { debugPrint("pb_pcode2mcode: Modifiers or swizles not allowed in matrices multiplication macros\n"); return NULL; }
+				sRegs.dest.msk=8; //.x
+				if (pb_set_mcode(p,&sRegs)) { debugPrint("pb_pcode2mcode: Unrecognized token\n"); return NULL; }
+				*(p+1)|=NV20_VP_INST_OPCODE_DP3<<NV20_VP_INST_VEC_OPCODE_SHIFT;
+				p+=4;
+				//dp3 dest.y, src0, ?i+1
+				pb_push(p++,NV20_TCL_PRIMITIVE_3D_VP_UPLOAD_INST0,4); n++; if (n==136) { debugPrint("pb_pcode2mcode(m3x4): Too many instructions: max=136 (including expanded macros)\n"); return NULL; }
+				sRegs.dest.msk=4; //.y				
+				if (sRegs.src1.reg==0xc) sRegs.src1.num=(sRegs.src1.num+1)%96; else sRegs.src1.num=(sRegs.src1.num+1)%16;
+				if (pb_set_mcode(p,&sRegs)) { debugPrint("pb_pcode2mcode: Unrecognized token\n"); return NULL; }
+				*(p+1)|=NV20_VP_INST_OPCODE_DP3<<NV20_VP_INST_VEC_OPCODE_SHIFT;
+				p+=4;
+				//dp3 dest.z, src0, ?i+2
+				pb_push(p++,NV20_TCL_PRIMITIVE_3D_VP_UPLOAD_INST0,4); n++; if (n==136) { debugPrint("pb_pcode2mcode(m3x4): Too many instructions: max=136 (including expanded macros)\n"); return NULL; }
+				sRegs.dest.msk=2; //.z
+				if (sRegs.src1.reg==0xc) sRegs.src1.num=(sRegs.src1.num+1)%96; else sRegs.src1.num=(sRegs.src1.num+1)%16;
+				if (pb_set_mcode(p,&sRegs)) { debugPrint("pb_pcode2mcode: Unrecognized token\n"); return NULL; }
+				*(p+1)|=NV20_VP_INST_OPCODE_DP3<<NV20_VP_INST_VEC_OPCODE_SHIFT;
+				p+=4;
+				//dp3 dest.w, src0, ?i+3
+				pb_push(p++,NV20_TCL_PRIMITIVE_3D_VP_UPLOAD_INST0,4); n++; if (n==136) { debugPrint("pb_pcode2mcode(m3x4): Too many instructions: max=136 (including expanded macros)\n"); return NULL; }
+				sRegs.dest.msk=1; //.w
+				if (sRegs.src1.reg==0xc) sRegs.src1.num=(sRegs.src1.num+1)%96; else sRegs.src1.num=(sRegs.src1.num+1)%16;
+				if (pb_set_mcode(p,&sRegs)) { debugPrint("pb_pcode2mcode: Unrecognized token\n"); return NULL; }
+				*(p+1)|=NV20_VP_INST_OPCODE_DP3<<NV20_VP_INST_VEC_OPCODE_SHIFT;
+				p+=4;
+				break;
+
+			case 0x00000017: //m3x3 dest, src0, ?i (matrix multiply)
+			case 0x40000017: //+m3x3
+				//dp3 dest.x, src0, ?i
+				pb_push(p++,NV20_TCL_PRIMITIVE_3D_VP_UPLOAD_INST0,4); n++; if (n==136) { debugPrint("pb_pcode2mcode(m3x3): Too many instructions: max=136 (including expanded macros)\n"); return NULL; }
+				pb_read_pregs(pcode,&sRegs,3); pcode+=3;
+				if (	(sRegs.src0.swz!=0x1b)||
+					(sRegs.src1.swz!=0x1b)||
+					(sRegs.src0.mod)||
+					(sRegs.src1.mod)	) { debugPrint("pb_pcode2mcode: Modifiers or swizles not allowed in matrices multiplication macros\n"); return NULL; }
+				sRegs.dest.msk=8; //.x
+				if (pb_set_mcode(p,&sRegs)) { debugPrint("pb_pcode2mcode: Unrecognized token\n"); return NULL; }
+				*(p+1)|=NV20_VP_INST_OPCODE_DP3<<NV20_VP_INST_VEC_OPCODE_SHIFT;
+				p+=4;
+				//dp3 dest.y, src0, ?i+1
+				pb_push(p++,NV20_TCL_PRIMITIVE_3D_VP_UPLOAD_INST0,4); n++; if (n==136) { debugPrint("pb_pcode2mcode(m3x3): Too many instructions: max=136 (including expanded macros)\n"); return NULL; }
+				sRegs.dest.msk=4; //.y				
+				if (sRegs.src1.reg==0xc) sRegs.src1.num=(sRegs.src1.num+1)%96; else sRegs.src1.num=(sRegs.src1.num+1)%16;
+				if (pb_set_mcode(p,&sRegs)) { debugPrint("pb_pcode2mcode: Unrecognized token\n"); return NULL; }
+				*(p+1)|=NV20_VP_INST_OPCODE_DP3<<NV20_VP_INST_VEC_OPCODE_SHIFT;
+				p+=4;
+				//dp3 dest.z, src0, ?i+2
+				pb_push(p++,NV20_TCL_PRIMITIVE_3D_VP_UPLOAD_INST0,4); n++; if (n==136) { debugPrint("pb_pcode2mcode(m3x3): Too many instructions: max=136 (including expanded macros)\n"); return NULL; }
+				sRegs.dest.msk=2; //.z
+				if (sRegs.src1.reg==0xc) sRegs.src1.num=(sRegs.src1.num+1)%96; else sRegs.src1.num=(sRegs.src1.num+1)%16;
+				if (pb_set_mcode(p,&sRegs)) { debugPrint("pb_pcode2mcode: Unrecognized token\n"); return NULL; }
+				*(p+1)|=NV20_VP_INST_OPCODE_DP3<<NV20_VP_INST_VEC_OPCODE_SHIFT;
+				p+=4;
+				break;
+
+			case 0x00000018: //m3x2 dest, src0, ?i (matrix multiply)
+			case 0x40000018: //+m3x2
+				//dp3 dest.x, src0, ?i
+				pb_push(p++,NV20_TCL_PRIMITIVE_3D_VP_UPLOAD_INST0,4); n++; if (n==136) { debugPrint("pb_pcode2mcode(m3x2): Too many instructions: max=136 (including expanded macros)\n"); return NULL; }
+				pb_read_pregs(pcode,&sRegs,3); pcode+=3;
+				if (	(sRegs.src0.swz!=0x1b)||
+					(sRegs.src1.swz!=0x1b)||
+					(sRegs.src0.mod)||
+					(sRegs.src1.mod)	) { debugPrint("pb_pcode2mcode: Modifiers or swizles not allowed in matrices multiplication macros\n"); return NULL; }
+				sRegs.dest.msk=8; //.x
+				if (pb_set_mcode(p,&sRegs)) { debugPrint("pb_pcode2mcode: Unrecognized token\n"); return NULL; }
+				*(p+1)|=NV20_VP_INST_OPCODE_DP3<<NV20_VP_INST_VEC_OPCODE_SHIFT;
+				p+=4;
+				//dp3 dest.y, src0, ?i+1
+				pb_push(p++,NV20_TCL_PRIMITIVE_3D_VP_UPLOAD_INST0,4); n++; if (n==136) { debugPrint("pb_pcode2mcode(m3x2): Too many instructions: max=136 (including expanded macros)\n"); return NULL; }
+				sRegs.dest.msk=4; //.y				
+				if (sRegs.src1.reg==0xc) sRegs.src1.num=(sRegs.src1.num+1)%96; else sRegs.src1.num=(sRegs.src1.num+1)%16;
+				if (pb_set_mcode(p,&sRegs)) { debugPrint("pb_pcode2mcode: Unrecognized token\n"); return NULL; }
+				*(p+1)|=NV20_VP_INST_OPCODE_DP3<<NV20_VP_INST_VEC_OPCODE_SHIFT;
+				p+=4;
+				break;
+
+			case 0x0000004e: //expp dest,src0 (scalar partial precision exponential function)
+			case 0x4000004e: //+expp
+				pb_push(p++,NV20_TCL_PRIMITIVE_3D_VP_UPLOAD_INST0,4); n++;
+				pb_read_pregs(pcode,&sRegs,2); pcode+=2;
+				//src2 is used instead of src0 in scalar functions
+				sRegs.n=4;
+				sRegs.src2=sRegs.src0;
+				sRegs.src0.reg=9; //v0.xyzw for unused src
+				sRegs.src0.num=0;
+				sRegs.src0.mod=0;
+				sRegs.src0.swz=0x1b;
+				sRegs.src0.idx=0;
+				sRegs.src1.reg=9; //v0.xyzw for unused src
+				sRegs.src1.num=0;
+				sRegs.src1.mod=0;
+				sRegs.src1.swz=0x1b;
+				sRegs.src1.idx=0;
+				if (pb_set_mcode(p,&sRegs)) { debugPrint("pb_pcode2mcode: Unrecognized token\n"); return NULL; }
+				*(p+1)|=NV20_VP_INST_OPCODE_EXP<<NV20_VP_INST_SCA_OPCODE_SHIFT;
+				if (sRegs.dest.reg!=8) //not r
+					*(p+3)|=NV20_VP_INST_DEST_SCA; //warns GPU that destination will receive scalar function result
+				else
+				{
+					//scalar temp dest mask=temp dest mask & temp dest mask=0
+					*(p+3)|=((*(p+3))&NV20_VP_INST_VTEMP_WRITEMASK_MASK)>>(NV20_VP_INST_VTEMP_WRITEMASK_SHIFT-NV20_VP_INST_STEMP_WRITEMASK_SHIFT);
+					*(p+3)&=~NV20_VP_INST_VTEMP_WRITEMASK_MASK;
+				}
+				p+=4;
+				break;
+
+			case 0x0000004f: //logp dest,src0 (scalar partial precision logarithm function)
+			case 0x4000004f: //+logp
+				pb_push(p++,NV20_TCL_PRIMITIVE_3D_VP_UPLOAD_INST0,4); n++;
+				pb_read_pregs(pcode,&sRegs,2); pcode+=2;
+				//src2 is used instead of src0 in scalar functions
+				sRegs.n=4;
+				sRegs.src2=sRegs.src0;
+				sRegs.src0.reg=9; //v0.xyzw for unused src
+				sRegs.src0.num=0;
+				sRegs.src0.mod=0;
+				sRegs.src0.swz=0x1b;
+				sRegs.src0.idx=0;
+				sRegs.src1.reg=9; //v0.xyzw for unused src
+				sRegs.src1.num=0;
+				sRegs.src1.mod=0;
+				sRegs.src1.swz=0x1b;
+				sRegs.src1.idx=0;
+				if (pb_set_mcode(p,&sRegs)) { debugPrint("pb_pcode2mcode: Unrecognized token\n"); return NULL; }
+				*(p+1)|=NV20_VP_INST_OPCODE_LOG<<NV20_VP_INST_SCA_OPCODE_SHIFT;
+				if (sRegs.dest.reg!=8) //not r
+					*(p+3)|=NV20_VP_INST_DEST_SCA; //warns GPU that destination will receive scalar function result
+				else
+				{
+					//scalar temp dest mask=temp dest mask & temp dest mask=0
+					*(p+3)|=((*(p+3))&NV20_VP_INST_VTEMP_WRITEMASK_MASK)>>(NV20_VP_INST_VTEMP_WRITEMASK_SHIFT-NV20_VP_INST_STEMP_WRITEMASK_SHIFT);
+					*(p+3)&=~NV20_VP_INST_VTEMP_WRITEMASK_MASK;
+				}
+				p+=4;
+				break;
+
+			case 0x00000051: //def cn x, y, z, w or def cn r, g, b, a
+				pb_push(p++,NV20_TCL_PRIMITIVE_3D_VP_UPLOAD_CONST_ID,1); *(p++)=((*(pcode++))&0xff)+96; //set cursor in order to load data into Cn
+				pb_push(p++,NV20_TCL_PRIMITIVE_3D_VP_UPLOAD_CONST_X,4); *(p++)=*(pcode++); *(p++)=*(pcode++); *(p++)=*(pcode++); *(p++)=*(pcode++);
+				break;
+
+			//non standard pseudo-code: nvidia-specific (vsa.exe won't accept these assembler instructions)
+			//workaround : use dp4 and rcp, then, in pseudo code, replace 9 with 0x100 and 6 with 0x101
+
+			case 0x00000100: //dph dest,src0,src1 (homogeneous dot product: same as dp4 but src0.w is seen as 1.0f)
+			case 0x40000100: //+dph
+				pb_push(p++,NV20_TCL_PRIMITIVE_3D_VP_UPLOAD_INST0,4); n++;
+				pb_read_pregs(pcode,&sRegs,3); pcode+=3;
+				if (pb_set_mcode(p,&sRegs)) { debugPrint("pb_pcode2mcode: Unrecognized token\n"); return NULL; }
+				*(p+1)|=NV20_VP_INST_OPCODE_DPH<<NV20_VP_INST_VEC_OPCODE_SHIFT;
+				p+=4;
+				break;
+
+			case 0x00000101: //rcc dest,src0 (clamped scalar 1/x function)
+			case 0x40000101: //+rcc
+				pb_push(p++,NV20_TCL_PRIMITIVE_3D_VP_UPLOAD_INST0,4); n++;
+				pb_read_pregs(pcode,&sRegs,2); pcode+=2;
+				//src2 is used instead of src0 in scalar functions
+				sRegs.n=4;
+				sRegs.src2=sRegs.src0;
+				sRegs.src0.reg=9; //v0.xyzw for unused src
+				sRegs.src0.num=0;
+				sRegs.src0.mod=0;
+				sRegs.src0.swz=0x1b;
+				sRegs.src0.idx=0;
+				sRegs.src1.reg=9; //v0.xyzw for unused src
+				sRegs.src1.num=0;
+				sRegs.src1.mod=0;
+				sRegs.src1.swz=0x1b;
+				sRegs.src1.idx=0;
+				if (pb_set_mcode(p,&sRegs)) { debugPrint("pb_pcode2mcode: Unrecognized token\n"); return NULL; }
+				*(p+1)|=NV20_VP_INST_OPCODE_RCC<<NV20_VP_INST_SCA_OPCODE_SHIFT;
+				if (sRegs.dest.reg!=8) //not r
+					*(p+3)|=NV20_VP_INST_DEST_SCA; //warns GPU that destination will receive scalar function result
+				else
+				{
+					//scalar temp dest mask=temp dest mask & temp dest mask=0
+					*(p+3)|=((*(p+3))&NV20_VP_INST_VTEMP_WRITEMASK_MASK)>>(NV20_VP_INST_VTEMP_WRITEMASK_SHIFT-NV20_VP_INST_STEMP_WRITEMASK_SHIFT);
+					*(p+3)&=~NV20_VP_INST_VTEMP_WRITEMASK_MASK;
+				}
+				p+=4;
+				break;
+				
+			default:
+				debugPrint("pb_pcode2mcode: Unrecognized vs token #%08x\n",*(pcode-1));
+				return NULL;	
+		}
+	}
+
+	*(p-1)|=NV20_VP_INST_LAST_INST; //bit 0 of 4th dword means end of shader
+
+	pb_gpu_programnc[0]=p-&pb_gpu_programnc[1]; //size
+	pb_gpu_programnc[0]|=0x43210000; //personal vs marker
+	return &pb_gpu_programnc[0];
+}
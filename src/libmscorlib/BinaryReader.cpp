@@ -41,21 +41,39 @@ namespace System
 	{
 		Stream* BinaryReader::BaseStream()
 		{
+			int unread = m_readEnd - m_readPosition;
+
+			if (m_stream != null && unread > 0 && m_stream->CanSeek())
+			{
+				m_stream->Seek(-unread, SeekOrigin::Current);
+				m_readPosition = m_readEnd = null;
+			}
+
 			return m_stream;
 		}
 
 		BinaryReader::BinaryReader(Stream * const input)
+			: m_stream(input), m_spanBuffer(null), m_spanBufferSize(0)
 		{
 			sassert(input->CanRead(), FrameworkResources::NotSupported_UnreadableStream);
 
-			m_disposed = false;
-			m_stream = input;
-			m_buffer = new byte[32];
+			InitReadAhead(DefaultReadAheadSize);
+		}
+
+		BinaryReader::BinaryReader(Stream * const input, const int readAheadSize)
+			: m_stream(input), m_spanBuffer(null), m_spanBufferSize(0)
+		{
+			sassert(input->CanRead(), FrameworkResources::NotSupported_UnreadableStream);
+
+			sassert(readAheadSize >= MinReadAheadSize && readAheadSize <= MaxReadAheadSize, String::Format("%s; %s", String::Format(FrameworkResources::Arg_ParamName_Name, "readAheadSize"), FrameworkResources::ArgumentOutOfRange_NeedPosNum));
+
+			InitReadAhead(readAheadSize);
 		}
 
 		BinaryReader::BinaryReader(FILE * const file)
-			: m_stream(new FileStream(file))
+			: m_stream(new FileStream(file)), m_spanBuffer(null), m_spanBufferSize(0)
 		{
+			InitReadAhead(DefaultReadAheadSize);
 		}
 
 		BinaryReader::~BinaryReader()
@@ -78,40 +96,125 @@ namespace System
 			m_stream->Close();
 
 			m_disposed = true;
-			delete m_buffer;
+			delete[] m_buffer;
 			m_buffer = null;
 			m_stream->Close();
 			m_stream = null;
 			delete[] m_charBuffer;
 			m_charBuffer = null;
+			delete[] m_spanBuffer;
+			m_spanBuffer = null;
+			m_spanBufferSize = 0;
+			delete[] m_readAhead;
+			m_readAhead = null;
+			m_readPosition = m_readEnd = null;
 		}
 
 		void BinaryReader::FillBuffer(int numBytes)
 		{
 			sassert(!m_disposed, "Cannot read from a closed BinaryReader.");
-			
-			int offset = 0;
-			int num2 = 0;
-			if (numBytes == 1)
-			{
-				num2 = m_stream->ReadByte();
 
-				sassert(!(num2 == -1), "Attempted to read beyond End Of File.");
+			sassert(numBytes >= 0 && numBytes <= 32, String::Format("numBytes; %s", FrameworkResources::ArgumentOutOfRange_NeedNonNegNum));
 
-				m_buffer[0] = (byte)num2;
+			const byte* data = Take(numBytes);
+
+			if (data != m_buffer)
+			{
+				memcpy(m_buffer, data, numBytes);
 			}
-			else
+		}
+
+		void BinaryReader::InitReadAhead(const int readAheadSize)
+		{
+			m_disposed = false;
+			m_buffer = new byte[32];
+			m_charBuffer = null;
+			m_readAhead = null;
+			m_readAheadSize = readAheadSize;
+			m_readPosition = m_readEnd = null;
+
+			// memory backed streams return an empty span instead of null
+			m_isMemoryStream = (m_stream->InternalReadSpan(0) != null);
+		}
+
+		bool BinaryReader::RefillReadAhead(const int count)
+		{
+			int unread = m_readEnd - m_readPosition;
+
+			if (m_isMemoryStream)
 			{
-				do
+				// Take everything that is left at once. Unread bytes are given back first, so the new span covers them too;
+				// this also picks up data written to the stream since the last refill.
+				if (unread > 0)
 				{
-					num2 = m_stream->Read(m_buffer, offset, numBytes - offset);
+					m_stream->Seek(-unread, SeekOrigin::Current);
+				}
 
-					sassert(!(num2 == 0), "Attempted to read beyond End Of File.");
+				long long remaining = m_stream->Length() - m_stream->Seek(0, SeekOrigin::Current);
 
-					offset += num2;
+				if (remaining > 0x7FFFFFFF)
+				{
+					remaining = 0x7FFFFFFF;
 				}
-				while (offset < numBytes);
+
+				const byte* span = (remaining > 0) ? m_stream->InternalReadSpan((int)remaining) : null;
+
+				if (span == null)
+				{
+					m_readPosition = m_readEnd = null;
+					return false;
+				}
+
+				m_readPosition = span;
+				m_readEnd = span + (int)remaining;
+				return (remaining >= count);
+			}
+
+			if (m_readAhead == null)
+			{
+				m_readAhead = new byte[m_readAheadSize];
 			}
+
+			// keep the unread tail and fill up the rest of the buffer behind it
+			if (unread > 0 && m_readPosition != m_readAhead)
+			{
+				memmove(m_readAhead, m_readPosition, unread);
+			}
+
+			m_readPosition = m_readAhead;
+			m_readEnd = m_readAhead + unread;
+
+			while (unread < count)
+			{
+				int num = m_stream->Read(m_readAhead, unread, m_readAheadSize - unread);
+
+				if (num <= 0)
+				{
+					return false;
+				}
+
+				unread += num;
+				m_readEnd += num;
+			}
+
+			return true;
+		}
+
+		// Returns count bytes from the read-ahead and consumes them. Primitives are stored little endian, like the Xbox itself,
+		// so the callers load them straight from the returned pointer.
+		inline const byte* BinaryReader::Take(const int count)
+		{
+			if (m_readEnd - m_readPosition < count && !RefillReadAhead(count))
+			{
+				sassert(false, "Attempted to read beyond End Of File.");
+
+				memset(m_buffer, 0, 32);
+				return m_buffer;
+			}
+
+			const byte* data = m_readPosition;
+			m_readPosition += count;
+			return data;
 		}
 
 		int BinaryReader::InternalReadChars(char buffer[], int index, int count)
@@ -266,7 +369,47 @@ namespace System
 				return -1;
 			}*/
 
-			int bytes_read = m_stream->Read(buffer, index, count);
+			// hand out what has been read ahead first; large reads go straight to the stream
+			int bytes_read = m_readEnd - m_readPosition;
+
+			if (bytes_read > count)
+			{
+				bytes_read = count;
+			}
+
+			if (bytes_read > 0)
+			{
+				memcpy(&buffer[index], m_readPosition, bytes_read);
+				m_readPosition += bytes_read;
+			}
+
+			if (bytes_read < count)
+			{
+				if (!m_isMemoryStream && count - bytes_read < m_readAheadSize)
+				{
+					RefillReadAhead(1);
+
+					int num = m_readEnd - m_readPosition;
+
+					if (num > count - bytes_read)
+					{
+						num = count - bytes_read;
+					}
+
+					memcpy(&buffer[index + bytes_read], m_readPosition, num);
+					m_readPosition += num;
+					bytes_read += num;
+				}
+				else
+				{
+					int num = m_stream->Read(buffer, index + bytes_read, count - bytes_read);
+
+					if (num > 0)
+					{
+						bytes_read += num;
+					}
+				}
+			}
 
 			return(bytes_read);
 		}
@@ -295,6 +438,23 @@ namespace System
 			uint bitsRead = 0;
 			uint value;
 
+			// an encoded int is at most 5 bytes, so if they are all buffered there is no need to check for the end of the data
+			if (m_readEnd - m_readPosition >= 5)
+			{
+				const byte* data = m_readPosition;
+
+				do
+				{
+					value = *data++;
+					result |= (value & 0x7f) << bitsRead;
+					bitsRead += 7;
+				}
+				while ((value & 0x80) && bitsRead < 35);
+
+				m_readPosition = data;
+				return result;
+			}
+
 			do
 			{
 				value = ReadByte();
@@ -308,19 +468,14 @@ namespace System
 
 		bool BinaryReader::ReadBoolean()
 		{
-			FillBuffer(1);
-			return (m_buffer[0] != 0);
+			return (*Take(1) != 0);
 		}
 
 		byte BinaryReader::ReadByte()
 		{
 			sassert(m_stream != null, "Cannot read from a closed BinaryReader.");
 
-			int num = m_stream->ReadByte();
-
-			sassert(num != -1, "Attempted to read beyond End Of File.");
-
-			return (byte)num;
+			return *Take(1);
 		}
 
 		byte* BinaryReader::ReadBytes(int count)
@@ -336,7 +491,7 @@ namespace System
 			int offset = 0;
 			do
 			{
-				int num2 = m_stream->Read(buffer, offset, count);
+				int num2 = Read(buffer, offset, count);
 				if (num2 == 0)
 					break;
 				offset += num2;
@@ -380,44 +535,101 @@ namespace System
 
 		double BinaryReader::ReadDouble()
 		{
-			FillBuffer(8);
-			uint num = (uint) (((m_buffer[0] | (m_buffer[1] << 8)) | (m_buffer[2] << 0x10)) | (m_buffer[3] << 0x18));
-			uint num2 = (uint) (((m_buffer[4] | (m_buffer[5] << 8)) | (m_buffer[6] << 0x10)) | (m_buffer[7] << 0x18));
-			ulong num3 = ((ulong)num2 << 0x20) | num;
-			return *(((double*) &num3));
+			double value;
+			memcpy(&value, Take(8), sizeof(value));
+			return value;
 		}
 
 		float BinaryReader::ReadSingle()
 		{
-			FillBuffer(4);
-			uint num = (uint) (((m_buffer[0] | (m_buffer[1] << 8)) | (m_buffer[2] << 0x10)) | (m_buffer[3] << 0x18));
-			return *(((float*) &num));
+			float value;
+			memcpy(&value, Take(4), sizeof(value));
+			return value;
+		}
+
+		const byte* BinaryReader::ReadSpan(const int count)
+		{
+			sassert(count >= 0, String::Format("count; %s", FrameworkResources::ArgumentOutOfRange_NeedNonNegNum));
+
+			sassert(m_stream != null, String::Format("BinaryReader; %s", "Cannot read from a closed BinaryReader."));
+
+			if (count < 0 || !m_stream)
+				return null;
+
+			if (m_readEnd - m_readPosition < count)
+			{
+				if (m_isMemoryStream || count <= m_readAheadSize)
+				{
+					// for in-memory streams this makes the read-ahead span the rest of the stream, so nothing is copied at all
+					if (!RefillReadAhead(count))
+					{
+						sassert(false, "Attempted to read beyond End Of File.");
+						return null;
+					}
+				}
+				else
+				{
+					// too large for the read-ahead buffer; gather the bytes in a buffer of their own
+					if (count > m_spanBufferSize)
+					{
+						delete[] m_spanBuffer;
+						m_spanBuffer = new byte[count];
+						m_spanBufferSize = count;
+					}
+
+					int offset = m_readEnd - m_readPosition;
+
+					if (offset > 0)
+					{
+						memcpy(m_spanBuffer, m_readPosition, offset);
+						m_readPosition = m_readEnd;
+					}
+
+					while (offset < count)
+					{
+						int num = m_stream->Read(m_spanBuffer, offset, count - offset);
+
+						sassert(num > 0, "Attempted to read beyond End Of File.");
+
+						if (num <= 0)
+							return null;
+
+						offset += num;
+					}
+
+					return m_spanBuffer;
+				}
+			}
+
+			const byte* span = m_readPosition;
+			m_readPosition += count;
+			return span;
 		}
 
 		short BinaryReader::ReadInt16()
 		{
-			FillBuffer(2);
-			return (short)(m_buffer[0] | (m_buffer[1] << 8));
+			short value;
+			memcpy(&value, Take(2), sizeof(value));
+			return value;
 		}
 
 		int BinaryReader::ReadInt32()
 		{
-			FillBuffer(4);
-			return (((m_buffer[0] | (m_buffer[1] << 8)) | (m_buffer[2] << 0x10)) | (m_buffer[3] << 0x18));
+			int value;
+			memcpy(&value, Take(4), sizeof(value));
+			return value;
 		}
 
 		long long BinaryReader::ReadInt64()
 		{
-			FillBuffer(8);
-			uint num = (uint)(((m_buffer[0] | (m_buffer[1] << 8)) | (m_buffer[2] << 0x10)) | (m_buffer[3] << 0x18));
-			uint num2 = (uint)(((m_buffer[4] | (m_buffer[5] << 8)) | (m_buffer[6] << 0x10)) | (m_buffer[7] << 0x18));
-			return (long long) (((long long)num2 << 0x20) | num);
+			long long value;
+			memcpy(&value, Take(8), sizeof(value));
+			return value;
 		}
 
 		sbyte BinaryReader::ReadSByte()
 		{
-			FillBuffer(1);
-			return (sbyte)m_buffer[0];
+			return (sbyte)*Take(1);
 		}
 
 		String BinaryReader::ReadString()
@@ -429,22 +641,23 @@ namespace System
 
 		ushort BinaryReader::ReadUInt16()
 		{
-			FillBuffer(2);
-			return (ushort) (m_buffer[0] | (m_buffer[1] << 8));
+			ushort value;
+			memcpy(&value, Take(2), sizeof(value));
+			return value;
 		}
 
 		uint BinaryReader::ReadUInt32()
 		{
-			FillBuffer(4);
-			return (uint)(((m_buffer[0] | (m_buffer[1] << 8)) | (m_buffer[2] << 0x10)) | (m_buffer[3] << 0x18));
+			uint value;
+			memcpy(&value, Take(4), sizeof(value));
+			return value;
 		}
 
 		ulong BinaryReader::ReadUInt64()
 		{
-			FillBuffer(8);
-			uint num = (uint) (((m_buffer[0] | (m_buffer[1] << 8)) | (m_buffer[2] << 0x10)) | (m_buffer[3] << 0x18));
-			uint num2 = (uint) (((m_buffer[4] | (m_buffer[5] << 8)) | (m_buffer[6] << 0x10)) | (m_buffer[7] << 0x18));
-			return (((ulong)num2 << 0x20) | num);
+			ulong value;
+			memcpy(&value, Take(8), sizeof(value));
+			return value;
 		}
 	}
 }
@@ -28,7 +28,7 @@
 #include <System/Array.h>
 #include <System/Collections/Generic/Dictionary.h>
 #include <System/Collections/Generic/EqualityComparer.h>
-#include "HashHelpers.h"
+#include <System/Collections/HashHelpers.h>
 
 #if DEBUG
 #include <stdio.h>
@@ -26,7 +26,7 @@
 // POSSIBILITY OF SUCH DAMAGE.
 
 #include <System/Array.h>
-#include "HashHelpers.h"
+#include <System/Collections/HashHelpers.h>
 #include <System/Math.h>
 
 #if DEBUG
@@ -0,0 +1,266 @@
+// Copyright (C) XFX Team
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without 
+// modification, are permitted provided that the following conditions are met:
+// 
+//* Redistributions of source code must retain the above copyright 
+//notice, this list of conditions and the following disclaimer.
+//* Redistributions in binary form must reproduce the above copyright 
+//notice, this list of conditions and the following disclaimer in the 
+//documentation and/or other materials provided with the distribution.
+//* Neither the name of the copyright holder nor the names of any 
+//contributors may be used to endorse or promote products derived from 
+//this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE 
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF 
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS 
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE 
+// POSSIBILITY OF SUCH DAMAGE.
+
+
+#include <System/FrameworkResources.h>
+#include <System/String.h>
+#include <System/Type.h>
+#include <System/IO/MappedFileStream.h>
+
+#if ENABLE_XBOX
+extern "C"
+{
+#include <hal/fileio.h>
+#include <xboxkrnl/xboxkrnl.h>
+}
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <sassert.h>
+#include <string.h>
+
+namespace System
+{
+	namespace IO
+	{
+		const Type MappedFileStreamTypeInfo("MappedFileStream", "System::IO::MappedFileStream", TypeCode::Object);
+
+		bool MappedFileStream::CanRead()
+		{
+			return _data != null;
+		}
+
+		bool MappedFileStream::CanSeek()
+		{
+			return _data != null;
+		}
+
+		bool MappedFileStream::CanWrite()
+		{
+			return false;
+		}
+
+		long long MappedFileStream::Length()
+		{
+			sassert(_data != null, FrameworkResources::ObjectDisposed_StreamClosed);
+
+			return _length;
+		}
+
+		MappedFileStream::MappedFileStream(const String& path)
+			: _data(null), _length(0)
+		{
+			sassert(!String::IsNullOrEmpty(path), FrameworkResources::ArgumentNull_Path);
+
+			Position = 0;
+
+#if ENABLE_XBOX
+			int handle;
+			uint length;
+			uint bytesRead;
+
+			if (XCreateFile(&handle, const_cast<char*>((const char *)path), GENERIC_READ, FILE_SHARE_READ, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL) != 0)
+			{
+				sassert(false, String::Format("Could not open file \"%s\".", (const char *)path));
+				return;
+			}
+
+			XGetFileSize(handle, &length);
+
+			// allocate at least one byte so an empty file still gives an open stream
+			_data = (byte*)MmAllocateContiguousMemory((length > 0) ? length : 1);
+
+			if (_data != null && XReadFile(handle, _data, length, &bytesRead) == 0 && bytesRead == length)
+			{
+				_length = (int)length;
+			}
+			else if (_data != null)
+			{
+				MmFreeContiguousMemory(_data);
+				_data = null;
+			}
+
+			XCloseHandle(handle);
+#else
+			int fd = open((const char *)path, O_RDONLY);
+			struct stat info;
+
+			if (fd < 0)
+			{
+				sassert(false, String::Format("Could not open file \"%s\".", (const char *)path));
+				return;
+			}
+
+			if (fstat(fd, &info) == 0)
+			{
+				void* mapping = (info.st_size > 0) ? mmap(null, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0) : MAP_FAILED;
+
+				if (mapping != MAP_FAILED)
+				{
+					_data = (byte*)mapping;
+					_length = (int)info.st_size;
+				}
+			}
+
+			close(fd);
+#endif
+
+			sassert(_data != null, String::Format("Could not read file \"%s\".", (const char *)path));
+		}
+
+		MappedFileStream::~MappedFileStream()
+		{
+			Dispose(false);
+		}
+
+		void MappedFileStream::Dispose(bool disposing)
+		{
+			if (_data != null)
+			{
+#if ENABLE_XBOX
+				MmFreeContiguousMemory(_data);
+#else
+				munmap(_data, _length);
+#endif
+				_data = null;
+				_length = 0;
+			}
+
+			Stream::Dispose(disposing);
+		}
+
+		void MappedFileStream::Flush()
+		{
+		}
+
+		const Type& MappedFileStream::GetType()
+		{
+			return MappedFileStreamTypeInfo;
+		}
+
+		const byte* MappedFileStream::InternalReadSpan(const int count)
+		{
+			sassert(_data != null, FrameworkResources::ObjectDisposed_StreamClosed);
+
+			sassert(count >= 0, String::Format("%s; %s", String::Format(FrameworkResources::Arg_ParamName_Name, "count"), FrameworkResources::ArgumentOutOfRange_NeedNonNegNum));
+
+			if (_data == null || Position < 0 || count < 0 || count > _length - Position)
+			{
+				return null;
+			}
+
+			const byte* span = &_data[Position];
+			Position += count;
+			return span;
+		}
+
+		int MappedFileStream::Read(byte buffer[], int offset, int count)
+		{
+			sassert(_data != null, FrameworkResources::ObjectDisposed_StreamClosed);
+
+			sassert(buffer != null, FrameworkResources::ArgumentNull_Buffer);
+
+			sassert(offset >= 0, String::Format("%s; %s", String::Format(FrameworkResources::Arg_ParamName_Name, "offset"), FrameworkResources::ArgumentOutOfRange_NeedNonNegNum));
+
+			sassert(count >= 0, String::Format("%s; %s", String::Format(FrameworkResources::Arg_ParamName_Name, "count"), FrameworkResources::ArgumentOutOfRange_NeedNonNegNum));
+
+			long long num = _length - Position;
+
+			if (num > count)
+			{
+				num = count;
+			}
+
+			if (num <= 0)
+			{
+				return 0;
+			}
+
+			memcpy(&buffer[offset], &_data[Position], (int)num);
+			Position += num;
+			return (int)num;
+		}
+
+		int MappedFileStream::ReadByte()
+		{
+			sassert(_data != null, FrameworkResources::ObjectDisposed_StreamClosed);
+
+			if (Position < 0 || Position >= _length)
+			{
+				return -1;
+			}
+
+			return _data[Position++];
+		}
+
+		long long MappedFileStream::Seek(long long offset, SeekOrigin_t origin)
+		{
+			sassert(_data != null, FrameworkResources::ObjectDisposed_StreamClosed);
+
+			long long position = Position;
+
+			switch (origin)
+			{
+			case SeekOrigin::Begin:
+				position = offset;
+				break;
+			case SeekOrigin::Current:
+				position += offset;
+				break;
+			case SeekOrigin::End:
+				position = _length + offset;
+				break;
+			default:
+				sassert(false, FrameworkResources::Argument_InvalidSeekOrigin);
+				break;
+			}
+
+			sassert(position >= 0, FrameworkResources::IO_SeekBeforeBegin);
+
+			if (position >= 0)
+			{
+				Position = position;
+			}
+
+			return Position;
+		}
+
+		void MappedFileStream::SetLength(long long value)
+		{
+			sassert(false, FrameworkResources::NotSupported_UnwritableStream);
+		}
+
+		void MappedFileStream::Write(byte buffer[], int offset, int count)
+		{
+			sassert(false, FrameworkResources::NotSupported_UnwritableStream);
+		}
+	}
+}
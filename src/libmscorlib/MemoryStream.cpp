@@ -54,6 +54,13 @@ namespace System
 			return _writable;
 		}
 
+		long long MemoryStream::Length()
+		{
+			sassert(_isOpen, FrameworkResources::ObjectDisposed_StreamClosed);
+
+			return _length - _origin;
+		}
+
 		int MemoryStream::getCapacity()
 		{
 			sassert(_isOpen, FrameworkResources::ObjectDisposed_StreamClosed);
@@ -92,10 +99,12 @@ namespace System
 		{
 			_buffer = new byte[0];
 			_capacity = 0;
+			_length = 0;
 			_expandable = true;
 			_writable = true;
 			_exposable = true;
 			_origin = 0;
+			_position = 0;
 			_isOpen = true;
 		}
 
@@ -105,10 +114,12 @@ namespace System
 
 			_buffer = new byte[capacity];
 			_capacity = capacity;
+			_length = 0;
 			_expandable = true;
 			_writable = true;
 			_exposable = true;
 			_origin = 0;
+			_position = 0;
 			_isOpen = true;
 		}
 
@@ -122,6 +133,7 @@ namespace System
 			_writable = true;
 			_exposable = false;
 			_origin = 0;
+			_position = 0;
 			_isOpen = true;
 		}
 
@@ -134,6 +146,7 @@ namespace System
 			_writable = writable;
 			_exposable = false;
 			_origin = 0;
+			_position = 0;
 			_isOpen = true;
 		}
 
@@ -150,6 +163,7 @@ namespace System
 			_buffer = new byte[count];
 			Array::Copy(buffer, index, _buffer, 0, count);
 			_origin = 0;
+			_position = 0;
 			_length = _capacity = count;
 			_writable = true;
 			_exposable = false;
@@ -170,6 +184,7 @@ namespace System
 			_buffer = new byte[count];
 			Array::Copy(buffer, index, _buffer, 0, count);
 			_origin = 0;
+			_position = 0;
 			_length = _capacity = count;
 			_writable = writable;
 			_exposable = false;
@@ -190,6 +205,7 @@ namespace System
 			_buffer = new byte[count];
 			Array::Copy(buffer, index, _buffer, 0, count);
 			_origin = 0;
+			_position = 0;
 			_length = _capacity = count;
 			_writable = writable;
 			_exposable = publiclyVisible;
@@ -239,6 +255,20 @@ namespace System
 		{
 		}
 
+		const byte* MemoryStream::InternalReadSpan(const int count)
+		{
+			sassert(_isOpen, FrameworkResources::ObjectDisposed_StreamClosed);
+
+			if (count < 0 || count > _length - _position)
+			{
+				return null;
+			}
+
+			const byte* span = &_buffer[_position];
+			_position += count;
+			return span;
+		}
+
 		byte* MemoryStream::GetBuffer()
 		{
 			sassert(_exposable, FrameworkResources::UnauthorizedAccess_MemStreamBuffer);
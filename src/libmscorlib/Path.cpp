@@ -69,8 +69,10 @@ namespace System
 #define NUM_OF_DRIVES (sizeof(driveMapping) / sizeof(driveMapping[0]))
 
 
+		const char Path::AltDirectorySeparatorChar = '/';
 		const char Path::PathSeparator = '\\';
 		const char Path::DirectorySeparatorChar = '\\';
+		const char Path::VolumeSeparatorChar = ':';
 
 		Path::Path()
 		{
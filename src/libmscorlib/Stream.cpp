@@ -51,14 +51,59 @@ namespace System
 		{
 		}
 
+		// The base class is the stream Null returns: it reads nothing, and discards whatever is written to it.
+		bool Stream::CanRead()
+		{
+			return false;
+		}
+
+		bool Stream::CanSeek()
+		{
+			return false;
+		}
+
 		bool Stream::CanTimeOut()
 		{
 			return false;
 		}
 
+		bool Stream::CanWrite()
+		{
+			return false;
+		}
+
+		long long Stream::Length()
+		{
+			return 0;
+		}
+
+		// The base class carries out asynchronous operations synchronously: the returned result is already completed,
+		// and the callback has been called, by the time Begin* returns. The result is deleted by the matching End* call.
 		IAsyncResult* Stream::BeginRead(byte buffer[], int offset, int count, AsyncCallback callback, Object* state)
 		{
-			// TODO: implement using ReadFileEx
+			StreamAsyncResult* result = new StreamAsyncResult(state);
+			result->SetComplete(Read(buffer, offset, count));
+
+			if (callback != null)
+			{
+				callback(result);
+			}
+
+			return result;
+		}
+
+		IAsyncResult* Stream::BeginWrite(byte buffer[], int offset, int count, AsyncCallback callback, Object* state)
+		{
+			StreamAsyncResult* result = new StreamAsyncResult(state);
+			Write(buffer, offset, count);
+			result->SetComplete(count);
+
+			if (callback != null)
+			{
+				callback(result);
+			}
+
+			return result;
 		}
 
 		void Stream::Close()
@@ -71,11 +116,33 @@ namespace System
 			Close();
 		}
 
+		void Stream::Dispose(bool disposing)
+		{
+		}
+
+		int Stream::EndRead(IAsyncResult* asyncResult)
+		{
+			sassert(asyncResult, String::Format("asyncResult: %s", FrameworkResources::ArgumentNull_Generic));
+
+			if (asyncResult == null)
+			{
+				return 0;
+			}
+
+			const int count = static_cast<StreamAsyncResult*>(asyncResult)->NBytes();
+			delete asyncResult;
+			return count;
+		}
+
 		void Stream::EndWrite(IAsyncResult* asyncResult)
 		{
 			sassert(asyncResult, String::Format("asyncResult: %s", FrameworkResources::ArgumentNull_Generic));
 
-			// TODO: implement
+			delete asyncResult;
+		}
+
+		void Stream::Flush()
+		{
 		}
 
 		const Type& Stream::GetType()
@@ -83,6 +150,16 @@ namespace System
 			return StreamTypeInfo;
 		}
 
+		const byte* Stream::InternalReadSpan(const int count)
+		{
+			return null;
+		}
+
+		int Stream::Read(byte buffer[], int offset, int count)
+		{
+			return 0;
+		}
+
 		int Stream::ReadByte()
 		{
 			byte* buffer = new byte[1];
@@ -93,6 +170,19 @@ namespace System
 			return buffer[0];
 		}
 
+		long long Stream::Seek(long long offset, SeekOrigin_t origin)
+		{
+			return 0;
+		}
+
+		void Stream::SetLength(long long value)
+		{
+		}
+
+		void Stream::Write(byte buffer[], int offset, int count)
+		{
+		}
+
 		void Stream::WriteByte(byte value)
 		{
 			byte buffer[] = { value };
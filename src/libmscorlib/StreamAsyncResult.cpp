@@ -35,16 +35,21 @@ namespace System
 		{
 			_nbytes = -1;
 			_state = state;
+			completed = false;
+			done = false;
 		}
 
 		StreamAsyncResult::StreamAsyncResult(const IAsyncResult &obj)
 		{
 			_nbytes = -1;
+			_state = null;
+			completed = false;
+			done = false;
 		}
 
 		StreamAsyncResult::StreamAsyncResult(const StreamAsyncResult &obj)
 		{
-			_nbytes = -1;
+			_nbytes = obj._nbytes;
 			_state = obj._state;
 			completed = obj.completed;
 			done = obj.done;
@@ -56,7 +61,7 @@ namespace System
 			return _state;
 		}
 
-		bool StreamAsyncResult::CompletedSynchronously()
+		bool StreamAsyncResult::CompletedSynchronously() const
 		{
 			return true;
 		}
@@ -66,7 +71,7 @@ namespace System
 			return exc;
 		}*/
 
-		bool StreamAsyncResult::IsCompleted()
+		bool StreamAsyncResult::IsCompleted() const
 		{
 			return completed;
 		}
@@ -81,6 +86,12 @@ namespace System
 			return null;
 		}
 
+		void StreamAsyncResult::SetComplete(int nbytes)
+		{
+			_nbytes = nbytes;
+			completed = true;
+		}
+
 		/*void StreamAsyncResult::SetComplete(Exception* e)
 		{
 			exc = e;
@@ -167,10 +167,13 @@ namespace System
 
 		int count = vsnprintf(NULL, 0, format, args);
 
+		va_end(args);
+
 		char* res = (char*)malloc(count + 1);
 
+		// The first pass consumed the arguments, so they are read again from the start.
+		va_start(args, format);
 		vsnprintf(res, count + 1, format, args);
-
 		va_end(args);
 
 		return res;
@@ -262,7 +265,7 @@ namespace System
 
 	bool String::IsNullOrEmpty(const String& value)
 	{
-		return (value == NULL || value.Length == 0);
+		return (value.internalString == NULL || value.Length == 0);
 	}
 
 	String String::PadLeft(int totalWidth)
@@ -447,7 +450,7 @@ namespace System
 	{
 		if (Length == right.Length)
 		{
-			return !Equals(right);
+			return (strncmp(internalString, right.internalString, Length) != 0);
 		}
 
 		return true;
@@ -467,13 +470,18 @@ namespace System
 	{
 		if (Length == right.Length)
 		{
-			return Equals(right);
+			return (strncmp(internalString, right.internalString, Length) == 0);
 		}
 		return false;
 	}
 
 	bool String::operator==(const char* right) const
 	{
+		if (right == NULL)
+		{
+			return (internalString == NULL);
+		}
+
 		if (Length == (int)strlen(right))
 		{
 			return (strncmp(internalString, right, Length) == 0);
@@ -534,7 +542,7 @@ namespace System
 	
 	const char& String::operator [](const int index) const
 	{
-		sassert(index > 0 && index < Length, "index out of range.");
+		sassert(index >= 0 && index < Length, "index out of range.");
 
 		return internalString[index];
 	}
@@ -0,0 +1,222 @@
+#if _MSC_VER
+#define _CRT_SECURE_NO_WARNINGS
+#endif
+
+#include <string.h>
+
+#include "Dxt.h"
+
+static int Expand5(const int value)
+{
+	return (value << 3) | (value >> 2);
+}
+
+static int Expand6(const int value)
+{
+	return (value << 2) | (value >> 4);
+}
+
+/**
+ * Gathers the 4x4 block at x, y. Pixels past the right or bottom edge repeat the last column or row, so they don't widen the block's endpoints.
+ */
+static void LoadBlock(unsigned char const * const image, const int width, const int height, const int x, const int y, unsigned char pixels[16][4])
+{
+	int i, j;
+
+	for (j = 0; j < 4; j++)
+	{
+		const int sourceY = (y + j < height) ? y + j : height - 1;
+
+		for (i = 0; i < 4; i++)
+		{
+			const int sourceX = (x + i < width) ? x + i : width - 1;
+
+			memcpy(pixels[j * 4 + i], image + (sourceY * width + sourceX) * 4, 4);
+		}
+	}
+}
+
+static void GetMinMax(unsigned char pixels[16][4], int low[4], int high[4])
+{
+	int c, i;
+
+	for (c = 0; c < 4; c++)
+	{
+		low[c] = 255;
+		high[c] = 0;
+
+		for (i = 0; i < 16; i++)
+		{
+			if (pixels[i][c] < low[c])
+			{
+				low[c] = pixels[i][c];
+			}
+
+			if (pixels[i][c] > high[c])
+			{
+				high[c] = pixels[i][c];
+			}
+		}
+	}
+}
+
+/**
+ * Writes a four colour block whose endpoints are the bounding box of the block's colours, inset by 1/16 of its size to reduce the error at the centre.
+ */
+static void EncodeColors(unsigned char pixels[16][4], const int low[4], const int high[4], Buffer * const output)
+{
+	int palette[4][3];
+	int c0, c1, c, i, k;
+	unsigned int indices = 0;
+	int insetLow[3], insetHigh[3];
+
+	for (c = 0; c < 3; c++)
+	{
+		const int inset = (high[c] - low[c]) >> 4;
+
+		insetLow[c] = low[c] + inset;
+		insetHigh[c] = high[c] - inset;
+	}
+
+	// every channel of the high endpoint is at least that of the low one, so c0 >= c1
+	c0 = ((insetHigh[0] >> 3) << 11) | ((insetHigh[1] >> 2) << 5) | (insetHigh[2] >> 3);
+	c1 = ((insetLow[0] >> 3) << 11) | ((insetLow[1] >> 2) << 5) | (insetLow[2] >> 3);
+
+	// A DXT1 block with equal endpoints is in three colour mode, where index 3 is transparent; index 0 is the only colour anyway.
+	if (c0 != c1)
+	{
+		palette[0][0] = Expand5(c0 >> 11);
+		palette[0][1] = Expand6((c0 >> 5) & 0x3F);
+		palette[0][2] = Expand5(c0 & 0x1F);
+		palette[1][0] = Expand5(c1 >> 11);
+		palette[1][1] = Expand6((c1 >> 5) & 0x3F);
+		palette[1][2] = Expand5(c1 & 0x1F);
+
+		for (c = 0; c < 3; c++)
+		{
+			palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+			palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+		}
+
+		for (i = 15; i >= 0; i--)
+		{
+			int best = 0;
+			int bestDistance = 0x7FFFFFFF;
+
+			for (k = 0; k < 4; k++)
+			{
+				const int dr = pixels[i][0] - palette[k][0];
+				const int dg = pixels[i][1] - palette[k][1];
+				const int db = pixels[i][2] - palette[k][2];
+				const int distance = dr * dr + dg * dg + db * db;
+
+				if (distance < bestDistance)
+				{
+					bestDistance = distance;
+					best = k;
+				}
+			}
+
+			indices = (indices << 2) | best;
+		}
+	}
+
+	Xnb.WriteByte(output, c0);
+	Xnb.WriteByte(output, c0 >> 8);
+	Xnb.WriteByte(output, c1);
+	Xnb.WriteByte(output, c1 >> 8);
+	Xnb.WriteInt32(output, (int)indices);
+}
+
+/**
+ * Writes an eight alpha block spanning the block's alphas. The endpoints are not inset so fully transparent and fully opaque pixels stay exact.
+ */
+static void EncodeAlpha(unsigned char pixels[16][4], const int low, const int high, Buffer * const output)
+{
+	int alphas[8];
+	int half, i, k;
+
+	alphas[0] = high;
+	alphas[1] = low;
+
+	for (i = 1; i < 7; i++)
+	{
+		alphas[i + 1] = ((7 - i) * high + i * low) / 7;
+	}
+
+	Xnb.WriteByte(output, high);
+	Xnb.WriteByte(output, low);
+
+	for (half = 0; half < 2; half++)
+	{
+		unsigned int indices = 0;
+
+		if (high != low)
+		{
+			for (i = 7; i >= 0; i--)
+			{
+				const int alpha = pixels[half * 8 + i][3];
+				int best = 0;
+				int bestDistance = 256;
+
+				for (k = 0; k < 8; k++)
+				{
+					const int distance = (alpha > alphas[k]) ? alpha - alphas[k] : alphas[k] - alpha;
+
+					if (distance < bestDistance)
+					{
+						bestDistance = distance;
+						best = k;
+					}
+				}
+
+				indices = (indices << 3) | best;
+			}
+		}
+
+		Xnb.WriteByte(output, indices);
+		Xnb.WriteByte(output, indices >> 8);
+		Xnb.WriteByte(output, indices >> 16);
+	}
+}
+
+void Dxt_CompressDxt1(unsigned char const * const image, const int width, const int height, Buffer * const output)
+{
+	unsigned char pixels[16][4];
+	int low[4], high[4];
+	int x, y;
+
+	for (y = 0; y < height; y += 4)
+	{
+		for (x = 0; x < width; x += 4)
+		{
+			LoadBlock(image, width, height, x, y, pixels);
+			GetMinMax(pixels, low, high);
+			EncodeColors(pixels, low, high, output);
+		}
+	}
+}
+
+void Dxt_CompressDxt5(unsigned char const * const image, const int width, const int height, Buffer * const output)
+{
+	unsigned char pixels[16][4];
+	int low[4], high[4];
+	int x, y;
+
+	for (y = 0; y < height; y += 4)
+	{
+		for (x = 0; x < width; x += 4)
+		{
+			LoadBlock(image, width, height, x, y, pixels);
+			GetMinMax(pixels, low, high);
+			EncodeAlpha(pixels, low[3], high[3], output);
+			EncodeColors(pixels, low, high, output);
+		}
+	}
+}
+
+struct _dxt Dxt =
+{
+	Dxt_CompressDxt1,
+	Dxt_CompressDxt5
+};
@@ -0,0 +1,23 @@
+#ifndef _DXT_H
+#define _DXT_H
+
+#include "Xnb.h"
+
+/**
+ * Compresses RGBA images (R, G, B, A bytes per pixel) to DXT1 or DXT5, with the same bounding box encoder as XFX's DxtUtil.
+ */
+struct _dxt
+{
+	/**
+	 * Appends the DXT1 blocks of an opaque image to output.
+	 */
+	void (*CompressDxt1)(unsigned char const * const, const int, const int, Buffer * const);
+	/**
+	 * Appends the DXT5 blocks of an image to output.
+	 */
+	void (*CompressDxt5)(unsigned char const * const, const int, const int, Buffer * const);
+};
+
+extern struct _dxt Dxt;
+
+#endif //_DXT_H
@@ -0,0 +1,497 @@
+#if _MSC_VER
+#define _CRT_SECURE_NO_WARNINGS
+#endif
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "Image.h"
+#include "Inflate.h"
+
+// Keeps width * height * 4 well inside an int.
+#define MAX_DIMENSION 16384
+
+#define PNG_GRAYSCALE 0
+#define PNG_TRUECOLOR 2
+#define PNG_INDEXED 3
+#define PNG_GRAYSCALE_ALPHA 4
+#define PNG_TRUECOLOR_ALPHA 6
+
+static const unsigned char PngSignature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+
+static unsigned int ReadUInt32BigEndian(unsigned char const * const data)
+{
+	return ((unsigned int)data[0] << 24) | ((unsigned int)data[1] << 16) | ((unsigned int)data[2] << 8) | data[3];
+}
+
+static int ReadUInt16(unsigned char const * const data)
+{
+	return data[0] | (data[1] << 8);
+}
+
+static const char * Allocate(Bitmap * const bitmap, const int width, const int height)
+{
+	if (width <= 0 || height <= 0 || width > MAX_DIMENSION || height > MAX_DIMENSION)
+	{
+		return "unsupported image size";
+	}
+
+	bitmap->width = width;
+	bitmap->height = height;
+	bitmap->pixels = (unsigned char *)malloc((size_t)width * height * 4);
+
+	return (bitmap->pixels != NULL) ? NULL : "out of memory";
+}
+
+static int Paeth(const int a, const int b, const int c)
+{
+	const int p = a + b - c;
+	const int pa = abs(p - a);
+	const int pb = abs(p - b);
+	const int pc = abs(p - c);
+
+	if (pa <= pb && pa <= pc)
+	{
+		return a;
+	}
+
+	return (pb <= pc) ? b : c;
+}
+
+/**
+ * Returns the value of channel c of pixel x of an unfiltered row, at its stored bit depth.
+ */
+static unsigned int Sample(unsigned char const * const row, const int x, const int c, const int channels, const int depth)
+{
+	if (depth == 16)
+	{
+		unsigned char const * const sample = row + (x * channels + c) * 2;
+		return (sample[0] << 8) | sample[1];
+	}
+
+	if (depth == 8)
+	{
+		return row[x * channels + c];
+	}
+
+	// bit depths below 8 only occur with a single channel, packed from the most significant bit
+	return (row[(x * depth) >> 3] >> (8 - depth - ((x * depth) & 7))) & ((1 << depth) - 1);
+}
+
+static const char * LoadPng(unsigned char const * const data, const size_t length, Bitmap * const bitmap)
+{
+	Buffer compressed = { NULL, 0, 0 };
+	Buffer raw = { NULL, 0, 0 };
+	unsigned char palette[256][4];
+	unsigned int transparent[3] = { 0x10000, 0x10000, 0x10000 }; // the tRNS colour key; no sample can match the default
+	int width = 0, height = 0, depth = 0, colorType = -1, channels = 0;
+	size_t position = sizeof(PngSignature);
+	size_t stride;
+	unsigned char * previous;
+	const char * error = NULL;
+	int bytesPerPixel, x, y, c;
+
+	memset(palette, 0xFF, sizeof(palette));
+
+	while (position + 12 <= length)
+	{
+		const unsigned int chunkLength = ReadUInt32BigEndian(data + position);
+		unsigned char const * const type = data + position + 4;
+		unsigned char const * const chunk = data + position + 8;
+
+		if (chunkLength > length - position - 12)
+		{
+			Xnb.Free(&compressed);
+			return "truncated PNG file";
+		}
+
+		if (memcmp(type, "IHDR", 4) == 0 && chunkLength >= 13)
+		{
+			width = (int)ReadUInt32BigEndian(chunk);
+			height = (int)ReadUInt32BigEndian(chunk + 4);
+			depth = chunk[8];
+			colorType = chunk[9];
+
+			if (chunk[12] != 0)
+			{
+				return "interlaced PNG files are not supported";
+			}
+		}
+		else if (memcmp(type, "PLTE", 4) == 0)
+		{
+			unsigned int i;
+
+			for (i = 0; i < chunkLength / 3 && i < 256; i++)
+			{
+				memcpy(palette[i], chunk + i * 3, 3);
+			}
+		}
+		else if (memcmp(type, "tRNS", 4) == 0)
+		{
+			unsigned int i;
+
+			if (colorType == PNG_INDEXED)
+			{
+				for (i = 0; i < chunkLength && i < 256; i++)
+				{
+					palette[i][3] = chunk[i];
+				}
+			}
+			else if (colorType == PNG_GRAYSCALE && chunkLength >= 2)
+			{
+				transparent[0] = (chunk[0] << 8) | chunk[1];
+			}
+			else if (colorType == PNG_TRUECOLOR && chunkLength >= 6)
+			{
+				for (i = 0; i < 3; i++)
+				{
+					transparent[i] = (chunk[i * 2] << 8) | chunk[i * 2 + 1];
+				}
+			}
+		}
+		else if (memcmp(type, "IDAT", 4) == 0)
+		{
+			Xnb.WriteBytes(&compressed, chunk, chunkLength);
+		}
+		else if (memcmp(type, "IEND", 4) == 0)
+		{
+			break;
+		}
+
+		position += 12 + chunkLength;
+	}
+
+	switch (colorType)
+	{
+	case PNG_GRAYSCALE:
+		channels = 1;
+		break;
+	case PNG_TRUECOLOR:
+		channels = 3;
+		break;
+	case PNG_INDEXED:
+		channels = 1;
+		break;
+	case PNG_GRAYSCALE_ALPHA:
+		channels = 2;
+		break;
+	case PNG_TRUECOLOR_ALPHA:
+		channels = 4;
+		break;
+	default:
+		Xnb.Free(&compressed);
+		return "missing or unsupported PNG header";
+	}
+
+	if ((depth != 1 && depth != 2 && depth != 4 && depth != 8 && depth != 16) || (depth < 8 && channels != 1) || (depth == 16 && colorType == PNG_INDEXED))
+	{
+		Xnb.Free(&compressed);
+		return "unsupported PNG bit depth";
+	}
+
+	error = Allocate(bitmap, width, height);
+
+	if (error == NULL)
+	{
+		error = Inflate.Decompress(compressed.data, compressed.length, &raw);
+	}
+
+	Xnb.Free(&compressed);
+
+	stride = ((size_t)width * channels * depth + 7) / 8;
+
+	if (error == NULL && raw.length < (stride + 1) * height)
+	{
+		error = "truncated PNG image data";
+	}
+
+	if (error != NULL)
+	{
+		Xnb.Free(&raw);
+		Image.Free(bitmap);
+		return error;
+	}
+
+	bytesPerPixel = (channels * depth + 7) / 8;
+	previous = NULL;
+
+	for (y = 0; y < height; y++)
+	{
+		unsigned char * const row = raw.data + y * (stride + 1) + 1;
+		const int filter = row[-1];
+		unsigned char * const pixels = bitmap->pixels + (size_t)y * width * 4;
+		size_t i;
+
+		// undo the row's filter in place
+		for (i = 0; i < stride; i++)
+		{
+			const int a = (i >= (size_t)bytesPerPixel) ? row[i - bytesPerPixel] : 0;
+			const int b = (previous != NULL) ? previous[i] : 0;
+			const int d = (previous != NULL && i >= (size_t)bytesPerPixel) ? previous[i - bytesPerPixel] : 0;
+
+			switch (filter)
+			{
+			case 1:
+				row[i] = (unsigned char)(row[i] + a);
+				break;
+			case 2:
+				row[i] = (unsigned char)(row[i] + b);
+				break;
+			case 3:
+				row[i] = (unsigned char)(row[i] + ((a + b) >> 1));
+				break;
+			case 4:
+				row[i] = (unsigned char)(row[i] + Paeth(a, b, d));
+				break;
+			}
+		}
+
+		previous = row;
+
+		for (x = 0; x < width; x++)
+		{
+			unsigned int samples[4];
+
+			for (c = 0; c < channels; c++)
+			{
+				samples[c] = Sample(row, x, c, channels, depth);
+			}
+
+			if (colorType == PNG_INDEXED)
+			{
+				memcpy(pixels + x * 4, palette[samples[0]], 4);
+				continue;
+			}
+
+			for (c = 0; c < channels; c++)
+			{
+				if (depth == 16)
+				{
+					samples[c] >>= 8;
+				}
+				else if (depth < 8)
+				{
+					samples[c] = samples[c] * 255 / ((1 << depth) - 1);
+				}
+			}
+
+			switch (colorType)
+			{
+			case PNG_GRAYSCALE:
+				pixels[x * 4] = pixels[x * 4 + 1] = pixels[x * 4 + 2] = (unsigned char)samples[0];
+				pixels[x * 4 + 3] = (Sample(row, x, 0, 1, depth) == transparent[0]) ? 0 : 255;
+				break;
+			case PNG_GRAYSCALE_ALPHA:
+				pixels[x * 4] = pixels[x * 4 + 1] = pixels[x * 4 + 2] = (unsigned char)samples[0];
+				pixels[x * 4 + 3] = (unsigned char)samples[1];
+				break;
+			case PNG_TRUECOLOR:
+				for (c = 0; c < 3; c++)
+				{
+					pixels[x * 4 + c] = (unsigned char)samples[c];
+				}
+				pixels[x * 4 + 3] = (Sample(row, x, 0, 3, depth) == transparent[0] && Sample(row, x, 1, 3, depth) == transparent[1] && Sample(row, x, 2, 3, depth) == transparent[2]) ? 0 : 255;
+				break;
+			default:
+				for (c = 0; c < 4; c++)
+				{
+					pixels[x * 4 + c] = (unsigned char)samples[c];
+				}
+				break;
+			}
+		}
+	}
+
+	Xnb.Free(&raw);
+
+	return NULL;
+}
+
+/**
+ * Converts one stored TGA pixel (BGR order) or colour map entry to RGBA.
+ *
+ * @param hasAlpha
+ * Zero if the descriptor declares no attribute bits, in which case the top bit of a 16-bit pixel is not alpha.
+ */
+static void ReadTgaPixel(unsigned char const * const source, const int bytesPerPixel, const int hasAlpha, unsigned char * const pixel)
+{
+	switch (bytesPerPixel)
+	{
+	case 1:
+		pixel[0] = pixel[1] = pixel[2] = source[0];
+		pixel[3] = 255;
+		break;
+	case 2:
+		{
+			// A1R5G5B5, widened by repeating the top bits of each channel
+			const int value = ReadUInt16(source);
+			const int r = (value >> 10) & 0x1F;
+			const int g = (value >> 5) & 0x1F;
+			const int b = value & 0x1F;
+			pixel[0] = (unsigned char)((r << 3) | (r >> 2));
+			pixel[1] = (unsigned char)((g << 3) | (g >> 2));
+			pixel[2] = (unsigned char)((b << 3) | (b >> 2));
+			pixel[3] = (!hasAlpha || (value & 0x8000)) ? 255 : 0;
+		}
+		break;
+	case 3:
+		pixel[0] = source[2];
+		pixel[1] = source[1];
+		pixel[2] = source[0];
+		pixel[3] = 255;
+		break;
+	default:
+		pixel[0] = source[2];
+		pixel[1] = source[1];
+		pixel[2] = source[0];
+		pixel[3] = source[3];
+		break;
+	}
+}
+
+static const char * LoadTga(unsigned char const * const data, const size_t length, Bitmap * const bitmap)
+{
+	const int idLength = data[0];
+	const int colorMapType = data[1];
+	const int imageType = data[2];
+	const int colorMapFirst = ReadUInt16(data + 3);
+	const int colorMapLength = ReadUInt16(data + 5);
+	const int colorMapBytes = (data[7] + 7) / 8;
+	const int width = ReadUInt16(data + 12);
+	const int height = ReadUInt16(data + 14);
+	const int bytesPerPixel = (data[16] + 7) / 8;
+	const int descriptor = data[17];
+	const int compressed = imageType >= 9;
+	const int indexed = (imageType & 7) == 1;
+	const size_t colorMapSize = (colorMapType == 1) ? (size_t)colorMapLength * colorMapBytes : 0;
+	unsigned char const * const colorMap = data + 18 + idLength;
+	unsigned char const * source = colorMap + colorMapSize;
+	unsigned char const * const end = data + length;
+	const char * error;
+	int count = 0;
+	int repeat = 0;
+	int x, y;
+
+	if ((imageType & 7) < 1 || (imageType & 7) > 3 || (imageType & ~0x0B) != 0)
+	{
+		return "unsupported TGA image type";
+	}
+
+	if ((indexed && (bytesPerPixel != 1 || colorMapType != 1 || colorMapBytes < 2 || colorMapBytes > 4)) ||
+		(!indexed && (imageType & 7) == 3 && bytesPerPixel != 1) ||
+		(!indexed && (imageType & 7) == 2 && (bytesPerPixel < 2 || bytesPerPixel > 4)))
+	{
+		return "unsupported TGA pixel format";
+	}
+
+	if (18 + idLength + colorMapSize > length)
+	{
+		return "truncated TGA file";
+	}
+
+	error = Allocate(bitmap, width, height);
+
+	if (error != NULL)
+	{
+		return error;
+	}
+
+	for (y = 0; y < height; y++)
+	{
+		// rows are stored bottom-up unless bit 5 of the descriptor is set, and right to left if bit 4 is
+		const int row = (descriptor & 0x20) ? y : height - 1 - y;
+
+		for (x = 0; x < width; x++)
+		{
+			const int column = (descriptor & 0x10) ? width - 1 - x : x;
+			unsigned char * const pixel = bitmap->pixels + ((size_t)row * width + column) * 4;
+			unsigned char const * stored;
+
+			if (compressed && count == 0)
+			{
+				// each packet is a header byte and either one pixel repeated, or header + 1 raw pixels
+				if (source >= end)
+				{
+					break;
+				}
+
+				count = (*source & 0x7F) + 1;
+				repeat = *source++ & 0x80;
+			}
+
+			if (source + bytesPerPixel > end)
+			{
+				break;
+			}
+
+			stored = source;
+
+			if (!compressed || !repeat || count == 1)
+			{
+				source += bytesPerPixel;
+			}
+
+			if (compressed)
+			{
+				count--;
+			}
+
+			if (indexed)
+			{
+				const int index = *stored - colorMapFirst;
+
+				if (index < 0 || index >= colorMapLength)
+				{
+					Image.Free(bitmap);
+					return "TGA colour index out of range";
+				}
+
+				ReadTgaPixel(colorMap + index * colorMapBytes, colorMapBytes, descriptor & 0x0F, pixel);
+			}
+			else
+			{
+				ReadTgaPixel(stored, bytesPerPixel, descriptor & 0x0F, pixel);
+			}
+		}
+
+		if (x < width)
+		{
+			Image.Free(bitmap);
+			return "truncated TGA file";
+		}
+	}
+
+	return NULL;
+}
+
+const char * Image_Load(unsigned char const * const data, const size_t length, Bitmap * const bitmap)
+{
+	memset(bitmap, 0, sizeof(*bitmap));
+
+	if (length >= sizeof(PngSignature) && memcmp(data, PngSignature, sizeof(PngSignature)) == 0)
+	{
+		return LoadPng(data, length, bitmap);
+	}
+
+	if (length < 18)
+	{
+		return "unrecognized image file";
+	}
+
+	return LoadTga(data, length, bitmap);
+}
+
+void Image_Free(Bitmap * const bitmap)
+{
+	free(bitmap->pixels);
+
+	bitmap->pixels = NULL;
+	bitmap->width = 0;
+	bitmap->height = 0;
+}
+
+struct _image Image =
+{
+	Image_Load,
+	Image_Free
+};
@@ -0,0 +1,33 @@
+#ifndef _IMAGE_H
+#define _IMAGE_H
+
+#include <stddef.h>
+
+/**
+ * An image with 4 bytes per pixel, stored as R, G, B, A from the top row down.
+ */
+typedef struct _bitmap
+{
+	int width;
+	int height;
+	unsigned char * pixels;
+} Bitmap;
+
+/**
+ * Imports PNG and TGA files.
+ */
+struct _image
+{
+	/**
+	 * Decodes a PNG file (recognized by its signature) or a TGA file.
+	 *
+	 * @return
+	 * NULL on success, otherwise a description of the error.
+	 */
+	const char * (*Load)(unsigned char const * const, const size_t, Bitmap * const);
+	void (*Free)(Bitmap * const);
+};
+
+extern struct _image Image;
+
+#endif //_IMAGE_H
@@ -0,0 +1,452 @@
+#if _MSC_VER
+#define _CRT_SECURE_NO_WARNINGS
+#endif
+
+#include <string.h>
+
+#include "Inflate.h"
+
+#define MAX_BITS 15
+#define MAX_LITERAL_CODES 288
+#define MAX_DISTANCE_CODES 30
+
+typedef struct _huffman
+{
+	short count[MAX_BITS + 1]; // number of codes of each length
+	short symbol[MAX_LITERAL_CODES]; // symbols ordered by code
+} Huffman;
+
+typedef struct _state
+{
+	unsigned char const * input;
+	size_t length;
+	size_t position;
+	unsigned int bitBuffer;
+	int bitCount;
+	int overrun;
+	Buffer * output;
+} State;
+
+static const short LengthBase[29] =
+{
+	3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+};
+
+static const short LengthExtra[29] =
+{
+	0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+};
+
+static const short DistanceBase[30] =
+{
+	1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577
+};
+
+static const short DistanceExtra[30] =
+{
+	0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13
+};
+
+// the order in which the code length code lengths are sent
+static const short CodeLengthOrder[19] =
+{
+	16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15
+};
+
+static int Bits(State * const state, const int count)
+{
+	unsigned int value = state->bitBuffer;
+
+	while (state->bitCount < count)
+	{
+		if (state->position == state->length)
+		{
+			// reads past the end return zeros; the caller checks overrun once the block is done
+			state->overrun = 1;
+			return 0;
+		}
+
+		value |= (unsigned int)state->input[state->position++] << state->bitCount;
+		state->bitCount += 8;
+	}
+
+	state->bitBuffer = value >> count;
+	state->bitCount -= count;
+
+	return (int)(value & ((1U << count) - 1));
+}
+
+/**
+ * Builds the canonical decoding tables for a set of code lengths.
+ *
+ * @return
+ * 0 for a complete code, a positive value for an incomplete one and a negative value for an over-subscribed one.
+ */
+static int Build(Huffman * const huffman, const short * const lengths, const int count)
+{
+	short offsets[MAX_BITS + 1];
+	int left = 1;
+	int i;
+
+	memset(huffman->count, 0, sizeof(huffman->count));
+
+	for (i = 0; i < count; i++)
+	{
+		huffman->count[lengths[i]]++;
+	}
+
+	if (huffman->count[0] == count)
+	{
+		return 0;
+	}
+
+	for (i = 1; i <= MAX_BITS; i++)
+	{
+		left <<= 1;
+		left -= huffman->count[i];
+
+		if (left < 0)
+		{
+			return left;
+		}
+	}
+
+	offsets[1] = 0;
+
+	for (i = 1; i < MAX_BITS; i++)
+	{
+		offsets[i + 1] = offsets[i] + huffman->count[i];
+	}
+
+	for (i = 0; i < count; i++)
+	{
+		if (lengths[i] != 0)
+		{
+			huffman->symbol[offsets[lengths[i]]++] = (short)i;
+		}
+	}
+
+	return left;
+}
+
+static int Decode(State * const state, const Huffman * const huffman)
+{
+	int code = 0;
+	int first = 0;
+	int index = 0;
+	int length;
+
+	for (length = 1; length <= MAX_BITS; length++)
+	{
+		const int count = huffman->count[length];
+
+		code |= Bits(state, 1);
+
+		if (code - count < first)
+		{
+			return huffman->symbol[index + (code - first)];
+		}
+
+		index += count;
+		first += count;
+		first <<= 1;
+		code <<= 1;
+
+		if (state->overrun)
+		{
+			break;
+		}
+	}
+
+	return -1;
+}
+
+static const char * Stored(State * const state)
+{
+	unsigned int length;
+
+	state->bitBuffer = 0;
+	state->bitCount = 0;
+
+	if (state->position + 4 > state->length)
+	{
+		return "unexpected end of compressed data";
+	}
+
+	length = state->input[state->position] | (state->input[state->position + 1] << 8);
+
+	if ((unsigned int)(state->input[state->position + 2] | (state->input[state->position + 3] << 8)) != (~length & 0xFFFF))
+	{
+		return "corrupt stored block";
+	}
+
+	state->position += 4;
+
+	if (state->position + length > state->length)
+	{
+		return "unexpected end of compressed data";
+	}
+
+	Xnb.WriteBytes(state->output, state->input + state->position, length);
+	state->position += length;
+
+	return NULL;
+}
+
+static const char * Codes(State * const state, const Huffman * const literals, const Huffman * const distances)
+{
+	Buffer * const output = state->output;
+	int symbol;
+
+	do
+	{
+		symbol = Decode(state, literals);
+
+		if (symbol < 0)
+		{
+			return "corrupt compressed data";
+		}
+
+		if (symbol < 256)
+		{
+			Xnb.WriteByte(output, symbol);
+		}
+		else if (symbol > 256)
+		{
+			size_t length;
+			size_t distance;
+
+			symbol -= 257;
+
+			if (symbol >= 29)
+			{
+				return "corrupt compressed data";
+			}
+
+			length = LengthBase[symbol] + Bits(state, LengthExtra[symbol]);
+			symbol = Decode(state, distances);
+
+			if (symbol < 0 || symbol >= 30)
+			{
+				return "corrupt compressed data";
+			}
+
+			distance = DistanceBase[symbol] + Bits(state, DistanceExtra[symbol]);
+
+			if (distance > output->length)
+			{
+				return "corrupt compressed data";
+			}
+
+			// the source may overlap the bytes being written, so copy one byte at a time
+			while (length-- > 0)
+			{
+				Xnb.WriteByte(output, output->data[output->length - distance]);
+			}
+		}
+
+		if (state->overrun)
+		{
+			return "unexpected end of compressed data";
+		}
+	}
+	while (symbol != 256);
+
+	return NULL;
+}
+
+static const char * Fixed(State * const state)
+{
+	Huffman literals;
+	Huffman distances;
+	short lengths[MAX_LITERAL_CODES];
+	int i;
+
+	for (i = 0; i < 144; i++)
+	{
+		lengths[i] = 8;
+	}
+	for (; i < 256; i++)
+	{
+		lengths[i] = 9;
+	}
+	for (; i < 280; i++)
+	{
+		lengths[i] = 7;
+	}
+	for (; i < MAX_LITERAL_CODES; i++)
+	{
+		lengths[i] = 8;
+	}
+	Build(&literals, lengths, MAX_LITERAL_CODES);
+
+	for (i = 0; i < MAX_DISTANCE_CODES; i++)
+	{
+		lengths[i] = 5;
+	}
+	Build(&distances, lengths, MAX_DISTANCE_CODES);
+
+	return Codes(state, &literals, &distances);
+}
+
+static const char * Dynamic(State * const state)
+{
+	Huffman literals;
+	Huffman distances;
+	short lengths[MAX_LITERAL_CODES + MAX_DISTANCE_CODES];
+	const int literalCount = Bits(state, 5) + 257;
+	const int distanceCount = Bits(state, 5) + 1;
+	const int codeCount = Bits(state, 4) + 4;
+	int index;
+	int error;
+
+	if (literalCount > MAX_LITERAL_CODES || distanceCount > MAX_DISTANCE_CODES)
+	{
+		return "corrupt compressed data";
+	}
+
+	for (index = 0; index < codeCount; index++)
+	{
+		lengths[CodeLengthOrder[index]] = (short)Bits(state, 3);
+	}
+	for (; index < 19; index++)
+	{
+		lengths[CodeLengthOrder[index]] = 0;
+	}
+
+	if (Build(&literals, lengths, 19) != 0)
+	{
+		return "corrupt compressed data";
+	}
+
+	index = 0;
+
+	while (index < literalCount + distanceCount)
+	{
+		int symbol = Decode(state, &literals);
+		int repeat;
+		short length = 0;
+
+		if (symbol < 0 || state->overrun)
+		{
+			return "corrupt compressed data";
+		}
+
+		if (symbol < 16)
+		{
+			lengths[index++] = (short)symbol;
+			continue;
+		}
+
+		if (symbol == 16)
+		{
+			if (index == 0)
+			{
+				return "corrupt compressed data";
+			}
+
+			length = lengths[index - 1];
+			repeat = 3 + Bits(state, 2);
+		}
+		else if (symbol == 17)
+		{
+			repeat = 3 + Bits(state, 3);
+		}
+		else
+		{
+			repeat = 11 + Bits(state, 7);
+		}
+
+		if (index + repeat > literalCount + distanceCount)
+		{
+			return "corrupt compressed data";
+		}
+
+		while (repeat-- > 0)
+		{
+			lengths[index++] = length;
+		}
+	}
+
+	if (lengths[256] == 0)
+	{
+		return "corrupt compressed data";
+	}
+
+	// incomplete codes are only allowed when they have a single code
+	error = Build(&literals, lengths, literalCount);
+
+	if (error < 0 || (error > 0 && literalCount - literals.count[0] != 1))
+	{
+		return "corrupt compressed data";
+	}
+
+	error = Build(&distances, lengths + literalCount, distanceCount);
+
+	if (error < 0 || (error > 0 && distanceCount - distances.count[0] != 1))
+	{
+		return "corrupt compressed data";
+	}
+
+	return Codes(state, &literals, &distances);
+}
+
+const char * Inflate_Decompress(unsigned char const * const data, const size_t length, Buffer * const output)
+{
+	State state;
+	const char * error = NULL;
+	int last;
+
+	if (length < 2 || (data[0] & 0x0F) != 8 || ((data[0] << 8) | data[1]) % 31 != 0)
+	{
+		return "not a zlib stream";
+	}
+
+	if (data[1] & 0x20)
+	{
+		return "zlib streams with a preset dictionary are not supported";
+	}
+
+	memset(&state, 0, sizeof(state));
+	state.input = data;
+	state.length = length;
+	state.position = 2;
+	state.output = output;
+
+	do
+	{
+		int type;
+
+		last = Bits(&state, 1);
+		type = Bits(&state, 2);
+
+		if (state.overrun)
+		{
+			return "unexpected end of compressed data";
+		}
+
+		switch (type)
+		{
+		case 0:
+			error = Stored(&state);
+			break;
+		case 1:
+			error = Fixed(&state);
+			break;
+		case 2:
+			error = Dynamic(&state);
+			break;
+		default:
+			error = "corrupt compressed data";
+			break;
+		}
+	}
+	while (error == NULL && !last);
+
+	return error;
+}
+
+struct _inflate Inflate =
+{
+	Inflate_Decompress
+};
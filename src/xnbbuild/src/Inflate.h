@@ -0,0 +1,24 @@
+#ifndef _INFLATE_H
+#define _INFLATE_H
+
+#include <stddef.h>
+
+#include "Xnb.h"
+
+/**
+ * Decompresses zlib streams, as used for the image data of PNG files.
+ */
+struct _inflate
+{
+	/**
+	 * Appends the decompressed contents of a zlib stream to output.
+	 *
+	 * @return
+	 * NULL on success, otherwise a description of the error.
+	 */
+	const char * (*Decompress)(unsigned char const * const, const size_t, Buffer * const);
+};
+
+extern struct _inflate Inflate;
+
+#endif //_INFLATE_H
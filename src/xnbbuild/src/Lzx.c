@@ -0,0 +1,700 @@
+#if _MSC_VER
+#define _CRT_SECURE_NO_WARNINGS
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Lzx.h"
+
+#define FRAME_SIZE 0x8000
+#define WINDOW_SIZE 0x10000
+#define NUM_CHARS 256
+#define NUM_POSITION_SLOTS 32
+#define NUM_PRIMARY_LENGTHS 7
+#define MAIN_ELEMENTS (NUM_CHARS + NUM_POSITION_SLOTS * 8)
+#define LENGTH_ELEMENTS 249
+#define PRETREE_ELEMENTS 20
+#define MAX_CODE_LENGTH 16
+#define MAX_PRETREE_CODE_LENGTH 15
+
+#define MIN_MATCH 3
+#define MAX_MATCH 257
+// The decoder can't copy from further back than the window minus the 3 bytes LZX reserves.
+#define MAX_DISTANCE (WINDOW_SIZE - 3)
+
+#define HASH_BITS 15
+#define HASH_SIZE (1 << HASH_BITS)
+#define MAX_CHAIN 48
+#define NO_POSITION (-1)
+
+#define BLOCKTYPE_VERBATIM 1
+
+static const unsigned int PositionBase[NUM_POSITION_SLOTS + 1] =
+{
+	0, 1, 2, 3, 4, 6, 8, 12, 16, 24, 32, 48, 64, 96, 128, 192, 256, 384, 512, 768, 1024, 1536, 2048, 3072, 4096, 6144,
+	8192, 12288, 16384, 24576, 32768, 49152, 65536
+};
+
+static const unsigned char ExtraBits[NUM_POSITION_SLOTS] =
+{
+	0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13, 14, 14
+};
+
+/**
+ * A literal, or a match with its length and position footer already split into the symbols and extra bits that are written.
+ */
+typedef struct _token
+{
+	unsigned short mainSymbol;
+	short lengthSymbol; // -1 when the length fits in the main symbol
+	unsigned short extraBits;
+	unsigned int extraValue;
+} Token;
+
+/**
+ * Writes 16-bit little-endian words, most significant bit first.
+ */
+typedef struct _bitWriter
+{
+	Buffer * output;
+	unsigned int value;
+	int count;
+} BitWriter;
+
+typedef struct _encoder
+{
+	unsigned char const * data;
+	size_t length;
+	int * head;
+	int * previous;
+	unsigned int R0, R1, R2;
+	unsigned char mainLengths[MAIN_ELEMENTS];
+	unsigned char lengthLengths[LENGTH_ELEMENTS];
+	Token * tokens;
+	int tokenCount;
+	BitWriter bits;
+} Encoder;
+
+static void WriteBits(BitWriter * const writer, const unsigned int value, const int count)
+{
+	int i;
+
+	for (i = count - 1; i >= 0; i--)
+	{
+		writer->value = (writer->value << 1) | ((value >> i) & 1);
+
+		if (++writer->count == 16)
+		{
+			Xnb.WriteByte(writer->output, (int)writer->value);
+			Xnb.WriteByte(writer->output, (int)(writer->value >> 8));
+			writer->value = 0;
+			writer->count = 0;
+		}
+	}
+}
+
+static void AlignBits(BitWriter * const writer)
+{
+	if (writer->count != 0)
+	{
+		WriteBits(writer, 0, 16 - writer->count);
+	}
+}
+
+/**
+ * Computes Huffman code lengths of at most maxLength bits.
+ * The frequencies are halved until the tree fits, which costs very little compression for the alphabets LZX uses.
+ */
+static void BuildCodeLengths(const unsigned int * const frequencies, const int symbolCount, const int maxLength, unsigned char * const lengths)
+{
+	unsigned int weights[MAIN_ELEMENTS * 2];
+	int parents[MAIN_ELEMENTS * 2];
+	int heap[MAIN_ELEMENTS];
+	int heapCount;
+	int nodeCount;
+	int used = 0;
+	int i;
+	int maxFound;
+
+	for (i = 0; i < symbolCount; i++)
+	{
+		weights[i] = frequencies[i];
+
+		if (weights[i] != 0)
+		{
+			used++;
+		}
+	}
+
+	memset(lengths, 0, symbolCount);
+
+	if (used == 0)
+	{
+		return;
+	}
+
+	if (used == 1)
+	{
+		// a complete code needs two symbols
+		weights[(weights[0] != 0) ? 1 : 0] = 1;
+	}
+
+	while (1)
+	{
+		heapCount = 0;
+		nodeCount = symbolCount;
+
+		// a binary min-heap of node indices ordered by weight
+		for (i = 0; i < symbolCount; i++)
+		{
+			if (weights[i] != 0)
+			{
+				int child = heapCount++;
+
+				while (child > 0 && weights[heap[(child - 1) / 2]] > weights[i])
+				{
+					heap[child] = heap[(child - 1) / 2];
+					child = (child - 1) / 2;
+				}
+
+				heap[child] = i;
+			}
+			parents[i] = -1;
+		}
+
+		while (heapCount > 1)
+		{
+			int smallest[2];
+			int k;
+
+			for (k = 0; k < 2; k++)
+			{
+				int last = heap[--heapCount];
+				int parent = 0;
+
+				smallest[k] = heap[0];
+
+				while (2 * parent + 1 < heapCount)
+				{
+					int child = 2 * parent + 1;
+
+					if (child + 1 < heapCount && weights[heap[child + 1]] < weights[heap[child]])
+					{
+						child++;
+					}
+
+					if (weights[last] <= weights[heap[child]])
+					{
+						break;
+					}
+
+					heap[parent] = heap[child];
+					parent = child;
+				}
+
+				heap[parent] = last;
+			}
+
+			weights[nodeCount] = weights[smallest[0]] + weights[smallest[1]];
+			parents[nodeCount] = -1;
+			parents[smallest[0]] = nodeCount;
+			parents[smallest[1]] = nodeCount;
+
+			{
+				int child = heapCount++;
+
+				while (child > 0 && weights[heap[(child - 1) / 2]] > weights[nodeCount])
+				{
+					heap[child] = heap[(child - 1) / 2];
+					child = (child - 1) / 2;
+				}
+
+				heap[child] = nodeCount;
+			}
+
+			nodeCount++;
+		}
+
+		maxFound = 0;
+
+		for (i = 0; i < symbolCount; i++)
+		{
+			int depth = 0;
+			int node = i;
+
+			if (weights[i] == 0)
+			{
+				continue;
+			}
+
+			while (parents[node] != -1)
+			{
+				node = parents[node];
+				depth++;
+			}
+
+			lengths[i] = (unsigned char)depth;
+
+			if (depth > maxFound)
+			{
+				maxFound = depth;
+			}
+		}
+
+		if (maxFound <= maxLength)
+		{
+			return;
+		}
+
+		for (i = 0; i < symbolCount; i++)
+		{
+			if (weights[i] != 0)
+			{
+				weights[i] = (weights[i] >> 1) + 1;
+			}
+		}
+	}
+}
+
+/**
+ * Assigns canonical codes: shorter codes first, and symbols of the same length in increasing order.
+ */
+static void BuildCodes(const unsigned char * const lengths, const int symbolCount, unsigned short * const codes)
+{
+	unsigned int code = 0;
+	int length;
+	int i;
+
+	for (length = 1; length <= MAX_CODE_LENGTH; length++)
+	{
+		for (i = 0; i < symbolCount; i++)
+		{
+			if (lengths[i] == length)
+			{
+				codes[i] = (unsigned short)code++;
+			}
+		}
+
+		code <<= 1;
+	}
+}
+
+/**
+ * Writes the lengths of symbols first to last - 1 through a pretree, as differences from the lengths of the previous block.
+ */
+static void WriteLengths(BitWriter * const writer, const unsigned char * const previous, const unsigned char * const lengths, const int first, const int last)
+{
+	// each operation is a pretree symbol and, for the run symbols, its argument
+	int symbols[MAIN_ELEMENTS];
+	int arguments[MAIN_ELEMENTS];
+	int repeated[MAIN_ELEMENTS];
+	unsigned int frequencies[PRETREE_ELEMENTS];
+	unsigned char pretreeLengths[PRETREE_ELEMENTS];
+	unsigned short pretreeCodes[PRETREE_ELEMENTS];
+	int count = 0;
+	int x = first;
+	int i;
+
+	memset(frequencies, 0, sizeof(frequencies));
+
+	while (x < last)
+	{
+		int run = 0;
+
+		if (lengths[x] == 0)
+		{
+			while (x + run < last && lengths[x + run] == 0 && run < 51)
+			{
+				run++;
+			}
+
+			if (run >= 20)
+			{
+				symbols[count] = 18;
+				arguments[count++] = run - 20;
+				x += run;
+				continue;
+			}
+
+			if (run >= 4)
+			{
+				symbols[count] = 17;
+				arguments[count++] = run - 4;
+				x += run;
+				continue;
+			}
+		}
+
+		run = 0;
+
+		while (x + run < last && lengths[x + run] == lengths[x] && run < 5)
+		{
+			run++;
+		}
+
+		if (run >= 4 && lengths[x] != 0)
+		{
+			symbols[count] = 19;
+			arguments[count] = run - 4;
+			repeated[count++] = (previous[x] - lengths[x] + 17) % 17;
+			x += run;
+			continue;
+		}
+
+		symbols[count++] = (previous[x] - lengths[x] + 17) % 17;
+		x++;
+	}
+
+	for (i = 0; i < count; i++)
+	{
+		frequencies[symbols[i]]++;
+
+		if (symbols[i] == 19)
+		{
+			frequencies[repeated[i]]++;
+		}
+	}
+
+	BuildCodeLengths(frequencies, PRETREE_ELEMENTS, MAX_PRETREE_CODE_LENGTH, pretreeLengths);
+	BuildCodes(pretreeLengths, PRETREE_ELEMENTS, pretreeCodes);
+
+	for (i = 0; i < PRETREE_ELEMENTS; i++)
+	{
+		WriteBits(writer, pretreeLengths[i], 4);
+	}
+
+	for (i = 0; i < count; i++)
+	{
+		WriteBits(writer, pretreeCodes[symbols[i]], pretreeLengths[symbols[i]]);
+
+		if (symbols[i] == 17)
+		{
+			WriteBits(writer, arguments[i], 4);
+		}
+		else if (symbols[i] == 18)
+		{
+			WriteBits(writer, arguments[i], 5);
+		}
+		else if (symbols[i] == 19)
+		{
+			WriteBits(writer, arguments[i], 1);
+			WriteBits(writer, pretreeCodes[repeated[i]], pretreeLengths[repeated[i]]);
+		}
+	}
+}
+
+static unsigned int Hash(unsigned char const * const data)
+{
+	return ((data[0] << 10) ^ (data[1] << 5) ^ data[2]) & (HASH_SIZE - 1);
+}
+
+static void InsertPosition(Encoder * const encoder, const size_t position)
+{
+	unsigned int hash;
+
+	if (position + MIN_MATCH > encoder->length)
+	{
+		return;
+	}
+
+	hash = Hash(encoder->data + position);
+	encoder->previous[position & (WINDOW_SIZE - 1)] = encoder->head[hash];
+	encoder->head[hash] = (int)position;
+}
+
+/**
+ * Finds the longest earlier match for position that ends at or before limit.
+ */
+static int FindMatch(const Encoder * const encoder, const size_t position, const size_t limit, unsigned int * const distance)
+{
+	unsigned char const * const data = encoder->data;
+	int candidate;
+	int chain = MAX_CHAIN;
+	int best = 0;
+
+	if (position + MIN_MATCH > limit)
+	{
+		return 0;
+	}
+
+	candidate = encoder->head[Hash(data + position)];
+
+	while (candidate != NO_POSITION && chain-- > 0)
+	{
+		const size_t match = (size_t)candidate;
+		int length = 0;
+
+		if (position - match > MAX_DISTANCE)
+		{
+			break;
+		}
+
+		if (data[match + best] == data[position + best])
+		{
+			while (position + length < limit && data[match + length] == data[position + length])
+			{
+				length++;
+			}
+
+			if (length > best)
+			{
+				best = length;
+				*distance = (unsigned int)(position - match);
+
+				if (position + best == limit)
+				{
+					break;
+				}
+			}
+		}
+
+		candidate = encoder->previous[match & (WINDOW_SIZE - 1)];
+
+		// positions only ever link to older ones; anything else is a slot reused after the window moved on
+		if (candidate >= (int)match)
+		{
+			break;
+		}
+	}
+
+	return (best >= MIN_MATCH) ? best : 0;
+}
+
+static void AddLiteral(Encoder * const encoder, const int value)
+{
+	Token * const token = &encoder->tokens[encoder->tokenCount++];
+
+	token->mainSymbol = (unsigned short)value;
+	token->lengthSymbol = -1;
+	token->extraBits = 0;
+	token->extraValue = 0;
+}
+
+static void AddMatch(Encoder * const encoder, const int length, const unsigned int distance)
+{
+	Token * const token = &encoder->tokens[encoder->tokenCount++];
+	int slot;
+	int lengthHeader;
+
+	token->extraBits = 0;
+	token->extraValue = 0;
+
+	// the three most recent distances have their own slots
+	if (distance == encoder->R0)
+	{
+		slot = 0;
+	}
+	else if (distance == encoder->R1)
+	{
+		slot = 1;
+		encoder->R1 = encoder->R0;
+		encoder->R0 = distance;
+	}
+	else if (distance == encoder->R2)
+	{
+		slot = 2;
+		encoder->R2 = encoder->R0;
+		encoder->R0 = distance;
+	}
+	else
+	{
+		const unsigned int footer = distance + 2;
+
+		slot = 3;
+
+		while (PositionBase[slot + 1] <= footer)
+		{
+			slot++;
+		}
+
+		token->extraBits = ExtraBits[slot];
+		token->extraValue = footer - PositionBase[slot];
+		encoder->R2 = encoder->R1;
+		encoder->R1 = encoder->R0;
+		encoder->R0 = distance;
+	}
+
+	lengthHeader = (length - 2 < NUM_PRIMARY_LENGTHS) ? length - 2 : NUM_PRIMARY_LENGTHS;
+	token->mainSymbol = (unsigned short)(NUM_CHARS + (slot << 3) + lengthHeader);
+	token->lengthSymbol = (short)((lengthHeader == NUM_PRIMARY_LENGTHS) ? length - 2 - NUM_PRIMARY_LENGTHS : -1);
+}
+
+/**
+ * Splits one frame into literals and matches, using lazy matching: a match is put off by one byte if the next position has a longer one.
+ */
+static void Tokenize(Encoder * const encoder, const size_t start, const size_t end)
+{
+	size_t position = start;
+	unsigned int distance = 0;
+	unsigned int nextDistance = 0;
+	int length = 0;
+	int nextLength;
+
+	encoder->tokenCount = 0;
+
+	while (position < end)
+	{
+		const size_t limit = (end - position > MAX_MATCH) ? position + MAX_MATCH : end;
+
+		if (length == 0)
+		{
+			length = FindMatch(encoder, position, limit, &distance);
+		}
+
+		InsertPosition(encoder, position);
+
+		if (length == 0)
+		{
+			AddLiteral(encoder, encoder->data[position++]);
+			continue;
+		}
+
+		nextLength = (length < MAX_MATCH && position + 1 < end) ? FindMatch(encoder, position + 1, (end - position - 1 > MAX_MATCH) ? position + 1 + MAX_MATCH : end, &nextDistance) : 0;
+
+		if (nextLength > length)
+		{
+			AddLiteral(encoder, encoder->data[position++]);
+			length = nextLength;
+			distance = nextDistance;
+			continue;
+		}
+
+		AddMatch(encoder, length, distance);
+
+		while (--length > 0)
+		{
+			InsertPosition(encoder, ++position);
+		}
+
+		position++;
+	}
+}
+
+static void WriteBlock(Encoder * const encoder, const size_t blockSize)
+{
+	BitWriter * const writer = &encoder->bits;
+	unsigned int mainFrequencies[MAIN_ELEMENTS];
+	unsigned int lengthFrequencies[LENGTH_ELEMENTS];
+	unsigned char mainLengths[MAIN_ELEMENTS];
+	unsigned char lengthLengths[LENGTH_ELEMENTS];
+	unsigned short mainCodes[MAIN_ELEMENTS];
+	unsigned short lengthCodes[LENGTH_ELEMENTS];
+	int i;
+
+	memset(mainFrequencies, 0, sizeof(mainFrequencies));
+	memset(lengthFrequencies, 0, sizeof(lengthFrequencies));
+
+	for (i = 0; i < encoder->tokenCount; i++)
+	{
+		mainFrequencies[encoder->tokens[i].mainSymbol]++;
+
+		if (encoder->tokens[i].lengthSymbol >= 0)
+		{
+			lengthFrequencies[encoder->tokens[i].lengthSymbol]++;
+		}
+	}
+
+	BuildCodeLengths(mainFrequencies, MAIN_ELEMENTS, MAX_CODE_LENGTH, mainLengths);
+	BuildCodes(mainLengths, MAIN_ELEMENTS, mainCodes);
+	BuildCodeLengths(lengthFrequencies, LENGTH_ELEMENTS, MAX_CODE_LENGTH, lengthLengths);
+	BuildCodes(lengthLengths, LENGTH_ELEMENTS, lengthCodes);
+
+	WriteBits(writer, BLOCKTYPE_VERBATIM, 3);
+	WriteBits(writer, (unsigned int)(blockSize >> 8), 16);
+	WriteBits(writer, (unsigned int)(blockSize & 0xFF), 8);
+
+	// the literals and the match headers are sent as two runs of lengths
+	WriteLengths(writer, encoder->mainLengths, mainLengths, 0, NUM_CHARS);
+	WriteLengths(writer, encoder->mainLengths, mainLengths, NUM_CHARS, MAIN_ELEMENTS);
+	WriteLengths(writer, encoder->lengthLengths, lengthLengths, 0, LENGTH_ELEMENTS);
+	memcpy(encoder->mainLengths, mainLengths, sizeof(mainLengths));
+	memcpy(encoder->lengthLengths, lengthLengths, sizeof(lengthLengths));
+
+	for (i = 0; i < encoder->tokenCount; i++)
+	{
+		const Token * const token = &encoder->tokens[i];
+
+		WriteBits(writer, mainCodes[token->mainSymbol], mainLengths[token->mainSymbol]);
+
+		if (token->lengthSymbol >= 0)
+		{
+			WriteBits(writer, lengthCodes[token->lengthSymbol], lengthLengths[token->lengthSymbol]);
+		}
+
+		if (token->extraBits != 0)
+		{
+			WriteBits(writer, token->extraValue, token->extraBits);
+		}
+	}
+}
+
+int Lzx_Compress(unsigned char const * const data, const size_t length, Buffer * const output)
+{
+	Encoder encoder;
+	Buffer frame = { NULL, 0, 0 };
+	size_t start;
+	int result = 0;
+
+	memset(&encoder, 0, sizeof(encoder));
+	encoder.data = data;
+	encoder.length = length;
+	encoder.R0 = encoder.R1 = encoder.R2 = 1;
+	encoder.head = (int *)malloc(HASH_SIZE * sizeof(int));
+	encoder.previous = (int *)malloc(WINDOW_SIZE * sizeof(int));
+	encoder.tokens = (Token *)malloc(FRAME_SIZE * sizeof(Token));
+	encoder.bits.output = &frame;
+
+	if (encoder.head == NULL || encoder.previous == NULL || encoder.tokens == NULL)
+	{
+		fprintf(stderr, "xnbbuild: error: out of memory\n");
+		exit(EXIT_FAILURE);
+	}
+
+	memset(encoder.head, 0xFF, HASH_SIZE * sizeof(int));
+	memset(encoder.previous, 0xFF, WINDOW_SIZE * sizeof(int));
+
+	// no Intel E8 call translation
+	WriteBits(&encoder.bits, 0, 1);
+
+	for (start = 0; start < length && result == 0; start += FRAME_SIZE)
+	{
+		const size_t frameSize = (length - start < FRAME_SIZE) ? length - start : FRAME_SIZE;
+
+		// matches never cross a frame, so each frame is a block that ends on a 16-bit boundary
+		Tokenize(&encoder, start, start + frameSize);
+		WriteBlock(&encoder, frameSize);
+		AlignBits(&encoder.bits);
+
+		if (frame.length >= 0xFFFF)
+		{
+			result = -1;
+			break;
+		}
+
+		if (frameSize != FRAME_SIZE)
+		{
+			Xnb.WriteByte(output, 0xFF);
+			Xnb.WriteByte(output, (int)(frameSize >> 8));
+			Xnb.WriteByte(output, (int)frameSize);
+		}
+
+		Xnb.WriteByte(output, (int)(frame.length >> 8));
+		Xnb.WriteByte(output, (int)frame.length);
+		Xnb.WriteBytes(output, frame.data, frame.length);
+		frame.length = 0;
+	}
+
+	Xnb.Free(&frame);
+	free(encoder.head);
+	free(encoder.previous);
+	free(encoder.tokens);
+
+	return result;
+}
+
+struct _lzx Lzx =
+{
+	Lzx_Compress
+};
@@ -0,0 +1,24 @@
+#ifndef _LZX_H
+#define _LZX_H
+
+#include <stddef.h>
+
+#include "Xnb.h"
+
+/**
+ * Compresses .xnb bodies into the LZX frames that LzxDecoderStream reads: a 64KB window, 32KB frames and one verbatim block per frame.
+ */
+struct _lzx
+{
+	/**
+	 * Appends the compressed frames of data to output.
+	 *
+	 * @return
+	 * 0 on success, or non-zero if a frame does not fit in the 16-bit size field of its header, in which case the content should be stored uncompressed.
+	 */
+	int (*Compress)(unsigned char const * const, const size_t, Buffer * const);
+};
+
+extern struct _lzx Lzx;
+
+#endif //_LZX_H
@@ -0,0 +1,205 @@
+#if _MSC_VER
+#define _CRT_SECURE_NO_WARNINGS
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Manifest.h"
+#include "Path.h"
+
+#define MANIFEST_FILENAME "xnbbuild.manifest"
+
+// Bump whenever the output of a processor changes, so that everything built by an older xnbbuild is rebuilt.
+#define FORMAT_VERSION "1"
+
+#define FNV_OFFSET_BASIS 0xCBF29CE484222325ULL
+#define FNV_PRIME 0x100000001B3ULL
+
+static ContentHash HashBytes(ContentHash hash, unsigned char const * const data, const size_t length)
+{
+	size_t i;
+
+	for (i = 0; i < length; i++)
+	{
+		hash = (hash ^ data[i]) * FNV_PRIME;
+	}
+
+	return hash;
+}
+
+ContentHash Manifest_Hash(unsigned char const * const data, const size_t length, char const * const options)
+{
+	ContentHash hash = HashBytes(FNV_OFFSET_BASIS, data, length);
+
+	hash = HashBytes(hash, (unsigned char const *)FORMAT_VERSION, sizeof(FORMAT_VERSION));
+	hash = HashBytes(hash, (unsigned char const *)options, strlen(options) + 1);
+
+	return hash;
+}
+
+const ManifestEntry * Manifest_Find(const BuildManifest * const manifest, char const * const path)
+{
+	int i;
+
+	for (i = 0; i < manifest->count; i++)
+	{
+		if (strcmp(manifest->entries[i].path, path) == 0)
+		{
+			return &manifest->entries[i];
+		}
+	}
+
+	return NULL;
+}
+
+void Manifest_Set(BuildManifest * const manifest, char const * const path, const ContentHash hash)
+{
+	ManifestEntry * entry = (ManifestEntry *)Manifest_Find(manifest, path);
+	size_t length = 0;
+
+	if (entry != NULL)
+	{
+		entry->hash = hash;
+		return;
+	}
+
+	if (manifest->count == manifest->capacity)
+	{
+		manifest->capacity = (manifest->capacity != 0) ? manifest->capacity * 2 : 64;
+		manifest->entries = (ManifestEntry *)realloc(manifest->entries, manifest->capacity * sizeof(ManifestEntry));
+
+		if (manifest->entries == NULL)
+		{
+			fprintf(stderr, "xnbbuild: error: out of memory\n");
+			exit(EXIT_FAILURE);
+		}
+	}
+
+	length = strlen(path);
+	entry = &manifest->entries[manifest->count++];
+	entry->hash = hash;
+	entry->path = (char *)malloc(length + 1);
+
+	if (entry->path == NULL)
+	{
+		fprintf(stderr, "xnbbuild: error: out of memory\n");
+		exit(EXIT_FAILURE);
+	}
+
+	memcpy(entry->path, path, length + 1);
+}
+
+void Manifest_Remove(BuildManifest * const manifest, char const * const path)
+{
+	ManifestEntry * entry = (ManifestEntry *)Manifest_Find(manifest, path);
+
+	if (entry == NULL)
+	{
+		return;
+	}
+
+	free(entry->path);
+	*entry = manifest->entries[--manifest->count];
+}
+
+void Manifest_Load(char const * const outDir, BuildManifest * const manifest)
+{
+	const char * manifestPath = Path.Combine(outDir, MANIFEST_FILENAME);
+	FILE * fp = NULL;
+	char line[4096];
+
+	manifest->entries = NULL;
+	manifest->count = 0;
+	manifest->capacity = 0;
+
+	fp = (manifestPath != NULL) ? fopen(manifestPath, "r") : NULL;
+	free((void *)manifestPath);
+
+	if (fp == NULL)
+	{
+		return;
+	}
+
+	while (fgets(line, sizeof(line), fp) != NULL)
+	{
+		ContentHash hash = 0;
+		char * c = line;
+		char * end = NULL;
+
+		for (; (*c >= '0' && *c <= '9') || (*c >= 'a' && *c <= 'f'); c++)
+		{
+			hash = (hash << 4) | (ContentHash)((*c <= '9') ? *c - '0' : *c - 'a' + 10);
+		}
+
+		// ignore anything that isn't a complete entry
+		if (c == line || *c != '\t' || (end = strchr(c, '\n')) == NULL)
+		{
+			continue;
+		}
+
+		*end = '\0';
+		Manifest_Set(manifest, c + 1, hash);
+	}
+
+	fclose(fp);
+}
+
+int Manifest_Save(char const * const outDir, const BuildManifest * const manifest)
+{
+	const char * manifestPath = Path.Combine(outDir, MANIFEST_FILENAME);
+	FILE * fp = NULL;
+	int result = 0;
+	int i;
+
+	fp = (manifestPath != NULL) ? fopen(manifestPath, "w") : NULL;
+	free((void *)manifestPath);
+
+	if (fp == NULL)
+	{
+		return -1;
+	}
+
+	for (i = 0; i < manifest->count; i++)
+	{
+		if (fprintf(fp, "%08lx%08lx\t%s\n", (unsigned long)(manifest->entries[i].hash >> 32), (unsigned long)(manifest->entries[i].hash & 0xFFFFFFFFUL), manifest->entries[i].path) < 0)
+		{
+			result = -1;
+		}
+	}
+
+	if (fclose(fp) != 0)
+	{
+		result = -1;
+	}
+
+	return result;
+}
+
+void Manifest_Free(BuildManifest * const manifest)
+{
+	int i;
+
+	for (i = 0; i < manifest->count; i++)
+	{
+		free(manifest->entries[i].path);
+	}
+
+	free(manifest->entries);
+
+	manifest->entries = NULL;
+	manifest->count = 0;
+	manifest->capacity = 0;
+}
+
+struct _manifest Manifest =
+{
+	Manifest_Hash,
+	Manifest_Load,
+	Manifest_Find,
+	Manifest_Set,
+	Manifest_Remove,
+	Manifest_Save,
+	Manifest_Free
+};
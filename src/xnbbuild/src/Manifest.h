@@ -0,0 +1,56 @@
+#ifndef _MANIFEST_H
+#define _MANIFEST_H
+
+#include <stddef.h>
+
+typedef unsigned long long ContentHash;
+
+typedef struct _manifestEntry
+{
+	char * path;
+	ContentHash hash;
+} ManifestEntry;
+
+/**
+ * The inputs of the last successful builds into an output directory, and the hash of each one's content and build options.
+ */
+typedef struct _buildManifest
+{
+	ManifestEntry * entries;
+	int count;
+	int capacity;
+} BuildManifest;
+
+/**
+ * Records which inputs have already been built into an output directory, so that unchanged files can be skipped.
+ * The manifest is a text file in the output directory with one "hash<TAB>input" line per input.
+ */
+struct _manifest
+{
+	/**
+	 * Hashes the content of a file together with the options it is built with, so that changing either causes a rebuild.
+	 */
+	ContentHash (*Hash)(unsigned char const * const, const size_t, char const * const);
+	/**
+	 * Loads the manifest of an output directory. A missing or unreadable manifest loads as empty.
+	 */
+	void (*Load)(char const * const, BuildManifest * const);
+	/**
+	 * Returns the entry for an input, or NULL.
+	 */
+	const ManifestEntry * (*Find)(const BuildManifest * const, char const * const);
+	void (*Set)(BuildManifest * const, char const * const, const ContentHash);
+	void (*Remove)(BuildManifest * const, char const * const);
+	/**
+	 * Saves the manifest of an output directory.
+	 *
+	 * @return
+	 * 0 on success.
+	 */
+	int (*Save)(char const * const, const BuildManifest * const);
+	void (*Free)(BuildManifest * const);
+};
+
+extern struct _manifest Manifest;
+
+#endif //_MANIFEST_H
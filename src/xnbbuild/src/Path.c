@@ -8,131 +8,119 @@
 
 #include "Path.h"
 
-const char * Path_Combine(char const * const path1, char const * const path2)
-{
-	const char * strPtr = NULL;
-	char * pathString = NULL;
-	size_t newLen = 0;
+#if _WIN32
+#define DIRECTORY_SEPARATOR '\\'
+#else
+#define DIRECTORY_SEPARATOR '/'
+#endif
 
-	strPtr = strrchr(path1, '\\');
+// Both separators are accepted, so paths written for either platform can be passed on the command line.
+static const char * FindLastSeparator(char const * const path)
+{
+	const char * backslash = strrchr(path, '\\');
+	const char * slash = strrchr(path, '/');
 
-	if (((size_t)strPtr - (size_t)path1) != 0)
-	{
-		newLen = strlen(path1) + 1 + strlen(path2);
+	return (backslash > slash) ? backslash : slash;
+}
 
-		pathString = (char *)malloc(newLen + 1);
+static char * Duplicate(char const * const str, const size_t length)
+{
+	char * pathString = (char *)malloc(length + 1);
 
-		sprintf(pathString, "%s\\%s", path1, path2);
-	}
-	else
+	if (pathString != NULL)
 	{
-		newLen = strlen(path1) + strlen(path2);
-
-		pathString = (char *)malloc(newLen + 1);
-
-		sprintf(pathString, "%s%s", path1, path2);
+		memcpy(pathString, str, length);
+		pathString[length] = '\0';
 	}
 
-	pathString[newLen] = '\0';
-
 	return pathString;
 }
 
-const char * Path_GetDirectory(char const * const path)
+const char * Path_Combine(char const * const path1, char const * const path2)
 {
-	const char * strPtr = NULL;
-	size_t pathLen = 0;
-	char * pathString;
+	char * pathString = NULL;
+	size_t len1 = 0;
+	size_t len2 = 0;
 
-	strPtr = strrchr(path, '\\');
+	if (path1 == NULL || path1[0] == '\0')
+	{
+		return Duplicate(path2, strlen(path2));
+	}
 
-	pathLen = (size_t)strPtr - (size_t)path;
+	len1 = strlen(path1);
+	len2 = strlen(path2);
 
-	pathString = (char *)malloc(pathLen + 1);
+	if (path1[len1 - 1] == '\\' || path1[len1 - 1] == '/')
+	{
+		pathString = (char *)malloc(len1 + len2 + 1);
 
-	strncpy(pathString, path, pathLen);
+		if (pathString != NULL)
+		{
+			sprintf(pathString, "%s%s", path1, path2);
+		}
+	}
+	else
+	{
+		pathString = (char *)malloc(len1 + 1 + len2 + 1);
 
-	pathString[pathLen] = '\0';
+		if (pathString != NULL)
+		{
+			sprintf(pathString, "%s%c%s", path1, DIRECTORY_SEPARATOR, path2);
+		}
+	}
 
 	return pathString;
 }
 
-const char * Path_GetExtension(char const * const path)
+const char * Path_GetDirectory(char const * const path)
 {
-	const char * strPtr = NULL;
-	size_t pathLen = 0;
-	size_t strLen = 0;
-	char * pathString = NULL;
-
-	strPtr = strrchr(path, '.');
+	const char * strPtr = FindLastSeparator(path);
 
 	if (strPtr == NULL)
 	{
-		// no extension, return an empty string.
-		return "";
+		// no directory, return an empty string.
+		return Duplicate("", 0);
 	}
 
-	strLen = strlen(path);
-
-	pathLen = (size_t)strPtr - (size_t)path;
-
-	strLen -= pathLen;
-
-	pathString = (char *)malloc(strLen + 1);
+	return Duplicate(path, (size_t)(strPtr - path));
+}
 
-	strncpy(pathString, strPtr + 1, strLen);
+const char * Path_GetExtension(char const * const path)
+{
+	const char * strPtr = strrchr(path, '.');
+	const char * separator = FindLastSeparator(path);
 
-	pathString[strLen] = '\0';
+	if (strPtr == NULL || strPtr < separator)
+	{
+		// no extension, return an empty string.
+		return Duplicate("", 0);
+	}
 
-	return pathString;
+	return Duplicate(strPtr + 1, strlen(strPtr + 1));
 }
 
 const char * Path_GetFileName(char const * const path)
 {
-	const char * strPtr = NULL;
-	size_t pathLen = 0;
-	size_t strLen = 0;
-	char * pathString = NULL;
-
-	strPtr = strrchr(path, '\\');
-
-	strLen = strlen(path);
-
-	pathLen = (size_t)strPtr - (size_t)path;
+	const char * strPtr = FindLastSeparator(path);
+	const char * fileName = (strPtr != NULL) ? strPtr + 1 : path;
 
-	strLen -= pathLen;
-
-	pathString = (char *)malloc(strLen + 1);
-
-	strncpy(pathString, strPtr + 1, strLen);
-
-	pathString[strLen] = '\0';
-
-	return pathString;
+	return Duplicate(fileName, strlen(fileName));
 }
 
 const char * Path_GetFileNameWithoutExtension(char const * const path)
 {
 	const char * strPtr = NULL;
-	size_t pathLen = 0;
-	char * pathString = NULL;
-	const char * fileName = NULL;
-
-	fileName = Path_GetFileName(path);
-
-	strPtr = strchr(fileName, '.');
+	const char * separator = FindLastSeparator(path);
+	const char * fileName = (separator != NULL) ? separator + 1 : path;
 
-	pathLen = (size_t)strPtr - (size_t)fileName;
+	strPtr = strrchr(fileName, '.');
 
-	pathString = (char *)malloc(pathLen + 1);
-
-	strncpy(pathString, fileName, pathLen);
-
-	free((void *)fileName);
-
-	pathString[pathLen] = '\0';
+	if (strPtr == NULL)
+	{
+		return Duplicate(fileName, strlen(fileName));
+	}
 
-	return pathString;
+	return Duplicate(fileName, (size_t)(strPtr - fileName));
 }
 
 struct _path Path = 
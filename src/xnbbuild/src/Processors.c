@@ -0,0 +1,319 @@
+#if _MSC_VER
+#define _CRT_SECURE_NO_WARNINGS
+#endif
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "Dxt.h"
+#include "Image.h"
+#include "Processors.h"
+#include "Wave.h"
+
+#define XNA_FRAMEWORK ", Microsoft.Xna.Framework, Version=4.0.0.0, Culture=neutral, PublicKeyToken=842cf8be1de50553"
+#define XNA_GRAPHICS ", Microsoft.Xna.Framework.Graphics, Version=4.0.0.0, Culture=neutral, PublicKeyToken=842cf8be1de50553"
+#define XNA_MSCORLIB ", mscorlib, Version=4.0.0.0, Culture=neutral, PublicKeyToken=b77a5c561934e089"
+
+#define CONTENT_READER(name) "Microsoft.Xna.Framework.Content." name
+
+// The values of XFX's SurfaceFormat enumeration, which Texture2DReader reads the format as.
+#define SURFACEFORMAT_COLOR 1
+#define SURFACEFORMAT_DXT1 28
+#define SURFACEFORMAT_DXT5 32
+
+#define FIRST_CHARACTER ' '
+
+typedef struct _glyph
+{
+	int x, y, width, height;
+} Glyph;
+
+/**
+ * Writes the list of type readers, none of which has a version, and the shared resource count, which is always 0.
+ */
+static void WriteHeader(Buffer * const body, char const * const * const readers, const int count)
+{
+	int i;
+
+	Xnb.Write7BitEncodedInt(body, count);
+
+	for (i = 0; i < count; i++)
+	{
+		Xnb.WriteString(body, readers[i]);
+		Xnb.WriteInt32(body, 0);
+	}
+
+	Xnb.Write7BitEncodedInt(body, 0);
+}
+
+static void WriteTexture(Buffer * const body, const Bitmap * const bitmap, const int dxt)
+{
+	const int pixelCount = bitmap->width * bitmap->height;
+	int opaque = 1;
+	int i;
+	size_t start;
+
+	for (i = 0; i < pixelCount && opaque; i++)
+	{
+		opaque = bitmap->pixels[i * 4 + 3] == 255;
+	}
+
+	Xnb.WriteInt32(body, !dxt ? SURFACEFORMAT_COLOR : (opaque ? SURFACEFORMAT_DXT1 : SURFACEFORMAT_DXT5));
+	Xnb.WriteInt32(body, bitmap->width);
+	Xnb.WriteInt32(body, bitmap->height);
+	Xnb.WriteInt32(body, 1);
+
+	// the level size is filled in once the level has been written
+	start = body->length;
+	Xnb.WriteInt32(body, 0);
+
+	if (!dxt)
+	{
+		Xnb.WriteBytes(body, bitmap->pixels, (size_t)pixelCount * 4);
+	}
+	else if (opaque)
+	{
+		Dxt.CompressDxt1(bitmap->pixels, bitmap->width, bitmap->height, body);
+	}
+	else
+	{
+		Dxt.CompressDxt5(bitmap->pixels, bitmap->width, bitmap->height, body);
+	}
+
+	{
+		const size_t levelSize = body->length - start - 4;
+
+		body->data[start] = (unsigned char)levelSize;
+		body->data[start + 1] = (unsigned char)(levelSize >> 8);
+		body->data[start + 2] = (unsigned char)(levelSize >> 16);
+		body->data[start + 3] = (unsigned char)(levelSize >> 24);
+	}
+}
+
+const char * Processors_Texture(unsigned char const * const data, const size_t length, const int dxt, Buffer * const body)
+{
+	static char const * const readers[] =
+	{
+		CONTENT_READER("Texture2DReader") XNA_GRAPHICS
+	};
+	Bitmap bitmap;
+	const char * error = Image.Load(data, length, &bitmap);
+
+	if (error != NULL)
+	{
+		return error;
+	}
+
+	WriteHeader(body, readers, 1);
+	Xnb.Write7BitEncodedInt(body, 1);
+	WriteTexture(body, &bitmap, dxt);
+
+	Image.Free(&bitmap);
+
+	return NULL;
+}
+
+static int IsSeparator(const Bitmap * const bitmap, const int x, const int y)
+{
+	unsigned char const * const pixel = bitmap->pixels + ((size_t)y * bitmap->width + x) * 4;
+
+	return pixel[0] == 255 && pixel[1] == 0 && pixel[2] == 255 && pixel[3] == 255;
+}
+
+static void WriteRectangle(Buffer * const body, const int x, const int y, const int width, const int height)
+{
+	Xnb.WriteInt32(body, x);
+	Xnb.WriteInt32(body, y);
+	Xnb.WriteInt32(body, width);
+	Xnb.WriteInt32(body, height);
+}
+
+const char * Processors_SpriteFont(unsigned char const * const data, const size_t length, Buffer * const body)
+{
+	static char const * const readers[] =
+	{
+		CONTENT_READER("SpriteFontReader") XNA_GRAPHICS,
+		CONTENT_READER("Texture2DReader") XNA_GRAPHICS,
+		CONTENT_READER("ListReader`1[[Microsoft.Xna.Framework.Rectangle") XNA_FRAMEWORK "]]",
+		CONTENT_READER("RectangleReader"),
+		CONTENT_READER("ListReader`1[[System.Char") XNA_MSCORLIB "]]",
+		CONTENT_READER("CharReader"),
+		CONTENT_READER("ListReader`1[[Microsoft.Xna.Framework.Vector3") XNA_FRAMEWORK "]]",
+		CONTENT_READER("Vector3Reader")
+	};
+	Bitmap bitmap;
+	Glyph * glyphs = NULL;
+	int glyphCount = 0;
+	int glyphCapacity = 0;
+	int lineSpacing = 0;
+	int x, y, i;
+	const char * error = Image.Load(data, length, &bitmap);
+
+	if (error != NULL)
+	{
+		return error;
+	}
+
+	// a glyph starts at every pixel that isn't magenta but whose left and upper neighbours are
+	for (y = 0; y < bitmap.height; y++)
+	{
+		for (x = 0; x < bitmap.width; x++)
+		{
+			Glyph * glyph;
+
+			if (IsSeparator(&bitmap, x, y) || (x > 0 && !IsSeparator(&bitmap, x - 1, y)) || (y > 0 && !IsSeparator(&bitmap, x, y - 1)))
+			{
+				continue;
+			}
+
+			if (glyphCount == glyphCapacity)
+			{
+				glyphCapacity = (glyphCapacity != 0) ? glyphCapacity * 2 : 128;
+				glyphs = (Glyph *)realloc(glyphs, glyphCapacity * sizeof(Glyph));
+
+				if (glyphs == NULL)
+				{
+					Image.Free(&bitmap);
+					return "out of memory";
+				}
+			}
+
+			glyph = &glyphs[glyphCount++];
+			glyph->x = x;
+			glyph->y = y;
+			glyph->width = 0;
+			glyph->height = 0;
+
+			while (x + glyph->width < bitmap.width && !IsSeparator(&bitmap, x + glyph->width, y))
+			{
+				glyph->width++;
+			}
+
+			while (y + glyph->height < bitmap.height && !IsSeparator(&bitmap, x, y + glyph->height))
+			{
+				glyph->height++;
+			}
+
+			if (glyph->height > lineSpacing)
+			{
+				lineSpacing = glyph->height;
+			}
+		}
+	}
+
+	if (glyphCount == 0 || FIRST_CHARACTER + glyphCount > 0x10000)
+	{
+		free(glyphs);
+		Image.Free(&bitmap);
+		return (glyphCount == 0) ? "no glyphs found; separate them with magenta (255, 0, 255)" : "too many glyphs";
+	}
+
+	// the separators become transparent
+	for (i = 0; i < bitmap.width * bitmap.height; i++)
+	{
+		if (IsSeparator(&bitmap, i % bitmap.width, i / bitmap.width))
+		{
+			memset(bitmap.pixels + (size_t)i * 4, 0, 4);
+		}
+	}
+
+	WriteHeader(body, readers, sizeof(readers) / sizeof(readers[0]));
+	Xnb.Write7BitEncodedInt(body, 1);
+
+	Xnb.Write7BitEncodedInt(body, 2);
+	WriteTexture(body, &bitmap, 0);
+
+	Xnb.Write7BitEncodedInt(body, 3);
+	Xnb.WriteInt32(body, glyphCount);
+
+	for (i = 0; i < glyphCount; i++)
+	{
+		WriteRectangle(body, glyphs[i].x, glyphs[i].y, glyphs[i].width, glyphs[i].height);
+	}
+
+	Xnb.Write7BitEncodedInt(body, 3);
+	Xnb.WriteInt32(body, glyphCount);
+
+	for (i = 0; i < glyphCount; i++)
+	{
+		WriteRectangle(body, 0, 0, glyphs[i].width, glyphs[i].height);
+	}
+
+	Xnb.Write7BitEncodedInt(body, 5);
+	Xnb.WriteInt32(body, glyphCount);
+
+	for (i = 0; i < glyphCount; i++)
+	{
+		Xnb.WriteChar(body, FIRST_CHARACTER + i);
+	}
+
+	Xnb.WriteInt32(body, lineSpacing);
+	Xnb.WriteSingle(body, 0.0f);
+
+	// the kerning of each glyph is the space before it, its width and the space after it
+	Xnb.Write7BitEncodedInt(body, 7);
+	Xnb.WriteInt32(body, glyphCount);
+
+	for (i = 0; i < glyphCount; i++)
+	{
+		Xnb.WriteSingle(body, 0.0f);
+		Xnb.WriteSingle(body, (float)glyphs[i].width);
+		Xnb.WriteSingle(body, 0.0f);
+	}
+
+	// no default character
+	Xnb.WriteByte(body, 0);
+
+	free(glyphs);
+	Image.Free(&bitmap);
+
+	return NULL;
+}
+
+const char * Processors_SoundEffect(unsigned char const * const data, const size_t length, Buffer * const body)
+{
+	static char const * const readers[] =
+	{
+		CONTENT_READER("SoundEffectReader") XNA_FRAMEWORK
+	};
+	WaveFile wave;
+	const char * error = Wave.Load(data, length, &wave);
+
+	if (error != NULL)
+	{
+		return error;
+	}
+
+	WriteHeader(body, readers, 1);
+	Xnb.Write7BitEncodedInt(body, 1);
+
+	// a WAVEFORMATEX, including cbSize
+	if (wave.formatLength < 18)
+	{
+		static const unsigned char noExtraBytes[2] = { 0, 0 };
+
+		Xnb.WriteInt32(body, 18);
+		Xnb.WriteBytes(body, wave.format, 16);
+		Xnb.WriteBytes(body, noExtraBytes, 2);
+	}
+	else
+	{
+		Xnb.WriteInt32(body, (int)wave.formatLength);
+		Xnb.WriteBytes(body, wave.format, wave.formatLength);
+	}
+
+	Xnb.WriteInt32(body, (int)wave.dataLength);
+	Xnb.WriteBytes(body, wave.data, wave.dataLength);
+	Xnb.WriteInt32(body, wave.loopStart);
+	Xnb.WriteInt32(body, wave.loopLength);
+	Xnb.WriteInt32(body, wave.duration);
+
+	return NULL;
+}
+
+struct _processors Processors =
+{
+	Processors_Texture,
+	Processors_SpriteFont,
+	Processors_SoundEffect
+};
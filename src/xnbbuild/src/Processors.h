@@ -0,0 +1,35 @@
+#ifndef _PROCESSORS_H
+#define _PROCESSORS_H
+
+#include <stddef.h>
+
+#include "Xnb.h"
+
+/**
+ * Converts source files into the body of an .xnb file: the type reader table, the shared resource count and the asset, in the layout the XFX content readers expect.
+ */
+struct _processors
+{
+	/**
+	 * Builds a Texture2D from a PNG or TGA file.
+	 *
+	 * @param dxt
+	 * Non-zero to compress the texture to DXT1 if it is opaque, or DXT5 otherwise.
+	 *
+	 * @return
+	 * NULL on success, otherwise a description of the error.
+	 */
+	const char * (*Texture)(unsigned char const * const, const size_t, const int, Buffer * const);
+	/**
+	 * Builds a SpriteFont from a PNG or TGA font texture: glyphs for the characters from ' ' onwards, in reading order, separated by magenta.
+	 */
+	const char * (*SpriteFont)(unsigned char const * const, const size_t, Buffer * const);
+	/**
+	 * Builds a SoundEffect from a WAV file.
+	 */
+	const char * (*SoundEffect)(unsigned char const * const, const size_t, Buffer * const);
+};
+
+extern struct _processors Processors;
+
+#endif //_PROCESSORS_H
@@ -0,0 +1,127 @@
+#if _MSC_VER
+#define _CRT_SECURE_NO_WARNINGS
+#endif
+
+#include <string.h>
+
+#include "Wave.h"
+
+#define WAVE_FORMAT_PCM 1
+#define WAVE_FORMAT_ADPCM 2
+
+static unsigned int ReadUInt32(unsigned char const * const data)
+{
+	return data[0] | (data[1] << 8) | (data[2] << 16) | ((unsigned int)data[3] << 24);
+}
+
+static int ReadUInt16(unsigned char const * const data)
+{
+	return data[0] | (data[1] << 8);
+}
+
+const char * Wave_Load(unsigned char const * const file, const size_t length, WaveFile * const wave)
+{
+	size_t position = 12;
+	int formatTag, channels, blockAlign, bitsPerSample;
+	unsigned int sampleRate, averageBytesPerSecond;
+	int sampleCount;
+
+	memset(wave, 0, sizeof(*wave));
+
+	if (length < 12 || memcmp(file, "RIFF", 4) != 0 || memcmp(file + 8, "WAVE", 4) != 0)
+	{
+		return "not a RIFF WAVE file";
+	}
+
+	while (position + 8 <= length)
+	{
+		const size_t chunkLength = ReadUInt32(file + position + 4);
+		unsigned char const * const chunk = file + position + 8;
+
+		if (chunkLength > length - position - 8)
+		{
+			return "truncated WAV file";
+		}
+
+		if (memcmp(file + position, "fmt ", 4) == 0)
+		{
+			wave->format = chunk;
+			wave->formatLength = chunkLength;
+		}
+		else if (memcmp(file + position, "data", 4) == 0)
+		{
+			wave->data = chunk;
+			wave->dataLength = chunkLength;
+		}
+
+		// chunks are padded to an even size
+		position += 8 + chunkLength + (chunkLength & 1);
+	}
+
+	if (wave->format == NULL || wave->formatLength < 16)
+	{
+		return "missing fmt chunk";
+	}
+
+	if (wave->data == NULL)
+	{
+		return "missing data chunk";
+	}
+
+	formatTag = ReadUInt16(wave->format);
+	channels = ReadUInt16(wave->format + 2);
+	sampleRate = ReadUInt32(wave->format + 4);
+	averageBytesPerSecond = ReadUInt32(wave->format + 8);
+	blockAlign = ReadUInt16(wave->format + 12);
+	bitsPerSample = ReadUInt16(wave->format + 14);
+
+	if (channels < 1 || channels > 2 || sampleRate == 0 || averageBytesPerSecond == 0 || blockAlign == 0)
+	{
+		return "unsupported WAV format";
+	}
+
+	if (formatTag == WAVE_FORMAT_PCM)
+	{
+		if (bitsPerSample != 8 && bitsPerSample != 16)
+		{
+			return "unsupported PCM sample size";
+		}
+
+		sampleCount = (int)(wave->dataLength / blockAlign);
+	}
+	else if (formatTag == WAVE_FORMAT_ADPCM)
+	{
+		int samplesPerBlock;
+		size_t remainder;
+
+		if (wave->formatLength < 20)
+		{
+			return "truncated ADPCM format";
+		}
+
+		// every block starts with a header holding the first two samples of each channel, then packs two samples per byte
+		samplesPerBlock = ReadUInt16(wave->format + 18);
+		remainder = wave->dataLength % blockAlign;
+		sampleCount = (int)(wave->dataLength / blockAlign) * samplesPerBlock;
+
+		if (remainder >= (size_t)(7 * channels))
+		{
+			sampleCount += 2 + (int)((remainder - 7 * channels) * 2 / channels);
+		}
+	}
+	else
+	{
+		return "unsupported WAV encoding; use PCM or ADPCM";
+	}
+
+	wave->loopStart = 0;
+	wave->loopLength = sampleCount;
+	wave->duration = (int)((double)sampleCount * 1000 / sampleRate);
+
+	return NULL;
+}
+
+struct _wave Wave =
+{
+	Wave_Load
+};
@@ -0,0 +1,36 @@
+#ifndef _WAVE_H
+#define _WAVE_H
+
+#include <stddef.h>
+
+/**
+ * The parts of a RIFF WAVE file that a SoundEffect is built from. format and data point into the file.
+ */
+typedef struct _waveFile
+{
+	unsigned char const * format; // a WAVEFORMATEX, without cbSize if the file leaves it out
+	size_t formatLength;
+	unsigned char const * data;
+	size_t dataLength;
+	int loopStart; // in samples
+	int loopLength;
+	int duration; // in milliseconds
+} WaveFile;
+
+/**
+ * Imports WAV files.
+ */
+struct _wave
+{
+	/**
+	 * Locates the format and sample data of a WAV file. PCM and ADPCM data are passed through unchanged.
+	 *
+	 * @return
+	 * NULL on success, otherwise a description of the error.
+	 */
+	const char * (*Load)(unsigned char const * const, const size_t, WaveFile * const);
+};
+
+extern struct _wave Wave;
+
+#endif //_WAVE_H
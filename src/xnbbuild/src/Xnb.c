@@ -0,0 +1,221 @@
+#if _MSC_VER
+#define _CRT_SECURE_NO_WARNINGS
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Lzx.h"
+#include "Xnb.h"
+
+// The header is "XNB", the target platform, the format version, flags and the size of the whole file.
+#define XNB_HEADER_SIZE 10
+#define XNB_COMPRESSED_HEADER_SIZE 14
+#define XNB_PLATFORM 'w'
+#define XNB_VERSION 5
+#define XNB_FLAG_COMPRESSED 0x80
+
+static void Reserve(Buffer * const buffer, const size_t count)
+{
+	size_t capacity = buffer->capacity;
+
+	if (buffer->length + count <= capacity)
+	{
+		return;
+	}
+
+	if (capacity < 256)
+	{
+		capacity = 256;
+	}
+
+	while (capacity < buffer->length + count)
+	{
+		capacity *= 2;
+	}
+
+	buffer->data = (unsigned char *)realloc(buffer->data, capacity);
+
+	if (buffer->data == NULL)
+	{
+		fprintf(stderr, "xnbbuild: error: out of memory\n");
+		exit(EXIT_FAILURE);
+	}
+
+	buffer->capacity = capacity;
+}
+
+void Xnb_WriteByte(Buffer * const buffer, const int value)
+{
+	Reserve(buffer, 1);
+
+	buffer->data[buffer->length++] = (unsigned char)value;
+}
+
+void Xnb_WriteBytes(Buffer * const buffer, const void * const data, const size_t count)
+{
+	Reserve(buffer, count);
+
+	memcpy(buffer->data + buffer->length, data, count);
+	buffer->length += count;
+}
+
+void Xnb_WriteInt32(Buffer * const buffer, const int value)
+{
+	Reserve(buffer, 4);
+
+	buffer->data[buffer->length++] = (unsigned char)value;
+	buffer->data[buffer->length++] = (unsigned char)(value >> 8);
+	buffer->data[buffer->length++] = (unsigned char)(value >> 16);
+	buffer->data[buffer->length++] = (unsigned char)(value >> 24);
+}
+
+void Xnb_WriteSingle(Buffer * const buffer, const float value)
+{
+	unsigned int bits;
+
+	memcpy(&bits, &value, sizeof(bits));
+	Xnb_WriteInt32(buffer, (int)bits);
+}
+
+void Xnb_Write7BitEncodedInt(Buffer * const buffer, const int value)
+{
+	unsigned int num = (unsigned int)value;
+
+	while (num >= 0x80)
+	{
+		Xnb_WriteByte(buffer, (int)(num | 0x80));
+		num >>= 7;
+	}
+
+	Xnb_WriteByte(buffer, (int)num);
+}
+
+/**
+ * Writes a character as UTF-8, like BinaryWriter.Write(char).
+ */
+void Xnb_WriteChar(Buffer * const buffer, const int value)
+{
+	if (value < 0x80)
+	{
+		Xnb_WriteByte(buffer, value);
+	}
+	else if (value < 0x800)
+	{
+		Xnb_WriteByte(buffer, 0xC0 | (value >> 6));
+		Xnb_WriteByte(buffer, 0x80 | (value & 0x3F));
+	}
+	else
+	{
+		Xnb_WriteByte(buffer, 0xE0 | (value >> 12));
+		Xnb_WriteByte(buffer, 0x80 | ((value >> 6) & 0x3F));
+		Xnb_WriteByte(buffer, 0x80 | (value & 0x3F));
+	}
+}
+
+/**
+ * Writes a length-prefixed string, like BinaryWriter.Write(string).
+ */
+void Xnb_WriteString(Buffer * const buffer, char const * const value)
+{
+	const size_t length = strlen(value);
+
+	Xnb_Write7BitEncodedInt(buffer, (int)length);
+	Xnb_WriteBytes(buffer, value, length);
+}
+
+void Xnb_Free(Buffer * const buffer)
+{
+	free(buffer->data);
+
+	buffer->data = NULL;
+	buffer->length = 0;
+	buffer->capacity = 0;
+}
+
+static void PutUInt32(unsigned char * const data, const size_t value)
+{
+	data[0] = (unsigned char)value;
+	data[1] = (unsigned char)(value >> 8);
+	data[2] = (unsigned char)(value >> 16);
+	data[3] = (unsigned char)(value >> 24);
+}
+
+/**
+ * Writes an .xnb file containing body, which holds the type readers, shared resource count and primary asset.
+ *
+ * @param compress
+ * Non-zero to LZX compress the body. The file is stored uncompressed if that doesn't make it smaller.
+ *
+ * @return
+ * 0 on success.
+ */
+int Xnb_WriteFile(char const * const path, const Buffer * const body, const int compress)
+{
+	Buffer file = { NULL, 0, 0 };
+	FILE * fp = NULL;
+	size_t length = 0;
+	size_t written = 0;
+
+	Reserve(&file, XNB_COMPRESSED_HEADER_SIZE + body->length);
+	memset(file.data, 0, XNB_COMPRESSED_HEADER_SIZE);
+	file.data[0] = 'X';
+	file.data[1] = 'N';
+	file.data[2] = 'B';
+	file.data[3] = XNB_PLATFORM;
+	file.data[4] = XNB_VERSION;
+
+	if (compress)
+	{
+		file.length = XNB_COMPRESSED_HEADER_SIZE;
+
+		if (Lzx.Compress(body->data, body->length, &file) != 0 || file.length >= XNB_HEADER_SIZE + body->length)
+		{
+			file.length = 0;
+		}
+		else
+		{
+			file.data[5] = XNB_FLAG_COMPRESSED;
+			PutUInt32(file.data + 10, body->length);
+		}
+	}
+
+	if (file.length == 0)
+	{
+		file.length = XNB_HEADER_SIZE;
+		Xnb_WriteBytes(&file, body->data, body->length);
+	}
+
+	length = file.length;
+	PutUInt32(file.data + 6, length);
+
+	fp = fopen(path, "wb");
+
+	if (fp != NULL)
+	{
+		written = fwrite(file.data, 1, length, fp);
+
+		if (fclose(fp) != 0)
+		{
+			written = 0;
+		}
+	}
+
+	Xnb_Free(&file);
+
+	return (written == length) ? 0 : -1;
+}
+
+struct _xnb Xnb =
+{
+	Xnb_WriteByte,
+	Xnb_WriteBytes,
+	Xnb_WriteInt32,
+	Xnb_WriteSingle,
+	Xnb_Write7BitEncodedInt,
+	Xnb_WriteChar,
+	Xnb_WriteString,
+	Xnb_WriteFile,
+	Xnb_Free
+};
@@ -0,0 +1,34 @@
+#ifndef _XNB_H
+#define _XNB_H
+
+#include <stddef.h>
+
+/**
+ * A growable block of memory that content is serialized into.
+ */
+typedef struct _buffer
+{
+	unsigned char * data;
+	size_t length;
+	size_t capacity;
+} Buffer;
+
+/**
+ * Writes values in the little-endian layout read by BinaryReader and ContentReader, and wraps finished content in an .xnb file.
+ */
+struct _xnb
+{
+	void (*WriteByte)(Buffer * const, const int);
+	void (*WriteBytes)(Buffer * const, const void * const, const size_t);
+	void (*WriteInt32)(Buffer * const, const int);
+	void (*WriteSingle)(Buffer * const, const float);
+	void (*Write7BitEncodedInt)(Buffer * const, const int);
+	void (*WriteChar)(Buffer * const, const int);
+	void (*WriteString)(Buffer * const, char const * const);
+	int (*WriteFile)(char const * const, const Buffer * const, const int);
+	void (*Free)(Buffer * const);
+};
+
+extern struct _xnb Xnb;
+
+#endif //_XNB_H
@@ -2,14 +2,393 @@
 #define _CRT_SECURE_NO_WARNINGS
 #endif
 
-#include <assert.h>
-#include <errno.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
+#if _WIN32
+#include <direct.h>
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+#endif
+
+#include "Manifest.h"
 #include "Path.h"
-#include "TryCatchFinally.h"
+#include "Processors.h"
+#include "Xnb.h"
+
+#define MAX_JOBS 64
+
+typedef enum _jobResult
+{
+	JOB_FAILED,
+	JOB_BUILT,
+	JOB_UP_TO_DATE
+} JobResult;
+
+/**
+ * One input file, which is built by whichever worker thread takes it first.
+ */
+typedef struct _job
+{
+	const char * input;
+	const char * output;
+	int font;
+	ContentHash hash;
+	JobResult result;
+} Job;
+
+static Job * jobs = NULL;
+static int jobCount = 0;
+static int compress = 0;
+static int dxt = 0;
+static int rebuild = 0;
+static BuildManifest manifest;
+
+#if _WIN32
+static volatile LONG nextJob = 0;
+static CRITICAL_SECTION consoleLock;
+#else
+static int nextJob = 0;
+static pthread_mutex_t jobLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_mutex_t consoleLock = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+/**
+ * Returns the index of the next job to build, or jobCount once every job has been taken.
+ */
+static int TakeJob()
+{
+#if _WIN32
+	return (int)InterlockedIncrement(&nextJob) - 1;
+#else
+	int index;
+
+	pthread_mutex_lock(&jobLock);
+	index = nextJob++;
+	pthread_mutex_unlock(&jobLock);
+
+	return index;
+#endif
+}
+
+/**
+ * Prints a line to stdout, or stderr for errors, without interleaving it with the output of other workers.
+ */
+static void PrintResult(const Job * const job, const char * const error)
+{
+#if _WIN32
+	EnterCriticalSection(&consoleLock);
+#else
+	pthread_mutex_lock(&consoleLock);
+#endif
+
+	switch (job->result)
+	{
+	case JOB_BUILT:
+		printf("%s -> %s\n", job->input, job->output);
+		break;
+	case JOB_UP_TO_DATE:
+		printf("%s is up to date\n", job->input);
+		break;
+	default:
+		fprintf(stderr, "xnbbuild: error: %s: %s\n", job->input, error);
+		break;
+	}
+
+#if _WIN32
+	LeaveCriticalSection(&consoleLock);
+#else
+	pthread_mutex_unlock(&consoleLock);
+#endif
+}
+
+static int EqualsIgnoreCase(char const * const str1, char const * const str2)
+{
+	size_t i;
+
+	for (i = 0; str1[i] != '\0' || str2[i] != '\0'; i++)
+	{
+		char c1 = str1[i];
+		char c2 = str2[i];
+
+		if (c1 >= 'A' && c1 <= 'Z')
+		{
+			c1 += 'a' - 'A';
+		}
+
+		if (c2 >= 'A' && c2 <= 'Z')
+		{
+			c2 += 'a' - 'A';
+		}
+
+		if (c1 != c2)
+		{
+			return 0;
+		}
+	}
+
+	return 1;
+}
+
+/**
+ * Reads a whole file into memory.
+ *
+ * @return
+ * The contents of the file, allocated with malloc, or NULL if it could not be read.
+ */
+static unsigned char * ReadAllBytes(char const * const path, size_t * const length)
+{
+	FILE * fp = fopen(path, "rb");
+	unsigned char * data = NULL;
+	long size = 0;
+
+	if (fp == NULL)
+	{
+		return NULL;
+	}
+
+	if (fseek(fp, 0, SEEK_END) == 0 && (size = ftell(fp)) >= 0 && fseek(fp, 0, SEEK_SET) == 0)
+	{
+		// one extra byte, so that an empty file doesn't return NULL
+		data = (unsigned char *)malloc((size_t)size + 1);
+
+		if (data != NULL && fread(data, 1, (size_t)size, fp) != (size_t)size)
+		{
+			free(data);
+			data = NULL;
+		}
+	}
+
+	fclose(fp);
+
+	*length = (size_t)size;
+
+	return data;
+}
+
+static int FileExists(char const * const path)
+{
+	FILE * fp = fopen(path, "rb");
+
+	if (fp == NULL)
+	{
+		return 0;
+	}
+
+	fclose(fp);
+	return 1;
+}
+
+/**
+ * Builds one input: reads it once, hashes it, and unless the manifest shows the output to be up to date, processes it and writes the .xnb file.
+ */
+static const char * BuildJob(Job * const job)
+{
+	const char * extension = Path.GetExtension(job->input);
+	const char * options = NULL;
+	const char * error = NULL;
+	const ManifestEntry * entry = NULL;
+	unsigned char * data = NULL;
+	size_t length = 0;
+	Buffer body = { NULL, 0, 0 };
+	int isTexture = 0;
+	int isSound = 0;
+
+	job->result = JOB_FAILED;
+
+	isTexture = EqualsIgnoreCase(extension, "png") || EqualsIgnoreCase(extension, "tga");
+	isSound = EqualsIgnoreCase(extension, "wav");
+	free((void *)extension);
+
+	if (isSound)
+	{
+		options = compress ? "sound compress" : "sound";
+	}
+	else if (isTexture && job->font)
+	{
+		options = compress ? "font compress" : "font";
+	}
+	else if (isTexture)
+	{
+		options = dxt ? (compress ? "texture dxt compress" : "texture dxt") : (compress ? "texture compress" : "texture");
+	}
+	else
+	{
+		return "unsupported file type; expected .png, .tga or .wav";
+	}
+
+	if ((data = ReadAllBytes(job->input, &length)) == NULL)
+	{
+		return "could not read the file";
+	}
+
+	job->hash = Manifest.Hash(data, length, options);
+
+	// the manifest is only read while the workers run, and only updated once they have finished
+	entry = Manifest.Find(&manifest, job->input);
+
+	if (!rebuild && entry != NULL && entry->hash == job->hash && FileExists(job->output))
+	{
+		free(data);
+		job->result = JOB_UP_TO_DATE;
+		return NULL;
+	}
+
+	if (isSound)
+	{
+		error = Processors.SoundEffect(data, length, &body);
+	}
+	else if (job->font)
+	{
+		error = Processors.SpriteFont(data, length, &body);
+	}
+	else
+	{
+		error = Processors.Texture(data, length, dxt, &body);
+	}
+
+	free(data);
+
+	if (error == NULL)
+	{
+		if (Xnb.WriteFile(job->output, &body, compress) == 0)
+		{
+			job->result = JOB_BUILT;
+		}
+		else
+		{
+			error = "could not write the output file";
+		}
+	}
+
+	Xnb.Free(&body);
+
+	return error;
+}
+
+#if _WIN32
+static DWORD WINAPI Worker(LPVOID parameter)
+#else
+static void * Worker(void * parameter)
+#endif
+{
+	int index;
+
+	(void)parameter;
+
+	while ((index = TakeJob()) < jobCount)
+	{
+		const char * error = BuildJob(&jobs[index]);
+
+		PrintResult(&jobs[index], error);
+	}
+
+	return 0;
+}
+
+static int GetProcessorCount()
+{
+#if _WIN32
+	SYSTEM_INFO info;
+
+	GetSystemInfo(&info);
+	return (int)info.dwNumberOfProcessors;
+#else
+	long count = sysconf(_SC_NPROCESSORS_ONLN);
+
+	return (count > 0) ? (int)count : 1;
+#endif
+}
+
+/**
+ * Runs the workers, reusing the calling thread as one of them.
+ */
+static void RunWorkers(const int threadCount)
+{
+#if _WIN32
+	HANDLE threads[MAX_JOBS];
+	int i;
+	int started = 0;
+
+	InitializeCriticalSection(&consoleLock);
+
+	for (i = 1; i < threadCount; i++)
+	{
+		if ((threads[started] = CreateThread(NULL, 0, Worker, NULL, 0, NULL)) != NULL)
+		{
+			started++;
+		}
+	}
+
+	Worker(NULL);
+
+	if (started > 0)
+	{
+		WaitForMultipleObjects((DWORD)started, threads, TRUE, INFINITE);
+	}
+
+	for (i = 0; i < started; i++)
+	{
+		CloseHandle(threads[i]);
+	}
+
+	DeleteCriticalSection(&consoleLock);
+#else
+	pthread_t threads[MAX_JOBS];
+	int i;
+	int started = 0;
+
+	for (i = 1; i < threadCount; i++)
+	{
+		if (pthread_create(&threads[started], NULL, Worker, NULL) == 0)
+		{
+			started++;
+		}
+	}
+
+	Worker(NULL);
+
+	for (i = 0; i < started; i++)
+	{
+		pthread_join(threads[i], NULL);
+	}
+#endif
+}
+
+static void MakeDirectory(char const * const path)
+{
+	if (path[0] == '\0')
+	{
+		return;
+	}
+
+	// fails harmlessly if the directory already exists; a missing directory shows up when the outputs are written
+#if _WIN32
+	_mkdir(path);
+#else
+	mkdir(path, 0777);
+#endif
+}
+
+static void PrintUsage()
+{
+	printf("Usage: xnbbuild [-outdir <directory>] [-compress] [-dxt] [-jobs <count>] [-rebuild] [[-font] <file>]...\n");
+	printf("\n");
+	printf("Builds .png and .tga files into Texture2D and .wav files into SoundEffect .xnb files.\n");
+	printf("\n");
+	printf("  -outdir <directory>  Write the .xnb files to directory instead of the current directory.\n");
+	printf("  -compress            LZX compress the .xnb files.\n");
+	printf("  -dxt                 Compress textures to DXT1, or DXT5 if they have transparency.\n");
+	printf("  -jobs <count>        Build count files at once. Defaults to the number of processors.\n");
+	printf("  -rebuild             Build every file, even if it hasn't changed since the last build.\n");
+	printf("  -font                Build the next file into a SpriteFont. The glyphs of the characters\n");
+	printf("                       from ' ' onwards are laid out in reading order, separated by magenta.\n");
+}
 
 /**
  * Application entry point
@@ -25,38 +404,132 @@
  */
 int main(int argc, char** argv)
 {
-	FILE *fpIn = NULL;
-	FILE *fpOut = NULL;
-	const char * inFile = NULL;
-	const char * outDir = NULL;
+	const char * outDir = "";
+	int threadCount = 0;
+	int font = 0;
+	int failed = 0;
 	int i;
 
-	if (argc == 0)
+	jobs = (Job *)calloc((size_t)argc, sizeof(Job));
+
+	if (jobs == NULL)
 	{
-		printf("");
+		fprintf(stderr, "xnbbuild: error: out of memory\n");
+		return EXIT_FAILURE;
 	}
 
-	for (i = 0; i < argc; i++)
+	for (i = 1; i < argc; i++)
 	{
-		if (strncmp(argv[i], "-outdir", 7) == 0)
+		if (strcmp(argv[i], "-outdir") == 0 && i + 1 < argc)
+		{
+			outDir = argv[++i];
+		}
+		else if (strcmp(argv[i], "-jobs") == 0 && i + 1 < argc)
+		{
+			threadCount = atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "-compress") == 0)
+		{
+			compress = 1;
+		}
+		else if (strcmp(argv[i], "-dxt") == 0)
 		{
-			
+			dxt = 1;
 		}
+		else if (strcmp(argv[i], "-rebuild") == 0)
+		{
+			rebuild = 1;
+		}
+		else if (strcmp(argv[i], "-font") == 0)
+		{
+			font = 1;
+		}
+		else if (argv[i][0] == '-')
+		{
+			fprintf(stderr, "xnbbuild: error: unknown option %s\n", argv[i]);
+			PrintUsage();
+			return EXIT_FAILURE;
+		}
+		else
+		{
+			jobs[jobCount].input = argv[i];
+			jobs[jobCount].font = font;
+			jobCount++;
+			font = 0;
+		}
+	}
+
+	if (jobCount == 0)
+	{
+		PrintUsage();
+		return EXIT_FAILURE;
+	}
+
+	for (i = 0; i < jobCount; i++)
+	{
+		const char * name = Path.GetFileNameWithoutExtension(jobs[i].input);
+		char * fileName = (char *)malloc(strlen(name) + 5);
 
-		if (argc > 0)
+		if (fileName == NULL)
 		{
-			inFile = Path.GetFileName(argv[argc - 1]);
+			fprintf(stderr, "xnbbuild: error: out of memory\n");
+			return EXIT_FAILURE;
 		}
+
+		sprintf(fileName, "%s.xnb", name);
+		jobs[i].output = Path.Combine(outDir, fileName);
+
+		free(fileName);
+		free((void *)name);
 	}
 
-	TRY
-		fpIn = fopen(inFile, "rb");
-		fpOut = fopen(Path.Combine(outDir, inFile), "wb");
+	if (threadCount <= 0)
+	{
+		threadCount = GetProcessorCount();
+	}
 
+	if (threadCount > jobCount)
+	{
+		threadCount = jobCount;
+	}
 
-	FINALLY
-		break;
-	ETRY;
+	if (threadCount > MAX_JOBS)
+	{
+		threadCount = MAX_JOBS;
+	}
 
-	return 0;
+	MakeDirectory(outDir);
+	Manifest.Load(outDir, &manifest);
+
+	RunWorkers(threadCount);
+
+	// inputs that weren't part of this build keep their entries; failed ones lose theirs so they are built again next time
+	for (i = 0; i < jobCount; i++)
+	{
+		if (jobs[i].result == JOB_FAILED)
+		{
+			Manifest.Remove(&manifest, jobs[i].input);
+			failed++;
+		}
+		else
+		{
+			Manifest.Set(&manifest, jobs[i].input, jobs[i].hash);
+		}
+	}
+
+	if (Manifest.Save(outDir, &manifest) != 0)
+	{
+		fprintf(stderr, "xnbbuild: warning: could not save the build manifest; everything will be rebuilt next time\n");
+	}
+
+	Manifest.Free(&manifest);
+
+	for (i = 0; i < jobCount; i++)
+	{
+		free((void *)jobs[i].output);
+	}
+
+	free(jobs);
+
+	return (failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
 }
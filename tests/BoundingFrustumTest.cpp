@@ -0,0 +1,187 @@
+// Copyright (C) XFX Team
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without 
+// modification, are permitted provided that the following conditions are met:
+// 
+//* Redistributions of source code must retain the above copyright 
+//notice, this list of conditions and the following disclaimer.
+//* Redistributions in binary form must reproduce the above copyright 
+//notice, this list of conditions and the following disclaimer in the 
+//documentation and/or other materials provided with the distribution.
+//* Neither the name of the copyright holder nor the names of any 
+//contributors may be used to endorse or promote products derived from 
+//this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE 
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF 
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS 
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE 
+// POSSIBILITY OF SUCH DAMAGE.
+
+// Checks that the batched BoundingFrustum::Cull overloads agree with Contains for every box and sphere,
+// with and without the lastPlane cache and for counts that leave a scalar tail after the groups of four.
+
+#include <BoundingBox.h>
+#include <BoundingFrustum.h>
+#include <BoundingSphere.h>
+#include <Matrix.h>
+#include <Plane.h>
+
+#include "HostTest.h"
+
+using namespace XFX;
+
+static const int MaxCount = 67;
+
+static unsigned int seed = 12345;
+static int culled, total;
+
+static float Random(const float range)
+{
+	seed = seed * 1103515245 + 12345;
+	return ((int)(seed >> 8) % 2001 - 1000) * (range / 1000.0f);
+}
+
+// A camera inside the scene looking towards its middle, with a far plane that cuts through it.
+static BoundingFrustum RandomFrustum()
+{
+	const Vector3 position(Random(20.0f), Random(20.0f), Random(20.0f));
+	const Vector3 target(Random(5.0f), Random(5.0f), Random(5.0f));
+
+	return BoundingFrustum(Matrix::CreateLookAt(position, target, Vector3::Up) *
+		Matrix::CreatePerspectiveFieldOfView(1.0f + Random(0.3f), 1.0f + Random(0.5f), 0.5f, 30.0f + Random(10.0f)));
+}
+
+// The planes in the order of the frustum's internal array, which lastPlane indexes.
+static Plane PlaneAt(BoundingFrustum& frustum, const int index)
+{
+	switch (index)
+	{
+	case 0:
+		return frustum.Near();
+	case 1:
+		return frustum.Far();
+	case 2:
+		return frustum.Left();
+	case 3:
+		return frustum.Right();
+	case 4:
+		return frustum.Top();
+	default:
+		return frustum.Bottom();
+	}
+}
+
+static bool Visible(const uint visibility[], const int i)
+{
+	return (visibility[i >> 5] & (1u << (i & 31))) != 0;
+}
+
+// Bits past count must be left clear.
+static bool TailClear(const uint visibility[], const int count)
+{
+	return (count & 31) == 0 || (visibility[count >> 5] >> (count & 31)) == 0;
+}
+
+static void CheckBoxes(BoundingFrustum& frustum, const int count, byte lastPlane[])
+{
+	float minX[MaxCount], minY[MaxCount], minZ[MaxCount], maxX[MaxCount], maxY[MaxCount], maxZ[MaxCount];
+	uint visibility[(MaxCount + 31) / 32];
+
+	for (int i = 0; i < count; i++)
+	{
+		minX[i] = Random(15.0f);
+		minY[i] = Random(15.0f);
+		minZ[i] = Random(15.0f);
+		maxX[i] = minX[i] + 0.1f + Random(3.0f) + 3.0f;
+		maxY[i] = minY[i] + 0.1f + Random(3.0f) + 3.0f;
+		maxZ[i] = minZ[i] + 0.1f + Random(3.0f) + 3.0f;
+	}
+
+	frustum.Cull(minX, minY, minZ, maxX, maxY, maxZ, count, visibility, lastPlane);
+	CHECK(TailClear(visibility, count));
+
+	for (int i = 0; i < count; i++)
+	{
+		const BoundingBox box(Vector3(minX[i], minY[i], minZ[i]), Vector3(maxX[i], maxY[i], maxZ[i]));
+		const bool visible = frustum.Contains(box) != ContainmentType::Disjoint;
+
+		CHECK(Visible(visibility, i) == visible);
+		culled += !visible;
+		total++;
+
+		// The cached plane is one that rejects the box.
+		if (!visible && lastPlane != null)
+		{
+			CHECK(lastPlane[i] < 6 && box.Intersects(PlaneAt(frustum, lastPlane[i])) == PlaneIntersectionType::Front);
+		}
+	}
+}
+
+static void CheckSpheres(BoundingFrustum& frustum, const int count, byte lastPlane[])
+{
+	float x[MaxCount], y[MaxCount], z[MaxCount], radius[MaxCount];
+	uint visibility[(MaxCount + 31) / 32];
+
+	for (int i = 0; i < count; i++)
+	{
+		x[i] = Random(15.0f);
+		y[i] = Random(15.0f);
+		z[i] = Random(15.0f);
+		radius[i] = 0.1f + Random(2.0f) + 2.0f;
+	}
+
+	frustum.Cull(x, y, z, radius, count, visibility, lastPlane);
+	CHECK(TailClear(visibility, count));
+
+	for (int i = 0; i < count; i++)
+	{
+		const BoundingSphere sphere(Vector3(x[i], y[i], z[i]), radius[i]);
+		const bool visible = frustum.Contains(sphere) != ContainmentType::Disjoint;
+
+		CHECK(Visible(visibility, i) == visible);
+
+		if (!visible && lastPlane != null)
+		{
+			CHECK(lastPlane[i] < 6 && PlaneAt(frustum, lastPlane[i]).DotCoordinate(sphere.Center) > radius[i]);
+		}
+	}
+}
+
+int main()
+{
+	byte lastPlane[MaxCount];
+
+	for (int pass = 0; pass < 200; pass++)
+	{
+		BoundingFrustum frustum = RandomFrustum();
+
+		for (int count = 0; count <= MaxCount; count++)
+		{
+			CheckBoxes(frustum, count, null);
+			CheckSpheres(frustum, count, null);
+
+			// A cache left by another frustum and other objects, as when the camera moves: any plane index may come first.
+			for (int i = 0; i < count; i++)
+			{
+				seed = seed * 1103515245 + 12345;
+				lastPlane[i] = (byte)((seed >> 8) % 6);
+			}
+
+			CheckBoxes(frustum, count, lastPlane);
+			CheckSpheres(frustum, count, lastPlane);
+		}
+	}
+
+	// The scene is neither all visible nor all culled.
+	CHECK(culled > total / 10 && culled < total - total / 10);
+
+	return HostTestResult("BoundingFrustumTest");
+}
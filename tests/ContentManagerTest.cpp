@@ -0,0 +1,295 @@
+// Copyright (C) XFX Team
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without 
+// modification, are permitted provided that the following conditions are met:
+// 
+//* Redistributions of source code must retain the above copyright 
+//notice, this list of conditions and the following disclaimer.
+//* Redistributions in binary form must reproduce the above copyright 
+//notice, this list of conditions and the following disclaimer in the 
+//documentation and/or other materials provided with the distribution.
+//* Neither the name of the copyright holder nor the names of any 
+//contributors may be used to endorse or promote products derived from 
+//this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE 
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF 
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS 
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE 
+// POSSIBILITY OF SUCH DAMAGE.
+
+// Loads assets through ContentManager::Load and LoadAsync, and checks that every spelling of a path shares one cache entry,
+// that the entries are reference counted, and that asynchronous loads are handed back at the next DispatchCompletedLoads.
+
+#include <Content/ContentManager.h>
+#include <Content/ContentReader.h>
+#include <System/Type.h>
+
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "HostTest.h"
+
+using namespace XFX::Content;
+
+static int reads, disposes, deletes;
+
+// A small asset type, and the reader ContentManager reads it with.
+class TestAsset : public IDisposable
+{
+public:
+	int Value;
+
+	TestAsset(const int value)
+		: Value(value)
+	{
+	}
+
+	~TestAsset()
+	{
+		deletes++;
+	}
+
+	void Dispose()
+	{
+		disposes++;
+	}
+
+	static const Type& GetType()
+	{
+		static const Type TestAssetTypeInfo("TestAsset", "TestAsset", TypeCode::Object);
+
+		return TestAssetTypeInfo;
+	}
+};
+
+// Another type, with no reader, to check that the type a cached asset is requested as must match.
+class OtherAsset
+{
+public:
+	static const Type& GetType()
+	{
+		static const Type OtherAssetTypeInfo("OtherAsset", "OtherAsset", TypeCode::Object);
+
+		return OtherAssetTypeInfo;
+	}
+};
+
+namespace XFX
+{
+	namespace Content
+	{
+		template <>
+		struct ContentTypeReaderFor<TestAsset>
+		{
+			static TestAsset* Read(ContentReader * const input, TestAsset* existingInstance)
+			{
+				reads++;
+				return new TestAsset(input->ReadInt32());
+			}
+		};
+
+		template <>
+		struct ContentTypeReaderFor<OtherAsset>
+		{
+			static OtherAsset* Read(ContentReader * const input, OtherAsset* existingInstance)
+			{
+				return new OtherAsset();
+			}
+		};
+	}
+}
+
+class TestServiceProvider : public IServiceProvider
+{
+public:
+	Object* GetService(const Type& serviceType)
+	{
+		return null;
+	}
+};
+
+// An uncompressed .xnb file holding one TestAsset: the header, the type reader table, no shared resources, then the asset.
+static void WriteAsset(const char path[], const int value)
+{
+	static const char readerName[] = "TestAssetReader";
+	FILE* file = fopen(path, "wb");
+	const int size = 10 + 1 + 1 + (sizeof(readerName) - 1) + 4 + 1 + 1 + 4;
+	const int version = 0;
+
+	fwrite("XNBx\x05\x00", 1, 6, file);
+	fwrite(&size, sizeof(size), 1, file);
+	fputc(1, file);
+	fputc(sizeof(readerName) - 1, file);
+	fwrite(readerName, 1, sizeof(readerName) - 1, file);
+	fwrite(&version, sizeof(version), 1, file);
+	fputc(0, file);
+	fputc(1, file);
+	fwrite(&value, sizeof(value), 1, file);
+	fclose(file);
+}
+
+static TestAsset* callbackAsset;
+static Object* callbackState;
+static int callbacks;
+
+// Callbacks usually end the load themselves, as this one does.
+static void LoadCompleted(IAsyncResult* asyncResult)
+{
+	callbacks++;
+	callbackState = asyncResult->AsyncState();
+	callbackAsset = ((ContentManager*)asyncResult->AsyncState())->EndLoad<TestAsset>(asyncResult);
+}
+
+static void CheckLoad(ContentManager& content)
+{
+	reads = disposes = deletes = 0;
+
+	// Every spelling of a path is one cache entry, and the asset is read once.
+	TestAsset* asset = content.Load<TestAsset>("first");
+
+	CHECK(asset != null && asset->Value == 1);
+	CHECK(content.Load<TestAsset>("./first") == asset);
+	CHECK(content.Load<TestAsset>("sub/../first") == asset);
+	CHECK(content.Load<TestAsset>("sub\\..\\.\\first") == asset);
+	CHECK(reads == 1);
+
+	TestAsset* second = content.Load<TestAsset>("sub/second");
+
+	CHECK(second != null && second != asset && second->Value == 2);
+	CHECK(content.Load<TestAsset>("sub\\second") == second);
+	CHECK(content.Load<TestAsset>("sub//second") == second);
+	CHECK(content.Load<TestAsset>("other/../sub/./second") == second);
+	CHECK(reads == 2);
+
+	// The asset is freed with its last reference, whatever path each one was taken with.
+	content.UnloadAsset("first");
+	content.UnloadAsset("./first");
+	content.UnloadAsset("sub/../first");
+	CHECK(disposes == 0 && deletes == 0);
+
+	content.UnloadAsset("first");
+	CHECK(disposes == 1 && deletes == 1);
+
+	// Unloading it again does nothing, and loading it again reads a new instance.
+	content.UnloadAsset("first");
+	CHECK(deletes == 1);
+
+	asset = content.Load<TestAsset>("first");
+	CHECK(asset != null && asset->Value == 1 && reads == 3);
+
+	// A cached asset cannot be loaded as another type.
+	const int asserts = hostAssertFailures;
+
+	content.Load<OtherAsset>("first");
+	CHECK(hostAssertFailures == asserts + 1);
+	hostAssertFailures = asserts;
+
+	// Unload frees every asset, however many references it has.
+	content.Unload();
+	CHECK(disposes == 3 && deletes == 3);
+}
+
+static void CheckLoadAsync(ContentManager& content)
+{
+	reads = disposes = deletes = callbacks = 0;
+	callbackAsset = null;
+
+	// The asset is read off the game thread (here, right away), but only handed over and called back from DispatchCompletedLoads.
+	IAsyncResult* result = content.LoadAsync<TestAsset>("sub/second", LoadCompleted, (Object*)&content);
+
+	CHECK(result != null && !result->IsCompleted() && !result->CompletedSynchronously());
+	CHECK(reads == 1 && callbacks == 0);
+
+	content.DispatchCompletedLoads();
+	CHECK(callbacks == 1 && callbackState == (Object*)&content);
+	CHECK(callbackAsset != null && callbackAsset->Value == 2);
+
+	// Dispatching again calls nothing back, and the asset is now in the cache.
+	content.DispatchCompletedLoads();
+	CHECK(callbacks == 1);
+	CHECK(content.Load<TestAsset>("sub\\second") == callbackAsset && reads == 1);
+
+	// Loading a cached asset completes synchronously, without reading it, but is still called back from DispatchCompletedLoads.
+	TestAsset* second = callbackAsset;
+
+	result = content.LoadAsync<TestAsset>("./sub/second", LoadCompleted, (Object*)&content);
+	CHECK(result->CompletedSynchronously() && callbacks == 1);
+
+	content.DispatchCompletedLoads();
+	CHECK(callbacks == 2 && callbackAsset == second && reads == 1);
+
+	// EndLoad may be called before DispatchCompletedLoads, and without a callback.
+	result = content.LoadAsync<TestAsset>("first", null, null);
+	TestAsset* first = content.EndLoad<TestAsset>(result);
+
+	CHECK(first != null && first->Value == 1 && reads == 2);
+
+	content.DispatchCompletedLoads();
+	CHECK(callbacks == 2);
+
+	// Two loads of an asset that is not cached yet are both read, but only one instance is kept and shared.
+	content.UnloadAsset("first");
+	CHECK(deletes == 1);
+
+	IAsyncResult* a = content.LoadAsync<TestAsset>("first", null, null);
+	IAsyncResult* b = content.LoadAsync<TestAsset>("sub/../first", null, null);
+
+	content.DispatchCompletedLoads();
+	first = content.EndLoad<TestAsset>(a);
+	CHECK(content.EndLoad<TestAsset>(b) == first && first != null);
+	CHECK(reads == 4 && deletes == 2);
+
+	// Three references to the second asset (two loads and a synchronous one), and two to the first.
+	content.UnloadAsset("sub/second");
+	content.UnloadAsset("sub/second");
+	content.UnloadAsset("first");
+	CHECK(deletes == 2);
+
+	content.UnloadAsset("sub/second");
+	content.UnloadAsset("first");
+	CHECK(deletes == 4 && disposes == 4);
+
+	// A load that is still pending is completed and freed by Unload, and then ends with no asset.
+	result = content.LoadAsync<TestAsset>("first", null, null);
+	content.Unload();
+	CHECK(deletes == 5);
+	CHECK(content.EndLoad<TestAsset>(result) == null);
+}
+
+int main()
+{
+	char directory[] = "/tmp/xfx-content-XXXXXX";
+	char cwd[1024];
+
+	CHECK(mkdtemp(directory) != null);
+	CHECK(getcwd(cwd, sizeof(cwd)) != null);
+	CHECK(chdir(directory) == 0);
+
+	// Asset paths are built with the Xbox separator, so on the host the asset in a subdirectory is a file with a backslash in its name.
+	WriteAsset("first.xnb", 1);
+	WriteAsset("sub\\second.xnb", 2);
+
+	TestServiceProvider services;
+	ContentManager content(&services);
+
+	CheckLoad(content);
+	CheckLoadAsync(content);
+
+	content.Dispose();
+
+	unlink("first.xnb");
+	unlink("sub\\second.xnb");
+	CHECK(chdir(cwd) == 0);
+	rmdir(directory);
+
+	return HostTestResult("ContentManagerTest");
+}
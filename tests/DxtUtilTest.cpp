@@ -0,0 +1,339 @@
+// Copyright (C) XFX Team
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without 
+// modification, are permitted provided that the following conditions are met:
+// 
+//* Redistributions of source code must retain the above copyright 
+//notice, this list of conditions and the following disclaimer.
+//* Redistributions in binary form must reproduce the above copyright 
+//notice, this list of conditions and the following disclaimer in the 
+//documentation and/or other materials provided with the distribution.
+//* Neither the name of the copyright holder nor the names of any 
+//contributors may be used to endorse or promote products derived from 
+//this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE 
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF 
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS 
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE 
+// POSSIBILITY OF SUCH DAMAGE.
+
+// Checks DxtUtil against a per-pixel decoder written from the S3TC specification, on hand-made reference blocks and random data,
+// and checks that decoding in ranges of block rows gives the same image as decoding it whole.
+// The encoder must reproduce solid colours that 565 can represent exactly, and stay close to a smooth gradient.
+
+#include "DxtUtil.h"
+
+#include <math.h>
+#include <string.h>
+
+#include "HostTest.h"
+
+using namespace XFX::Graphics;
+
+static unsigned int seed = 12345;
+
+static int Random()
+{
+	seed = seed * 1103515245 + 12345;
+	return (int)(seed >> 8);
+}
+
+static int Expand5(const int value)
+{
+	return (value << 3) | (value >> 2);
+}
+
+static int Expand6(const int value)
+{
+	return (value << 2) | (value >> 4);
+}
+
+// Decodes pixel i of the colour half of a block; DXT3 and DXT5 colours are always in four colour mode.
+static void ReferenceColor(const byte block[], const int i, const bool dxt1, int rgba[4])
+{
+	const int color0 = block[0] | (block[1] << 8);
+	const int color1 = block[2] | (block[3] << 8);
+	const int index = (block[4 + i / 4] >> ((i % 4) * 2)) & 3;
+	const int endpoint0[3] = { Expand5(color0 >> 11), Expand6((color0 >> 5) & 63), Expand5(color0 & 31) };
+	const int endpoint1[3] = { Expand5(color1 >> 11), Expand6((color1 >> 5) & 63), Expand5(color1 & 31) };
+
+	rgba[3] = 255;
+
+	for (int k = 0; k < 3; k++)
+	{
+		if (index == 0)
+			rgba[k] = endpoint0[k];
+		else if (index == 1)
+			rgba[k] = endpoint1[k];
+		else if (color0 > color1 || !dxt1)
+			rgba[k] = (index == 2) ? (2 * endpoint0[k] + endpoint1[k]) / 3 : (endpoint0[k] + 2 * endpoint1[k]) / 3;
+		else if (index == 2)
+			rgba[k] = (endpoint0[k] + endpoint1[k]) / 2;
+		else
+		{
+			rgba[k] = 0;
+			rgba[3] = 0;
+		}
+	}
+}
+
+static int ReferenceAlpha(const byte block[], const int i)
+{
+	unsigned long long bits = 0;
+
+	for (int k = 0; k < 6; k++)
+	{
+		bits |= (unsigned long long)block[2 + k] << (8 * k);
+	}
+
+	const int index = (int)(bits >> (3 * i)) & 7;
+	const int alpha0 = block[0];
+	const int alpha1 = block[1];
+
+	if (index == 0)
+		return alpha0;
+	if (index == 1)
+		return alpha1;
+	if (alpha0 > alpha1)
+		return ((8 - index) * alpha0 + (index - 1) * alpha1) / 7;
+	if (index == 6)
+		return 0;
+	if (index == 7)
+		return 255;
+	return ((6 - index) * alpha0 + (index - 1) * alpha1) / 5;
+}
+
+// format is 1, 3 or 5.
+static void ReferenceDecode(const int format, const byte imageData[], const int width, const int height, byte output[])
+{
+	const int blockSize = (format == 1) ? 8 : 16;
+	const int blocksWide = DxtUtil::GetBlockCount(width);
+
+	for (int by = 0; by < DxtUtil::GetBlockCount(height); by++)
+	{
+		for (int bx = 0; bx < blocksWide; bx++)
+		{
+			const byte* block = &imageData[(by * blocksWide + bx) * blockSize];
+
+			for (int i = 0; i < 16; i++)
+			{
+				const int x = bx * 4 + i % 4;
+				const int y = by * 4 + i / 4;
+				int rgba[4];
+
+				if (x >= width || y >= height)
+					continue;
+
+				if (format == 1)
+				{
+					ReferenceColor(block, i, true, rgba);
+				}
+				else
+				{
+					ReferenceColor(&block[8], i, false, rgba);
+					rgba[3] = (format == 3) ? ((block[i / 2] >> ((i & 1) * 4)) & 15) * 17 : ReferenceAlpha(block, i);
+				}
+
+				for (int k = 0; k < 4; k++)
+				{
+					output[(y * width + x) * 4 + k] = (byte)rgba[k];
+				}
+			}
+		}
+	}
+}
+
+static byte* Decompress(const int format, const byte imageData[], const int width, const int height)
+{
+	switch (format)
+	{
+	case 1:
+		return DxtUtil::DecompressDxt1(imageData, width, height);
+	case 3:
+		return DxtUtil::DecompressDxt3(imageData, width, height);
+	default:
+		return DxtUtil::DecompressDxt5(imageData, width, height);
+	}
+}
+
+static void Decompress(const int format, const byte imageData[], const int width, const int height, byte output[], const int firstBlockRow, const int blockRowCount)
+{
+	switch (format)
+	{
+	case 1:
+		DxtUtil::DecompressDxt1(imageData, width, height, output, firstBlockRow, blockRowCount);
+		break;
+	case 3:
+		DxtUtil::DecompressDxt3(imageData, width, height, output, firstBlockRow, blockRowCount);
+		break;
+	default:
+		DxtUtil::DecompressDxt5(imageData, width, height, output, firstBlockRow, blockRowCount);
+		break;
+	}
+}
+
+static void CheckReferenceBlocks()
+{
+	// Red and blue endpoints, indices 0 to 3 in every row.
+	const byte fourColor[8] = { 0x00, 0xF8, 0x1F, 0x00, 0xE4, 0xE4, 0xE4, 0xE4 };
+	const byte fourColorRow[16] = { 255, 0, 0, 255, 0, 0, 255, 255, 170, 0, 85, 255, 85, 0, 170, 255 };
+	// color0 < color1 selects three colours and transparent black.
+	const byte threeColor[8] = { 0x1F, 0x00, 0x00, 0xF8, 0xE4, 0xE4, 0xE4, 0xE4 };
+	const byte threeColorRow[16] = { 0, 0, 255, 255, 255, 0, 0, 255, 127, 0, 127, 255, 0, 0, 0, 0 };
+	// Alpha 255 to 0 with indices 0 to 7 twice, over red.
+	const byte interpolatedAlpha[16] = { 255, 0, 0x88, 0xC6, 0xFA, 0x88, 0xC6, 0xFA, 0xFF, 0xFF, 0xFF, 0xFF, 0, 0, 0, 0 };
+	const byte interpolatedAlphas[8] = { 255, 0, 218, 182, 145, 109, 72, 36 };
+
+	byte* output = DxtUtil::DecompressDxt1(fourColor, 4, 4);
+	for (int y = 0; y < 4; y++)
+	{
+		CHECK(memcmp(&output[y * 16], fourColorRow, 16) == 0);
+	}
+	delete[] output;
+
+	output = DxtUtil::DecompressDxt1(threeColor, 4, 4);
+	for (int y = 0; y < 4; y++)
+	{
+		CHECK(memcmp(&output[y * 16], threeColorRow, 16) == 0);
+	}
+	delete[] output;
+
+	output = DxtUtil::DecompressDxt5(interpolatedAlpha, 4, 4);
+	for (int i = 0; i < 16; i++)
+	{
+		CHECK(output[i * 4] == 255 && output[i * 4 + 3] == interpolatedAlphas[i % 8]);
+	}
+	delete[] output;
+}
+
+// Decodes random blocks, whole and two block rows at a time, at sizes that are and aren't multiples of 4.
+static void CheckRandomBlocks()
+{
+	static const int sizes[][2] = { { 1, 1 }, { 2, 2 }, { 3, 5 }, { 4, 4 }, { 7, 9 }, { 16, 16 }, { 33, 17 }, { 64, 128 }, { 255, 3 } };
+
+	for (int pass = 0; pass < 50; pass++)
+	{
+		for (unsigned int s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++)
+		{
+			const int width = sizes[s][0];
+			const int height = sizes[s][1];
+
+			for (int format = 1; format <= 5; format += 2)
+			{
+				const int length = DxtUtil::GetCompressedSize(width, height, (format == 1) ? 8 : 16);
+				byte* imageData = new byte[length];
+				byte* expected = new byte[width * height * 4];
+				byte* rows = new byte[width * height * 4];
+
+				for (int i = 0; i < length; i++)
+				{
+					imageData[i] = (byte)Random();
+				}
+
+				ReferenceDecode(format, imageData, width, height, expected);
+
+				byte* output = Decompress(format, imageData, width, height);
+				CHECK(memcmp(output, expected, width * height * 4) == 0);
+				delete[] output;
+
+				// The last range runs past the image.
+				memset(rows, 0xCD, width * height * 4);
+				for (int row = 0; row < DxtUtil::GetBlockCount(height); row += 2)
+				{
+					Decompress(format, imageData, width, height, rows, row, 2);
+				}
+				CHECK(memcmp(rows, expected, width * height * 4) == 0);
+
+				delete[] imageData;
+				delete[] expected;
+				delete[] rows;
+			}
+		}
+	}
+}
+
+static void CheckEncoder()
+{
+	// 7x5 pixels of a colour 565 represents exactly, which must come back unchanged.
+	byte image[7 * 5 * 4];
+
+	for (int pass = 0; pass < 1000; pass++)
+	{
+		const int color = Random() & 0xFFFF;
+		const byte pixel[4] = { (byte)Expand5(color >> 11), (byte)Expand6((color >> 5) & 63), (byte)Expand5(color & 31), (byte)Random() };
+
+		for (int i = 0; i < 35; i++)
+		{
+			memcpy(&image[i * 4], pixel, 4);
+		}
+
+		byte* compressed = DxtUtil::CompressDxt5(image, 7, 5);
+		byte* output = DxtUtil::DecompressDxt5(compressed, 7, 5);
+		CHECK(memcmp(output, image, sizeof(image)) == 0);
+		delete[] compressed;
+		delete[] output;
+
+		for (int i = 0; i < 35; i++)
+		{
+			image[i * 4 + 3] = 255;
+		}
+
+		compressed = DxtUtil::CompressDxt1(image, 7, 5);
+		output = DxtUtil::DecompressDxt1(compressed, 7, 5);
+		CHECK(memcmp(output, image, sizeof(image)) == 0);
+		delete[] compressed;
+		delete[] output;
+	}
+
+	// A gradient in every channel stays within a few levels.
+	const int size = 256;
+	byte* gradient = new byte[size * size * 4];
+
+	for (int y = 0; y < size; y++)
+	{
+		for (int x = 0; x < size; x++)
+		{
+			byte* pixel = &gradient[(y * size + x) * 4];
+			pixel[0] = (byte)x;
+			pixel[1] = (byte)y;
+			pixel[2] = (byte)((x + y) / 2);
+			pixel[3] = (byte)(x * 3);
+		}
+	}
+
+	byte* compressed = DxtUtil::CompressDxt5(gradient, size, size);
+	byte* output = DxtUtil::DecompressDxt5(compressed, size, size);
+	double squaredError[4] = { 0.0, 0.0, 0.0, 0.0 };
+
+	for (int i = 0; i < size * size * 4; i++)
+	{
+		const double difference = output[i] - gradient[i];
+		squaredError[i & 3] += difference * difference;
+	}
+
+	for (int k = 0; k < 4; k++)
+	{
+		CHECK(sqrt(squaredError[k] / (size * size)) < 4.0);
+	}
+
+	delete[] compressed;
+	delete[] output;
+	delete[] gradient;
+}
+
+int main()
+{
+	CheckReferenceBlocks();
+	CheckRandomBlocks();
+	CheckEncoder();
+
+	return HostTestResult("DxtUtilTest");
+}
@@ -0,0 +1,159 @@
+// Copyright (C) XFX Team
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without 
+// modification, are permitted provided that the following conditions are met:
+// 
+//* Redistributions of source code must retain the above copyright 
+//notice, this list of conditions and the following disclaimer.
+//* Redistributions in binary form must reproduce the above copyright 
+//notice, this list of conditions and the following disclaimer in the 
+//documentation and/or other materials provided with the distribution.
+//* Neither the name of the copyright holder nor the names of any 
+//contributors may be used to endorse or promote products derived from 
+//this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE 
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF 
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS 
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE 
+// POSSIBILITY OF SUCH DAMAGE.
+
+// Checks that BufferNeeded is raised on the thread calling FrameworkDispatcher::Update, never on the audio thread,
+// and that its handlers can submit buffers, stop and dispose of instances while AudioMixer::Render runs.
+
+#include <Audio/AudioMixer.h>
+#include <Audio/DynamicSoundEffectInstance.h>
+#include <FrameworkDispatcher.h>
+
+#include <pthread.h>
+#include <unistd.h>
+
+#include "HostTest.h"
+
+using namespace XFX;
+using namespace XFX::Audio;
+
+static const int BufferBytes = 960;
+
+static pthread_t gameThread;
+static volatile bool rendering;
+static short silence[BufferBytes / 2];
+
+static DynamicSoundEffectInstance* streamed;
+static DynamicSoundEffectInstance* stopping;
+static DynamicSoundEffectInstance* victim;
+static int events, eventsOffGameThread, stopEvents;
+
+static void* RenderThread(void*)
+{
+	short output[256 * 2];
+
+	while (rendering)
+	{
+		AudioMixer::Render(output, 256);
+		usleep(500);
+	}
+
+	return NULL;
+}
+
+static void CheckThread()
+{
+	events++;
+
+	if (!pthread_equal(pthread_self(), gameThread))
+	{
+		eventsOffGameThread++;
+	}
+}
+
+// Keeps three buffers queued.
+static void OnStreamedBufferNeeded(Object* const sender, EventArgs* const e)
+{
+	CheckThread();
+
+	while (streamed->getPendingBufferCount() < 3)
+	{
+		streamed->SubmitBuffer((byte*)silence, 0, BufferBytes);
+	}
+}
+
+// Once dispatched, stops and disposes of its own instance, and of the one dispatched after it, from inside the handler.
+static void OnStoppingBufferNeeded(Object* const sender, EventArgs* const e)
+{
+	CheckThread();
+	stopEvents++;
+
+	// Raised by Play.
+	if (stopEvents == 1)
+	{
+		return;
+	}
+
+	stopping->Stop();
+	((SoundEffectInstance*)stopping)->Dispose();
+
+	if (victim != NULL)
+	{
+		((SoundEffectInstance*)victim)->Dispose();
+		delete victim;
+		victim = NULL;
+	}
+}
+
+int main()
+{
+	gameThread = pthread_self();
+
+	streamed = new DynamicSoundEffectInstance(48000, AudioChannels::Mono);
+	streamed->BufferNeeded += new EventHandler::S(OnStreamedBufferNeeded);
+	victim = new DynamicSoundEffectInstance(24000, AudioChannels::Stereo);
+	// Created last, so that it is dispatched first and victim is the next instance in line.
+	stopping = new DynamicSoundEffectInstance(22050, AudioChannels::Mono);
+	stopping->BufferNeeded += new EventHandler::S(OnStoppingBufferNeeded);
+
+	// Play raises the event itself, on the calling thread.
+	streamed->Play();
+	CHECK(events == 1);
+	CHECK(streamed->getPendingBufferCount() == 3);
+
+	// Never fed: both run dry on the audio thread, and the first update disposes of them.
+	victim->Play();
+	stopping->Play();
+	CHECK(stopEvents == 1);
+
+	rendering = true;
+	pthread_t renderThread;
+	pthread_create(&renderThread, NULL, RenderThread, NULL);
+
+	for (int frame = 0; frame < 500; frame++)
+	{
+		usleep(2000);
+		FrameworkDispatcher::Update();
+	}
+
+	rendering = false;
+	pthread_join(renderThread, NULL);
+
+	CHECK(events > 10);
+	CHECK(eventsOffGameThread == 0);
+	CHECK(stopEvents == 2);
+	CHECK(victim == NULL);
+	CHECK(stopping->getState() == SoundState::Stopped);
+	CHECK(streamed->getState() == SoundState::Playing);
+
+	// The audio thread renders faster than real time, so underruns are expected and only reported.
+	printf("%d events, %d underruns\n", events, streamed->getUnderrunCount());
+
+	delete stopping;
+	delete streamed;
+
+	return HostTestResult("DynamicSoundEffectInstanceTest");
+}
@@ -0,0 +1,348 @@
+// Copyright (C) XFX Team
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without 
+// modification, are permitted provided that the following conditions are met:
+// 
+//* Redistributions of source code must retain the above copyright 
+//notice, this list of conditions and the following disclaimer.
+//* Redistributions in binary form must reproduce the above copyright 
+//notice, this list of conditions and the following disclaimer in the 
+//documentation and/or other materials provided with the distribution.
+//* Neither the name of the copyright holder nor the names of any 
+//contributors may be used to endorse or promote products derived from 
+//this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE 
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF 
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS 
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE 
+// POSSIBILITY OF SUCH DAMAGE.
+
+// Checks the push buffer DrawIndexedPrimitives records: the vertex arrays it binds, and the indices it sends.
+// Also checks that state the registers already hold is not sent again, that the bytes this saves are reported per frame,
+// and that the recorder build links the shader compiler the effects use.
+
+#include <Graphics/BlendState.h>
+#include <Graphics/DepthStencilState.h>
+#include <Graphics/GraphicsDevice.h>
+#include <Graphics/IndexBuffer.h>
+#include <Graphics/PresentationParameters.h>
+#include <Graphics/RasterizerState.h>
+#include <Graphics/SamplerState.h>
+#include <Graphics/VertexBuffer.h>
+#include <Graphics/VertexDeclaration.h>
+#include <Graphics/VertexElement.h>
+
+extern "C"
+{
+#include "pbKit.h"
+}
+
+#include <string.h>
+
+#include "HostTest.h"
+
+using namespace XFX;
+using namespace XFX::Graphics;
+
+static const int MaxIndices = 1024;
+
+// What a stretch of the recorded push buffer did.
+struct Recording
+{
+	int attributesSet;
+	DWORD formats[NV20_TCL_PRIMITIVE_3D_VERTEX_ATTR__SIZE];
+	DWORD pointers[NV20_TCL_PRIMITIVE_3D_VERTEX_ATTR__SIZE];
+	int beginEnds;
+	DWORD begins[4];
+	int indexCount;
+	DWORD indices[MaxIndices];
+	int longestIndexBurst;
+	bool indicesOutsideBeginEnd;
+};
+
+static DWORD Mark()
+{
+	DWORD count;
+	pb_recorded_stream(&count);
+	return count;
+}
+
+static void Parse(const DWORD start, Recording& recording)
+{
+	DWORD count;
+	const DWORD* stream = pb_recorded_stream(&count);
+	const DWORD* p = stream + start;
+	const DWORD* end = stream + count;
+	bool inBeginEnd = false;
+
+	memset(&recording, 0, sizeof(recording));
+
+	while (p < end)
+	{
+		const DWORD header = *(p++);
+		const int n = (header >> 18) & 0x7ff;
+		const DWORD method = header & 0x1ffc;
+		const bool nonIncrement = (header & 0x40000000) != 0;
+
+		for (int i = 0; i < n; i++)
+		{
+			const DWORD m = nonIncrement ? method : method + i * 4;
+			const DWORD value = p[i];
+
+			if (m >= NV20_TCL_PRIMITIVE_3D_VERTEX_ATTR(0) && m < NV20_TCL_PRIMITIVE_3D_VERTEX_ATTR(NV20_TCL_PRIMITIVE_3D_VERTEX_ATTR__SIZE))
+			{
+				recording.formats[(m - NV20_TCL_PRIMITIVE_3D_VERTEX_ATTR(0)) / 4] = value;
+				recording.attributesSet++;
+			}
+			else if (m >= NV20_TCL_PRIMITIVE_3D_VB_POINTER_ATTR0_POS && m < NV20_TCL_PRIMITIVE_3D_VERTEX_ATTR(0))
+			{
+				recording.pointers[(m - NV20_TCL_PRIMITIVE_3D_VB_POINTER_ATTR0_POS) / 4] = value;
+			}
+			else if (m == NV20_TCL_PRIMITIVE_3D_BEGIN_END)
+			{
+				recording.begins[recording.beginEnds++ & 3] = value;
+				inBeginEnd = (value != STOP);
+			}
+			else if (m == NV20_TCL_PRIMITIVE_3D_INDEX_DATA && recording.indexCount + 2 <= MaxIndices)
+			{
+				recording.indices[recording.indexCount++] = value & 0xffff;
+				recording.indices[recording.indexCount++] = value >> 16;
+				recording.indicesOutsideBeginEnd |= !inBeginEnd;
+			}
+			else if (m == NV20_TCL_PRIMITIVE_3D_INDEX_DATA32 && recording.indexCount < MaxIndices)
+			{
+				recording.indices[recording.indexCount++] = value;
+				recording.indicesOutsideBeginEnd |= !inBeginEnd;
+			}
+		}
+
+		if ((method == NV20_TCL_PRIMITIVE_3D_INDEX_DATA || method == NV20_TCL_PRIMITIVE_3D_INDEX_DATA32) && n > recording.longestIndexBurst)
+		{
+			recording.longestIndexBurst = n;
+		}
+
+		p += n;
+	}
+}
+
+// The number of methods recorded since start.
+static int CountMethods(const DWORD start)
+{
+	DWORD count;
+	const DWORD* stream = pb_recorded_stream(&count);
+	const DWORD* p = stream + start;
+	int methods = 0;
+
+	while (p < stream + count)
+	{
+		const int n = (*(p++) >> 18) & 0x7ff;
+
+		methods += n;
+		p += n;
+	}
+
+	return methods;
+}
+
+struct TestVertex
+{
+	float X, Y, Z;
+	float U, V;
+	byte Bones[4];
+};
+
+int main()
+{
+	PresentationParameters presentationParameters;
+	presentationParameters.BackBufferWidth = 640;
+	presentationParameters.BackBufferHeight = 480;
+
+	GraphicsDevice device(null, &presentationParameters);
+
+	const VertexElement elements[] =
+	{
+		VertexElement(0, VertexElementFormat::Vector3, VertexElementUsage::Position, 0),
+		VertexElement(12, VertexElementFormat::Vector2, VertexElementUsage::TextureCoordinate, 0),
+		VertexElement(20, VertexElementFormat::Byte4, VertexElementUsage::BlendIndices, 0)
+	};
+	VertexDeclaration declaration(elements, 3);
+
+	CHECK(declaration.getVertexStride() == (int)sizeof(TestVertex));
+
+	TestVertex vertices[8];
+	TestVertex readBack[8];
+
+	for (int i = 0; i < 8; i++)
+	{
+		vertices[i].X = (float)i;
+		vertices[i].Y = vertices[i].Z = vertices[i].U = vertices[i].V = 0.0f;
+		memset(vertices[i].Bones, i, 4);
+	}
+
+	VertexBuffer vertexBuffer(&device, declaration, 8, BufferUsage::None);
+	vertexBuffer.SetData(vertices, 0, 8);
+	vertexBuffer.GetData(readBack, 0, 8);
+	CHECK(memcmp(vertices, readBack, sizeof(vertices)) == 0);
+
+	ushort shortIndices[7] = { 0, 1, 2, 3, 4, 5, 6 };
+	IndexBuffer shortIndexBuffer(&device, IndexElementSize::SixteenBits, 7, BufferUsage::None);
+	shortIndexBuffer.SetData(shortIndices, 0, 7);
+
+	device.SetVertexBuffer(&vertexBuffer);
+	device.setIndices(&shortIndexBuffer);
+
+	// The used attributes are enabled with the stride of the vertex, and the others disabled.
+	Recording recording;
+	DWORD start = Mark();
+	device.DrawIndexedPrimitives(PrimitiveType::TriangleList, 0, 0, 4, 1, 2);
+	Parse(start, recording);
+
+	const DWORD address = recording.pointers[0];
+
+	CHECK(address != 0);
+	CHECK(recording.pointers[9] == address + 12);
+	CHECK(recording.pointers[11] == address + 20);
+	CHECK(recording.formats[0] == (2 | (3 << 4) | (sizeof(TestVertex) << 8)));
+	CHECK(recording.formats[9] == (2 | (2 << 4) | (sizeof(TestVertex) << 8)));
+	CHECK(recording.formats[11] == (4 | (4 << 4) | (sizeof(TestVertex) << 8)));
+	CHECK(recording.formats[1] == 2);
+	CHECK(recording.beginEnds == 2 && recording.begins[0] == PrimitiveType::TriangleList && recording.begins[1] == STOP);
+	CHECK(recording.indexCount == 6 && !recording.indicesOutsideBeginEnd);
+
+	for (int i = 0; i < recording.indexCount; i++)
+	{
+		CHECK(recording.indices[i] == shortIndices[1 + i]);
+	}
+
+	// The arrays start at vertexOffset + baseVertex, so the indices are sent unchanged.
+	device.SetVertexBuffer(&vertexBuffer, 1);
+
+	start = Mark();
+	device.DrawIndexedPrimitives(PrimitiveType::TriangleList, 2, 0, 4, 1, 2);
+	Parse(start, recording);
+
+	CHECK(recording.pointers[0] == address + 3 * sizeof(TestVertex));
+	CHECK(recording.pointers[9] == address + 3 * sizeof(TestVertex) + 12);
+	CHECK(recording.pointers[11] == address + 3 * sizeof(TestVertex) + 20);
+	CHECK(recording.indexCount == 6 && recording.indices[0] == 1);
+
+	// Drawing again with the same buffers leaves the arrays alone, and an odd 16-bit index is sent on its own.
+	start = Mark();
+	device.DrawIndexedPrimitives(PrimitiveType::TriangleStrip, 2, 0, 4, 2, 1);
+	Parse(start, recording);
+
+	CHECK(recording.attributesSet == 0);
+	CHECK(recording.beginEnds == 2 && recording.begins[0] == PrimitiveType::TriangleStrip && recording.begins[1] == STOP);
+	CHECK(recording.indexCount == 3 && recording.indices[0] == 2 && recording.indices[1] == 3 && recording.indices[2] == 4);
+
+	// 32-bit indices are sent in bursts that keep each push buffer block under 128 dwords.
+	static DWORD longIndices[900];
+
+	for (int i = 0; i < 900; i++)
+	{
+		longIndices[i] = (i * 7) % 70000;
+	}
+
+	IndexBuffer longIndexBuffer(&device, IndexElementSize::ThirtyTwoBits, 900, BufferUsage::None);
+	longIndexBuffer.SetData(longIndices, 0, 900);
+	device.setIndices(&longIndexBuffer);
+
+	start = Mark();
+	device.DrawIndexedPrimitives(PrimitiveType::LineList, 0, 0, 8, 0, 450);
+	Parse(start, recording);
+
+	CHECK(recording.indexCount == 900 && !recording.indicesOutsideBeginEnd);
+	CHECK(recording.longestIndexBurst > 0 && recording.longestIndexBurst < 128);
+	CHECK(memcmp(recording.indices, longIndices, sizeof(longIndices)) == 0);
+
+	// Indices past the end of the buffer are refused.
+	const int asserts = hostAssertFailures;
+	start = Mark();
+	device.DrawIndexedPrimitives(PrimitiveType::TriangleList, 0, 0, 8, 899, 1);
+	Parse(start, recording);
+
+	CHECK(hostAssertFailures == asserts + 1);
+	CHECK(recording.beginEnds == 0);
+	hostAssertFailures = asserts;
+
+	// With nothing known about the registers, applying each state writes them.
+	device.Present();
+	device.InvalidateRenderState();
+
+	start = Mark();
+	device.setBlendState(&BlendState::AlphaBlend);
+	const int blendWrites = CountMethods(start);
+	start = Mark();
+	device.setDepthStencilState(&DepthStencilState::Default);
+	const int depthStencilWrites = CountMethods(start);
+	start = Mark();
+	device.setRasterizerState(&RasterizerState::CullCounterClockwise);
+	const int rasterizerWrites = CountMethods(start);
+	start = Mark();
+	device.ApplySamplerState(0, &SamplerState::LinearClamp);
+	const int samplerWrites = CountMethods(start);
+
+	CHECK(blendWrites > 0 && depthStencilWrites > 0 && rasterizerWrites > 0 && samplerWrites == 2);
+
+	// Applying them again records nothing.
+	const int lastFrameBytesSaved = device.getStateBytesSaved();
+
+	start = Mark();
+	device.setBlendState(&BlendState::AlphaBlend);
+	CHECK(CountMethods(start) == 0);
+	start = Mark();
+	device.setDepthStencilState(&DepthStencilState::Default);
+	CHECK(CountMethods(start) == 0);
+	start = Mark();
+	device.setRasterizerState(&RasterizerState::CullCounterClockwise);
+	CHECK(CountMethods(start) == 0);
+	start = Mark();
+	device.ApplySamplerState(0, &SamplerState::LinearClamp);
+	CHECK(CountMethods(start) == 0);
+
+	// Anisotropic filtering is applied as linear filtering, so it writes nothing over a linear sampler either.
+	start = Mark();
+	device.ApplySamplerState(0, &SamplerState::AnisotropicClamp);
+	CHECK(CountMethods(start) == 0);
+
+	// The writes that were dropped are reported once the frame is presented, and not before.
+	const int droppedWrites = blendWrites + depthStencilWrites + rasterizerWrites + 2 * samplerWrites;
+
+	CHECK(device.getStateBytesSaved() == lastFrameBytesSaved);
+	device.Present();
+	CHECK(device.getStateBytesSaved() == droppedWrites * 2 * (int)sizeof(DWORD));
+
+	// Only the registers that change are written, and the others are counted as saved.
+	start = Mark();
+	device.setBlendState(&BlendState::Additive);
+	const int additiveWrites = CountMethods(start);
+
+	CHECK(additiveWrites > 0 && additiveWrites < blendWrites);
+	device.Present();
+	CHECK(device.getStateBytesSaved() == (blendWrites - additiveWrites) * 2 * (int)sizeof(DWORD));
+
+	// A frame that drops nothing reports nothing.
+	device.Present();
+	CHECK(device.getStateBytesSaved() == 0);
+
+	// mov oPos, v0
+	const DWORD pcode[] =
+	{
+		0xfffe0101,
+		0x00000001, 0x80000000 | (4 << 28) | (15 << 16), 0x80000000 | (1 << 28) | (0xe4 << 16),
+		0x0000ffff
+	};
+	const DWORD* mcode = pb_pcode2mcode(pcode);
+
+	CHECK(mcode != NULL && (mcode[0] & 0xffff) > 0);
+
+	return HostTestResult("GraphicsDeviceTest");
+}
@@ -0,0 +1,190 @@
+// Copyright (C) XFX Team
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without 
+// modification, are permitted provided that the following conditions are met:
+// 
+//* Redistributions of source code must retain the above copyright 
+//notice, this list of conditions and the following disclaimer.
+//* Redistributions in binary form must reproduce the above copyright 
+//notice, this list of conditions and the following disclaimer in the 
+//documentation and/or other materials provided with the distribution.
+//* Neither the name of the copyright holder nor the names of any 
+//contributors may be used to endorse or promote products derived from 
+//this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE 
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF 
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS 
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE 
+// POSSIBILITY OF SUCH DAMAGE.
+
+// Round-trips data through LzxEncoder and LzxDecoder, frame by frame and through ContentReader, and feeds the decoder corrupt frames.
+
+#include <Content/ContentReader.h>
+#include <System/IO/MappedFileStream.h>
+#include "LzxDecoder.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "HostTest.h"
+#include "LzxEncoder.h"
+
+using namespace XFX::Content;
+
+static const int FrameSize = 0x8000;
+
+// Decodes the frames of a compressed .xnb body. Returns false if the decoder rejects a frame or the data runs out.
+static bool Decode(const byte* compressed, const int compressedLength, byte* output, const int outputLength)
+{
+	LzxDecoder decoder(16);
+	int read = 0;
+	int written = 0;
+
+	while (read < compressedLength)
+	{
+		int frameSize = FrameSize;
+
+		if (compressed[read] == 0xFF)
+		{
+			if (read + 3 > compressedLength)
+			{
+				return false;
+			}
+
+			frameSize = (compressed[read + 1] << 8) | compressed[read + 2];
+			read += 3;
+		}
+
+		if (read + 2 > compressedLength)
+		{
+			return false;
+		}
+
+		const int blockSize = (compressed[read] << 8) | compressed[read + 1];
+		read += 2;
+
+		if (read + blockSize > compressedLength || written + frameSize > outputLength)
+		{
+			return false;
+		}
+
+		if (!decoder.Decompress(&compressed[read], blockSize, &output[written], frameSize))
+		{
+			return false;
+		}
+
+		read += blockSize;
+		written += frameSize;
+	}
+
+	return written == outputLength;
+}
+
+static void CheckRoundTrip(const int length, const LzxEncoder::BlockTypes blockTypes, const unsigned int seed)
+{
+	byte* data = (byte*)malloc(length + 1);
+	byte* decoded = (byte*)malloc(length + 1);
+	int compressedLength;
+
+	LzxEncoder::SampleData(data, length, seed);
+	byte* compressed = LzxEncoder::Compress(data, length, blockTypes, compressedLength);
+
+	CHECK(compressedLength < length / 2 || length < 1000);
+	CHECK(Decode(compressed, compressedLength, decoded, length));
+	CHECK(memcmp(data, decoded, length) == 0);
+
+	free(compressed);
+	free(decoded);
+	free(data);
+}
+
+static void WriteInt32(FILE* const file, const int value)
+{
+	fwrite(&value, sizeof(value), 1, file);
+}
+
+int main()
+{
+	CheckRoundTrip(1, LzxEncoder::Verbatim, 1);
+	CheckRoundTrip(FrameSize, LzxEncoder::Verbatim, 2);
+	CheckRoundTrip(1000000, LzxEncoder::Verbatim, 3);
+	// Ends in a short frame, and crosses frames inside every block type.
+	CheckRoundTrip(300001, LzxEncoder::Mixed, 4);
+	CheckRoundTrip(1 << 20, LzxEncoder::Mixed, 5);
+
+	// A compressed .xnb file: ContentReader decompresses the body while it is read.
+	const int length = 200000;
+	byte* data = (byte*)malloc(length);
+	byte* decoded = (byte*)malloc(length);
+	int compressedLength;
+
+	LzxEncoder::SampleData(data, length, 6);
+	byte* compressed = LzxEncoder::Compress(data, length, LzxEncoder::Mixed, compressedLength);
+
+	char path[] = "/tmp/xfx-lzx-XXXXXX";
+	const int fd = mkstemp(path);
+	FILE* file = fdopen(fd, "wb");
+
+	fwrite("XNBx\x05\x80", 1, 6, file);
+	WriteInt32(file, 14 + compressedLength);
+	WriteInt32(file, length);
+	fwrite(compressed, 1, compressedLength, file);
+	fclose(file);
+
+	Stream* body;
+	{
+		MappedFileStream stream(path);
+		ContentReader reader(null, &stream, path);
+		int read = 0;
+		int count;
+
+		// Reads of uneven sizes, so they straddle frames.
+		while ((count = reader.Read(decoded, read, (read % 7919) + 1 < length - read ? (read % 7919) + 1 : length - read)) > 0)
+		{
+			read += count;
+		}
+
+		CHECK(read == length);
+		CHECK(memcmp(data, decoded, length) == 0);
+		body = reader.BaseStream();
+	}
+
+	// ContentReader closes, but does not free, the decompressing stream it created.
+	delete body;
+
+	unlink(path);
+
+	// Corrupt frames are rejected, or decode to something, but never read or write out of bounds (run under ASan to check).
+	unsigned int seed = 7;
+
+	for (int i = 0; i < 200; i++)
+	{
+		byte* corrupt = (byte*)malloc(compressedLength);
+
+		memcpy(corrupt, compressed, compressedLength);
+
+		for (int j = 0; j < 1 + i % 8; j++)
+		{
+			seed = seed * 1103515245 + 12345;
+			corrupt[(seed >> 8) % compressedLength] ^= 1 << (seed % 8);
+		}
+
+		Decode(corrupt, compressedLength, decoded, length);
+		free(corrupt);
+	}
+
+	free(compressed);
+	free(decoded);
+	free(data);
+
+	return HostTestResult("LzxDecoderTest");
+}
@@ -0,0 +1,180 @@
+// Copyright (C) XFX Team
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without 
+// modification, are permitted provided that the following conditions are met:
+// 
+//* Redistributions of source code must retain the above copyright 
+//notice, this list of conditions and the following disclaimer.
+//* Redistributions in binary form must reproduce the above copyright 
+//notice, this list of conditions and the following disclaimer in the 
+//documentation and/or other materials provided with the distribution.
+//* Neither the name of the copyright holder nor the names of any 
+//contributors may be used to endorse or promote products derived from 
+//this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE 
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF 
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS 
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE 
+// POSSIBILITY OF SUCH DAMAGE.
+
+// Checks that the SSE matrix kernels give bit-identical results to the scalar code in Matrix.cpp.
+// Matrix.cpp is built without SSE for this test (see the makefile), so the Matrix methods called here are the scalar ones.
+
+#include <Matrix.h>
+#include <Quaternion.h>
+#include <Vector3.h>
+#include "MatrixKernels.h"
+
+#include <string.h>
+
+#include "HostTest.h"
+
+using namespace XFX;
+
+static unsigned int seed = 12345;
+
+static float Random(const float range)
+{
+	seed = seed * 1103515245 + 12345;
+	return ((int)(seed >> 8) % 2001 - 1000) * (range / 1000.0f);
+}
+
+// Returns the address of the first element, hiding its alignment from the compiler so that
+// no aligned SSE moves are generated for the misaligned matrices built below.
+static float* Elements(const Matrix& matrix)
+{
+	float* p = (float*)&matrix.M11;
+	__asm__("" : "+r"(p));
+	return p;
+}
+
+static void RandomMatrix(Matrix& matrix)
+{
+	float* m = Elements(matrix);
+
+	for (int i = 0; i < 16; i++)
+	{
+		m[i] = Random(4.0f);
+	}
+}
+
+// Builds scale * rotation * translation, the kind of matrix Decompose is meant for.
+static void RandomTransform(Matrix& matrix)
+{
+	Matrix transform = Matrix::CreateScale(Random(3.0f), Random(3.0f), Random(3.0f)) *
+		Matrix::CreateFromYawPitchRoll(Random(3.1f), Random(3.1f), Random(3.1f)) *
+		Matrix::CreateTranslation(Random(100.0f), Random(100.0f), Random(100.0f));
+
+	memcpy(Elements(matrix), Elements(transform), 16 * sizeof(float));
+}
+
+static bool Same(const Matrix& matrix1, const Matrix& matrix2)
+{
+	return memcmp(Elements(matrix1), Elements(matrix2), 16 * sizeof(float)) == 0;
+}
+
+static bool Same(const float a, const float b)
+{
+	return memcmp(&a, &b, sizeof(float)) == 0;
+}
+
+static bool Same(const Vector3& a, const Vector3& b)
+{
+	return Same(a.X, b.X) && Same(a.Y, b.Y) && Same(a.Z, b.Z);
+}
+
+static bool Same(const Quaternion& a, const Quaternion& b)
+{
+	return Same(a.X, b.X) && Same(a.Y, b.Y) && Same(a.Z, b.Z) && Same(a.W, b.W);
+}
+
+// Runs every kernel on a, b and result, which may be misaligned.
+// The scalar code gets aligned copies, since the compiler may vectorize it with aligned moves.
+static void CheckKernels(Matrix& a, Matrix& b, Matrix& result)
+{
+	Matrix alignedA, alignedB, expected;
+	memcpy(Elements(alignedA), Elements(a), 16 * sizeof(float));
+	memcpy(Elements(alignedB), Elements(b), 16 * sizeof(float));
+
+	// Multiply, also with result aliasing either argument.
+	Matrix::Multiply(alignedA, alignedB, expected);
+	MatrixKernels::Multiply(a, b, result);
+	CHECK(Same(expected, result));
+	memcpy(Elements(result), Elements(a), 16 * sizeof(float));
+	MatrixKernels::Multiply(result, b, result);
+	CHECK(Same(expected, result));
+	memcpy(Elements(result), Elements(b), 16 * sizeof(float));
+	MatrixKernels::Multiply(a, result, result);
+	CHECK(Same(expected, result));
+
+	// Invert, also in place.
+	Matrix::Invert(alignedA, expected);
+	MatrixKernels::Invert(a, result);
+	CHECK(Same(expected, result));
+	memcpy(Elements(result), Elements(a), 16 * sizeof(float));
+	MatrixKernels::Invert(result, result);
+	CHECK(Same(expected, result));
+
+	// Transpose, also in place.
+	Matrix::Transpose(alignedA, expected);
+	MatrixKernels::Transpose(a, result);
+	CHECK(Same(expected, result));
+	memcpy(Elements(result), Elements(a), 16 * sizeof(float));
+	MatrixKernels::Transpose(result, result);
+	CHECK(Same(expected, result));
+
+	// Decompose: the scale must match exactly, and the rotation the kernel leaves must give the scalar quaternion.
+	Vector3 expectedScale, expectedTranslation, scale;
+	Quaternion expectedRotation;
+	bool expectedResult = alignedB.Decompose(expectedScale, expectedRotation, expectedTranslation) != 0;
+	bool kernelResult = MatrixKernels::Decompose(b, scale, result);
+	CHECK(expectedResult == kernelResult);
+
+	if (expectedResult && kernelResult)
+	{
+		CHECK(Same(expectedScale, scale));
+		CHECK(Same(expectedRotation, Quaternion::CreateFromRotationMatrix(result)));
+	}
+}
+
+int main()
+{
+	// Room for three matrices at any offset from a 16-byte boundary.
+	static char storage[4 * sizeof(Matrix) + 16] __attribute__((aligned(16)));
+
+	for (int offset = 0; offset < 16; offset += 4)
+	{
+		// Copied in bytewise: the Matrix constructor itself may use aligned stores.
+		const Matrix identity;
+		Matrix* a = (Matrix*)(storage + offset);
+		Matrix* b = (Matrix*)(storage + offset + sizeof(Matrix));
+		Matrix* result = (Matrix*)(storage + offset + 2 * sizeof(Matrix));
+		memcpy((void*)a, (const void*)&identity, sizeof(Matrix));
+		memcpy((void*)b, (const void*)&identity, sizeof(Matrix));
+		memcpy((void*)result, (const void*)&identity, sizeof(Matrix));
+
+		for (int i = 0; i < 20000; i++)
+		{
+			RandomMatrix(*a);
+			RandomTransform(*b);
+			CheckKernels(*a, *b, *result);
+			RandomMatrix(*b);
+			CheckKernels(*a, *b, *result);
+		}
+
+		// A zero scale makes Decompose fail on both paths.
+		RandomTransform(*b);
+		Elements(*b)[4] = Elements(*b)[5] = Elements(*b)[6] = 0.0f;
+		CheckKernels(*a, *b, *result);
+	}
+
+	return HostTestResult("MatrixKernelsTest");
+}
@@ -0,0 +1,394 @@
+// Copyright (C) XFX Team
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without 
+// modification, are permitted provided that the following conditions are met:
+// 
+//* Redistributions of source code must retain the above copyright 
+//notice, this list of conditions and the following disclaimer.
+//* Redistributions in binary form must reproduce the above copyright 
+//notice, this list of conditions and the following disclaimer in the 
+//documentation and/or other materials provided with the distribution.
+//* Neither the name of the copyright holder nor the names of any 
+//contributors may be used to endorse or promote products derived from 
+//this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE 
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF 
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS 
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE 
+// POSSIBILITY OF SUCH DAMAGE.
+
+// Draws interleaved copies of several models through ModelInstanceBatch, and checks from the effects and the recorded push buffer
+// that each effect is applied once, each mesh part's buffers are bound once, and the instances of a part are drawn back to back.
+
+#include <Graphics/GraphicsDevice.h>
+#include <Graphics/IndexBuffer.h>
+#include <Graphics/Model.h>
+#include <Graphics/ModelInstanceBatch.h>
+#include <Graphics/PresentationParameters.h>
+#include <Graphics/VertexBuffer.h>
+#include <Graphics/VertexDeclaration.h>
+#include <Graphics/VertexElement.h>
+
+extern "C"
+{
+#include "pbKit.h"
+}
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "HostTest.h"
+
+using namespace XFX;
+using namespace XFX::Graphics;
+
+static const int MaxDraws = 256;
+
+// Where each instance was drawn, packed from the translation of its world matrix, in the order the effects were given them.
+struct Placement
+{
+	Effect* effect;
+	long long position;
+	bool applied;
+};
+
+static Placement placements[MaxDraws];
+static int placementCount;
+
+static long long Position(const Matrix& world)
+{
+	return (long long)floorf(world.M41 + 0.5f) * 1000000 + (long long)floorf(world.M42 + 0.5f) * 1000 + (long long)floorf(world.M43 + 0.5f);
+}
+
+static int ComparePositions(const void* a, const void* b)
+{
+	const long long x = *(const long long*)a;
+	const long long y = *(const long long*)b;
+
+	return (x > y) - (x < y);
+}
+
+// Logs the world matrix of every instance it is asked to draw, and whether it was fully applied for it.
+class CountingEffect : public Effect
+{
+private:
+	Matrix world;
+
+protected:
+	void OnApply()
+	{
+		Log(true);
+	}
+
+	void OnApplyWorld(const Matrix& world)
+	{
+		this->world = world;
+		Log(false);
+	}
+
+	void SetMatrices(const Matrix& world, const Matrix& view, const Matrix& projection)
+	{
+		this->world = world;
+	}
+
+	void Log(const bool applied)
+	{
+		if (placementCount < MaxDraws)
+		{
+			Placement placement = { this, Position(world), applied };
+
+			placements[placementCount++] = placement;
+		}
+	}
+
+public:
+	CountingEffect(GraphicsDevice * const graphicsDevice)
+		: Effect(graphicsDevice, null)
+	{
+	}
+};
+
+// What a stretch of the recorded push buffer did.
+struct Recording
+{
+	int draws;
+	int binds;
+	DWORD bindAddresses[MaxDraws];
+};
+
+static DWORD Mark()
+{
+	DWORD count;
+	pb_recorded_stream(&count);
+	return count;
+}
+
+static void Parse(const DWORD start, Recording& recording)
+{
+	DWORD count;
+	const DWORD* stream = pb_recorded_stream(&count);
+	const DWORD* p = stream + start;
+	const DWORD* end = stream + count;
+
+	memset(&recording, 0, sizeof(recording));
+
+	while (p < end)
+	{
+		const DWORD header = *(p++);
+		const int n = (header >> 18) & 0x7ff;
+		const DWORD method = header & 0x1ffc;
+		const bool nonIncrement = (header & 0x40000000) != 0;
+
+		for (int i = 0; i < n; i++)
+		{
+			const DWORD m = nonIncrement ? method : method + i * 4;
+
+			if (m == NV20_TCL_PRIMITIVE_3D_BEGIN_END && p[i] != STOP)
+			{
+				recording.draws++;
+			}
+			else if (m == NV20_TCL_PRIMITIVE_3D_VB_POINTER_ATTR0_POS && recording.binds < MaxDraws)
+			{
+				recording.bindAddresses[recording.binds++] = p[i];
+			}
+		}
+
+		p += n;
+	}
+}
+
+// The models are put together by hand, as ModelReader would: a root bone placed along x with a child bone above it,
+// and a mesh on each bone, whose parts are added by the test.
+static Model* CreateModel(const float x)
+{
+	Model* model = new Model();
+
+	for (int i = 0; i < 2; i++)
+	{
+		ModelBone bone;
+
+		bone.index = i;
+		bone.model = model;
+		model->bones.Add(bone);
+		model->boneParents.Add(i - 1);
+		model->boneTransforms.Add((i == 0) ? Matrix::CreateTranslation(x, 0.0f, 0.0f) : Matrix::CreateTranslation(0.0f, 100.0f, 0.0f));
+
+		ModelMesh mesh;
+
+		mesh.parentBone = i;
+		mesh.Tag = null;
+		model->meshes.Add(mesh);
+	}
+
+	model->InitializeBones();
+
+	return model;
+}
+
+static void AddPart(Model * const model, const int mesh, Effect * const effect, VertexBuffer * const vertexBuffer, IndexBuffer * const indexBuffer, const int vertexOffset)
+{
+	ModelMeshPart part;
+
+	part.indexBuffer = indexBuffer;
+	part.vertexBuffer = vertexBuffer;
+	part.numVertices = 4;
+	part.primitiveCount = 2;
+	part.startIndex = 0;
+	part.vertexOffset = vertexOffset;
+	part.Effect = effect;
+	part.Tag = null;
+
+	model->meshes[mesh].meshParts.Add(part);
+}
+
+struct Queued
+{
+	Model* model;
+	int firstWorld;
+	int count;
+};
+
+// Queues the copies, draws them, and checks the effects were applied and the buffers bound as the batch promises.
+static void CheckFrame(GraphicsDevice& device, ModelInstanceBatch& batch, const Queued queued[], const int queuedCount, const Matrix worlds[],
+	const int effectCount, const int partCount)
+{
+	long long expected[MaxDraws];
+	long long drawn[MaxDraws];
+	int expectedCount = 0;
+
+	placementCount = 0;
+
+	// Forget the buffers bound by the last frame, so each part's bind shows up in the push buffer.
+	device.InvalidateRenderState();
+
+	Recording recording;
+	const DWORD start = Mark();
+
+	batch.Begin(Matrix::Identity, Matrix::Identity);
+
+	for (int i = 0; i < queuedCount; i++)
+	{
+		batch.Draw(queued[i].model, &worlds[queued[i].firstWorld], queued[i].count);
+
+		Matrix absolute[2];
+		queued[i].model->CopyAbsoluteBoneTransformsTo(absolute);
+
+		for (int j = 0; j < queued[i].model->meshes.Count(); j++)
+		{
+			const ModelMesh& mesh = queued[i].model->meshes[j];
+
+			for (int k = 0; k < mesh.meshParts.Count() * queued[i].count; k++)
+			{
+				expected[expectedCount++] = Position(absolute[mesh.parentBone] * worlds[queued[i].firstWorld + k % queued[i].count]);
+			}
+		}
+	}
+
+	batch.End();
+	Parse(start, recording);
+
+	// Every instance of every part is drawn once, in the right place.
+	CHECK(recording.draws == expectedCount);
+	CHECK(placementCount == expectedCount);
+
+	for (int i = 0; i < placementCount; i++)
+	{
+		drawn[i] = placements[i].position;
+	}
+
+	qsort(expected, expectedCount, sizeof(expected[0]), ComparePositions);
+	qsort(drawn, placementCount, sizeof(drawn[0]), ComparePositions);
+	CHECK(placementCount == expectedCount && memcmp(expected, drawn, expectedCount * sizeof(expected[0])) == 0);
+
+	// One full apply per effect, before its instances, which all follow each other; every other instance only changes the world matrix.
+	int applies = 0;
+	int effectChanges = 0;
+	bool appliedOnChange = true;
+
+	for (int i = 0; i < placementCount; i++)
+	{
+		applies += placements[i].applied;
+
+		if (i == 0 || placements[i].effect != placements[i - 1].effect)
+		{
+			effectChanges++;
+			appliedOnChange &= placements[i].applied;
+		}
+	}
+
+	CHECK(applies == effectCount);
+	CHECK(effectChanges == effectCount);
+	CHECK(appliedOnChange);
+
+	// One vertex buffer bind per part, each to a different place, so the draws of a part follow each other.
+	bool distinct = true;
+
+	for (int i = 0; i < recording.binds; i++)
+	{
+		for (int j = 0; j < i; j++)
+		{
+			distinct &= (recording.bindAddresses[i] != recording.bindAddresses[j]);
+		}
+	}
+
+	CHECK(recording.binds == partCount);
+	CHECK(distinct);
+}
+
+int main()
+{
+	PresentationParameters presentationParameters;
+	presentationParameters.BackBufferWidth = 640;
+	presentationParameters.BackBufferHeight = 480;
+
+	GraphicsDevice device(null, &presentationParameters);
+
+	const VertexElement elements[] =
+	{
+		VertexElement(0, VertexElementFormat::Vector3, VertexElementUsage::Position, 0)
+	};
+	VertexDeclaration declaration(elements, 1);
+
+	float vertices[64 * 3];
+	memset(vertices, 0, sizeof(vertices));
+
+	VertexBuffer vertexBuffer(&device, declaration, 64, BufferUsage::None);
+	vertexBuffer.SetData(vertices, 0, 64);
+
+	ushort indices[6] = { 0, 1, 2, 2, 1, 3 };
+	IndexBuffer indexBuffer(&device, IndexElementSize::SixteenBits, 6, BufferUsage::None);
+	indexBuffer.SetData(indices, 0, 6);
+
+	CountingEffect effectA(&device);
+	CountingEffect effectB(&device);
+	CountingEffect effectC(&device);
+
+	// Seven parts over three effects, spread over the meshes of three models so that neither effects nor buffers come in order.
+	Model* first = CreateModel(1000.0f);
+	Model* second = CreateModel(2000.0f);
+	Model* third = CreateModel(3000.0f);
+
+	AddPart(first, 0, &effectA, &vertexBuffer, &indexBuffer, 0);
+	AddPart(first, 0, &effectB, &vertexBuffer, &indexBuffer, 4);
+	AddPart(second, 0, &effectA, &vertexBuffer, &indexBuffer, 8);
+	AddPart(second, 1, &effectC, &vertexBuffer, &indexBuffer, 12);
+	AddPart(third, 1, &effectB, &vertexBuffer, &indexBuffer, 16);
+	AddPart(third, 0, &effectA, &vertexBuffer, &indexBuffer, 20);
+	AddPart(third, 1, &effectC, &vertexBuffer, &indexBuffer, 24);
+
+	Matrix worlds[16];
+
+	for (int i = 0; i < 16; i++)
+	{
+		worlds[i] = Matrix::CreateTranslation((float)i, 0.0f, (float)(i * 3));
+	}
+
+	ModelInstanceBatch batch(&device);
+
+	// The first model is queued twice, so two runs of each of its parts have to be merged to keep to one bind per part.
+	const Queued queued[] =
+	{
+		{ first, 0, 3 },
+		{ second, 3, 2 },
+		{ third, 5, 5 },
+		{ first, 10, 4 },
+		{ second, 14, 1 }
+	};
+
+	CheckFrame(device, batch, queued, 5, worlds, 3, 7);
+
+	// A moved bone moves only the meshes below it, and the next frame draws the same.
+	third->SetBoneTransform(1, Matrix::CreateTranslation(0.0f, 200.0f, 0.0f));
+	CheckFrame(device, batch, queued, 5, worlds, 3, 7);
+
+	// A single model with a single copy.
+	CheckFrame(device, batch, queued + 4, 1, worlds, 2, 2);
+
+	// Nothing queued, no copies, or no model, draws nothing.
+	const int asserts = hostAssertFailures;
+	const Queued none[] = { { first, 0, 0 } };
+
+	CheckFrame(device, batch, none, 1, worlds, 0, 0);
+
+	batch.Begin(Matrix::Identity, Matrix::Identity);
+	batch.Draw(null, worlds, 1);
+	batch.End();
+
+	CHECK(hostAssertFailures == asserts + 1);
+	hostAssertFailures = asserts;
+
+	delete first;
+	delete second;
+	delete third;
+
+	return HostTestResult("ModelInstanceBatchTest");
+}
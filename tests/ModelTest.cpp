@@ -0,0 +1,288 @@
+// Copyright (C) XFX Team
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without 
+// modification, are permitted provided that the following conditions are met:
+// 
+//* Redistributions of source code must retain the above copyright 
+//notice, this list of conditions and the following disclaimer.
+//* Redistributions in binary form must reproduce the above copyright 
+//notice, this list of conditions and the following disclaimer in the 
+//documentation and/or other materials provided with the distribution.
+//* Neither the name of the copyright holder nor the names of any 
+//contributors may be used to endorse or promote products derived from 
+//this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE 
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF 
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS 
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE 
+// POSSIBILITY OF SUCH DAMAGE.
+
+// Reads random bone hierarchies through ModelReader and checks, frame after frame of random edits, that the
+// absolute transforms Model keeps up to date by recomputing only the dirty subtrees match a full recompute.
+
+#include <Content/ContentReader.h>
+#include <Graphics/Model.h>
+#include <System/IO/MappedFileStream.h>
+#include "ModelReader.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "HostTest.h"
+
+using namespace XFX;
+using namespace XFX::Content;
+using namespace XFX::Graphics;
+
+static const int MaxBones = 300;
+
+static unsigned int seed = 4321;
+
+static int RandomInt(const int count)
+{
+	seed = seed * 1103515245 + 12345;
+	return (int)(seed >> 8) % count;
+}
+
+static float Random(const float range)
+{
+	return (RandomInt(2001) - 1000) * (range / 1000.0f);
+}
+
+static Matrix RandomTransform()
+{
+	return Matrix::CreateFromYawPitchRoll(Random(3.0f), Random(3.0f), Random(3.0f)) * Matrix::CreateTranslation(Random(2.0f), Random(2.0f), Random(2.0f));
+}
+
+// A random tree, with the bones shuffled so that parents do not always come before their children.
+static void RandomHierarchy(const int count, int parents[], Matrix transforms[])
+{
+	int order[MaxBones];
+
+	for (int i = 0; i < count; i++)
+	{
+		order[i] = i;
+	}
+
+	for (int i = count - 1; i > 0; i--)
+	{
+		const int j = RandomInt(i + 1);
+		const int swap = order[i];
+
+		order[i] = order[j];
+		order[j] = swap;
+	}
+
+	// A few roots, and chains deep enough to span several levels of dirty subtrees.
+	for (int i = 0; i < count; i++)
+	{
+		parents[order[i]] = (i == 0 || RandomInt(20) == 0) ? -1 : order[(RandomInt(4) == 0) ? RandomInt(i) : i - 1 - RandomInt((i < 3) ? i : 3)];
+		transforms[i] = RandomTransform();
+	}
+}
+
+static void WriteBoneReference(FILE* const file, const int count, const int bone)
+{
+	const uint id = bone + 1;
+
+	if (count < 255)
+	{
+		fputc(id, file);
+	}
+	else
+	{
+		fwrite(&id, sizeof(id), 1, file);
+	}
+}
+
+// Writes the model body that ModelReader reads: the bone transforms, the parent and children of each bone, and no meshes.
+static void WriteModel(const char path[], const int count, const int parents[], const Matrix transforms[])
+{
+	FILE* file = fopen(path, "wb");
+	const uint boneCount = count;
+	const uint meshCount = 0;
+
+	fwrite(&boneCount, sizeof(boneCount), 1, file);
+
+	for (int i = 0; i < count; i++)
+	{
+		fwrite(&transforms[i].M11, sizeof(float), 16, file);
+	}
+
+	for (int i = 0; i < count; i++)
+	{
+		uint childCount = 0;
+
+		WriteBoneReference(file, count, parents[i]);
+
+		for (int j = 0; j < count; j++)
+		{
+			childCount += (parents[j] == i);
+		}
+
+		fwrite(&childCount, sizeof(childCount), 1, file);
+
+		for (int j = 0; j < count; j++)
+		{
+			if (parents[j] == i)
+			{
+				WriteBoneReference(file, count, j);
+			}
+		}
+	}
+
+	fwrite(&meshCount, sizeof(meshCount), 1, file);
+	fclose(file);
+}
+
+static Model* ReadModel(const char path[], Model* existingInstance)
+{
+	MappedFileStream stream(path);
+	ContentReader reader(null, &stream, (GraphicsDevice*)null);
+	ModelReader modelReader;
+
+	return modelReader.Read(&reader, existingInstance);
+}
+
+// The reference: every absolute transform recomputed from the root down, with no caching.
+static Matrix Absolute(const int bone, const int parents[], const Matrix transforms[])
+{
+	return (parents[bone] < 0) ? transforms[bone] : transforms[bone] * Absolute(parents[bone], parents, transforms);
+}
+
+static bool Matches(Model* const model, const int count, const int parents[], const Matrix transforms[])
+{
+	Matrix absolute[MaxBones];
+
+	model->CopyAbsoluteBoneTransformsTo(absolute);
+
+	for (int i = 0; i < count; i++)
+	{
+		const Matrix expected = Absolute(i, parents, transforms);
+		const float* a = &absolute[i].M11;
+		const float* e = &expected.M11;
+
+		for (int j = 0; j < 16; j++)
+		{
+			if (fabsf(a[j] - e[j]) > 1e-3f * (1.0f + fabsf(e[j])))
+			{
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+static void CheckHierarchy(const char path[], const int count, const int frames, Model* model)
+{
+	int parents[MaxBones];
+	Matrix transforms[MaxBones];
+
+	RandomHierarchy(count, parents, transforms);
+	WriteModel(path, count, parents, transforms);
+	model = ReadModel(path, model);
+
+	CHECK(model->getBones().Count() == count);
+	CHECK(model->getMeshes().Count() == 0);
+	CHECK(parents[model->getRoot().getIndex()] < 0);
+
+	int mismatches = 0;
+	int parentMismatches = 0;
+
+	for (int i = 0; i < count; i++)
+	{
+		ModelBone* parent = model->getBones()[i].getParent();
+
+		parentMismatches += (parent == null) ? (parents[i] >= 0) : (parent->getIndex() != parents[i]);
+	}
+
+	CHECK(parentMismatches == 0);
+	CHECK(Matches(model, count, parents, transforms));
+
+	for (int frame = 0; frame < frames; frame++)
+	{
+		switch (RandomInt(4))
+		{
+		case 0:
+			// Nothing moved: the cached transforms are handed out again.
+			break;
+		case 1:
+			// A few bones animated through ModelBone.
+			for (int i = RandomInt(4); i >= 0; i--)
+			{
+				const int bone = RandomInt(count);
+
+				transforms[bone] = RandomTransform();
+				model->getBones()[bone].setTransform(transforms[bone]);
+			}
+			break;
+		case 2:
+			// A whole pose copied in, most of it unchanged.
+			{
+				Matrix pose[MaxBones];
+
+				model->CopyBoneTransformsTo(pose);
+
+				for (int i = RandomInt(8); i >= 0; i--)
+				{
+					const int bone = RandomInt(count);
+
+					transforms[bone] = RandomTransform();
+					pose[bone] = transforms[bone];
+				}
+
+				model->CopyBoneTransformsFrom(pose);
+			}
+			break;
+		case 3:
+			// A bone set to the transform it already has.
+			{
+				const int bone = RandomInt(count);
+
+				model->getBones()[bone].setTransform(transforms[bone]);
+			}
+			break;
+		}
+
+		mismatches += !Matches(model, count, parents, transforms);
+	}
+
+	CHECK(mismatches == 0);
+
+	delete model;
+}
+
+int main()
+{
+	char path[] = "/tmp/xfx-model-XXXXXX";
+	close(mkstemp(path));
+
+	CheckHierarchy(path, 1, 50, null);
+	CheckHierarchy(path, 60, 2000, null);
+	// More than 254 bones, so the bone references are 32 bit.
+	CheckHierarchy(path, MaxBones, 500, null);
+
+	// Reading over an existing model replaces its hierarchy, including a larger one with a smaller one.
+	{
+		int parents[MaxBones];
+		Matrix transforms[MaxBones];
+
+		RandomHierarchy(200, parents, transforms);
+		WriteModel(path, 200, parents, transforms);
+		CheckHierarchy(path, 40, 1000, ReadModel(path, null));
+	}
+
+	unlink(path);
+
+	return HostTestResult("ModelTest");
+}
@@ -0,0 +1,117 @@
+// Copyright (C) XFX Team
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without 
+// modification, are permitted provided that the following conditions are met:
+// 
+//* Redistributions of source code must retain the above copyright 
+//notice, this list of conditions and the following disclaimer.
+//* Redistributions in binary form must reproduce the above copyright 
+//notice, this list of conditions and the following disclaimer in the 
+//documentation and/or other materials provided with the distribution.
+//* Neither the name of the copyright holder nor the names of any 
+//contributors may be used to endorse or promote products derived from 
+//this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE 
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF 
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS 
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE 
+// POSSIBILITY OF SUCH DAMAGE.
+
+// Checks the counters the push buffer recorder keeps against a known push sequence, and their rollover at the end of a frame.
+
+extern "C"
+{
+#include "pbKit.h"
+}
+
+#include <string.h>
+
+#include "HostTest.h"
+
+static bool Equals(const s_PbStats& stats, const DWORD methods, const DWORD dwords, const DWORD drawCalls, const DWORD stateChanges)
+{
+	return stats.Methods == methods && stats.Dwords == dwords && stats.DrawCalls == drawCalls && stats.StateChanges == stateChanges;
+}
+
+// Sends one of each kind of command: 8 methods in 23 dwords, of which 2 draw (a primitive and a clear) and 3 change state.
+static void PushSequence()
+{
+	DWORD* p = pb_begin();
+	pb_push1(p, NV20_TCL_PRIMITIVE_3D_BLEND_FUNC_ENABLE, 1); p += 2;							// state
+	pb_push4f(p, NV20_TCL_PRIMITIVE_3D_VIEWPORT_OX, 320.0f, 240.0f, 0.0f, 0.0f); p += 5;		// state, 4 parameters
+	pb_push1(p, NV20_TCL_PRIMITIVE_3D_BEGIN_END, TRIANGLES); p += 2;						// draw
+	pb_push3(p, NV20_TCL_PRIMITIVE_3D_VERTEX_POS_3F_X, 0, 0, 0); p += 4;						// vertex data
+	pb_push1(p, NV20_TCL_PRIMITIVE_3D_BEGIN_END, STOP); p += 2;								// closes the draw
+	pb_push3(p, NV20_TCL_PRIMITIVE_3D_CLEAR_VALUE_DEPTH, 0xffffff00, 0, 0xf3); p += 4;		// clear, triggered by the last parameter
+	pb_push1(p, NV20_TCL_PRIMITIVE_3D_NOP, 0); p += 2;										// synchronization
+	pb_push1to(SUBCH_3, p, NV20_TCL_PRIMITIVE_SET_MAIN_OBJECT, 16); p += 2;					// state, on another subchannel
+	pb_end(p);
+}
+
+int main()
+{
+	CHECK(pb_init() == 0);
+
+	s_PbStats stats;
+	s_PbStats frameStats;
+
+	pb_get_stats(&stats);
+	pb_get_frame_stats(&frameStats);
+	CHECK(Equals(stats, 0, 0, 0, 0));
+	CHECK(Equals(frameStats, 0, 0, 0, 0));
+
+	// The counters add up over the blocks of a frame.
+	PushSequence();
+	pb_get_stats(&stats);
+	CHECK(Equals(stats, 8, 23, 2, 3));
+
+	PushSequence();
+	pb_get_stats(&stats);
+	pb_get_frame_stats(&frameStats);
+	CHECK(Equals(stats, 16, 46, 4, 6));
+	CHECK(Equals(frameStats, 0, 0, 0, 0));
+
+	// pb_finished ends the frame with 5 synchronization methods, latches the counters and starts the next frame from zero.
+	pb_finished();
+	pb_get_stats(&stats);
+	pb_get_frame_stats(&frameStats);
+	CHECK(Equals(stats, 0, 0, 0, 0));
+	CHECK(Equals(frameStats, 16 + 5, 46 + 10, 4, 6));
+
+	// The next frame only counts its own commands, and the latched counters stay until it ends.
+	pb_reset();
+	PushSequence();
+	pb_get_frame_stats(&frameStats);
+	CHECK(Equals(frameStats, 16 + 5, 46 + 10, 4, 6));
+
+	pb_finished();
+	pb_get_stats(&stats);
+	pb_get_frame_stats(&frameStats);
+	CHECK(Equals(stats, 0, 0, 0, 0));
+	CHECK(Equals(frameStats, 8 + 5, 23 + 10, 2, 3));
+
+	// The stream holds what was sent since pb_reset: the sequence and the end of the frame.
+	DWORD count;
+	pb_recorded_stream(&count);
+	CHECK(count == 23 + 10);
+
+	// pb_reset_stats clears both the running and the latched counters.
+	PushSequence();
+	pb_reset_stats();
+	pb_get_stats(&stats);
+	pb_get_frame_stats(&frameStats);
+	CHECK(Equals(stats, 0, 0, 0, 0));
+	CHECK(Equals(frameStats, 0, 0, 0, 0));
+
+	pb_kill();
+
+	return HostTestResult("PbKitStatsTest");
+}
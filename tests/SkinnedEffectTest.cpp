@@ -0,0 +1,236 @@
+// Copyright (C) XFX Team
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without 
+// modification, are permitted provided that the following conditions are met:
+// 
+//* Redistributions of source code must retain the above copyright 
+//notice, this list of conditions and the following disclaimer.
+//* Redistributions in binary form must reproduce the above copyright 
+//notice, this list of conditions and the following disclaimer in the 
+//documentation and/or other materials provided with the distribution.
+//* Neither the name of the copyright holder nor the names of any 
+//contributors may be used to endorse or promote products derived from 
+//this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE 
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF 
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS 
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE 
+// POSSIBILITY OF SUCH DAMAGE.
+
+// Checks what SkinnedEffect sends to the push buffer when it is applied: all of its bones the first time, only the dirty range after
+// that, and a single 35 dword block of constants for an unchanged pose.
+// Also checks that the SSE path of SkinVertices gives bit-identical results to its scalar fallback.
+
+#include <Graphics/GraphicsDevice.h>
+#include <Graphics/PresentationParameters.h>
+#include <Graphics/SkinnedEffect.h>
+#include <Graphics/VertexElement.h>
+#include <Matrix.h>
+
+// VertexSkinning.cpp is also built without SSE under this name (see the makefile), so the scalar path can be called next to the SSE one.
+#define VertexSkinning ScalarVertexSkinning
+#include "VertexSkinning.h"
+#undef VertexSkinning
+
+extern "C"
+{
+#include "pbKit.h"
+}
+
+#include <string.h>
+
+#include "HostTest.h"
+
+using namespace XFX;
+using namespace XFX::Graphics;
+
+// The constants c0-c7: an id, a burst header and 32 dwords.
+static const DWORD ConstantsDwords = 35;
+
+static DWORD Mark()
+{
+	DWORD count;
+	pb_recorded_stream(&count);
+	return count;
+}
+
+// The dwords UploadBones sends for count bones: per block of 8 bones, an id and 32 dword bursts of 3 registers a bone.
+static DWORD BoneDwords(int count)
+{
+	DWORD dwords = 0;
+
+	for (; count > 0; count -= 8)
+	{
+		const DWORD registers = (count < 8 ? count : 8) * 12;
+
+		dwords += 2 + (registers + 31) / 32 + registers;
+	}
+
+	return dwords;
+}
+
+// The dwords sent by applying the effect.
+static DWORD Apply(SkinnedEffect& effect)
+{
+	const DWORD start = Mark();
+	effect.OnApply();
+	return Mark() - start;
+}
+
+static unsigned int seed = 12345;
+
+static float Random(const float range)
+{
+	seed = seed * 1103515245 + 12345;
+	return ((int)(seed >> 8) % 2001 - 1000) * (range / 1000.0f);
+}
+
+struct SkinnedVertex
+{
+	float Position[3];
+	float Normal[3];
+	byte Indices[4];
+	float Weights[4];
+	float TextureCoordinate[2];
+};
+
+static const int VertexCount = 333;
+
+static SkinnedVertex source[VertexCount];
+static SkinnedVertex skinned[VertexCount];
+static SkinnedVertex skinnedScalar[VertexCount];
+
+int main()
+{
+	PresentationParameters presentationParameters;
+	presentationParameters.BackBufferWidth = 640;
+	presentationParameters.BackBufferHeight = 480;
+
+	GraphicsDevice device(null, &presentationParameters);
+
+	Matrix bones[SkinnedEffect::MaxBones];
+
+	for (int i = 0; i < SkinnedEffect::MaxBones; i++)
+	{
+		bones[i] = Matrix::CreateFromYawPitchRoll(Random(3.0f), Random(3.0f), Random(3.0f)) * Matrix::CreateTranslation(Random(10.0f), Random(10.0f), Random(10.0f));
+	}
+
+	// The first apply loads the program, and uploads every bone that was set.
+	SkinnedEffect effect(&device);
+	effect.SetBoneTransforms(bones, 20);
+
+	CHECK(Apply(effect) > ConstantsDwords + BoneDwords(20));
+
+	// An unchanged pose only sends the constants.
+	CHECK(Apply(effect) == ConstantsDwords);
+
+	effect.SetBoneTransforms(bones, 20);
+	CHECK(Apply(effect) == ConstantsDwords);
+
+	// Changing bones 5 and 9 sends the range between them, in one block.
+	bones[5] = Matrix::CreateRotationX(0.5f);
+	bones[9] = Matrix::CreateRotationY(0.5f);
+	effect.SetBoneTransforms(bones, 20);
+
+	CHECK(Apply(effect) == ConstantsDwords + BoneDwords(5));
+
+	// Bones set for the first time are sent even when they match what the effect held for them.
+	for (int i = 20; i < 24; i++)
+	{
+		bones[i] = Matrix::Identity;
+	}
+	effect.SetBoneTransforms(bones, 24);
+
+	CHECK(Apply(effect) == ConstantsDwords + BoneDwords(4));
+
+	// Another effect with the same weights shares the program, but takes over the palette.
+	SkinnedEffect other(&device);
+	other.SetBoneTransforms(bones, 3);
+
+	CHECK(Apply(other) == ConstantsDwords + BoneDwords(3));
+	CHECK(Apply(effect) == ConstantsDwords + BoneDwords(24));
+	CHECK(Apply(effect) == ConstantsDwords);
+
+	// SkinVertices, through the SSE path, against the scalar fallback.
+	for (int i = 0; i < SkinnedEffect::MaxBones; i++)
+	{
+		bones[i] = Matrix::CreateFromYawPitchRoll(Random(3.0f), Random(3.0f), Random(3.0f)) * Matrix::CreateScale(1.0f + Random(0.5f)) * Matrix::CreateTranslation(Random(10.0f), Random(10.0f), Random(10.0f));
+	}
+	effect.SetBoneTransforms(bones, SkinnedEffect::MaxBones);
+
+	for (int i = 0; i < VertexCount; i++)
+	{
+		float total = 0.0f;
+
+		for (int j = 0; j < 3; j++)
+		{
+			source[i].Position[j] = Random(20.0f);
+			source[i].Normal[j] = Random(1.0f);
+		}
+
+		for (int j = 0; j < 4; j++)
+		{
+			source[i].Indices[j] = (byte)((seed >> 8) % SkinnedEffect::MaxBones);
+			source[i].Weights[j] = 1.0f + Random(1.0f);
+			total += source[i].Weights[j];
+		}
+
+		for (int j = 0; j < 4; j++)
+		{
+			source[i].Weights[j] /= total;
+		}
+
+		source[i].TextureCoordinate[0] = source[i].TextureCoordinate[1] = Random(1.0f);
+	}
+
+	const VertexElement elements[] =
+	{
+		VertexElement(0, VertexElementFormat::Vector3, VertexElementUsage::Position, 0),
+		VertexElement(24, VertexElementFormat::Byte4, VertexElementUsage::BlendIndices, 0),
+		VertexElement(28, VertexElementFormat::Vector4, VertexElementUsage::BlendWeight, 0),
+		VertexElement(44, VertexElementFormat::Vector2, VertexElementUsage::TextureCoordinate, 0),
+		VertexElement(12, VertexElementFormat::Vector3, VertexElementUsage::Normal, 0)
+	};
+	const int stride = (int)sizeof(SkinnedVertex);
+	const int weightCounts[] = { 1, 2, 4 };
+
+	for (int w = 0; w < 3; w++)
+	{
+		effect.setWeightsPerVertex(weightCounts[w]);
+
+		// With and without the normal, which is the last element.
+		for (int elementCount = 4; elementCount <= 5; elementCount++)
+		{
+			const int normalOffset = (elementCount == 5) ? 12 : -1;
+
+			memset(skinned, 0, sizeof(skinned));
+			memset(skinnedScalar, 0, sizeof(skinnedScalar));
+
+			effect.SkinVertices(source, skinned, VertexCount, stride, elements, elementCount);
+			ScalarVertexSkinning::Skin(bones, SkinnedEffect::MaxBones, weightCounts[w], source, skinnedScalar, VertexCount, stride, 0, normalOffset, 24, 28);
+
+			CHECK(memcmp(skinned, skinnedScalar, sizeof(skinned)) == 0);
+
+			// Only the position and normal are written, here in place.
+			memcpy(skinned, source, sizeof(skinned));
+			memcpy(skinnedScalar, source, sizeof(skinnedScalar));
+
+			effect.SkinVertices(skinned, skinned, VertexCount, stride, elements, elementCount);
+			ScalarVertexSkinning::Skin(bones, SkinnedEffect::MaxBones, weightCounts[w], skinnedScalar, skinnedScalar, VertexCount, stride, 0, normalOffset, 24, 28);
+
+			CHECK(memcmp(skinned, skinnedScalar, sizeof(skinned)) == 0);
+			CHECK(memcmp(skinned[7].Indices, source[7].Indices, sizeof(source[7]) - 24) == 0);
+			CHECK(skinned[7].Position[0] != source[7].Position[0]);
+		}
+	}
+
+	return HostTestResult("SkinnedEffectTest");
+}
@@ -0,0 +1,308 @@
+// Copyright (C) XFX Team
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without 
+// modification, are permitted provided that the following conditions are met:
+// 
+//* Redistributions of source code must retain the above copyright 
+//notice, this list of conditions and the following disclaimer.
+//* Redistributions in binary form must reproduce the above copyright 
+//notice, this list of conditions and the following disclaimer in the 
+//documentation and/or other materials provided with the distribution.
+//* Neither the name of the copyright holder nor the names of any 
+//contributors may be used to endorse or promote products derived from 
+//this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE 
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF 
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS 
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE 
+// POSSIBILITY OF SUCH DAMAGE.
+
+// Draws sprites through SpriteBatch and checks the push buffer it records: consecutive sprites that share a texture are
+// drawn together, and the Texture, BackToFront and FrontToBack modes reorder the sprites as they should.
+// Also prints the bytes and draw calls each frame costs, as counted by the recorder.
+
+#include <Graphics/BlendState.h>
+#include <Graphics/GraphicsDevice.h>
+#include <Graphics/PresentationParameters.h>
+#include <Graphics/SpriteBatch.h>
+#include <Graphics/Texture2D.h>
+#include <Rectangle.h>
+
+extern "C"
+{
+#include "pbKit.h"
+}
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "HostTest.h"
+
+using namespace XFX;
+using namespace XFX::Graphics;
+
+static const int MaxSprites = 512;
+
+// The sprites of a stretch of the recorded push buffer, in the order they were drawn.
+struct Recording
+{
+	int draws;
+	int spriteCount;
+	int sprites[MaxSprites];
+	DWORD textures[MaxSprites];
+	bool drawsMixTextures;
+};
+
+static DWORD Mark()
+{
+	DWORD count;
+	pb_recorded_stream(&count);
+	return count;
+}
+
+// Every sprite is drawn at an x of ten times its number, which is how the vertices are traced back to it.
+static void Parse(const SpriteBatch& batch, const DWORD start, Recording& recording)
+{
+	DWORD count;
+	const DWORD* stream = pb_recorded_stream(&count);
+	const DWORD* p = stream + start;
+	const DWORD* end = stream + count;
+	// The texture registers are not sent again while they hold the same texture, so the last one seen carries over.
+	static DWORD texture = 0;
+
+	recording.draws = recording.spriteCount = 0;
+	recording.drawsMixTextures = false;
+
+	while (p < end)
+	{
+		const DWORD header = *(p++);
+		const int n = (header >> 18) & 0x7ff;
+		const DWORD method = header & 0x1ffc;
+		const bool nonIncrement = (header & 0x40000000) != 0;
+
+		for (int i = 0; i < n; i++)
+		{
+			const DWORD m = nonIncrement ? method : method + i * 4;
+			const DWORD value = p[i];
+
+			if (m == NV20_TCL_PRIMITIVE_3D_TX_NPOT_SIZE(0))
+			{
+				texture = value;
+			}
+			else if (m == NV20_TCL_PRIMITIVE_3D_BEGIN_END && value != STOP)
+			{
+				recording.draws++;
+			}
+			else if (m == NV20_TCL_PRIMITIVE_3D_VB_VERTEX_BATCH)
+			{
+				const int first = value & 0xffffff;
+				const int vertices = (value >> 24) + 1;
+
+				for (int j = first; j < first + vertices; j += 4)
+				{
+					if (recording.spriteCount > 0 && recording.textures[recording.spriteCount - 1] != texture && j != first)
+					{
+						recording.drawsMixTextures = true;
+					}
+
+					recording.textures[recording.spriteCount] = texture;
+					recording.sprites[recording.spriteCount++] = (int)(batch.vertexBuffer[j].X / 10.0f);
+				}
+			}
+		}
+
+		p += n;
+	}
+}
+
+static DWORD SizeOf(const Texture2D& texture)
+{
+	return ((DWORD)texture.Width << 16) | texture.Height;
+}
+
+// Draws the sprites in the given mode, and checks that they come out in the expected order.
+static void CheckOrder(GraphicsDevice& device, SpriteBatch& batch, const SpriteSortMode_t sortMode, Texture2D* const textures[], const float depths[], const int count, const int expectedOrder[], const int expectedDraws)
+{
+	Recording recording;
+	const DWORD start = Mark();
+
+	batch.Begin(sortMode, BlendState::AlphaBlend);
+
+	for (int i = 0; i < count; i++)
+	{
+		batch.Draw(textures[i], Rectangle(i * 10, 0, textures[i]->Width, textures[i]->Height), null, Color::White, 0.0f, Vector2::Zero, SpriteEffects::None, depths[i]);
+	}
+
+	batch.End();
+	Parse(batch, start, recording);
+
+	CHECK(recording.draws == expectedDraws);
+	CHECK(recording.spriteCount == count);
+	CHECK(!recording.drawsMixTextures);
+
+	for (int i = 0; i < count && i < recording.spriteCount; i++)
+	{
+		CHECK(recording.sprites[i] == expectedOrder[i]);
+		CHECK(recording.textures[i] == SizeOf(*textures[expectedOrder[i]]));
+	}
+}
+
+int main()
+{
+	PresentationParameters presentationParameters;
+	presentationParameters.BackBufferWidth = 640;
+	presentationParameters.BackBufferHeight = 480;
+
+	GraphicsDevice device(null, &presentationParameters);
+	SpriteBatch batch(&device);
+
+	// Each texture has its own size, which is what the recording tells them apart by.
+	Texture2D a(&device, 4, 4);
+	Texture2D b(&device, 8, 8);
+	Texture2D c(&device, 16, 16);
+
+	// Deferred keeps the order sprites are drawn in, and only runs of one texture are drawn together.
+	{
+		Texture2D* const textures[] = { &a, &a, &b, &b, &b, &a, &c };
+		const float depths[] = { 0.5f, 0.1f, 0.9f, 0.3f, 0.3f, 0.7f, 0.2f };
+		const int order[] = { 0, 1, 2, 3, 4, 5, 6 };
+
+		CheckOrder(device, batch, SpriteSortMode::Deferred, textures, depths, 7, order, 4);
+	}
+
+	// Texture groups sprites by texture, and keeps the order they were drawn in within a texture.
+	{
+		Texture2D* const textures[] = { &b, &a, &b, &c, &a, &b };
+		const float depths[] = { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f };
+		Texture2D* groups[] = { &a, &b, &c };
+		int order[6];
+		int position = 0;
+
+		// The sort key is the texture's address, so the group order depends on where the textures live.
+		for (int i = 0; i < 3; i++)
+		{
+			for (int j = i + 1; j < 3; j++)
+			{
+				if ((size_t)groups[j] < (size_t)groups[i])
+				{
+					Texture2D* temp = groups[i];
+					groups[i] = groups[j];
+					groups[j] = temp;
+				}
+			}
+		}
+
+		for (int i = 0; i < 3; i++)
+		{
+			for (int j = 0; j < 6; j++)
+			{
+				if (textures[j] == groups[i])
+				{
+					order[position++] = j;
+				}
+			}
+		}
+
+		CheckOrder(device, batch, SpriteSortMode::Texture, textures, depths, 6, order, 3);
+	}
+
+	// BackToFront draws the deepest sprites first, FrontToBack the nearest; sprites at the same depth keep their order.
+	{
+		Texture2D* const textures[] = { &a, &a, &a, &a, &a, &a };
+		const float depths[] = { 0.2f, 0.8f, 0.5f, 0.8f, 0.0f, 1.0f };
+		const int backToFront[] = { 5, 1, 3, 2, 0, 4 };
+		const int frontToBack[] = { 4, 0, 2, 1, 3, 5 };
+
+		CheckOrder(device, batch, SpriteSortMode::BackToFront, textures, depths, 6, backToFront, 1);
+		CheckOrder(device, batch, SpriteSortMode::FrontToBack, textures, depths, 6, frontToBack, 1);
+	}
+
+	// Sorting by depth splits the runs of a texture wherever another texture comes in between.
+	{
+		Texture2D* const textures[] = { &a, &b, &a, &b };
+		const float depths[] = { 0.1f, 0.2f, 0.3f, 0.4f };
+		const int backToFront[] = { 3, 2, 1, 0 };
+		const int frontToBack[] = { 0, 1, 2, 3 };
+
+		CheckOrder(device, batch, SpriteSortMode::BackToFront, textures, depths, 4, backToFront, 4);
+		CheckOrder(device, batch, SpriteSortMode::FrontToBack, textures, depths, 4, frontToBack, 4);
+	}
+
+	// A run is split where the ring buffer wraps around.
+	{
+		Texture2D* textures[100];
+		float depths[100];
+		int order[100];
+		const int count = 100;
+
+		for (int i = 0; i < count; i++)
+		{
+			textures[i] = &a;
+			depths[i] = 0.0f;
+			order[i] = i;
+		}
+
+		batch.vertexBufferPosition = SpriteBatch::MaxBatchSize - 50;
+		CheckOrder(device, batch, SpriteSortMode::Deferred, textures, depths, count, order, 2);
+	}
+
+	// The recorder counts what each frame sends. The first frame starts from a device whose state is unknown,
+	// the second finds everything but the textures already set, and costs less.
+	struct s_PbStats frames[2];
+
+	device.InvalidateRenderState();
+	pb_finished();
+
+	for (int frame = 0; frame < 2; frame++)
+	{
+		Recording recording;
+		const DWORD start = Mark();
+
+		batch.Begin(SpriteSortMode::Texture, BlendState::AlphaBlend);
+
+		for (int i = 0; i < 300; i++)
+		{
+			Texture2D* texture = (i % 3 == 0) ? &a : ((i % 3 == 1) ? &b : &c);
+
+			batch.Draw(texture, Rectangle(i * 10, 0, 4, 4), Color::White);
+		}
+
+		batch.End();
+		pb_finished();
+		pb_get_frame_stats(&frames[frame]);
+		Parse(batch, start, recording);
+
+		CHECK(frames[frame].Dwords == Mark() - start);
+		CHECK(frames[frame].DrawCalls == 3 && recording.draws == 3);
+
+		printf("SpriteBatchTest: frame %d, 300 sprites in 3 textures: %d bytes, %d methods, %d draw calls, %d state changes\n", frame,
+			(int)frames[frame].Dwords * 4, (int)frames[frame].Methods, (int)frames[frame].DrawCalls, (int)frames[frame].StateChanges);
+	}
+
+	CHECK(frames[1].StateChanges < frames[0].StateChanges);
+	CHECK(frames[1].Dwords < frames[0].Dwords);
+
+	// A null texture is refused instead of drawn.
+	const int asserts = hostAssertFailures;
+	Recording recording;
+	const DWORD start = Mark();
+
+	batch.Begin();
+	batch.Draw(null, Rectangle(0, 0, 4, 4), null, Color::White, 0.0f, Vector2::Zero, SpriteEffects::None, 0.0f);
+	batch.End();
+	Parse(batch, start, recording);
+
+	CHECK(hostAssertFailures == asserts + 1);
+	CHECK(recording.draws == 0);
+	hostAssertFailures = asserts;
+
+	return HostTestResult("SpriteBatchTest");
+}
@@ -0,0 +1,206 @@
+// Copyright (C) XFX Team
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without 
+// modification, are permitted provided that the following conditions are met:
+// 
+//* Redistributions of source code must retain the above copyright 
+//notice, this list of conditions and the following disclaimer.
+//* Redistributions in binary form must reproduce the above copyright 
+//notice, this list of conditions and the following disclaimer in the 
+//documentation and/or other materials provided with the distribution.
+//* Neither the name of the copyright holder nor the names of any 
+//contributors may be used to endorse or promote products derived from 
+//this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE 
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF 
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS 
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE 
+// POSSIBILITY OF SUCH DAMAGE.
+
+// Checks the eviction order, the hit and miss counters and the memory cap of TextLayoutCache,
+// first on a few hand-picked cases and then against a simple model over random sequences of lookups and additions.
+
+#include "TextLayoutCache.h"
+
+#include <string.h>
+
+#include "HostTest.h"
+
+using namespace XFX;
+using namespace XFX::Graphics;
+
+static const Vector2 One(1.0f, 1.0f);
+
+static int LayoutSize(const char text[], const int quadCount)
+{
+	return sizeof(TextLayoutCache::TextLayout) + quadCount * sizeof(TextLayoutCache::GlyphQuad) + strlen(text);
+}
+
+static TextLayoutCache::TextLayout* Add(TextLayoutCache& cache, const char text[])
+{
+	return cache.Add(text, strlen(text), One, SpriteEffects::None, strlen(text));
+}
+
+static bool Cached(TextLayoutCache& cache, const char text[])
+{
+	return cache.Find(text, strlen(text), One, SpriteEffects::None) != null;
+}
+
+static void CheckOrder()
+{
+	// Room for exactly three of these layouts.
+	TextLayoutCache cache(3 * LayoutSize("aaaa", 4));
+
+	Add(cache, "aaaa");
+	Add(cache, "bbbb");
+	Add(cache, "cccc");
+	CHECK(cache.Size() == 3 * LayoutSize("aaaa", 4));
+
+	// a becomes the most recently used, so d pushes out b.
+	CHECK(Cached(cache, "aaaa"));
+	Add(cache, "dddd");
+	CHECK(!Cached(cache, "bbbb"));
+	CHECK(Cached(cache, "cccc"));
+	CHECK(Cached(cache, "aaaa"));
+	CHECK(Cached(cache, "dddd"));
+	CHECK(cache.Hits() == 4);
+	CHECK(cache.Misses() == 1);
+
+	// The scale and the effects are part of the key.
+	CHECK(cache.Find("aaaa", 4, Vector2(2.0f, 1.0f), SpriteEffects::None) == null);
+	CHECK(cache.Find("aaaa", 4, One, SpriteEffects::FlipHorizontally) == null);
+	CHECK(cache.Misses() == 3);
+
+	// A layout larger than the cache is returned, but neither cached nor allowed to push anything out.
+	char text[1024];
+	memset(text, 'x', sizeof(text) - 1);
+	text[sizeof(text) - 1] = '\0';
+	TextLayoutCache::TextLayout* large = Add(cache, text);
+	CHECK(large != null);
+	large->Quads[1000].Glyph = 1;
+	CHECK(cache.Size() == 3 * LayoutSize("aaaa", 4));
+	CHECK(!Cached(cache, text));
+	CHECK(Cached(cache, "cccc"));
+
+	// Shrinking the capacity drops the least recently used layouts: a, then d.
+	cache.setCapacity(LayoutSize("aaaa", 4));
+	CHECK(cache.Size() == LayoutSize("aaaa", 4));
+	CHECK(Cached(cache, "cccc"));
+	CHECK(!Cached(cache, "aaaa"));
+
+	cache.Clear();
+	CHECK(cache.Size() == 0);
+	CHECK(!Cached(cache, "cccc"));
+}
+
+// The cache as a list of keys ordered from the most to the least recently used.
+struct Model
+{
+	int keys[64];
+	int sizes[64];
+	int count;
+	int size;
+	int hits;
+	int misses;
+
+	bool Find(const int key)
+	{
+		for (int i = 0; i < count; i++)
+		{
+			if (keys[i] == key)
+			{
+				for (; i > 0; i--)
+				{
+					keys[i] = keys[i - 1];
+					sizes[i] = sizes[i - 1];
+				}
+
+				keys[0] = key;
+				sizes[0] = Size(key);
+				hits++;
+				return true;
+			}
+		}
+
+		misses++;
+		return false;
+	}
+
+	void Add(const int key, const int capacity)
+	{
+		const int layoutSize = Size(key);
+
+		if (layoutSize > capacity)
+		{
+			return;
+		}
+
+		while (count > 0 && size + layoutSize > capacity)
+		{
+			size -= sizes[--count];
+		}
+
+		for (int i = count; i > 0; i--)
+		{
+			keys[i] = keys[i - 1];
+			sizes[i] = sizes[i - 1];
+		}
+
+		keys[0] = key;
+		sizes[0] = layoutSize;
+		count++;
+		size += layoutSize;
+	}
+
+	static int Size(const int key)
+	{
+		return sizeof(TextLayoutCache::TextLayout) + (key % 7) * 40 * sizeof(TextLayoutCache::GlyphQuad) + 8;
+	}
+};
+
+static void CheckAgainstModel()
+{
+	const int capacity = 4096;
+	TextLayoutCache cache(capacity);
+	Model model = { { 0 }, { 0 }, 0, 0, 0, 0 };
+	unsigned int seed = 12345;
+
+	for (int i = 0; i < 100000; i++)
+	{
+		seed = seed * 1103515245 + 12345;
+		const int key = (seed >> 8) % 40;
+		char text[9];
+		sprintf(text, "key%05d", key);
+
+		const bool cached = cache.Find(text, 8, One, SpriteEffects::None) != null;
+		CHECK(cached == model.Find(key));
+
+		if (!cached)
+		{
+			cache.Add(text, 8, One, SpriteEffects::None, (key % 7) * 40);
+			model.Add(key, capacity);
+		}
+
+		CHECK(cache.Size() == model.size);
+		CHECK(cache.Size() <= capacity);
+	}
+
+	CHECK(cache.Hits() == model.hits);
+	CHECK(cache.Misses() == model.misses);
+}
+
+int main()
+{
+	CheckOrder();
+	CheckAgainstModel();
+
+	return HostTestResult("TextLayoutCacheTest");
+}
@@ -0,0 +1,266 @@
+// Copyright (C) XFX Team
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without 
+// modification, are permitted provided that the following conditions are met:
+// 
+//* Redistributions of source code must retain the above copyright 
+//notice, this list of conditions and the following disclaimer.
+//* Redistributions in binary form must reproduce the above copyright 
+//notice, this list of conditions and the following disclaimer in the 
+//documentation and/or other materials provided with the distribution.
+//* Neither the name of the copyright holder nor the names of any 
+//contributors may be used to endorse or promote products derived from 
+//this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE 
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF 
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS 
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE 
+// POSSIBILITY OF SUCH DAMAGE.
+
+// Loads Texture2D assets from .xnb files through ContentManager, and checks the texels of the top level of Color and DXT1
+// textures with mipmaps, that the other levels are skipped without disturbing the rest of the stream, and that an existing
+// texture of the same size is read into.
+
+#include <Content/ContentManager.h>
+#include <Content/ContentReader.h>
+#include <Graphics/GraphicsDevice.h>
+#include <Graphics/IGraphicsDeviceService.h>
+#include <Graphics/PresentationParameters.h>
+#include <Graphics/Texture2D.h>
+#include <System/IO/MappedFileStream.h>
+
+#include "DxtUtil.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "HostTest.h"
+
+using namespace XFX;
+using namespace XFX::Content;
+using namespace XFX::Graphics;
+
+// XNA 4.0 SurfaceFormat values, as .xnb files store them.
+static const int XnbColor = 0;
+static const int XnbDxt1 = 4;
+
+static const char readerName[] = "Microsoft.Xna.Framework.Content.Texture2DReader";
+// The header, the table with the one type reader, the shared resource count and the type of the asset.
+static const int PreambleSize = 10 + 1 + 1 + (sizeof(readerName) - 1) + 4 + 1 + 1;
+
+class TestGraphicsDeviceService : public IGraphicsDeviceService
+{
+public:
+	GraphicsDevice* device;
+
+	GraphicsDevice* getGraphicsDevice() const
+	{
+		return device;
+	}
+};
+
+class TestServiceProvider : public IServiceProvider
+{
+public:
+	TestGraphicsDeviceService graphicsService;
+
+	Object* GetService(const Type& serviceType)
+	{
+		return (&serviceType == &IGraphicsDeviceService::GetType()) ? &graphicsService : null;
+	}
+};
+
+static void WriteInt32(FILE* file, const int value)
+{
+	fwrite(&value, sizeof(value), 1, file);
+}
+
+// An uncompressed .xnb file holding one Texture2D: the header, the type reader table, no shared resources, the texture,
+// and a sentinel after it. Each level is filled with bytes counting up from its level number times 64.
+static void WriteTexture(const char path[], const int format, const int width, const int height, const int levelCount, const int levelSizes[])
+{
+	FILE* file = fopen(path, "wb");
+	int size = PreambleSize + 16 + 4;
+
+	for (int level = 0; level < levelCount; level++)
+	{
+		size += 4 + levelSizes[level];
+	}
+
+	fwrite("XNBx\x05\x00", 1, 6, file);
+	WriteInt32(file, size);
+	fputc(1, file);
+	fputc(sizeof(readerName) - 1, file);
+	fwrite(readerName, 1, sizeof(readerName) - 1, file);
+	WriteInt32(file, 0);
+	fputc(0, file);
+	fputc(1, file);
+	WriteInt32(file, format);
+	WriteInt32(file, width);
+	WriteInt32(file, height);
+	WriteInt32(file, levelCount);
+
+	for (int level = 0; level < levelCount; level++)
+	{
+		WriteInt32(file, levelSizes[level]);
+
+		for (int i = 0; i < levelSizes[level]; i++)
+		{
+			fputc((level * 64 + i) & 0xff, file);
+		}
+	}
+
+	WriteInt32(file, 0x5e471e1);
+	fclose(file);
+}
+
+// Reads the texture in a file with a ContentReader of its own, so that the sentinel after it can be checked.
+static Texture2D* ReadTexture(GraphicsDevice& device, const char path[], Texture2D* existingInstance)
+{
+	MappedFileStream stream(path);
+	ContentReader reader(null, &stream, &device);
+
+	reader.ReadSpan(PreambleSize);
+
+	Texture2D* texture = ContentTypeReaderFor<Texture2D>::Read(&reader, existingInstance);
+
+	CHECK(reader.ReadInt32() == 0x5e471e1);
+	return texture;
+}
+
+static void CheckColor(GraphicsDevice& device, ContentManager& content)
+{
+	// 5x3 with levels of 2x1 and 1x1: sizes that are not powers of two must not matter.
+	const int levelSizes[] = { 5 * 3 * 4, 2 * 1 * 4, 1 * 1 * 4 };
+	byte expected[5 * 3 * 4];
+	uint texels[5 * 3];
+
+	WriteTexture("color.xnb", XnbColor, 5, 3, 3, levelSizes);
+
+	for (int i = 0; i < (int)sizeof(expected); i++)
+	{
+		expected[i] = (byte)i;
+	}
+
+	Texture2D* texture = content.Load<Texture2D>("color");
+
+	CHECK(texture != null && texture->Width == 5 && texture->Height == 3);
+	CHECK(texture->Format() == SurfaceFormat::Color);
+	CHECK(texture->getGraphicsDevice() == &device);
+
+	texture->GetData(texels, 0, 5 * 3);
+	CHECK(memcmp(texels, expected, sizeof(expected)) == 0);
+
+	// The levels after the top one are read past.
+	Texture2D* read = ReadTexture(device, "color.xnb", null);
+
+	read->GetData(texels, 0, 5 * 3);
+	CHECK(memcmp(texels, expected, sizeof(expected)) == 0);
+
+	// A texture of the same size is read into, and one of another size is not.
+	CHECK(ReadTexture(device, "color.xnb", read) == read);
+
+	Texture2D other(&device, 4, 4);
+	Texture2D* replaced = ReadTexture(device, "color.xnb", &other);
+
+	CHECK(replaced != &other && replaced->Width == 5);
+
+	delete replaced;
+	delete read;
+	unlink("color.xnb");
+}
+
+static void CheckDxt1(GraphicsDevice& device, ContentManager& content)
+{
+	// 8x8 with levels down to 1x1; every level takes at least one 8 byte block.
+	const int levelSizes[] = { 4 * 8, 8, 8, 8 };
+	byte levelData[4 * 8];
+	uint texels[8 * 8];
+
+	WriteTexture("dxt1.xnb", XnbDxt1, 8, 8, 4, levelSizes);
+
+	for (int i = 0; i < (int)sizeof(levelData); i++)
+	{
+		levelData[i] = (byte)i;
+	}
+
+	byte* expected = DxtUtil::DecompressDxt1(levelData, 8, 8);
+	Texture2D* texture = content.Load<Texture2D>("dxt1");
+
+	CHECK(texture != null && texture->Width == 8 && texture->Height == 8);
+	CHECK(texture->Format() == SurfaceFormat::Color);
+
+	texture->GetData(texels, 0, 8 * 8);
+	CHECK(memcmp(texels, expected, sizeof(texels)) == 0);
+
+	Texture2D* read = ReadTexture(device, "dxt1.xnb", null);
+
+	read->GetData(texels, 0, 8 * 8);
+	CHECK(memcmp(texels, expected, sizeof(texels)) == 0);
+
+	delete read;
+	delete[] expected;
+
+	// A solid red block: both endpoints 0xF800, so every index decodes to opaque red.
+	const int redSizes[] = { 8 };
+	const byte red[] = { 0x00, 0xF8, 0x00, 0xF8, 0, 0, 0, 0 };
+	FILE* file;
+
+	WriteTexture("red.xnb", XnbDxt1, 4, 4, 1, redSizes);
+	file = fopen("red.xnb", "r+b");
+	fseek(file, -4 - 8, SEEK_END);
+	fwrite(red, 1, sizeof(red), file);
+	fclose(file);
+
+	texture = content.Load<Texture2D>("red");
+	texture->GetData(texels, 0, 4 * 4);
+
+	for (int i = 0; i < 4 * 4; i++)
+	{
+		const byte* texel = (const byte*)&texels[i];
+
+		CHECK(texel[0] == 255 && texel[1] == 0 && texel[2] == 0 && texel[3] == 255);
+	}
+
+	unlink("dxt1.xnb");
+	unlink("red.xnb");
+}
+
+int main()
+{
+	char directory[] = "/tmp/xfx-texture-XXXXXX";
+	char cwd[1024];
+
+	CHECK(mkdtemp(directory) != null);
+	CHECK(getcwd(cwd, sizeof(cwd)) != null);
+	CHECK(chdir(directory) == 0);
+
+	PresentationParameters presentationParameters;
+	presentationParameters.BackBufferWidth = 640;
+	presentationParameters.BackBufferHeight = 480;
+
+	GraphicsDevice device(null, &presentationParameters);
+	TestServiceProvider services;
+	services.graphicsService.device = &device;
+
+	ContentManager content(&services);
+
+	CheckColor(device, content);
+	CheckDxt1(device, content);
+
+	content.Dispose();
+
+	CHECK(chdir(cwd) == 0);
+	rmdir(directory);
+
+	return HostTestResult("Texture2DReaderTest");
+}
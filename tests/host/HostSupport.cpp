@@ -0,0 +1,101 @@
+// Copyright (C) XFX Team
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without 
+// modification, are permitted provided that the following conditions are met:
+// 
+//* Redistributions of source code must retain the above copyright 
+//notice, this list of conditions and the following disclaimer.
+//* Redistributions in binary form must reproduce the above copyright 
+//notice, this list of conditions and the following disclaimer in the 
+//documentation and/or other materials provided with the distribution.
+//* Neither the name of the copyright holder nor the names of any 
+//contributors may be used to endorse or promote products derived from 
+//this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE 
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF 
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS 
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE 
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include "HostTest.h"
+
+#include <System/Threading/Thread.h>
+#include <xboxkrnl/xboxkrnl.h>
+
+#include <stdarg.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <sassert.h>
+
+int hostCheckFailures = 0;
+int hostAssertFailures = 0;
+
+extern "C" void __sassert(const char *fileName, int lineNumber, const char* conditionString, const char* message)
+{
+	hostAssertFailures++;
+	fprintf(stderr, "%s:%d: sassert(%s) failed: %s\n", fileName, lineNumber, conditionString, message);
+}
+
+extern "C" void debugPrint(const char* format, ...)
+{
+	va_list args;
+	va_start(args, format);
+	vfprintf(stderr, format, args);
+	va_end(args);
+}
+
+PVOID MmAllocateContiguousMemoryEx(ULONG NumberOfBytes, ULONG_PTR LowestAcceptableAddress, ULONG_PTR HighestAcceptableAddress, ULONG Alignment, ULONG Protect)
+{
+	return malloc(NumberOfBytes);
+}
+
+VOID MmFreeContiguousMemory(PVOID BaseAddress)
+{
+	free(BaseAddress);
+}
+
+extern "C" void XSleep(int milliseconds)
+{
+	usleep(milliseconds * 1000);
+}
+
+// Thread.cpp is built on the Xbox kernel; these are the members the tested sources use.
+void System::Threading::Thread::Sleep(int millisecondsTimeout)
+{
+	usleep(millisecondsTimeout * 1000);
+}
+
+void HostCheckFailed(const char* fileName, int lineNumber, const char* conditionString)
+{
+	hostCheckFailures++;
+	fprintf(stderr, "%s:%d: CHECK(%s) failed\n", fileName, lineNumber, conditionString);
+}
+
+int HostTestResult(const char* testName)
+{
+	if (hostCheckFailures == 0 && hostAssertFailures == 0)
+	{
+		printf("%s: passed\n", testName);
+		return 0;
+	}
+
+	printf("%s: %d checks and %d sasserts failed\n", testName, hostCheckFailures, hostAssertFailures);
+	return 1;
+}
+
+double HostSeconds()
+{
+	timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return now.tv_sec + now.tv_nsec * 1e-9;
+}
@@ -0,0 +1,31 @@
+/*****************************************************************************
+ *	HostTest.h																 *
+ *																			 *
+ *	Checks shared by the host builds of the XFX tests						 *
+ *	Copyright (c) XFX Team. All Rights Reserved 							 *
+ *****************************************************************************/
+#ifndef _XFX_HOSTTEST_
+#define _XFX_HOSTTEST_
+
+#include <stdio.h>
+
+// The number of failed checks so far, and of sassert failures reported by the library.
+extern int hostCheckFailures;
+extern int hostAssertFailures;
+
+/**
+ * Reports a failed check with its location, and keeps going.
+ */
+#define CHECK(e) ((e) ? (void)0 : HostCheckFailed(__FILE__, __LINE__, #e))
+
+void HostCheckFailed(const char* fileName, int lineNumber, const char* conditionString);
+/**
+ * Prints the result of a test and returns the exit code for main: 0 if no check or sassert failed.
+ */
+int HostTestResult(const char* testName);
+/**
+ * Returns a monotonic time in seconds, for benchmarks.
+ */
+double HostSeconds();
+
+#endif //_XFX_HOSTTEST_
@@ -0,0 +1,761 @@
+// Copyright (C) XFX Team
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without 
+// modification, are permitted provided that the following conditions are met:
+// 
+//* Redistributions of source code must retain the above copyright 
+//notice, this list of conditions and the following disclaimer.
+//* Redistributions in binary form must reproduce the above copyright 
+//notice, this list of conditions and the following disclaimer in the 
+//documentation and/or other materials provided with the distribution.
+//* Neither the name of the copyright holder nor the names of any 
+//contributors may be used to endorse or promote products derived from 
+//this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE 
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF 
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS 
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE 
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include "LzxEncoder.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+static const int FrameSize = 0x8000;
+static const int WindowSize = 0x10000;
+static const int NumChars = 256;
+static const int PositionSlots = 32;
+static const int MainElements = NumChars + PositionSlots * 8;
+static const int LengthElements = 249;
+static const int PretreeElements = 20;
+static const int AlignedElements = 8;
+static const int MinMatch = 3;
+static const int MaxMatch = 257;
+static const int MaxChainLength = 16;
+static const int HashBits = 15;
+
+static const unsigned int PositionBase[PositionSlots] =
+{
+	0, 1, 2, 3, 4, 6, 8, 12, 16, 24, 32, 48, 64, 96, 128, 192, 256, 384, 512, 768, 1024, 1536, 2048, 3072, 4096, 6144,
+	8192, 12288, 16384, 24576, 32768, 49152
+};
+
+static const int ExtraBits[PositionSlots] =
+{
+	0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13, 14, 14
+};
+
+// A literal, or a match with its main tree symbol, length tree footer and position footer.
+struct Token
+{
+	int symbol;
+	int lengthFooter;
+	unsigned int positionFooter;
+	int positionBits;
+	int length;
+};
+
+// Writes bits most significant first into little-endian 16-bit words, as LZX reads them.
+struct BitWriter
+{
+	unsigned char* data;
+	int size;
+	int capacity;
+	unsigned int accumulator;
+	int count;
+
+	BitWriter()
+		: data(NULL), size(0), capacity(0), accumulator(0), count(0)
+	{
+	}
+
+	void Byte(const unsigned char value)
+	{
+		if (size == capacity)
+		{
+			capacity = (capacity == 0) ? 65536 : capacity * 2;
+			data = (unsigned char*)realloc(data, capacity);
+		}
+
+		data[size++] = value;
+	}
+
+	void Bits(const unsigned int value, const int bitCount)
+	{
+		for (int i = bitCount - 1; i >= 0; i--)
+		{
+			accumulator = (accumulator << 1) | ((value >> i) & 1);
+
+			if (++count == 16)
+			{
+				Byte(accumulator & 0xFF);
+				Byte(accumulator >> 8);
+				accumulator = 0;
+				count = 0;
+			}
+		}
+	}
+
+	void Align()
+	{
+		if (count != 0)
+		{
+			Bits(0, 16 - count);
+		}
+	}
+};
+
+// Code lengths no longer than maxLength for the symbols that occur. The frequencies are flattened until the tree fits.
+static void HuffmanLengths(const int frequencies[], const int symbolCount, const int maxLength, unsigned char lengths[])
+{
+	int weights[2 * MainElements];
+	int parents[2 * MainElements];
+	bool merged[2 * MainElements];
+	int used = 0;
+
+	memset(lengths, 0, symbolCount);
+
+	for (int i = 0; i < symbolCount; i++)
+	{
+		weights[i] = frequencies[i];
+		used += (frequencies[i] > 0);
+	}
+
+	if (used == 0)
+	{
+		return;
+	}
+
+	// A complete tree needs two symbols.
+	if (used == 1)
+	{
+		weights[(weights[0] == 0) ? 0 : 1] = 1;
+	}
+
+	for (;;)
+	{
+		int nodeCount = symbolCount;
+
+		for (int i = 0; i < symbolCount; i++)
+		{
+			parents[i] = -1;
+			merged[i] = (weights[i] == 0);
+		}
+
+		for (;;)
+		{
+			int first = -1;
+			int second = -1;
+
+			for (int i = 0; i < nodeCount; i++)
+			{
+				if (merged[i])
+				{
+					continue;
+				}
+
+				if (first < 0 || weights[i] < weights[first])
+				{
+					second = first;
+					first = i;
+				}
+				else if (second < 0 || weights[i] < weights[second])
+				{
+					second = i;
+				}
+			}
+
+			if (second < 0)
+			{
+				break;
+			}
+
+			weights[nodeCount] = weights[first] + weights[second];
+			parents[nodeCount] = -1;
+			merged[nodeCount] = false;
+			parents[first] = parents[second] = nodeCount;
+			merged[first] = merged[second] = true;
+			nodeCount++;
+		}
+
+		int longest = 0;
+
+		for (int i = 0; i < symbolCount; i++)
+		{
+			if (weights[i] == 0)
+			{
+				continue;
+			}
+
+			int depth = 0;
+
+			for (int node = i; parents[node] >= 0; node = parents[node])
+			{
+				depth++;
+			}
+
+			lengths[i] = depth;
+			longest = (depth > longest) ? depth : longest;
+		}
+
+		if (longest <= maxLength)
+		{
+			return;
+		}
+
+		for (int i = 0; i < symbolCount; i++)
+		{
+			weights[i] = (weights[i] > 0) ? (weights[i] >> 1) + 1 : 0;
+		}
+	}
+}
+
+static void CanonicalCodes(const unsigned char lengths[], const int symbolCount, unsigned int codes[])
+{
+	unsigned int code = 0;
+
+	for (int length = 1; length <= 16; length++)
+	{
+		for (int i = 0; i < symbolCount; i++)
+		{
+			if (lengths[i] == length)
+			{
+				codes[i] = code++;
+			}
+		}
+
+		code <<= 1;
+	}
+}
+
+// Writes lengths[first, last) through a pretree, as deltas from the previous lengths with runs of zeros and of equal lengths.
+static void WriteLengths(BitWriter& writer, const unsigned char previous[], const unsigned char lengths[], const int first, const int last)
+{
+	int symbols[MainElements];
+	int arguments[MainElements];
+	int deltas[MainElements];
+	int frequencies[PretreeElements] = { 0 };
+	int count = 0;
+
+	for (int i = first; i < last; )
+	{
+		int run = 0;
+
+		while (i + run < last && lengths[i + run] == lengths[i] && run < ((lengths[i] == 0) ? 51 : 5))
+		{
+			run++;
+		}
+
+		if (lengths[i] == 0 && run >= 20)
+		{
+			symbols[count] = 18;
+			arguments[count++] = run - 20;
+		}
+		else if (lengths[i] == 0 && run >= 4)
+		{
+			run = (run > 19) ? 19 : run;
+			symbols[count] = 17;
+			arguments[count++] = run - 4;
+		}
+		else if (lengths[i] != 0 && run >= 4)
+		{
+			symbols[count] = 19;
+			arguments[count] = run - 4;
+			deltas[count] = (previous[i] - lengths[i] + 17) % 17;
+			frequencies[deltas[count++]]++;
+		}
+		else
+		{
+			run = 1;
+			symbols[count++] = (previous[i] - lengths[i] + 17) % 17;
+		}
+
+		frequencies[symbols[count - 1]]++;
+		i += run;
+	}
+
+	unsigned char pretreeLengths[PretreeElements];
+	unsigned int pretreeCodes[PretreeElements];
+
+	HuffmanLengths(frequencies, PretreeElements, 15, pretreeLengths);
+	CanonicalCodes(pretreeLengths, PretreeElements, pretreeCodes);
+
+	for (int i = 0; i < PretreeElements; i++)
+	{
+		writer.Bits(pretreeLengths[i], 4);
+	}
+
+	for (int i = 0; i < count; i++)
+	{
+		writer.Bits(pretreeCodes[symbols[i]], pretreeLengths[symbols[i]]);
+
+		if (symbols[i] == 17)
+		{
+			writer.Bits(arguments[i], 4);
+		}
+		else if (symbols[i] == 18)
+		{
+			writer.Bits(arguments[i], 5);
+		}
+		else if (symbols[i] == 19)
+		{
+			writer.Bits(arguments[i], 1);
+			writer.Bits(pretreeCodes[deltas[i]], pretreeLengths[deltas[i]]);
+		}
+	}
+}
+
+class Encoder
+{
+private:
+	const unsigned char* data;
+	int length;
+	int* head;
+	int* chain;
+	int hashed;
+	unsigned int R0, R1, R2;
+	unsigned char mainPrevious[MainElements];
+	unsigned char lengthPrevious[LengthElements];
+	int position;
+	int frameStart;
+	int frameCut;
+	// The frames written so far: their uncompressed sizes, and where their bits start and end.
+	int frameCount;
+	int* frameSizes;
+	int* frameOffsets;
+
+	static int Hash(const unsigned char* p)
+	{
+		return ((p[0] << 10) ^ (p[1] << 5) ^ p[2]) & ((1 << HashBits) - 1);
+	}
+
+	void Insert(const int end)
+	{
+		for (; hashed < end && hashed + MinMatch <= length; hashed++)
+		{
+			const int hash = Hash(&data[hashed]);
+
+			chain[hashed] = head[hash];
+			head[hash] = hashed;
+		}
+	}
+
+	// Greedy matches over [start, end). Matches never cross the end of a frame.
+	int Tokenize(const int start, const int end, Token tokens[])
+	{
+		int count = 0;
+
+		for (int i = start; i < end; )
+		{
+			const int frameEnd = (i / FrameSize + 1) * FrameSize;
+			int limit = (end < frameEnd) ? end : frameEnd;
+			int bestLength = 0;
+			int bestDistance = 0;
+
+			limit = (limit < i + MaxMatch) ? limit : i + MaxMatch;
+			Insert(i);
+
+			if (i + MinMatch <= limit)
+			{
+				int candidate = head[Hash(&data[i])];
+
+				for (int steps = 0; candidate >= 0 && steps < MaxChainLength; steps++, candidate = chain[candidate])
+				{
+					if (i - candidate > WindowSize - 3)
+					{
+						break;
+					}
+
+					int matched = 0;
+
+					while (i + matched < limit && data[candidate + matched] == data[i + matched])
+					{
+						matched++;
+					}
+
+					if (matched > bestLength)
+					{
+						bestLength = matched;
+						bestDistance = i - candidate;
+					}
+				}
+			}
+
+			Token& token = tokens[count++];
+
+			if (bestLength < MinMatch)
+			{
+				token.symbol = data[i];
+				token.length = 1;
+				i++;
+				continue;
+			}
+
+			int slot;
+			const unsigned int distance = bestDistance;
+
+			if (distance == R0)
+			{
+				slot = 0;
+			}
+			else if (distance == R1)
+			{
+				slot = 1;
+				R1 = R0;
+				R0 = distance;
+			}
+			else if (distance == R2)
+			{
+				slot = 2;
+				R2 = R0;
+				R0 = distance;
+			}
+			else
+			{
+				const unsigned int formatted = distance + 2;
+
+				for (slot = PositionSlots - 1; PositionBase[slot] > formatted; slot--)
+				{
+				}
+
+				R2 = R1;
+				R1 = R0;
+				R0 = distance;
+			}
+
+			const int lengthHeader = (bestLength - 2 < 7) ? bestLength - 2 : 7;
+
+			token.symbol = NumChars + (slot << 3) + lengthHeader;
+			token.lengthFooter = (lengthHeader == 7) ? bestLength - 2 - 7 : -1;
+			token.positionBits = (slot >= 3) ? ExtraBits[slot] : 0;
+			token.positionFooter = (slot >= 3) ? distance + 2 - PositionBase[slot] : 0;
+			token.length = bestLength;
+			i += bestLength;
+		}
+
+		return count;
+	}
+
+	void Advance(BitWriter& writer, const int count)
+	{
+		position += count;
+
+		if (position - frameStart == FrameSize)
+		{
+			writer.Align();
+			EndFrame(writer);
+		}
+	}
+
+	void EndFrame(BitWriter& writer)
+	{
+		frameSizes[frameCount] = position - frameStart;
+		frameOffsets[frameCount++] = frameCut;
+		frameCut = writer.size;
+		frameStart = position;
+	}
+
+public:
+	BitWriter writer;
+
+	Encoder(const unsigned char source[], const int sourceLength)
+		: data(source), length(sourceLength), hashed(0), R0(1), R1(1), R2(1), position(0), frameStart(0), frameCut(0), frameCount(0)
+	{
+		head = (int*)malloc(sizeof(int) << HashBits);
+		chain = (int*)malloc(sizeof(int) * (length + 1));
+		frameSizes = (int*)malloc(sizeof(int) * (length / FrameSize + 2));
+		frameOffsets = (int*)malloc(sizeof(int) * (length / FrameSize + 3));
+		memset(head, 0xFF, sizeof(int) << HashBits);
+		memset(mainPrevious, 0, sizeof(mainPrevious));
+		memset(lengthPrevious, 0, sizeof(lengthPrevious));
+
+		// no E8 translation
+		writer.Bits(0, 1);
+	}
+
+	~Encoder()
+	{
+		free(head);
+		free(chain);
+		free(frameSizes);
+		free(frameOffsets);
+		free(writer.data);
+	}
+
+	void CompressedBlock(const int start, const int end, const bool aligned)
+	{
+		Token* tokens = (Token*)malloc(sizeof(Token) * (end - start));
+		const int count = Tokenize(start, end, tokens);
+		int mainFrequencies[MainElements] = { 0 };
+		int lengthFrequencies[LengthElements] = { 0 };
+		int alignedFrequencies[AlignedElements] = { 0 };
+
+		for (int i = 0; i < count; i++)
+		{
+			mainFrequencies[tokens[i].symbol]++;
+
+			if (tokens[i].symbol >= NumChars)
+			{
+				if (tokens[i].lengthFooter >= 0)
+				{
+					lengthFrequencies[tokens[i].lengthFooter]++;
+				}
+
+				if (aligned && tokens[i].positionBits >= 3)
+				{
+					alignedFrequencies[tokens[i].positionFooter & 7]++;
+				}
+			}
+		}
+
+		unsigned char mainLengths[MainElements];
+		unsigned char lengthLengths[LengthElements];
+		unsigned char alignedLengths[AlignedElements];
+		unsigned int mainCodes[MainElements];
+		unsigned int lengthCodes[LengthElements];
+		unsigned int alignedCodes[AlignedElements];
+
+		HuffmanLengths(mainFrequencies, MainElements, 16, mainLengths);
+		HuffmanLengths(lengthFrequencies, LengthElements, 16, lengthLengths);
+		CanonicalCodes(mainLengths, MainElements, mainCodes);
+		CanonicalCodes(lengthLengths, LengthElements, lengthCodes);
+
+		writer.Bits(aligned ? 2 : 1, 3);
+		writer.Bits((end - start) >> 8, 16);
+		writer.Bits((end - start) & 0xFF, 8);
+
+		if (aligned)
+		{
+			int alignedUsed = 0;
+
+			for (int i = 0; i < AlignedElements; i++)
+			{
+				alignedUsed += alignedFrequencies[i];
+			}
+
+			// A block with no aligned offsets still sends a complete tree.
+			if (alignedUsed == 0)
+			{
+				memset(alignedLengths, 3, sizeof(alignedLengths));
+			}
+			else
+			{
+				HuffmanLengths(alignedFrequencies, AlignedElements, 7, alignedLengths);
+			}
+
+			CanonicalCodes(alignedLengths, AlignedElements, alignedCodes);
+
+			for (int i = 0; i < AlignedElements; i++)
+			{
+				writer.Bits(alignedLengths[i], 3);
+			}
+		}
+
+		WriteLengths(writer, mainPrevious, mainLengths, 0, NumChars);
+		WriteLengths(writer, mainPrevious, mainLengths, NumChars, MainElements);
+		WriteLengths(writer, lengthPrevious, lengthLengths, 0, LengthElements);
+		memcpy(mainPrevious, mainLengths, sizeof(mainPrevious));
+		memcpy(lengthPrevious, lengthLengths, sizeof(lengthPrevious));
+
+		for (int i = 0; i < count; i++)
+		{
+			const Token& token = tokens[i];
+
+			writer.Bits(mainCodes[token.symbol], mainLengths[token.symbol]);
+
+			if (token.symbol >= NumChars)
+			{
+				if (token.lengthFooter >= 0)
+				{
+					writer.Bits(lengthCodes[token.lengthFooter], lengthLengths[token.lengthFooter]);
+				}
+
+				if (aligned && token.positionBits >= 3)
+				{
+					writer.Bits(token.positionFooter >> 3, token.positionBits - 3);
+					writer.Bits(alignedCodes[token.positionFooter & 7], alignedLengths[token.positionFooter & 7]);
+				}
+				else
+				{
+					writer.Bits(token.positionFooter, token.positionBits);
+				}
+			}
+
+			Advance(writer, token.length);
+		}
+
+		free(tokens);
+	}
+
+	void UncompressedBlock(const int start, const int end)
+	{
+		writer.Bits(3, 3);
+		writer.Bits((end - start) >> 8, 16);
+		writer.Bits((end - start) & 0xFF, 8);
+
+		if (writer.count == 0)
+		{
+			writer.Bits(0, 16);
+		}
+		else
+		{
+			writer.Align();
+		}
+
+		const unsigned int offsets[3] = { R0, R1, R2 };
+
+		for (int i = 0; i < 3; i++)
+		{
+			for (int shift = 0; shift < 32; shift += 8)
+			{
+				writer.Byte((offsets[i] >> shift) & 0xFF);
+			}
+		}
+
+		for (int i = start; i < end; i++)
+		{
+			writer.Byte(data[i]);
+			Advance(writer, 1);
+		}
+
+		if ((end - start) & 1)
+		{
+			writer.Byte(0);
+		}
+	}
+
+	unsigned char* Finish(int& compressedLength)
+	{
+		writer.Align();
+
+		if (position > frameStart)
+		{
+			EndFrame(writer);
+		}
+
+		frameOffsets[frameCount] = writer.size;
+
+		unsigned char* output = (unsigned char*)malloc(writer.size + frameCount * 5 + 1);
+		int size = 0;
+
+		for (int i = 0; i < frameCount; i++)
+		{
+			const int frameLength = frameOffsets[i + 1] - frameOffsets[i];
+
+			if (frameSizes[i] != FrameSize)
+			{
+				output[size++] = 0xFF;
+				output[size++] = frameSizes[i] >> 8;
+				output[size++] = frameSizes[i] & 0xFF;
+			}
+
+			output[size++] = frameLength >> 8;
+			output[size++] = frameLength & 0xFF;
+			memcpy(&output[size], &writer.data[frameOffsets[i]], frameLength);
+			size += frameLength;
+		}
+
+		compressedLength = size;
+		return output;
+	}
+};
+
+unsigned char* LzxEncoder::Compress(const unsigned char source[], const int length, const BlockTypes blockTypes, int& compressedLength)
+{
+	Encoder encoder(source, length);
+
+	for (int start = 0, block = 0; start < length; block++)
+	{
+		const int type = (blockTypes == Mixed) ? block % 4 : 0;
+		// Uncompressed blocks have an even length, so none needs padding at the end of a frame.
+		int end = (type == 3) ? start + ((2000 + (block * 4231) % 8000) & ~1) : start + 20000 + (block * 7919) % 30000;
+
+		end = (end < length) ? end : length;
+
+		if (type == 3)
+		{
+			encoder.UncompressedBlock(start, end);
+		}
+		else
+		{
+			encoder.CompressedBlock(start, end, type == 1);
+		}
+
+		start = end;
+	}
+
+	return encoder.Finish(compressedLength);
+}
+
+void LzxEncoder::SampleData(unsigned char data[], const int length, unsigned int seed)
+{
+	unsigned char words[300][10];
+	int wordLengths[300];
+	int size = 0;
+
+#define NEXT() (seed = seed * 1103515245 + 12345, (seed >> 8) & 0xFFFF)
+
+	for (int i = 0; i < 300; i++)
+	{
+		wordLengths[i] = 2 + NEXT() % 8;
+
+		for (int j = 0; j < wordLengths[i]; j++)
+		{
+			words[i][j] = 'a' + NEXT() % 26;
+		}
+
+		words[i][wordLengths[i]] = ' ';
+	}
+
+	while (size < length)
+	{
+		const int kind = NEXT() % 10;
+
+		if (kind < 7)
+		{
+			const int word = NEXT() % 300;
+
+			for (int j = 0; j <= wordLengths[word] && size < length; j++)
+			{
+				data[size++] = words[word][j];
+			}
+		}
+		else if (kind == 7)
+		{
+			for (int count = 1 + NEXT() % 40; count > 0 && size < length; count--)
+			{
+				data[size++] = NEXT() & 0xFF;
+			}
+		}
+		else if (kind == 8 && size > 1000)
+		{
+			const int maxDistance = (size < 60000) ? size : 60000;
+			const int distance = 1 + (NEXT() * 65536 + NEXT()) % maxDistance;
+
+			for (int count = 10 + NEXT() % 290; count > 0 && size < length; count--, size++)
+			{
+				data[size] = data[size - distance];
+			}
+		}
+		else
+		{
+			const unsigned char value = NEXT() & 0xFF;
+
+			for (int count = 1 + NEXT() % 300; count > 0 && size < length; count--)
+			{
+				data[size++] = value;
+			}
+		}
+	}
+
+#undef NEXT
+}
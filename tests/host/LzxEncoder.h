@@ -0,0 +1,41 @@
+/*****************************************************************************
+ *	LzxEncoder.h															 *
+ *																			 *
+ *	LZX compressor for the host tests and benchmarks						 *
+ *	Copyright (c) XFX Team. All Rights Reserved 							 *
+ *****************************************************************************/
+#ifndef _XFX_HOST_LZXENCODER_
+#define _XFX_HOST_LZXENCODER_
+
+/**
+ * Compresses data as the XNA content pipeline does: a 64KB window, 32KB frames, and no E8 translation.
+ *
+ * The output is the body of a compressed .xnb file, as LzxDecoderStream reads it: each frame is preceded by its compressed size
+ * (big-endian), and by 0xFF and its uncompressed size when it is not 32KB. Matches are found greedily, so the ratio is worse than
+ * XNA's, but every block type and tree encoding the decoder handles is produced.
+ */
+class LzxEncoder
+{
+public:
+	enum BlockTypes
+	{
+		// Verbatim blocks only.
+		Verbatim,
+		// Verbatim, aligned offset and uncompressed blocks in turn.
+		Mixed
+	};
+
+	/**
+	 * Compresses length bytes of source.
+	 *
+	 * @return
+	 * The compressed data, to be released with free.
+	 */
+	static unsigned char* Compress(const unsigned char source[], const int length, const BlockTypes blockTypes, int& compressedLength);
+	/**
+	 * Fills data with compressible content: words, runs, random bytes and repeats at distances up to the window size.
+	 */
+	static void SampleData(unsigned char data[], const int length, unsigned int seed);
+};
+
+#endif //_XFX_HOST_LZXENCODER_
@@ -0,0 +1,53 @@
+#
+# Host (Linux, x86) build of XFX sources, shared by tests/makefile and bench/makefile.
+# Set XFX_ROOT to the root of the tree before including this file.
+#
+#########################################################################
+CC = gcc
+CPP = g++
+
+OBJDIR = obj
+HOST = $(XFX_ROOT)/tests/host
+
+# The library is built as on the Xbox: DEBUG keeps sassert, and the push buffer recorder stands in for pbKit.
+SDLFLAGS = -DENABLE_XBOX -DDEBUG -DXFX_ALIGNED_MATRIX -DPBKIT_RECORDER
+HOST_DEFINES = -Dstricmp=strcasecmp -Dstrnicmp=strncasecmp
+# -fpermissive: the sources assume 32-bit pointers (casts to int), which only warns on a 64-bit host.
+CC_FLAGS = -c -g -O2 -ffunction-sections -std=gnu99 -fno-exceptions -msse -mfpmath=sse $(SDLFLAGS) $(HOST_DEFINES) $(HOST_FLAGS)
+CPP_FLAGS = -c -g -O2 -ffunction-sections -std=c++03 -fpermissive -fno-rtti -fno-exceptions -msse -mfpmath=sse $(SDLFLAGS) $(HOST_DEFINES) $(HOST_FLAGS)
+C_INCLUDE = -I$(HOST)/include -I$(HOST) -I$(XFX_ROOT)/include -I$(XFX_ROOT)/src/libXFX
+INCLUDE = $(C_INCLUDE) -include System/Object.h
+# Functions nothing calls are dropped, so a source links without the Xbox-only code its other members need
+# (BinaryReader(FILE*) constructs a FileStream, which is built on the Xbox kernel).
+LD_FLAGS = -Wl,--gc-sections
+LD_LIBS = -lpthread -lm
+
+$(OBJDIR)/%.o: %.cpp
+	@mkdir -p $(dir $@)
+	$(CPP) $< -o $@ $(CPP_FLAGS) $(INCLUDE)
+
+$(OBJDIR)/host/%.o: $(HOST)/%.cpp
+	@mkdir -p $(dir $@)
+	$(CPP) $< -o $@ $(CPP_FLAGS) $(INCLUDE)
+
+$(OBJDIR)/libmscorlib/%.o: $(XFX_ROOT)/src/libmscorlib/%.cpp
+	@mkdir -p $(dir $@)
+	$(CPP) $< -o $@ $(CPP_FLAGS) $(INCLUDE)
+
+$(OBJDIR)/libXFX/%.o: $(XFX_ROOT)/src/libXFX/%.cpp
+	@mkdir -p $(dir $@)
+	$(CPP) $< -o $@ $(CPP_FLAGS) $(INCLUDE)
+
+$(OBJDIR)/libXFX/%.o: $(XFX_ROOT)/src/libXFX/%.c
+	@mkdir -p $(dir $@)
+	$(CC) $< -o $@ $(CC_FLAGS) $(C_INCLUDE)
+
+# MappedFileStream.cpp built on its POSIX (mmap) path instead of the Xbox kernel.
+$(OBJDIR)/posix/%.o: $(XFX_ROOT)/src/libmscorlib/%.cpp
+	@mkdir -p $(dir $@)
+	$(CPP) $< -o $@ $(CPP_FLAGS) -UENABLE_XBOX $(INCLUDE)
+
+# The same sources built without SSE, for comparing the scalar paths against the SSE ones.
+$(OBJDIR)/scalar/%.o: $(XFX_ROOT)/src/libXFX/%.cpp
+	@mkdir -p $(dir $@)
+	$(CPP) $< -o $@ $(CPP_FLAGS) -U__SSE__ $(INCLUDE)
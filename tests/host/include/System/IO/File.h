@@ -0,0 +1,2 @@
+// Host stand-in: the header is named file.h in the tree, which only matters on case-sensitive file systems.
+#include <System/IO/file.h>
@@ -0,0 +1 @@
+// Host stand-in for the newlib header included by sassert.h.
@@ -0,0 +1,12 @@
+// Host stand-in for the OpenXDK header of the same name; only the declarations XFX sources refer to.
+#ifndef _HOST_HAL_FILEIO_
+#define _HOST_HAL_FILEIO_
+
+typedef struct _XBOX_FIND_DATA* PXBOX_FIND_DATA;
+
+#ifdef __cplusplus
+extern "C"
+#endif
+int XRenameFile(char *oldFilename, char *newFilename);
+
+#endif
@@ -0,0 +1,10 @@
+// Host stand-in for the OpenXDK header of the same name.
+#ifndef _HOST_HAL_XBOX_
+#define _HOST_HAL_XBOX_
+
+#ifdef __cplusplus
+extern "C"
+#endif
+void XSleep(int milliseconds);
+
+#endif
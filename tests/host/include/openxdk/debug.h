@@ -0,0 +1,10 @@
+// Host stand-in for the OpenXDK header of the same name.
+#ifndef _HOST_OPENXDK_DEBUG_
+#define _HOST_OPENXDK_DEBUG_
+
+#ifdef __cplusplus
+extern "C"
+#endif
+void debugPrint(const char* format, ...);
+
+#endif
@@ -0,0 +1,7 @@
+// Host stand-in for the OpenXDK header of the same name.
+#ifndef _HOST_XBOXKRNL_TYPES_
+#define _HOST_XBOXKRNL_TYPES_
+
+typedef unsigned int DWORD;
+
+#endif
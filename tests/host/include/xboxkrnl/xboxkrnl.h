@@ -0,0 +1,32 @@
+// Host stand-in for the OpenXDK header of the same name; only the declarations XFX sources refer to.
+#ifndef _HOST_XBOXKRNL_XBOXKRNL_
+#define _HOST_XBOXKRNL_XBOXKRNL_
+
+#include <xboxkrnl/types.h>
+
+#define VOID void
+#define NTAPI
+
+typedef void* PVOID;
+typedef void* HANDLE;
+typedef unsigned long ULONG;
+typedef ULONG* PULONG;
+typedef unsigned long ULONG_PTR;
+typedef void (*PKSTART_ROUTINE)(PVOID, PVOID);
+
+#define PAGE_READWRITE		0x04
+#define PAGE_WRITECOMBINE	0x400
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Served from the C heap by HostSupport.cpp.
+PVOID MmAllocateContiguousMemoryEx(ULONG NumberOfBytes, ULONG_PTR LowestAcceptableAddress, ULONG_PTR HighestAcceptableAddress, ULONG Alignment, ULONG Protect);
+VOID MmFreeContiguousMemory(PVOID BaseAddress);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif